@@ -32,7 +32,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 7
-#define API_VERSION_NUMBER_PATCH 0
+#define API_VERSION_NUMBER_PATCH 1
 
 #define HDMI 0
 #define COMPOSITE 1
@@ -621,6 +621,7 @@ JsonArray AVInput::getInputDevices(int iType)
 
 void AVInput::writeEDID(int portId, std::string message)
 {
+    m_edidCache.Invalidate(portId);
 }
 
 std::string AVInput::readEDID(int iPort)
@@ -629,7 +630,10 @@ std::string AVInput::readEDID(int iPort)
     string edidbase64 = "";
     try {
         vector<uint8_t> edidVec2;
-        device::HdmiInput::getInstance().getEDIDBytesInfo (iPort, edidVec2);
+        m_edidCache.Bytes(iPort, [iPort](vector<uint8_t>& bytes) {
+            device::HdmiInput::getInstance().getEDIDBytesInfo (iPort, bytes);
+            return !bytes.empty();
+        }, edidVec2);
         edidVec = edidVec2;//edidVec must be "unknown" unless we successfully get to this line
 
         //convert to base64
@@ -658,6 +662,9 @@ std::string AVInput::readEDID(int iPort)
 void AVInput::AVInputHotplug( int input , int connect, int type)
 {
     LOGWARN("AVInputHotplug [%d, %d, %d]", input, connect, type);
+    if (type == HDMI) {
+        m_edidCache.Invalidate(input);
+    }
 
     JsonObject params;
     params["devices"] = getInputDevices(type);
@@ -1268,6 +1275,7 @@ uint32_t AVInput::setEdid2AllmSupportWrapper(const JsonObject& parameters, JsonO
 	}
 
 	bool result = setEdid2AllmSupport(portId, allmSupport);
+	m_edidCache.Invalidate(portId);
 	if(result == true)
 	{
 	   returnResponse(true);
@@ -1416,6 +1424,7 @@ int AVInput::setEdidVersion(int iPort, int iEdidVer)
     bool ret = true;
     try {
         device::HdmiInput::getInstance().setEdidVersion (iPort, iEdidVer);
+        m_edidCache.Invalidate(iPort);
         LOGWARN("AVInput::setEdidVersion EDID Version:%d", iEdidVer);
     }
     catch (const device::Exception& err) {
@@ -22,6 +22,7 @@
 #include "Module.h"
 #include "libIBus.h"
 #include "dsTypes.h"
+#include "UtilsEdid.h"
 
 #define DEFAULT_PRIM_VOL_LEVEL 25
 #define MAX_PRIM_VOL_LEVEL 100
@@ -98,6 +99,8 @@ private:
     bool setVideoRectangle(int x, int y, int width, int height, int type);
     bool getALLMStatus(int iPort);
 
+    Utils::Edid::Cache m_edidCache; // HDMI input ports, dropped on hotplug and EDID changes
+
     void AVInputHotplug(int input , int connect, int type);
     static void dsAVEventHandler(const char *owner, IARM_EventId_t eventId, void *data, size_t len);
 
@@ -415,6 +415,9 @@ namespace Plugin {
             LOGWARN("Failed to get the supported index from capability \n");
         }
 
+        // Every PQ setting is read from TR181 once, then served from memory
+        configurePQSettingsTable();
+
         syncAvoutputTVParamsToHAL("none","none","none");
 	
         setDefaultAspectRatio();
@@ -433,6 +436,9 @@ namespace Plugin {
     {
        LOGINFO("Entry\n");
 
+       // Write out settings still waiting for the store
+       m_pqSettings.stop();
+
        tvError_t ret = tvERROR_NONE;
        ret = TvTerm();
 
@@ -2657,9 +2663,7 @@ namespace Plugin {
         int current_source = 0;
         int current_format = 0;
         int pqIndex = 0;
-        std::string tr181_param_name;
-        TR181_ParamData_t param = {0};
-        tr181ErrorCode_t err = tr181Success;
+        std::string pqmode;
 
         if (parsingGetInputArgument(parameters, "PictureMode",source, dummyPqmode, format) != 0) {
             LOGINFO("%s: Failed to parse argument\n", __FUNCTION__);
@@ -2671,18 +2675,12 @@ namespace Plugin {
             returnResponse(false);
         }
 
-        tr181_param_name += std::string(AVOUTPUT_SOURCE_PICTUREMODE_STRING_RFC_PARAM);
-        tr181_param_name += "." + convertSourceIndexToString(current_source) + "." + "Format."+convertVideoFormatToString(current_format)+"."+"PictureModeString";
-        err = getLocalParam(rfc_caller_id, tr181_param_name.c_str(), &param);
-
-        if ( tr181Success != err ) {
+        if ( getSourcePictureMode(current_source, current_format, pqmode) != 0 ) {
             returnResponse(false);
         }
         else {
-            std::string s;
-            s+=param.value;
-            response["pictureMode"] = s;
-            LOGINFO("Exit : getPictureMode() : %s\n",s.c_str());
+            response["pictureMode"] = pqmode;
+            LOGINFO("Exit : getPictureMode() : %s\n",pqmode.c_str());
             returnResponse(true);
         }
     }
@@ -2739,7 +2737,7 @@ namespace Plugin {
                     // framing Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.AVOutput.Source.source_index[x].Format.format_index[x].PictureModeString.value
                     tr181_param_name += "."+convertSourceIndexToString(source)+"."+"Format."+
                                       convertVideoFormatToString(format)+"."+"PictureModeString";
-                    tr181ErrorCode_t err = setLocalParam(rfc_caller_id, tr181_param_name.c_str(), value.c_str());
+                    tr181ErrorCode_t err = m_pqSettings.storePictureMode(source, format, value, tr181_param_name);
                     if ( err != tr181Success ) {
                         LOGERR("setLocalParam for %s Failed : %s\n", AVOUTPUT_SOURCE_PICTUREMODE_STRING_RFC_PARAM, getTR181ErrorString(err));
                         returnResponse(false);
@@ -2747,7 +2745,10 @@ namespace Plugin {
                     else {
                         LOGINFO("setLocalParam for %s Successful, Value: %s\n", AVOUTPUT_SOURCE_PICTUREMODE_STRING_RFC_PARAM, value.c_str());
                         int pqmodeindex = (int)getPictureModeIndex(value);
-                        SaveSourcePictureMode(source, format, pqmodeindex);
+                        if (!m_pqSettings.halPictureModeCurrent(source, format, pqmodeindex)) {
+                            tvError_t tv_err = SaveSourcePictureMode(source, format, pqmodeindex);
+                            m_pqSettings.halPictureModeApplied(source, format, pqmodeindex, tv_err == tvERROR_NONE);
+                        }
                     }
                 }
             }
@@ -2781,7 +2782,6 @@ namespace Plugin {
     {
         LOGINFO("Entry\n");
         tr181ErrorCode_t err = tr181Success;
-        TR181_ParamData_t param = {0};
 
         std::vector<int> pq_mode_vec;
         std::vector<int> source_vec;
@@ -2812,14 +2812,14 @@ namespace Plugin {
                 tr181_param_name += "."+convertSourceIndexToString(sourceType)+"."+"Format."+
                                    convertVideoFormatToString(formatType)+"."+"PictureModeString";
 
-                err = clearLocalParam(rfc_caller_id, tr181_param_name.c_str());
+                err = m_pqSettings.clearPictureMode(sourceType, formatType, tr181_param_name);
                 if ( err != tr181Success ) {
                     LOGWARN("clearLocalParam for %s Failed : %s\n", tr181_param_name.c_str(), getTR181ErrorString(err));
                     returnResponse(false);
                 }
                 else {
-                    err = getLocalParam(rfc_caller_id, tr181_param_name.c_str(), &param);
-                    if ( tr181Success == err ) {
+                    std::string pqmode;
+                    if ( getSourcePictureMode(sourceType, formatType, pqmode) == 0 ) {
                         //get curren source and if matches save for that alone
                         tvVideoSrcType_t current_source = VIDEO_SOURCE_IP;
                         GetCurrentSource(&current_source);
@@ -2832,17 +2832,20 @@ namespace Plugin {
 
                         if (current_source == sourceType && current_format == formatType) {
 
-                            tvError_t ret = SetTVPictureMode(param.value);
+                            tvError_t ret = SetTVPictureMode(pqmode.c_str());
                             if(ret != tvERROR_NONE) {
                                 LOGWARN("Picture Mode set failed: %s\n",getErrorString(ret).c_str());
                                 returnResponse(false);
                             }
                             else {
-                                LOGINFO("Exit : Picture Mode reset successfully, value: %s\n", param.value);
+                                LOGINFO("Exit : Picture Mode reset successfully, value: %s\n", pqmode.c_str());
                             }
                         }
-                        int pqmodeindex = (int)getPictureModeIndex(param.value);
-                        SaveSourcePictureMode(sourceType, formatType, pqmodeindex);
+                        int pqmodeindex = (int)getPictureModeIndex(pqmode);
+                        if (!m_pqSettings.halPictureModeCurrent(sourceType, formatType, pqmodeindex)) {
+                            tvError_t tv_err = SaveSourcePictureMode(sourceType, formatType, pqmodeindex);
+                            m_pqSettings.halPictureModeApplied(sourceType, formatType, pqmodeindex, tv_err == tvERROR_NONE);
+                        }
                     }
                     else {
                         LOGWARN("getLocalParam for %s failed\n", AVOUTPUT_SOURCE_PICTUREMODE_STRING_RFC_PARAM);
@@ -31,6 +31,7 @@
 #include "tvError.h"
 #include "tr181api.h"
 #include "AVOutputBase.h"
+#include "AVOutputTVSettingsTable.h"
 #include "libIARM.h"
 #include "libIBusDaemon.h"
 #include "libIBus.h"
@@ -44,6 +45,7 @@
 
 //Macro
 #define RFC_BUFF_MAX 100
+#define PQ_SETTINGS_TABLE_INDEX_MAX 32
 #define BACKLIGHT_RAW_VALUE_MAX    (255)
 #define AVOUTPUT_RFC_CALLERID        "AVOutput"
 #define AVOUTPUT_RFC_CALLERID_OVERRIDE        "../../opt/panel/AVOutput"
@@ -201,6 +203,10 @@ class AVOutputTV : public AVOutputBase {
 		tvError_t syncAvoutputTVParamsToHAL(std::string pqmode, std::string source, std::string format);
 		/* Every Bootup this function is called to sync TR181 to TVSettings HAL for saving the picture mode assiocation to source */
 		int syncAvoutputTVPQModeParamsToHAL(std::string pqmode, std::string source, std::string format);
+		/* Sizes the in-memory PQ settings table from the capability indexes */
+		void configurePQSettingsTable();
+		/* Picture mode associated to the source and format, from the PQ settings table or TR181 */
+		int getSourcePictureMode(int source, int format, std::string &pqmode);
 		
 		uint32_t generateStorageIdentifier(std::string &key, std::string forParam,int contentFormat, int pqmode, int source);
 		uint32_t generateStorageIdentifierDirty(std::string &key, std::string forParam,uint32_t contentFormat, int pqmode);
@@ -234,6 +240,8 @@ class AVOutputTV : public AVOutputBase {
 		tvError_t setAspectRatioZoomSettings(tvDisplayMode_t mode);
 		tvError_t setDefaultAspectRatio(std::string pqmode="none",std::string format="none",std::string source="none");
 
+		AVOutputTVSettingsTable m_pqSettings;
+
 	public:
 		int m_currentHdmiInResoluton;
 		int m_videoZoomMode;
@@ -18,6 +18,7 @@
 */
 
 #include <string>
+#include <algorithm>
 #include "AVOutputTV.h"
 #include "UtilsIarm.h"
 #include "rfcapi.h"
@@ -661,9 +662,8 @@ namespace Plugin {
     tvError_t AVOutputTV::initializePictureMode()
     {
         tvError_t ret = tvERROR_NONE;
-        TR181_ParamData_t param;
+        std::string pqmode;
         tvVideoSrcType_t current_source = VIDEO_SOURCE_IP;
-        std::string tr181_param_name = "";
         tvVideoFormatType_t current_format = VIDEO_FORMAT_NONE;
 
         GetCurrentVideoFormat(&current_format);
@@ -673,23 +673,19 @@ namespace Plugin {
         // get current source
         GetCurrentSource(&current_source);
 
-        tr181_param_name += std::string(AVOUTPUT_SOURCE_PICTUREMODE_STRING_RFC_PARAM);
-        tr181_param_name += "."+convertSourceIndexToString(current_source)+"."+"Format."+convertVideoFormatToString(current_format)+"."+"PictureModeString";
-        tr181ErrorCode_t err = getLocalParam(rfc_caller_id, tr181_param_name.c_str(), &param);
-        if ( tr181Success == err ) {
-            ret = SetTVPictureMode(param.value);
+        if ( getSourcePictureMode(current_source, current_format, pqmode) == 0 ) {
+            ret = SetTVPictureMode(pqmode.c_str());
 
             if(ret != tvERROR_NONE) {
                 LOGWARN("Picture Mode set failed: %s\n",getErrorString(ret).c_str());
             }
             else {
-                LOGINFO("Picture Mode initialized successfully, tr181 value [%s] value: %s\n", tr181_param_name.c_str(),
-                        param.value);
+                LOGINFO("Picture Mode initialized successfully, source %d format %d value: %s\n", current_source, current_format,
+                        pqmode.c_str());
             }
         }
         else {
             ret = tvERROR_GENERAL;
-            LOGWARN("getLocalParam for %s Failed : %s\n", tr181_param_name.c_str(), getTR181ErrorString(err));
         }
 
         return ret;
@@ -865,11 +861,11 @@ namespace Plugin {
                 else if (forParam.compare("DolbyVisionMode") == 0 ) {
                     toStore = getDolbyModeStringFromEnum((tvDolbyMode_t)value);
                 }
-                err = setLocalParam(rfc_caller_id, key.c_str(),toStore.c_str());
+                err = m_pqSettings.store(AVOutputTVSettingsTable::paramIndex(forParam),source,pqmode,format,value,key,toStore);
 
             }
             else {
-                err = clearLocalParam(rfc_caller_id, key.c_str());
+                err = m_pqSettings.clear(AVOutputTVSettingsTable::paramIndex(forParam),source,pqmode,format,key);
             }
 
             if ( err != tr181Success ) {
@@ -890,6 +886,7 @@ namespace Plugin {
         bool sync = !(action.compare("sync"));
         bool reset = !(action.compare("reset"));
         bool set = !(action.compare("set"));
+        int paramIndex = AVOutputTVSettingsTable::paramIndex(tr181ParamName);
 
         LOGINFO("%s: Entry param : %s Action : %s pqmode : %s source :%s format :%s\n",__FUNCTION__,tr181ParamName.c_str(),action.c_str(),pqmode.c_str(),source.c_str(),format.c_str() );
         ret = getSaveConfig(pqmode, source, format, sources, pictureModes, formats);
@@ -927,40 +924,45 @@ namespace Plugin {
                             default:
                                 break;
                         }
+                        /* HAL already holds this value, nothing to save */
+                        if(m_pqSettings.halCurrent(paramIndex,source,mode,format,params[0])) {
+                            continue;
+                        }
+                        int halRet = 0;
                         switch(pqParamIndex) {
                             case PQ_PARAM_BRIGHTNESS:
-                                ret |= SaveBrightness(source, mode,format,params[0]);
+                                halRet = SaveBrightness(source, mode,format,params[0]);
                                 break;
                             case PQ_PARAM_CONTRAST:
-                                ret |= SaveContrast(source, mode,format,params[0]);
+                                halRet = SaveContrast(source, mode,format,params[0]);
                                 break;
                             case PQ_PARAM_SHARPNESS:
-                                ret |= SaveSharpness(source, mode,format,params[0]);
+                                halRet = SaveSharpness(source, mode,format,params[0]);
                                 break;
                             case PQ_PARAM_HUE:
-                                ret |= SaveHue(source, mode,format,params[0]);
+                                halRet = SaveHue(source, mode,format,params[0]);
                                 break;
                             case PQ_PARAM_SATURATION:
-                                ret |= SaveSaturation(source, mode,format,params[0]);
+                                halRet = SaveSaturation(source, mode,format,params[0]);
                                 break;
                             case PQ_PARAM_COLOR_TEMPERATURE:
-                                ret |= SaveColorTemperature(source, mode,format,(tvColorTemp_t)params[0]);
+                                halRet = SaveColorTemperature(source, mode,format,(tvColorTemp_t)params[0]);
                                 break;
                             case PQ_PARAM_BACKLIGHT:
-                                ret |= SaveBacklight(source, mode,format,params[0]);
+                                halRet = SaveBacklight(source, mode,format,params[0]);
                                 break;
                             case PQ_PARAM_DIMMINGMODE:
-                                ret |= SaveTVDimmingMode(source,mode,format,(tvDimmingMode_t)params[0]);
+                                halRet = SaveTVDimmingMode(source,mode,format,(tvDimmingMode_t)params[0]);
                                 break;
                             case PQ_PARAM_LOWLATENCY_STATE:
-                                ret |= SaveLowLatencyState(source, mode,format,params[0]);
+                                halRet = SaveLowLatencyState(source, mode,format,params[0]);
                                 break;
                             case PQ_PARAM_DOLBY_MODE:
-                                 ret |= SaveTVDolbyVisionMode(source, mode,format,(tvDolbyMode_t)params[0]);
+                                 halRet = SaveTVDolbyVisionMode(source, mode,format,(tvDolbyMode_t)params[0]);
                                  break;
 
                              case PQ_PARAM_ASPECT_RATIO:
-                                 ret |= SaveAspectRatio(source,mode,format,(tvDisplayMode_t)params[0]);
+                                 halRet = SaveAspectRatio(source,mode,format,(tvDisplayMode_t)params[0]);
                                  break;
                              case PQ_PARAM_LOCALDIMMING_LEVEL:
                              {
@@ -969,7 +971,7 @@ namespace Plugin {
                                      getLocalparam(tr181ParamName,format,mode,source,value,pqParamIndex,sync);
                                      params[0]=value;
                                  }
-                                 ret |= SaveTVDimmingMode(source, mode,format,(tvDimmingMode_t)params[0]);
+                                 halRet = SaveTVDimmingMode(source, mode,format,(tvDimmingMode_t)params[0]);
                                  break;
                              }
                              case PQ_PARAM_CMS:
@@ -977,6 +979,8 @@ namespace Plugin {
                              default:
                                  break;
                         }
+                        ret |= halRet;
+                        m_pqSettings.halApplied(paramIndex,source,mode,format,params[0],halRet == 0);
                     }
                 }
            }
@@ -1063,8 +1067,6 @@ namespace Plugin {
         std::vector<int> sources;
         std::vector<int> pictureModes;
         std::vector<int> formats;
-        tr181ErrorCode_t err = tr181Success;
-        TR181_ParamData_t param = {0};
         int ret = 0;
 
         ret = getSaveConfig(pqmode, source, format, sources, pictureModes, formats);
@@ -1074,17 +1076,16 @@ namespace Plugin {
                 tvVideoSrcType_t sourceType = (tvVideoSrcType_t)source;
                 for (int format : formats) {
                     tvVideoFormatType_t formatType = (tvVideoFormatType_t)format;
-                    std::string tr181_param_name = "";
-                    tr181_param_name += std::string(AVOUTPUT_SOURCE_PICTUREMODE_STRING_RFC_PARAM);
-                    tr181_param_name += "."+convertSourceIndexToString(sourceType)+"."+"Format."+
-                                         convertVideoFormatToString(formatType)+"."+"PictureModeString";
-
-                    err = getLocalParam(rfc_caller_id, tr181_param_name.c_str(), &param);
-                    if ( tr181Success == err ) {
-                        std::string local = param.value;
+                    std::string local;
+
+                    if ( getSourcePictureMode(sourceType, formatType, local) == 0 ) {
                         int pqmodeindex = (int)getPictureModeIndex(local);
 
+                        if (m_pqSettings.halPictureModeCurrent(sourceType, formatType, pqmodeindex)) {
+                            continue;
+                        }
                         tvError_t tv_err = SaveSourcePictureMode(sourceType, formatType, pqmodeindex);
+                        m_pqSettings.halPictureModeApplied(sourceType, formatType, pqmodeindex, tv_err == tvERROR_NONE);
                         if (tv_err != tvERROR_NONE) {
                             LOGWARN("failed to SaveSourcePictureMode \n");
                             return -1;
@@ -1100,6 +1101,64 @@ namespace Plugin {
         return ret;
    }
 
+    void AVOutputTV::configurePQSettingsTable()
+    {
+        int sources = 0;
+        int pictureModes = 0;
+        int formats = 0;
+
+        for (const auto &entry : supportedSourcemap) {
+            sources = std::max(sources, entry.second + 1);
+        }
+        for (const auto &entry : supportedPictureModemap) {
+            pictureModes = std::max(pictureModes, entry.second + 1);
+        }
+        for (const auto &entry : supportedFormatmap) {
+            formats = std::max(formats, entry.second + 1);
+        }
+
+        if (sources > PQ_SETTINGS_TABLE_INDEX_MAX || pictureModes > PQ_SETTINGS_TABLE_INDEX_MAX || formats > PQ_SETTINGS_TABLE_INDEX_MAX) {
+            LOGWARN("%s: capability indexes out of range, PQ settings are read from TR181 directly\n", __FUNCTION__);
+            sources = pictureModes = formats = 0;
+        }
+        m_pqSettings.configure(rfc_caller_id, sources, pictureModes, formats);
+    }
+
+    int AVOutputTV::getSourcePictureMode(int source, int format, std::string &pqmode)
+    {
+        uint32_t generation = 0;
+        std::string cached;
+
+        AVOutputTVSettingsTable::State state = m_pqSettings.getPictureMode(source, format, cached, generation);
+        if (state == AVOutputTVSettingsTable::STATE_SET) {
+            pqmode = cached;
+            return 0;
+        }
+        if (state == AVOutputTVSettingsTable::STATE_UNSET) {
+            return -1;
+        }
+
+        TR181_ParamData_t param = {0};
+        std::string tr181_param_name = "";
+        tr181_param_name += std::string(AVOUTPUT_SOURCE_PICTUREMODE_STRING_RFC_PARAM);
+        // framing Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.AVOutput.Source.source_index[x].Format.format_index[x].PictureModeString.value
+        tr181_param_name += "."+convertSourceIndexToString(source)+"."+"Format."+
+                            convertVideoFormatToString(format)+"."+"PictureModeString";
+
+        tr181ErrorCode_t err = getLocalParam(rfc_caller_id, tr181_param_name.c_str(), &param);
+        if ( tr181Success != err ) {
+            LOGWARN("getLocalParam for %s Failed : %s\n", tr181_param_name.c_str(), getTR181ErrorString(err));
+            // Only a missing key is remembered, other errors may go away and are retried on the next read.
+            if ( AVOutputTVSettingsTable::notFound(err) ) {
+                m_pqSettings.loadedPictureMode(source, format, AVOutputTVSettingsTable::STATE_UNSET, std::string(), generation);
+            }
+            return -1;
+        }
+        pqmode = param.value;
+        m_pqSettings.loadedPictureMode(source, format, AVOutputTVSettingsTable::STATE_SET, pqmode, generation);
+        return 0;
+    }
+
     uint32_t AVOutputTV::generateStorageIdentifier(std::string &key, std::string forParam,int contentFormat, int pqmode, int source)
     {
         key+=std::string(AVOUTPUT_GENERIC_STRING_RFC_PARAM);
@@ -1174,15 +1233,30 @@ namespace Plugin {
     {
         string key;
         TR181_ParamData_t param={0};
+        int paramIndex = AVOutputTVSettingsTable::paramIndex(forParam);
+        uint32_t generation = 0;
+        int cached = 0;
+
+        AVOutputTVSettingsTable::State state = m_pqSettings.get(paramIndex,sourceIndex,pqIndex,formatIndex,cached,generation);
+        if( state == AVOutputTVSettingsTable::STATE_SET ) {
+            value = cached;
+            return 0;
+        }
+
         generateStorageIdentifier(key,forParam,formatIndex,pqIndex,sourceIndex);
         if(key.empty()) {
             LOGERR("generateStorageIdentifier failed\n");
             return -1;
         }
 
-        tr181ErrorCode_t err=getLocalParam(rfc_caller_id, key.c_str(), &param);
+        bool found = false;
+        tr181ErrorCode_t err = tr181Success;
+        if( state == AVOutputTVSettingsTable::STATE_UNKNOWN ) {
+            err = getLocalParam(rfc_caller_id, key.c_str(), &param);
+            found = ( tr181Success == err );
+        }
 
-        if ( tr181Success == err ) {//Fetch new tr181format values
+        if ( found ) {//Fetch new tr181format values
             if( forParam.compare("ColorTemp") == 0 ) {
                 if (strncmp(param.value, "Standard", strlen(param.value))==0) {
                     value=tvColorTemp_STANDARD;
@@ -1199,7 +1273,6 @@ namespace Plugin {
                 else {
                     value=tvColorTemp_STANDARD;
 		}
-                return 0;
            }
            else if( forParam.compare("DimmingMode") == 0 ) {
                if (strncmp(param.value, "fixed", strlen(param.value))==0) {
@@ -1211,7 +1284,6 @@ namespace Plugin {
                else if (strncmp(param.value, "global", strlen(param.value))==0) {
                    value=tvDimmingMode_Global;
 	       }
-               return 0;
            }
            else if ( forParam.compare("DolbyVisionMode") == 0) {
                if (strncmp(param.value, "Dark", strlen(param.value)) == 0) {
@@ -1223,14 +1295,17 @@ namespace Plugin {
                else {
                    value = tvDolbyMode_Bright;
                }
-               return 0;
            }
            else {
                value=std::stoi(param.value);
-               return 0;
            }
+           m_pqSettings.loaded(paramIndex,sourceIndex,pqIndex,formatIndex,AVOutputTVSettingsTable::STATE_SET,value,generation);
+           return 0;
         }
         else {// default value from DB
+            if( state == AVOutputTVSettingsTable::STATE_UNKNOWN && AVOutputTVSettingsTable::notFound(err) ) {
+                m_pqSettings.loaded(paramIndex,sourceIndex,pqIndex,formatIndex,AVOutputTVSettingsTable::STATE_UNSET,0,generation);
+            }
             if( sync ) {
                 return 1;
             }
@@ -1393,8 +1468,7 @@ namespace Plugin {
     int AVOutputTV::getCurrentPictureMode(char *picMode)
     {
         tvError_t  ret = tvERROR_NONE;
-        TR181_ParamData_t param;
-        std::string tr181_param_name;
+        std::string pqmode;
         tvVideoSrcType_t currentSource = VIDEO_SOURCE_IP;
 
         ret = GetCurrentSource(&currentSource);
@@ -1409,14 +1483,9 @@ namespace Plugin {
 	    current_format  = VIDEO_FORMAT_SDR;
 	}
 
-        tr181_param_name += std::string(AVOUTPUT_SOURCE_PICTUREMODE_STRING_RFC_PARAM);
-        tr181_param_name += "." + convertSourceIndexToString(currentSource) + "." + "Format."+convertVideoFormatToString(current_format)+"."+"PictureModeString";
-
-        memset(&param, 0, sizeof(param));
-
-        tr181ErrorCode_t err = getLocalParam(rfc_caller_id, tr181_param_name.c_str(), &param);
-        if ( err == tr181Success ) {
-            strncpy(picMode, param.value, strlen(param.value)+1);
+        if ( getSourcePictureMode(currentSource, current_format, pqmode) == 0 ) {
+            strncpy(picMode, pqmode.c_str(), PIC_MODE_NAME_MAX - 1);
+            picMode[PIC_MODE_NAME_MAX - 1] = '\0';
             LOGINFO("getLocalParam success, mode = %s\n", picMode);
             return 1;
         }
@@ -0,0 +1,388 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2024 Sky UK
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <chrono>
+#include "Module.h"
+#include "AVOutputTVSettingsTable.h"
+#include "UtilsLogging.h"
+
+/* Sets arriving within this window are written to the store together */
+#define WRITE_BEHIND_DELAY_MS  500
+/* A failed write is retried with the next flushes, up to this many attempts in all */
+#define WRITE_BEHIND_MAX_ATTEMPTS  3
+
+namespace WPEFramework {
+namespace Plugin {
+
+    AVOutputTVSettingsTable::AVOutputTVSettingsTable()
+        : m_stop(false)
+        , m_sources(0)
+        , m_pictureModes(0)
+        , m_formats(0)
+        , m_generation(0)
+    {
+    }
+
+    AVOutputTVSettingsTable::~AVOutputTVSettingsTable()
+    {
+        stop();
+    }
+
+    int AVOutputTVSettingsTable::paramIndex(const std::string &forParam)
+    {
+        static const char* names[PARAM_MAX] = {
+            "Brightness",
+            "Contrast",
+            "Sharpness",
+            "Saturation",
+            "Hue",
+            "ColorTemp",
+            "DolbyVisionMode",
+            "DimmingMode",
+            "Backlight",
+            "LowLatencyState"
+        };
+
+        for (int i = 0; i < PARAM_MAX; i++) {
+            if (forParam.compare(names[i]) == 0) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    bool AVOutputTVSettingsTable::notFound(tr181ErrorCode_t err)
+    {
+        // getLocalParam has no value for a key the local store does not hold
+        return (err == tr181ValueIsEmpty);
+    }
+
+    void AVOutputTVSettingsTable::configure(const std::string &callerId, int sources, int pictureModes, int formats)
+    {
+        {
+            std::lock_guard<std::mutex> storeLock(m_storeLock);
+            std::lock_guard<std::mutex> lock(m_lock);
+
+            m_callerId = callerId;
+            m_sources = sources;
+            m_pictureModes = pictureModes;
+            m_formats = formats;
+            m_generation++;
+            m_cells.assign(PARAM_MAX * sources * pictureModes * formats, Cell{0, 0, STATE_UNKNOWN, false});
+            m_pictureModeCells.assign(sources * formats, PictureModeCell{std::string(), 0, STATE_UNKNOWN, false});
+            m_stop = false;
+        }
+
+        if (!m_flushThread.joinable()) {
+            m_flushThread = std::thread(&AVOutputTVSettingsTable::flushLoop, this);
+        }
+        LOGINFO("PQ settings table: %d sources, %d picture modes, %d formats\n", sources, pictureModes, formats);
+    }
+
+    void AVOutputTVSettingsTable::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_stop = true;
+        }
+        m_flushSignal.notify_all();
+        if (m_flushThread.joinable()) {
+            m_flushThread.join();
+        }
+        flushPending();
+    }
+
+    void AVOutputTVSettingsTable::flush()
+    {
+        flushPending();
+    }
+
+    int AVOutputTVSettingsTable::cellIndex(int param, int source, int pqmode, int format) const
+    {
+        if (param < 0 || param >= PARAM_MAX ||
+            source < 0 || source >= m_sources ||
+            pqmode < 0 || pqmode >= m_pictureModes ||
+            format < 0 || format >= m_formats) {
+            return -1;
+        }
+        return ((param * m_sources + source) * m_pictureModes + pqmode) * m_formats + format;
+    }
+
+    int AVOutputTVSettingsTable::pictureModeIndex(int source, int format) const
+    {
+        if (source < 0 || source >= m_sources || format < 0 || format >= m_formats) {
+            return -1;
+        }
+        return source * m_formats + format;
+    }
+
+    AVOutputTVSettingsTable::State AVOutputTVSettingsTable::get(int param, int source, int pqmode, int format, int &value, uint32_t &generation) const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        const int index = cellIndex(param, source, pqmode, format);
+
+        generation = m_generation;
+        if (index < 0) {
+            return STATE_UNKNOWN;
+        }
+        if (m_cells[index].state == STATE_SET) {
+            value = m_cells[index].value;
+        }
+        return m_cells[index].state;
+    }
+
+    void AVOutputTVSettingsTable::loaded(int param, int source, int pqmode, int format, State state, int value, uint32_t generation)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        const int index = cellIndex(param, source, pqmode, format);
+
+        // A set or clear since the store was read makes what was read stale.
+        if (index >= 0 && generation == m_generation && m_cells[index].state == STATE_UNKNOWN) {
+            m_cells[index].value = value;
+            m_cells[index].state = state;
+        }
+    }
+
+    tr181ErrorCode_t AVOutputTVSettingsTable::store(int param, int source, int pqmode, int format, int value, const std::string &key, const std::string &toStore)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            const int index = cellIndex(param, source, pqmode, format);
+
+            if (index >= 0 && !m_stop) {
+                m_cells[index].value = value;
+                m_cells[index].state = STATE_SET;
+                m_pending[key] = PendingWrite{toStore, index, -1, 0};
+                m_flushSignal.notify_one();
+                return tr181Success;
+            }
+        }
+
+        std::lock_guard<std::mutex> storeLock(m_storeLock);
+        return write(key, toStore);
+    }
+
+    tr181ErrorCode_t AVOutputTVSettingsTable::clear(int param, int source, int pqmode, int format, const std::string &key)
+    {
+        std::lock_guard<std::mutex> storeLock(m_storeLock);
+        const int index = cellIndex(param, source, pqmode, format);
+
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_pending.erase(key);
+        }
+
+        tr181ErrorCode_t err = remove(key);
+
+        // Read back from the store on next use, it may hold a default for the key.
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (index >= 0) {
+            m_cells[index].state = STATE_UNKNOWN;
+        }
+        m_generation++;
+        return err;
+    }
+
+    bool AVOutputTVSettingsTable::halCurrent(int param, int source, int pqmode, int format, int value) const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        const int index = cellIndex(param, source, pqmode, format);
+
+        return (index >= 0 && m_cells[index].halValid && m_cells[index].halValue == value);
+    }
+
+    void AVOutputTVSettingsTable::halApplied(int param, int source, int pqmode, int format, int value, bool success)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        const int index = cellIndex(param, source, pqmode, format);
+
+        if (index >= 0) {
+            m_cells[index].halValue = value;
+            m_cells[index].halValid = success;
+        }
+    }
+
+    AVOutputTVSettingsTable::State AVOutputTVSettingsTable::getPictureMode(int source, int format, std::string &pqmode, uint32_t &generation) const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        const int index = pictureModeIndex(source, format);
+
+        generation = m_generation;
+        if (index < 0) {
+            return STATE_UNKNOWN;
+        }
+        if (m_pictureModeCells[index].state == STATE_SET) {
+            pqmode = m_pictureModeCells[index].pqmode;
+        }
+        return m_pictureModeCells[index].state;
+    }
+
+    void AVOutputTVSettingsTable::loadedPictureMode(int source, int format, State state, const std::string &pqmode, uint32_t generation)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        const int index = pictureModeIndex(source, format);
+
+        if (index >= 0 && generation == m_generation && m_pictureModeCells[index].state == STATE_UNKNOWN) {
+            m_pictureModeCells[index].pqmode = pqmode;
+            m_pictureModeCells[index].state = state;
+        }
+    }
+
+    tr181ErrorCode_t AVOutputTVSettingsTable::storePictureMode(int source, int format, const std::string &pqmode, const std::string &key)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            const int index = pictureModeIndex(source, format);
+
+            if (index >= 0 && !m_stop) {
+                m_pictureModeCells[index].pqmode = pqmode;
+                m_pictureModeCells[index].state = STATE_SET;
+                m_pending[key] = PendingWrite{pqmode, -1, index, 0};
+                m_flushSignal.notify_one();
+                return tr181Success;
+            }
+        }
+
+        std::lock_guard<std::mutex> storeLock(m_storeLock);
+        return write(key, pqmode);
+    }
+
+    tr181ErrorCode_t AVOutputTVSettingsTable::clearPictureMode(int source, int format, const std::string &key)
+    {
+        std::lock_guard<std::mutex> storeLock(m_storeLock);
+        const int index = pictureModeIndex(source, format);
+
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_pending.erase(key);
+        }
+
+        tr181ErrorCode_t err = remove(key);
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (index >= 0) {
+            m_pictureModeCells[index].state = STATE_UNKNOWN;
+        }
+        m_generation++;
+        return err;
+    }
+
+    bool AVOutputTVSettingsTable::halPictureModeCurrent(int source, int format, int pqmodeIndex) const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        const int index = pictureModeIndex(source, format);
+
+        return (index >= 0 && m_pictureModeCells[index].halValid && m_pictureModeCells[index].halIndex == pqmodeIndex);
+    }
+
+    void AVOutputTVSettingsTable::halPictureModeApplied(int source, int format, int pqmodeIndex, bool success)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        const int index = pictureModeIndex(source, format);
+
+        if (index >= 0) {
+            m_pictureModeCells[index].halIndex = pqmodeIndex;
+            m_pictureModeCells[index].halValid = success;
+        }
+    }
+
+    tr181ErrorCode_t AVOutputTVSettingsTable::write(const std::string &key, const std::string &value)
+    {
+        tr181ErrorCode_t err = setLocalParam(const_cast<char*>(m_callerId.c_str()), key.c_str(), value.c_str());
+        if (err != tr181Success) {
+            LOGERR("setLocalParam for %s Failed : %s\n", key.c_str(), getTR181ErrorString(err));
+        }
+        return err;
+    }
+
+    tr181ErrorCode_t AVOutputTVSettingsTable::remove(const std::string &key)
+    {
+        tr181ErrorCode_t err = clearLocalParam(const_cast<char*>(m_callerId.c_str()), key.c_str());
+        if (err != tr181Success) {
+            LOGERR("clearLocalParam for %s Failed : %s\n", key.c_str(), getTR181ErrorString(err));
+        }
+        return err;
+    }
+
+    void AVOutputTVSettingsTable::flushLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+
+        while (!m_stop) {
+            if (m_pending.empty()) {
+                m_flushSignal.wait(lock);
+                continue;
+            }
+            // Let a burst of sets, e.g. a reset over all picture modes, settle first.
+            m_flushSignal.wait_for(lock, std::chrono::milliseconds(WRITE_BEHIND_DELAY_MS), [this]() { return m_stop; });
+
+            lock.unlock();
+            flushPending();
+            lock.lock();
+        }
+    }
+
+    void AVOutputTVSettingsTable::flushPending()
+    {
+        std::lock_guard<std::mutex> storeLock(m_storeLock);
+        std::map<std::string, PendingWrite> pending;
+
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            pending.swap(m_pending);
+        }
+        if (pending.empty()) {
+            return;
+        }
+
+        std::map<std::string, PendingWrite> failed;
+        for (auto &entry : pending) {
+            if (write(entry.first, entry.second.value) != tr181Success) {
+                entry.second.attempts++;
+                failed.insert(entry);
+            }
+        }
+
+        int dropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            for (const auto &entry : failed) {
+                if (m_pending.find(entry.first) != m_pending.end()) {
+                    continue; // set again meanwhile, the new value is written instead
+                }
+                if (!m_stop && entry.second.attempts < WRITE_BEHIND_MAX_ATTEMPTS) {
+                    m_pending.insert(entry);
+                    continue;
+                }
+                // The table must not keep a value the store does not have, read the cell from the store again.
+                if (entry.second.cell >= 0 && entry.second.cell < (int)m_cells.size()) {
+                    m_cells[entry.second.cell].state = STATE_UNKNOWN;
+                }
+                if (entry.second.pictureModeCell >= 0 && entry.second.pictureModeCell < (int)m_pictureModeCells.size()) {
+                    m_pictureModeCells[entry.second.pictureModeCell].state = STATE_UNKNOWN;
+                }
+                m_generation++;
+                dropped++;
+            }
+        }
+        LOGINFO("Flushed %d PQ settings to the local store, %d failed, %d given up\n", (int)pending.size(), (int)failed.size(), dropped);
+    }
+
+}//namespace Plugin
+}//namespace WPEFramework
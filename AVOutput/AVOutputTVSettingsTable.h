@@ -0,0 +1,155 @@
+/*
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2024 Sky UK
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef AVOutputTVSettingsTable_H
+#define AVOutputTVSettingsTable_H
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+#include "tr181api.h"
+
+namespace WPEFramework {
+namespace Plugin {
+
+/*
+ * In-memory copy of the per source / picture mode / format PQ settings kept in TR181.
+ *
+ * Every setting is read from the local store at most once, then served from a dense table indexed by
+ * (param, source, picture mode, format). Sets update the table and are written to the store by a
+ * background flush that coalesces everything changed within a short window. A write that keeps failing
+ * is given up after a few attempts and its cell is read from the store again. Clears go to the store
+ * straight away, so a following read sees the store default, if it has one.
+ *
+ * The table also remembers the last value saved to the TVSettings HAL for each cell, so the same value
+ * is not saved twice.
+ *
+ * Settings outside the dimensions given to configure() are passed through to the store directly.
+ */
+class AVOutputTVSettingsTable {
+    public:
+		enum Param {
+			PARAM_BRIGHTNESS = 0,
+			PARAM_CONTRAST,
+			PARAM_SHARPNESS,
+			PARAM_SATURATION,
+			PARAM_HUE,
+			PARAM_COLOR_TEMPERATURE,
+			PARAM_DOLBY_MODE,
+			PARAM_DIMMING_MODE,
+			PARAM_BACKLIGHT,
+			PARAM_LOWLATENCY_STATE,
+			PARAM_MAX
+		};
+
+		enum State : uint8_t {
+			STATE_UNKNOWN = 0,	/* not read from the store yet */
+			STATE_SET,		/* value is valid */
+			STATE_UNSET		/* not in the store, the HAL default applies */
+		};
+
+		AVOutputTVSettingsTable();
+		~AVOutputTVSettingsTable();
+
+		/* Maps the TR181 parameter name to a table row, -1 if the parameter is not kept in the table */
+		static int paramIndex(const std::string &forParam);
+		/* True for the getLocalParam error of a key that is not in the store; only that is cached as STATE_UNSET */
+		static bool notFound(tr181ErrorCode_t err);
+
+		void configure(const std::string &callerId, int sources, int pictureModes, int formats);
+		/* Writes out pending sets and stops the flush thread */
+		void stop();
+		/* Writes out pending sets now */
+		void flush();
+
+		/* PQ parameters; generation is passed back to loaded() after reading the store */
+		State get(int param, int source, int pqmode, int format, int &value, uint32_t &generation) const;
+		void loaded(int param, int source, int pqmode, int format, State state, int value, uint32_t generation);
+		tr181ErrorCode_t store(int param, int source, int pqmode, int format, int value, const std::string &key, const std::string &toStore);
+		tr181ErrorCode_t clear(int param, int source, int pqmode, int format, const std::string &key);
+
+		bool halCurrent(int param, int source, int pqmode, int format, int value) const;
+		void halApplied(int param, int source, int pqmode, int format, int value, bool success);
+
+		/* Picture mode associated to a source and format */
+		State getPictureMode(int source, int format, std::string &pqmode, uint32_t &generation) const;
+		void loadedPictureMode(int source, int format, State state, const std::string &pqmode, uint32_t generation);
+		tr181ErrorCode_t storePictureMode(int source, int format, const std::string &pqmode, const std::string &key);
+		tr181ErrorCode_t clearPictureMode(int source, int format, const std::string &key);
+
+		bool halPictureModeCurrent(int source, int format, int pqmodeIndex) const;
+		void halPictureModeApplied(int source, int format, int pqmodeIndex, bool success);
+
+    private:
+		AVOutputTVSettingsTable(const AVOutputTVSettingsTable&) = delete;
+		AVOutputTVSettingsTable& operator=(const AVOutputTVSettingsTable&) = delete;
+
+		struct Cell {
+			int value;
+			int halValue;
+			State state;
+			bool halValid;
+		};
+
+		struct PictureModeCell {
+			std::string pqmode;
+			int halIndex;
+			State state;
+			bool halValid;
+		};
+
+		struct PendingWrite {
+			std::string value;
+			int cell;		/* in m_cells, -1 if none */
+			int pictureModeCell;	/* in m_pictureModeCells, -1 if none */
+			int attempts;
+		};
+
+		int cellIndex(int param, int source, int pqmode, int format) const;
+		int pictureModeIndex(int source, int format) const;
+		tr181ErrorCode_t write(const std::string &key, const std::string &value);
+		tr181ErrorCode_t remove(const std::string &key);
+		void flushLoop();
+		void flushPending();
+
+		mutable std::mutex m_lock;		/* table and pending writes */
+		std::mutex m_storeLock;		/* orders the store accesses, taken before m_lock */
+		std::condition_variable m_flushSignal;
+		std::thread m_flushThread;
+		bool m_stop;
+
+		std::string m_callerId;
+		int m_sources;
+		int m_pictureModes;
+		int m_formats;
+		uint32_t m_generation;
+		std::vector<Cell> m_cells;
+		std::vector<PictureModeCell> m_pictureModeCells;
+		std::map<std::string, PendingWrite> m_pending;
+};
+
+}//namespace Plugin
+}//namespace WPEFramework
+
+#endif
@@ -0,0 +1,170 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../AVOutputTVSettingsTable.h"
+#include "Tr181Mock.h"
+
+using ::testing::_;
+using ::testing::Eq;
+using ::testing::Mock;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::Test;
+using ::WPEFramework::Plugin::AVOutputTVSettingsTable;
+
+const auto kCallerId = "l1test";
+const auto kSources = 2;
+const auto kPictureModes = 3;
+const auto kFormats = 2;
+
+class AnAVOutputTVSettingsTable : public Test {
+protected:
+    // Outlives the table, which writes what is still pending when it stops.
+    NiceMock<Tr181Mock> store;
+    AVOutputTVSettingsTable table;
+    AnAVOutputTVSettingsTable()
+    {
+        ON_CALL(store, getLocalParam(_, _)).WillByDefault(Return(tr181ValueIsEmpty));
+        ON_CALL(store, setLocalParam(_, _)).WillByDefault(Return(tr181Success));
+        ON_CALL(store, clearLocalParam(_)).WillByDefault(Return(tr181Success));
+        table.configure(kCallerId, kSources, kPictureModes, kFormats);
+    }
+};
+
+TEST_F(AnAVOutputTVSettingsTable, PassesSettingsOutsideTheTableThroughToTheStore)
+{
+    const struct {
+        int param;
+        int source;
+        int pqmode;
+        int format;
+    } outside[] = {
+        { -1, 0, 0, 0 },
+        { AVOutputTVSettingsTable::PARAM_MAX, 0, 0, 0 },
+        { 0, -1, 0, 0 },
+        { 0, kSources, 0, 0 },
+        { 0, 0, -1, 0 },
+        { 0, 0, kPictureModes, 0 },
+        { 0, 0, 0, -1 },
+        { 0, 0, 0, kFormats },
+    };
+
+    for (const auto& cell : outside) {
+        EXPECT_CALL(store, setLocalParam("key", "7")).WillOnce(Return(tr181Success));
+        EXPECT_THAT(table.store(cell.param, cell.source, cell.pqmode, cell.format, 7, "key", "7"), Eq(tr181Success));
+        Mock::VerifyAndClearExpectations(&store);
+
+        int value = 0;
+        uint32_t generation = 0;
+        EXPECT_THAT(table.get(cell.param, cell.source, cell.pqmode, cell.format, value, generation), Eq(AVOutputTVSettingsTable::STATE_UNKNOWN));
+        EXPECT_THAT(value, Eq(0));
+    }
+
+    EXPECT_CALL(store, setLocalParam("mode", "Vivid")).WillOnce(Return(tr181Success));
+    EXPECT_THAT(table.storePictureMode(kSources, 0, "Vivid", "mode"), Eq(tr181Success));
+    Mock::VerifyAndClearExpectations(&store);
+
+    // The last cell is in the table, its write is left to the flush.
+    EXPECT_CALL(store, setLocalParam("corner", _)).Times(0);
+    EXPECT_THAT(table.store(AVOutputTVSettingsTable::PARAM_MAX - 1, kSources - 1, kPictureModes - 1, kFormats - 1, 9, "corner", "9"), Eq(tr181Success));
+    Mock::VerifyAndClearExpectations(&store);
+
+    int value = 0;
+    uint32_t generation = 0;
+    EXPECT_THAT(table.get(AVOutputTVSettingsTable::PARAM_MAX - 1, kSources - 1, kPictureModes - 1, kFormats - 1, value, generation), Eq(AVOutputTVSettingsTable::STATE_SET));
+    EXPECT_THAT(value, Eq(9));
+
+    EXPECT_CALL(store, setLocalParam("corner", "9")).WillOnce(Return(tr181Success));
+    table.flush();
+}
+
+TEST_F(AnAVOutputTVSettingsTable, IgnoresWhatWasReadBeforeASet)
+{
+    int value = 0;
+    uint32_t generation = 0;
+    uint32_t unused = 0;
+    EXPECT_THAT(table.get(AVOutputTVSettingsTable::PARAM_BRIGHTNESS, 0, 0, 0, value, generation), Eq(AVOutputTVSettingsTable::STATE_UNKNOWN));
+
+    table.store(AVOutputTVSettingsTable::PARAM_BRIGHTNESS, 0, 0, 0, 60, "brightness", "60");
+    table.loaded(AVOutputTVSettingsTable::PARAM_BRIGHTNESS, 0, 0, 0, AVOutputTVSettingsTable::STATE_SET, 40, generation);
+
+    EXPECT_THAT(table.get(AVOutputTVSettingsTable::PARAM_BRIGHTNESS, 0, 0, 0, value, unused), Eq(AVOutputTVSettingsTable::STATE_SET));
+    EXPECT_THAT(value, Eq(60));
+
+    std::string pqmode;
+    EXPECT_THAT(table.getPictureMode(1, 1, pqmode, generation), Eq(AVOutputTVSettingsTable::STATE_UNKNOWN));
+
+    table.storePictureMode(1, 1, "Vivid", "mode");
+    table.loadedPictureMode(1, 1, AVOutputTVSettingsTable::STATE_UNSET, std::string(), generation);
+
+    EXPECT_THAT(table.getPictureMode(1, 1, pqmode, unused), Eq(AVOutputTVSettingsTable::STATE_SET));
+    EXPECT_THAT(pqmode, Eq("Vivid"));
+}
+
+TEST_F(AnAVOutputTVSettingsTable, BumpsTheGenerationOnClear)
+{
+    int value = 0;
+    uint32_t before = 0;
+    uint32_t after = 0;
+    table.get(AVOutputTVSettingsTable::PARAM_CONTRAST, 1, 2, 1, value, before);
+
+    // The pending set is dropped, the store only sees the clear.
+    EXPECT_CALL(store, setLocalParam("contrast", _)).Times(0);
+    EXPECT_CALL(store, clearLocalParam("contrast")).WillOnce(Return(tr181Success));
+    table.store(AVOutputTVSettingsTable::PARAM_CONTRAST, 1, 2, 1, 50, "contrast", "50");
+    EXPECT_THAT(table.clear(AVOutputTVSettingsTable::PARAM_CONTRAST, 1, 2, 1, "contrast"), Eq(tr181Success));
+    table.flush();
+
+    EXPECT_THAT(table.get(AVOutputTVSettingsTable::PARAM_CONTRAST, 1, 2, 1, value, after), Eq(AVOutputTVSettingsTable::STATE_UNKNOWN));
+    EXPECT_THAT(after, Eq(before + 1));
+
+    // A read from before the clear is stale, one after it is taken.
+    table.loaded(AVOutputTVSettingsTable::PARAM_CONTRAST, 1, 2, 1, AVOutputTVSettingsTable::STATE_SET, 50, before);
+    EXPECT_THAT(table.get(AVOutputTVSettingsTable::PARAM_CONTRAST, 1, 2, 1, value, after), Eq(AVOutputTVSettingsTable::STATE_UNKNOWN));
+    table.loaded(AVOutputTVSettingsTable::PARAM_CONTRAST, 1, 2, 1, AVOutputTVSettingsTable::STATE_UNSET, 0, after);
+    EXPECT_THAT(table.get(AVOutputTVSettingsTable::PARAM_CONTRAST, 1, 2, 1, value, after), Eq(AVOutputTVSettingsTable::STATE_UNSET));
+
+    std::string pqmode;
+    EXPECT_CALL(store, clearLocalParam("mode")).WillOnce(Return(tr181Success));
+    table.clearPictureMode(0, 0, "mode");
+    EXPECT_THAT(table.getPictureMode(0, 0, pqmode, after), Eq(AVOutputTVSettingsTable::STATE_UNKNOWN));
+    EXPECT_THAT(after, Eq(before + 2));
+}
+
+TEST_F(AnAVOutputTVSettingsTable, CoalescesSetsIntoOneWritePerKey)
+{
+    EXPECT_CALL(store, setLocalParam("brightness", "3")).WillOnce(Return(tr181Success));
+    EXPECT_CALL(store, setLocalParam("hue", "1")).WillOnce(Return(tr181Success));
+    EXPECT_CALL(store, setLocalParam("mode", "Standard")).WillOnce(Return(tr181Success));
+
+    table.store(AVOutputTVSettingsTable::PARAM_BRIGHTNESS, 0, 0, 0, 1, "brightness", "1");
+    table.store(AVOutputTVSettingsTable::PARAM_BRIGHTNESS, 0, 0, 0, 2, "brightness", "2");
+    table.store(AVOutputTVSettingsTable::PARAM_HUE, 0, 1, 0, 1, "hue", "1");
+    table.storePictureMode(0, 1, "Vivid", "mode");
+    table.storePictureMode(0, 1, "Standard", "mode");
+    table.store(AVOutputTVSettingsTable::PARAM_BRIGHTNESS, 0, 0, 0, 3, "brightness", "3");
+    table.flush();
+
+    // Nothing is left for a second flush.
+    table.flush();
+}
+
+TEST_F(AnAVOutputTVSettingsTable, ReadsTheStoreAgainWhenAWriteKeepsFailing)
+{
+    EXPECT_CALL(store, setLocalParam("sharpness", "10")).Times(3).WillRepeatedly(Return(tr181Failure));
+
+    table.store(AVOutputTVSettingsTable::PARAM_SHARPNESS, 0, 0, 0, 10, "sharpness", "10");
+    table.flush();
+
+    int value = 0;
+    uint32_t before = 0;
+    uint32_t after = 0;
+    EXPECT_THAT(table.get(AVOutputTVSettingsTable::PARAM_SHARPNESS, 0, 0, 0, value, before), Eq(AVOutputTVSettingsTable::STATE_SET));
+    EXPECT_THAT(value, Eq(10));
+
+    table.flush();
+    table.flush();
+
+    EXPECT_THAT(table.get(AVOutputTVSettingsTable::PARAM_SHARPNESS, 0, 0, 0, value, after), Eq(AVOutputTVSettingsTable::STATE_UNKNOWN));
+    EXPECT_THAT(after, Eq(before + 1));
+}
@@ -0,0 +1,27 @@
+#include "Tr181Mock.h"
+
+Tr181Mock* Tr181Mock::instance = nullptr;
+
+extern "C" {
+
+tr181ErrorCode_t getLocalParam(char*, const char* pcParameterName, TR181_ParamData_t* pstParamData)
+{
+    return (Tr181Mock::instance != nullptr ? Tr181Mock::instance->getLocalParam(pcParameterName, pstParamData) : tr181Failure);
+}
+
+tr181ErrorCode_t setLocalParam(char*, const char* pcParameterName, const char* pcParameterValue)
+{
+    return (Tr181Mock::instance != nullptr ? Tr181Mock::instance->setLocalParam(pcParameterName, pcParameterValue) : tr181Failure);
+}
+
+tr181ErrorCode_t clearLocalParam(char*, const char* pcParameterName)
+{
+    return (Tr181Mock::instance != nullptr ? Tr181Mock::instance->clearLocalParam(pcParameterName) : tr181Failure);
+}
+
+const char* getTR181ErrorString(tr181ErrorCode_t code)
+{
+    return (code == tr181Success ? "Success" : "Failure");
+}
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <gmock/gmock.h>
+#include <string>
+
+#include "tr181api.h"
+
+// The local TR181 store; the tr181api functions go to the instance alive at the time.
+class Tr181Mock {
+public:
+    Tr181Mock()
+    {
+        instance = this;
+    }
+    ~Tr181Mock()
+    {
+        instance = nullptr;
+    }
+    MOCK_METHOD(tr181ErrorCode_t, getLocalParam, (const std::string& name, TR181_ParamData_t* data));
+    MOCK_METHOD(tr181ErrorCode_t, setLocalParam, (const std::string& name, const std::string& value));
+    MOCK_METHOD(tr181ErrorCode_t, clearLocalParam, (const std::string& name));
+
+    static Tr181Mock* instance;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+// The part of the RFC component's tr181api.h the settings table uses, backed by Tr181Mock.
+
+#define MAX_PARAM_LEN (2 * 1024)
+
+typedef enum {
+    tr181Success = 0,
+    tr181Failure,
+    tr181InvalidParameterName,
+    tr181InvalidParameterValue,
+    tr181InvalidType,
+    tr181NotWritable,
+    tr181ValueIsEmpty,
+    tr181ValueIsNull,
+    tr181DefaultValue,
+    tr181ErrorCodeMax
+} tr181ErrorCode_t;
+
+typedef enum {
+    PARAM_STRING = 0,
+    PARAM_INT,
+    PARAM_UINT,
+    PARAM_BOOLEAN,
+    PARAM_DATETIME,
+    PARAM_BASE64,
+    PARAM_LONG,
+    PARAM_ULONG,
+    PARAM_FLOAT,
+    PARAM_DOUBLE,
+    PARAM_BYTE,
+    PARAM_NONE
+} DATA_TYPE;
+
+typedef struct _TR181_Param_t {
+    char value[MAX_PARAM_LEN];
+    DATA_TYPE type;
+} TR181_ParamData_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+tr181ErrorCode_t getLocalParam(char* pcCallerID, const char* pcParameterName, TR181_ParamData_t* pstParamData);
+tr181ErrorCode_t setLocalParam(char* pcCallerID, const char* pcParameterName, const char* pcParameterValue);
+tr181ErrorCode_t clearLocalParam(char* pcCallerID, const char* pcParameterName);
+const char* getTR181ErrorString(tr181ErrorCode_t code);
+
+#ifdef __cplusplus
+}
+#endif
@@ -222,6 +222,23 @@ namespace WPEFramework
         }
 
         bool SiftBackend::SendEventInternal(const Event &event, const SiftConfig::Attributes &attributes)
+        {
+            std::string json;
+            ComposeEvent(event, attributes, json);
+
+            if (mStorePtr != nullptr
+                && mStorePtr->PostEvent(json))
+            {
+                LOGINFO("Event %s sent to store", event.eventName.c_str());
+                return true;
+            }
+
+            LOGERR("Failed to send event %s to store", event.eventName.c_str());
+
+            return false;
+        }
+
+        void SiftBackend::ComposeEvent(const Event &event, const SiftConfig::Attributes &attributes, std::string &json)
         {
             JsonObject eventJson = JsonObject();
             if (attributes.schema2Enabled)
@@ -343,19 +360,7 @@ namespace WPEFramework
                 eventJson["device_type"] = attributes.deviceType;
             }
 
-            std::string json;
             eventJson.ToString(json);
-
-            if (mStorePtr != nullptr
-                && mStorePtr->PostEvent(json))
-            {
-                LOGINFO("Event %s sent to store", event.eventName.c_str());
-                return true;
-            }
-
-            LOGERR("Failed to send event %s to store", event.eventName.c_str());
-
-            return false;
         }
 
         uint8_t SiftBackend::GenerateRandomCharacter()
@@ -43,6 +43,9 @@ namespace Plugin {
         uint32_t Configure(PluginHost::IShell* shell) override;
         uint32_t SetSessionId(const std::string& sessionId) override;
 
+        // Builds the Sift 1.0 or 2.0 JSON of an event, as posted to the store
+        static void ComposeEvent(const Event& event, const SiftConfig::Attributes& attributes, std::string& json);
+
     private:
 
         struct Config
@@ -40,7 +40,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 12
+#define API_VERSION_NUMBER_PATCH 13
 
 const string WPEFramework::Plugin::Bluetooth::SERVICE_NAME = "org.rdk.Bluetooth";
 const string WPEFramework::Plugin::Bluetooth::METHOD_START_SCAN = "startScan";
@@ -66,6 +66,7 @@ const string WPEFramework::Plugin::Bluetooth::METHOD_GET_AUDIO_INFO = "getAudioI
 const string WPEFramework::Plugin::Bluetooth::METHOD_GET_API_VERSION_NUMBER = "getApiVersionNumber";
 const string WPEFramework::Plugin::Bluetooth::METHOD_GET_DEVICE_VOLUME_MUTE_INFO = "getDeviceVolumeMuteInfo";
 const string WPEFramework::Plugin::Bluetooth::METHOD_SET_DEVICE_VOLUME_MUTE_INFO = "setDeviceVolumeMuteInfo";
+const string WPEFramework::Plugin::Bluetooth::METHOD_SET_EVENT_BATCHING = "setEventBatching";
 
 const string WPEFramework::Plugin::Bluetooth::EVT_STATUS_CHANGED = "onStatusChanged";
 const string WPEFramework::Plugin::Bluetooth::EVT_PAIRING_REQUEST = "onPairingRequest";
@@ -84,6 +85,7 @@ const string WPEFramework::Plugin::Bluetooth::EVT_DEVICE_FOUND = "onDeviceFound"
 const string WPEFramework::Plugin::Bluetooth::EVT_DEVICE_LOST_OR_OUT_OF_RANGE = "onDeviceLost";
 const string WPEFramework::Plugin::Bluetooth::EVT_DEVICE_DISCOVERY_UPDATE = "onDiscoveredDevice";
 const string WPEFramework::Plugin::Bluetooth::EVT_DEVICE_MEDIA_STATUS = "onDeviceMediaStatus";
+const string WPEFramework::Plugin::Bluetooth::EVT_DISCOVERED_DEVICES = "onDiscoveredDevices";
 
 const string WPEFramework::Plugin::Bluetooth::STATUS_NO_BLUETOOTH_HARDWARE = "NO_BLUETOOTH_HARDWARE";
 const string WPEFramework::Plugin::Bluetooth::STATUS_SOFTWARE_DISABLED = "SOFTWARE_DISABLED";
@@ -159,6 +161,9 @@ namespace WPEFramework
         , m_apiVersionNumber(API_VERSION_NUMBER_MAJOR)
         , m_discoveryRunning(false)
         , m_discoveryTimer(this)
+        , m_registry()
+        , m_batchInterval(0)
+        , m_batchVersion(0)
         {
             Bluetooth::_instance = this;
             Register(METHOD_GET_API_VERSION_NUMBER, &Bluetooth::getApiVersionNumber, this);
@@ -184,6 +189,10 @@ namespace WPEFramework
             Register(METHOD_GET_AUDIO_INFO, &Bluetooth::getMediaTrackInfoWrapper, this);
             Register(METHOD_GET_DEVICE_VOLUME_MUTE_INFO, &Bluetooth::getDeviceVolumeMuteInfoWrapper, this);
             Register(METHOD_SET_DEVICE_VOLUME_MUTE_INFO, &Bluetooth::setDeviceVolumeMuteInfoWrapper, this);
+            Register(METHOD_SET_EVENT_BATCHING, &Bluetooth::setEventBatchingWrapper, this);
+
+            m_batchTimer.setSingleShot(true);
+            m_batchTimer.connect(std::bind(&Bluetooth::onBatchTimer, this));
 
             Utils::IARM::init();
 
@@ -204,6 +213,11 @@ namespace WPEFramework
         void Bluetooth::Deinitialize(PluginHost::IShell* /* service */)
         {
             Bluetooth::_instance = nullptr;
+            m_batchInterval = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_batchTimerMutex);
+                m_batchTimer.stop();
+            }
 
             BTRMGR_Result_t rc = BTRMGR_UnRegisterFromCallbacks(Utils::IARM::NAME);
             if (BTRMGR_RESULT_SUCCESS != rc)
@@ -380,9 +394,8 @@ namespace WPEFramework
             stopDeviceDiscovery();
         }
 
-        JsonArray Bluetooth::getDiscoveredDevices()
+        void Bluetooth::syncDiscoveredDevices()
         {
-            JsonArray deviceArray;
             BTRMGR_DiscoveredDevicesList_t discoveredDevices;
 
             memset (&discoveredDevices, 0, sizeof(discoveredDevices));
@@ -393,32 +406,30 @@ namespace WPEFramework
             }
             else
             {
-                int i = 0;
-                JsonObject deviceDetails;
+                DeviceRegistry::Devices devices;
                 LOGINFO ("Success....   Discovered %d Devices", discoveredDevices.m_numOfDevices);
-                for (; i < discoveredDevices.m_numOfDevices; i++)
+                for (int i = 0; i < discoveredDevices.m_numOfDevices; i++)
                 {
-                    deviceDetails["deviceID"] = std::to_string(discoveredDevices.m_deviceProperty[i].m_deviceHandle);
-                    deviceDetails["name"] = string(discoveredDevices.m_deviceProperty[i].m_name);
-                    deviceDetails["deviceType"] = string(BTRMGR_GetDeviceTypeAsString(discoveredDevices.m_deviceProperty[i].m_deviceType));
-                    deviceDetails["connected"] = discoveredDevices.m_deviceProperty[i].m_isConnected?true:false;
-                    deviceDetails["paired"] = discoveredDevices.m_deviceProperty[i].m_isPairedDevice?true:false;
-                    deviceDetails["rawDeviceType"] = std::to_string(discoveredDevices.m_deviceProperty[i].m_ui32DevClassBtSpec);
-                    deviceDetails["rawBleDeviceType"] = std::to_string(discoveredDevices.m_deviceProperty[i].m_ui16DevAppearanceBleSpec);
-                    deviceArray.Add(deviceDetails);
+                    DeviceRegistry::Device device;
+                    device.name = string(discoveredDevices.m_deviceProperty[i].m_name);
+                    device.deviceType = string(BTRMGR_GetDeviceTypeAsString(discoveredDevices.m_deviceProperty[i].m_deviceType));
+                    device.connected = discoveredDevices.m_deviceProperty[i].m_isConnected?true:false;
+                    device.paired = discoveredDevices.m_deviceProperty[i].m_isPairedDevice?true:false;
+                    device.rawDeviceType = discoveredDevices.m_deviceProperty[i].m_ui32DevClassBtSpec;
+                    device.rawBleDeviceType = discoveredDevices.m_deviceProperty[i].m_ui16DevAppearanceBleSpec;
+                    devices.emplace_back(discoveredDevices.m_deviceProperty[i].m_deviceHandle, device);
                 }
+                m_registry.Sync(DeviceRegistry::DISCOVERED, devices);
             }
-            return deviceArray;
         }
 
-        JsonArray Bluetooth::getPairedDevices()
+        void Bluetooth::syncPairedDevices()
         {
-            JsonArray deviceArray;
             BTRMGR_PairedDevicesList_t *pairedDevices = (BTRMGR_PairedDevicesList_t*)malloc(sizeof(BTRMGR_PairedDevicesList_t));
             if(pairedDevices == nullptr)
             {
                 LOGERR("Failed to allocate memory");
-                return deviceArray;
+                return;
             }
 
             memset (pairedDevices, 0, sizeof(BTRMGR_PairedDevicesList_t));
@@ -429,25 +440,142 @@ namespace WPEFramework
             }
             else
             {
-                int i = 0;
-                JsonObject deviceDetails;
+                DeviceRegistry::Devices devices;
                 LOGINFO ("Success....   Paired %d Devices", pairedDevices->m_numOfDevices);
-                for (; i < pairedDevices->m_numOfDevices; i++)
+                for (int i = 0; i < pairedDevices->m_numOfDevices; i++)
                 {
-                    deviceDetails["deviceID"] = std::to_string(pairedDevices->m_deviceProperty[i].m_deviceHandle);
-                    deviceDetails["name"] = string(pairedDevices->m_deviceProperty[i].m_name);
-                    deviceDetails["deviceType"] = string(BTRMGR_GetDeviceTypeAsString(pairedDevices->m_deviceProperty[i].m_deviceType));
-                    deviceDetails["connected"] = pairedDevices->m_deviceProperty[i].m_isConnected?true:false;
-                    deviceDetails["rawDeviceType"] = std::to_string(pairedDevices->m_deviceProperty[i].m_ui32DevClassBtSpec);
-                    deviceDetails["rawBleDeviceType"] = std::to_string(pairedDevices->m_deviceProperty[i].m_ui16DevAppearanceBleSpec);
-
-                    deviceArray.Add(deviceDetails);
+                    DeviceRegistry::Device device;
+                    device.name = string(pairedDevices->m_deviceProperty[i].m_name);
+                    device.deviceType = string(BTRMGR_GetDeviceTypeAsString(pairedDevices->m_deviceProperty[i].m_deviceType));
+                    device.connected = pairedDevices->m_deviceProperty[i].m_isConnected?true:false;
+                    device.rawDeviceType = pairedDevices->m_deviceProperty[i].m_ui32DevClassBtSpec;
+                    device.rawBleDeviceType = pairedDevices->m_deviceProperty[i].m_ui16DevAppearanceBleSpec;
+                    devices.emplace_back(pairedDevices->m_deviceProperty[i].m_deviceHandle, device);
                 }
+                m_registry.Sync(DeviceRegistry::PAIRED, devices);
             }
             free(pairedDevices);
+        }
+
+        // Devices of the list from the registry; BTRMgr is only asked when the registry lost track of the list.
+        JsonArray Bluetooth::getRegisteredDevices(DeviceRegistry::list which, uint64_t sinceVersion, JsonArray& removed, uint64_t& version, bool& delta)
+        {
+            if (!m_registry.IsSynced(which))
+            {
+                if (which == DeviceRegistry::DISCOVERED)
+                    syncDiscoveredDevices();
+                else
+                    syncPairedDevices();
+            }
+
+            DeviceRegistry::Devices devices;
+            std::vector<uint64_t> gone;
+            delta = m_registry.Changes(which, sinceVersion, devices, gone, version);
+
+            JsonArray deviceArray;
+            for (const auto& entry : devices)
+            {
+                JsonObject deviceDetails;
+                deviceDetails["deviceID"] = std::to_string(entry.first);
+                deviceDetails["name"] = entry.second.name;
+                deviceDetails["deviceType"] = entry.second.deviceType;
+                deviceDetails["connected"] = entry.second.connected;
+                if (which == DeviceRegistry::DISCOVERED)
+                    deviceDetails["paired"] = entry.second.paired;
+                deviceDetails["rawDeviceType"] = std::to_string(entry.second.rawDeviceType);
+                deviceDetails["rawBleDeviceType"] = std::to_string(entry.second.rawBleDeviceType);
+                deviceArray.Add(deviceDetails);
+            }
+            for (uint64_t handle : gone)
+                removed.Add(std::to_string(handle));
+
             return deviceArray;
         }
 
+        // Keeps the registry in line with what the event says about the device.
+        void Bluetooth::updateRegistry(BTRMGR_EventMessage_t &eventMsg)
+        {
+            bool changed = false;
+
+            switch (eventMsg.m_eventType) {
+                case BTRMGR_EVENT_DEVICE_DISCOVERY_STARTED:
+                case BTRMGR_EVENT_DEVICE_DISCOVERY_COMPLETE:
+                    // Once per scan BTRMgr gets the final word on the discovered list.
+                    m_registry.Invalidate(DeviceRegistry::DISCOVERED);
+                    break;
+
+                case BTRMGR_EVENT_DEVICE_DISCOVERY_UPDATE:
+                case BTRMGR_EVENT_DEVICE_PAIRING_COMPLETE:
+                {
+                    const auto& info = eventMsg.m_discoveredDevice;
+                    const bool update = (eventMsg.m_eventType == BTRMGR_EVENT_DEVICE_DISCOVERY_UPDATE);
+                    changed = m_registry.Modify(info.m_deviceHandle, [&](DeviceRegistry::Device& device) {
+                        device.name = string(info.m_name);
+                        device.deviceType = string(BTRMGR_GetDeviceTypeAsString(info.m_deviceType));
+                        device.rawDeviceType = info.m_ui32DevClassBtSpec;
+                        device.rawBleDeviceType = info.m_ui16DevAppearanceBleSpec;
+                        device.paired = info.m_isPairedDevice ? true : false;
+                        if (update)
+                            device.discovered = info.m_isDiscovered ? true : false;
+                        else
+                            device.connected = info.m_isConnected ? true : false;
+                    });
+                    break;
+                }
+
+                case BTRMGR_EVENT_DEVICE_UNPAIRING_COMPLETE:
+                case BTRMGR_EVENT_DEVICE_CONNECTION_COMPLETE:
+                case BTRMGR_EVENT_DEVICE_DISCONNECT_COMPLETE:
+                case BTRMGR_EVENT_DEVICE_FOUND:
+                {
+                    const auto& info = eventMsg.m_pairedDevice;
+                    const bool unpaired = (eventMsg.m_eventType == BTRMGR_EVENT_DEVICE_UNPAIRING_COMPLETE);
+                    const bool found = (eventMsg.m_eventType == BTRMGR_EVENT_DEVICE_FOUND);
+                    changed = m_registry.Modify(info.m_deviceHandle, [&](DeviceRegistry::Device& device) {
+                        device.name = string(info.m_name);
+                        device.deviceType = string(BTRMGR_GetDeviceTypeAsString(info.m_deviceType));
+                        device.rawDeviceType = info.m_ui32DevClassBtSpec;
+                        device.rawBleDeviceType = info.m_ui16DevAppearanceBleSpec;
+                        device.paired = !unpaired;
+                        if (!found)
+                            device.connected = info.m_isConnected ? true : false;
+                    });
+                    break;
+                }
+
+                default:
+                    break;
+            }
+
+            if (changed && (m_batchInterval != 0))
+            {
+                std::lock_guard<std::mutex> lock(m_batchTimerMutex);
+                if (!m_batchTimer.isActive())
+                    m_batchTimer.start(m_batchInterval);
+            }
+        }
+
+        void Bluetooth::onBatchTimer()
+        {
+            std::lock_guard<std::mutex> lock(m_batchMutex);
+
+            JsonArray removed;
+            uint64_t version = 0;
+            bool delta = false;
+            JsonArray devices = getRegisteredDevices(DeviceRegistry::DISCOVERED, m_batchVersion, removed, version, delta);
+
+            if (version != m_batchVersion)
+            {
+                JsonObject params;
+                params["version"] = version;
+                params["delta"] = delta;
+                params["discoveredDevices"] = devices;
+                params["removedDevices"] = removed;
+                m_batchVersion = version;
+                sendNotify(C_STR(EVT_DISCOVERED_DEVICES), params);
+            }
+        }
+
         JsonArray Bluetooth::getConnectedDevices()
         {
             JsonArray deviceArray;
@@ -889,6 +1017,7 @@ namespace WPEFramework
             string profileInfo;
             string eventId;
             LOGINFO ("Event notification: event of type %d received", eventMsg.m_eventType);
+            updateRegistry(eventMsg);
             switch (eventMsg.m_eventType) {
                 case BTRMGR_EVENT_DEVICE_DISCOVERY_COMPLETE:
                     LOGINFO ("Received %s Event from BTRMgr", C_STR(STATUS_DISCOVERY_COMPLETED));
@@ -1231,6 +1360,12 @@ namespace WPEFramework
                     break;
             }
 
+            if ((eventId == EVT_DEVICE_DISCOVERY_UPDATE) && (m_batchInterval != 0))
+            {
+                // Coalesced into the next onDiscoveredDevices event.
+                eventId.clear();
+            }
+
             if (!eventId.empty())
             {
                 sendNotify(C_STR(eventId), params);
@@ -1330,16 +1465,36 @@ namespace WPEFramework
         uint32_t Bluetooth::getDiscoveredDevicesWrapper(const JsonObject& parameters, JsonObject& response)
         {
             LOGINFOMETHOD();
-            UNUSED(parameters);
-            response["discoveredDevices"] = getDiscoveredDevices();
+            uint64_t sinceVersion = parameters.HasLabel("sinceVersion") ? static_cast<uint64_t>(parameters["sinceVersion"].Number()) : 0;
+            JsonArray removed;
+            uint64_t version = 0;
+            bool delta = false;
+
+            response["discoveredDevices"] = getRegisteredDevices(DeviceRegistry::DISCOVERED, sinceVersion, removed, version, delta);
+            response["version"] = version;
+            if (parameters.HasLabel("sinceVersion"))
+            {
+                response["delta"] = delta;
+                response["removedDevices"] = removed;
+            }
             returnResponse(true);
         }
 
         uint32_t Bluetooth::getPairedDevicesWrapper(const JsonObject& parameters, JsonObject& response)
         {
             LOGINFOMETHOD();
-            UNUSED(parameters);
-            response["pairedDevices"] = getPairedDevices();
+            uint64_t sinceVersion = parameters.HasLabel("sinceVersion") ? static_cast<uint64_t>(parameters["sinceVersion"].Number()) : 0;
+            JsonArray removed;
+            uint64_t version = 0;
+            bool delta = false;
+
+            response["pairedDevices"] = getRegisteredDevices(DeviceRegistry::PAIRED, sinceVersion, removed, version, delta);
+            response["version"] = version;
+            if (parameters.HasLabel("sinceVersion"))
+            {
+                response["delta"] = delta;
+                response["removedDevices"] = removed;
+            }
             returnResponse(true);
         }
 
@@ -1750,6 +1905,35 @@ namespace WPEFramework
             }
             returnResponse(successFlag);
         }
+
+        uint32_t Bluetooth::setEventBatchingWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            bool successFlag = false;
+            if (parameters.HasLabel("interval"))
+            {
+                int interval = 0;
+                getNumberParameter("interval", interval);
+                if (interval >= 0)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_batchMutex);
+                        m_batchVersion = m_registry.Version();
+                    }
+                    m_batchInterval = static_cast<uint32_t>(interval);
+                    if (interval == 0)
+                    {
+                        std::lock_guard<std::mutex> lock(m_batchTimerMutex);
+                        m_batchTimer.stop();
+                    }
+                    LOGINFO("Discovery event batching %s (%d ms)", interval ? "enabled" : "disabled", interval);
+                    successFlag = true;
+                }
+            }
+            if (!successFlag)
+                LOGERR("Please specify parameters. Example: \"params\": {\"interval\": 500}");
+            returnResponse(successFlag);
+        }
         //
         /// Registered methods end
 
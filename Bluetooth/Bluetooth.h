@@ -19,10 +19,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <thread>
 
 #include "Module.h"
 #include "UtilsThreadRAII.h"
+#include "DeviceRegistry.h"
+#include "tptimer.h"
 
 #include "btmgr.h" //TODO: can we move it to the module? Required by notifyEventWrapper()
 
@@ -97,6 +101,7 @@ namespace WPEFramework {
             uint32_t getMediaTrackInfoWrapper(const JsonObject& parameters, JsonObject& response);
             uint32_t getDeviceVolumeMuteInfoWrapper(const JsonObject& parameters, JsonObject& response);
             uint32_t setDeviceVolumeMuteInfoWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t setEventBatchingWrapper(const JsonObject& parameters, JsonObject& response);
             // Registered methods end
 
         private: /*internal methods*/
@@ -107,8 +112,11 @@ namespace WPEFramework {
             void startDiscoveryTimer(int msec);
             void stopDiscoveryTimer();
             void onDiscoveryTimer();
-            JsonArray getDiscoveredDevices();
-            JsonArray getPairedDevices();
+            void syncDiscoveredDevices();
+            void syncPairedDevices();
+            JsonArray getRegisteredDevices(DeviceRegistry::list which, uint64_t sinceVersion, JsonArray& removed, uint64_t& version, bool& delta);
+            void updateRegistry(BTRMGR_EventMessage_t &eventMsg);
+            void onBatchTimer();
             JsonArray getConnectedDevices();
             bool setDeviceConnection(long long int deviceID, const string &enable, const string &deviceType = "UNKNOWN DEVICE");
             bool setAudioStream(long long int deviceID, const string &audioStreamName);
@@ -151,6 +159,7 @@ namespace WPEFramework {
             static const string METHOD_GET_API_VERSION_NUMBER;
             static const string METHOD_GET_DEVICE_VOLUME_MUTE_INFO;
             static const string METHOD_SET_DEVICE_VOLUME_MUTE_INFO;
+            static const string METHOD_SET_EVENT_BATCHING;
             static const string EVT_STATUS_CHANGED;
             static const string EVT_PAIRING_REQUEST;
             static const string EVT_REQUEST_FAILED;
@@ -169,6 +178,7 @@ namespace WPEFramework {
             static const string EVT_DEVICE_LOST_OR_OUT_OF_RANGE;
             static const string EVT_DEVICE_DISCOVERY_UPDATE;
             static const string EVT_DEVICE_MEDIA_STATUS;
+            static const string EVT_DISCOVERED_DEVICES;
 
             Bluetooth();
             virtual ~Bluetooth();
@@ -228,6 +238,16 @@ namespace WPEFramework {
             bool m_discoveryRunning;
             DiscoveryTimer m_discoveryTimer;
             friend class DiscoveryTimer;
+
+            DeviceRegistry m_registry;
+            // With a batching interval, onDiscoveredDevice events are replaced by one onDiscoveredDevices
+            // event per interval carrying the changes since the previous one.
+            std::atomic<uint32_t> m_batchInterval;
+            uint64_t m_batchVersion;
+            std::mutex m_batchMutex;
+            // The timer is started from the IARM event thread and stopped from JSON-RPC calls.
+            std::mutex m_batchTimerMutex;
+            TpTimer m_batchTimer;
         };
 	} // Plugin
 } // WPEFramework
@@ -0,0 +1,241 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        // The devices BTRMgr reported, kept current from its events so the "get devices" calls do not go
+        // over IPC every time a pairing screen polls. Every change stamps the device with the next version
+        // of the registry, which lets a client ask for what changed since the version it last saw.
+        // Devices that left all lists are kept as tombstones for those queries; when too many of them pile
+        // up the oldest are dropped and older versions can only be answered with the full list.
+        class DeviceRegistry {
+        public:
+            enum list {
+                DISCOVERED = 0,
+                PAIRED = 1
+            };
+
+            struct Device {
+                Device()
+                    : name()
+                    , deviceType()
+                    , rawDeviceType(0)
+                    , rawBleDeviceType(0)
+                    , discovered(false)
+                    , paired(false)
+                    , connected(false)
+                    , version(0)
+                {
+                }
+
+                bool operator==(const Device& other) const
+                {
+                    return ((name == other.name) && (deviceType == other.deviceType) && (rawDeviceType == other.rawDeviceType)
+                        && (rawBleDeviceType == other.rawBleDeviceType) && (discovered == other.discovered)
+                        && (paired == other.paired) && (connected == other.connected));
+                }
+
+                bool In(const list which) const
+                {
+                    return (which == DISCOVERED ? discovered : paired);
+                }
+
+                string name;
+                string deviceType;
+                uint32_t rawDeviceType;
+                uint16_t rawBleDeviceType;
+                bool discovered;
+                bool paired;
+                bool connected;
+                uint64_t version;
+            };
+
+            typedef std::vector<std::pair<uint64_t, Device>> Devices;
+
+            DeviceRegistry(const DeviceRegistry&) = delete;
+            DeviceRegistry& operator=(const DeviceRegistry&) = delete;
+
+            DeviceRegistry()
+                : _adminLock()
+                , _devices()
+                , _version(0)
+                , _horizon(0)
+            {
+                _synced[DISCOVERED] = false;
+                _synced[PAIRED] = false;
+            }
+            ~DeviceRegistry() = default;
+
+        public:
+            uint64_t Version() const
+            {
+                _adminLock.Lock();
+                uint64_t result = _version;
+                _adminLock.Unlock();
+                return (result);
+            }
+
+            bool IsSynced(const list which) const
+            {
+                _adminLock.Lock();
+                bool result = _synced[which];
+                _adminLock.Unlock();
+                return (result);
+            }
+
+            // The next query of this list goes to BTRMgr again.
+            void Invalidate(const list which)
+            {
+                _adminLock.Lock();
+                _synced[which] = false;
+                _adminLock.Unlock();
+            }
+
+            // Takes over the list as BTRMgr reports it: listed devices are updated, others leave the list.
+            void Sync(const list which, const Devices& devices)
+            {
+                _adminLock.Lock();
+
+                std::map<uint64_t, bool> listed;
+                for (const auto& entry : devices) {
+                    Device device(entry.second);
+                    if (which == DISCOVERED) {
+                        device.discovered = true;
+                    } else {
+                        device.paired = true;
+                        auto current = _devices.find(entry.first);
+                        device.discovered = ((current != _devices.end()) && (current->second.discovered));
+                    }
+                    Store(entry.first, device);
+                    listed[entry.first] = true;
+                }
+
+                for (auto& entry : _devices) {
+                    if ((entry.second.In(which) == true) && (listed.find(entry.first) == listed.end())) {
+                        Device device(entry.second);
+                        (which == DISCOVERED ? device.discovered : device.paired) = false;
+                        Store(entry.first, device);
+                    }
+                }
+
+                _synced[which] = true;
+                Prune();
+
+                _adminLock.Unlock();
+            }
+
+            // Applies an event: modify gets a copy of the device (a default one if it is new) to change.
+            template <typename MODIFIER>
+            bool Modify(const uint64_t handle, MODIFIER&& modify)
+            {
+                _adminLock.Lock();
+
+                auto current = _devices.find(handle);
+                Device device(current != _devices.end() ? current->second : Device());
+                modify(device);
+                bool changed = Store(handle, device);
+                Prune();
+
+                _adminLock.Unlock();
+
+                return (changed);
+            }
+
+            // Devices in the list; with since != 0 only those changed after that version plus the handles
+            // of those that left the list. Returns false when since is too old for a delta and the full
+            // list was returned instead.
+            bool Changes(const list which, const uint64_t since, Devices& present, std::vector<uint64_t>& removed, uint64_t& version) const
+            {
+                _adminLock.Lock();
+
+                const bool delta = ((since != 0) && (since >= _horizon) && (since <= _version));
+
+                for (const auto& entry : _devices) {
+                    if ((delta == false) || (entry.second.version > since)) {
+                        if (entry.second.In(which) == true) {
+                            present.emplace_back(entry.first, entry.second);
+                        } else if (delta == true) {
+                            removed.push_back(entry.first);
+                        }
+                    }
+                }
+                version = _version;
+
+                _adminLock.Unlock();
+
+                return (delta);
+            }
+
+        private:
+            bool Store(const uint64_t handle, Device& device)
+            {
+                auto current = _devices.find(handle);
+                if ((current != _devices.end()) && (current->second == device)) {
+                    return (false);
+                }
+                if ((current == _devices.end()) && (device.discovered == false) && (device.paired == false) && (device.connected == false)) {
+                    // Never seen in a list, nothing a client could have to forget.
+                    return (false);
+                }
+
+                device.version = ++_version;
+                _devices[handle] = device;
+
+                return (true);
+            }
+
+            void Prune()
+            {
+                static constexpr size_t MaxTombstones = 64;
+
+                std::vector<std::pair<uint64_t, uint64_t>> tombstones;
+                for (const auto& entry : _devices) {
+                    if ((entry.second.discovered == false) && (entry.second.paired == false) && (entry.second.connected == false)) {
+                        tombstones.emplace_back(entry.second.version, entry.first);
+                    }
+                }
+
+                if (tombstones.size() > MaxTombstones) {
+                    std::sort(tombstones.begin(), tombstones.end());
+                    for (size_t index = 0; index < (tombstones.size() - MaxTombstones); index++) {
+                        _horizon = std::max(_horizon, tombstones[index].first);
+                        _devices.erase(tombstones[index].second);
+                    }
+                }
+            }
+
+        private:
+            mutable Core::CriticalSection _adminLock;
+            std::map<uint64_t, Device> _devices;
+            uint64_t _version;
+            uint64_t _horizon;
+            bool _synced[2];
+        };
+
+    } // Plugin
+} // WPEFramework
@@ -24,7 +24,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 2
+#define API_VERSION_NUMBER_PATCH 4
 
 namespace WPEFramework {
 
@@ -80,6 +80,9 @@ namespace Plugin {
 
         SYSLOG(Logging::Startup, (_T("grpc endpoint is %s"), uri.c_str()));
 
+        Core::SystemInfo::SetEnvironment(PATH_ENV, _config.Path.Value());
+        Core::SystemInfo::SetEnvironment(MAXAGE_ENV, std::to_string(_config.MaxAge.Value()));
+
         string token;
         auto security = _service->QueryInterfaceByCallsign<
             PluginHost::IAuthenticate>("SecurityAgent");
@@ -37,10 +37,14 @@ namespace Plugin {
                 : Core::JSON::Container()
             {
                 Add(_T("uri"), &Uri);
+                Add(_T("path"), &Path);
+                Add(_T("maxage"), &MaxAge);
             }
 
         public:
             Core::JSON::String Uri;
+            Core::JSON::String Path;
+            Core::JSON::DecUInt32 MaxAge;
         };
 
         class Store2Notification : public Exchange::IStore2::INotification {
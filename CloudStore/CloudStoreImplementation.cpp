@@ -19,6 +19,7 @@
 
 #include "CloudStoreImplementation.h"
 #include "grpc/Store2.h"
+#include "sqlite/Store2.h"
 
 namespace WPEFramework {
 namespace Plugin {
@@ -26,9 +27,21 @@ namespace Plugin {
     SERVICE_REGISTRATION(CloudStoreImplementation, 1, 0);
 
     CloudStoreImplementation::CloudStoreImplementation()
-        : _accountStore2(Core::Service<Grpc::Store2>::Create<Exchange::IStore2>())
+        : _accountStore2(nullptr)
     {
-        ASSERT(_accountStore2 != nullptr);
+        auto upstream = Core::Service<Grpc::Store2>::Create<Grpc::Store2>();
+        ASSERT(upstream != nullptr);
+
+        // Writes are journaled locally and replayed to the cloud, reads are cached,
+        // both kept apart per identity. The local store holds a reference to upstream.
+        auto path = getenv(PATH_ENV);
+        if ((path != nullptr) && (path[0] != '\0')) {
+            _accountStore2 = Core::Service<Sqlite::Store2>::Create<Exchange::IStore2>(
+                upstream, [upstream]() { return upstream->Identity(); });
+            upstream->Release();
+        } else {
+            _accountStore2 = upstream;
+        }
     }
 
     CloudStoreImplementation::~CloudStoreImplementation()
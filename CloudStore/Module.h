@@ -31,6 +31,8 @@
 
 #define URI_ENV "CLOUDSTORE_URI"
 #define TOKEN_ENV "CLOUDSTORE_TOKEN"
+#define PATH_ENV "CLOUDSTORE_PATH"
+#define MAXAGE_ENV "CLOUDSTORE_MAXAGE"
 #define IARM_INIT_NAME "Thunder_Plugins"
 #define URI_RFC "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.CloudStore.Uri"
 #define PARTNER_ID_FILENAME "/opt/www/authService/partnerId3.dat"
@@ -40,6 +42,11 @@
 #define JSON_RPC_TIMEOUT 2000
 #define GRPC_TIMEOUT 3000
 #define IDLE_TIMEOUT 30000
+#define TOKEN_DEFAULT_LIFETIME 3600
+#define TOKEN_REFRESH_MARGIN 60
+#define SQLITE_TIMEOUT 1000
+#define REPLAY_MIN_DELAY 1000
+#define REPLAY_MAX_DELAY 300000
 
 #undef EXTERNAL
 #define EXTERNAL
@@ -21,6 +21,7 @@
 
 #include "../Module.h"
 #include "secure_storage.grpc.pb.h"
+#include <chrono>
 #include <fstream>
 #include <grpcpp/create_channel.h>
 #include <interfaces/IStore2.h>
@@ -62,6 +63,25 @@ namespace Plugin {
                 const string _key;
                 const string _value;
             };
+            class TokenJob : public Core::IDispatch {
+            public:
+                TokenJob(Store2* parent)
+                    : _parent(parent)
+                {
+                    _parent->AddRef();
+                }
+                ~TokenJob() override
+                {
+                    _parent->Release();
+                }
+                void Dispatch() override
+                {
+                    _parent->RefreshToken();
+                }
+
+            private:
+                Store2* _parent;
+            };
 
         private:
             Store2(const Store2&) = delete;
@@ -77,10 +97,20 @@ namespace Plugin {
                 , _uri(uri)
                 , _token(token)
                 , _authorization((_uri.find("localhost") == string::npos) && (_uri.find("0.0.0.0") == string::npos))
+                , _authEventRegistered(false)
+                , _tokenRefreshing(false)
+                , _identityValid(false)
+                , _iarmConnected(false)
+                , _timeSynced(false)
             {
                 Open();
             }
-            ~Store2() override = default;
+            ~Store2() override
+            {
+                if (_authEventRegistered) {
+                    _authService->Unsubscribe(JSON_RPC_TIMEOUT, _T("serviceAccessTokenChanged"));
+                }
+            }
 
         private:
             void Open()
@@ -98,75 +128,174 @@ namespace Plugin {
             }
 
         private:
-            bool IsTimeSynced() const
+            bool IsTimeSynced()
             {
 #ifdef WITH_SYSMGR
-                // Get actual state, as it may change at any time...
-                IARM_Bus_Init(IARM_INIT_NAME);
-                IARM_Bus_Connect();
-                IARM_Bus_SYSMgr_GetSystemStates_Param_t param;
-                if ((IARM_Bus_Call_with_IPCTimeout(
-                         IARM_BUS_SYSMGR_NAME,
-                         IARM_BUS_SYSMGR_API_GetSystemStates,
-                         &param,
-                         sizeof(param),
-                         IARM_TIMEOUT) // Timeout
-                        != IARM_RESULT_SUCCESS)
-                    || !param.time_source.state) {
-                    return false;
+                // Once synced, time stays synced. Until then, get actual state, as it may change at any time...
+                Core::SafeSyncType<Core::CriticalSection> lock(_timeLock);
+                if (!_timeSynced) {
+                    if (!_iarmConnected) {
+                        IARM_Bus_Init(IARM_INIT_NAME);
+                        IARM_Bus_Connect();
+                        _iarmConnected = true;
+                    }
+                    IARM_Bus_SYSMgr_GetSystemStates_Param_t param;
+                    _timeSynced = (IARM_Bus_Call_with_IPCTimeout(
+                                       IARM_BUS_SYSMGR_NAME,
+                                       IARM_BUS_SYSMGR_API_GetSystemStates,
+                                       &param,
+                                       sizeof(param),
+                                       IARM_TIMEOUT) // Timeout
+                                      == IARM_RESULT_SUCCESS)
+                        && param.time_source.state;
                 }
-#endif
+                return _timeSynced;
+#else
                 return true;
+#endif
             }
-            string GetToken() const
+            string GetToken()
             {
-                // Get actual token, as it may change at any time...
-                string result;
+                // The token is refreshed in the background before it expires,
+                // and fetched here only when there is none or it has expired.
+                {
+                    Core::SafeSyncType<Core::CriticalSection> lock(_authLock);
+
+                    const auto now = std::chrono::steady_clock::now();
+                    if (!_tokenValue.empty() && (now < _tokenExpiry)) {
+                        if ((now >= _tokenRefresh) && !_tokenRefreshing) {
+                            _tokenRefreshing = true;
+                            Core::IWorkerPool::Instance().Submit(Core::ProxyType<Core::IDispatch>(
+                                Core::ProxyType<TokenJob>::Create(this)));
+                        }
+                        return _tokenValue;
+                    }
+                }
+
+                return RefreshToken();
+            }
+            string RefreshToken()
+            {
+                // One request at a time, the others get its result
+                Core::SafeSyncType<Core::CriticalSection> refreshLock(_refreshLock);
+
+                {
+                    Core::SafeSyncType<Core::CriticalSection> lock(_authLock);
 
-                Core::SystemInfo::SetEnvironment(_T("THUNDER_ACCESS"), (_T("127.0.0.1:9998")));
-                auto link = Core::ProxyType<JSONRPC::LinkType<Core::JSON::IElement>>::Create(
-                    _T("org.rdk.AuthService"), _T(""), false, "token=" + _token);
+                    if (!_tokenValue.empty() && (std::chrono::steady_clock::now() < _tokenRefresh)) {
+                        _tokenRefreshing = false;
+                        return _tokenValue;
+                    }
+                }
+
+                if (!_authService.IsValid()) {
+                    Core::SystemInfo::SetEnvironment(_T("THUNDER_ACCESS"), (_T("127.0.0.1:9998")));
+                    _authService = Core::ProxyType<JSONRPC::LinkType<Core::JSON::IElement>>::Create(
+                        _T("org.rdk.AuthService"), _T(""), false, "token=" + _token);
+                }
+
+                string result;
+                uint32_t lifetime = TOKEN_DEFAULT_LIFETIME;
 
                 JsonObject json;
-                auto status = link->Invoke<JsonObject, JsonObject>(
+                auto status = _authService->Invoke<JsonObject, JsonObject>(
                     JSON_RPC_TIMEOUT, // Timeout
                     _T("getServiceAccessToken"),
                     JsonObject(),
                     json);
                 if (status == Core::ERROR_NONE) {
                     result = json[_T("token")].String();
+                    if (json.HasLabel(_T("expires")) && (json[_T("expires")].Number() > 0)) {
+                        lifetime = json[_T("expires")].Number();
+                    }
                 } else {
                     TRACE(Trace::Error, (_T("sat status %d"), status));
                 }
 
+                if ((status == Core::ERROR_NONE) && !_authEventRegistered) {
+                    _authEventRegistered = (_authService->Subscribe<JsonObject>(JSON_RPC_TIMEOUT,
+                                                _T("serviceAccessTokenChanged"), &Store2::OnServiceAccessTokenChanged, this)
+                        == Core::ERROR_NONE);
+                }
+
+                Core::SafeSyncType<Core::CriticalSection> lock(_authLock);
+
+                _tokenRefreshing = false;
+                if (!result.empty()) {
+                    const auto now = std::chrono::steady_clock::now();
+                    const uint32_t margin = (lifetime > (2 * TOKEN_REFRESH_MARGIN)) ? TOKEN_REFRESH_MARGIN : (lifetime / 2);
+                    _tokenValue = result;
+                    _tokenExpiry = now + std::chrono::seconds(lifetime);
+                    _tokenRefresh = _tokenExpiry - std::chrono::seconds(margin);
+                }
+
                 return result;
             }
-            string GetPartnerId() const
+            void OnServiceAccessTokenChanged(const JsonObject&)
             {
-                // Get actual id, as it may change at any time...
-                std::ifstream input(PARTNER_ID_FILENAME);
-                string line;
-                getline(input, line);
-                return line;
+                TRACE(Trace::Information, (_T("sat changed")));
+
+                // A new token may come with a new account, read the ids again too
+                Core::SafeSyncType<Core::CriticalSection> lock(_authLock);
+                _tokenValue.clear();
+                _identityValid = false;
+                if (!_tokenRefreshing) {
+                    _tokenRefreshing = true;
+                    Core::IWorkerPool::Instance().Submit(Core::ProxyType<Core::IDispatch>(
+                        Core::ProxyType<TokenJob>::Create(this)));
+                }
             }
-            string GetAccountId() const
+            void OnAuthError(const grpc::Status& status)
             {
-                // Get actual id, as it may change at any time...
-                std::ifstream input(ACCOUNT_ID_FILENAME);
-                string line;
-                getline(input, line);
-                return line;
+                if ((status.error_code() == grpc::StatusCode::UNAUTHENTICATED)
+                    || (status.error_code() == grpc::StatusCode::PERMISSION_DENIED)) {
+                    Core::SafeSyncType<Core::CriticalSection> lock(_authLock);
+                    _tokenValue.clear();
+                    _identityValid = false;
+                }
             }
-            string GetDeviceId() const
+            static string ReadId(const char* filename)
             {
-                // Get actual id, as it may change at any time...
-                std::ifstream input(DEVICE_ID_FILENAME);
+                std::ifstream input(filename);
                 string line;
                 getline(input, line);
                 return line;
             }
+            void GetIdentity(string& partnerId, string& accountId, string& deviceId)
+            {
+                // The ids are read once, and again after an auth change
+                Core::SafeSyncType<Core::CriticalSection> lock(_authLock);
+
+                if (!_identityValid) {
+                    _partnerId = ReadId(PARTNER_ID_FILENAME);
+                    _accountId = ReadId(ACCOUNT_ID_FILENAME);
+                    _deviceId = ReadId(DEVICE_ID_FILENAME);
+                    // Not provisioned yet, keep reading
+                    _identityValid = !_partnerId.empty() && !_accountId.empty() && !_deviceId.empty();
+                }
+                partnerId = _partnerId;
+                accountId = _accountId;
+                deviceId = _deviceId;
+            }
+            template <typename REQUEST>
+            void SetIdentity(REQUEST& request)
+            {
+                string partnerId, accountId, deviceId;
+                GetIdentity(partnerId, accountId, deviceId);
+                request.set_partner_id(partnerId);
+                request.set_account_id(accountId);
+                request.set_device_id(deviceId);
+            }
 
         public:
+            // Who the calls are made for, changes with the account
+            string Identity()
+            {
+                string partnerId, accountId, deviceId;
+                GetIdentity(partnerId, accountId, deviceId);
+                return partnerId + '/' + accountId + '/' + deviceId;
+            }
+
             uint32_t Register(INotification* notification) override
             {
                 Core::SafeSyncType<Core::CriticalSection> lock(_clientLock);
@@ -205,9 +334,7 @@ namespace Plugin {
                 }
                 context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(GRPC_TIMEOUT)); // Timeout
                 ::distp::gateway::secure_storage::v1::UpdateValueRequest request;
-                request.set_partner_id(GetPartnerId());
-                request.set_account_id(GetAccountId());
-                request.set_device_id(GetDeviceId());
+                SetIdentity(request);
                 auto v = new ::distp::gateway::secure_storage::v1::Value();
                 v->set_value(value);
                 if (ttl != 0) {
@@ -235,6 +362,7 @@ namespace Plugin {
                     result = Core::ERROR_NONE;
                 } else {
                     OnError(__FUNCTION__, status);
+                    OnAuthError(status);
                     if (status.error_code() == grpc::StatusCode::INVALID_ARGUMENT) {
                         result = Core::ERROR_INVALID_INPUT_LENGTH;
                     } else {
@@ -254,9 +382,7 @@ namespace Plugin {
                 }
                 context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(GRPC_TIMEOUT)); // Timeout
                 ::distp::gateway::secure_storage::v1::GetValueRequest request;
-                request.set_partner_id(GetPartnerId());
-                request.set_account_id(GetAccountId());
-                request.set_device_id(GetDeviceId());
+                SetIdentity(request);
                 auto k = new ::distp::gateway::secure_storage::v1::Key();
                 k->set_app_id(ns);
                 k->set_key(key);
@@ -294,6 +420,7 @@ namespace Plugin {
                     }
                 } else {
                     OnError(__FUNCTION__, status);
+                    OnAuthError(status);
                     if (status.error_code() == grpc::StatusCode::INVALID_ARGUMENT) {
                         result = Core::ERROR_INVALID_INPUT_LENGTH;
                     } else if (status.error_code() == grpc::StatusCode::NOT_FOUND) {
@@ -315,9 +442,7 @@ namespace Plugin {
                 }
                 context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(GRPC_TIMEOUT)); // Timeout
                 ::distp::gateway::secure_storage::v1::DeleteValueRequest request;
-                request.set_partner_id(GetPartnerId());
-                request.set_account_id(GetAccountId());
-                request.set_device_id(GetDeviceId());
+                SetIdentity(request);
                 auto k = new ::distp::gateway::secure_storage::v1::Key();
                 k->set_app_id(ns);
                 k->set_key(key);
@@ -334,8 +459,11 @@ namespace Plugin {
                     result = Core::ERROR_NONE;
                 } else {
                     OnError(__FUNCTION__, status);
+                    OnAuthError(status);
                     if (status.error_code() == grpc::StatusCode::INVALID_ARGUMENT) {
                         result = Core::ERROR_INVALID_INPUT_LENGTH;
+                    } else if (status.error_code() == grpc::StatusCode::NOT_FOUND) {
+                        result = Core::ERROR_UNKNOWN_KEY;
                     } else {
                         result = Core::ERROR_GENERAL;
                     }
@@ -353,9 +481,7 @@ namespace Plugin {
                 }
                 context.set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(GRPC_TIMEOUT)); // Timeout
                 ::distp::gateway::secure_storage::v1::DeleteAllValuesRequest request;
-                request.set_partner_id(GetPartnerId());
-                request.set_account_id(GetAccountId());
-                request.set_device_id(GetDeviceId());
+                SetIdentity(request);
                 request.set_app_id(ns);
                 request.set_scope(scope == ScopeType::ACCOUNT
                         ? ::distp::gateway::secure_storage::v1::Scope::SCOPE_ACCOUNT
@@ -369,6 +495,7 @@ namespace Plugin {
                     result = Core::ERROR_NONE;
                 } else {
                     OnError(__FUNCTION__, status);
+                    OnAuthError(status);
                     result = Core::ERROR_GENERAL;
                 }
 
@@ -402,6 +529,21 @@ namespace Plugin {
             const string _uri;
             const string _token;
             const bool _authorization;
+            Core::ProxyType<JSONRPC::LinkType<Core::JSON::IElement>> _authService;
+            bool _authEventRegistered;
+            string _tokenValue;
+            std::chrono::steady_clock::time_point _tokenExpiry;
+            std::chrono::steady_clock::time_point _tokenRefresh;
+            bool _tokenRefreshing;
+            string _partnerId;
+            string _accountId;
+            string _deviceId;
+            bool _identityValid;
+            bool _iarmConnected;
+            bool _timeSynced;
+            Core::CriticalSection _authLock;
+            Core::CriticalSection _refreshLock;
+            Core::CriticalSection _timeLock;
             std::unique_ptr<::distp::gateway::secure_storage::v1::SecureStorageService::Stub> _stub;
             std::list<INotification*> _clients;
             Core::CriticalSection _clientLock;
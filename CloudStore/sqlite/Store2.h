@@ -0,0 +1,684 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "../Module.h"
+#include <interfaces/IStore2.h>
+#include <sqlite3.h>
+#ifdef WITH_SYSMGR
+#include <libIBus.h>
+#include <sysMgr.h>
+#endif
+
+namespace WPEFramework {
+namespace Plugin {
+    namespace Sqlite {
+
+        // Local front of the cloud store. Writes go to a journal and return,
+        // the journal is replayed to the cloud store in order, in the background,
+        // retrying while it can't be reached. Reads are served from the journal,
+        // then from values read from the cloud store no longer than maxAge ago.
+        // A write the cloud store rejects is dropped, clients are told what's there.
+        // Both are kept per identity, what another account left stays until it is back.
+        class Store2 : public Exchange::IStore2 {
+        private:
+            class Job : public Core::IDispatch {
+            public:
+                Job(Store2* parent, const ScopeType scope, const string& ns, const string& key, const string& value)
+                    : _parent(parent)
+                    , _scope(scope)
+                    , _ns(ns)
+                    , _key(key)
+                    , _value(value)
+                {
+                    _parent->AddRef();
+                }
+                ~Job() override
+                {
+                    _parent->Release();
+                }
+                void Dispatch() override
+                {
+                    _parent->OnValueChanged(_scope, _ns, _key, _value);
+                }
+
+            private:
+                Store2* _parent;
+                const ScopeType _scope;
+                const string _ns;
+                const string _key;
+                const string _value;
+            };
+
+        private:
+            Store2(const Store2&) = delete;
+            Store2& operator=(const Store2&) = delete;
+
+        public:
+            using Identity = std::function<string()>;
+
+            Store2(IStore2* upstream, const Identity& identity)
+                : Store2(getenv(PATH_ENV), std::stoul(getenv(MAXAGE_ENV)), upstream, identity)
+            {
+            }
+            Store2(const string& path, const uint32_t maxAge, IStore2* upstream, const Identity& identity)
+                : IStore2()
+                , _path(path)
+                , _maxAge(maxAge)
+                , _upstream(upstream)
+                , _identity(identity)
+                , _replay(*this)
+                , _replayDelay(REPLAY_MIN_DELAY)
+                , _offline(false)
+                , _iarmConnected(false)
+                , _timeSynced(false)
+            {
+                ASSERT(_upstream != nullptr);
+                _upstream->AddRef();
+
+                IntegrityCheck();
+                Open();
+
+                // Whatever was left over from the last run
+                _replay.Submit();
+            }
+            ~Store2() override
+            {
+                _replay.Revoke();
+                Close();
+                _upstream->Release();
+            }
+
+        private:
+            void IntegrityCheck()
+            {
+                Core::File file(_path);
+                Core::Directory(file.PathName().c_str()).CreatePath();
+                auto rc = sqlite3_open(_path.c_str(), &_data);
+                sqlite3_stmt* stmt;
+                sqlite3_prepare_v2(_data, "pragma integrity_check;",
+                    -1, &stmt, nullptr);
+                while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+                    TRACE(Trace::Information,
+                        (_T("%s %s"), __FUNCTION__,
+                            (const char*)sqlite3_column_text(stmt, 0)));
+                }
+                sqlite3_finalize(stmt);
+                sqlite3_close_v2(_data);
+                if (rc != SQLITE_DONE) {
+                    OnError(__FUNCTION__, rc);
+                    if ((rc == SQLITE_MISUSE) || (rc == SQLITE_CORRUPT)) {
+                        ASSERT(file.Destroy());
+                    }
+                }
+            }
+            void Open()
+            {
+                Core::File file(_path);
+                Core::Directory(file.PathName().c_str()).CreatePath();
+                auto rc = sqlite3_open(_path.c_str(), &_data);
+                if (rc != SQLITE_OK) {
+                    OnError(__FUNCTION__, rc);
+                }
+                rc = sqlite3_busy_timeout(_data, SQLITE_TIMEOUT); // Timeout
+                if (rc != SQLITE_OK) {
+                    OnError(__FUNCTION__, rc);
+                }
+                // Journal: a row per key not yet in the cloud store, the last
+                // change of the key wins and moves to the end. Empty key is a
+                // namespace delete, null value a key delete. ttl is the expiry time.
+                // Cache: values as read from or written to the cloud store,
+                // time is when. identity is who the row is for.
+                const std::vector<string> statements = {
+                    "create table if not exists journal"
+                    " (id integer primary key autoincrement,identity text,scope integer,ns text,key text,value text,ttl integer,"
+                    "unique(identity,scope,ns,key) on conflict replace);",
+                    "create table if not exists cache"
+                    " (identity text,scope integer,ns text,key text,value text,ttl integer,time integer,"
+                    "unique(identity,scope,ns,key) on conflict replace);"
+                };
+                for (auto& sql : statements) {
+                    auto rc = sqlite3_exec(_data, sql.c_str(), nullptr, nullptr, nullptr);
+                    if (rc != SQLITE_OK) {
+                        OnError(__FUNCTION__, rc);
+                    }
+                }
+            }
+            void Close()
+            {
+                auto rc = sqlite3_close_v2(_data);
+                if (rc != SQLITE_OK) {
+                    OnError(__FUNCTION__, rc);
+                }
+            }
+
+        private:
+            bool IsTimeSynced()
+            {
+#ifdef WITH_SYSMGR
+                // Once synced, time stays synced. Until then, get actual state, as it may change at any time...
+                Core::SafeSyncType<Core::CriticalSection> lock(_timeLock);
+                if (!_timeSynced) {
+                    if (!_iarmConnected) {
+                        IARM_Bus_Init(IARM_INIT_NAME);
+                        IARM_Bus_Connect();
+                        _iarmConnected = true;
+                    }
+                    IARM_Bus_SYSMgr_GetSystemStates_Param_t param;
+                    _timeSynced = (IARM_Bus_Call_with_IPCTimeout(
+                                       IARM_BUS_SYSMGR_NAME,
+                                       IARM_BUS_SYSMGR_API_GetSystemStates,
+                                       &param,
+                                       sizeof(param),
+                                       IARM_TIMEOUT) // Timeout
+                                      == IARM_RESULT_SUCCESS)
+                        && param.time_source.state;
+                }
+                return _timeSynced;
+#else
+                return true;
+#endif
+            }
+
+        public:
+            uint32_t Register(INotification* notification) override
+            {
+                Core::SafeSyncType<Core::CriticalSection> lock(_clientLock);
+
+                ASSERT(std::find(_clients.begin(), _clients.end(), notification) == _clients.end());
+
+                notification->AddRef();
+                _clients.push_back(notification);
+
+                return Core::ERROR_NONE;
+            }
+            uint32_t Unregister(INotification* notification) override
+            {
+                Core::SafeSyncType<Core::CriticalSection> lock(_clientLock);
+
+                std::list<INotification*>::iterator
+                    index(std::find(_clients.begin(), _clients.end(), notification));
+
+                ASSERT(index != _clients.end());
+
+                if (index != _clients.end()) {
+                    notification->Release();
+                    _clients.erase(index);
+                }
+
+                return Core::ERROR_NONE;
+            }
+
+            uint32_t SetValue(const ScopeType scope, const string& ns, const string& key, const string& value, const uint32_t ttl) override
+            {
+                uint32_t result;
+
+                if (ns.empty() || key.empty()) {
+                    return Core::ERROR_INVALID_INPUT_LENGTH;
+                }
+                if (ttl != 0) {
+                    if (!IsTimeSynced()) {
+                        return Core::ERROR_PENDING_CONDITIONS;
+                    }
+                }
+                const string identity = _identity();
+                const int64_t now = time(nullptr);
+                sqlite3_stmt* stmt;
+                sqlite3_prepare_v2(_data, "insert into journal (identity,scope,ns,key,value,ttl)"
+                                          " values (?,?,?,?,?,?)"
+                                          ";",
+                    -1, &stmt, nullptr);
+                sqlite3_bind_text(stmt, 1, identity.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(stmt, 2, static_cast<int>(scope));
+                sqlite3_bind_text(stmt, 3, ns.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(stmt, 4, key.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(stmt, 5, value.c_str(), -1, SQLITE_TRANSIENT);
+                if (ttl != 0) {
+                    sqlite3_bind_int64(stmt, 6, (int64_t)ttl + now);
+                } else {
+                    sqlite3_bind_null(stmt, 6);
+                }
+                auto rc = sqlite3_step(stmt);
+                sqlite3_finalize(stmt);
+
+                if (rc == SQLITE_DONE) {
+                    Cache(identity, scope, ns, key, value, ttl, now);
+
+                    Core::IWorkerPool::Instance().Submit(Core::ProxyType<Core::IDispatch>(
+                        Core::ProxyType<Job>::Create(this, scope, ns, key, value))); // Decouple notification
+
+                    Replay();
+
+                    result = Core::ERROR_NONE;
+                } else {
+                    OnError(__FUNCTION__, rc);
+                    result = Core::ERROR_GENERAL;
+                }
+
+                return result;
+            }
+            uint32_t GetValue(const ScopeType scope, const string& ns, const string& key, string& value, uint32_t& ttl) override
+            {
+                uint32_t result;
+
+                // Not in the cloud store yet
+                const string identity = _identity();
+                string v;
+                int64_t t = 0;
+                if (Journaled(identity, scope, ns, key, v, t, result)) {
+                    if (result == Core::ERROR_NONE) {
+                        result = Expiry(v, t, value, ttl);
+                    }
+                    return result;
+                }
+
+                // Read from the cloud store before
+                int64_t cached = -1;
+                sqlite3_stmt* stmt;
+                sqlite3_prepare_v2(_data, "select value, ttl, time"
+                                          " from cache"
+                                          " where identity = ? and scope = ? and ns = ? and key = ?"
+                                          ";",
+                    -1, &stmt, nullptr);
+                sqlite3_bind_text(stmt, 1, identity.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(stmt, 2, static_cast<int>(scope));
+                sqlite3_bind_text(stmt, 3, ns.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(stmt, 4, key.c_str(), -1, SQLITE_TRANSIENT);
+                auto rc = sqlite3_step(stmt);
+                if (rc == SQLITE_ROW) {
+                    v = (const char*)sqlite3_column_text(stmt, 0);
+                    t = sqlite3_column_int64(stmt, 1);
+                    cached = sqlite3_column_int64(stmt, 2);
+                }
+                sqlite3_finalize(stmt);
+
+                const int64_t now = time(nullptr);
+                if ((cached >= 0) && (cached <= now) && ((now - cached) < _maxAge)) {
+                    return Expiry(v, t, value, ttl);
+                }
+
+                result = _upstream->GetValue(scope, ns, key, value, ttl);
+
+                // Written meanwhile, what's in the cloud store is older, don't cache it
+                uint32_t written;
+                if (Journaled(identity, scope, ns, key, v, t, written)) {
+                    if (result == Core::ERROR_NONE) {
+                        Replay(true);
+                    }
+                    if (written == Core::ERROR_NONE) {
+                        written = Expiry(v, t, value, ttl);
+                    }
+                    return written;
+                }
+
+                if (result == Core::ERROR_NONE) {
+                    if ((ttl == 0) || IsTimeSynced()) {
+                        Cache(identity, scope, ns, key, value, ttl, now);
+                    }
+                    Replay(true);
+                } else if ((result == Core::ERROR_UNKNOWN_KEY) || (result == Core::ERROR_NOT_EXIST)) {
+                    Uncache(identity, scope, ns, key);
+                } else if (cached >= 0) {
+                    // Can't get to the cloud store, what's known is better than nothing
+                    result = Expiry(v, t, value, ttl);
+                }
+
+                return result;
+            }
+            uint32_t DeleteKey(const ScopeType scope, const string& ns, const string& key) override
+            {
+                uint32_t result;
+
+                const string identity = _identity();
+                sqlite3_stmt* stmt;
+                sqlite3_prepare_v2(_data, "insert into journal (identity,scope,ns,key,value,ttl)"
+                                          " values (?,?,?,?,null,null)"
+                                          ";",
+                    -1, &stmt, nullptr);
+                sqlite3_bind_text(stmt, 1, identity.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(stmt, 2, static_cast<int>(scope));
+                sqlite3_bind_text(stmt, 3, ns.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(stmt, 4, key.c_str(), -1, SQLITE_TRANSIENT);
+                auto rc = sqlite3_step(stmt);
+                sqlite3_finalize(stmt);
+
+                if (rc == SQLITE_DONE) {
+                    Uncache(identity, scope, ns, key);
+                    Replay();
+
+                    result = Core::ERROR_NONE;
+                } else {
+                    OnError(__FUNCTION__, rc);
+                    result = Core::ERROR_GENERAL;
+                }
+
+                return result;
+            }
+            uint32_t DeleteNamespace(const ScopeType scope, const string& ns) override
+            {
+                uint32_t result;
+
+                // Supersedes whatever is pending in the namespace
+                const string identity = _identity();
+                sqlite3_stmt* stmt;
+                sqlite3_prepare_v2(_data, "delete from journal where identity = ? and scope = ? and ns = ?;", -1, &stmt, nullptr);
+                sqlite3_bind_text(stmt, 1, identity.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(stmt, 2, static_cast<int>(scope));
+                sqlite3_bind_text(stmt, 3, ns.c_str(), -1, SQLITE_TRANSIENT);
+                auto rc = sqlite3_step(stmt);
+                sqlite3_finalize(stmt);
+                if (rc == SQLITE_DONE) {
+                    sqlite3_prepare_v2(_data, "insert into journal (identity,scope,ns,key,value,ttl)"
+                                              " values (?,?,?,'',null,null)"
+                                              ";",
+                        -1, &stmt, nullptr);
+                    sqlite3_bind_text(stmt, 1, identity.c_str(), -1, SQLITE_TRANSIENT);
+                    sqlite3_bind_int(stmt, 2, static_cast<int>(scope));
+                    sqlite3_bind_text(stmt, 3, ns.c_str(), -1, SQLITE_TRANSIENT);
+                    rc = sqlite3_step(stmt);
+                    sqlite3_finalize(stmt);
+                }
+                if (rc == SQLITE_DONE) {
+                    sqlite3_prepare_v2(_data, "delete from cache where identity = ? and scope = ? and ns = ?;", -1, &stmt, nullptr);
+                    sqlite3_bind_text(stmt, 1, identity.c_str(), -1, SQLITE_TRANSIENT);
+                    sqlite3_bind_int(stmt, 2, static_cast<int>(scope));
+                    sqlite3_bind_text(stmt, 3, ns.c_str(), -1, SQLITE_TRANSIENT);
+                    rc = sqlite3_step(stmt);
+                    sqlite3_finalize(stmt);
+                }
+
+                if (rc == SQLITE_DONE) {
+                    Replay();
+
+                    result = Core::ERROR_NONE;
+                } else {
+                    OnError(__FUNCTION__, rc);
+                    result = Core::ERROR_GENERAL;
+                }
+
+                return result;
+            }
+
+            BEGIN_INTERFACE_MAP(Store2)
+            INTERFACE_ENTRY(IStore2)
+            END_INTERFACE_MAP
+
+        private:
+            bool Journaled(const string& identity, const ScopeType scope, const string& ns, const string& key, string& v, int64_t& t, uint32_t& result)
+            {
+                bool found = false;
+                sqlite3_stmt* stmt;
+                sqlite3_prepare_v2(_data, "select key, value, ttl"
+                                          " from journal"
+                                          " where identity = ? and scope = ? and ns = ? and (key = ? or key = '')"
+                                          " order by id desc limit 1"
+                                          ";",
+                    -1, &stmt, nullptr);
+                sqlite3_bind_text(stmt, 1, identity.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(stmt, 2, static_cast<int>(scope));
+                sqlite3_bind_text(stmt, 3, ns.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(stmt, 4, key.c_str(), -1, SQLITE_TRANSIENT);
+                auto rc = sqlite3_step(stmt);
+                if (rc == SQLITE_ROW) {
+                    found = true;
+                    if (sqlite3_column_type(stmt, 1) == SQLITE_NULL) {
+                        result = Core::ERROR_UNKNOWN_KEY; // deleted
+                    } else {
+                        v = (const char*)sqlite3_column_text(stmt, 1);
+                        t = sqlite3_column_int64(stmt, 2);
+                        result = Core::ERROR_NONE;
+                    }
+                }
+                sqlite3_finalize(stmt);
+
+                return found;
+            }
+            uint32_t Expiry(const string& v, const int64_t t, string& value, uint32_t& ttl)
+            {
+                uint32_t result;
+
+                if (t == 0) {
+                    value = v;
+                    ttl = 0;
+                    result = Core::ERROR_NONE;
+                } else if (IsTimeSynced()) {
+                    const int64_t left = t - time(nullptr);
+                    if (left > 0) {
+                        value = v;
+                        ttl = left;
+                        result = Core::ERROR_NONE;
+                    } else {
+                        result = Core::ERROR_UNKNOWN_KEY;
+                    }
+                } else {
+                    result = Core::ERROR_PENDING_CONDITIONS;
+                }
+
+                return result;
+            }
+            void Cache(const string& identity, const ScopeType scope, const string& ns, const string& key, const string& value, const uint32_t ttl, const int64_t now)
+            {
+                sqlite3_stmt* stmt;
+                sqlite3_prepare_v2(_data, "insert into cache (identity,scope,ns,key,value,ttl,time)"
+                                          " values (?,?,?,?,?,?,?)"
+                                          ";",
+                    -1, &stmt, nullptr);
+                sqlite3_bind_text(stmt, 1, identity.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(stmt, 2, static_cast<int>(scope));
+                sqlite3_bind_text(stmt, 3, ns.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(stmt, 4, key.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(stmt, 5, value.c_str(), -1, SQLITE_TRANSIENT);
+                if (ttl != 0) {
+                    sqlite3_bind_int64(stmt, 6, (int64_t)ttl + now);
+                } else {
+                    sqlite3_bind_null(stmt, 6);
+                }
+                sqlite3_bind_int64(stmt, 7, now);
+                auto rc = sqlite3_step(stmt);
+                sqlite3_finalize(stmt);
+                if (rc != SQLITE_DONE) {
+                    OnError(__FUNCTION__, rc);
+                }
+            }
+            void Uncache(const string& identity, const ScopeType scope, const string& ns, const string& key)
+            {
+                sqlite3_stmt* stmt;
+                sqlite3_prepare_v2(_data, "delete from cache where identity = ? and scope = ? and ns = ? and key = ?;", -1, &stmt, nullptr);
+                sqlite3_bind_text(stmt, 1, identity.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(stmt, 2, static_cast<int>(scope));
+                sqlite3_bind_text(stmt, 3, ns.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(stmt, 4, key.c_str(), -1, SQLITE_TRANSIENT);
+                auto rc = sqlite3_step(stmt);
+                sqlite3_finalize(stmt);
+                if (rc != SQLITE_DONE) {
+                    OnError(__FUNCTION__, rc);
+                }
+            }
+            void Replay(const bool reachable = false)
+            {
+                // While offline, wait for the retry, or for a read to get through
+                Core::SafeSyncType<Core::CriticalSection> lock(_replayLock);
+                if (reachable) {
+                    if (!_offline) {
+                        return;
+                    }
+                    _offline = false;
+                    _replayDelay = REPLAY_MIN_DELAY;
+                }
+                if (!_offline) {
+                    _replay.Submit();
+                }
+            }
+
+            friend Core::ThreadPool::JobType<Store2&>;
+            void Dispatch()
+            {
+                // Oldest first. A row changed meanwhile gets a new id, and stays.
+                // Only what was written for the current identity, upstream makes
+                // the calls for it.
+                while (true) {
+                    const string identity = _identity();
+                    int64_t id = 0;
+                    ScopeType scope = ScopeType::DEVICE;
+                    string ns, key, value;
+                    bool remove = false;
+                    int64_t t = 0;
+                    sqlite3_stmt* stmt;
+                    sqlite3_prepare_v2(_data, "select id, scope, ns, key, value, ttl"
+                                              " from journal"
+                                              " where identity = ?"
+                                              " order by id limit 1"
+                                              ";",
+                        -1, &stmt, nullptr);
+                    sqlite3_bind_text(stmt, 1, identity.c_str(), -1, SQLITE_TRANSIENT);
+                    auto rc = sqlite3_step(stmt);
+                    if (rc == SQLITE_ROW) {
+                        id = sqlite3_column_int64(stmt, 0);
+                        scope = static_cast<ScopeType>(sqlite3_column_int(stmt, 1));
+                        ns = (const char*)sqlite3_column_text(stmt, 2);
+                        key = (const char*)sqlite3_column_text(stmt, 3);
+                        remove = (sqlite3_column_type(stmt, 4) == SQLITE_NULL);
+                        if (!remove) {
+                            value = (const char*)sqlite3_column_text(stmt, 4);
+                        }
+                        t = sqlite3_column_int64(stmt, 5);
+                    }
+                    sqlite3_finalize(stmt);
+
+                    if (rc != SQLITE_ROW) {
+                        if (rc != SQLITE_DONE) {
+                            OnError(__FUNCTION__, rc);
+                        }
+                        Core::SafeSyncType<Core::CriticalSection> lock(_replayLock);
+                        _offline = false;
+                        _replayDelay = REPLAY_MIN_DELAY;
+                        break;
+                    }
+
+                    uint32_t result;
+                    if (key.empty()) {
+                        result = _upstream->DeleteNamespace(scope, ns);
+                    } else if (remove) {
+                        result = _upstream->DeleteKey(scope, ns, key);
+                    } else if (t == 0) {
+                        result = _upstream->SetValue(scope, ns, key, value, 0);
+                    } else if ((t - time(nullptr)) > 0) {
+                        result = _upstream->SetValue(scope, ns, key, value, t - time(nullptr));
+                    } else {
+                        // Expired before it got there, still replaces what's there
+                        result = _upstream->DeleteKey(scope, ns, key);
+                    }
+
+                    if ((result == Core::ERROR_UNKNOWN_KEY) || (result == Core::ERROR_NOT_EXIST)) {
+                        result = Core::ERROR_NONE; // Deleted already
+                    }
+                    if ((result != Core::ERROR_NONE) && (result != Core::ERROR_INVALID_INPUT_LENGTH)) {
+                        Core::SafeSyncType<Core::CriticalSection> lock(_replayLock);
+                        TRACE(Trace::Information, (_T("%s retry in %u ms, error %u"), __FUNCTION__, _replayDelay, result));
+                        _offline = true;
+                        _replay.Reschedule(Core::Time::Now().Add(_replayDelay));
+                        _replayDelay = std::min(2 * _replayDelay, (uint32_t)REPLAY_MAX_DELAY);
+                        break;
+                    }
+
+                    sqlite3_prepare_v2(_data, "delete from journal where id = ?;", -1, &stmt, nullptr);
+                    sqlite3_bind_int64(stmt, 1, id);
+                    rc = sqlite3_step(stmt);
+                    sqlite3_finalize(stmt);
+                    if (rc != SQLITE_DONE) {
+                        OnError(__FUNCTION__, rc);
+                        break;
+                    }
+
+                    if (result == Core::ERROR_INVALID_INPUT_LENGTH) {
+                        // Never going to get there, what's there stays
+                        TRACE(Trace::Error, (_T("%s dropped %s %s, rejected"), __FUNCTION__, ns.c_str(), key.c_str()));
+                        Uncache(identity, scope, ns, key);
+                        Rejected(identity, scope, ns, key);
+                    }
+                }
+            }
+            void Rejected(const string& identity, const ScopeType scope, const string& ns, const string& key)
+            {
+                // The value notified at SetValue didn't stick, tell what's there instead.
+                // Unless written again meanwhile, then that's notified already.
+                string v;
+                int64_t t = 0;
+                uint32_t result;
+                if (Journaled(identity, scope, ns, key, v, t, result)) {
+                    return;
+                }
+
+                string value;
+                uint32_t ttl = 0;
+                result = _upstream->GetValue(scope, ns, key, value, ttl);
+                if (result == Core::ERROR_NONE) {
+                    if ((ttl == 0) || IsTimeSynced()) {
+                        Cache(identity, scope, ns, key, value, ttl, time(nullptr));
+                    }
+                } else if ((result == Core::ERROR_UNKNOWN_KEY) || (result == Core::ERROR_NOT_EXIST)) {
+                    value.clear(); // Not there, cleared
+                } else {
+                    TRACE(Trace::Error, (_T("%s %s %s unknown, error %u"), __FUNCTION__, ns.c_str(), key.c_str(), result));
+                    return;
+                }
+
+                Core::IWorkerPool::Instance().Submit(Core::ProxyType<Core::IDispatch>(
+                    Core::ProxyType<Job>::Create(this, scope, ns, key, value))); // Decouple notification
+            }
+
+            void OnValueChanged(const ScopeType scope, const string& ns, const string& key, const string& value)
+            {
+                Core::SafeSyncType<Core::CriticalSection> lock(_clientLock);
+
+                std::list<INotification*>::iterator
+                    index(_clients.begin());
+
+                while (index != _clients.end()) {
+                    // If main process is out of threads, this can time out, and IPC will mess up...
+                    (*index)->ValueChanged(scope, ns, key, value);
+                    index++;
+                }
+            }
+            void OnError(const char* fn, const int status) const
+            {
+                TRACE(Trace::Error, (_T("%s sqlite error %d"), fn, status));
+            }
+
+        private:
+            const string _path;
+            const int64_t _maxAge;
+            IStore2* _upstream;
+            const Identity _identity;
+            sqlite3* _data;
+            Core::WorkerPool::JobType<Store2&> _replay;
+            uint32_t _replayDelay;
+            bool _offline;
+            Core::CriticalSection _replayLock;
+            bool _iarmConnected;
+            bool _timeSynced;
+            Core::CriticalSection _timeLock;
+            std::list<INotification*> _clients;
+            Core::CriticalSection _clientLock;
+        };
+
+    } // namespace Sqlite
+} // namespace Plugin
+} // namespace WPEFramework
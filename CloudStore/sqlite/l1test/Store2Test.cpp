@@ -0,0 +1,467 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../Store2.h"
+#include "Store2Mock.h"
+#include "Store2NotificationMock.h"
+#include "WorkerPoolImplementation.h"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Eq;
+using ::testing::Gt;
+using ::testing::Invoke;
+using ::testing::Le;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::Test;
+using ::WPEFramework::Exchange::IStore2;
+using ::WPEFramework::Plugin::Sqlite::Store2;
+
+const auto kPath = "/tmp/cloudstore/sqlite/l1test/store2test";
+const auto kMaxAge = 300;
+const auto kValue = "value";
+const auto kKey = "key";
+const auto kAppId = "app";
+const auto kTtl = 100;
+const auto kNoTtl = 0;
+const auto kTimeout = 2 * WPEFramework::Core::Time::MilliSecondsPerSecond;
+const auto kIdentity = "partner/account1/device";
+const auto kOtherIdentity = "partner/account2/device";
+
+class AStore2 : public Test {
+protected:
+    WPEFramework::Core::ProxyType<WorkerPoolImplementation> workerPool;
+    WPEFramework::Core::Sink<NiceMock<Store2Mock>> upstream;
+    WPEFramework::Core::ProxyType<Store2> store2;
+    // Read by the replay too
+    string identity;
+    WPEFramework::Core::CriticalSection identityLock;
+    AStore2()
+        : workerPool(WPEFramework::Core::ProxyType<WorkerPoolImplementation>::Create(
+            WPEFramework::Core::Thread::DefaultStackSize()))
+        , identity(kIdentity)
+    {
+        WPEFramework::Core::IWorkerPool::Assign(&(*workerPool));
+        WPEFramework::Core::File(string(kPath)).Destroy();
+        ON_CALL(upstream, SetValue(_, _, _, _, _))
+            .WillByDefault(Return(WPEFramework::Core::ERROR_GENERAL));
+        ON_CALL(upstream, GetValue(_, _, _, _, _))
+            .WillByDefault(Return(WPEFramework::Core::ERROR_GENERAL));
+        ON_CALL(upstream, DeleteKey(_, _, _))
+            .WillByDefault(Return(WPEFramework::Core::ERROR_GENERAL));
+        ON_CALL(upstream, DeleteNamespace(_, _))
+            .WillByDefault(Return(WPEFramework::Core::ERROR_GENERAL));
+    }
+    ~AStore2() override
+    {
+        store2.Release();
+        WPEFramework::Core::IWorkerPool::Assign(nullptr);
+    }
+    void Start(const uint32_t maxAge = kMaxAge)
+    {
+        store2 = WPEFramework::Core::ProxyType<Store2>::Create(
+            kPath, maxAge, &upstream, [this]() { return Identity(); });
+    }
+    string Identity()
+    {
+        WPEFramework::Core::SafeSyncType<WPEFramework::Core::CriticalSection> lock(identityLock);
+        return identity;
+    }
+    void SwitchTo(const string& other)
+    {
+        WPEFramework::Core::SafeSyncType<WPEFramework::Core::CriticalSection> lock(identityLock);
+        identity = other;
+    }
+};
+
+TEST_F(AStore2, DoesNotSetValueWhenNamespaceEmpty)
+{
+    Start();
+    EXPECT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, "", kKey, kValue, kNoTtl),
+        Eq(WPEFramework::Core::ERROR_INVALID_INPUT_LENGTH));
+}
+
+TEST_F(AStore2, DoesNotSetValueWhenKeyEmpty)
+{
+    Start();
+    EXPECT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, "", kValue, kNoTtl),
+        Eq(WPEFramework::Core::ERROR_INVALID_INPUT_LENGTH));
+}
+
+TEST_F(AStore2, SetsValueWhenUpstreamUnavailable)
+{
+    EXPECT_CALL(upstream, GetValue(_, _, _, _, _)).Times(0);
+    Start();
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, kValue, kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    string value;
+    uint32_t ttl;
+    ASSERT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(value, Eq(kValue));
+    EXPECT_THAT(ttl, Eq(kNoTtl));
+}
+
+TEST_F(AStore2, GetsValueWithTtl)
+{
+    Start();
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, kValue, kTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    string value;
+    uint32_t ttl;
+    ASSERT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(value, Eq(kValue));
+    EXPECT_THAT(ttl, Le(kTtl));
+    EXPECT_THAT(ttl, Gt(kNoTtl));
+}
+
+TEST_F(AStore2, ReplaysSetValue)
+{
+    WPEFramework::Core::Event lock(false, true);
+    EXPECT_CALL(upstream, SetValue(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), Eq(kValue), kNoTtl))
+        .WillOnce(Invoke(
+            [&](const IStore2::ScopeType, const string&, const string&, const string&, const uint32_t) {
+                lock.SetEvent();
+                return WPEFramework::Core::ERROR_NONE;
+            }));
+    Start();
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, kValue, kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(lock.Lock(kTimeout), Eq(WPEFramework::Core::ERROR_NONE));
+}
+
+TEST_F(AStore2, ReplaysLastValueAfterRestart)
+{
+    Start();
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, "value1", kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, kValue, kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    store2.Release();
+
+    WPEFramework::Core::Event lock(false, true);
+    EXPECT_CALL(upstream, SetValue(_, _, _, Eq("value1"), _)).Times(0);
+    EXPECT_CALL(upstream, SetValue(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), Eq(kValue), kNoTtl))
+        .WillOnce(Invoke(
+            [&](const IStore2::ScopeType, const string&, const string&, const string&, const uint32_t) {
+                lock.SetEvent();
+                return WPEFramework::Core::ERROR_NONE;
+            }));
+    Start();
+    EXPECT_THAT(lock.Lock(kTimeout), Eq(WPEFramework::Core::ERROR_NONE));
+}
+
+TEST_F(AStore2, ReplaysDeleteNamespaceOnly)
+{
+    Start();
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, kValue, kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    ASSERT_THAT(store2->DeleteNamespace(
+                    IStore2::ScopeType::ACCOUNT, kAppId),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    store2.Release();
+
+    WPEFramework::Core::Event lock(false, true);
+    EXPECT_CALL(upstream, SetValue(_, _, _, _, _)).Times(0);
+    EXPECT_CALL(upstream, DeleteNamespace(IStore2::ScopeType::ACCOUNT, Eq(kAppId)))
+        .WillOnce(Invoke(
+            [&](const IStore2::ScopeType, const string&) {
+                lock.SetEvent();
+                return WPEFramework::Core::ERROR_NONE;
+            }));
+    Start();
+    EXPECT_THAT(lock.Lock(kTimeout), Eq(WPEFramework::Core::ERROR_NONE));
+}
+
+TEST_F(AStore2, DoesNotGetValueWhenKeyDeleted)
+{
+    EXPECT_CALL(upstream, GetValue(_, _, _, _, _)).Times(0);
+    Start();
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, kValue, kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    ASSERT_THAT(store2->DeleteKey(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    string value;
+    uint32_t ttl;
+    EXPECT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_UNKNOWN_KEY));
+}
+
+TEST_F(AStore2, DoesNotGetValueWhenNamespaceDeleted)
+{
+    EXPECT_CALL(upstream, GetValue(_, _, _, _, _)).Times(0);
+    Start();
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, kValue, kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    ASSERT_THAT(store2->DeleteNamespace(
+                    IStore2::ScopeType::ACCOUNT, kAppId),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    string value;
+    uint32_t ttl;
+    EXPECT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_UNKNOWN_KEY));
+}
+
+TEST_F(AStore2, GetsValueFromUpstreamOnce)
+{
+    EXPECT_CALL(upstream, GetValue(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), _, _))
+        .WillOnce(Invoke(
+            [](const IStore2::ScopeType, const string&, const string&, string& value, uint32_t& ttl) {
+                value = kValue;
+                ttl = kNoTtl;
+                return WPEFramework::Core::ERROR_NONE;
+            }));
+    Start();
+    string value;
+    uint32_t ttl;
+    ASSERT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(value, Eq(kValue));
+    value.clear();
+    ASSERT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(value, Eq(kValue));
+    EXPECT_THAT(ttl, Eq(kNoTtl));
+}
+
+TEST_F(AStore2, GetsCachedValueWhenUpstreamUnavailable)
+{
+    EXPECT_CALL(upstream, GetValue(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), _, _))
+        .WillOnce(Invoke(
+            [](const IStore2::ScopeType, const string&, const string&, string& value, uint32_t& ttl) {
+                value = kValue;
+                ttl = kNoTtl;
+                return WPEFramework::Core::ERROR_NONE;
+            }))
+        .WillOnce(Return(WPEFramework::Core::ERROR_GENERAL));
+    Start(0);
+    string value;
+    uint32_t ttl;
+    ASSERT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    value.clear();
+    ASSERT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(value, Eq(kValue));
+}
+
+TEST_F(AStore2, DoesNotGetValueWhenUpstreamDoesNotHaveIt)
+{
+    EXPECT_CALL(upstream, GetValue(_, _, _, _, _))
+        .WillOnce(Return(WPEFramework::Core::ERROR_UNKNOWN_KEY));
+    Start();
+    string value;
+    uint32_t ttl;
+    EXPECT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_UNKNOWN_KEY));
+}
+
+TEST_F(AStore2, SendsValueChangedEventWhenSetValue)
+{
+    IStore2::ScopeType eventScope;
+    string eventNamespace;
+    string eventKey;
+    string eventValue;
+    WPEFramework::Core::Event lock(false, true);
+    WPEFramework::Core::Sink<NiceMock<Store2NotificationMock>> sink;
+    EXPECT_CALL(sink, ValueChanged(_, _, _, _))
+        .WillRepeatedly(Invoke(
+            [&](const IStore2::ScopeType scope, const string& ns,
+                const string& key, const string& value) {
+                eventScope = scope;
+                eventNamespace = ns;
+                eventKey = key;
+                eventValue = value;
+                lock.SetEvent();
+                return WPEFramework::Core::ERROR_NONE;
+            }));
+    Start();
+    store2->Register(&sink);
+    EXPECT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, kValue, kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    lock.Lock(kTimeout);
+    EXPECT_THAT(eventScope, Eq(IStore2::ScopeType::ACCOUNT));
+    EXPECT_THAT(eventNamespace, Eq(kAppId));
+    EXPECT_THAT(eventKey, Eq(kKey));
+    EXPECT_THAT(eventValue, Eq(kValue));
+    store2->Unregister(&sink);
+}
+
+TEST_F(AStore2, ReplaysOnlyForTheAccountItWasSetFor)
+{
+    WPEFramework::Core::Event failed(false, true);
+    WPEFramework::Core::Event lock(false, true);
+    EXPECT_CALL(upstream, SetValue(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), Eq(kValue), kNoTtl))
+        .WillRepeatedly(Invoke(
+            [&](const IStore2::ScopeType, const string&, const string&, const string&, const uint32_t) {
+                EXPECT_THAT(Identity(), Eq(kIdentity));
+                failed.SetEvent();
+                return WPEFramework::Core::ERROR_GENERAL;
+            }));
+    EXPECT_CALL(upstream, SetValue(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), Eq("value2"), kNoTtl))
+        .WillOnce(Invoke(
+            [&](const IStore2::ScopeType, const string&, const string&, const string&, const uint32_t) {
+                EXPECT_THAT(Identity(), Eq(kOtherIdentity));
+                lock.SetEvent();
+                return WPEFramework::Core::ERROR_NONE;
+            }));
+    Start();
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, kValue, kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    ASSERT_THAT(failed.Lock(kTimeout), Eq(WPEFramework::Core::ERROR_NONE));
+
+    SwitchTo(kOtherIdentity);
+    string value;
+    uint32_t ttl;
+    EXPECT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_GENERAL));
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, "value2", kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(lock.Lock(kTimeout), Eq(WPEFramework::Core::ERROR_NONE));
+
+    SwitchTo(kIdentity);
+    ASSERT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(value, Eq(kValue));
+}
+
+TEST_F(AStore2, DoesNotGetCachedValueOfAnotherAccount)
+{
+    EXPECT_CALL(upstream, GetValue(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), _, _))
+        .WillOnce(Invoke(
+            [](const IStore2::ScopeType, const string&, const string&, string& value, uint32_t& ttl) {
+                value = kValue;
+                ttl = kNoTtl;
+                return WPEFramework::Core::ERROR_NONE;
+            }))
+        .WillOnce(Return(WPEFramework::Core::ERROR_UNKNOWN_KEY));
+    Start();
+    string value;
+    uint32_t ttl;
+    ASSERT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    SwitchTo(kOtherIdentity);
+    EXPECT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_UNKNOWN_KEY));
+}
+
+TEST_F(AStore2, DoesNotCacheUpstreamValueWhenSetMeanwhile)
+{
+    WPEFramework::Core::Event lock(false, true);
+    EXPECT_CALL(upstream, GetValue(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), _, _))
+        .WillOnce(Invoke(
+            [&](const IStore2::ScopeType, const string&, const string&, string& value, uint32_t& ttl) {
+                EXPECT_THAT(store2->SetValue(
+                                IStore2::ScopeType::ACCOUNT, kAppId, kKey, "value2", kNoTtl),
+                    Eq(WPEFramework::Core::ERROR_NONE));
+                value = kValue;
+                ttl = kNoTtl;
+                return WPEFramework::Core::ERROR_NONE;
+            }));
+    EXPECT_CALL(upstream, SetValue(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), Eq("value2"), kNoTtl))
+        .WillOnce(Invoke(
+            [&](const IStore2::ScopeType, const string&, const string&, const string&, const uint32_t) {
+                lock.SetEvent();
+                return WPEFramework::Core::ERROR_NONE;
+            }));
+    Start();
+    string value;
+    uint32_t ttl;
+    ASSERT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(value, Eq("value2"));
+    ASSERT_THAT(lock.Lock(kTimeout), Eq(WPEFramework::Core::ERROR_NONE));
+    ASSERT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(value, Eq("value2"));
+}
+
+TEST_F(AStore2, SendsValueChangedEventWithUpstreamValueWhenSetValueRejected)
+{
+    WPEFramework::Core::Event lock(false, true);
+    WPEFramework::Core::Sink<NiceMock<Store2NotificationMock>> sink;
+    EXPECT_CALL(sink, ValueChanged(_, _, _, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(sink, ValueChanged(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), Eq(kValue)))
+        .WillOnce(Invoke(
+            [&](const IStore2::ScopeType, const string&, const string&, const string&) {
+                lock.SetEvent();
+            }));
+    EXPECT_CALL(upstream, SetValue(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), Eq("value2"), kNoTtl))
+        .WillOnce(Return(WPEFramework::Core::ERROR_INVALID_INPUT_LENGTH));
+    EXPECT_CALL(upstream, GetValue(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), _, _))
+        .WillOnce(Invoke(
+            [](const IStore2::ScopeType, const string&, const string&, string& value, uint32_t& ttl) {
+                value = kValue;
+                ttl = kNoTtl;
+                return WPEFramework::Core::ERROR_NONE;
+            }));
+    Start();
+    store2->Register(&sink);
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, "value2", kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(lock.Lock(kTimeout), Eq(WPEFramework::Core::ERROR_NONE));
+    string value;
+    uint32_t ttl;
+    ASSERT_THAT(store2->GetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, value, ttl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(value, Eq(kValue));
+    store2->Unregister(&sink);
+}
+
+TEST_F(AStore2, SendsValueChangedEventWithEmptyValueWhenRejectedKeyNotUpstream)
+{
+    WPEFramework::Core::Event lock(false, true);
+    WPEFramework::Core::Sink<NiceMock<Store2NotificationMock>> sink;
+    EXPECT_CALL(sink, ValueChanged(_, _, _, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(sink, ValueChanged(IStore2::ScopeType::ACCOUNT, Eq(kAppId), Eq(kKey), Eq("")))
+        .WillOnce(Invoke(
+            [&](const IStore2::ScopeType, const string&, const string&, const string&) {
+                lock.SetEvent();
+            }));
+    EXPECT_CALL(upstream, SetValue(_, _, _, _, _))
+        .WillOnce(Return(WPEFramework::Core::ERROR_INVALID_INPUT_LENGTH));
+    EXPECT_CALL(upstream, GetValue(_, _, _, _, _))
+        .WillOnce(Return(WPEFramework::Core::ERROR_UNKNOWN_KEY));
+    Start();
+    store2->Register(&sink);
+    ASSERT_THAT(store2->SetValue(
+                    IStore2::ScopeType::ACCOUNT, kAppId, kKey, kValue, kNoTtl),
+        Eq(WPEFramework::Core::ERROR_NONE));
+    EXPECT_THAT(lock.Lock(kTimeout), Eq(WPEFramework::Core::ERROR_NONE));
+    store2->Unregister(&sink);
+}
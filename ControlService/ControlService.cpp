@@ -1206,7 +1206,7 @@ namespace WPEFramework {
             // Get the current lastKeyInfo from the ControlMgr, which tracks all the information.
             memset((void*)&lastKeyInfo, 0, sizeof(lastKeyInfo));
             lastKeyInfo.api_revision = CTRLM_MAIN_IARM_BUS_API_REVISION;
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_LAST_KEY_INFO_GET, (void*)&lastKeyInfo, sizeof(lastKeyInfo));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_LAST_KEY_INFO_GET, (void*)&lastKeyInfo, sizeof(lastKeyInfo));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - LAST_KEY_INFO_GET IARM_Bus_Call FAILED, res: %d", (int)res);
@@ -1351,7 +1351,7 @@ namespace WPEFramework {
             if (iarmSettings.available > 0)
             {
                 // Make the IARM call to controlMgr
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CONTROL_SERVICE_SET_VALUES, (void *)&iarmSettings, sizeof(iarmSettings));
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CONTROL_SERVICE_SET_VALUES, (void *)&iarmSettings, sizeof(iarmSettings));
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CONTROL_SERVICE_SET_VALUES IARM_Bus_Call FAILED, res: %d.", (int)res);
@@ -1386,7 +1386,7 @@ namespace WPEFramework {
             iarmSettings.api_revision = CTRLM_MAIN_IARM_BUS_API_REVISION;
 
             // Make the IARM call to controlMgr to get the settings
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CONTROL_SERVICE_GET_VALUES, (void *)&iarmSettings, sizeof(iarmSettings));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CONTROL_SERVICE_GET_VALUES, (void *)&iarmSettings, sizeof(iarmSettings));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - CONTROL_SERVICE_GET_VALUES IARM_Bus_Call FAILED, res: %d.", (int)res);
@@ -1442,7 +1442,7 @@ namespace WPEFramework {
             iarmMode.restrict_by_remote = (unsigned char)restrictions;
 
             // Make the IARM call to controlMgr
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CONTROL_SERVICE_START_PAIRING_MODE, (void *)&iarmMode, sizeof(iarmMode));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CONTROL_SERVICE_START_PAIRING_MODE, (void *)&iarmMode, sizeof(iarmMode));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - CONTROL_SERVICE_START_PAIRING_MODE IARM_Bus_Call FAILED, res: %d.", (int)res);
@@ -1483,7 +1483,7 @@ namespace WPEFramework {
             iarmMode.network_id = rf4ceId;
 
             // Make the IARM call to controlMgr
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CONTROL_SERVICE_END_PAIRING_MODE, (void *)&iarmMode, sizeof(iarmMode));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CONTROL_SERVICE_END_PAIRING_MODE, (void *)&iarmMode, sizeof(iarmMode));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - CONTROL_SERVICE_END_PAIRING_MODE IARM_Bus_Call FAILED, res: %d.", (int)res);
@@ -1541,7 +1541,7 @@ namespace WPEFramework {
             memcpy(&(pCmd->param_data[1]), &alert_duration, sizeof(alert_duration));
 
             // Make the IARM bus call to controlMgr
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_REVERSE_CMD, (void *)pCmd, totalsize);
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_REVERSE_CMD, (void *)pCmd, totalsize);
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - CTRLM_RCU_IARM_CALL_REVERSE_CMD IARM_Bus_Call FAILED, res: %d.", (int)res);
@@ -1603,7 +1603,7 @@ namespace WPEFramework {
             call.api_revision = CTRLM_MAIN_IARM_BUS_API_REVISION;
 
             // Make the IARM bus call to controlMgr
-            retval = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CONTROL_SERVICE_CAN_FIND_MY_REMOTE, (void *)&call, sizeof(call));
+            retval = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CONTROL_SERVICE_CAN_FIND_MY_REMOTE, (void *)&call, sizeof(call));
             if (retval != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - CTRLM_MAIN_IARM_CALL_CONTROL_SERVICE_CAN_FIND_MY_REMOTE - IARM_Bus_Call FAILED, retval: %d.", (int)retval);
@@ -1649,7 +1649,7 @@ namespace WPEFramework {
             call.network_id   = rf4ceId;
 
             // Make the IARM bus call to controlMgr
-            retval = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CHIP_STATUS_GET, (void *)&call, sizeof(call));
+            retval = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_CHIP_STATUS_GET, (void *)&call, sizeof(call));
             if (retval != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - CTRLM_MAIN_IARM_CALL_CHIP_STATUS_GET - IARM_Bus_Call FAILED, retval: <%d>.\n",
@@ -1775,7 +1775,7 @@ namespace WPEFramework {
             // Get the all the IR remote use history from ControlMgr.
             memset((void*)&irRemoteUsage, 0, sizeof(irRemoteUsage));
             irRemoteUsage.api_revision = CTRLM_MAIN_IARM_BUS_API_REVISION;
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_IR_REMOTE_USAGE_GET, (void*)&irRemoteUsage, sizeof(irRemoteUsage));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_IR_REMOTE_USAGE_GET, (void*)&irRemoteUsage, sizeof(irRemoteUsage));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - IR_REMOTE_USAGE_GET IARM_Bus_Call FAILED, res: %d", (int)res);
@@ -1801,7 +1801,7 @@ namespace WPEFramework {
 
             memset((void*)&status, 0, sizeof(status));
             status.api_revision = CTRLM_MAIN_IARM_BUS_API_REVISION;
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_STATUS_GET, (void*)&status, sizeof(status));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_STATUS_GET, (void*)&status, sizeof(status));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - STATUS_GET IARM_Bus_Call FAILED, res: %d", (int)res);
@@ -1853,7 +1853,7 @@ namespace WPEFramework {
             memset((void*)&netStatus, 0, sizeof(netStatus));
             netStatus.api_revision = CTRLM_MAIN_IARM_BUS_API_REVISION;
             netStatus.network_id = rf4ceId;
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_NETWORK_STATUS_GET, (void*)&netStatus, sizeof(netStatus));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_NETWORK_STATUS_GET, (void*)&netStatus, sizeof(netStatus));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - NETWORK_STATUS_GET IARM_Bus_Call FAILED, res: %d", (int)res);
@@ -1910,7 +1910,7 @@ namespace WPEFramework {
             // Get the ctrlm pairing metrics information, and add it to the stbData
             memset((void*)&pairMetrics, 0, sizeof(pairMetrics));
             pairMetrics.api_revision = CTRLM_MAIN_IARM_BUS_API_REVISION;
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_PAIRING_METRICS_GET, (void*)&pairMetrics, sizeof(pairMetrics));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_PAIRING_METRICS_GET, (void*)&pairMetrics, sizeof(pairMetrics));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - PAIRING_METRICS_GET IARM_Bus_Call FAILED, res: %d", (int)res);
@@ -1985,7 +1985,7 @@ namespace WPEFramework {
             // Otherwise, just do the load of the remoteInfo object from the controller_status passed in.
             if ((ctrlStatus.status.ieee_address == 0LL) && (ctrlStatus.status.short_address == 0) && (ctrlStatus.status.time_binding == 0))
             {
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_CONTROLLER_STATUS, (void*)&ctrlStatus, sizeof(ctrlStatus));
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_CONTROLLER_STATUS, (void*)&ctrlStatus, sizeof(ctrlStatus));
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CONTROLLER_STATUS IARM_Bus_Call FAILED, res: %d, controller_id: %d",
@@ -2196,7 +2196,7 @@ namespace WPEFramework {
                 ctrlStatus.network_id = netStatus.network_id;
                 ctrlStatus.controller_id = netStatus.status.rf4ce.controllers[i];
 
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_CONTROLLER_STATUS, (void*)&ctrlStatus, sizeof(ctrlStatus));
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_CONTROLLER_STATUS, (void*)&ctrlStatus, sizeof(ctrlStatus));
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CONTROLLER_STATUS IARM_Bus_Call FAILED, res: %d, controller_id: %d",
@@ -0,0 +1,165 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "AudioClipStream.h"
+
+#include <string.h>
+#include <algorithm>
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        AudioRingBuffer::AudioRingBuffer(size_t capacity)
+            : m_buffer(std::max<size_t>(capacity, 1))
+            , m_head(0)
+            , m_used(0)
+            , m_high_watermark(0)
+            , m_closed(false)
+            , m_aborted(false)
+        {
+        }
+
+        bool AudioRingBuffer::write(const unsigned char* data, size_t size)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (size > 0)
+            {
+                m_writable.wait(lock, [this]() { return m_aborted || (m_used < m_buffer.size()); });
+                if (m_aborted || m_closed)
+                    return false;
+
+                size_t tail = (m_head + m_used) % m_buffer.size();
+                size_t chunk = std::min(size, std::min(m_buffer.size() - m_used, m_buffer.size() - tail));
+                memcpy(&m_buffer[tail], data, chunk);
+                m_used += chunk;
+                m_high_watermark = std::max(m_high_watermark, m_used);
+                data += chunk;
+                size -= chunk;
+                m_readable.notify_one();
+            }
+            return true;
+        }
+
+        size_t AudioRingBuffer::read(unsigned char* data, size_t size)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_readable.wait(lock, [this]() { return m_aborted || m_closed || (m_used > 0); });
+            if (m_aborted)
+                return 0;
+
+            size_t total = 0;
+            while ((total < size) && (m_used > 0))
+            {
+                size_t chunk = std::min(size - total, std::min(m_used, m_buffer.size() - m_head));
+                memcpy(data + total, &m_buffer[m_head], chunk);
+                m_head = (m_head + chunk) % m_buffer.size();
+                m_used -= chunk;
+                total += chunk;
+            }
+            m_writable.notify_one();
+            return total;
+        }
+
+        void AudioRingBuffer::close()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            m_readable.notify_all();
+            m_writable.notify_all();
+        }
+
+        void AudioRingBuffer::abort()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_aborted = true;
+            m_readable.notify_all();
+            m_writable.notify_all();
+        }
+
+        bool AudioRingBuffer::aborted() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_aborted;
+        }
+
+        size_t AudioRingBuffer::highWatermark() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_high_watermark;
+        }
+
+        PcmDownsampler::PcmDownsampler(unsigned int channels, unsigned int input_rate, unsigned int output_rate)
+            : m_channels(std::min(std::max(channels, 1u), (unsigned int)(sizeof(m_partial) / 2)))
+            , m_input_rate(input_rate)
+            , m_output_rate(std::min(output_rate, input_rate))
+            , m_partial_size(0)
+            , m_phase(0)
+            , m_sum(0)
+            , m_count(0)
+        {
+        }
+
+        void PcmDownsampler::process(const unsigned char* data, size_t size, std::vector<unsigned char>& out)
+        {
+            const size_t frame_size = m_channels * 2;
+            out.reserve(out.size() + ((size / frame_size) * m_output_rate / std::max(m_input_rate, 1u) + 1) * 2);
+
+            while (size > 0)
+            {
+                const unsigned char* frame = data;
+                if ((m_partial_size > 0) || (size < frame_size))
+                {
+                    /* frame split across two reads */
+                    size_t chunk = std::min(frame_size - m_partial_size, size);
+                    memcpy(m_partial + m_partial_size, data, chunk);
+                    m_partial_size += chunk;
+                    data += chunk;
+                    size -= chunk;
+                    if (m_partial_size < frame_size)
+                        break;
+                    frame = m_partial;
+                    m_partial_size = 0;
+                }
+                else
+                {
+                    data += frame_size;
+                    size -= frame_size;
+                }
+
+                int32_t mono = 0;
+                for (unsigned int channel = 0; channel < m_channels; channel++)
+                    mono += (int16_t)(frame[channel * 2] | (frame[channel * 2 + 1] << 8));
+                m_sum += mono / (int32_t)m_channels;
+                m_count++;
+
+                m_phase += m_output_rate;
+                if (m_phase >= m_input_rate)
+                {
+                    m_phase -= m_input_rate;
+                    int16_t sample = (int16_t)(m_sum / (int64_t)m_count);
+                    out.push_back((unsigned char)(sample & 0xff));
+                    out.push_back((unsigned char)((sample >> 8) & 0xff));
+                    m_sum = 0;
+                    m_count = 0;
+                }
+            }
+        }
+
+    } // namespace Plugin
+} // namespace WPEFramework
@@ -0,0 +1,98 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace WPEFramework {
+    namespace Plugin {
+
+        /* Bounded byte queue between the thread reading the clip socket and the
+         * cURL upload. The writer blocks while the buffer is full, so memory use
+         * does not depend on the clip duration. */
+        class AudioRingBuffer
+        {
+        public:
+            explicit AudioRingBuffer(size_t capacity);
+
+            /* Blocks until all of data is queued. Returns false if the reader
+             * gave up (abort()) before that. */
+            bool write(const unsigned char* data, size_t size);
+
+            /* Blocks until at least one byte is available. Returns 0 once the
+             * writer closed the buffer and everything was read, or on abort(). */
+            size_t read(unsigned char* data, size_t size);
+
+            /* End of stream, called by the writer. */
+            void close();
+
+            /* Stop both sides, e.g. when the upload failed. */
+            void abort();
+
+            bool aborted() const;
+            size_t capacity() const { return m_buffer.size(); }
+            size_t highWatermark() const;
+
+        private:
+            AudioRingBuffer(const AudioRingBuffer&) = delete;
+            AudioRingBuffer& operator=(const AudioRingBuffer&) = delete;
+
+            std::vector<unsigned char> m_buffer;
+            size_t m_head;
+            size_t m_used;
+            size_t m_high_watermark;
+            bool m_closed;
+            bool m_aborted;
+            mutable std::mutex m_mutex;
+            std::condition_variable m_readable;
+            std::condition_variable m_writable;
+        };
+
+        /* Converts interleaved 16 bit little endian PCM to mono 16 bit PCM at a
+         * lower sample rate. Every output sample is the average of the input
+         * frames it covers, which is good enough as anti-aliasing for song and
+         * speech recognition back ends. Input may be split at any byte offset. */
+        class PcmDownsampler
+        {
+        public:
+            PcmDownsampler(unsigned int channels, unsigned int input_rate, unsigned int output_rate);
+
+            void process(const unsigned char* data, size_t size, std::vector<unsigned char>& out);
+
+            unsigned int channels() const { return m_channels; }
+            unsigned int output_rate() const { return m_output_rate; }
+
+        private:
+            const unsigned int m_channels;
+            const unsigned int m_input_rate;
+            const unsigned int m_output_rate;
+            unsigned char m_partial[16];
+            size_t m_partial_size;
+            unsigned int m_phase;
+            int64_t m_sum;
+            unsigned int m_count;
+        };
+
+    } // namespace Plugin
+} // namespace WPEFramework
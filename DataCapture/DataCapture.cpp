@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <regex>
+#include <thread>
 #undef LOG // we don't need LOG from audiocapturemgr_iarm as we are defining our own LOG
 #include "DataCapture.h"
 #include <curl/curl.h>
@@ -37,7 +38,10 @@ pthread_mutex_t WPEFramework::Plugin::DataCapture::_mutex = PTHREAD_MUTEX_INITIA
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 7
+#define API_VERSION_NUMBER_PATCH 8
+
+#define STREAM_CHUNK_SIZE 4096
+#define STREAM_RING_BUFFER_SIZE (64 * 1024)
 
 using namespace std;
 using namespace audiocapturemgr;
@@ -94,9 +98,14 @@ namespace WPEFramework {
             , _max_supported_duration(0)
             , _is_precapture(false)
             , _duration(0)
+            , _streaming(false)
+            , _sample_rate(0)
+            , _curl(nullptr)
         {
             LOGINFO("ctor");
 
+            curl_global_init(CURL_GLOBAL_ALL);
+
             cleanup_samples();
 
             DataCapture::_instance = this;
@@ -112,6 +121,10 @@ namespace WPEFramework {
             //LOGINFO("dtor");
             Unregister(METHOD_ENABLE_AUDIO_CAPTURE);
             Unregister(METHOD_GET_AUDIO_CLIP);
+
+            if (_curl)
+                curl_easy_cleanup(_curl);
+            curl_global_cleanup();
         }
 
         const string DataCapture::Initialize(PluginHost::IShell* /* service */)
@@ -222,12 +235,12 @@ namespace WPEFramework {
                     iarmbus_acm_arg_t param;
                     param.session_id = _session_id;
 
-                    ret = IARM_Bus_Call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_STOP, (void *) &param, sizeof(param));
+                    ret = Utils::IARM::call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_STOP, (void *) &param, sizeof(param));
                     if(IARM_RESULT_SUCCESS != ret)
                     {
                         LOGERR("Failed to stop audiocapturemgr session.");
                     }
-                    ret = IARM_Bus_Call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_CLOSE, (void *) &param, sizeof(param));
+                    ret = Utils::IARM::call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_CLOSE, (void *) &param, sizeof(param));
                     if(IARM_RESULT_SUCCESS != ret)
                     {
                         LOGERR("Failed to close audiocapturemgr session.");
@@ -243,7 +256,7 @@ namespace WPEFramework {
                 iarmbus_acm_arg_t param;
                 param.details.arg_open.source = 0; //primary
                 param.details.arg_open.output_type = BUFFERED_FILE_OUTPUT;
-                ret = IARM_Bus_Call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_OPEN, (void *) &param, sizeof(param));
+                ret = Utils::IARM::call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_OPEN, (void *) &param, sizeof(param));
                 if(!verify_result(ret, param))
                 {
                     return ACM_RESULT_PRECAPTURE_NOT_SUPPORTED;
@@ -255,7 +268,7 @@ namespace WPEFramework {
             {
                 iarmbus_acm_arg_t param;
                 param.session_id = _session_id;
-                ret = IARM_Bus_Call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_GET_OUTPUT_PROPS, (void *) &param, sizeof(param));
+                ret = Utils::IARM::call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_GET_OUTPUT_PROPS, (void *) &param, sizeof(param));
                 if(!verify_result(ret, param))
                 {
                     LOGWARN("Unable to read max duration. Setting safe limit of 10");
@@ -278,7 +291,7 @@ namespace WPEFramework {
                 iarmbus_acm_arg_t param;
                 param.session_id = _session_id;
                 param.details.arg_output_props.output.buffer_duration = incoming_duration;
-                ret = IARM_Bus_Call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_SET_OUTPUT_PROPERTIES, (void *) &param, sizeof(param));
+                ret = Utils::IARM::call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_SET_OUTPUT_PROPERTIES, (void *) &param, sizeof(param));
                 if(!verify_result(ret, param))
                 {
                     LOGERR("Failed to set precature duration.");
@@ -290,7 +303,7 @@ namespace WPEFramework {
             {
                 iarmbus_acm_arg_t param;
                 param.session_id = _session_id;
-                ret = IARM_Bus_Call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_GET_AUDIO_PROPS, (void *) &param, sizeof(param));
+                ret = Utils::IARM::call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_GET_AUDIO_PROPS, (void *) &param, sizeof(param));
                 if(!verify_result(ret, param))
                 {
                     LOGERR("Failed to get output properties.");
@@ -307,7 +320,7 @@ namespace WPEFramework {
             {
                 iarmbus_acm_arg_t param;
                 param.session_id = _session_id ;
-                ret = IARM_Bus_Call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_START, (void *) &param, sizeof(param));
+                ret = Utils::IARM::call(IARMBUS_AUDIOCAPTUREMGR_NAME, IARMBUS_AUDIOCAPTUREMGR_START, (void *) &param, sizeof(param));
                 if(!verify_result(ret, param))
                 {
                     LOGERR("Failed to start audiocapture session");
@@ -324,9 +337,11 @@ namespace WPEFramework {
             _duration = (unsigned int)clipRequest["duration"].Number();
             const string& captureMode = clipRequest["captureMode"].String();
             _is_precapture = (captureMode == "preCapture");
+            _streaming = clipRequest.HasLabel("streaming") && clipRequest["streaming"].Boolean();
+            _sample_rate = clipRequest.HasLabel("sampleRate") ? (unsigned int)clipRequest["sampleRate"].Number() : 0;
 
-            LOGINFO("DataCaptureService calling getAudioClip: stream = %s, url = %s, duration = %d, captureMode = %s, session id = %d",
-                         stream.c_str(), _destination_url.c_str(), _duration, captureMode.c_str(), _session_id);
+            LOGINFO("DataCaptureService calling getAudioClip: stream = %s, url = %s, duration = %d, captureMode = %s, session id = %d, streaming = %d, sampleRate = %u",
+                         stream.c_str(), _destination_url.c_str(), _duration, captureMode.c_str(), _session_id, _streaming, _sample_rate);
 
             if(0 > _session_id)
             {
@@ -352,7 +367,7 @@ namespace WPEFramework {
                 return ACM_RESULT_DURATION_OUT_OF_BOUNDS; // return max supported duration.
             }
 
-            IARM_Result_t ret = IARM_Bus_Call(IARMBUS_AUDIOCAPTUREMGR_NAME,  IARMBUS_AUDIOCAPTUREMGR_REQUEST_SAMPLE, (void *) &param, sizeof(param));
+            IARM_Result_t ret = Utils::IARM::call(IARMBUS_AUDIOCAPTUREMGR_NAME,  IARMBUS_AUDIOCAPTUREMGR_REQUEST_SAMPLE, (void *) &param, sizeof(param));
             if(IARM_RESULT_SUCCESS != ret)
             {
                 return ACM_RESULT_GENERAL_FAILURE;
@@ -431,6 +446,35 @@ namespace WPEFramework {
                 JsonObject params;
                 params["fileName"] = fileName;
 
+                if (_streaming)
+                {
+                    bool has_data = false;
+                    std::string error_str;
+                    if (streamDataToUrl(payload->dataLocator, _destination_url.c_str(), has_data, error_str))
+                    {
+                        params["status"] = true;
+                        params["message"] = "Success";
+                    }
+                    else if (has_data)
+                    {
+                        LOGERR("Upload failed: %s (cURL error)", C_STR(error_str));
+                        params["status"] = false;
+                        params["message"] = std::string("Upload Failed: ") + error_str;
+                    }
+                    else
+                    {
+                        LOGERR("Unable to read data from %s (connection error)", payload->dataLocator);
+                        params["status"] = false;
+                        params["message"] = std::string("Unable to read data from  ") + string(payload->dataLocator);
+                    }
+
+                    string message;
+                    params.ToString(message);
+                    LOGINFO("Sending notification %s: %s", C_STR(EVT_ON_AUDIO_CLIP_READY), C_STR(message));
+                    sendNotify(C_STR(EVT_ON_AUDIO_CLIP_READY), params);
+                    return;
+                }
+
                 while (attemptsLeft) {
                     if(0 == _sock_adaptor->connect_socket(payload->dataLocator))
                     {
@@ -488,8 +532,7 @@ namespace WPEFramework {
         bool DataCapture::uploadDataToUrl(std::vector<unsigned char> &data, const char *url, std::string &error_str)
         {
             CURL *curl;
-            CURLcode res;
-            bool call_succeeded = true;
+            bool call_succeeded;
 
             if(!url || !strlen(url))
             {
@@ -499,10 +542,7 @@ namespace WPEFramework {
 
             LOGWARN("uploading pcm data of size %zu to '%s'", data.size(), url);
 
-            //init curl
-            curl_global_init(CURL_GLOBAL_ALL);
-            curl = curl_easy_init();
-
+            curl = curlHandle();
             if(!curl)
             {
                 LOGERR("could not init curl\n");
@@ -522,7 +562,140 @@ namespace WPEFramework {
                 LOGWARN("Failed to set curl option: CURLOPT_POSTFIELDSIZE");
             if(curl_easy_setopt(curl, CURLOPT_POSTFIELDS, &data[0]) != CURLE_OK)
                 LOGWARN("Failed to set curl option: CURLOPT_POSTFIELDS");
-        
+
+            call_succeeded = performUpload(curl, error_str);
+
+            curl_slist_free_all(chunk);
+
+            return call_succeeded;
+        }
+
+        bool DataCapture::streamDataToUrl(const char *dataLocator, const char *url, bool &has_data, std::string &error_str)
+        {
+            std::vector<char> chunk(STREAM_CHUNK_SIZE);
+            int size = 0;
+
+            has_data = false;
+            for (int attemptsLeft = 2; (attemptsLeft > 0) && (size <= 0); --attemptsLeft)
+            {
+                if (0 == _sock_adaptor->connect_socket(dataLocator))
+                    size = _sock_adaptor->read_data(chunk.data(), chunk.size()); // closes the socket at the end of the stream
+                if ((size <= 0) && (attemptsLeft > 1))
+                {
+                    LOGWARN("No data in the socket. One more attempt in 1 sec");
+                    usleep(1000 * 1000);
+                }
+            }
+            if (size <= 0)
+                return false;
+            has_data = true;
+
+            /* The socket is read on a separate thread so the upload can start with
+             * the first chunk, instead of after the whole clip was received. */
+            AudioRingBuffer ring(STREAM_RING_BUFFER_SIZE);
+            std::unique_ptr<PcmDownsampler> downsampler(createDownsampler());
+            size_t received = 0;
+
+            std::thread reader([&]() {
+                std::vector<unsigned char> converted;
+                bool writing = true;
+                while (size > 0)
+                {
+                    received += size;
+                    if (writing)
+                    {
+                        const unsigned char *bytes = reinterpret_cast<const unsigned char*>(chunk.data());
+                        size_t length = size;
+                        if (downsampler)
+                        {
+                            converted.clear();
+                            downsampler->process(bytes, length, converted);
+                            bytes = converted.data();
+                            length = converted.size();
+                        }
+                        // keep draining the socket after the upload gave up, so the producer is not stalled
+                        writing = (length == 0) || ring.write(bytes, length);
+                    }
+                    size = _sock_adaptor->read_data(chunk.data(), chunk.size());
+                }
+
+                if (size < 0)
+                    ring.abort();
+                else
+                    ring.close();
+            });
+
+            bool call_succeeded = uploadStreamToUrl(ring, url, error_str);
+
+            ring.abort();
+            reader.join();
+
+            LOGINFO("streamed %zu bytes of pcm data, peak buffer use %zu of %zu bytes", received, ring.highWatermark(), ring.capacity());
+            return call_succeeded;
+        }
+
+        bool DataCapture::uploadStreamToUrl(AudioRingBuffer &ring, const char *url, std::string &error_str)
+        {
+            CURL *curl;
+            bool call_succeeded;
+
+            if(!url || !strlen(url))
+            {
+                LOGERR("no url given");
+                error_str = "no url given";
+                return false;
+            }
+
+            LOGWARN("streaming pcm data to '%s'", url);
+
+            curl = curlHandle();
+            if(!curl)
+            {
+                LOGERR("could not init curl\n");
+                error_str = "could not init curl";
+                return false;
+            }
+
+            //create header, the body length is not known upfront
+            struct curl_slist *chunk = NULL;
+            chunk = curl_slist_append(chunk, "Content-Type: audio/x-wav");
+            chunk = curl_slist_append(chunk, "Transfer-Encoding: chunked");
+            chunk = curl_slist_append(chunk, "Expect:");
+
+            if(curl_easy_setopt(curl, CURLOPT_URL, url) != CURLE_OK)
+                LOGWARN("Failed to set curl option: CURLOPT_URL");
+            if(curl_easy_setopt(curl, CURLOPT_HTTPHEADER, chunk) != CURLE_OK)
+                LOGWARN("Failed to set curl option: CURLOPT_HTTPHEADER");
+            if(curl_easy_setopt(curl, CURLOPT_POST, 1L) != CURLE_OK)
+                LOGWARN("Failed to set curl option: CURLOPT_POST");
+            if(curl_easy_setopt(curl, CURLOPT_READFUNCTION, curlReadCallback) != CURLE_OK)
+                LOGWARN("Failed to set curl option: CURLOPT_READFUNCTION");
+            if(curl_easy_setopt(curl, CURLOPT_READDATA, &ring) != CURLE_OK)
+                LOGWARN("Failed to set curl option: CURLOPT_READDATA");
+
+            call_succeeded = performUpload(curl, error_str);
+
+            curl_slist_free_all(chunk);
+
+            return call_succeeded;
+        }
+
+        size_t DataCapture::curlReadCallback(char *buffer, size_t size, size_t nitems, void *userdata)
+        {
+            AudioRingBuffer *ring = static_cast<AudioRingBuffer*>(userdata);
+            size_t length = ring->read(reinterpret_cast<unsigned char*>(buffer), size * nitems);
+            if ((0 == length) && ring->aborted())
+            {
+                LOGERR("clip stream interrupted");
+                return CURL_READFUNC_ABORT;
+            }
+            return length;
+        }
+
+        bool DataCapture::performUpload(CURL *curl, std::string &error_str)
+        {
+            CURLcode res;
+            bool call_succeeded = true;
 
             //perform blocking upload call
             res = curl_easy_perform(curl);
@@ -549,12 +722,59 @@ namespace WPEFramework {
                 error_str = std::to_string(res) + std::string(":'") + std::string(curl_easy_strerror(res)) + std::string("'");
                 call_succeeded = false;
             }
-            //clean up curl object
-            curl_easy_cleanup(curl);
-            curl_slist_free_all(chunk);
 
             return call_succeeded;
         }
+
+        CURL* DataCapture::curlHandle()
+        {
+            /* One handle for all uploads, so the connection to the service can be reused */
+            if (_curl)
+                curl_easy_reset(_curl);
+            else
+                _curl = curl_easy_init();
+            return _curl;
+        }
+
+        PcmDownsampler* DataCapture::createDownsampler() const
+        {
+            unsigned int channels;
+            unsigned int rate;
+
+            if (0 == _sample_rate)
+                return nullptr;
+
+            switch(_audio_properties.format)
+            {
+                case acmFormate16BitStereo:
+                    channels = 2; break;
+                case acmFormate16BitMonoLeft: //fall-through
+                case acmFormate16BitMonoRight: //fall-through
+                case acmFormate16BitMono:
+                    channels = 1; break;
+                default:
+                    LOGWARN("Downsampling is only supported for 16 bit PCM, sending the clip as captured");
+                    return nullptr;
+            }
+
+            switch(_audio_properties.sampling_frequency)
+            {
+                case acmFreqe48000: rate = 48000; break;
+                case acmFreqe44100: rate = 44100; break;
+                case acmFreqe32000: rate = 32000; break;
+                case acmFreqe24000: rate = 24000; break;
+                case acmFreqe16000: rate = 16000; break;
+                default:
+                    LOGWARN("Unknown capture sampling rate, sending the clip as captured");
+                    return nullptr;
+            }
+
+            if (_sample_rate >= rate)
+                return nullptr;
+
+            LOGINFO("Downsampling %u channel(s) at %u Hz to mono at %u Hz", channels, rate, _sample_rate);
+            return new PcmDownsampler(channels, rate, _sample_rate);
+        }
         // Internal methods end
     } // namespace Plugin
 } // namespace WPEFramework
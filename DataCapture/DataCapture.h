@@ -20,10 +20,12 @@
 #pragma once
 
 #include <memory>
+#include <curl/curl.h>
 
 #include "Module.h"
 #include "audiocapturemgr_iarm.h"
 #include "libIARM.h"
+#include "AudioClipStream.h"
 
 class socket_adaptor;
 
@@ -69,6 +71,12 @@ namespace WPEFramework {
             int getAudioClip(const JsonObject& clipRequest);
             void constructFormatString();
             bool uploadDataToUrl(std::vector<unsigned char> &data, const char *url, std::string &error_str);
+            bool streamDataToUrl(const char *dataLocator, const char *url, bool &has_data, std::string &error_str);
+            bool uploadStreamToUrl(AudioRingBuffer &ring, const char *url, std::string &error_str);
+            bool performUpload(CURL *curl, std::string &error_str);
+            CURL* curlHandle();
+            PcmDownsampler* createDownsampler() const;
+            static size_t curlReadCallback(char *buffer, size_t size, size_t nitems, void *userdata);
         private/*members*/:
             audiocapturemgr::session_id_t _session_id;
             unsigned int _max_supported_duration;
@@ -78,6 +86,9 @@ namespace WPEFramework {
             string _destination_url;
             bool _is_precapture;
             unsigned int _duration;
+            bool _streaming;
+            unsigned int _sample_rate;
+            CURL *_curl;
             static pthread_mutex_t _mutex;
         };
     } // namespace Plugin
@@ -158,6 +158,34 @@ int socket_adaptor::fetch_data()
     return total_size;
 }
 
+int socket_adaptor::read_data(char * buffer, const unsigned int size)
+{
+    if(m_read_fd < 0) {
+        SA_ERR("Unable to read data. Did you connect?");
+        return -1;
+    }
+
+    int ret;
+    do
+    {
+        ret = read(m_read_fd, buffer, size);
+    }
+    while(ret < 0 && errno == EINTR);
+
+    if(ret <= 0)
+    {
+        if(ret < 0)
+        {
+            SA_ERR("read() failed, errno: 0x%x\n", errno);
+        }
+        close(m_read_fd);
+        lock();
+        m_read_fd = -1;
+        unlock();
+    }
+    return ret;
+}
+
 void socket_adaptor::get_data(std::vector<unsigned char>& data)
 {
     if (m_fetch_buffer.empty())
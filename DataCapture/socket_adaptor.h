@@ -117,6 +117,18 @@ class socket_adaptor
      */
     int fetch_data();
 
+    /**
+     *  @brief This api invokes a single unix read() on the connected socket, for
+     *  consumers that process the data while it is still being received.
+     *  The socket is closed once the peer closes it or on an error.
+     *
+     *  @param[out] buffer Data buffer.
+     *  @param[in] size   Size of the buffer
+     *
+     *  @return Returns length of the data, 0 at the end of the stream or -1 in case of an error
+     */
+    int read_data(char * buffer, const unsigned int size);
+
     /**
      *  @brief This api provides the previously fetched data
      *
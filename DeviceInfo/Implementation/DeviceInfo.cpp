@@ -39,7 +39,7 @@ namespace Plugin {
             IARM_Bus_MFRLib_GetSerializedData_Param_t param;
             param.bufLen = 0;
             param.type = type;
-            auto status = IARM_Bus_Call(
+            auto status = Utils::IARM::call(
                 IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_GetSerializedData, &param, sizeof(param));
             if ((status == IARM_RESULT_SUCCESS) && param.bufLen) {
                 response.assign(param.buffer, param.bufLen);
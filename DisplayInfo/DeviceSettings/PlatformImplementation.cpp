@@ -32,8 +32,8 @@
 #include "audioOutputPortType.hpp"
 #include "audioOutputPortConfig.hpp"
 #include "manager.hpp"
-#include "edid-parser.hpp"
 #include "UtilsIarm.h"
+#include "UtilsEdid.h"
 
 #include "libIBus.h"
 #include "libIBusDaemon.h"
@@ -41,6 +41,7 @@
 
 #define EDID_MAX_HORIZONTAL_SIZE 21
 #define EDID_MAX_VERTICAL_SIZE   22
+#define EDID_CACHE_DISPLAY       0
 
 namespace WPEFramework {
 namespace Plugin {
@@ -63,6 +64,7 @@ public:
             IARM_Result_t res;
             IARM_CHECK( IARM_Bus_RegisterEventHandler(IARM_BUS_DSMGR_NAME,IARM_BUS_DSMGR_EVENT_RES_PRECHANGE,ResolutionChange) );
             IARM_CHECK( IARM_Bus_RegisterEventHandler(IARM_BUS_DSMGR_NAME,IARM_BUS_DSMGR_EVENT_RES_POSTCHANGE, ResolutionChange) );
+            IARM_CHECK( IARM_Bus_RegisterEventHandler(IARM_BUS_DSMGR_NAME,IARM_BUS_DSMGR_EVENT_HDMI_HOTPLUG, HdmiHotplug) );
 
             //TODO: this is probably per process so we either need to be running in our own process or be carefull no other plugin is calling it
             device::Manager::Initialize();
@@ -82,6 +84,7 @@ public:
         IARM_Result_t res;
         IARM_CHECK( IARM_Bus_RemoveEventHandler(IARM_BUS_DSMGR_NAME,IARM_BUS_DSMGR_EVENT_RES_PRECHANGE,ResolutionChange) );
         IARM_CHECK( IARM_Bus_RemoveEventHandler(IARM_BUS_DSMGR_NAME,IARM_BUS_DSMGR_EVENT_RES_POSTCHANGE,ResolutionChange) );
+        IARM_CHECK( IARM_Bus_RemoveEventHandler(IARM_BUS_DSMGR_NAME,IARM_BUS_DSMGR_EVENT_HDMI_HOTPLUG,HdmiHotplug) );
         DisplayInfoImplementation::_instance = nullptr;
     }
 
@@ -152,6 +155,15 @@ public:
         }
     }
 
+    static void HdmiHotplug(const char *owner, IARM_EventId_t eventId, void *data, size_t len)
+    {
+        // The EDID is read again from the new (or no) display on next use.
+        if(DisplayInfoImplementation::_instance)
+        {
+           DisplayInfoImplementation::_instance->_edidCache.Invalidate(EDID_CACHE_DISPLAY);
+        }
+    }
+
     void ResolutionChangeImpl(IConnectionProperties::INotification::Source eventtype)
     {
         _adminLock.Lock();
@@ -211,31 +223,12 @@ public:
     }
     uint32_t VerticalFreq(uint32_t& value) const override
     {
-        vector<uint8_t> edidVec;
-        uint32_t ret = GetEdidBytes(edidVec);
+        Utils::Edid::Capabilities caps;
+        uint32_t ret = GetEdidCapabilities(caps);
         if (ret == Core::ERROR_NONE)
         {
-            uint32_t edidLen = edidVec.size();
-            unsigned char* edidbytes = new unsigned char [edidLen];
-            std::copy(edidVec.begin(), edidVec.end(), edidbytes);
-            if (edid_parser::EDID_Verify(edidbytes, edidLen) == edid_parser::EDID_STATUS_OK)
-            {
-                edid_parser::edid_data_t data_ptr;
-                edid_parser::EDID_Parse(edidbytes, edidLen, &data_ptr);
-                value = data_ptr.res.refresh;
-                TRACE(Trace::Information, (_T("Vertical frequency = %d"), value));
-            }
-            else
-            {
-                TRACE(Trace::Information, (_T("EDID Verification failed")));
-                ret = Core::ERROR_GENERAL;
-            }
-            delete[] edidbytes;
-        }
-        else
-        {
-            TRACE(Trace::Information, (_T("HDMI not connected")));
-            ret = Core::ERROR_GENERAL;
+            value = caps.preferredRefresh;
+            TRACE(Trace::Information, (_T("Vertical frequency = %d"), value));
         }
         return ret;
    }
@@ -336,7 +329,10 @@ public:
             {
                 std::vector<uint8_t> edidVec;
 
-                vPort.getDisplay().getEDIDBytes(edidVec);
+                _edidCache.Bytes(EDID_CACHE_DISPLAY, [&vPort](vector<uint8_t>& bytes) {
+                    vPort.getDisplay().getEDIDBytes(bytes);
+                    return !bytes.empty();
+                }, edidVec);
 
                 if(edidVec.size() > EDID_MAX_VERTICAL_SIZE)
                 {
@@ -367,7 +363,10 @@ public:
             device::VideoOutputPort vPort = device::Host::getInstance().getVideoOutputPort(strVideoPort.c_str());
             if (vPort.isDisplayConnected())
             {
-                vPort.getDisplay().getEDIDBytes(edidVec2);
+                _edidCache.Bytes(EDID_CACHE_DISPLAY, [&vPort](vector<uint8_t>& bytes) {
+                    vPort.getDisplay().getEDIDBytes(bytes);
+                    return !bytes.empty();
+                }, edidVec2);
                 edidVec = edidVec2;//edidVec must be "unknown" unless we successfully get to this line
             }
             else
@@ -577,40 +576,21 @@ public:
     uint32_t Colorimetry(IColorimetryIterator*& colorimetry /* @out */) const override
     {
         std::list<Exchange::IDisplayProperties::ColorimetryType> colorimetryCaps;
-        vector<uint8_t> edidVec;
-        uint32_t ret = GetEdidBytes(edidVec);
+        Utils::Edid::Capabilities caps;
+        uint32_t ret = GetEdidCapabilities(caps);
         if (ret == Core::ERROR_NONE)
         {
-            uint32_t edidLen = edidVec.size();
-            unsigned char* edidbytes = new unsigned char [edidLen];
-            std::copy(edidVec.begin(), edidVec.end(), edidbytes);
-            if (edid_parser::EDID_Verify(edidbytes, edidLen) == edid_parser::EDID_STATUS_OK)
-            {
-                edid_parser::edid_data_t data_ptr;
-                edid_parser::EDID_Parse(edidbytes, edidLen, &data_ptr);
-                uint32_t colorimetry_info = data_ptr.colorimetry_info;
-                TRACE(Trace::Information, (_T("colorimetry = %d"),colorimetry_info));
-                if (!colorimetry_info) colorimetryCaps.push_back(COLORIMETRY_UNKNOWN);
-                if (colorimetry_info & edid_parser::COLORIMETRY_INFO_XVYCC601) colorimetryCaps.push_back(COLORIMETRY_XVYCC601);
-                if (colorimetry_info & edid_parser::COLORIMETRY_INFO_XVYCC709) colorimetryCaps.push_back(COLORIMETRY_XVYCC709);
-                if (colorimetry_info & edid_parser::COLORIMETRY_INFO_SYCC601) colorimetryCaps.push_back(COLORIMETRY_SYCC601);
-                if (colorimetry_info & edid_parser::COLORIMETRY_INFO_ADOBEYCC601) colorimetryCaps.push_back(COLORIMETRY_OPYCC601);
-                if (colorimetry_info & edid_parser::COLORIMETRY_INFO_ADOBERGB) colorimetryCaps.push_back(COLORIMETRY_OPRGB);
-                if (colorimetry_info & edid_parser::COLORIMETRY_INFO_BT2020CL || colorimetry_info & edid_parser::COLORIMETRY_INFO_BT2020NCL) colorimetryCaps.push_back(COLORIMETRY_BT2020YCCBCBRC);
-                if (colorimetry_info & edid_parser::COLORIMETRY_INFO_BT2020RGB) colorimetryCaps.push_back(COLORIMETRY_BT2020RGB_YCBCR);
-                if (colorimetry_info & edid_parser::COLORIMETRY_INFO_DCI_P3) colorimetryCaps.push_back(COLORIMETRY_OTHER);
-            }
-            else
-            {
-                TRACE(Trace::Error, (_T("EDID Verification failed")));
-                ret = Core::ERROR_GENERAL;
-            }
-            delete[] edidbytes;
-        }
-        else
-        {
-            TRACE(Trace::Error, (_T("HDMI not connected!")));
-            ret = Core::ERROR_GENERAL;
+            uint32_t colorimetry_info = caps.colorimetry;
+            TRACE(Trace::Information, (_T("colorimetry = %d"),colorimetry_info));
+            if (!colorimetry_info) colorimetryCaps.push_back(COLORIMETRY_UNKNOWN);
+            if (colorimetry_info & Utils::Edid::COLORIMETRY_XVYCC601) colorimetryCaps.push_back(COLORIMETRY_XVYCC601);
+            if (colorimetry_info & Utils::Edid::COLORIMETRY_XVYCC709) colorimetryCaps.push_back(COLORIMETRY_XVYCC709);
+            if (colorimetry_info & Utils::Edid::COLORIMETRY_SYCC601) colorimetryCaps.push_back(COLORIMETRY_SYCC601);
+            if (colorimetry_info & Utils::Edid::COLORIMETRY_OPYCC601) colorimetryCaps.push_back(COLORIMETRY_OPYCC601);
+            if (colorimetry_info & Utils::Edid::COLORIMETRY_OPRGB) colorimetryCaps.push_back(COLORIMETRY_OPRGB);
+            if (colorimetry_info & Utils::Edid::COLORIMETRY_BT2020CYCC || colorimetry_info & Utils::Edid::COLORIMETRY_BT2020YCC) colorimetryCaps.push_back(COLORIMETRY_BT2020YCCBCBRC);
+            if (colorimetry_info & Utils::Edid::COLORIMETRY_BT2020RGB) colorimetryCaps.push_back(COLORIMETRY_BT2020RGB_YCBCR);
+            if (colorimetry_info & Utils::Edid::COLORIMETRY_DCI_P3) colorimetryCaps.push_back(COLORIMETRY_OTHER);
         }
         colorimetry = Core::Service<ColorimetryIteratorImplementation>::Create<Exchange::IDisplayProperties::IColorimetryIterator>(colorimetryCaps);
         return (colorimetry != nullptr && ret == Core::ERROR_NONE ? Core::ERROR_NONE : Core::ERROR_GENERAL);
@@ -754,6 +734,7 @@ public:
 private:
     std::list<IConnectionProperties::INotification*> _observers;
     mutable Core::CriticalSection _adminLock;
+    mutable Utils::Edid::Cache _edidCache;
 
 private:
     uint32_t GetEdidBytes(vector<uint8_t> &edid) const
@@ -765,7 +746,10 @@ private:
             device::VideoOutputPort vPort = device::Host::getInstance().getVideoOutputPort(strVideoPort.c_str());
             if (vPort.isDisplayConnected())
             {
-                vPort.getDisplay().getEDIDBytes(edid);
+                _edidCache.Bytes(EDID_CACHE_DISPLAY, [&vPort](vector<uint8_t>& bytes) {
+                    vPort.getDisplay().getEDIDBytes(bytes);
+                    return !bytes.empty();
+                }, edid);
             }
             else
             {
@@ -783,6 +767,35 @@ private:
         return ret;
     }
 
+    uint32_t GetEdidCapabilities(Utils::Edid::Capabilities &caps) const
+    {
+        uint32_t ret = Core::ERROR_NONE;
+        try
+        {
+            std::string strVideoPort = device::Host::getInstance().getDefaultVideoPortName();
+            device::VideoOutputPort vPort = device::Host::getInstance().getVideoOutputPort(strVideoPort.c_str());
+            if (!vPort.isDisplayConnected())
+            {
+                TRACE(Trace::Error, (_T("HDMI not connected!")));
+                ret = Core::ERROR_GENERAL;
+            }
+            else if (!_edidCache.Parsed(EDID_CACHE_DISPLAY, [&vPort](vector<uint8_t>& bytes) {
+                         vPort.getDisplay().getEDIDBytes(bytes);
+                         return !bytes.empty();
+                     }, caps))
+            {
+                TRACE(Trace::Error, (_T("EDID Verification failed")));
+                ret = Core::ERROR_GENERAL;
+            }
+        }
+        catch (const device::Exception& err)
+        {
+            TRACE(Trace::Error, (_T("caught an exception: %d, %s"),err.getCode(), err.what()));
+            ret = Core::ERROR_GENERAL;
+        }
+
+        return ret;
+    }
 
 public:
     static DisplayInfoImplementation* _instance;
@@ -77,6 +77,8 @@ using namespace std;
 #define SAD_UPDATE_CHECK_TIME_IN_MILLISECONDS 3000
 #define ARC_DETECTION_CHECK_TIME_IN_MILLISECONDS 1000
 #define AUDIO_DEVICE_POWER_TRANSITION_TIME_IN_MILLISECONDS 1000
+#define EDID_CACHE_DISPLAY 0
+#define EDID_CACHE_HOST 1
 
 #define RFC_PWRMGR2 "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Power.PwrMgr2.Enable"
 
@@ -85,7 +87,7 @@ using namespace std;
 
 #define API_VERSION_NUMBER_MAJOR 2
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 0
+#define API_VERSION_NUMBER_PATCH 2
 
 static bool isCecEnabled = false;
 static bool isResCacheUpdated = false;
@@ -367,6 +369,7 @@ namespace WPEFramework {
             registerMethodLockedApi("getPreferredColorDepth", &DisplaySettings::getPreferredColorDepth, this);
             registerMethodLockedApi("getColorDepthCapabilities", &DisplaySettings::getColorDepthCapabilities, this);
 	    registerMethodLockedApi("getSupportedMS12Config", &DisplaySettings::getSupportedMS12Config, this);
+            Utils::Synchro::RegisterLockStatisticsApi(this);
            
 
 	    m_subscribed = false; //HdmiCecSink event subscription
@@ -738,7 +741,7 @@ namespace WPEFramework {
                 IARM_CHECK( Utils::Synchro::RegisterLockedIarmEventHandler<DisplaySettings>(IARM_BUS_DSMGR_NAME, IARM_BUS_DSMGR_EVENT_AUDIO_PRIMARY_LANGUAGE_CHANGED, dsSettingsChangeEventHandler) );
                 IARM_CHECK( Utils::Synchro::RegisterLockedIarmEventHandler<DisplaySettings>(IARM_BUS_DSMGR_NAME, IARM_BUS_DSMGR_EVENT_AUDIO_SECONDARY_LANGUAGE_CHANGED, dsSettingsChangeEventHandler) ); 
  
-                res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState, (void *)&param, sizeof(param));
+                res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState, (void *)&param, sizeof(param));
                 if (res == IARM_RESULT_SUCCESS)
                 {
                     m_powerState = param.curState;
@@ -902,6 +905,8 @@ namespace WPEFramework {
                 isResCacheUpdated = false;
                 isDisplayConnectedCacheUpdated = false;
                 isStbHDRcapabilitiesCache = false;
+                if(DisplaySettings::_instance)
+                    DisplaySettings::_instance->m_edidCache.Invalidate(EDID_CACHE_DISPLAY);
                 //TODO(MROLLINS) note that there are several services listening for the notifyHdmiHotPlugEvent ServiceManagerNotifier broadcast
                 //So if DisplaySettings becomes the owner/originator of this, then those future thunder plugins need to listen to our event
                 //But of course, nothing is stopping any thunder plugin for listening to iarm event directly -- this is getting murky
@@ -1964,7 +1969,10 @@ namespace WPEFramework {
                 device::VideoOutputPort vPort = device::Host::getInstance().getVideoOutputPort(strVideoPort.c_str());
                 if (isDisplayConnected(strVideoPort))
                 {
-                    vPort.getDisplay().getEDIDBytes(edidVec2);
+                    m_edidCache.Bytes(EDID_CACHE_DISPLAY, [&vPort](vector<uint8_t>& bytes) {
+                        vPort.getDisplay().getEDIDBytes(bytes);
+                        return !bytes.empty();
+                    }, edidVec2);
                     edidVec = edidVec2;//edidVec must be "unknown" unless we successfully get to this line
 
                     //convert to base64
@@ -1999,7 +2007,10 @@ namespace WPEFramework {
             try
             {
                 vector<unsigned char> edidVec2;
-                device::Host::getInstance().getHostEDID(edidVec2);
+                m_edidCache.Bytes(EDID_CACHE_HOST, [](vector<uint8_t>& bytes) {
+                    device::Host::getInstance().getHostEDID(bytes);
+                    return !bytes.empty();
+                }, edidVec2);
                 edidVec = edidVec2;//edidVec must be "unknown" unless we successfully get to this line
                 LOGINFO("getHostEDID size is %d.", int(edidVec2.size()));
             }
@@ -2217,7 +2228,7 @@ namespace WPEFramework {
                 param.isEnabled = enabled;
                 strncpy(param.port, portname.c_str(), PWRMGR_MAX_VIDEO_PORT_NAME_LENGTH);
                 param.port[sizeof(param.port) - 1] = '\0';
-                if(IARM_RESULT_SUCCESS != IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_SetStandbyVideoState, &param, sizeof(param)))
+                if(IARM_RESULT_SUCCESS != Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_SetStandbyVideoState, &param, sizeof(param)))
                 {
                     LOGERR("Port: %s. enable: %d", param.port, param.isEnabled);
                     response["error_message"] = "Bus failure";
@@ -2236,7 +2247,7 @@ namespace WPEFramework {
                 param.isEnabled = enabled;
                 strncpy(param.port, portname.c_str(), PWRMGR_MAX_VIDEO_PORT_NAME_LENGTH);
                 param.port[sizeof(param.port) - 1] = '\0';
-                if(IARM_RESULT_SUCCESS != IARM_Bus_Call(IARM_BUS_DSMGR_NAME, IARM_BUS_DSMGR_API_SetStandbyVideoState, &param, sizeof(param)))
+                if(IARM_RESULT_SUCCESS != Utils::IARM::call(IARM_BUS_DSMGR_NAME, IARM_BUS_DSMGR_API_SetStandbyVideoState, &param, sizeof(param)))
                 {
                     LOGERR("Port: %s. enable: %d", param.port, param.isEnabled);
                     response["error_message"] = "Bus failure";
@@ -2264,7 +2275,7 @@ namespace WPEFramework {
             {
                 IARM_Bus_PWRMgr_StandbyVideoState_Param_t param;
                 strncpy(param.port, portname.c_str(), PWRMGR_MAX_VIDEO_PORT_NAME_LENGTH);
-                if(IARM_RESULT_SUCCESS != IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetStandbyVideoState, &param, sizeof(param)))
+                if(IARM_RESULT_SUCCESS != Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetStandbyVideoState, &param, sizeof(param)))
                 {
                     LOGERR("Port: %s. enable:%d", param.port, param.isEnabled);
                     response["error_message"] = "Bus failure";
@@ -2287,7 +2298,7 @@ namespace WPEFramework {
             {
                 dsMgrStandbyVideoStateParam_t param;
                 strncpy(param.port, portname.c_str(), PWRMGR_MAX_VIDEO_PORT_NAME_LENGTH);
-                if(IARM_RESULT_SUCCESS != IARM_Bus_Call(IARM_BUS_DSMGR_NAME, IARM_BUS_DSMGR_API_GetStandbyVideoState, &param, sizeof(param)))
+                if(IARM_RESULT_SUCCESS != Utils::IARM::call(IARM_BUS_DSMGR_NAME, IARM_BUS_DSMGR_API_GetStandbyVideoState, &param, sizeof(param)))
                 {
                     LOGERR("Port: %s. enable:%d", param.port, param.isEnabled);
                     response["error_message"] = "Bus failure";
@@ -4713,7 +4724,7 @@ namespace WPEFramework {
             IARM_Result_t res;
             IARM_Bus_PWRMgr_GetPowerState_Param_t param;
 
-            res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState, (void *)&param, sizeof(param));
+            res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState, (void *)&param, sizeof(param));
             if (res == IARM_RESULT_SUCCESS)
             {
                 m_powerState = param.curState;
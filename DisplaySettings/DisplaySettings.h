@@ -24,6 +24,7 @@
 #include "Module.h"
 #include "dsTypes.h"
 #include "tptimer.h"
+#include "UtilsEdid.h"
 #include "libIARM.h"
 #include "irMgr.h"
 #include "pwrMgr.h"
@@ -237,6 +238,7 @@ namespace WPEFramework {
 	    void checkSADUpdate();
 	    void checkAudioDevicePowerStatusTimer();
 
+	    Utils::Edid::Cache m_edidCache; // connected display and host EDID, display dropped on hotplug
 	    TpTimer m_timer;
             TpTimer m_AudioDeviceDetectTimer;
 	    TpTimer m_SADDetectionTimer;
@@ -30,6 +30,7 @@
 #define METHOD_START_FPS_COLLECTION "startFpsCollection"
 #define METHOD_STOP_FPS_COLLECTION "stopFpsCollection"
 #define METHOD_UPDATE_FPS_COLLECTION "updateFps"
+#define METHOD_UPDATE_FRAME_TIMES "updateFrameTimes"
 #define METHOD_SET_FRAME_MODE "setFrmMode"
 #define METHOD_GET_FRAME_MODE "getFrmMode"
 #define METHOD_GET_DISPLAY_FRAME_RATE "getDisplayFrameRate"
@@ -37,6 +38,7 @@
 
 // Events
 #define EVENT_FPS_UPDATE "onFpsEvent"
+#define EVENT_FRAME_TIME_UPDATE "onFrameTimeEvent"
 #define EVENT_FRAMERATE_PRECHANGE  "onDisplayFrameRateChanging"
 #define EVENT_FRAMERATE_POSTCHANGE    "onDisplayFrameRateChanged"
 
@@ -51,7 +53,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 6
+#define API_VERSION_NUMBER_PATCH 7
 
 namespace WPEFramework
 {
@@ -88,6 +90,7 @@ namespace WPEFramework
             registerMethod(METHOD_START_FPS_COLLECTION, &FrameRate::startFpsCollectionWrapper, this);
             registerMethod(METHOD_STOP_FPS_COLLECTION, &FrameRate::stopFpsCollectionWrapper, this);
             registerMethod(METHOD_UPDATE_FPS_COLLECTION, &FrameRate::updateFpsWrapper, this);
+            registerMethod(METHOD_UPDATE_FRAME_TIMES, &FrameRate::updateFrameTimesWrapper, this);
             registerMethod(METHOD_SET_FRAME_MODE, &FrameRate::setFrmMode, this);
             registerMethod(METHOD_GET_FRAME_MODE, &FrameRate::getFrmMode, this);
             registerMethod(METHOD_GET_DISPLAY_FRAME_RATE, &FrameRate::getDisplayFrameRate, this);
@@ -205,6 +208,41 @@ namespace WPEFramework
 
             returnResponse(true);
         }
+
+        uint32_t FrameRate::updateFrameTimesWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            std::lock_guard<std::mutex> guard(m_callMutex);
+
+            if (!parameters.HasLabel("frameTimes"))
+            {
+                returnResponse(false);
+            }
+
+            if (!m_fpsCollectionInProgress)
+            {
+                returnResponse(true);
+            }
+
+            std::string callsign = parameters.HasLabel("callsign") ? parameters["callsign"].String() : std::string();
+            if (callsign != m_frameTimesCallsign)
+            {
+                // the window belongs to one app, report what the previous one rendered
+                frameTimeCollectionUpdate();
+                m_frameTimesCallsign = callsign;
+            }
+
+            const JsonArray frameTimes = parameters["frameTimes"].Array();
+            for (int i = 0; i < frameTimes.Length(); i++)
+            {
+                int64_t frameTime = frameTimes[i].Number();
+                if (frameTime > 0)
+                {
+                    m_frameTimes.add(static_cast<uint32_t>(frameTime > UINT32_MAX ? UINT32_MAX : frameTime));
+                }
+            }
+
+            returnResponse(true);
+        }
         
 	uint32_t FrameRate::setFrmMode(const JsonObject& parameters, JsonObject& response)
         {
@@ -348,6 +386,7 @@ namespace WPEFramework
             m_maxFpsValue = DEFAULT_MAX_FPS_VALUE;
             m_totalFpsValues = 0;
             m_numberOfFpsUpdates = 0;
+            m_frameTimes.reset();
             m_fpsCollectionInProgress = true;
             int fpsCollectionFrequency = m_fpsCollectionFrequencyInMs;
             if (fpsCollectionFrequency < MINIMUM_FPS_COLLECTION_TIME_IN_MILLISECONDS)
@@ -386,6 +425,7 @@ namespace WPEFramework
                 maxFps = m_maxFpsValue;
                 fpsCollectionUpdate(averageFps, minFps, maxFps);
                 }
+                frameTimeCollectionUpdate();
                 disableFpsCollection();
             }
             return true;
@@ -421,6 +461,51 @@ namespace WPEFramework
             
             sendNotify(EVENT_FPS_UPDATE, params);
         }
+
+        /**
+        * @brief This function reports the frame times of the window, if any were collected, and starts a new window.
+        */
+        void FrameRate::frameTimeCollectionUpdate()
+        {
+            if (m_frameTimes.frames() == 0)
+            {
+                return;
+            }
+
+            FrameTimeHistogram::Summary summary = m_frameTimes.summary();
+            JsonObject params;
+            if (!m_frameTimesCallsign.empty())
+            {
+                params["callsign"] = m_frameTimesCallsign;
+            }
+            params["frames"] = summary.frames;
+            params["p50"] = summary.p50;
+            params["p95"] = summary.p95;
+            params["p99"] = summary.p99;
+            params["max"] = summary.max;
+            params["longFrames"] = summary.longFrames;
+            params["jankBursts"] = summary.jankBursts;
+            params["vsync"] = m_frameTimes.vsyncInterval();
+
+            sendNotify(EVENT_FRAME_TIME_UPDATE, params);
+            m_frameTimes.reset();
+        }
+
+        /**
+        * @brief This function takes the vsync interval for long frame detection from a display frame rate
+        * such as "3840x2160px48" or "1920x1080px59.94". The interval is left as is when there is no rate.
+        */
+        void FrameRate::setVsyncInterval(const char *displayFrameRate)
+        {
+            std::string frameRate(displayFrameRate);
+            size_t start = frameRate.find_last_not_of("0123456789.");
+            start = (start == std::string::npos) ? 0 : start + 1;
+            double rate = atof(frameRate.c_str() + start);
+            if (rate > 0)
+            {
+                m_frameTimes.setVsyncInterval(static_cast<uint32_t>((1000000.0 / rate) + 0.5));
+            }
+        }
         
         void FrameRate::onReportFpsTimer()
         {
@@ -436,6 +521,7 @@ namespace WPEFramework
                 maxFps = m_maxFpsValue;
             }
             fpsCollectionUpdate(averageFps, minFps, maxFps);
+            frameTimeCollectionUpdate();
             if (m_lastFpsValue >= 0)
             {
                 // store the last fps value just in case there are no updates
@@ -500,6 +586,11 @@ namespace WPEFramework
 
         void FrameRate::frameRatePostChange(char *displayFrameRate)
         {
+            {
+                std::lock_guard<std::mutex> guard(m_callMutex);
+                setVsyncInterval(displayFrameRate);
+            }
+
             JsonObject params;
             params["displayFrameRate"] = std::string(displayFrameRate);
             sendNotify(EVENT_FRAMERATE_POSTCHANGE, params);
@@ -24,6 +24,7 @@
 #include "Module.h"
 
 #include "tptimer.h"
+#include "FrameTimeHistogram.h"
 
 #include "libIARM.h"
 
@@ -43,6 +44,7 @@ namespace WPEFramework {
             uint32_t startFpsCollectionWrapper(const JsonObject& parameters, JsonObject& response);
             uint32_t stopFpsCollectionWrapper(const JsonObject& parameters, JsonObject& response);
             uint32_t updateFpsWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t updateFrameTimesWrapper(const JsonObject& parameters, JsonObject& response);
             uint32_t setFrmMode(const JsonObject& parameters, JsonObject& response);
 	    uint32_t getFrmMode(const JsonObject& parameters, JsonObject& response);
 	    uint32_t getDisplayFrameRate(const JsonObject& parameters, JsonObject& response);
@@ -56,6 +58,8 @@ namespace WPEFramework {
             void updateFps(int newFpsValue);
 
             void fpsCollectionUpdate( int averageFps, int minFps, int maxFps );
+            void frameTimeCollectionUpdate();
+            void setVsyncInterval(const char *displayFrameRate);
             
             virtual void enableFpsCollection() {}
             virtual void disableFpsCollection() {}
@@ -98,6 +102,8 @@ namespace WPEFramework {
             //QTimer m_reportFpsTimer;
             TpTimer m_reportFpsTimer;
             int m_lastFpsValue;
+            FrameTimeHistogram m_frameTimes;
+            std::string m_frameTimesCallsign;
             
             std::mutex m_callMutex;
         };
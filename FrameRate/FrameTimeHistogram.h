@@ -0,0 +1,182 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+namespace WPEFramework {
+
+    namespace Plugin {
+
+        // Frame intervals of one collection window in a fixed number of log scaled buckets: every power of
+        // two is split in 8 linear sub buckets, so a percentile is off by at most 1/8 of its value however
+        // many frames the window has. Frames longer than twice the vsync interval are long frames, two or
+        // more of them in a row count as one jank burst.
+        class FrameTimeHistogram {
+        public:
+            static const uint32_t SUB_BUCKET_BITS = 3;
+            static const uint32_t SUB_BUCKETS = (1 << SUB_BUCKET_BITS);
+            static const uint32_t MAX_FRAME_TIME = ((1 << 26) - 1); // us, about 67 s
+            static const uint32_t BUCKETS = ((26 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS);
+            static const uint32_t DEFAULT_VSYNC_INTERVAL = 16667; // us, 60 Hz
+
+            struct Summary {
+                uint32_t frames;
+                uint32_t p50; // us
+                uint32_t p95; // us
+                uint32_t p99; // us
+                uint32_t max; // us
+                uint32_t longFrames;
+                uint32_t jankBursts;
+            };
+
+            FrameTimeHistogram()
+                : m_vsyncInterval(DEFAULT_VSYNC_INTERVAL)
+            {
+                reset();
+            }
+
+            void setVsyncInterval(uint32_t intervalUs)
+            {
+                m_vsyncInterval = DEFAULT_VSYNC_INTERVAL;
+                if (intervalUs > 0)
+                {
+                    m_vsyncInterval = intervalUs;
+                }
+            }
+
+            uint32_t vsyncInterval() const
+            {
+                return m_vsyncInterval;
+            }
+
+            void reset()
+            {
+                memset(m_counts, 0, sizeof(m_counts));
+                m_frames = 0;
+                m_max = 0;
+                m_longFrames = 0;
+                m_jankBursts = 0;
+                m_consecutiveLongFrames = 0;
+            }
+
+            void add(uint32_t frameTimeUs)
+            {
+                if (frameTimeUs > MAX_FRAME_TIME)
+                {
+                    frameTimeUs = MAX_FRAME_TIME;
+                }
+                m_counts[bucketOf(frameTimeUs)]++;
+                m_frames++;
+                if (frameTimeUs > m_max)
+                {
+                    m_max = frameTimeUs;
+                }
+                if (frameTimeUs > (2 * m_vsyncInterval))
+                {
+                    m_longFrames++;
+                    if (++m_consecutiveLongFrames == 2)
+                    {
+                        m_jankBursts++;
+                    }
+                }
+                else
+                {
+                    m_consecutiveLongFrames = 0;
+                }
+            }
+
+            uint32_t frames() const
+            {
+                return m_frames;
+            }
+
+            Summary summary() const
+            {
+                Summary result;
+                result.frames = m_frames;
+                result.p50 = percentile(50);
+                result.p95 = percentile(95);
+                result.p99 = percentile(99);
+                result.max = m_max;
+                result.longFrames = m_longFrames;
+                result.jankBursts = m_jankBursts;
+                return result;
+            }
+
+            // The upper bound of the bucket holding the frame at the given percentile, 0 without frames.
+            uint32_t percentile(uint32_t percent) const
+            {
+                if (m_frames == 0)
+                {
+                    return 0;
+                }
+                uint64_t rank = ((static_cast<uint64_t>(m_frames) * percent) + 99) / 100;
+                if (rank == 0)
+                {
+                    rank = 1;
+                }
+                uint64_t seen = 0;
+                for (uint32_t bucket = 0; bucket < BUCKETS; bucket++)
+                {
+                    seen += m_counts[bucket];
+                    if (seen >= rank)
+                    {
+                        uint32_t upper = upperBound(bucket);
+                        return (upper < m_max ? upper : m_max);
+                    }
+                }
+                return m_max;
+            }
+
+            static uint32_t bucketOf(uint32_t frameTimeUs)
+            {
+                if (frameTimeUs < SUB_BUCKETS)
+                {
+                    return frameTimeUs;
+                }
+                uint32_t msb = 31 - __builtin_clz(frameTimeUs);
+                uint32_t shift = msb - SUB_BUCKET_BITS;
+                return ((shift + 1) * SUB_BUCKETS) + ((frameTimeUs >> shift) & (SUB_BUCKETS - 1));
+            }
+
+            static uint32_t upperBound(uint32_t bucket)
+            {
+                if (bucket < SUB_BUCKETS)
+                {
+                    return bucket;
+                }
+                uint32_t shift = (bucket / SUB_BUCKETS) - 1;
+                uint32_t lower = (SUB_BUCKETS + (bucket % SUB_BUCKETS)) << shift;
+                return lower + (1 << shift) - 1;
+            }
+
+        private:
+            uint32_t m_counts[BUCKETS];
+            uint32_t m_frames;
+            uint32_t m_max;
+            uint32_t m_longFrames;
+            uint32_t m_jankBursts;
+            uint32_t m_consecutiveLongFrames;
+            uint32_t m_vsyncInterval;
+        };
+    } // namespace Plugin
+} // namespace WPEFramework
@@ -45,7 +45,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 9
+#define API_VERSION_NUMBER_PATCH 10
 
 namespace WPEFramework
 {
@@ -127,12 +127,14 @@ namespace WPEFramework
         {
             Utils::Synchro::RegisterLockedApi(_T(HDCP_PROFILE_METHOD_GET_HDCP_STATUS), &HdcpProfile::getHDCPStatusWrapper, this);
             Utils::Synchro::RegisterLockedApi(_T(HDCP_PROFILE_METHOD_GET_SETTOP_HDCP_SUPPORT), &HdcpProfile::getSettopHDCPSupportWrapper, this);
+            Utils::Synchro::RegisterLockStatisticsApi(this);
         }
 
         void HdcpProfile::UnregisterAll()
         {
             Unregister(_T(HDCP_PROFILE_METHOD_GET_HDCP_STATUS));
             Unregister(_T(HDCP_PROFILE_METHOD_GET_SETTOP_HDCP_SUPPORT));
+            Utils::Synchro::UnregisterLockStatisticsApi(this);
         }
         uint32_t HdcpProfile::getHDCPStatusWrapper(const JsonObject& parameters, JsonObject& response)
         {
@@ -304,7 +306,7 @@ namespace WPEFramework
             else if (IARM_BUS_DSMGR_EVENT_HDCP_STATUS == eventId)
             {
                 IARM_Bus_PWRMgr_GetPowerState_Param_t param;
-                check_ret = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState, (void *)&param, sizeof(param));
+                check_ret = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState, (void *)&param, sizeof(param));
                 if(check_ret != IARM_RESULT_SUCCESS)
                     LOGWARN("Failed to Invoke RPC method: GetPowerState");
                 IARM_Bus_DSMgr_EventData_t *eventData = (IARM_Bus_DSMgr_EventData_t *)data;
@@ -59,7 +59,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 13
+#define API_VERSION_NUMBER_PATCH 14
 
 enum {
 	HDMICEC_EVENT_DEVICE_ADDED=0,
@@ -189,6 +189,7 @@ namespace WPEFramework
             Utils::Synchro::RegisterLockedApi(HDMICEC_METHOD_SEND_MESSAGE, &HdmiCec::sendMessageWrapper, this);
             Utils::Synchro::RegisterLockedApi(HDMICEC_METHOD_GET_ACTIVE_SOURCE_STATUS, &HdmiCec::getActiveSourceStatus, this);
             Utils::Synchro::RegisterLockedApi("getDeviceList", &HdmiCec::getDeviceList, this);
+            Utils::Synchro::RegisterLockStatisticsApi(this);
 
             physicalAddress = 0x0F0F0F0F;
 
@@ -461,7 +462,7 @@ namespace WPEFramework
 
             char c;
             IARM_Result_t retVal = IARM_RESULT_SUCCESS;
-            retVal = IARM_Bus_Call_with_IPCTimeout(IARM_BUS_CECMGR_NAME, IARM_BUS_CECMGR_API_isAvailable, (void *)&c, sizeof(c), 1000);
+            retVal = Utils::IARM::callWithIPCTimeout(IARM_BUS_CECMGR_NAME, IARM_BUS_CECMGR_API_isAvailable, (void *)&c, sizeof(c), 1000);
             if(retVal != IARM_RESULT_SUCCESS) {
                 LOGINFO("CECMGR is not available. Failed to enable HdmiCec Plugin");
                 cecEnableStatus = false;
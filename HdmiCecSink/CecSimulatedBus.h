@@ -0,0 +1,117 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "CecTxScheduler.h"
+
+#include <map>
+#include <set>
+
+namespace WPEFramework {
+
+    namespace Plugin {
+
+        /* In-process CEC line for tests and benchmarks. Every frame occupies the
+         * bus for frameTime, like a real single-wire CEC segment would, and only the
+         * addresses added with attach() acknowledge polls. */
+        class CecSimulatedBus : public CecTxBus
+        {
+        public:
+            struct Frame {
+                int from;
+                int to;
+                std::string tag;
+                std::chrono::steady_clock::time_point sentAt;
+            };
+
+            explicit CecSimulatedBus(std::chrono::milliseconds frameTime = std::chrono::milliseconds(30))
+                : m_frameTime(frameTime)
+            {
+            }
+
+            void attach(int address)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_devices.insert(address);
+            }
+
+            void detach(int address)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_devices.erase(address);
+            }
+
+            PingResult ping(int from, int to) override
+            {
+                occupy();
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pings[to]++;
+                record(from, to, "ping");
+                return (m_devices.count(to) != 0) ? PING_ACK : PING_NACK;
+            }
+
+            void transmit(int from, int to, const std::string& tag)
+            {
+                occupy();
+                std::lock_guard<std::mutex> lock(m_mutex);
+                record(from, to, tag);
+            }
+
+            uint32_t pingCount(int address) const
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::map<int, uint32_t>::const_iterator it = m_pings.find(address);
+                return (it != m_pings.end()) ? it->second : 0;
+            }
+
+            std::vector<Frame> frames() const
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_frames;
+            }
+
+        private:
+            void occupy()
+            {
+                /* one frame on the wire at a time */
+                std::lock_guard<std::mutex> lock(m_lineMutex);
+                std::this_thread::sleep_for(m_frameTime);
+            }
+
+            void record(int from, int to, const std::string& tag)
+            {
+                Frame frame;
+                frame.from = from;
+                frame.to = to;
+                frame.tag = tag;
+                frame.sentAt = std::chrono::steady_clock::now();
+                m_frames.push_back(frame);
+            }
+
+            const std::chrono::milliseconds m_frameTime;
+            mutable std::mutex m_mutex;
+            std::mutex m_lineMutex;
+            std::set<int> m_devices;
+            std::map<int, uint32_t> m_pings;
+            std::vector<Frame> m_frames;
+        };
+
+    } // namespace Plugin
+} // namespace WPEFramework
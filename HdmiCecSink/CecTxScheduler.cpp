@@ -0,0 +1,322 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "CecTxScheduler.h"
+
+#include <string.h>
+#include <exception>
+
+#include "UtilsLogging.h"
+
+#define CEC_TX_MAX_BACKOFF_SHIFT 16
+
+namespace WPEFramework {
+
+    namespace Plugin {
+
+        CecTxScheduler::CecTxScheduler(CecTxBus& bus, uint32_t discoveryGapMs, uint32_t maxBackoffSweeps)
+            : m_bus(bus)
+            , m_discoveryGap(discoveryGapMs)
+            , m_maxBackoffSweeps(maxBackoffSweeps > 0 ? maxBackoffSweeps : 1)
+            , m_lastDiscovery()
+            , m_sweepPending(0)
+            , m_sweepGeneration(0)
+            , m_running(false)
+        {
+            memset(m_addresses, 0, sizeof(m_addresses));
+            memset(&m_stats, 0, sizeof(m_stats));
+        }
+
+        CecTxScheduler::~CecTxScheduler()
+        {
+            stop();
+        }
+
+        void CecTxScheduler::start()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_running)
+                return;
+
+            m_running = true;
+            m_thread = std::thread(&CecTxScheduler::worker, this);
+        }
+
+        void CecTxScheduler::stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_running && !m_thread.joinable())
+                    return;
+
+                m_running = false;
+                for (int i = 0; i < PRIORITY_COUNT; i++)
+                    m_queues[i].clear();
+                m_sweepPending = 0;
+                m_jobCV.notify_all();
+                m_sweepCV.notify_all();
+            }
+
+            try
+            {
+                if (m_thread.joinable())
+                    m_thread.join();
+            }
+            catch(const std::system_error& e)
+            {
+                LOGERR("system_error exception in thread join %s", e.what());
+            }
+        }
+
+        bool CecTxScheduler::isRunning() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_running;
+        }
+
+        bool CecTxScheduler::submit(Priority priority, const std::string& key, const Action& action)
+        {
+            if (priority >= PRIORITY_COUNT || !action)
+                return false;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running)
+                return false;
+
+            return enqueue(priority, key, action);
+        }
+
+        void CecTxScheduler::transmit(Priority priority, const std::string& key, const Action& action)
+        {
+            if (priority >= PRIORITY_COUNT || !action)
+                return;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_running)
+            {
+                enqueue(priority, key, action);
+            }
+            else
+            {
+                m_stats.executed[priority]++;
+                if (!run(key, action))
+                    m_stats.failed++;
+            }
+        }
+
+        bool CecTxScheduler::enqueue(Priority priority, const std::string& key, const Action& action)
+        {
+            m_stats.submitted++;
+            if (!key.empty())
+            {
+                for (std::deque<Job>::iterator it = m_queues[priority].begin(); it != m_queues[priority].end(); ++it)
+                {
+                    if (it->key == key)
+                    {
+                        /* keep the queue position, but send the latest request */
+                        it->action = action;
+                        m_stats.coalesced++;
+                        return false;
+                    }
+                }
+            }
+
+            Job job;
+            job.key = key;
+            job.action = action;
+            m_queues[priority].push_back(job);
+            m_jobCV.notify_one();
+            return true;
+        }
+
+        void CecTxScheduler::discover(int from, const std::vector<bool>& present, std::vector<int>& connected, std::vector<int>& disconnected)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!m_running)
+                return;
+
+            const uint32_t generation = ++m_sweepGeneration;
+            std::vector<CecTxBus::PingResult> results(MAX_ADDRESSES, CecTxBus::PING_ERROR);
+            std::vector<bool> polled(MAX_ADDRESSES, false);
+
+            for (int address = 0; address < MAX_ADDRESSES; address++)
+            {
+                if (address == from)
+                    continue;
+
+                const bool isPresent = (address < (int)present.size()) && present[address];
+                if (!isPresent && m_addresses[address].skipSweeps > 0)
+                {
+                    m_addresses[address].skipSweeps--;
+                    m_stats.pingsSkipped++;
+                    continue;
+                }
+
+                polled[address] = true;
+                m_sweepPending++;
+
+                Job job;
+                job.action = [this, from, address, generation, &results]() {
+                    CecTxBus::PingResult result = m_bus.ping(from, address);
+
+                    std::lock_guard<std::mutex> jobLock(m_mutex);
+                    m_stats.pingsSent++;
+                    if (generation != m_sweepGeneration || m_sweepPending == 0)
+                        return;
+                    results[address] = result;
+                    if (--m_sweepPending == 0)
+                        m_sweepCV.notify_all();
+                };
+                m_queues[PRIORITY_DISCOVERY].push_back(job);
+            }
+            m_jobCV.notify_one();
+
+            m_sweepCV.wait(lock, [this]() { return (m_sweepPending == 0) || !m_running; });
+            if (!m_running)
+                return;
+
+            for (int address = 0; address < MAX_ADDRESSES; address++)
+            {
+                if (!polled[address])
+                    continue;
+
+                const bool isPresent = (address < (int)present.size()) && present[address];
+                AddressState& state = m_addresses[address];
+
+                if (results[address] == CecTxBus::PING_ACK)
+                {
+                    state.misses = 0;
+                    state.skipSweeps = 0;
+                    if (!isPresent)
+                        connected.push_back(address);
+                }
+                else if (results[address] == CecTxBus::PING_NACK)
+                {
+                    if (isPresent)
+                        disconnected.push_back(address);
+                    if (state.misses < CEC_TX_MAX_BACKOFF_SHIFT)
+                        state.misses++;
+                    uint32_t backoff = 1u << (state.misses - 1);
+                    if (backoff > m_maxBackoffSweeps)
+                        backoff = m_maxBackoffSweeps;
+                    state.skipSweeps = backoff - 1;
+                }
+            }
+        }
+
+        void CecTxScheduler::resetBackoff(int address)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (int i = 0; i < MAX_ADDRESSES; i++)
+            {
+                if (address < 0 || address == i)
+                {
+                    m_addresses[i].misses = 0;
+                    m_addresses[i].skipSweeps = 0;
+                }
+            }
+        }
+
+        CecTxScheduler::Stats CecTxScheduler::stats() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_stats;
+        }
+
+        bool CecTxScheduler::popJob(Job& job, Priority& priority, std::unique_lock<std::mutex>& lock)
+        {
+            while (m_running)
+            {
+                int next = PRIORITY_COUNT;
+                for (int i = 0; i < PRIORITY_COUNT; i++)
+                {
+                    if (!m_queues[i].empty())
+                    {
+                        next = i;
+                        break;
+                    }
+                }
+
+                if (next == PRIORITY_COUNT)
+                {
+                    m_jobCV.wait(lock);
+                    continue;
+                }
+
+                if (next == PRIORITY_DISCOVERY)
+                {
+                    /* Pace background polls, but let any foreground job that shows up
+                     * during the gap go out immediately. */
+                    std::chrono::steady_clock::time_point due = m_lastDiscovery + m_discoveryGap;
+                    if (std::chrono::steady_clock::now() < due)
+                    {
+                        m_jobCV.wait_until(lock, due);
+                        continue;
+                    }
+                }
+
+                job = m_queues[next].front();
+                m_queues[next].pop_front();
+                priority = static_cast<Priority>(next);
+                return true;
+            }
+            return false;
+        }
+
+        bool CecTxScheduler::run(const std::string& key, const Action& action)
+        {
+            try
+            {
+                action();
+                return true;
+            }
+            catch(const std::exception& e)
+            {
+                LOGWARN("CEC transmit (%s) failed: %s", key.c_str(), e.what());
+            }
+            catch(...)
+            {
+                LOGWARN("CEC transmit (%s) failed", key.c_str());
+            }
+            return false;
+        }
+
+        void CecTxScheduler::worker()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            Job job;
+            Priority priority = PRIORITY_USER;
+
+            while (popJob(job, priority, lock))
+            {
+                m_stats.executed[priority]++;
+                lock.unlock();
+
+                const bool sent = run(job.key, job.action);
+
+                lock.lock();
+                if (!sent)
+                    m_stats.failed++;
+                if (priority == PRIORITY_DISCOVERY)
+                    m_lastDiscovery = std::chrono::steady_clock::now();
+            }
+        }
+
+    } // namespace Plugin
+} // namespace WPEFramework
@@ -0,0 +1,143 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace WPEFramework {
+
+    namespace Plugin {
+
+        /* Transport used by the scheduler for discovery polls. The plugin wraps the
+         * ccec Connection; tests and benchmarks use CecSimulatedBus instead. */
+        class CecTxBus
+        {
+        public:
+            enum PingResult {
+                PING_ACK,
+                PING_NACK,
+                PING_ERROR
+            };
+
+            virtual ~CecTxBus() {}
+            virtual PingResult ping(int from, int to) = 0;
+        };
+
+        /* Single writer for the CEC line. Every outgoing frame is queued here and sent
+         * from one thread in priority order, so a user command never waits for more
+         * than the frame currently on the wire, even in the middle of a discovery sweep. */
+        class CecTxScheduler
+        {
+        public:
+            enum Priority {
+                PRIORITY_USER = 0,      /* routing, power and key commands issued through the API */
+                PRIORITY_PROTOCOL,      /* responses and follow-up requests driven by received messages */
+                PRIORITY_DISCOVERY,     /* background polls and device info requests */
+                PRIORITY_COUNT
+            };
+
+            typedef std::function<void()> Action;
+
+            struct Stats {
+                uint32_t submitted;
+                uint32_t coalesced;
+                uint32_t executed[PRIORITY_COUNT];
+                uint32_t failed;
+                uint32_t pingsSent;
+                uint32_t pingsSkipped;
+            };
+
+            static const int MAX_ADDRESSES = 15;
+
+            CecTxScheduler(CecTxBus& bus, uint32_t discoveryGapMs = 50, uint32_t maxBackoffSweeps = 4);
+            ~CecTxScheduler();
+
+            void start();
+            void stop();
+            bool isRunning() const;
+
+            /* Queues an action. When key is not empty and a job with the same key is
+             * still pending, the pending job takes the new action instead of a second
+             * job being queued. Returns false when the job was coalesced or dropped. */
+            bool submit(Priority priority, const std::string& key, const Action& action);
+
+            /* As submit() while running. While stopped the action runs on the calling
+             * thread instead, still under the scheduler lock, so it can never overlap
+             * the worker of a concurrent start(). Actions that throw are logged and
+             * counted as failed. */
+            void transmit(Priority priority, const std::string& key, const Action& action);
+
+            /* Polls every logical address except 'from' at discovery priority and blocks
+             * until the sweep completes. Addresses that keep NACKing are skipped for an
+             * exponentially growing number of sweeps, capped at maxBackoffSweeps. */
+            void discover(int from, const std::vector<bool>& present, std::vector<int>& connected, std::vector<int>& disconnected);
+
+            /* Clears back-off for one address (or all with -1), e.g. on hotplug or when
+             * a frame is received from that address. */
+            void resetBackoff(int address = -1);
+
+            Stats stats() const;
+
+        private:
+            CecTxScheduler(const CecTxScheduler&) = delete;
+            CecTxScheduler& operator=(const CecTxScheduler&) = delete;
+
+            struct Job {
+                std::string key;
+                Action action;
+            };
+
+            struct AddressState {
+                uint32_t misses;
+                uint32_t skipSweeps;
+            };
+
+            bool enqueue(Priority priority, const std::string& key, const Action& action);
+            bool run(const std::string& key, const Action& action);
+            bool popJob(Job& job, Priority& priority, std::unique_lock<std::mutex>& lock);
+            void worker();
+
+            CecTxBus& m_bus;
+            const std::chrono::milliseconds m_discoveryGap;
+            const uint32_t m_maxBackoffSweeps;
+
+            mutable std::mutex m_mutex;
+            std::condition_variable m_jobCV;
+            std::condition_variable m_sweepCV;
+            std::deque<Job> m_queues[PRIORITY_COUNT];
+            AddressState m_addresses[MAX_ADDRESSES];
+            std::chrono::steady_clock::time_point m_lastDiscovery;
+            uint32_t m_sweepPending;
+            uint32_t m_sweepGeneration;
+            bool m_running;
+            std::thread m_thread;
+            Stats m_stats;
+        };
+
+    } // namespace Plugin
+} // namespace WPEFramework
@@ -75,6 +75,8 @@
 #define HDMICECSINK_PING_INTERVAL_MS 				10000
 #define HDMICECSINK_WAIT_FOR_HDMI_IN_MS 			1000
 #define HDMICECSINK_REQUEST_INTERVAL_TIME_MS 		500
+#define HDMICECSINK_PING_GAP_MS 					50
+#define HDMICECSINK_PING_MAX_BACKOFF_SWEEPS 		4
 #define HDMICECSINK_NUMBER_TV_ADDR 					2
 #define HDMICECSINK_UPDATE_POWER_STATUS_INTERVA_MS    (60 * 1000)
 #define HDMISINK_ARC_START_STOP_MAX_WAIT_MS           4000
@@ -177,7 +179,7 @@ static std::vector<DeviceFeatures> deviceFeatures = {DEVICE_FEATURES_TV};
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 3
-#define API_VERSION_NUMBER_PATCH 9
+#define API_VERSION_NUMBER_PATCH 10
 
 namespace WPEFramework
 {
@@ -202,6 +204,38 @@ namespace WPEFramework
         HdmiCecSink* HdmiCecSink::_instance = nullptr;
         static int libcecInitStatus = 0;
 
+//=========================================== HdmiCecSinkTxBus =========================================
+        CecTxBus::PingResult HdmiCecSinkTxBus::ping(int from, int to)
+        {
+            if(!m_connection)
+                return PING_ERROR;
+
+            try {
+                m_connection->ping(LogicalAddress(from), LogicalAddress(to), Throw_e());
+            }
+            catch(CECNoAckException &e)
+            {
+                return PING_NACK;
+            }
+            catch(Exception &e)
+            {
+                LOGWARN("Ping device: 0x%x caught %s \r\n", to, e.what());
+                return PING_ERROR;
+            }
+            return PING_ACK;
+        }
+
+        void HdmiCecSinkTxBus::sendTo(const LogicalAddress &to, const CECFrame &frame, int timeout)
+        {
+            if(!m_connection)
+                return;
+
+            if (timeout > 0)
+                m_connection->sendTo(to, frame, timeout);
+            else
+                m_connection->sendTo(to, frame);
+        }
+
 //=========================================== HdmiCecSinkFrameListener =========================================
         void HdmiCecSinkFrameListener::notify(const CECFrame &in) const {
                 const uint8_t *buf = NULL;
@@ -291,10 +325,10 @@ namespace WPEFramework
              try
              { 
                  if(cecVersion == 2.0) {
-		     conn.sendToAsync(header.from, MessageEncoder().encode(CECVersion(Version::V_2_0)));
+		     HdmiCecSink::_instance->sendResponse(header.from, MessageEncoder().encode(CECVersion(Version::V_2_0)), 0);
 		 }
 		 else{
-		     conn.sendToAsync(header.from, MessageEncoder().encode(CECVersion(Version::V_1_4)));
+		     HdmiCecSink::_instance->sendResponse(header.from, MessageEncoder().encode(CECVersion(Version::V_1_4)), 0);
 		 }
 	     }
              catch(...)
@@ -330,7 +364,7 @@ namespace WPEFramework
 	     }
              try
              { 
-                 conn.sendToAsync(header.from, MessageEncoder().encode(SetOSDName(osdName)));
+                 HdmiCecSink::_instance->sendResponse(header.from, MessageEncoder().encode(SetOSDName(osdName)), 0);
              } 
              catch(...)
              {
@@ -345,7 +379,7 @@ namespace WPEFramework
                  try
                  { 
                      LOGINFO(" sending ReportPhysicalAddress response physical_addr :%s logicalAddress :%x \n",physical_addr.toString().c_str(), logicalAddress.toInt());
-                     conn.sendTo(LogicalAddress(LogicalAddress::BROADCAST), MessageEncoder().encode(ReportPhysicalAddress(physical_addr,logicalAddress.toInt())), 500);
+                     HdmiCecSink::_instance->sendResponse(LogicalAddress(LogicalAddress::BROADCAST), MessageEncoder().encode(ReportPhysicalAddress(physical_addr,logicalAddress.toInt())), 500);
                  } 
                  catch(...)
                  {
@@ -363,7 +397,7 @@ namespace WPEFramework
              try
              {
                  LOGINFO("Command: GiveDeviceVendorID sending VendorID response :%s\n",appVendorId.toString().c_str());
-                 conn.sendToAsync(LogicalAddress(LogicalAddress::BROADCAST), MessageEncoder().encode(DeviceVendorID(appVendorId)));
+                 HdmiCecSink::_instance->sendResponse(LogicalAddress(LogicalAddress::BROADCAST), MessageEncoder().encode(DeviceVendorID(appVendorId)), 0);
              }
              catch(...)
              {
@@ -480,7 +514,7 @@ namespace WPEFramework
 	     }
              try
              { 
-                 conn.sendTo(header.from, MessageEncoder().encode(ReportPowerStatus(PowerStatus(powerState))));
+                 HdmiCecSink::_instance->sendResponse(header.from, MessageEncoder().encode(ReportPowerStatus(PowerStatus(powerState))), 0);
              } 
              catch(...)
              {
@@ -658,7 +692,7 @@ namespace WPEFramework
             try
             {
 	        if(cecVersion == 2.0) {
-		    conn.sendToAsync(LogicalAddress(LogicalAddress::BROADCAST),MessageEncoder().encode(ReportFeatures(Version::V_2_0,allDevicetype,rcProfile,deviceFeatures)));
+		    HdmiCecSink::_instance->sendResponse(LogicalAddress(LogicalAddress::BROADCAST),MessageEncoder().encode(ReportFeatures(Version::V_2_0,allDevicetype,rcProfile,deviceFeatures)), 0);
 		}
             }
             catch(...)
@@ -683,6 +717,7 @@ namespace WPEFramework
 
        HdmiCecSink::HdmiCecSink()
        : PluginHost::JSONRPC()
+       , m_txScheduler(m_txBus, HDMICECSINK_PING_GAP_MS, HDMICECSINK_PING_MAX_BACKOFF_SWEEPS)
        {
            LOGWARN("Initlaizing HdmiCecSink");
            HdmiCecSink::_instance = this;
@@ -752,7 +787,7 @@ namespace WPEFramework
            m_arcStartStopTimer.setSingleShot(true);
             // get power state:
             IARM_Bus_PWRMgr_GetPowerState_Param_t param;
-            err = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+            err = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                             IARM_BUS_PWRMGR_API_GetPowerState,
                             (void *)&param,
                             sizeof(param));
@@ -762,7 +797,7 @@ namespace WPEFramework
                 LOGINFO("Current state is IARM: (%d) powerState :%d \n",param.curState,powerState);
             }
 
-			err = IARM_Bus_Call(IARM_BUS_DSMGR_NAME,
+			err = Utils::IARM::call(IARM_BUS_DSMGR_NAME,
                             IARM_BUS_DSMGR_API_dsHdmiInGetNumberOfInputs,
                             (void *)&hdmiInput,
                             sizeof(hdmiInput));
@@ -789,7 +824,7 @@ namespace WPEFramework
 			CheckHdmiInState();
 
             int cecMgrIsAvailableParam;
-            err = IARM_Bus_Call(IARM_BUS_CECMGR_NAME,
+            err = Utils::IARM::call(IARM_BUS_CECMGR_NAME,
                             IARM_BUS_CECMGR_API_isAvailable,
                             (void *)&cecMgrIsAvailableParam,
                             sizeof(cecMgrIsAvailableParam));
@@ -998,7 +1033,7 @@ namespace WPEFramework
 				return;
 			}
 
-			_instance->smConnection->sendTo(LogicalAddress(LogicalAddress::BROADCAST), MessageEncoder().encode(Standby()), 1000);
+			_instance->sendUserFrame("standby", LogicalAddress(LogicalAddress::BROADCAST), MessageEncoder().encode(Standby()), 1000);
        } 
 
 	   void HdmiCecSink::wakeupFromStandby()
@@ -1010,7 +1045,7 @@ namespace WPEFramework
 
 				LOGINFO("Wakeup Device From standby ");
 				param.newState =  IARM_BUS_PWRMGR_POWERSTATE_ON;
-				ret = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_SetPowerState, (void *)&param, sizeof(param));
+				ret = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_SetPowerState, (void *)&param, sizeof(param));
 
 				if ( ret != IARM_RESULT_SUCCESS )
 				{
@@ -1061,6 +1096,7 @@ namespace WPEFramework
 
           if(cecEnableStatus) {
               LOGINFO("cecEnableStatus : %d Trigger CEC Ping !!! \n", cecEnableStatus);
+              m_txScheduler.resetBackoff();
               m_pollNextState = POLL_THREAD_STATE_PING;
               m_ThreadExitCV.notify_one();
           }
@@ -1161,7 +1197,7 @@ namespace WPEFramework
 		return;
 
 	    LOGINFO("Send Report Current Latency message \n");
-	    _instance->smConnection->sendTo(LogicalAddress::BROADCAST,MessageEncoder().encode(ReportCurrentLatency(physical_addr,m_video_latency,m_latency_flags,m_audio_output_delay)));
+	    _instance->sendFrame(CecTxScheduler::PRIORITY_PROTOCOL, "reportCurrentLatency", LogicalAddress::BROADCAST,MessageEncoder().encode(ReportCurrentLatency(physical_addr,m_video_latency,m_latency_flags,m_audio_output_delay)), 0);
 
         }
 
@@ -1221,64 +1257,64 @@ namespace WPEFramework
                     switch(keyCode)
                    {
                        case VOLUME_UP:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_VOLUME_UP)),100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_VOLUME_UP)),100);
 			   break;
 		       case VOLUME_DOWN:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_VOLUME_DOWN)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_VOLUME_DOWN)), 100);
                           break;
 		       case MUTE:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_MUTE)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_MUTE)), 100);
 			   break;
 		       case UP:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_UP)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_UP)), 100);
 			   break;
 		       case DOWN:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_DOWN)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_DOWN)), 100);
 			   break;
 		       case LEFT:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_LEFT)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_LEFT)), 100);
 			   break;
 		       case RIGHT:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_RIGHT)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_RIGHT)), 100);
 			   break;
 		       case SELECT:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_SELECT)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_SELECT)), 100);
 			   break;
 		       case HOME:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_HOME)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_HOME)), 100);
 			   break;
 		       case BACK:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_BACK)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_BACK)), 100);
 			   break;
 		       case NUMBER_0:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_0)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_0)), 100);
 			   break;
 		       case NUMBER_1:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_1)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_1)), 100);
 			   break;
 		       case NUMBER_2:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_2)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_2)), 100);
 			   break;
 		       case NUMBER_3:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_3)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_3)), 100);
 			   break;
 		       case NUMBER_4:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_4)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_4)), 100);
 			   break;
 		       case NUMBER_5:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_5)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_5)), 100);
 			   break;
 		       case NUMBER_6:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_6)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_6)), 100);
 			   break;
 		       case NUMBER_7:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_7)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_7)), 100);
 			   break;
 		       case NUMBER_8:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_8)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_8)), 100);
 			   break;
 		       case NUMBER_9:
-			   _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_9)), 100);
+			   _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_9)), 100);
 			   break;
 
                    }
@@ -1292,64 +1328,64 @@ namespace WPEFramework
                     switch(keyCode)
                    {
                        case VOLUME_UP:
-                          _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_VOLUME_UP)),100);
+                          _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_VOLUME_UP)),100);
                           break;
                       case VOLUME_DOWN:
-                          _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_VOLUME_DOWN)), 100);
+                          _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_VOLUME_DOWN)), 100);
                           break;
                       case MUTE:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_MUTE)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_MUTE)), 100);
                            break;
                        case UP:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_UP)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_UP)), 100);
                            break;
                        case DOWN:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_DOWN)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_DOWN)), 100);
                            break;
                        case LEFT:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_LEFT)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_LEFT)), 100);
                            break;
                        case RIGHT:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_RIGHT)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_RIGHT)), 100);
                            break;
                        case SELECT:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_SELECT)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_SELECT)), 100);
                            break;
                        case HOME:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_HOME)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_HOME)), 100);
                            break;
                        case BACK:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_BACK)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_BACK)), 100);
                            break;
                        case NUMBER_0:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_0)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_0)), 100);
                            break;
                        case NUMBER_1:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_1)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_1)), 100);
                            break;
                        case NUMBER_2:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_2)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_2)), 100);
                            break;
                        case NUMBER_3:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_3)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_3)), 100);
                            break;
                        case NUMBER_4:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_4)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_4)), 100);
                            break;
                        case NUMBER_5:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_5)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_5)), 100);
                            break;
                        case NUMBER_6:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_6)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_6)), 100);
                            break;
                        case NUMBER_7:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_7)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_7)), 100);
                            break;
                        case NUMBER_8:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_8)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_8)), 100);
                            break;
                        case NUMBER_9:
-                           _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_9)), 100);
+                           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_NUM_9)), 100);
                            break;
 
                   }
@@ -1359,7 +1395,7 @@ namespace WPEFramework
 		 {
                     if(!(_instance->smConnection))
                         return;
-		 _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlReleased()), 100);
+		 _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlReleased()), 100);
 
 		 }
 
@@ -1368,7 +1404,7 @@ namespace WPEFramework
                     if(!(_instance->smConnection))
                         return;
                    LOGINFO(" User Control Released \n");
-                 _instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlReleased()), 100);
+                 _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "", LogicalAddress(logicalAddress), MessageEncoder().encode(UserControlReleased()), 100);
                  }
 
          void  HdmiCecSink::sendDeviceUpdateInfo(const int logicalAddress)
@@ -1390,7 +1426,7 @@ namespace WPEFramework
             if(!(_instance->smConnection))
                 return;
              LOGINFO(" Send systemAudioModeRequest ");
-           _instance->smConnection->sendTo(LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(SystemAudioModeRequest(physical_addr)), 1000);
+           _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "systemAudioModeRequest", LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(SystemAudioModeRequest(physical_addr)), 1000);
 
         }
          void HdmiCecSink::sendGiveAudioStatusMsg()
@@ -1400,7 +1436,7 @@ namespace WPEFramework
             if(!(_instance->smConnection))
                 return;
              LOGINFO(" Send GiveAudioStatus ");
-	      _instance->smConnection->sendTo(LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(GiveAudioStatus()), 100);
+	      _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "giveAudioStatus", LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(GiveAudioStatus()), 100);
 
         }
         void  HdmiCecSink::reportAudioDevicePowerStatusInfo(const int logicalAddress, const int powerStatus)
@@ -2095,7 +2131,7 @@ namespace WPEFramework
 			bool isAnyPortConnected = false;
 			
 			dsHdmiInGetStatusParam_t params;
-            err = IARM_Bus_Call(IARM_BUS_DSMGR_NAME,
+            err = Utils::IARM::call(IARM_BUS_DSMGR_NAME,
                             IARM_BUS_DSMGR_API_dsHdmiInGetStatus,
                             (void *)&params,
                             sizeof(params));
@@ -2134,7 +2170,7 @@ namespace WPEFramework
 				return;
 			}
 
-			_instance->smConnection->sendTo(LogicalAddress::BROADCAST, 
+			_instance->sendUserFrame("requestActiveSource", LogicalAddress(LogicalAddress::BROADCAST),
 										MessageEncoder().encode(RequestActiveSource()), 500);
 		}
 		
@@ -2156,7 +2192,7 @@ namespace WPEFramework
 				return;
 			}
 		
-			_instance->smConnection->sendTo(LogicalAddress::BROADCAST, 
+			_instance->sendUserFrame("activeSource", LogicalAddress(LogicalAddress::BROADCAST),
 										MessageEncoder().encode(ActiveSource(_instance->deviceList[_instance->m_logicalAddressAllocated].m_physicalAddr)), 500);
 			_instance->m_currentActiveSource = _instance->m_logicalAddressAllocated;
 		}
@@ -2189,7 +2225,7 @@ namespace WPEFramework
 
 			lang = _instance->deviceList[_instance->m_logicalAddressAllocated].m_currentLanguage;
 
-			_instance->smConnection->sendTo(LogicalAddress::BROADCAST, MessageEncoder().encode(SetMenuLanguage(lang)), 100);
+			_instance->sendFrame(CecTxScheduler::PRIORITY_USER, "setMenuLanguage", LogicalAddress::BROADCAST, MessageEncoder().encode(SetMenuLanguage(lang)), 100);
 		}
 
 		void HdmiCecSink::updateInActiveSource(const int logical_address, const InActiveSource &source )
@@ -2272,7 +2308,7 @@ namespace WPEFramework
 			}
 
                         LOGINFO(" Send requestShortAudioDescriptor Message ");
-                    _instance->smConnection->sendTo(LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(RequestShortAudioDescriptor(formatid,audioFormatCode,numberofdescriptor)), 1000);
+                    _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "requestShortAudioDescriptor", LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(RequestShortAudioDescriptor(formatid,audioFormatCode,numberofdescriptor)), 1000);
 
 		}
 
@@ -2295,7 +2331,7 @@ namespace WPEFramework
                         }
 
                         LOGINFO(" Send GiveDevicePowerStatus Message to Audio system in the network \n");
-                        _instance->smConnection->sendTo(LogicalAddress::AUDIO_SYSTEM, MessageEncoder().encode(GiveDevicePowerStatus()), 500);
+                        _instance->sendFrame(CecTxScheduler::PRIORITY_USER, "audioDevicePowerStatus", LogicalAddress::AUDIO_SYSTEM, MessageEncoder().encode(GiveDevicePowerStatus()), 500);
 
 			m_audioDevicePowerStatusRequested = true;
                 }
@@ -2308,7 +2344,7 @@ namespace WPEFramework
                        if(!(_instance->smConnection))
                            return;
 		       LOGINFO(" Sending FeatureAbort to %s for opcode %s with reason %s ",logicalAddress.toString().c_str(),feature.toString().c_str(),reason.toString().c_str());
-                       _instance->smConnection->sendTo(logicalAddress, MessageEncoder().encode(FeatureAbort(feature,reason)), 500);
+                       _instance->sendFrame(CecTxScheduler::PRIORITY_PROTOCOL, "", logicalAddress, MessageEncoder().encode(FeatureAbort(feature,reason)), 500);
                  }
 
                void HdmiCecSink::reportFeatureAbortEvent(const LogicalAddress logicalAddress, const OpCode featureOpcode, const AbortReason abortReason)
@@ -2323,8 +2359,6 @@ namespace WPEFramework
 
 	void HdmiCecSink::pingDevices(std::vector<int> &connected , std::vector<int> &disconnected)
         {
-        	int i;
-
 		if(!HdmiCecSink::_instance)
                 return;
                 if(!(_instance->smConnection))
@@ -2334,40 +2368,45 @@ namespace WPEFramework
 				LOGERR("Logical Address NOT Allocated");
 				return;
 			}
-			
-            for(i=0; i< LogicalAddress::UNREGISTERED; i++ ) {
-				if ( i != _instance->m_logicalAddressAllocated )
+
+			std::vector<bool> present(LogicalAddress::UNREGISTERED, false);
+			for(int i=0; i< LogicalAddress::UNREGISTERED; i++ ) {
+				present[i] = _instance->deviceList[i].m_isDevicePresent;
+			}
+
+			/* Polls are paced by the scheduler and yield to any user command queued meanwhile */
+			_instance->m_txScheduler.discover(_instance->m_logicalAddressAllocated, present, connected, disconnected);
+        }
+
+		void HdmiCecSink::sendUserFrame(const std::string &key, const LogicalAddress &to, const CECFrame &frame, int timeout)
+		{
+			sendFrame(CecTxScheduler::PRIORITY_USER, key, to, frame, timeout);
+		}
+
+		void HdmiCecSink::sendFrame(CecTxScheduler::Priority priority, const std::string &key, const LogicalAddress &to, const CECFrame &frame, int timeout)
+		{
+			if(!(_instance->smConnection))
+				return;
+
+			/* Queued while the scheduler runs, sent right away under its lock otherwise.
+			 * The bus connection is only replaced while the scheduler is stopped. */
+			m_txScheduler.transmit(priority, key, [this, to, frame, timeout]() {
+				try
 				{
-					//LOGWARN("PING for  0x%x \r\n",i);
-					try {
-						_instance->smConnection->ping(LogicalAddress(_instance->m_logicalAddressAllocated), LogicalAddress(i), Throw_e());
-					}
-					catch(CECNoAckException &e)
-					{
-						if ( _instance->deviceList[i].m_isDevicePresent ) {
-							disconnected.push_back(i);
-						}
-                                                //LOGWARN("Ping device: 0x%x caught %s \r\n", i, e.what());
-						usleep(50000);
-						continue;
-					}
-					  catch(Exception &e)
-					  {
-						LOGWARN("Ping device: 0x%x caught %s \r\n", i, e.what());
-                                                usleep(50000);
-                                                continue;
-					  }
-					  
-					  /* If we get ACK, then the device is present in the network*/
-					  if ( !_instance->deviceList[i].m_isDevicePresent )
-					  {
-					  	connected.push_back(i);
-                                                //LOGWARN("Ping success, added device: 0x%x \r\n", i);
-					  }
-					  usleep(50000);      
+					m_txBus.sendTo(to, frame, timeout);
 				}
-           	}
-        }
+				catch(Exception &e)
+				{
+					LOGWARN("Sending to 0x%x failed: %s", to.toInt(), e.what());
+					throw;
+				}
+			});
+		}
+
+		void HdmiCecSink::sendResponse(const LogicalAddress &to, const CECFrame &frame, int timeout)
+		{
+			sendFrame(CecTxScheduler::PRIORITY_PROTOCOL, "", to, frame, timeout);
+		}
 
 		int HdmiCecSink::requestType( const int logicalAddress ) {
 			int requestType = CECDeviceParams::REQUEST_NONE;
@@ -2453,9 +2492,9 @@ namespace WPEFramework
 				{
 					LOGINFO("Sending Power OFF ");
 					/* send Power OFF Function to turn OFF */
-					_instance->smConnection->sendTo(LogicalAddress(_instance->m_currentActiveSource), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_POWER_OFF_FUNCTION)), 100);
+					_instance->sendUserFrame("", LogicalAddress(_instance->m_currentActiveSource), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_POWER_OFF_FUNCTION)), 100);
 
-					_instance->smConnection->sendTo(LogicalAddress(_instance->m_currentActiveSource), MessageEncoder().encode(UserControlReleased()), 100);
+					_instance->sendUserFrame("", LogicalAddress(_instance->m_currentActiveSource), MessageEncoder().encode(UserControlReleased()), 100);
 				}
 			}
 		}
@@ -2489,8 +2528,8 @@ namespace WPEFramework
 				{
 					LOGINFO("Sending Power ON");
 					/* send Power ON Function to turn ON */
-					_instance->smConnection->sendTo(LogicalAddress(logicalAddr), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_POWER_ON_FUNCTION)), 100);
-					_instance->smConnection->sendTo(LogicalAddress(logicalAddr), MessageEncoder().encode(UserControlReleased()), 100);
+					_instance->sendUserFrame("", LogicalAddress(logicalAddr), MessageEncoder().encode(UserControlPressed(UICommand::UI_COMMAND_POWER_ON_FUNCTION)), 100);
+					_instance->sendUserFrame("", LogicalAddress(logicalAddr), MessageEncoder().encode(UserControlReleased()), 100);
 				}
 			}
 		}
@@ -2507,7 +2546,7 @@ namespace WPEFramework
 				return;
 			}
 
-			_instance->smConnection->sendTo(LogicalAddress(LogicalAddress::BROADCAST), MessageEncoder().encode(SetStreamPath(physical_addr)), 500);
+			_instance->sendUserFrame("streamPath", LogicalAddress(LogicalAddress::BROADCAST), MessageEncoder().encode(SetStreamPath(physical_addr)), 500);
 		}
 
 		void HdmiCecSink::setRoutingChange(const std::string &from, const std::string &to) {
@@ -2566,7 +2605,7 @@ namespace WPEFramework
 			
                         if(!(_instance->smConnection))
                             return;
-			_instance->smConnection->sendTo(LogicalAddress(LogicalAddress::BROADCAST), MessageEncoder().encode(RoutingChange(oldPhyAddr, newPhyAddr)), 500);
+			_instance->sendUserFrame("routingChange", LogicalAddress(LogicalAddress::BROADCAST), MessageEncoder().encode(RoutingChange(oldPhyAddr, newPhyAddr)), 500);
 		}
 
 		void HdmiCecSink::addDevice(const int logicalAddress) {
@@ -2582,6 +2621,7 @@ namespace WPEFramework
 			
 			if ( !HdmiCecSink::_instance->deviceList[logicalAddress].m_isDevicePresent )
 			 {
+			 	HdmiCecSink::_instance->m_txScheduler.resetBackoff(logicalAddress);
 			 	HdmiCecSink::_instance->deviceList[logicalAddress].m_isDevicePresent = true;
 				HdmiCecSink::_instance->deviceList[logicalAddress].m_logicalAddress = LogicalAddress(logicalAddress);
 				HdmiCecSink::_instance->m_numberOfDevices++;
@@ -2647,7 +2687,7 @@ namespace WPEFramework
 				LOGERR("Logical Address NOT Allocated Or its not valid");
 				return;
 			}
-			_instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(GiveDevicePowerStatus()), 100);
+			_instance->sendFrame(CecTxScheduler::PRIORITY_DISCOVERY, "powerStatus-" + std::to_string(logicalAddress), LogicalAddress(logicalAddress), MessageEncoder().encode(GiveDevicePowerStatus()), 100);
 		}
 
 		void HdmiCecSink::request(const int logicalAddress) {
@@ -2665,35 +2705,36 @@ namespace WPEFramework
 			requestType = _instance->requestType(logicalAddress);
 			_instance->deviceList[logicalAddress].m_isRequested = requestType;
 			
+			/* Keyed by opcode and address, a pending request only absorbs a repeat of itself */
 			switch (requestType)
 			{
 				case CECDeviceParams::REQUEST_PHISICAL_ADDRESS :
 				{
-					_instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(GivePhysicalAddress()), 200);
+					_instance->sendFrame(CecTxScheduler::PRIORITY_DISCOVERY, "givePhysicalAddress-" + std::to_string(logicalAddress), LogicalAddress(logicalAddress), MessageEncoder().encode(GivePhysicalAddress()), 200);
 				}
 					break;
 
 				case CECDeviceParams::REQUEST_CEC_VERSION :
 				{
-					_instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(GetCECVersion()), 100);
+					_instance->sendFrame(CecTxScheduler::PRIORITY_DISCOVERY, "getCECVersion-" + std::to_string(logicalAddress), LogicalAddress(logicalAddress), MessageEncoder().encode(GetCECVersion()), 100);
 				}
 					break;
 
 				case CECDeviceParams::REQUEST_DEVICE_VENDOR_ID :
 				{
-					_instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(GiveDeviceVendorID()), 100);
+					_instance->sendFrame(CecTxScheduler::PRIORITY_DISCOVERY, "giveDeviceVendorID-" + std::to_string(logicalAddress), LogicalAddress(logicalAddress), MessageEncoder().encode(GiveDeviceVendorID()), 100);
 				}
 					break;
 
 				case CECDeviceParams::REQUEST_OSD_NAME :	
 				{
-					_instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(GiveOSDName()), 500);
+					_instance->sendFrame(CecTxScheduler::PRIORITY_DISCOVERY, "giveOSDName-" + std::to_string(logicalAddress), LogicalAddress(logicalAddress), MessageEncoder().encode(GiveOSDName()), 500);
 				}
 					break;
 
 				case CECDeviceParams::REQUEST_POWER_STATUS :	
 				{
-					_instance->smConnection->sendTo(LogicalAddress(logicalAddress), MessageEncoder().encode(GiveDevicePowerStatus()), 100);
+					_instance->sendFrame(CecTxScheduler::PRIORITY_DISCOVERY, "powerStatus-" + std::to_string(logicalAddress), LogicalAddress(logicalAddress), MessageEncoder().encode(GiveDevicePowerStatus()), 100);
 				}
 					break;
 				default:
@@ -2900,11 +2941,11 @@ namespace WPEFramework
 						    _instance->deviceList[_instance->m_logicalAddressAllocated].m_osdName = osdName.toString().c_str();
 						    if(cecVersion == 2.0) {
 						        _instance->deviceList[_instance->m_logicalAddressAllocated].m_cecVersion = Version::V_2_0;
-						        _instance->smConnection->sendTo(LogicalAddress(LogicalAddress::BROADCAST),
+						        _instance->sendFrame(CecTxScheduler::PRIORITY_PROTOCOL, "reportFeatures", LogicalAddress(LogicalAddress::BROADCAST),
                                                                     MessageEncoder().encode(ReportFeatures(Version::V_2_0,allDevicetype,rcProfile,deviceFeatures)), 500);
 						    }
 						    _instance->smConnection->addFrameListener(_instance->msgFrameListener);
-						    _instance->smConnection->sendTo(LogicalAddress(LogicalAddress::BROADCAST), 
+						    _instance->sendFrame(CecTxScheduler::PRIORITY_PROTOCOL, "reportPhysicalAddress", LogicalAddress(LogicalAddress::BROADCAST),
 						    		MessageEncoder().encode(ReportPhysicalAddress(physical_addr, _instance->deviceList[_instance->m_logicalAddressAllocated].m_deviceType)), 100);
 
 						    _instance->m_sleepTime = 0;
@@ -3174,6 +3215,7 @@ namespace WPEFramework
 
 			smConnection = new Connection(LogicalAddress::UNREGISTERED,false,"ServiceManager::Connection::");
             smConnection->open();
+            m_txBus.setConnection(smConnection);
             allocateLogicalAddress(DeviceType::TV);
             LOGINFO("logical address allocalted: %x  \n",m_logicalAddressAllocated);
             if ( m_logicalAddressAllocated != LogicalAddress::UNREGISTERED && smConnection)
@@ -3191,6 +3233,8 @@ namespace WPEFramework
 			    m_pollThreadState = POLL_THREAD_STATE_POLL;
                             m_pollNextState = POLL_THREAD_STATE_NONE;
                             m_pollThreadExit = false;
+				m_txScheduler.resetBackoff();
+				m_txScheduler.start();
 				m_pollThread = std::thread(threadRun);
             }
             cecEnableStatus = true;
@@ -3228,6 +3272,8 @@ namespace WPEFramework
 		LOGWARN("Stop Thread %p", smConnection );
 		m_pollThreadExit = true;
 		m_ThreadExitCV.notify_one();
+		/* releases the poll thread if it is waiting on a discovery sweep */
+		m_txScheduler.stop();
 
 		try
 		{
@@ -3251,6 +3297,7 @@ namespace WPEFramework
 
 		LOGWARN("Deleted Thread %p", smConnection );
 
+                m_txBus.setConnection(NULL);
                 smConnection->close();
                 delete smConnection;
                 smConnection = NULL;
@@ -3597,7 +3644,7 @@ namespace WPEFramework
            if(!(_instance->smConnection))
                return;
           LOGINFO(" Send_Request_Arc_Initiation_Message ");
-           _instance->smConnection->sendTo(LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(RequestArcInitiation()), 1000);
+           _instance->sendFrame(CecTxScheduler::PRIORITY_PROTOCOL, "requestArcInitiation", LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(RequestArcInitiation()), 1000);
 
         }
         void HdmiCecSink::Send_Report_Arc_Initiated_Message()
@@ -3606,7 +3653,7 @@ namespace WPEFramework
 	    return;
             if(!(_instance->smConnection))
                return;
-            _instance->smConnection->sendTo(LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(ReportArcInitiation()), 1000);
+            _instance->sendFrame(CecTxScheduler::PRIORITY_PROTOCOL, "reportArcInitiation", LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(ReportArcInitiation()), 1000);
 
         }
         void HdmiCecSink::Send_Request_Arc_Termination_Message()
@@ -3616,7 +3663,7 @@ namespace WPEFramework
 	     return;
             if(!(_instance->smConnection))
                return;
-            _instance->smConnection->sendTo(LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(RequestArcTermination()), 1000);
+            _instance->sendFrame(CecTxScheduler::PRIORITY_PROTOCOL, "requestArcTermination", LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(RequestArcTermination()), 1000);
         }
 
        void HdmiCecSink::Send_Report_Arc_Terminated_Message()
@@ -3625,7 +3672,7 @@ namespace WPEFramework
 		return;
             if(!(_instance->smConnection))
                return;
-           _instance->smConnection->sendTo(LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(ReportArcTermination()), 1000);
+           _instance->sendFrame(CecTxScheduler::PRIORITY_PROTOCOL, "reportArcTermination", LogicalAddress::AUDIO_SYSTEM,MessageEncoder().encode(ReportArcTermination()), 1000);
 
        }
        
@@ -3633,7 +3680,7 @@ namespace WPEFramework
       {
          int err;
          dsGetHDMIARCPortIdParam_t param;
-         err = IARM_Bus_Call(IARM_BUS_DSMGR_NAME,
+         err = Utils::IARM::call(IARM_BUS_DSMGR_NAME,
                             (char *)IARM_BUS_DSMGR_API_dsGetHDMIARCPortId,
                             (void *)&param,
                             sizeof(param));
@@ -33,6 +33,7 @@
 
 #include "Module.h"
 #include "tptimer.h"
+#include "CecTxScheduler.h"
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -53,6 +54,18 @@ namespace WPEFramework {
             MessageProcessor &processor;
         };
         
+        class HdmiCecSinkTxBus : public CecTxBus
+        {
+        public:
+            HdmiCecSinkTxBus() : m_connection(NULL) {}
+            /* Set while the scheduler is stopped, its thread is then the only one sending */
+            void setConnection(Connection *conn) { m_connection = conn; }
+            PingResult ping(int from, int to) override;
+            void sendTo(const LogicalAddress &to, const CECFrame &frame, int timeout);
+        private:
+            Connection *m_connection;
+        };
+
         class HdmiCecSinkProcessor : public MessageProcessor
         {
         public:
@@ -557,6 +570,8 @@ private:
 			void Process_SetSystemAudioMode_msg(const SetSystemAudioMode &msg);
 			void sendDeviceUpdateInfo(const int logicalAddress);
 			void sendFeatureAbort(const LogicalAddress logicalAddress, const OpCode feature, const AbortReason reason);
+			/* Replies to received messages, through the transmit scheduler */
+			void sendResponse(const LogicalAddress &to, const CECFrame &frame, int timeout);
 			void reportFeatureAbortEvent(const LogicalAddress logicalAddress, const OpCode feature, const AbortReason reason);
 			void systemAudioModeRequest();
                         void SendStandbyMsgEvent(const int logicalAddress);
@@ -651,6 +666,9 @@ private:
             TpTimer m_arcStartStopTimer;
 
             Connection *smConnection;
+            /* Discovery polls and user initiated commands are serialized through m_txScheduler */
+            HdmiCecSinkTxBus m_txBus;
+            CecTxScheduler m_txScheduler;
 			std::vector<uint8_t> m_connectedDevices;
             HdmiCecSinkProcessor *msgProcessor;
             HdmiCecSinkFrameListener *msgFrameListener;
@@ -659,6 +677,8 @@ private:
 			void allocateLogicalAddress(int deviceType);
 			void allocateLAforTV();
 			void pingDevices(std::vector<int> &connected , std::vector<int> &disconnected);
+			void sendUserFrame(const std::string &key, const LogicalAddress &to, const CECFrame &frame, int timeout);
+			void sendFrame(CecTxScheduler::Priority priority, const std::string &key, const LogicalAddress &to, const CECFrame &frame, int timeout);
 			void CheckHdmiInState();
 			void request(const int logicalAddress);
 			int requestType(const int logicalAddress);
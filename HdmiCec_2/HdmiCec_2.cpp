@@ -432,7 +432,7 @@ namespace WPEFramework
 
                char c;
                IARM_Result_t retVal = IARM_RESULT_SUCCESS;
-               retVal = IARM_Bus_Call_with_IPCTimeout(IARM_BUS_CECMGR_NAME, IARM_BUS_CECMGR_API_isAvailable, (void *)&c, sizeof(c), 1000);
+               retVal = Utils::IARM::callWithIPCTimeout(IARM_BUS_CECMGR_NAME, IARM_BUS_CECMGR_API_isAvailable, (void *)&c, sizeof(c), 1000);
                if(retVal != IARM_RESULT_SUCCESS) {
                    msg = "IARM_BUS_CECMGR is not available";
                    LOGINFO("CECMGR is not available. Failed to activate HdmiCec_2 Plugin");
@@ -473,7 +473,7 @@ namespace WPEFramework
 
                 // get power state:
                 IARM_Bus_PWRMgr_GetPowerState_Param_t param;
-                int err = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+                int err = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                             IARM_BUS_PWRMGR_API_GetPowerState,
                             (void *)&param,
                             sizeof(param));
@@ -68,7 +68,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 4
-#define API_VERSION_NUMBER_PATCH 0
+#define API_VERSION_NUMBER_PATCH 1
 
 static int audio_output_delay = 100;
 static int video_latency = 20;
@@ -504,7 +504,7 @@ namespace WPEFramework
 
         void HdmiInput::writeEDID(int deviceId, std::string message)
         {
-
+            m_edidCache.Invalidate(deviceId);
         }
 
         std::string HdmiInput::readEDID(int iPort)
@@ -514,7 +514,10 @@ namespace WPEFramework
             try
             {
                 vector<uint8_t> edidVec2;
-                device::HdmiInput::getInstance().getEDIDBytesInfo (iPort, edidVec2);
+                m_edidCache.Bytes(iPort, [iPort](vector<uint8_t>& bytes) {
+                    device::HdmiInput::getInstance().getEDIDBytesInfo (iPort, bytes);
+                    return !bytes.empty();
+                }, edidVec2);
                 edidVec = edidVec2;//edidVec must be "unknown" unless we successfully get to this line
 
                 //convert to base64
@@ -547,6 +550,7 @@ namespace WPEFramework
         void HdmiInput::hdmiInputHotplug( int input , int connect)
         {
             LOGWARN("hdmiInputHotplug [%d, %d]", input, connect);
+            m_edidCache.Invalidate(input);
 
             JsonObject params;
             params["devices"] = getHDMIInputDevices();
@@ -1368,6 +1372,7 @@ namespace WPEFramework
             try
             {
                 device::HdmiInput::getInstance().setEdidVersion (iPort, iEdidVer);
+                m_edidCache.Invalidate(iPort);
                 LOGWARN("HdmiInput::setEdidVersion EDID Version:%d", iEdidVer);
             }
             catch (const device::Exception& err)
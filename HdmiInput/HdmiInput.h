@@ -23,6 +23,7 @@
 
 #include "Module.h"
 #include "dsTypes.h"
+#include "UtilsEdid.h"
 
 #define DEFAULT_PRIM_VOL_LEVEL 25
 #define MAX_PRIM_VOL_LEVEL 100
@@ -92,6 +93,7 @@ namespace WPEFramework {
             WPEFramework::JSONRPC::LinkType<WPEFramework::Core::JSON::IElement>* m_client;
             WPEFramework::JSONRPC::LinkType<WPEFramework::Core::JSON::IElement>* m_tv_client;
             std::vector<std::string> m_clientRegisteredEventNames;
+            Utils::Edid::Cache m_edidCache; // per input port, dropped on hotplug and EDID changes
             uint32_t getServiceState(PluginHost::IShell* shell, const string& callsign, PluginHost::IShell::state& state);
 
 	    void hdmiInputHotplug( int input , int connect);
@@ -19,10 +19,13 @@
 
 #include "DemuxerStreamFsFCC.h"
 #include <iostream>
-#include <fstream>
 #include <sstream>
 #include <vector>
 #include <boost/algorithm/string.hpp>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 // delimiter used for string tokenizing
 #define DELIMITER ','
@@ -35,6 +38,8 @@
 // index definitions for stream_status fsnode
 #define STREAM_SOURCE_LOST 0
 #define STREAM_SOURCE_LOSS_COUNT 1
+// largest node content read, the seek node holds 5 comma separated 64-bit numbers
+#define NODE_BUFFER_SIZE 256
 
 namespace WPEFramework {
 namespace Plugin {
@@ -56,26 +61,30 @@ inline bool stringToNumber(const std::string &in, T &out) {
     return !(in.empty() || numberToString<T>(out) != in);
 }
 
-IDemuxer::IO_STATUS read(const std::string &name, std::string &data) {
-    std::ifstream file(name);
-    syslog(LOG_INFO, "Reading from file: %s", name.c_str());
-    if (!file.is_open()) {
+// The nodes hold a single line, read and written at offset 0.
+IDemuxer::IO_STATUS readLine(int fd, std::string &data) {
+    char buf[NODE_BUFFER_SIZE];
+    const ssize_t res = pread(fd, buf, sizeof(buf), 0);
+    if (res < 0) {
         return DemuxerStreamFsFCC::IO_STATUS::READ_ERROR;
     }
-    getline(file, data);
-    file.close();
+    data.assign(buf, res);
+    const size_t eol = data.find('\n');
+    if (eol != std::string::npos) {
+        data.erase(eol);
+    }
     return DemuxerStreamFsFCC::IO_STATUS::OK;
 }
 
-IDemuxer::IO_STATUS write(const std::string &name, const std::string &data) {
-    std::ofstream file(name);
-    syslog(LOG_ERR, "Writing to file: %s", name.c_str());
-    if (!file.is_open()) {
+IDemuxer::IO_STATUS writeLine(int fd, const std::string &data) {
+    struct stat st;
+    // A regular file (simulated node) is truncated first, so a shorter value leaves no stale tail and a
+    // concurrent reader sees either nothing or the whole new value.
+    if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (ftruncate(fd, 0) != 0)) {
         return DemuxerStreamFsFCC::IO_STATUS::WRITE_ERROR;
     }
-    file << data;
-    file.close();
-    if (!file) {
+    const ssize_t res = pwrite(fd, data.c_str(), data.size(), 0);
+    if ((res < 0) || (static_cast<size_t>(res) != data.size())) {
         // return WRITE_ERROR if file system reported error during writing of the data
         return DemuxerStreamFsFCC::IO_STATUS::WRITE_ERROR;
     }
@@ -92,51 +101,110 @@ std::vector<T> arrayFromString(std::string input, unsigned char delim) {
 }
 
 template<typename T>
-IDemuxer::IO_STATUS readArray(const std::string &name, std::vector<T> &array, size_t expectedSize) {
-    std::string line;
-    if (read(name, line) == DemuxerStreamFsFCC::IO_STATUS::OK) {
-        array = arrayFromString<T>(line, DELIMITER);
-        if (array.size() == expectedSize) {
-            return DemuxerStreamFsFCC::IO_STATUS::OK;
-        }
-        return DemuxerStreamFsFCC::IO_STATUS::PARSE_ERROR;
+IDemuxer::IO_STATUS parseArray(const std::string &line, std::vector<T> &array, size_t expectedSize) {
+    array = arrayFromString<T>(line, DELIMITER);
+    if (array.size() == expectedSize) {
+        return DemuxerStreamFsFCC::IO_STATUS::OK;
     }
-    return DemuxerStreamFsFCC::IO_STATUS::READ_ERROR;
+    return DemuxerStreamFsFCC::IO_STATUS::PARSE_ERROR;
 }
 
 } // namespace anonymous
 
+bool DemuxerStreamFsFCC::openNode(Node &node)
+{
+    struct stat st;
+    if ((node.fd >= 0) && (fstat(node.fd, &st) == 0) && (st.st_nlink == 0)) {
+        // The node was removed (and maybe created again), the descriptor refers to the old one.
+        closeNode(node);
+    }
+    if (node.fd < 0) {
+        node.fd = ::open(node.path.c_str(), node.flags | O_CLOEXEC);
+        if (node.fd < 0) {
+            syslog(LOG_ERR, "Could not open %s: %s", node.path.c_str(), strerror(errno));
+            return false;
+        }
+    }
+    return true;
+}
+
+void DemuxerStreamFsFCC::closeNode(Node &node)
+{
+    if (node.fd >= 0) {
+        ::close(node.fd);
+        node.fd = -1;
+    }
+}
+
+IDemuxer::IO_STATUS DemuxerStreamFsFCC::read(Node &node, std::string &data)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    // A failing descriptor is dropped and the node opened again once, e.g. when streamfs was remounted.
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (openNode(node) && (readLine(node.fd, data) == IO_STATUS::OK)) {
+            return IO_STATUS::OK;
+        }
+        closeNode(node);
+    }
+    return IO_STATUS::READ_ERROR;
+}
+
+IDemuxer::IO_STATUS DemuxerStreamFsFCC::write(Node &node, const std::string &data)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (openNode(node) && (writeLine(node.fd, data) == IO_STATUS::OK)) {
+            return IO_STATUS::OK;
+        }
+        closeNode(node);
+    }
+    return IO_STATUS::WRITE_ERROR;
+}
+
 IDemuxer::IO_STATUS DemuxerStreamFsFCC::open()
 {
-    // implementation to be added later
+    std::lock_guard<std::mutex> lock(_lock);
+    // Nodes missing now are opened on first access.
+    openNode(_channel);
+    openNode(_seek);
+    openNode(_trickPlay);
+    openNode(_status);
     return DemuxerStreamFsFCC::IO_STATUS::OK;
 }
 
 IDemuxer::IO_STATUS DemuxerStreamFsFCC::close()
 {
-    // implementation to be added later
+    std::lock_guard<std::mutex> lock(_lock);
+    closeNode(_channel);
+    closeNode(_seek);
+    closeNode(_trickPlay);
+    closeNode(_status);
     return DemuxerStreamFsFCC::IO_STATUS::OK;
 }
 
 IDemuxer::IO_STATUS DemuxerStreamFsFCC::setChannel(const std::string& channel)
 {
 
-    return write(DemuxerStreamFsFCC::_fileChannel, channel);
+    return write(_channel, channel);
 }
 
 IDemuxer::IO_STATUS DemuxerStreamFsFCC::getChannel(std::string& channel)
 {
-    return read(DemuxerStreamFsFCC::_fileChannel, channel);
+    return read(_channel, channel);
 }
 
 IDemuxer::IO_STATUS DemuxerStreamFsFCC::setSeekPosInSeconds(uint64_t seekSeconds)
 {
-    return write(DemuxerStreamFsFCC::_fileSeek, numberToString<uint64_t>(seekSeconds));
+    return write(_seek, numberToString<uint64_t>(seekSeconds));
 }
 
 IDemuxer::IO_STATUS DemuxerStreamFsFCC::getSeek(SeekType &result) {
+    std::string line;
     std::vector<uint64_t> values;
-    auto status = readArray<uint64_t>(DemuxerStreamFsFCC::_fileSeek, values, 5);
+    auto status = read(_seek, line);
+    if (status == IO_STATUS::OK) {
+        status = parseArray<uint64_t>(line, values, 5);
+    }
     if (status == IO_STATUS::OK) {
         result.seekPosInSeconds      = values[CURRENT_SEEK_IN_SEC];
         result.seekPosInBytes        = values[CURRENT_SEEK_IN_BYTES];
@@ -149,13 +217,13 @@ IDemuxer::IO_STATUS DemuxerStreamFsFCC::getSeek(SeekType &result) {
 
 IDemuxer::IO_STATUS DemuxerStreamFsFCC::setTrickPlaySpeed(int16_t speed)
 {
-    return write(DemuxerStreamFsFCC::_fileTrickPlay, numberToString<int16_t>(speed));
+    return write(_trickPlay, numberToString<int16_t>(speed));
 }
 
 IDemuxer::IO_STATUS DemuxerStreamFsFCC::getTrickPlaySpeed(int16_t &result)
 {
     std::string line;
-    if (read(DemuxerStreamFsFCC::_fileTrickPlay, line) == DemuxerStreamFsFCC::IO_STATUS::OK) {
+    if (read(_trickPlay, line) == DemuxerStreamFsFCC::IO_STATUS::OK) {
         if (stringToNumber<int16_t>(line, result)) {
             return DemuxerStreamFsFCC::IO_STATUS::OK;
         }
@@ -165,9 +233,19 @@ IDemuxer::IO_STATUS DemuxerStreamFsFCC::getTrickPlaySpeed(int16_t &result)
 }
 
 IDemuxer::IO_STATUS DemuxerStreamFsFCC::getStreamStatus(StreamStatusType &result)
+{
+    std::string line;
+    auto status = read(_status, line);
+    if (status == IO_STATUS::OK) {
+        status = parseStreamStatus(line, result);
+    }
+    return status;
+}
+
+IDemuxer::IO_STATUS DemuxerStreamFsFCC::parseStreamStatus(const std::string &data, StreamStatusType &result)
 {
     std::vector<uint64_t> values;
-    auto status = readArray<uint64_t>(DemuxerStreamFsFCC::_fileStatus, values, 2);
+    auto status = parseArray<uint64_t>(data, values, 2);
     if (status == IO_STATUS::OK) {
         result.streamSourceLost      = values[STREAM_SOURCE_LOST];
         result.streamSourceLossCount = values[STREAM_SOURCE_LOSS_COUNT];
@@ -175,10 +253,17 @@ IDemuxer::IO_STATUS DemuxerStreamFsFCC::getStreamStatus(StreamStatusType &result
     return status;
 }
 
+std::string DemuxerStreamFsFCC::getChannelFile() const {
+    return _channel.path;
+}
+
 std::string DemuxerStreamFsFCC::getTrickPlayFile() const {
-    return _fileTrickPlay;
+    return _trickPlay.path;
+}
+
+std::string DemuxerStreamFsFCC::getStreamStatusFile() const {
+    return _status.path;
 }
 
 } // namespace Plugin
 } // namespace WPEFramework
-
@@ -19,8 +19,10 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <stdint.h>
+#include <fcntl.h>
 #include "LinearConfig.h"
 #include "IDemuxer.h"
 
@@ -41,19 +43,25 @@ static inline std::string separator()
 
 /**
  * Concrete implementation of a demuxer interface for Nokia FCC
+ *
+ * The FCC nodes are opened once and then read and written at offset 0, instead of being opened for every
+ * call. A node that cannot be opened, or fails, is (re)opened on the next access. The mount point may also
+ * hold regular files instead of streamfs nodes, which is how the FCC file system is simulated in tests.
  */
 class DemuxerStreamFsFCC : public IDemuxer {
     public:
         explicit DemuxerStreamFsFCC(LinearConfig::Config *config, uint8_t demuxId)
+            : _channel(config->MountPoint.Value() + separator() + FCC_PLUGIN_PATH + separator() + "chan_select" + std::to_string(demuxId), O_RDWR)
+            , _seek(config->MountPoint.Value() + separator() + FCC_PLUGIN_PATH + separator() + "seek" + std::to_string(demuxId), O_RDWR)
+            , _trickPlay(config->MountPoint.Value() + separator() + FCC_PLUGIN_PATH + separator() + "trick_play" + std::to_string(demuxId), O_RDWR)
+            , _status(config->MountPoint.Value() + separator() + FCC_PLUGIN_PATH + separator() + "stream_status", O_RDONLY)
         {
-            _fileChannel   = config->MountPoint.Value() + separator() + FCC_PLUGIN_PATH + separator() + "chan_select" + std::to_string(demuxId);
-            _fileSeek      = config->MountPoint.Value() + separator() + FCC_PLUGIN_PATH + separator() + "seek" + std::to_string(demuxId);
-            _fileTrickPlay = config->MountPoint.Value() + separator() + FCC_PLUGIN_PATH + separator() + "trick_play" + std::to_string(demuxId);
-            _fileStatus    = config->MountPoint.Value() + separator() + FCC_PLUGIN_PATH + separator() + "stream_status";
         };
 
         ~DemuxerStreamFsFCC()
-        {}
+        {
+            close();
+        }
 
     IDemuxer::IO_STATUS open() override;
 
@@ -73,13 +81,37 @@ class DemuxerStreamFsFCC : public IDemuxer {
 
     IDemuxer::IO_STATUS getStreamStatus(StreamStatusType &result) override;
 
+    std::string getChannelFile() const;
+
     std::string getTrickPlayFile() const;
 
+    std::string getStreamStatusFile() const;
+
+    // Parses the content of the stream_status node, as passed by a FileSelectListener.
+    static IDemuxer::IO_STATUS parseStreamStatus(const std::string &data, StreamStatusType &result);
+
+private:
+    struct Node {
+        Node(const std::string &path, int flags)
+            : path(path), flags(flags), fd(-1)
+        {}
+
+        const std::string path;
+        const int flags;
+        int fd;
+    };
+
+    IDemuxer::IO_STATUS read(Node &node, std::string &data);
+    IDemuxer::IO_STATUS write(Node &node, const std::string &data);
+    bool openNode(Node &node);
+    void closeNode(Node &node);
+
 private:
-    std::string _fileChannel;
-    std::string _fileSeek;
-    std::string _fileTrickPlay;
-    std::string _fileStatus;
+    std::mutex _lock;
+    Node _channel;
+    Node _seek;
+    Node _trickPlay;
+    Node _status;
 };
 
 } // namespace Plugin
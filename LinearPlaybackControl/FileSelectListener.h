@@ -19,21 +19,71 @@
 
 #pragma once
 
-#include <thread>
+#include <atomic>
+#include <chrono>
 #include <functional>
-#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <syslog.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
 
+/**
+ * Reports the content of a set of files whenever it changes, from a single thread.
+ *
+ * Streamfs nodes are waited on with poll() on a descriptor that stays open. Regular files, as used by a
+ * simulated FCC file system, are watched with inotify. The directory of every file is watched as well, so a
+ * file that is missing at start or removed later is picked up as soon as it (re)appears, without polling.
+ * Only content that differs from what was last reported is passed on; empty content is skipped. Content
+ * present when the listener is created is not reported.
+ */
 class FileSelectListener
 {
 public:
+    using Callback = std::function<void(const std::string&)>;
+    using Files = std::vector<std::pair<std::string, Callback>>;
+
     FileSelectListener(const std::string &file,
                        uint32_t bufSize,
-                       std::function<void(const std::string&)> func)
-            : mFile(file)
-            , mBufSize(bufSize)
-            , mFunc(func)
+                       Callback func)
+            : FileSelectListener(Files{ { file, func } }, bufSize)
+    {
+    }
+
+    FileSelectListener(const Files &files, uint32_t bufSize)
+            : mBuf(bufSize)
             , mStop(false)
+            , mWakeFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+            , mInotifyFd(inotify_init1(IN_CLOEXEC | IN_NONBLOCK))
     {
+        if (mInotifyFd < 0) {
+            syslog(LOG_ERR, "inotify is not available (%s), missing files are checked every second", strerror(errno));
+        }
+
+        for (const auto &file : files) {
+            Entry entry;
+            const size_t pos = file.first.find_last_of('/');
+            entry.file = file.first;
+            entry.dir = (pos == std::string::npos) ? "." : ((pos == 0) ? "/" : file.first.substr(0, pos));
+            entry.name = (pos == std::string::npos) ? file.first : file.first.substr(pos + 1);
+            entry.func = file.second;
+            mEntries.push_back(entry);
+        }
+        for (auto &entry : mEntries) {
+            if (!openEntry(entry, false)) {
+                syslog(LOG_ERR, "%s is missing, waiting for it", entry.file.c_str());
+            }
+        }
+
         mThread = std::shared_ptr<std::thread>(
                 new std::thread(&FileSelectListener::pollLoop, this));
     }
@@ -41,82 +91,212 @@ public:
     ~FileSelectListener()
     {
         mStop = true;
+        if (mWakeFd >= 0) {
+            const uint64_t one = 1;
+            if (write(mWakeFd, &one, sizeof(one)) != sizeof(one)) {
+                syslog(LOG_ERR, "Failed to wake up the listener: %s", strerror(errno));
+            }
+        }
         if (mThread != nullptr && mThread->joinable()) {
             mThread->join();
         }
+        for (auto &entry : mEntries) {
+            closeEntry(entry);
+        }
+        if (mInotifyFd >= 0) {
+            close(mInotifyFd);
+        }
+        if (mWakeFd >= 0) {
+            close(mWakeFd);
+        }
     }
 
 private:
     FileSelectListener(const FileSelectListener&) = delete;
     FileSelectListener& operator=(const FileSelectListener&) = delete;
 
-    std::string mFile;
-    uint32_t mBufSize;
-    std::function<void(const std::string&)> mFunc;
-    bool mStop;
+    struct Entry {
+        std::string file;
+        std::string dir;
+        std::string name;
+        Callback func;
+        std::string last;
+        int fd = -1;
+        int wd = -1;      // watch on the file itself, regular files only
+        int dirWd = -1;   // watch on the directory, shared by the files in it
+        bool regular = false;
+        bool backoff = false;
+    };
+
+    std::vector<Entry> mEntries;
+    std::vector<char> mBuf;
+    std::atomic<bool> mStop;
+    int mWakeFd;
+    int mInotifyFd;
 
     std::shared_ptr<std::thread> mThread;
 
-    inline bool file_exists(const std::string &name) {
-        std::ifstream f(name.c_str());
-        f.close();
-        return f.good();
+    bool openEntry(Entry &entry, bool notify) {
+        if ((entry.dirWd < 0) && (mInotifyFd >= 0)) {
+            entry.dirWd = inotify_add_watch(mInotifyFd, entry.dir.c_str(), IN_CREATE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM);
+        }
+        if (entry.fd >= 0) {
+            return true;
+        }
+
+        entry.fd = open(entry.file.c_str(), O_RDONLY | O_CLOEXEC);
+        if (entry.fd < 0) {
+            return false;
+        }
+
+        struct stat st;
+        entry.regular = (fstat(entry.fd, &st) == 0) && S_ISREG(st.st_mode);
+        if (entry.regular) {
+            // Watch before reading, so a write in between is not lost.
+            if (mInotifyFd >= 0) {
+                entry.wd = inotify_add_watch(mInotifyFd, entry.file.c_str(), IN_MODIFY | IN_CLOSE_WRITE);
+            }
+            readEntry(entry, notify);
+        }
+        return true;
     }
 
-    void pollLoop() {
-        char buf[mBufSize];
-        int fd;
-        while (!mStop) {
-            if (!file_exists(mFile)) {
-                syslog(LOG_ERR, "%s is missing. Retry in 2 seconds", mFile.c_str());
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-                continue;
+    void closeEntry(Entry &entry) {
+        if ((entry.wd >= 0) && (mInotifyFd >= 0)) {
+            inotify_rm_watch(mInotifyFd, entry.wd);
+        }
+        entry.wd = -1;
+        if (entry.fd >= 0) {
+            close(entry.fd);
+            entry.fd = -1;
+        }
+    }
+
+    bool readEntry(Entry &entry, bool notify) {
+        if (lseek(entry.fd, 0, SEEK_SET) < 0) {
+            syslog(LOG_ERR, "Failed to rewind %s: %s", entry.file.c_str(), strerror(errno));
+            return false;
+        }
+        const ssize_t res = read(entry.fd, mBuf.data(), mBuf.size());
+        if (res < 0) {
+            syslog(LOG_ERR, "Failed to read data from %s: %s", entry.file.c_str(), strerror(errno));
+            return false;
+        }
+
+        std::string data(mBuf.data(), res);
+        if (!data.empty() && (data != entry.last)) {
+            entry.last = data;
+            if (notify) {
+                entry.func(data);
             }
+        }
+        return true;
+    }
 
-            fd = open(mFile.c_str(), O_RDONLY);
-            if (fd < 0) {
-                syslog(LOG_ERR, "Could not open %s", mFile.c_str());
-                continue;
+    void handleInotify() {
+        alignas(struct inotify_event) char buf[4096];
+        ssize_t len;
+        while ((len = read(mInotifyFd, buf, sizeof(buf))) > 0) {
+            for (char *ptr = buf; ptr < buf + len; ) {
+                const struct inotify_event *event = reinterpret_cast<const struct inotify_event*>(ptr);
+                for (auto &entry : mEntries) {
+                    handleEvent(entry, *event);
+                }
+                ptr += sizeof(struct inotify_event) + event->len;
+            }
+        }
+    }
+
+    void handleEvent(Entry &entry, const struct inotify_event &event) {
+        if ((event.mask & IN_IGNORED) != 0) {
+            if (event.wd == entry.wd) {
+                entry.wd = -1;
+                closeEntry(entry);
+            }
+            if (event.wd == entry.dirWd) {
+                entry.dirWd = -1;
             }
+        } else if ((event.wd == entry.dirWd) && (event.len > 0) && (entry.name == event.name)) {
+            // Removed, or replaced by a new file: the descriptor refers to the old one.
+            closeEntry(entry);
+            if ((event.mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+                openEntry(entry, true);
+            }
+        } else if ((entry.wd >= 0) && (event.wd == entry.wd)) {
+            readEntry(entry, true);
+        }
+    }
 
-            while (!mStop) {
-                fd_set rfds;
-                struct timeval timeout;
+    void pollLoop() {
+        std::vector<struct pollfd> fds;
+        std::vector<Entry*> polled;
 
-                FD_ZERO(&rfds);
-                FD_SET(fd, &rfds);
+        while (!mStop) {
+            bool timed = (mWakeFd < 0);
 
-                /* Initialize the timeout data structure. */
-                timeout.tv_sec = 2;
-                timeout.tv_usec = 0;
+            fds.clear();
+            polled.clear();
+            fds.push_back({ mWakeFd, POLLIN, 0 });
+            fds.push_back({ mInotifyFd, POLLIN, 0 });
+            for (auto &entry : mEntries) {
+                if (entry.backoff) {
+                    entry.backoff = false;
+                    timed = true;
+                } else if ((entry.fd < 0) && !openEntry(entry, true) && (entry.dirWd < 0)) {
+                    timed = true;
+                }
+                if ((entry.fd >= 0) && entry.regular && (entry.wd < 0)) {
+                    timed = true;
+                }
+                if ((entry.fd >= 0) && !entry.regular) {
+                    fds.push_back({ entry.fd, POLLIN | POLLPRI, 0 });
+                    polled.push_back(&entry);
+                }
+            }
 
-                int res = select(fd + 1, &rfds, nullptr, nullptr, &timeout);
-                if (res < 0) {
-                    syslog(LOG_ERR, "Calling select on %s failed", mFile.c_str());
-                    break;
+            const int res = poll(fds.data(), fds.size(), timed ? 1000 : -1);
+            if (res < 0) {
+                if (errno != EINTR) {
+                    syslog(LOG_ERR, "Calling poll failed: %s", strerror(errno));
+                    std::this_thread::sleep_for(std::chrono::seconds(1));
                 }
+                continue;
+            }
+            if (mStop || ((fds[0].revents & POLLIN) != 0)) {
+                break;
+            }
+
+            if ((fds[1].revents & POLLIN) != 0) {
+                handleInotify();
+            }
 
-                if (!FD_ISSET(fd, &rfds)) {
+            for (size_t i = 0; i < polled.size(); i++) {
+                const struct pollfd &pfd = fds[i + 2];
+                Entry &entry = *polled[i];
+                if (entry.fd != pfd.fd) {
+                    // closed or reopened while handling inotify
                     continue;
                 }
-                lseek(fd, 0, SEEK_SET);
-
-                res = read(fd, buf, mBufSize);
-                if (res < 0) {
-                    if (errno == ENOTCONN || errno == EBADF || errno == ECONNRESET) {
-                        syslog(LOG_ERR, "Socket error for %s", mFile.c_str());
-                        break;
-                    } else {
-                        syslog(LOG_ERR, "Failed to read data from %s", mFile.c_str());
-                        std::this_thread::sleep_for(std::chrono::seconds(2));
-                        continue;
+                if ((pfd.revents & (POLLIN | POLLPRI)) != 0) {
+                    if (!readEntry(entry, true)) {
+                        closeEntry(entry);
+                        entry.backoff = true;
+                    }
+                } else if ((pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0) {
+                    syslog(LOG_ERR, "Lost %s, reopening", entry.file.c_str());
+                    closeEntry(entry);
+                    entry.backoff = true;
+                }
+            }
+
+            if (res == 0) {
+                // No inotify for these: check on every timeout.
+                for (auto &entry : mEntries) {
+                    if ((entry.fd >= 0) && entry.regular && (entry.wd < 0)) {
+                        readEntry(entry, true);
                     }
-                } else {
-                    mFunc(std::string(buf, res));
                 }
             }
-            close(fd);
-            std::this_thread::sleep_for(std::chrono::seconds(1));
         }
     }
 };
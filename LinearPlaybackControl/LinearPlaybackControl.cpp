@@ -23,7 +23,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 0
+#define API_VERSION_NUMBER_PATCH 1
 
 namespace WPEFramework {
 
@@ -49,6 +49,8 @@ namespace Plugin {
     {
         ASSERT(_service == nullptr);
 
+        _service = service;
+
         LinearConfig::Config config;
         config.FromString(service->ConfigLine());
         _mountPoint = config.MountPoint.Value();
@@ -57,9 +59,13 @@ namespace Plugin {
         if (_isStreamFSEnabled) {
             // For now we only have one Nokia FCC demuxer interface with demux Id = 0
             _demuxer = std::unique_ptr<DemuxerStreamFsFCC>(new DemuxerStreamFsFCC(&config, 0));
-            _trickPlayFileListener = std::unique_ptr<FileSelectListener>(new FileSelectListener(_demuxer->getTrickPlayFile(), 16,[this](const std::string &data){
-                speedchangedNotify(data);
-            }));
+            _demuxer->open();
+            // One thread pushes channel, trick play and stream status changes as they happen, so clients need not poll.
+            _fileListener = std::unique_ptr<FileSelectListener>(new FileSelectListener({
+                { _demuxer->getChannelFile(), [this](const std::string &data){ channelchangedNotify(data); } },
+                { _demuxer->getTrickPlayFile(), [this](const std::string &data){ speedchangedNotify(data); } },
+                { _demuxer->getStreamStatusFile(), [this](const std::string &data){ streamstatuschangedNotify(data); } }
+            }, 256));
         }
 
         // Initialize streamfs and associated dependencies here.
@@ -73,6 +79,11 @@ namespace Plugin {
         ASSERT(_service == service);
 
        // Deinitialize streamfs and associated dependencies here.
+        _fileListener.reset();
+        if (_demuxer) {
+            _demuxer->close();
+            _demuxer.reset();
+        }
 
         _service = nullptr;
     }
@@ -102,6 +102,8 @@ namespace Plugin {
         uint32_t callDemuxer(const string& demuxerId, const std::function<endpoint_func>& func) const;
 
         void speedchangedNotify(const std::string &data);
+        void channelchangedNotify(const std::string &data);
+        void streamstatuschangedNotify(const std::string &data);
 
     private:
         uint32_t _skipURL;
@@ -109,7 +111,7 @@ namespace Plugin {
         std::string _mountPoint;
         bool _isStreamFSEnabled;
         std::unique_ptr<DemuxerStreamFsFCC> _demuxer;
-        std::unique_ptr<FileSelectListener> _trickPlayFileListener;
+        std::unique_ptr<FileSelectListener> _fileListener;
 };
 } //namespace Plugin
 } //namespace WPEFramework
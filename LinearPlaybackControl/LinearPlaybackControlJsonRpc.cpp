@@ -262,7 +262,7 @@ namespace Plugin {
     }
 
     void LinearPlaybackControl::speedchangedNotify(const std::string &data) {
-        uint16_t trickPlaySpeed;
+        int16_t trickPlaySpeed;
         std::istringstream is(data);
         is >> trickPlaySpeed;
 
@@ -272,5 +272,28 @@ namespace Plugin {
 
         Notify(_T("speedchanged"), params);
     }
+
+    void LinearPlaybackControl::channelchangedNotify(const std::string &data) {
+        JsonObject params;
+        params[_T("channel")] = data.substr(0, data.find('\n'));
+        params[_T("muxId")] = 0;
+
+        Notify(_T("channelchanged"), params);
+    }
+
+    void LinearPlaybackControl::streamstatuschangedNotify(const std::string &data) {
+        IDemuxer::StreamStatusType streamStatus;
+        if (DemuxerStreamFsFCC::parseStreamStatus(data, streamStatus) != IDemuxer::IO_STATUS::OK) {
+            syslog(LOG_ERR, "Failed to parse stream status: %s", data.c_str());
+            return;
+        }
+
+        JsonObject params;
+        params[_T("streamSourceLost")] = streamStatus.streamSourceLost;
+        params[_T("streamSourceLossCount")] = static_cast<uint64_t>(streamStatus.streamSourceLossCount);
+        params[_T("muxId")] = 0;
+
+        Notify(_T("streamstatuschanged"), params);
+    }
 } // namespace Plugin
 } // namespace WPEFramework
@@ -92,7 +92,7 @@ namespace WPEFramework {
             LOGINFOMETHOD();
 
             IARM_BUS_SYSMGR_KEYCodeLoggingInfo_Param_t param;
-            IARM_Result_t res = IARM_Bus_Call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_GetKeyCodeLoggingPref, (void *)&param, sizeof(param));
+            IARM_Result_t res = Utils::IARM::call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_GetKeyCodeLoggingPref, (void *)&param, sizeof(param));
             if(res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("IARM call failed with status %d while reading preferences", res);
@@ -108,7 +108,7 @@ namespace WPEFramework {
             returnIfBooleanParamNotFound(parameters, "keystrokeMaskEnabled");
 
             IARM_BUS_SYSMGR_KEYCodeLoggingInfo_Param_t params;
-            IARM_Result_t res = IARM_Bus_Call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_GetKeyCodeLoggingPref, (void *)&params, sizeof(params));
+            IARM_Result_t res = Utils::IARM::call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_GetKeyCodeLoggingPref, (void *)&params, sizeof(params));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("IARM call failed with status %d while reading preferences", res);
@@ -120,7 +120,7 @@ namespace WPEFramework {
             if (enabled == params.logStatus)
             {
                 params = { enabled ? 0 : 1 };
-                IARM_Result_t res = IARM_Bus_Call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_SetKeyCodeLoggingPref, (void *)&params, sizeof(params));
+                IARM_Result_t res = Utils::IARM::call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_SetKeyCodeLoggingPref, (void *)&params, sizeof(params));
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("IARM call failed with status %d while setting preferences", res);
@@ -68,7 +68,7 @@ using namespace std;
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 36
+#define API_VERSION_NUMBER_PATCH 38
 #define SERVER_DETAILS  "127.0.0.1:9998"
 
 
@@ -223,7 +223,24 @@ namespace WPEFramework {
             "/lib/rdk/Start_uploadSTBLogs.sh"
         };
 
-        vector<string> tasks;
+        /* Tasks of the current cycle, as indexes in task_names_foreground */
+        vector<uint8_t> tasks;
+
+        /* Dependency graph of the maintenance tasks, indexed as task_names_foreground.
+         * A task starts as soon as every task it depends on completed (successfully or not),
+         * tasks that do not depend on each other run in parallel. RFC goes first as the other
+         * two read their configuration from it. */
+        struct MaintenanceTaskInfo {
+            const char* name;
+            int completeBit;
+            uint8_t dependsOn;
+        };
+
+        static const MaintenanceTaskInfo kTaskInfo[MAINTENANCE_TASK_COUNT] = {
+            { "RFC", RFC_COMPLETE, 0 },
+            { "SWUPDATE", DIFD_COMPLETE, (1 << 0) },
+            { "LOGUPLOAD", LOGUPLOAD_COMPLETE, (1 << 0) }
+        };
 
         string script_names[]={
             "RFCbase.sh",
@@ -242,6 +259,7 @@ namespace WPEFramework {
          */
         MaintenanceManager::MaintenanceManager()
             :PluginHost::JSONRPC()
+            ,m_pluginMonitor(*this)
         {
             MaintenanceManager::_instance = this;
 	    if (Utils::directoryExists(MAINTENANCE_MGR_RECORD_FILE))
@@ -275,6 +293,7 @@ namespace WPEFramework {
             MaintenanceManager::m_task_map[task_names_foreground[0].c_str()]=false;
             MaintenanceManager::m_task_map[task_names_foreground[1].c_str()]=false;
             MaintenanceManager::m_task_map[task_names_foreground[2].c_str()]=false;
+            resetTaskTimings();
 
 #if defined(ENABLE_WHOAMI)
             MaintenanceManager::m_param_map[kDeviceInitContextKeyVals[0].c_str()] = TR181_PARTNER_ID;
@@ -289,7 +308,6 @@ namespace WPEFramework {
 
         void MaintenanceManager::task_execution_thread(){
             uint8_t i=0;
-            string cmd="";
             bool internetConnectStatus=false;
 	    bool delayMaintenanceStarted = false;
 
@@ -312,6 +330,7 @@ namespace WPEFramework {
             if(!tasks.empty()){
                 tasks.erase (tasks.begin(),tasks.end());
             }
+            resetTaskTimings();
 
             /* Controlled by CFLAGS */
 #if defined(SUPPRESS_MAINTENANCE) && !defined(ENABLE_WHOAMI)
@@ -389,37 +408,227 @@ namespace WPEFramework {
                     /* set the task status of swupdate */
                     SET_STATUS(g_task_status,DIFD_SUCCESS);
                     SET_STATUS(g_task_status,DIFD_COMPLETE);
+                    taskEnded(1, "skipped");
 
                     /* Add tasks */
-                    tasks.push_back(task_names_foreground[0].c_str());
-                    tasks.push_back(task_names_foreground[2].c_str());
+                    tasks.push_back(0);
+                    tasks.push_back(2);
 		}
 	    }
 #else
-            tasks.push_back(task_names_foreground[0].c_str());
-            tasks.push_back(task_names_foreground[1].c_str());
-            tasks.push_back(task_names_foreground[2].c_str());
+            tasks.push_back(0);
+            tasks.push_back(1);
+            tasks.push_back(2);
 #endif
+            uint8_t scheduled = 0;
+            uint8_t started = 0;
+            for (i = 0; i < tasks.size(); i++) {
+                scheduled |= (1 << tasks[i]);
+            }
+
             std::unique_lock<std::mutex> lck(m_callMutex);
-            for( i = 0; i < tasks.size() && !m_abort_flag; i++) {
-                cmd = tasks[i];
-                cmd += " &";
-                cmd += "\0";
-                m_task_map[tasks[i]] = true;
-
-                if ( !m_abort_flag ){
-                    LOGINFO("Starting Script (SM) :  %s \n",cmd.c_str());
-                    system(cmd.c_str());
-
-                    LOGINFO("Waiting to unlock.. [%d/%d]",i+1,(int)tasks.size());
-                    task_thread.wait(lck);
+            while (!m_abort_flag) {
+                uint8_t done = completedTasks() & scheduled;
+                if (done == scheduled) {
+                    break;
                 }
+
+                /* start everything whose dependencies are through */
+                for (i = 0; i < tasks.size() && !m_abort_flag; i++) {
+                    uint8_t task = tasks[i];
+                    if (!(started & (1 << task)) && !(kTaskInfo[task].dependsOn & scheduled & ~done)) {
+                        startMaintenanceTask(task);
+                        started |= (1 << task);
+                    }
+                }
+
+                LOGINFO("Waiting to unlock.. [%d/%d] completed", __builtin_popcount(done), (int)tasks.size());
+                /* completion events come from iarmEventHandler, the timeout only guards against a missed notification */
+                task_thread.wait_for(lck, std::chrono::seconds(TASK_WAIT_INTERVAL), [&]() {
+                    return m_abort_flag || ((completedTasks() & scheduled) != done);
+                });
             }
 
 	    m_abort_flag=false;
             LOGINFO("Worker Thread Completed");
         }
 
+        uint8_t MaintenanceManager::completedTasks()
+        {
+            uint8_t done = 0;
+            uint16_t status = g_task_status;
+            for (uint8_t i = 0; i < MAINTENANCE_TASK_COUNT; i++) {
+                if (CHECK_STATUS(status, kTaskInfo[i].completeBit)) {
+                    done |= (1 << i);
+                }
+            }
+            return done;
+        }
+
+        void MaintenanceManager::startMaintenanceTask(uint8_t index)
+        {
+            m_task_map[task_names_foreground[index]] = true;
+
+            m_timingMutex.lock();
+            m_task_timing[index].startTime = time(nullptr);
+            m_task_timing[index].start = std::chrono::steady_clock::now();
+            m_task_timing[index].duration = 0;
+            m_task_timing[index].status = "running";
+            m_timingMutex.unlock();
+
+            if (!startScript(task_names_foreground[index], isUserWatching())) {
+                taskFailedToStart(index);
+            }
+        }
+
+        /* A task whose script did not start never reports back. It is counted as failed so the tasks
+         * depending on it start and the cycle ends; when it was the last one nobody else ends the cycle. */
+        void MaintenanceManager::taskFailedToStart(uint8_t index)
+        {
+            m_statusMutex.lock();
+            LOGERR("%s task failed to start", kTaskInfo[index].name);
+            taskEnded(index, "error");
+            SET_STATUS(g_task_status, kTaskInfo[index].completeBit);
+            m_task_map[task_names_foreground[index]] = false;
+
+            if (!m_abort_flag && ((g_task_status & TASKS_COMPLETED) == TASKS_COMPLETED)) {
+                Maint_notify_status_t notify_status = cycleOutcome();
+                LOGINFO("ENDING MAINTENANCE CYCLE");
+                if (g_maintenance_type == UNSOLICITED_MAINTENANCE && !g_unsolicited_complete) {
+                    g_unsolicited_complete = true;
+                }
+                MaintenanceManager::_instance->onMaintenanceStatusChange(notify_status);
+            }
+            m_statusMutex.unlock();
+        }
+
+        /* Runs the task in the background, throttled if asked to. The task is "script [redirections]". */
+        bool MaintenanceManager::startScript(const string& task, bool throttle)
+        {
+            string script = task.substr(0, task.find(' '));
+            if (access(script.c_str(), X_OK) != 0) {
+                LOGERR("%s is not executable: %s", script.c_str(), strerror(errno));
+                return false;
+            }
+
+            string cmd = (throttle ? throttlePrefix() : string()) + task + " &";
+            LOGINFO("Starting Script (SM) :  %s \n",cmd.c_str());
+            int status = system(cmd.c_str());
+            if (status != 0) {
+                LOGERR("%s could not be started, status %d", script.c_str(), status);
+                return false;
+            }
+            return true;
+        }
+
+        /* While the user is watching, maintenance scripts get the lowest CPU priority and the idle IO class
+         * (and the maintenance cgroup when the platform provides one) so they do not disturb playback.
+         * A tool the platform does not ship is left out rather than failing the whole command. */
+        string MaintenanceManager::throttlePrefix()
+        {
+            string prefix;
+            if (Utils::fileExists(MAINTENANCE_CGROUP_PROCS)) {
+                prefix = "echo $$ > " MAINTENANCE_CGROUP_PROCS "; ";
+            }
+            if (isInPath("nice")) {
+                prefix += "nice -n 19 ";
+            }
+            if (isInPath("ionice")) {
+                prefix += "ionice -c 3 ";
+            }
+            return prefix;
+        }
+
+        bool MaintenanceManager::isInPath(const char* binary)
+        {
+            const char* path = getenv("PATH");
+            std::stringstream dirs((path != nullptr) ? path : "/usr/bin:/bin");
+            string dir;
+            while (std::getline(dirs, dir, ':')) {
+                if (!dir.empty() && (access((dir + "/" + binary).c_str(), X_OK) == 0)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool MaintenanceManager::isUserWatching()
+        {
+            bool watching = (BACKGROUND_MODE != g_currentMode);
+#if defined(USE_IARMBUS) || defined(USE_IARM_BUS)
+            IARM_Bus_PWRMgr_GetPowerState_Param_t param;
+            param.curState = IARM_BUS_PWRMGR_POWERSTATE_ON;
+            if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState, (void*)&param, sizeof(param))) {
+                watching = watching && (param.curState == IARM_BUS_PWRMGR_POWERSTATE_ON);
+            }
+#endif /* USE_IARMBUS || USE_IARM_BUS */
+            return watching;
+        }
+
+        /* Waits until a plugin gets activated, the device goes online or the timeout expires, whichever is first.
+         * Callers check their condition again afterwards. */
+        void MaintenanceManager::waitForReadiness(int seconds)
+        {
+            std::unique_lock<std::mutex> lock(m_readyMutex);
+            m_readyCondition.wait_for(lock, std::chrono::seconds(seconds));
+        }
+
+        void MaintenanceManager::onPluginActivated(const string& callsign)
+        {
+            if (callsign == "org.rdk.Network" || callsign == "org.rdk.SecManager" || callsign == "org.rdk.AuthService") {
+                LOGINFO("%s activated", callsign.c_str());
+                std::lock_guard<std::mutex> lock(m_readyMutex);
+                m_readyCondition.notify_all();
+            }
+        }
+
+        void MaintenanceManager::resetTaskTimings()
+        {
+            std::lock_guard<std::mutex> lock(m_timingMutex);
+            for (uint8_t i = 0; i < MAINTENANCE_TASK_COUNT; i++) {
+                m_task_timing[i].startTime = 0;
+                m_task_timing[i].duration = 0;
+                m_task_timing[i].status = "pending";
+            }
+        }
+
+        void MaintenanceManager::taskEnded(uint8_t index, const char* status)
+        {
+            std::lock_guard<std::mutex> lock(m_timingMutex);
+            if (m_task_timing[index].startTime != 0) {
+                m_task_timing[index].duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_task_timing[index].start).count();
+            }
+            m_task_timing[index].status = status;
+        }
+
+        /* Status of a cycle whose tasks all completed, a successful one is recorded as the last successful maintenance */
+        Maint_notify_status_t MaintenanceManager::cycleOutcome()
+        {
+            Maint_notify_status_t notify_status = MAINTENANCE_ERROR;
+            if ( (g_task_status & ALL_TASKS_SUCCESS) == ALL_TASKS_SUCCESS ){ // all tasks success
+                LOGINFO("DBG:Maintenance Successfully Completed!!");
+                notify_status=MAINTENANCE_COMPLETE;
+                /*  we store the time in persistant location */
+                time_t successfulTime=time(nullptr);
+                tm ltime=*localtime(&successfulTime);
+                time_t epoch_time=mktime(&ltime);
+                string str_successfulTime=to_string(epoch_time);
+                LOGINFO("last succesful time is :%s", str_successfulTime.c_str());
+                /* Remove any old completion time */
+                m_setting.remove("LastSuccessfulCompletionTime");
+                m_setting.setValue("LastSuccessfulCompletionTime",str_successfulTime);
+            }
+            /* Check other than all success case which means we have errors */
+            else if ((g_task_status & MAINTENANCE_TASK_SKIPPED ) == MAINTENANCE_TASK_SKIPPED ){
+                LOGINFO("DBG:There are Skipped Task. Maintenance Incomplete");
+                notify_status=MAINTENANCE_INCOMPLETE;
+            }
+            else {
+                LOGINFO("DBG:Maintenance Ended with Errors");
+            }
+            return notify_status;
+        }
+
 #if defined(ENABLE_WHOAMI)
         bool MaintenanceManager::knowWhoAmI(string &activation_status)
         {
@@ -465,8 +674,8 @@ namespace WPEFramework {
                 else {
                     g_subscribed_for_deviceContextUpdate = false;
                     if (activation_status != "activated") {
-                        LOGINFO("%s is not active. Retry after %d seconds", secMgr_callsign, SECMGR_RETRY_INTERVAL);
-                        sleep(SECMGR_RETRY_INTERVAL);
+                        LOGINFO("%s is not active. Retry on activation or after %d seconds", secMgr_callsign, SECMGR_RETRY_INTERVAL);
+                        waitForReadiness(SECMGR_RETRY_INTERVAL);
                     }
                     else {
 			LOGINFO("%s is not active. Device is already Activated. Hence exiting from knoWhoAmI()", secMgr_callsign);
@@ -589,6 +798,11 @@ namespace WPEFramework {
                         g_listen_to_nwevents = false;
                     }
                 }
+
+                if (state == INTERNET_CONNECTED_STATE) {
+                    std::lock_guard<std::mutex> lock(m_readyMutex);
+                    m_readyCondition.notify_all();
+                }
             }
         }
 
@@ -644,7 +858,7 @@ namespace WPEFramework {
                 //if plugin is not activated we need to retry
                 do{
                     if ((getServiceState(m_service, "org.rdk.AuthService", state) != Core::ERROR_NONE) || (state != PluginHost::IShell::state::ACTIVATED)) {
-                        sleep(10);
+                        waitForReadiness(AUTHSERVICE_RETRY_INTERVAL);
                         i++;
                         LOGINFO("AuthService retries [%d/4] \n",i);
                     }
@@ -772,7 +986,8 @@ namespace WPEFramework {
             if ((getServiceState(m_service, "org.rdk.Network", state) == Core::ERROR_NONE) && (state == PluginHost::IShell::state::ACTIVATED)) {
                 LOGINFO("Network plugin is active");
 
-                if (UNSOLICITED_MAINTENANCE == g_maintenance_type && !g_subscribed_for_nwevents) {
+                /* the event also wakes up isDeviceOnline(), so subscribe for solicited maintenance as well */
+                if (!g_subscribed_for_nwevents) {
                     // Subscribe for internetConnectionStatusChange event
                     bool subscribe_status = subscribeForInternetStatusEvent("onInternetStatusChange");
                     if (subscribe_status) {
@@ -835,8 +1050,8 @@ namespace WPEFramework {
 	    if (!network_available) {
                 int retry_count = 0;
 		while (retry_count < MAX_NETWORK_RETRIES) {
-                    LOGINFO("Network not available. Sleeping for %d seconds", NETWORK_RETRY_INTERVAL);
-                    sleep(NETWORK_RETRY_INTERVAL);
+                    LOGINFO("Network not available. Waiting up to %d seconds for it", NETWORK_RETRY_INTERVAL);
+                    waitForReadiness(NETWORK_RETRY_INTERVAL);
 		    LOGINFO("Network retries [%d/%d] \n", ++retry_count, MAX_NETWORK_RETRIES);
 		    network_available = checkNetwork();
                     if (network_available) {
@@ -932,6 +1147,7 @@ namespace WPEFramework {
 
             m_service = service;
             m_service->AddRef();
+            m_service->Register(&m_pluginMonitor);
 #if defined(ENABLE_WHOAMI)
             subscribeToDeviceInitializationEvent();
 #endif /* WhoAmI */
@@ -952,6 +1168,7 @@ namespace WPEFramework {
 
             ASSERT(service == m_service);
 
+            m_service->Unregister(&m_pluginMonitor);
             m_service->Release();
             m_service = nullptr;
         }
@@ -1025,8 +1242,6 @@ namespace WPEFramework {
             Maint_notify_status_t notify_status=MAINTENANCE_STARTED;
             IARM_Bus_MaintMGR_EventData_t *module_event_data=(IARM_Bus_MaintMGR_EventData_t*)data;
             IARM_Maint_module_status_t module_status;
-            time_t successfulTime;
-            string str_successfulTime="";
             auto task_status_RFC=m_task_map.find(task_names_foreground[0].c_str());
             auto task_status_FWDLD=m_task_map.find(task_names_foreground[1].c_str());
             auto task_status_LOGUPLD=m_task_map.find(task_names_foreground[2].c_str());
@@ -1047,6 +1262,7 @@ namespace WPEFramework {
                                  break;
                             }
                             else {
+                                 taskEnded(0, "success");
                                  SET_STATUS(g_task_status,RFC_SUCCESS);
                                  SET_STATUS(g_task_status,RFC_COMPLETE);
                                  task_thread.notify_one();
@@ -1059,6 +1275,7 @@ namespace WPEFramework {
                                  break;
                             }
                             else {
+                                taskEnded(1, "success");
                                 SET_STATUS(g_task_status,DIFD_SUCCESS);
                                 SET_STATUS(g_task_status,DIFD_COMPLETE);
                                 task_thread.notify_one();
@@ -1071,6 +1288,7 @@ namespace WPEFramework {
                                  break;
                             }
                             else {
+                                taskEnded(2, "success");
                                 SET_STATUS(g_task_status,LOGUPLOAD_SUCCESS);
                                 SET_STATUS(g_task_status,LOGUPLOAD_COMPLETE);
                                 task_thread.notify_one();
@@ -1087,6 +1305,7 @@ namespace WPEFramework {
                             break;
                         case MAINT_FWDOWNLOAD_ABORTED:
                             SET_STATUS(g_task_status,TASK_SKIPPED);
+                            taskEnded(1, "skipped");
                             /* we say FW update task complete */
                             SET_STATUS(g_task_status,DIFD_COMPLETE);
                             task_thread.notify_one();
@@ -1099,6 +1318,7 @@ namespace WPEFramework {
                                  break;
                             }
                             else {
+                                 taskEnded(0, "error");
                                  SET_STATUS(g_task_status,RFC_COMPLETE);
                                  task_thread.notify_one();
                                  LOGINFO("Error encountered in RFC script task \n");
@@ -1112,6 +1332,7 @@ namespace WPEFramework {
                                   break;
                             }
                             else {
+                                taskEnded(2, "error");
                                 SET_STATUS(g_task_status,LOGUPLOAD_COMPLETE);
                                 task_thread.notify_one();
                                 LOGINFO("Error encountered in LOGUPLOAD script task \n");
@@ -1125,6 +1346,7 @@ namespace WPEFramework {
                                  break;
                             }
                             else {
+                                taskEnded(1, "error");
                                 SET_STATUS(g_task_status,DIFD_COMPLETE);
                                 task_thread.notify_one();
                                 LOGINFO("Error encountered in SWUPDATE script task \n");
@@ -1160,32 +1382,7 @@ namespace WPEFramework {
                 /* Send the updated status only if all task completes execution
                  * until that we say maintenance started */
                 if ( (g_task_status & TASKS_COMPLETED ) == TASKS_COMPLETED ){
-                    if ( (g_task_status & ALL_TASKS_SUCCESS) == ALL_TASKS_SUCCESS ){ // all tasks success
-                        LOGINFO("DBG:Maintenance Successfully Completed!!");
-                        notify_status=MAINTENANCE_COMPLETE;
-                        /*  we store the time in persistant location */
-                        successfulTime=time(nullptr);
-                        tm ltime=*localtime(&successfulTime);
-                        time_t epoch_time=mktime(&ltime);
-                        str_successfulTime=to_string(epoch_time);
-                        LOGINFO("last succesful time is :%s", str_successfulTime.c_str());
-                        /* Remove any old completion time */
-                        m_setting.remove("LastSuccessfulCompletionTime");
-                        m_setting.setValue("LastSuccessfulCompletionTime",str_successfulTime);
-
-                    }
-                    /* Check other than all success case which means we have errors */
-                    else if ((g_task_status & ALL_TASKS_SUCCESS)!= ALL_TASKS_SUCCESS) {
-                        if ((g_task_status & MAINTENANCE_TASK_SKIPPED ) == MAINTENANCE_TASK_SKIPPED ){
-                            LOGINFO("DBG:There are Skipped Task. Maintenance Incomplete");
-                            notify_status=MAINTENANCE_INCOMPLETE;
-                        }
-                        else {
-                            LOGINFO("DBG:Maintenance Ended with Errors");
-                            notify_status=MAINTENANCE_ERROR;
-                        }
-
-                    }
+                    notify_status = cycleOutcome();
 
                     LOGINFO("ENDING MAINTENANCE CYCLE");
                     if(m_thread.joinable()){
@@ -1300,6 +1497,23 @@ namespace WPEFramework {
                     }
                     response["isCriticalMaintenance"] = b_criticalMaintenace;
                     response["isRebootPending"] = b_rebootPending;
+
+                    JsonArray taskTimings;
+                    m_timingMutex.lock();
+                    for (uint8_t i = 0; i < MAINTENANCE_TASK_COUNT; i++) {
+                        JsonObject timing;
+                        timing["task"] = kTaskInfo[i].name;
+                        timing["status"] = m_task_timing[i].status.empty() ? string("pending") : m_task_timing[i].status;
+                        timing["startTime"] = (int64_t)m_task_timing[i].startTime;
+                        if (m_task_timing[i].status == "running") {
+                            timing["duration"] = (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_task_timing[i].start).count();
+                        } else {
+                            timing["duration"] = m_task_timing[i].duration;
+                        }
+                        taskTimings.Add(timing);
+                    }
+                    m_timingMutex.unlock();
+                    response["tasks"] = taskTimings;
                     result = true;
 
                     returnResponse(result);
@@ -1644,9 +1858,9 @@ namespace WPEFramework {
 
                         if( k_ret == 0 ) {                                      // if task(s) was(were) killed successfully ...                    
                             m_task_map[task_names_foreground[i].c_str()]=false; // set it to false 
+                            taskEnded(i, "aborted");
                         }
-                        /* No need to loop again */
-                        break;
+                        /* independent tasks run in parallel, keep looking for other running ones */
                     }
                     else{
                         LOGINFO("Task[%d] is false \n",i);
@@ -1659,6 +1873,7 @@ namespace WPEFramework {
                 LOGERR("Failed to stopMaintenance without starting maintenance \n");
             }
             task_thread.notify_one();
+            m_readyCondition.notify_all();
 
             if(m_thread.joinable()){
                 m_thread.join();
@@ -23,6 +23,8 @@
 #include <stdint.h>
 #include <thread>
 #include <map>
+#include <chrono>
+#include <condition_variable>
 
 #include "Module.h"
 #include "tracing/Logging.h"
@@ -77,6 +79,12 @@ typedef enum{
 
 #define NETWORK_RETRY_INTERVAL          30
 #define SECMGR_RETRY_INTERVAL           5
+#define AUTHSERVICE_RETRY_INTERVAL      10
+#define TASK_WAIT_INTERVAL              30
+
+/* maintenance scripts are moved here, when it exists, while the user is watching */
+#define MAINTENANCE_CGROUP_PROCS        "/sys/fs/cgroup/maintenance/cgroup.procs"
+#define MAINTENANCE_TASK_COUNT          3
 
 #define RFC_SUCCESS                     0
 #define RFC_COMPLETE                    1
@@ -143,6 +151,60 @@ namespace WPEFramework {
                 std::condition_variable task_thread;
                 std::thread m_thread;
 
+                /* Timing of the tasks of the current or last maintenance cycle */
+                struct TaskTiming {
+                    time_t startTime;
+                    std::chrono::steady_clock::time_point start;
+                    uint32_t duration;
+                    string status;
+                };
+
+                class PluginStateMonitor : public PluginHost::IPlugin::INotification {
+                    public:
+                        PluginStateMonitor(const PluginStateMonitor&) = delete;
+                        PluginStateMonitor& operator=(const PluginStateMonitor&) = delete;
+
+                        explicit PluginStateMonitor(MaintenanceManager& parent)
+                            : _parent(parent)
+                        {
+                        }
+                        ~PluginStateMonitor() override = default;
+
+#ifdef USE_THUNDER_R4
+                        void Activated(const string& callsign, PluginHost::IShell*) override
+                        {
+                            _parent.onPluginActivated(callsign);
+                        }
+                        void Deactivated(const string&, PluginHost::IShell*) override
+                        {
+                        }
+                        void Unavailable(const string&, PluginHost::IShell*) override
+                        {
+                        }
+#else
+                        void StateChange(PluginHost::IShell* plugin) override
+                        {
+                            if (plugin->State() == PluginHost::IShell::ACTIVATED) {
+                                _parent.onPluginActivated(plugin->Callsign());
+                            }
+                        }
+#endif /* USE_THUNDER_R4 */
+
+                        BEGIN_INTERFACE_MAP(PluginStateMonitor)
+                        INTERFACE_ENTRY(PluginHost::IPlugin::INotification)
+                        END_INTERFACE_MAP
+
+                    private:
+                        MaintenanceManager& _parent;
+                };
+
+                std::mutex m_readyMutex;
+                std::condition_variable m_readyCondition;
+                Core::Sink<PluginStateMonitor> m_pluginMonitor;
+
+                std::mutex m_timingMutex;
+                TaskTiming m_task_timing[MAINTENANCE_TASK_COUNT];
+
                 std::map<string, bool> m_task_map;
                 std::map<string, string> m_param_map;
                 std::map<string, DATA_TYPE> m_paramType_map;
@@ -151,6 +213,17 @@ namespace WPEFramework {
 
                 bool isDeviceOnline();
                 void task_execution_thread();
+                void startMaintenanceTask(uint8_t index);
+                void taskFailedToStart(uint8_t index);
+                Maint_notify_status_t cycleOutcome();
+                uint8_t completedTasks();
+                static string throttlePrefix();
+                static bool isInPath(const char* binary);
+                bool isUserWatching();
+                void waitForReadiness(int seconds);
+                void onPluginActivated(const string& callsign);
+                void resetTaskTimings();
+                void taskEnded(uint8_t index, const char* status);
                 void requestSystemReboot();
                 void maintenanceManagerOnBootup();
                 bool checkAutoRebootFlag();
@@ -198,6 +271,7 @@ namespace WPEFramework {
                 static int runScript(const std::string& script,
                         const std::string& args, string *output = NULL,
                         string *error = NULL, int timeout = 30000);
+                static bool startScript(const string& task, bool throttle);
 
                 BEGIN_INTERFACE_MAP(MaintenanceManager)
                 INTERFACE_ENTRY(PluginHost::IPlugin)
@@ -169,7 +169,7 @@ namespace WPEFramework
 
 				IARM_CHECK( IARM_Bus_RegisterEventHandler(IARM_BUS_PWRMGR_NAME,IARM_BUS_PWRMGR_EVENT_MODECHANGED, pwrMgrModeChangeEventHandler) );
 				// get power state:
-				res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+				res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
 									IARM_BUS_PWRMGR_API_GetPowerState,
 									(void *)&param,
 									sizeof(param));
@@ -182,7 +182,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
                 char c;
                 uint32_t retry = 0;
                 do{
-                    retVal = IARM_Bus_Call_with_IPCTimeout(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_isAvailable, (void *)&c, sizeof(c), (1000*10));
+                    retVal = Utils::IARM::callWithIPCTimeout(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_isAvailable, (void *)&c, sizeof(c), (1000*10));
                     if(retVal != IARM_RESULT_SUCCESS){
                         LOGERR("NetSrvMgr is not available. Failed to activate Network Plugin, retry = %d", retry);
                         usleep(500*1000);
@@ -332,7 +332,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
             {
                 char c;
                 uint32_t retry = 0;
-                retVal = IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_isAvailable, (void *)&c, sizeof(c));
+                retVal = Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_isAvailable, (void *)&c, sizeof(c));
                 if(retVal != IARM_RESULT_SUCCESS){
                     LOGERR("threadEventRegistration: NetSrvMgr is not available. Failed to activate Network Plugin, retrying count = %d", retry);
                     usleep(500*1000);
@@ -372,7 +372,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
 
             if(m_isPluginInited)
             {
-                if (IARM_RESULT_SUCCESS == IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_getInterfaceList, (void*)&list, sizeof(list)))
+                if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_getInterfaceList, (void*)&list, sizeof(list)))
                 {
                     JsonArray networkInterfaces;
 
@@ -463,7 +463,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
                     iarmData.setInterface[sizeof(iarmData.setInterface) - 1] = '\0';
                     iarmData.persist = persist;
 
-                    if (IARM_RESULT_SUCCESS == IARM_Bus_Call (IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_setDefaultInterface, (void *)&iarmData, sizeof(iarmData)))
+                    if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_setDefaultInterface, (void *)&iarmData, sizeof(iarmData)))
                         result = true;
                     else
                         LOGWARN ("Call to %s for %s failed", IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_setDefaultInterface);
@@ -491,7 +491,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
                     response["ip"] = m_stbIpCache;
                     result = true;
                 }
-                else if (IARM_RESULT_SUCCESS == IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_getSTBip, (void*)&param, sizeof(param)))
+                else if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_getSTBip, (void*)&param, sizeof(param)))
                 {
                     response["ip"] = string(param.activeIfaceIpaddr, MAX_IP_ADDRESS_LEN - 1);
                     m_stbIpCache = string(param.activeIfaceIpaddr, MAX_IP_ADDRESS_LEN - 1);
@@ -576,7 +576,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
                     strncpy(param.setInterface, interface.c_str(), INTERFACE_SIZE);
                     param.setInterface[sizeof(param.setInterface) - 1] = '\0';
 
-                    if (IARM_RESULT_SUCCESS == IARM_Bus_Call (IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_isInterfaceEnabled, (void*)&param, sizeof(param)))
+                    if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_isInterfaceEnabled, (void*)&param, sizeof(param)))
                     {
                         LOGINFO("%s :: Enabled = %d ",__FUNCTION__,param.isInterfaceEnabled);
                         response["enabled"] = param.isInterfaceEnabled;
@@ -623,7 +623,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
                     iarmData.isInterfaceEnabled = enabled;
                     iarmData.persist = persist;
 
-                    if (IARM_RESULT_SUCCESS == IARM_Bus_Call (IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_setInterfaceEnabled, (void *)&iarmData, sizeof(iarmData)))
+                    if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_setInterfaceEnabled, (void *)&iarmData, sizeof(iarmData)))
                         result = true;
                     else
                         LOGWARN ("Call to %s for %s failed", IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_setInterfaceEnabled);
@@ -929,7 +929,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
                           }
                      }
                  }
-                 if (IARM_RESULT_SUCCESS == IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_setIPSettings, (void *) &iarmData, sizeof(iarmData)))
+                 if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_setIPSettings, (void *) &iarmData, sizeof(iarmData)))
                  {
                      response["supported"] = iarmData.isSupported;
                      result = true;
@@ -1042,7 +1042,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
            iarmData.interface[sizeof(iarmData.interface) - 1] = '\0';
            strncpy(iarmData.ipversion, ipversion.c_str(), 16);
            iarmData.ipversion[sizeof(iarmData.ipversion) - 1] = '\0';
-           if (IARM_RESULT_SUCCESS == IARM_Bus_Call (IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_getIPSettings, (void *)&iarmData, sizeof(iarmData)))
+           if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_getIPSettings, (void *)&iarmData, sizeof(iarmData)))
                 return true;
            return false;
         }
@@ -1342,7 +1342,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
                 getDefaultBoolParameter("disableConnectivityTest", disableConnTest, true);
                 pniConfig.disableConnectivityTest = disableConnTest;
 
-                if (IARM_RESULT_SUCCESS == IARM_Bus_Call (IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_configurePNI, (void *)&pniConfig, sizeof(pniConfig)))
+                if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_configurePNI, (void *)&pniConfig, sizeof(pniConfig)))
                 {
                     LOGINFO ("Configured PNI Successfully. PNI.disableConnectivityTest=%d", disableConnTest);
                     result = true;
@@ -1410,7 +1410,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
                 LOGWARN("getPublicIP called with server=%s port=%u iface=%s ipv6=%u sync=%u timeout=%u cache_timeout=%u\n", 
                         iarmData.server, iarmData.port, iarmData.interface, iarmData.ipv6, iarmData.sync, iarmData.bind_timeout, iarmData.cache_timeout);
 
-                if (IARM_RESULT_SUCCESS == IARM_Bus_Call (IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_getPublicIP, (void *)&iarmData, sizeof(iarmData)))
+                if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_getPublicIP, (void *)&iarmData, sizeof(iarmData)))
                 {
                     response["public_ip"] = string(iarmData.public_ip);
                     m_publicIPAddress = string(iarmData.public_ip);
@@ -1681,7 +1681,7 @@ typedef struct _IARM_BUS_NetSrvMgr_Iface_EventData_t {
                     LOGINFO("Identified as mediaclient device type");
 
                     IARM_BUS_NetSrvMgr_DefaultRoute_t defaultRoute = {0};
-                    if (IARM_RESULT_SUCCESS == IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_getDefaultInterface
+                    if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_getDefaultInterface
                                 , (void*)&defaultRoute, sizeof(defaultRoute)))
                     {
                         LOGWARN ("Call to %s for %s returned interface = %s, gateway = %s", IARM_BUS_NM_SRV_MGR_NAME
@@ -0,0 +1,161 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PackageDownloader.h"
+
+#include <curl/curl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+namespace WPEFramework {
+namespace Plugin {
+
+namespace {
+
+    constexpr long kConnectTimeoutSec = 30;
+    // Give up on a transfer that stalls below 1 byte/s for a minute; the next
+    // attempt continues where this one stopped.
+    constexpr long kLowSpeedLimit = 1;
+    constexpr long kLowSpeedTimeSec = 60;
+
+    uint64_t FileSize(const string& path)
+    {
+        struct stat info;
+        return (stat(path.c_str(), &info) == 0 ? static_cast<uint64_t>(info.st_size) : 0);
+    }
+
+    size_t Write(char* data, size_t size, size_t count, void* file)
+    {
+        return fwrite(data, size, count, static_cast<FILE*>(file));
+    }
+
+    int Progress(void* aborted, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+    {
+        return (*static_cast<const std::atomic<bool>*>(aborted) ? 1 : 0);
+    }
+
+}
+
+    PackageDownloader::PackageDownloader()
+        : _aborted(false)
+    {
+        curl_global_init(CURL_GLOBAL_ALL);
+    }
+
+    PackageDownloader::~PackageDownloader()
+    {
+        curl_global_cleanup();
+    }
+
+    void PackageDownloader::Abort()
+    {
+        _aborted = true;
+    }
+
+    uint32_t PackageDownloader::Fetch(const string& url, const string& location, uint64_t& resumedAt, uint64_t& received) const
+    {
+        const string partial(PartialLocation(location));
+
+        resumedAt = 0;
+        received = 0;
+
+        if (Core::File(location).Exists() == true) {
+            TRACE_L1("%s is already in the cache", location.c_str());
+            return (Core::ERROR_NONE);
+        }
+
+        resumedAt = FileSize(partial);
+        uint32_t result = Transfer(url, partial, resumedAt, received);
+
+        if (result == Core::ERROR_NOT_SUPPORTED) {
+            // Range not supported or the file changed on the server, start over.
+            TRACE(Trace::Information, (_T("[Packager]: Resuming %s at %llu failed, downloading from the start"), url.c_str(), static_cast<unsigned long long>(resumedAt)));
+            Core::File(partial).Destroy();
+            resumedAt = 0;
+            result = Transfer(url, partial, 0, received);
+        }
+
+        if (result == Core::ERROR_NONE) {
+            if (rename(partial.c_str(), location.c_str()) != 0) {
+                TRACE(Trace::Error, (_T("[Packager]: Failed to move %s into the cache"), partial.c_str()));
+                result = Core::ERROR_GENERAL;
+            }
+        }
+
+        return (result);
+    }
+
+    uint32_t PackageDownloader::Transfer(const string& url, const string& partial, uint64_t offset, uint64_t& received) const
+    {
+        if (_aborted == true) {
+            return (Core::ERROR_ABORTED);
+        }
+
+        FILE* file = fopen(partial.c_str(), (offset != 0 ? "ab" : "wb"));
+        if (file == nullptr) {
+            TRACE(Trace::Error, (_T("[Packager]: Cannot open %s"), partial.c_str()));
+            return (Core::ERROR_GENERAL);
+        }
+
+        CURL* curl = curl_easy_init();
+        if (curl == nullptr) {
+            fclose(file);
+            return (Core::ERROR_GENERAL);
+        }
+
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, Write);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, file);
+        curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(offset));
+        curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, kConnectTimeoutSec);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, kLowSpeedLimit);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, kLowSpeedTimeSec);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, Progress);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, const_cast<std::atomic<bool>*>(&_aborted));
+
+        CURLcode code = curl_easy_perform(curl);
+
+        curl_off_t downloaded = 0;
+        long response = 0;
+        curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &downloaded);
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response);
+        received += static_cast<uint64_t>(downloaded);
+
+        curl_easy_cleanup(curl);
+        fclose(file);
+
+        uint32_t result = Core::ERROR_NONE;
+        if (code == CURLE_ABORTED_BY_CALLBACK) {
+            result = Core::ERROR_ABORTED;
+        } else if ((offset != 0) && ((code == CURLE_RANGE_ERROR) || (response == 416))) {
+            result = Core::ERROR_NOT_SUPPORTED;
+        } else if (code != CURLE_OK) {
+            TRACE(Trace::Error, (_T("[Packager]: Download of %s failed: %s"), url.c_str(), curl_easy_strerror(code)));
+            result = Core::ERROR_GENERAL;
+        }
+
+        return (result);
+    }
+
+}  // namespace Plugin
+}  // namespace WPEFramework
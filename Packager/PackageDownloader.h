@@ -0,0 +1,61 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+#include <atomic>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Fetches package files into the opkg cache ahead of the install. Data is
+    // written to "<location>.part" first and only renamed to <location> when
+    // complete, so an interrupted download is continued with an HTTP range
+    // request on the next attempt instead of starting from scratch.
+    class PackageDownloader {
+    public:
+        PackageDownloader(const PackageDownloader&) = delete;
+        PackageDownloader& operator=(const PackageDownloader&) = delete;
+
+        PackageDownloader();
+        ~PackageDownloader();
+
+        // Returns ERROR_NONE when <location> is complete, ERROR_ABORTED after
+        // Abort() and ERROR_GENERAL on any other failure. resumedAt is the size
+        // of the partial file the transfer continued from.
+        uint32_t Fetch(const string& url, const string& location, uint64_t& resumedAt, uint64_t& received) const;
+
+        // Interrupts running and future fetches; partial files are kept.
+        void Abort();
+
+        static string PartialLocation(const string& location)
+        {
+            return (location + _T(".part"));
+        }
+
+    private:
+        uint32_t Transfer(const string& url, const string& partial, uint64_t offset, uint64_t& received) const;
+
+        std::atomic<bool> _aborted;
+    };
+
+}  // namespace Plugin
+}  // namespace WPEFramework
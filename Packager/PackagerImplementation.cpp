@@ -21,6 +21,7 @@
 
 #if defined (DO_NOT_USE_DEPRECATED_API)
 #include <opkg_cmd.h>
+#include <pkg_hash.h>
 #else
 #include <opkg.h>
 #endif
@@ -102,6 +103,14 @@ namespace Plugin {
              _volatileCache = config.MakeCacheVolatile.Value();
          }
 
+        if (config.ParallelDownloads.IsSet() == true) {
+            _parallelDownloads = config.ParallelDownloads.Value();
+        }
+
+        for (uint8_t index = 0; index < _parallelDownloads; index++) {
+            _downloaders.emplace_back(new DownloadThread(this));
+        }
+
         if (Core::File(_configFile).Exists() == false) {
             result = Core::ERROR_GENERAL;
         } else if (Core::Directory(_tempPath.c_str()).CreatePath() == false) {
@@ -121,6 +130,19 @@ namespace Plugin {
 
     PackagerImplementation::~PackagerImplementation()
     {
+        _downloader.Abort();
+
+        _adminLock.Lock();
+        _installQueue.clear();
+        for (auto& job : _downloadQueue) {
+            job->Fetched.SetEvent();
+        }
+        _downloadQueue.clear();
+        _adminLock.Unlock();
+
+        // Running transfers see the abort and return, partial files are kept for the next attempt.
+        _downloaders.clear();
+
         FreeOPKG();
         _servicePI->Release();
         _servicePI = nullptr;
@@ -136,6 +158,9 @@ namespace Plugin {
             ASSERT(_inProgress.Package != nullptr);
             notification->StateChange(_inProgress.Package, _inProgress.Install);
         }
+        for (auto& job : _installQueue) {
+            notification->StateChange(job->Package, job->Install);
+        }
         _adminLock.Unlock();
     }
 
@@ -163,9 +188,11 @@ namespace Plugin {
     uint32_t PackagerImplementation::DoWork(const string* name, const string* version, const string* arch)
     {
         uint32_t result = Core::ERROR_INPROGRESS;
+        const bool isInstall = (name && version && arch);
+        std::shared_ptr<InstallJob> job;
 
         _adminLock.Lock();
-        if (_inProgress.Install == nullptr && _isSyncing == false) {
+        if (_inProgress.Install == nullptr && _installQueue.empty() == true && _isSyncing == false) {
             ASSERT(_inProgress.Package == nullptr);
             result = Core::ERROR_NONE;
             // OPKG bug: it marks it checked dependency for a package as cyclic dependency handling fix
@@ -175,25 +202,195 @@ namespace Plugin {
             if (_opkgInitialized == true)  // it was initialized
                 FreeOPKG();
             _opkgInitialized = InitOPKG();
+            _opkgFresh = _opkgInitialized;
 
-            if (_opkgInitialized) {
-                if (name && version && arch) {
-                    _inProgress.Package = Core::Service<PackageInfo>::Create<PackageInfo>(*name, *version, *arch);
-                    _inProgress.Install = Core::Service<InstallInfo>::Create<InstallInfo>();
-                } else {
-                    _isSyncing = true;
-                }
-                _worker.Run();
-            } else {
+            if (_opkgInitialized == false) {
                 result = Core::ERROR_GENERAL;
             }
+        } else if (isInstall == true && _isSyncing == false && IsQueued(*name) == false) {
+            // Queued behind the installs already running, the worker re-initializes OPKG for it.
+            result = Core::ERROR_NONE;
+        }
+
+        if (result == Core::ERROR_NONE) {
+            if (isInstall == true) {
+                job = std::make_shared<InstallJob>(*name, *version, *arch);
+                _installQueue.push_back(job);
+            } else {
+                _isSyncing = true;
+            }
+            _worker.Run();
         }
         _adminLock.Unlock();
 
+        if (job) {
+            NotifyStateChange(job->Package, job->Install);
+        }
+
         return result;
 
     }
 
+    bool PackagerImplementation::IsQueued(const string& name) const
+    {
+        bool queued = (_inProgress.Package != nullptr && _inProgress.Package->Name() == name);
+        for (auto index = _installQueue.cbegin(); queued == false && index != _installQueue.cend(); ++index) {
+            queued = ((*index)->Package->Name() == name);
+        }
+        return queued;
+    }
+
+    bool PackagerImplementation::BlockingInstallNextNoLock()
+    {
+        _adminLock.Lock();
+        const bool pending = (_installQueue.empty() == false);
+        const bool fresh = _opkgFresh;
+        if (pending == true) {
+            _opkgFresh = false;
+        }
+        _adminLock.Unlock();
+
+        if (pending == false) {
+            return false;
+        }
+
+        // See DoWork() why every install needs a freshly initialized OPKG.
+        if (fresh == false) {
+            FreeOPKG();
+            _opkgInitialized = InitOPKG();
+        }
+
+        if (_opkgInitialized == true) {
+            ResolveDownloadsNoLock();
+        }
+
+        _adminLock.Lock();
+        if (_installQueue.empty() == true) {
+            _adminLock.Unlock();
+            return false;
+        }
+        std::shared_ptr<InstallJob> job(_installQueue.front());
+        _installQueue.pop_front();
+        ASSERT(_inProgress.Install == nullptr && _inProgress.Package == nullptr);
+        _inProgress.Package = job->Package;
+        _inProgress.Package->AddRef();
+        _inProgress.Install = job->Install;
+        _inProgress.Install->AddRef();
+        _adminLock.Unlock();
+
+        if (_opkgInitialized == false) {
+            _inProgress.Install->SetError(Core::ERROR_GENERAL);
+            NotifyStateChange();
+        } else {
+            // If the package file did not make it into the cache opkg downloads it itself.
+            job->Fetched.Lock();
+
+            const uint64_t installStart = Core::Time::Now().Ticks();
+            BlockingInstallUntilCompletionNoLock();
+            const uint64_t installEnd = Core::Time::Now().Ticks();
+
+            TRACE(Trace::Information, (_T("[Packager]: %s waited %llu ms, download took %llu ms (%llu bytes, resumed at %llu), install took %llu ms"),
+                job->Package->Name().c_str(),
+                static_cast<unsigned long long>((installStart - job->Queued) / Core::Time::TicksPerMillisecond),
+                static_cast<unsigned long long>((job->DownloadEnd - job->DownloadStart) / Core::Time::TicksPerMillisecond),
+                static_cast<unsigned long long>(job->Received),
+                static_cast<unsigned long long>(job->ResumedAt),
+                static_cast<unsigned long long>((installEnd - installStart) / Core::Time::TicksPerMillisecond)));
+        }
+
+        _adminLock.Lock();
+        _inProgress.Install->Release();
+        _inProgress.Package->Release();
+        _inProgress.Install = nullptr;
+        _inProgress.Package = nullptr;
+        _adminLock.Unlock();
+
+        return true;
+    }
+
+    void PackagerImplementation::ResolveDownloadsNoLock()
+    {
+        std::list<std::shared_ptr<InstallJob>> pending;
+
+        _adminLock.Lock();
+        for (auto& job : _installQueue) {
+            if (job->Resolved == false) {
+                job->Resolved = true;
+                pending.push_back(job);
+            }
+        }
+        _adminLock.Unlock();
+
+        for (auto& job : pending) {
+            if (_downloaders.empty() == true) {
+                job->Fetched.SetEvent();
+                continue;
+            }
+
+            const string& version = job->Package->Version();
+            const string& arch = job->Package->Architecture();
+#if defined (DO_NOT_USE_DEPRECATED_API)
+            pkg_t* pkg = pkg_hash_fetch_best_installation_candidate_by_name(job->Package->Name().c_str());
+#else
+            pkg_t* pkg = opkg_find_package(job->Package->Name().c_str(),
+                                           version.empty() == true ? nullptr : version.c_str(),
+                                           arch.empty() == true ? nullptr : arch.c_str(),
+                                           nullptr);
+#endif
+            if (pkg != nullptr && pkg->filename != nullptr && pkg->src != nullptr && pkg->src->value != nullptr) {
+                // With host_cache_dir set opkg looks for the package file by its base name in the cache.
+                const string filename(pkg->filename);
+                job->Url = string(pkg->src->value) + '/' + filename;
+                job->Location = string(opkg_config->cache_dir) + '/' + filename.substr(filename.find_last_of('/') + 1);
+
+                _adminLock.Lock();
+                _downloadQueue.push_back(job);
+                for (auto& thread : _downloaders) {
+                    thread->Run();
+                }
+                _adminLock.Unlock();
+            } else {
+                TRACE_L1("No feed location for %s, leaving the download to opkg", job->Package->Name().c_str());
+                job->Fetched.SetEvent();
+            }
+        }
+    }
+
+    std::shared_ptr<PackagerImplementation::InstallJob> PackagerImplementation::NextDownload(DownloadThread& thread)
+    {
+        std::shared_ptr<InstallJob> job;
+
+        _adminLock.Lock();
+        if (_downloadQueue.empty() == true) {
+            thread.Block();
+        } else {
+            job = _downloadQueue.front();
+            _downloadQueue.pop_front();
+        }
+        _adminLock.Unlock();
+
+        return job;
+    }
+
+    void PackagerImplementation::BlockingDownloadNoLock(InstallJob& job)
+    {
+        job.DownloadStart = Core::Time::Now().Ticks();
+        job.Install->SetState(Exchange::IPackager::DOWNLOADING);
+        NotifyStateChange(job.Package, job.Install);
+
+        uint32_t result = _downloader.Fetch(job.Url, job.Location, job.ResumedAt, job.Received);
+        job.DownloadEnd = Core::Time::Now().Ticks();
+
+        if (result == Core::ERROR_NONE) {
+            job.Install->SetState(Exchange::IPackager::DOWNLOADED);
+            NotifyStateChange(job.Package, job.Install);
+        } else {
+            TRACE(Trace::Information, (_T("[Packager]: Prefetching %s failed (%d), opkg will download it"), job.Package->Name().c_str(), result));
+        }
+
+        job.Fetched.SetEvent();
+    }
+
     void PackagerImplementation::BlockingInstallUntilCompletionNoLock() {
         ASSERT(_inProgress.Install != nullptr && _inProgress.Package != nullptr);
 
@@ -253,6 +450,9 @@ namespace Plugin {
                                                                         void* data)
     {
         PackagerImplementation* self = static_cast<PackagerImplementation*>(data);
+        // opkg calls back on the worker thread between the steps of the install, so packages queued
+        // meanwhile can be looked up here and start downloading before this install is done.
+        self->ResolveDownloadsNoLock();
         self->_inProgress.Install->SetProgress(progress->percentage);
         if (progress->action == OPKG_INSTALL &&
             self->_inProgress.Install->State() == Exchange::IPackager::DOWNLOADING) {
@@ -262,7 +462,9 @@ namespace Plugin {
         bool stateChanged = false;
         switch (progress->action) {
             case OPKG_DOWNLOAD:
-                if (self->_inProgress.Install->State() != Exchange::IPackager::DOWNLOADING) {
+                // DOWNLOADED already when the package file was prefetched into the cache.
+                if (self->_inProgress.Install->State() != Exchange::IPackager::DOWNLOADING &&
+                    self->_inProgress.Install->State() != Exchange::IPackager::DOWNLOADED) {
                     self->_inProgress.Install->SetState(Exchange::IPackager::DOWNLOADING);
                     stateChanged = true;
                 }
@@ -407,11 +609,16 @@ namespace Plugin {
     }
 
     void PackagerImplementation::NotifyStateChange()
+    {
+        NotifyStateChange(_inProgress.Package, _inProgress.Install);
+    }
+
+    void PackagerImplementation::NotifyStateChange(PackageInfo* package, InstallInfo* install)
     {
         _adminLock.Lock();
-        TRACE_L1("State for %s changed to %d (%d %%, %d)", _inProgress.Package->Name().c_str(), _inProgress.Install->State(), _inProgress.Install->Progress(), _inProgress.Install->ErrorCode());
+        TRACE_L1("State for %s changed to %d (%d %%, %d)", package->Name().c_str(), install->State(), install->Progress(), install->ErrorCode());
         for (auto* notification : _notifications) {
-            notification->StateChange(_inProgress.Package, _inProgress.Install);
+            notification->StateChange(package, install);
         }
         _adminLock.Unlock();
     }
@@ -20,9 +20,11 @@
 #pragma once
 
 #include "Module.h"
+#include "PackageDownloader.h"
 #include <interfaces/IPackager.h>
 
 #include <list>
+#include <memory>
 #include <string>
 
 // Forward declarations so we do not need to include the OPKG headers here.
@@ -48,6 +50,7 @@ namespace Plugin {
                 , NoDeps()
                 , NoSignatureCheck()
                 , AlwaysUpdateFirst()
+                , ParallelDownloads(3)          // Packages fetched ahead of the install, 0 leaves downloading to opkg
             {
                 Add(_T("config"), &ConfigFile);
                 Add(_T("temppath"), &TempDir);
@@ -57,6 +60,7 @@ namespace Plugin {
                 Add(_T("nodeps"), &NoDeps);
                 Add(_T("nosignaturecheck"), &NoSignatureCheck);
                 Add(_T("alwaysupdatefirst"), &AlwaysUpdateFirst);
+                Add(_T("paralleldownloads"), &ParallelDownloads);
             }
 
             ~Config() override
@@ -74,6 +78,7 @@ namespace Plugin {
             Core::JSON::Boolean NoDeps;
             Core::JSON::Boolean NoSignatureCheck;
             Core::JSON::Boolean AlwaysUpdateFirst;
+            Core::JSON::DecUInt8 ParallelDownloads;
         };
 
         PackagerImplementation()
@@ -87,6 +92,8 @@ namespace Plugin {
             , _alwaysUpdateFirst(false)
             , _volatileCache(false)
             , _opkgInitialized(false)
+            , _opkgFresh(false)
+            , _parallelDownloads(3)
             , _servicePI(nullptr)
             , _worker(this)
             , _isUpgrade(false)
@@ -259,6 +266,47 @@ namespace Plugin {
             InstallInfo* Install = nullptr;
         };
 
+        // One Install() request. Jobs are installed one at a time in the order they were requested, opkg is
+        // not reentrant, but their package files are fetched into the opkg cache by the download threads
+        // while an earlier job is still installing.
+        struct InstallJob {
+            InstallJob(const InstallJob& other) = delete;
+            InstallJob& operator=(const InstallJob& other) = delete;
+
+            InstallJob(const string& name, const string& version, const string& arch)
+                : Package(Core::Service<PackageInfo>::Create<PackageInfo>(name, version, arch))
+                , Install(Core::Service<InstallInfo>::Create<InstallInfo>())
+                , Url()
+                , Location()
+                , Resolved(false)
+                , Fetched(false, true)
+                , Queued(Core::Time::Now().Ticks())
+                , DownloadStart(0)
+                , DownloadEnd(0)
+                , ResumedAt(0)
+                , Received(0)
+            {
+            }
+
+            ~InstallJob()
+            {
+                Package->Release();
+                Install->Release();
+            }
+
+            PackageInfo* Package;
+            InstallInfo* Install;
+            string Url;
+            string Location;
+            bool Resolved;
+            Core::Event Fetched;    // Set when the download thread is done with the job, or when there is none
+            uint64_t Queued;
+            uint64_t DownloadStart;
+            uint64_t DownloadEnd;
+            uint64_t ResumedAt;
+            uint64_t Received;
+        };
+
         class InstallThread : public Core::Thread {
         public:
             InstallThread(PackagerImplementation* parent)
@@ -271,26 +319,47 @@ namespace Plugin {
             uint32_t Worker() override {
                 while(IsRunning() == true) {
                     _parent->_adminLock.Lock(); // The parent may have lock when this starts so wait for it to release.
-                    bool isInstall = _parent->_inProgress.Install != nullptr;
-                    ASSERT(isInstall != true || _parent->_inProgress.Package != nullptr);
+                    bool isInstall = _parent->_installQueue.empty() == false;
+                    bool isSync = _parent->_isSyncing;
                     _parent->_adminLock.Unlock();
 
-                    // After this point locking is not needed because API running on other threads only read if in
-                    // progress is filled in.
-                    _parent->BlockingSetupLocalRepoNoLock(isInstall == true ? RepoSyncMode::SETUP : RepoSyncMode::FORCED);
-                    if (isInstall)
-                        _parent->BlockingInstallUntilCompletionNoLock();
-
-                    if (isInstall) {
-                        _parent->_adminLock.Lock();
-                        _parent->_inProgress.Install->Release();
-                        _parent->_inProgress.Package->Release();
-                        _parent->_inProgress.Install = nullptr;
-                        _parent->_inProgress.Package = nullptr;
-                        _parent->_adminLock.Unlock();
+                    // After this point locking is only needed around the job queues, API running on other
+                    // threads only reads the job that is in progress.
+                    if (isInstall == true || isSync == true) {
+                        _parent->BlockingSetupLocalRepoNoLock(isInstall == true ? RepoSyncMode::SETUP : RepoSyncMode::FORCED);
+                        while (_parent->BlockingInstallNextNoLock() == true);
                     }
 
-                    Block();
+                    // Only block when nothing was queued meanwhile, Run() might have been called already.
+                    _parent->_adminLock.Lock();
+                    if (_parent->_installQueue.empty() == true && _parent->_isSyncing == false) {
+                        Block();
+                    }
+                    _parent->_adminLock.Unlock();
+                }
+
+                return Core::infinite;
+            }
+
+        private:
+            PackagerImplementation* _parent;
+        };
+
+        class DownloadThread : public Core::Thread {
+        public:
+            DownloadThread(PackagerImplementation* parent)
+                : _parent(parent)
+            {}
+
+            DownloadThread& operator=(const DownloadThread&) = delete;
+            DownloadThread(const DownloadThread&) = delete;
+
+            uint32_t Worker() override {
+                while(IsRunning() == true) {
+                    std::shared_ptr<InstallJob> job = _parent->NextDownload(*this);
+                    if (job) {
+                        _parent->BlockingDownloadNoLock(*job);
+                    }
                 }
 
                 return Core::infinite;
@@ -316,9 +385,15 @@ namespace Plugin {
         void DeactivatePlugin(const string& callsign, const string& appName);
         uint32_t UpdateConfiguration(const string& callsign, const string& appName);
         void NotifyStateChange();
+        void NotifyStateChange(PackageInfo* package, InstallInfo* install);
         void NotifyRepoSynced(uint32_t status);
+        bool IsQueued(const string& name) const;
+        bool BlockingInstallNextNoLock();
         void BlockingInstallUntilCompletionNoLock();
         void BlockingSetupLocalRepoNoLock(RepoSyncMode mode);
+        void ResolveDownloadsNoLock();
+        std::shared_ptr<InstallJob> NextDownload(DownloadThread& thread);
+        void BlockingDownloadNoLock(InstallJob& job);
         bool InitOPKG();
         void FreeOPKG();
 
@@ -332,9 +407,15 @@ namespace Plugin {
         bool _alwaysUpdateFirst;
         bool _volatileCache;
         bool _opkgInitialized;
+        bool _opkgFresh;            // OPKG was initialized by DoWork() for the next install, guarded by _adminLock
+        uint8_t _parallelDownloads;
         PluginHost::IShell* _servicePI;
         std::vector<Exchange::IPackager::INotification*> _notifications;
         InstallationData _inProgress;
+        std::list<std::shared_ptr<InstallJob>> _installQueue;
+        std::list<std::shared_ptr<InstallJob>> _downloadQueue;
+        PackageDownloader _downloader;
+        std::list<std::unique_ptr<DownloadThread>> _downloaders;
         InstallThread _worker;
         bool _isUpgrade;
         bool _isSyncing;
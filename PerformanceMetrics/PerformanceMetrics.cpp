@@ -26,7 +26,7 @@ namespace Plugin {
 
         static Metadata<PerformanceMetrics> metadata(
             // Version
-            1, 0, 0,
+            1, 1, 0,
             // Preconditions
             {},
             // Terminations
@@ -49,16 +49,17 @@ namespace Plugin {
             result = _T("Both callsign and classname set to observe for metrics");
         }
         else if( ( config.ObservableCallsign.IsSet() == true ) && ( config.ObservableCallsign.Value().empty() == false ) ) {
-            _handler.reset(new CallsignPerfMetricsHandler(config.ObservableCallsign.Value()));
+            _handler.reset(new CallsignPerfMetricsHandler(config.ObservableCallsign.Value(), _timeline));
         }
         else if( ( config.ObservableClassname.IsSet() == true ) && ( config.ObservableClassname.Value().empty() == false ) ) {
-            _handler.reset(new ClassnamePerfMetricsHandler(config.ObservableClassname.Value()));
+            _handler.reset(new ClassnamePerfMetricsHandler(config.ObservableClassname.Value(), _timeline));
         } else {
             result = _T("No callsign or classname set to observe for metrics");
         }
 
         if( result.empty() == true ) {
             ASSERT(_handler);
+            _timeline.Capacity(config.TimelineEvents.Value());
             _handler->Initialize();
             service->Register(&_notification);
         } else {
@@ -77,6 +78,7 @@ namespace Plugin {
             _handler->Deinitialize();
             _handler.reset();
         }
+        _timeline.Capacity(0);
     }
 
     string PerformanceMetrics::Information() const
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Module.h"
+#include "Timeline.h"
 #include <interfaces/IMemory.h>
 #include <interfaces/IBrowser.h>
 
@@ -28,7 +29,7 @@
 namespace WPEFramework {
 namespace Plugin {
 
-    class PerformanceMetrics : public PluginHost::IPlugin {
+    class PerformanceMetrics : public PluginHost::IPlugin, public PluginHost::JSONRPC {
 
     private:
         class Config : public Core::JSON::Container {
@@ -41,14 +42,17 @@ namespace Plugin {
                 : Core::JSON::Container()
                 , ObservableCallsign()
                 , ObservableClassname()
+                , TimelineEvents(1024)
             {
                 Add(_T("callsign"), &ObservableCallsign);
                 Add(_T("classname"), &ObservableClassname);
+                Add(_T("timeline"), &TimelineEvents);
             }
 
         public:
             Core::JSON::String ObservableCallsign;
             Core::JSON::String ObservableClassname;
+            Core::JSON::DecUInt32 TimelineEvents;
         };
 
         class Notification : public PluginHost::IPlugin::INotification {
@@ -149,9 +153,10 @@ namespace Plugin {
         class CallsignPerfMetricsHandler : public IPerfMetricsHandler
         {
         public:
-            CallsignPerfMetricsHandler(const string& callsign) 
+            CallsignPerfMetricsHandler(const string& callsign, Timeline& timeline) 
                 : IPerfMetricsHandler()
                 , _callsign(callsign)
+                , _timeline(timeline)
                 , _observable()
             {
             }
@@ -169,6 +174,11 @@ namespace Plugin {
                 return _callsign;
             }
 
+            Timeline& Events() const
+            {
+                return _timeline;
+            }
+
             void Initialize() override
             {
                 ASSERT(_observable.IsValid() == false);
@@ -212,15 +222,17 @@ namespace Plugin {
 
         private:
             string _callsign;
+            Timeline& _timeline;
             Core::ProxyType<IObservable> _observable;
         };
 
         class ClassnamePerfMetricsHandler : public IPerfMetricsHandler
         {
         public:
-            ClassnamePerfMetricsHandler(const string& classname) 
+            ClassnamePerfMetricsHandler(const string& classname, Timeline& timeline) 
                 : IPerfMetricsHandler()
                 , _classname(classname)
+                , _timeline(timeline)
                 , _observers()
                 , _adminLock()
             {
@@ -259,7 +271,7 @@ namespace Plugin {
                     _adminLock.Lock();
                     auto result =_observers.emplace(std::piecewise_construct,
                                        std::forward_as_tuple(service.Callsign()),
-                                       std::forward_as_tuple(service.Callsign()));
+                                       std::forward_as_tuple(service.Callsign(), _timeline));
                     ASSERT( ( result.second == true ) && ( result.first != _observers.end() ) );
                     result.first->second.Initialize();
                     result.first->second.Activated(service);
@@ -284,6 +296,7 @@ namespace Plugin {
             using OberserverMap = std::unordered_map<string, CallsignPerfMetricsHandler>;
 
             string _classname;
+            Timeline& _timeline;
             OberserverMap _observers;
             mutable Core::CriticalSection _adminLock;
         };
@@ -358,11 +371,13 @@ namespace Plugin {
             void Activated(PluginHost::IShell&) override
             { 
                 _activatetime = Core::Time::Now().Ticks();
+                Record(Timeline::ACTIVATED);
                 Logger().Activated();
             }
 
             void Deactivated(PluginHost::IShell&) override
             {
+                Record(Timeline::DEACTIVATED, string(), Uptime());
                 Logger().Deactivated( Uptime() );
             }
 
@@ -385,6 +400,12 @@ namespace Plugin {
                 return _service;
             }
 
+        protected:
+            void Record(const Timeline::event what, const string& URL = string(), const int32_t value = 0, const bool flag = false)
+            {
+                Parent().Events().Record(what, Parent().Callsign(), URL, value, flag);
+            }
+
         private: 
             CallsignPerfMetricsHandler& _parent;
             uint64_t _activatetime;
@@ -399,6 +420,7 @@ namespace Plugin {
         protected:
             // make Logger accessable here, so we don't have to put this-> in front of it everywhere
             using LoggerProxy<LOGGERINTERFACE>::Logger;
+            using Base::Record;
 
         public:
             StateObservable(const StateObservable&) = delete;
@@ -440,8 +462,10 @@ namespace Plugin {
             void StateChange(const PluginHost::IStateControl::state state) override 
             {
                 if( state == PluginHost::IStateControl::state::RESUMED ) {
+                    Record(Timeline::RESUMED);
                     Logger().Resumed();
                 } else if( state == PluginHost::IStateControl::state::SUSPENDED ) {
+                    Record(Timeline::SUSPENDED);
                     Logger().Suspended();
                 }
             }
@@ -472,6 +496,7 @@ namespace Plugin {
         protected:
             // make Logger accessable here, so we don't have to put this-> in front of it everywhere
             using LoggerProxy<LOGGERINTERFACE>::Logger;
+            using Base::Record;
 
         public:
             BrowserObservable(const BrowserObservable&) = delete;
@@ -523,18 +548,22 @@ namespace Plugin {
                 if( URL != IBrowserMetricsLogger::startURL ) {
                     ++_nbrloaded;
                 }
+                Record(Timeline::LOAD_FINISHED, URL, 0, true);
                 Logger().LoadFinished(URL, 0, true, _nbrloaded, 0);
             }
             void URLChanged(const string& URL) override
             {
+                Record(Timeline::URL_CHANGE, URL, 0, false);
                 Logger().URLChange(URL, false);
             }
             void Hidden(const bool hidden) override
             {
+                Record(Timeline::VISIBILITY, string(), 0, hidden);
                 Logger().VisibilityChange(hidden);
             }
             void Closure() override
             {
+                Record(Timeline::PAGE_CLOSURE);
                 Logger().PageClosure();
             }
 
@@ -551,6 +580,7 @@ namespace Plugin {
         protected:
             // make Logger accessable here, so we don't have to out this-> in front of it everywhere
             using LoggerProxy<LOGGERINTERFACE>::Logger;
+            using Base::Record;
         public:
             WebBrowserObservable(const WebBrowserObservable&) = delete;
             WebBrowserObservable& operator=(const WebBrowserObservable&) = delete;
@@ -604,6 +634,7 @@ namespace Plugin {
                 if( URL != IBrowserMetricsLogger::startURL ) {
                     ++_nbrloadedsuccess;
                 }
+                Record(Timeline::LOAD_FINISHED, URL, httpstatus, true);
                 Logger().LoadFinished(URL, httpstatus, true, _nbrloadedsuccess, _nbrloadedfailed);
             }
             void LoadFailed(const string& URL) override
@@ -611,18 +642,22 @@ namespace Plugin {
                 if( URL != IBrowserMetricsLogger::startURL ) {
                     ++_nbrloadedfailed;
                 }
+                Record(Timeline::LOAD_FINISHED, URL, 0, false);
                 Logger().LoadFinished(URL, 0, false, _nbrloadedsuccess, _nbrloadedfailed);
             }
             void URLChange(const string& URL, const bool loaded) override
             {
+                Record(Timeline::URL_CHANGE, URL, 0, loaded);
                 Logger().URLChange(URL, loaded);
             }
             void VisibilityChange(const bool hidden) override
             {
+                Record(Timeline::VISIBILITY, string(), 0, hidden);
                 Logger().VisibilityChange(hidden);
             }
             void PageClosure() override
             {
+                Record(Timeline::PAGE_CLOSURE);
                 Logger().PageClosure();
             }
             void BridgeQuery(const string&) override
@@ -640,18 +675,25 @@ namespace Plugin {
 PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
         PerformanceMetrics()
         : PluginHost::IPlugin()
+        , PluginHost::JSONRPC()
         , _notification(*this)
+        , _timeline(0)
         , _handler()
         {
+            RegisterAll();
         }
 POP_WARNING()
-        ~PerformanceMetrics() override = default;
+        ~PerformanceMetrics() override
+        {
+            UnregisterAll();
+        }
 
         PerformanceMetrics(const PerformanceMetrics&) = delete;
         PerformanceMetrics& operator=(const PerformanceMetrics&) = delete;
 
         BEGIN_INTERFACE_MAP(PerformanceMetrics)
         INTERFACE_ENTRY(PluginHost::IPlugin)
+        INTERFACE_ENTRY(PluginHost::IDispatcher)
         END_INTERFACE_MAP
 
     public:
@@ -681,8 +723,13 @@ POP_WARNING()
         void PluginActivated(PluginHost::IShell& service);
         void PluginDeactivated(PluginHost::IShell& service);
 
+        void RegisterAll();
+        void UnregisterAll();
+        uint32_t endpoint_timeline(const JsonObject& parameters, JsonObject& response);
+
     private:
         Core::Sink<Notification> _notification;
+        Timeline _timeline;
         std::unique_ptr<IPerfMetricsHandler> _handler;
     };
 
@@ -0,0 +1,83 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Module.h"
+#include "PerformanceMetrics.h"
+
+namespace WPEFramework {
+
+namespace Plugin {
+
+    // Registration
+    //
+
+    void PerformanceMetrics::RegisterAll()
+    {
+        Register<JsonObject, JsonObject>(_T("timeline"), &PerformanceMetrics::endpoint_timeline, this);
+    }
+
+    void PerformanceMetrics::UnregisterAll()
+    {
+        Unregister(_T("timeline"));
+    }
+
+    // API implementation
+    //
+
+    // Method: timeline - Returns the recorded lifecycle and browser events as a trace
+    // Return codes:
+    //  - ERROR_NONE: Success
+    //  - ERROR_BAD_REQUEST: Unknown format
+    //  - ERROR_UNAVAILABLE: The timeline is disabled
+    uint32_t PerformanceMetrics::endpoint_timeline(const JsonObject& parameters, JsonObject& response)
+    {
+        const string format = (parameters.HasLabel(_T("format")) == true ? parameters[_T("format")].String() : string(_T("chrome")));
+
+        if (_timeline.Capacity() == 0) {
+            return (Core::ERROR_UNAVAILABLE);
+        }
+
+        std::vector<Timeline::Event> events;
+        const uint32_t dropped = _timeline.Events(events);
+
+        string trace;
+        if (format == _T("chrome")) {
+            _timeline.ChromeTrace(trace);
+        } else if (format == _T("perfetto")) {
+            std::vector<uint8_t> data;
+            _timeline.Perfetto(data);
+            Core::ToString(data.data(), static_cast<uint32_t>(data.size()), true, trace);
+        } else {
+            return (Core::ERROR_BAD_REQUEST);
+        }
+
+        response[_T("format")] = format;
+        response[_T("events")] = static_cast<uint32_t>(events.size());
+        response[_T("dropped")] = dropped;
+        response[_T("trace")] = trace;
+
+        if ((parameters.HasLabel(_T("clear")) == true) && (parameters[_T("clear")].Boolean() == true)) {
+            _timeline.Clear();
+        }
+
+        return (Core::ERROR_NONE);
+    }
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -0,0 +1,411 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Timeline.h"
+
+#include <array>
+#include <map>
+#include <utility>
+
+#include <stdio.h>
+#include <time.h>
+
+namespace WPEFramework {
+namespace Plugin {
+
+namespace {
+
+    enum track : uint8_t {
+        LIFECYCLE,
+        STATE,
+        LOAD,
+        TRACKS
+    };
+
+    const char* trackNames[TRACKS] = { "lifecycle", "state", "load" };
+
+    void JsonString(string& result, const string& text)
+    {
+        result += '"';
+        for (const char c : text) {
+            switch (c) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                    result += escaped;
+                } else {
+                    result += c;
+                }
+                break;
+            }
+        }
+        result += '"';
+    }
+
+    // The few protobuf wire format pieces a Perfetto trace of track events needs.
+    void Varint(std::vector<uint8_t>& out, uint64_t value)
+    {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void Field(std::vector<uint8_t>& out, const uint32_t field, const uint64_t value)
+    {
+        Varint(out, (field << 3) | 0);
+        Varint(out, value);
+    }
+
+    void Field(std::vector<uint8_t>& out, const uint32_t field, const uint8_t data[], const size_t length)
+    {
+        Varint(out, (field << 3) | 2);
+        Varint(out, length);
+        out.insert(out.end(), data, data + length);
+    }
+
+    void Field(std::vector<uint8_t>& out, const uint32_t field, const string& text)
+    {
+        Field(out, field, reinterpret_cast<const uint8_t*>(text.data()), text.length());
+    }
+
+    void Field(std::vector<uint8_t>& out, const uint32_t field, const std::vector<uint8_t>& message)
+    {
+        Field(out, field, message.data(), message.size());
+    }
+
+    // Field numbers of perfetto/trace/trace_packet.proto and friends
+    constexpr uint32_t TRACE_PACKET = 1;
+    constexpr uint32_t PACKET_TIMESTAMP = 8;
+    constexpr uint32_t PACKET_SEQUENCE_ID = 10;
+    constexpr uint32_t PACKET_TRACK_EVENT = 11;
+    constexpr uint32_t PACKET_TRACK_DESCRIPTOR = 60;
+    constexpr uint32_t DESCRIPTOR_UUID = 1;
+    constexpr uint32_t DESCRIPTOR_NAME = 2;
+    constexpr uint32_t DESCRIPTOR_PARENT_UUID = 5;
+    constexpr uint32_t EVENT_DEBUG_ANNOTATION = 4;
+    constexpr uint32_t EVENT_TYPE = 9;
+    constexpr uint32_t EVENT_TRACK_UUID = 11;
+    constexpr uint32_t EVENT_CATEGORY = 22;
+    constexpr uint32_t EVENT_NAME = 23;
+    constexpr uint32_t ANNOTATION_STRING_VALUE = 6;
+    constexpr uint32_t ANNOTATION_NAME = 10;
+    constexpr uint64_t TYPE_SLICE_BEGIN = 1;
+    constexpr uint64_t TYPE_SLICE_END = 2;
+    constexpr uint64_t TYPE_INSTANT = 3;
+    constexpr uint64_t SEQUENCE_ID = 1;
+
+    uint64_t TrackUuid(const uint32_t process, const uint32_t which)
+    {
+        return ((static_cast<uint64_t>(process + 1) << 8) | which);
+    }
+}
+
+    // One begin ('B'), end ('E') or instant ('I') on a track of a plugin, balanced per track.
+    struct Timeline::Slice {
+        uint64_t timestamp;
+        uint32_t process;
+        uint8_t which;
+        char phase;
+        const char* name;
+        std::vector<std::pair<string, string>> args;
+    };
+
+    Timeline::Timeline(const uint32_t capacity)
+        : _adminLock()
+        , _events()
+        , _capacity(capacity)
+        , _head(0)
+        , _dropped(0)
+    {
+        _events.reserve(capacity);
+    }
+
+    void Timeline::Capacity(const uint32_t capacity)
+    {
+        _adminLock.Lock();
+        _capacity = capacity;
+        _events.clear();
+        _events.shrink_to_fit();
+        _events.reserve(capacity);
+        _head = 0;
+        _dropped = 0;
+        _adminLock.Unlock();
+    }
+
+    uint32_t Timeline::Capacity() const
+    {
+        _adminLock.Lock();
+        uint32_t result = _capacity;
+        _adminLock.Unlock();
+        return (result);
+    }
+
+    /* static */ uint64_t Timeline::Now()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_BOOTTIME, &now);
+        return ((static_cast<uint64_t>(now.tv_sec) * 1000000000ULL) + now.tv_nsec);
+    }
+
+    void Timeline::Record(const event what, const string& callsign, const string& url, const int32_t value, const bool flag)
+    {
+        Event entry;
+        entry.timestamp = Now();
+        entry.what = what;
+        entry.callsign = callsign;
+        entry.url = url;
+        entry.value = value;
+        entry.flag = flag;
+
+        _adminLock.Lock();
+        if (_capacity > 0) {
+            if (_events.size() < _capacity) {
+                _events.push_back(std::move(entry));
+            } else {
+                _events[_head] = std::move(entry);
+                _head = (_head + 1) % _capacity;
+                _dropped++;
+            }
+        }
+        _adminLock.Unlock();
+    }
+
+    void Timeline::Clear()
+    {
+        _adminLock.Lock();
+        _events.clear();
+        _head = 0;
+        _dropped = 0;
+        _adminLock.Unlock();
+    }
+
+    uint32_t Timeline::Events(std::vector<Event>& events) const
+    {
+        _adminLock.Lock();
+        events.reserve(events.size() + _events.size());
+        for (uint32_t index = 0; index < _events.size(); index++) {
+            events.push_back(_events[(_head + index) % _events.size()]);
+        }
+        uint32_t dropped = _dropped;
+        _adminLock.Unlock();
+        return (dropped);
+    }
+
+    void Timeline::Slices(std::vector<Slice>& slices, std::vector<string>& callsigns) const
+    {
+        std::vector<Event> events;
+        Events(events);
+
+        std::map<string, uint32_t> processes;
+        std::vector<std::array<bool, TRACKS>> open;
+
+        for (const Event& entry : events) {
+            auto process = processes.find(entry.callsign);
+            if (process == processes.end()) {
+                process = processes.emplace(entry.callsign, static_cast<uint32_t>(callsigns.size())).first;
+                callsigns.push_back(entry.callsign);
+                open.push_back({ { false, false, false } });
+            }
+
+            auto add = [&](const uint8_t which, const char phase, const char* name) -> Slice& {
+                slices.push_back({ entry.timestamp, process->second, which, phase, name, {} });
+                if (phase == 'B') {
+                    open[process->second][which] = true;
+                } else if (phase == 'E') {
+                    open[process->second][which] = false;
+                }
+                return (slices.back());
+            };
+            // an end without its begin (dropped from the ring, or never sent) becomes an instant
+            auto end = [&](const uint8_t which, const char* name, const char* instant) -> Slice& {
+                return (open[process->second][which] == true ? add(which, 'E', name) : add(which, 'I', instant));
+            };
+
+            switch (entry.what) {
+            case ACTIVATED:
+                if (open[process->second][LIFECYCLE] == true) {
+                    add(LIFECYCLE, 'E', "active");
+                }
+                add(LIFECYCLE, 'B', "active");
+                break;
+            case DEACTIVATED:
+                end(LIFECYCLE, "active", "deactivated").args.emplace_back("uptime", std::to_string(entry.value));
+                break;
+            case SUSPENDED:
+                if (open[process->second][STATE] == false) {
+                    add(STATE, 'B', "suspended");
+                }
+                break;
+            case RESUMED:
+                end(STATE, "suspended", "resumed");
+                break;
+            case URL_CHANGE:
+                if (entry.flag == false) {
+                    if (open[process->second][LOAD] == true) {
+                        add(LOAD, 'E', "load").args.emplace_back("url", "abandoned");
+                    }
+                    add(LOAD, 'B', "load").args.emplace_back("url", entry.url);
+                } else {
+                    add(LOAD, 'I', "url").args.emplace_back("url", entry.url);
+                }
+                break;
+            case LOAD_FINISHED: {
+                Slice& slice = end(LOAD, "load", "load finished");
+                slice.args.emplace_back("url", entry.url);
+                slice.args.emplace_back("success", (entry.flag == true ? "true" : "false"));
+                if (entry.value != 0) {
+                    slice.args.emplace_back("httpstatus", std::to_string(entry.value));
+                }
+                break;
+            }
+            case VISIBILITY:
+                add(STATE, 'I', (entry.flag == true ? "hidden" : "visible"));
+                break;
+            case PAGE_CLOSURE:
+                add(LOAD, 'I', "page closure");
+                break;
+            }
+        }
+    }
+
+    void Timeline::ChromeTrace(string& result) const
+    {
+        std::vector<Slice> slices;
+        std::vector<string> callsigns;
+        Slices(slices, callsigns);
+
+        _adminLock.Lock();
+        uint32_t dropped = _dropped;
+        _adminLock.Unlock();
+
+        char number[64];
+        bool first = true;
+        auto open = [&](const char* name, const char* phase, const uint32_t process, const uint32_t thread) {
+            result += (first == true ? "\n" : ",\n");
+            first = false;
+            result += "{\"name\":";
+            JsonString(result, name);
+            snprintf(number, sizeof(number), ",\"ph\":\"%s\",\"pid\":%u,\"tid\":%u", phase, process + 1, thread);
+            result += number;
+        };
+
+        result = "{\"traceEvents\":[";
+        for (uint32_t process = 0; process < callsigns.size(); process++) {
+            open("process_name", "M", process, 0);
+            result += ",\"args\":{\"name\":";
+            JsonString(result, callsigns[process]);
+            result += "}}";
+            for (uint8_t which = 0; which < TRACKS; which++) {
+                open("thread_name", "M", process, which + 1);
+                result += ",\"args\":{\"name\":";
+                JsonString(result, trackNames[which]);
+                result += "}}";
+            }
+        }
+        for (const Slice& slice : slices) {
+            const char phase[] = { slice.phase, '\0' };
+            open(slice.name, (slice.phase == 'I' ? "i" : phase), slice.process, slice.which + 1);
+            snprintf(number, sizeof(number), ",\"cat\":\"%s\",\"ts\":%llu.%03u",
+                trackNames[slice.which],
+                static_cast<unsigned long long>(slice.timestamp / 1000),
+                static_cast<uint32_t>(slice.timestamp % 1000));
+            result += number;
+            if (slice.phase == 'I') {
+                result += ",\"s\":\"t\"";
+            }
+            if (slice.args.empty() == false) {
+                result += ",\"args\":{";
+                for (uint32_t index = 0; index < slice.args.size(); index++) {
+                    if (index > 0) {
+                        result += ',';
+                    }
+                    JsonString(result, slice.args[index].first);
+                    result += ':';
+                    JsonString(result, slice.args[index].second);
+                }
+                result += '}';
+            }
+            result += '}';
+        }
+        snprintf(number, sizeof(number), "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":\"%u\"}}", dropped);
+        result += number;
+    }
+
+    void Timeline::Perfetto(std::vector<uint8_t>& result) const
+    {
+        std::vector<Slice> slices;
+        std::vector<string> callsigns;
+        Slices(slices, callsigns);
+
+        std::vector<uint8_t> packet;
+        std::vector<uint8_t> message;
+        auto emit = [&]() {
+            Field(packet, PACKET_SEQUENCE_ID, SEQUENCE_ID);
+            Field(result, TRACE_PACKET, packet);
+            packet.clear();
+        };
+
+        result.clear();
+        for (uint32_t process = 0; process < callsigns.size(); process++) {
+            message.clear();
+            Field(message, DESCRIPTOR_UUID, TrackUuid(process, 0));
+            Field(message, DESCRIPTOR_NAME, callsigns[process]);
+            Field(packet, PACKET_TRACK_DESCRIPTOR, message);
+            emit();
+            for (uint8_t which = 0; which < TRACKS; which++) {
+                message.clear();
+                Field(message, DESCRIPTOR_UUID, TrackUuid(process, which + 1));
+                Field(message, DESCRIPTOR_PARENT_UUID, TrackUuid(process, 0));
+                Field(message, DESCRIPTOR_NAME, string(trackNames[which]));
+                Field(packet, PACKET_TRACK_DESCRIPTOR, message);
+                emit();
+            }
+        }
+
+        std::vector<uint8_t> annotation;
+        for (const Slice& slice : slices) {
+            message.clear();
+            Field(message, EVENT_TYPE, (slice.phase == 'B' ? TYPE_SLICE_BEGIN : (slice.phase == 'E' ? TYPE_SLICE_END : TYPE_INSTANT)));
+            Field(message, EVENT_TRACK_UUID, TrackUuid(slice.process, slice.which + 1));
+            if (slice.phase != 'E') {
+                Field(message, EVENT_CATEGORY, string(trackNames[slice.which]));
+                Field(message, EVENT_NAME, string(slice.name));
+            }
+            for (const auto& arg : slice.args) {
+                annotation.clear();
+                Field(annotation, ANNOTATION_NAME, arg.first);
+                Field(annotation, ANNOTATION_STRING_VALUE, arg.second);
+                Field(message, EVENT_DEBUG_ANNOTATION, annotation);
+            }
+            Field(packet, PACKET_TIMESTAMP, slice.timestamp);
+            Field(packet, PACKET_TRACK_EVENT, message);
+            emit();
+        }
+    }
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -0,0 +1,90 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+#include <vector>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // The lifecycle and browser events of the observed plugins, with CLOCK_BOOTTIME timestamps, in a ring
+    // of a fixed number of events; when it is full the oldest event makes room. The ring can be exported
+    // as Chrome trace JSON or as a Perfetto protobuf trace, with one track per plugin and kind of slice
+    // (active, suspended, page load) so launch and load regressions can be looked at on a timeline.
+    class Timeline {
+    public:
+        enum event : uint8_t {
+            ACTIVATED,
+            DEACTIVATED,
+            RESUMED,
+            SUSPENDED,
+            URL_CHANGE,
+            LOAD_FINISHED,
+            VISIBILITY,
+            PAGE_CLOSURE
+        };
+
+        struct Event {
+            uint64_t timestamp; // ns
+            event what;
+            string callsign;
+            string url;
+            int32_t value; // DEACTIVATED: uptime in s, LOAD_FINISHED: HTTP status
+            bool flag; // URL_CHANGE: loaded, LOAD_FINISHED: success, VISIBILITY: hidden
+        };
+
+        Timeline(const Timeline&) = delete;
+        Timeline& operator=(const Timeline&) = delete;
+
+        explicit Timeline(const uint32_t capacity);
+        ~Timeline() = default;
+
+    public:
+        // 0 disables the recording, the events recorded so far are dropped.
+        void Capacity(const uint32_t capacity);
+        uint32_t Capacity() const;
+
+        void Record(const event what, const string& callsign, const string& url = string(), const int32_t value = 0, const bool flag = false);
+        void Clear();
+
+        // Oldest first, returns how many events were dropped since the last Clear because the ring was full.
+        uint32_t Events(std::vector<Event>& events) const;
+
+        void ChromeTrace(string& result) const;
+        void Perfetto(std::vector<uint8_t>& result) const;
+
+        static uint64_t Now();
+
+    private:
+        struct Slice;
+        void Slices(std::vector<Slice>& slices, std::vector<string>& callsigns) const;
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        std::vector<Event> _events;
+        uint32_t _capacity;
+        uint32_t _head; // index of the oldest event once the ring is full
+        uint32_t _dropped;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -0,0 +1,246 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "../Timeline.h"
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::MatchesRegex;
+using ::testing::Test;
+using ::WPEFramework::Plugin::Timeline;
+
+namespace {
+
+std::vector<string> Urls(const Timeline& timeline, uint32_t& dropped)
+{
+    std::vector<Timeline::Event> events;
+    dropped = timeline.Events(events);
+    std::vector<string> urls;
+    for (const Timeline::Event& event : events) {
+        urls.push_back(event.url);
+    }
+    return urls;
+}
+
+std::vector<string> Lines(const string& text)
+{
+    std::vector<string> lines;
+    std::istringstream stream(text);
+    string line;
+    while (std::getline(stream, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// The protobuf wire format as far as the Perfetto export uses it: varints and length delimited fields.
+struct Field {
+    uint32_t number;
+    uint64_t value;
+    string bytes;
+};
+
+uint64_t Varint(const string& data, size_t& offset)
+{
+    uint64_t value = 0;
+    uint32_t shift = 0;
+    while (offset < data.size()) {
+        const uint8_t byte = static_cast<uint8_t>(data[offset++]);
+        value |= (static_cast<uint64_t>(byte & 0x7F) << shift);
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+        shift += 7;
+    }
+    return value;
+}
+
+std::vector<Field> Fields(const string& data)
+{
+    std::vector<Field> fields;
+    size_t offset = 0;
+    while (offset < data.size()) {
+        const uint64_t key = Varint(data, offset);
+        Field field = { static_cast<uint32_t>(key >> 3), 0, string() };
+        if ((key & 0x07) == 0) {
+            field.value = Varint(data, offset);
+        } else {
+            EXPECT_THAT(key & 0x07, Eq(2u));
+            const uint64_t length = Varint(data, offset);
+            field.bytes = data.substr(offset, length);
+            offset += length;
+        }
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+const Field* Find(const std::vector<Field>& fields, const uint32_t number)
+{
+    for (const Field& field : fields) {
+        if (field.number == number) {
+            return &field;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST(ATimeline, KeepsTheNewestEventsWhenFull)
+{
+    Timeline timeline(3);
+    uint32_t dropped;
+
+    for (int i = 1; i <= 5; i++) {
+        timeline.Record(Timeline::URL_CHANGE, "WebKitBrowser", std::to_string(i), 0, true);
+    }
+    EXPECT_THAT(Urls(timeline, dropped), ElementsAre("3", "4", "5"));
+    EXPECT_THAT(dropped, Eq(2u));
+
+    // Around the ring once more
+    for (int i = 6; i <= 9; i++) {
+        timeline.Record(Timeline::URL_CHANGE, "WebKitBrowser", std::to_string(i), 0, true);
+    }
+    EXPECT_THAT(Urls(timeline, dropped), ElementsAre("7", "8", "9"));
+    EXPECT_THAT(dropped, Eq(6u));
+
+    timeline.Clear();
+    EXPECT_THAT(Urls(timeline, dropped), ElementsAre());
+    EXPECT_THAT(dropped, Eq(0u));
+    timeline.Record(Timeline::URL_CHANGE, "WebKitBrowser", "10", 0, true);
+    EXPECT_THAT(Urls(timeline, dropped), ElementsAre("10"));
+}
+
+TEST(ATimeline, DropsTheEventsWhenTheCapacityChanges)
+{
+    Timeline timeline(2);
+    uint32_t dropped;
+
+    timeline.Record(Timeline::URL_CHANGE, "WebKitBrowser", "1", 0, true);
+    timeline.Record(Timeline::URL_CHANGE, "WebKitBrowser", "2", 0, true);
+    timeline.Record(Timeline::URL_CHANGE, "WebKitBrowser", "3", 0, true);
+
+    timeline.Capacity(0);
+    timeline.Record(Timeline::URL_CHANGE, "WebKitBrowser", "4", 0, true);
+    EXPECT_THAT(Urls(timeline, dropped), ElementsAre());
+    EXPECT_THAT(dropped, Eq(0u));
+
+    timeline.Capacity(4);
+    EXPECT_THAT(timeline.Capacity(), Eq(4u));
+    timeline.Record(Timeline::URL_CHANGE, "WebKitBrowser", "5", 0, true);
+    EXPECT_THAT(Urls(timeline, dropped), ElementsAre("5"));
+}
+
+TEST(ATimeline, ExportsBalancedChromeTraceSlices)
+{
+    Timeline timeline(16);
+    timeline.Record(Timeline::ACTIVATED, "WebKitBrowser");
+    timeline.Record(Timeline::URL_CHANGE, "WebKitBrowser", "http://example.com/\"a\"", 0, false);
+    timeline.Record(Timeline::LOAD_FINISHED, "WebKitBrowser", "http://example.com/\"a\"", 200, true);
+    timeline.Record(Timeline::SUSPENDED, "WebKitBrowser");
+    timeline.Record(Timeline::VISIBILITY, "Cobalt", string(), 0, true);
+    timeline.Record(Timeline::RESUMED, "WebKitBrowser");
+    timeline.Record(Timeline::DEACTIVATED, "WebKitBrowser", string(), 42);
+
+    string trace;
+    timeline.ChromeTrace(trace);
+    const std::vector<string> lines = Lines(trace);
+
+    const string ts = ",\"ts\":[0-9]+\\.[0-9]{3}";
+    ASSERT_THAT(lines.size(), Eq(17u));
+    EXPECT_THAT(lines[0], Eq("{\"traceEvents\":["));
+    EXPECT_THAT(lines[1], Eq("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"WebKitBrowser\"}},"));
+    EXPECT_THAT(lines[2], Eq("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"lifecycle\"}},"));
+    EXPECT_THAT(lines[3], Eq("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"state\"}},"));
+    EXPECT_THAT(lines[4], Eq("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":3,\"args\":{\"name\":\"load\"}},"));
+    EXPECT_THAT(lines[5], Eq("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"tid\":0,\"args\":{\"name\":\"Cobalt\"}},"));
+    EXPECT_THAT(lines[9], MatchesRegex("\\{\"name\":\"active\",\"ph\":\"B\",\"pid\":1,\"tid\":1,\"cat\":\"lifecycle\"" + ts + "\\},"));
+    EXPECT_THAT(lines[10], MatchesRegex("\\{\"name\":\"load\",\"ph\":\"B\",\"pid\":1,\"tid\":3,\"cat\":\"load\"" + ts
+        + ",\"args\":\\{\"url\":\"http://example.com/\\\\\"a\\\\\"\"\\}\\},"));
+    EXPECT_THAT(lines[11], MatchesRegex("\\{\"name\":\"load\",\"ph\":\"E\",\"pid\":1,\"tid\":3,\"cat\":\"load\"" + ts
+        + ",\"args\":\\{\"url\":\"http://example.com/\\\\\"a\\\\\"\",\"success\":\"true\",\"httpstatus\":\"200\"\\}\\},"));
+    EXPECT_THAT(lines[12], MatchesRegex("\\{\"name\":\"suspended\",\"ph\":\"B\",\"pid\":1,\"tid\":2,\"cat\":\"state\"" + ts + "\\},"));
+    EXPECT_THAT(lines[13], MatchesRegex("\\{\"name\":\"hidden\",\"ph\":\"i\",\"pid\":2,\"tid\":2,\"cat\":\"state\"" + ts + ",\"s\":\"t\"\\},"));
+    EXPECT_THAT(lines[14], MatchesRegex("\\{\"name\":\"suspended\",\"ph\":\"E\",\"pid\":1,\"tid\":2,\"cat\":\"state\"" + ts + "\\},"));
+    EXPECT_THAT(lines[15], MatchesRegex("\\{\"name\":\"active\",\"ph\":\"E\",\"pid\":1,\"tid\":1,\"cat\":\"lifecycle\"" + ts
+        + ",\"args\":\\{\"uptime\":\"42\"\\}\\}"));
+    EXPECT_THAT(lines[16], Eq("],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":\"0\"}}"));
+}
+
+TEST(ATimeline, ExportsEndsWithoutBeginsAsInstants)
+{
+    Timeline timeline(2);
+    timeline.Record(Timeline::ACTIVATED, "WebKitBrowser");
+    timeline.Record(Timeline::SUSPENDED, "WebKitBrowser");
+    timeline.Record(Timeline::RESUMED, "WebKitBrowser");
+    timeline.Record(Timeline::DEACTIVATED, "WebKitBrowser", string(), 7);
+
+    string trace;
+    timeline.ChromeTrace(trace);
+    const std::vector<string> lines = Lines(trace);
+
+    const string ts = ",\"ts\":[0-9]+\\.[0-9]{3}";
+    ASSERT_THAT(lines.size(), Eq(8u));
+    EXPECT_THAT(lines[5], MatchesRegex("\\{\"name\":\"resumed\",\"ph\":\"i\",\"pid\":1,\"tid\":2,\"cat\":\"state\"" + ts + ",\"s\":\"t\"\\},"));
+    EXPECT_THAT(lines[6], MatchesRegex("\\{\"name\":\"deactivated\",\"ph\":\"i\",\"pid\":1,\"tid\":1,\"cat\":\"lifecycle\"" + ts
+        + ",\"s\":\"t\",\"args\":\\{\"uptime\":\"7\"\\}\\}"));
+    EXPECT_THAT(lines[7], Eq("],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":\"2\"}}"));
+}
+
+TEST(ATimeline, ExportsPerfettoTrackEvents)
+{
+    Timeline timeline(16);
+    timeline.Record(Timeline::ACTIVATED, "WebKitBrowser");
+    timeline.Record(Timeline::URL_CHANGE, "WebKitBrowser", "http://example.com", 0, true);
+    timeline.Record(Timeline::DEACTIVATED, "WebKitBrowser", string(), 3);
+
+    std::vector<uint8_t> data;
+    timeline.Perfetto(data);
+    const std::vector<Field> packets = Fields(string(data.begin(), data.end()));
+
+    // A descriptor for the plugin and one per track, then one packet per slice
+    ASSERT_THAT(packets.size(), Eq(7u));
+    std::vector<std::vector<Field>> fields;
+    for (const Field& packet : packets) {
+        EXPECT_THAT(packet.number, Eq(1u));
+        fields.push_back(Fields(packet.bytes));
+        ASSERT_THAT(Find(fields.back(), 10), ::testing::NotNull());
+        EXPECT_THAT(Find(fields.back(), 10)->value, Eq(1u));
+    }
+
+    ASSERT_THAT(Find(fields[0], 60), ::testing::NotNull());
+    const std::vector<Field> process = Fields(Find(fields[0], 60)->bytes);
+    EXPECT_THAT(Find(process, 1)->value, Eq(0x100u));
+    EXPECT_THAT(Find(process, 2)->bytes, Eq("WebKitBrowser"));
+
+    ASSERT_THAT(Find(fields[3], 60), ::testing::NotNull());
+    const std::vector<Field> load = Fields(Find(fields[3], 60)->bytes);
+    EXPECT_THAT(Find(load, 1)->value, Eq(0x103u));
+    EXPECT_THAT(Find(load, 5)->value, Eq(0x100u));
+    EXPECT_THAT(Find(load, 2)->bytes, Eq("load"));
+
+    ASSERT_THAT(Find(fields[4], 8), ::testing::NotNull());
+    ASSERT_THAT(Find(fields[4], 11), ::testing::NotNull());
+    const std::vector<Field> begin = Fields(Find(fields[4], 11)->bytes);
+    EXPECT_THAT(Find(begin, 9)->value, Eq(1u));
+    EXPECT_THAT(Find(begin, 11)->value, Eq(0x101u));
+    EXPECT_THAT(Find(begin, 22)->bytes, Eq("lifecycle"));
+    EXPECT_THAT(Find(begin, 23)->bytes, Eq("active"));
+
+    const std::vector<Field> instant = Fields(Find(fields[5], 11)->bytes);
+    EXPECT_THAT(Find(instant, 9)->value, Eq(3u));
+    EXPECT_THAT(Find(instant, 11)->value, Eq(0x103u));
+    ASSERT_THAT(Find(instant, 4), ::testing::NotNull());
+    const std::vector<Field> annotation = Fields(Find(instant, 4)->bytes);
+    EXPECT_THAT(Find(annotation, 10)->bytes, Eq("url"));
+    EXPECT_THAT(Find(annotation, 6)->bytes, Eq("http://example.com"));
+
+    const std::vector<Field> end = Fields(Find(fields[6], 11)->bytes);
+    EXPECT_THAT(Find(end, 9)->value, Eq(2u));
+    EXPECT_THAT(Find(end, 11)->value, Eq(0x101u));
+    EXPECT_THAT(Find(end, 23), ::testing::IsNull());
+    EXPECT_THAT(Find(fields[4], 8)->value, ::testing::Le(Find(fields[6], 8)->value));
+}
@@ -0,0 +1,393 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "MemoryPressureManager.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <poll.h>
+#include <sstream>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "UtilsLogging.h"
+
+namespace WPEFramework {
+namespace Plugin {
+
+namespace {
+
+    // Wake up early once some tasks stalled on memory for 150 ms within one second.
+    const char kTrigger[] = "some 150000 1000000";
+
+    // The avg10 figures need about ten seconds to show the effect of an action, acting again before
+    // that would take out more applications than the pressure asks for.
+    constexpr uint32_t kDefaultCooldown = 10000;
+
+    constexpr size_t kMaxDecisions = 32;
+
+    const char* kActionNames[] = { "none", "suspend", "hibernate", "kill" };
+
+    uint64_t now()
+    {
+        return (std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+}
+
+    MemoryPressureManager::MemoryPressureManager(IApplications& applications, const string& source)
+        : _applications(applications)
+        , _source(source)
+        , _controlLock()
+        , _adminLock()
+        , _policy(DefaultPolicy())
+        , _current()
+        , _lastForeground()
+        , _hibernated()
+        , _lastAction(0)
+        , _decisions()
+        , _wakeup(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        , _stop(false)
+        , _thread()
+    {
+    }
+
+    MemoryPressureManager::~MemoryPressureManager()
+    {
+        Stop();
+        if (_wakeup >= 0) {
+            close(_wakeup);
+        }
+    }
+
+    /* static */ MemoryPressureManager::Policy MemoryPressureManager::DefaultPolicy()
+    {
+        Policy policy;
+        policy.enabled = false;
+        policy.dryRun = false;
+        policy.hibernation = false;
+        policy.interval = 1000;
+        policy.cooldown = kDefaultCooldown;
+        policy.suspendThreshold = 10;
+        policy.hibernateThreshold = 25;
+        policy.killThreshold = 10;
+        return (policy);
+    }
+
+    void MemoryPressureManager::Configure(const Policy& policy)
+    {
+        std::lock_guard<std::mutex> control(_controlLock);
+
+        _adminLock.lock();
+        _policy = policy;
+        _adminLock.unlock();
+
+        if ((policy.enabled == true) && (_thread.joinable() == false)) {
+            Start();
+        } else if ((policy.enabled == false) && (_thread.joinable() == true)) {
+            Stop();
+        } else if (_wakeup >= 0) {
+            // Pick up the new interval right away.
+            uint64_t one = 1;
+            if (write(_wakeup, &one, sizeof(one)) < 0) {
+                LOGWARN("memory pressure wakeup failed: %s", strerror(errno));
+            }
+        }
+    }
+
+    MemoryPressureManager::Policy MemoryPressureManager::Configuration() const
+    {
+        std::lock_guard<std::mutex> lock(_adminLock);
+        return (_policy);
+    }
+
+    MemoryPressureManager::Pressure MemoryPressureManager::Current() const
+    {
+        std::lock_guard<std::mutex> lock(_adminLock);
+        return (_current);
+    }
+
+    void MemoryPressureManager::Decisions(std::vector<Decision>& decisions) const
+    {
+        std::lock_guard<std::mutex> lock(_adminLock);
+        decisions.assign(_decisions.begin(), _decisions.end());
+    }
+
+    /* static */ bool MemoryPressureManager::Parse(const string& text, Pressure& pressure)
+    {
+        // some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+        // full avg10=0.00 avg60=0.00 avg300=0.00 total=0
+        bool some = false;
+        bool full = false;
+        std::istringstream lines(text);
+        string line;
+
+        pressure.someAvg10 = 0;
+        pressure.fullAvg10 = 0;
+
+        while (std::getline(lines, line)) {
+            double avg10 = 0;
+            if (sscanf(line.c_str(), "some avg10=%lf", &avg10) == 1) {
+                pressure.someAvg10 = avg10;
+                some = true;
+            } else if (sscanf(line.c_str(), "full avg10=%lf", &avg10) == 1) {
+                pressure.fullAvg10 = avg10;
+                full = true;
+            }
+        }
+
+        // Kernels before 5.13 have no full line for the whole system, some is all there is then.
+        pressure.valid = some;
+        if ((some == true) && (full == false)) {
+            pressure.fullAvg10 = 0;
+        }
+
+        return (pressure.valid);
+    }
+
+    /* static */ const char* MemoryPressureManager::ActionName(const action what)
+    {
+        return (kActionNames[what]);
+    }
+
+    bool MemoryPressureManager::Evaluate(const Pressure& pressure, std::vector<Application>& applications, const uint64_t when, Decision& decision)
+    {
+        Policy policy;
+        std::map<string, uint64_t> lastForeground;
+        uint64_t lastAction;
+
+        _adminLock.lock();
+        for (const Application& application : applications) {
+            auto known = _lastForeground.find(application.callsign);
+            // An application seen for the first time counts as just used.
+            lastForeground[application.callsign] = (((application.foreground == true) || (known == _lastForeground.end())) ? when : known->second);
+            if (application.foreground == true) {
+                _hibernated.erase(application.callsign);
+            }
+        }
+        _lastForeground = lastForeground;
+        for (auto it = _hibernated.begin(); it != _hibernated.end();) {
+            it = (lastForeground.find(*it) == lastForeground.end() ? _hibernated.erase(it) : std::next(it));
+        }
+        std::set<string> hibernated(_hibernated);
+        policy = _policy;
+        lastAction = _lastAction;
+        _adminLock.unlock();
+
+        action what = NONE;
+        if ((pressure.valid == true) && (pressure.fullAvg10 >= policy.killThreshold)) {
+            what = KILL;
+        } else if ((pressure.valid == true) && (pressure.someAvg10 >= policy.hibernateThreshold)) {
+            what = HIBERNATE;
+        } else if ((pressure.valid == true) && (pressure.someAvg10 >= policy.suspendThreshold)) {
+            what = SUSPEND;
+        }
+
+        if ((what == NONE) || ((lastAction != 0) && ((when - lastAction) < policy.cooldown))) {
+            return (false);
+        }
+
+        // Hibernated applications hold next to nothing in RAM, taking them out does not help.
+        std::vector<Application*> candidates;
+        for (Application& application : applications) {
+            if ((application.foreground == false)
+                && (policy.protectedApps.find(application.callsign) == policy.protectedApps.end())
+                && (hibernated.find(application.callsign) == hibernated.end())) {
+                _applications.Inspect(application);
+                candidates.push_back(&application);
+            }
+        }
+
+        if (what == HIBERNATE) {
+            // Only suspended applications are hibernated; without any, suspending one is the next best thing.
+            bool suspended = std::any_of(candidates.begin(), candidates.end(), [](const Application* application) { return (application->suspended); });
+            if (suspended == false) {
+                what = SUSPEND;
+            } else if (policy.hibernation == false) {
+                what = KILL;
+                candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [](const Application* application) { return (application->suspended == false); }), candidates.end());
+            }
+        }
+
+        const Application* selected = nullptr;
+        double best = 0;
+        for (const Application* application : candidates) {
+            if (((what == SUSPEND) && (application->suspended == true)) || ((what == HIBERNATE) && (application->suspended == false))) {
+                continue;
+            }
+            const uint64_t idle = when - lastForeground[application->callsign];
+            const double score = ((idle / 1000.0) + 1) * std::max(application->residentKb / 1024.0, 1.0);
+            if ((selected == nullptr) || (score > best)) {
+                selected = application;
+                best = score;
+            }
+        }
+
+        if (selected == nullptr) {
+            return (false);
+        }
+
+        decision.timestamp = when;
+        decision.callsign = selected->callsign;
+        decision.what = what;
+        decision.residentKb = selected->residentKb;
+        decision.idleMs = when - lastForeground[selected->callsign];
+        decision.someAvg10 = pressure.someAvg10;
+        decision.fullAvg10 = pressure.fullAvg10;
+        decision.executed = false;
+
+        _adminLock.lock();
+        _lastAction = when;
+        _adminLock.unlock();
+
+        return (true);
+    }
+
+    void MemoryPressureManager::Start()
+    {
+        _stop = false;
+        _thread = std::thread(&MemoryPressureManager::Run, this);
+    }
+
+    void MemoryPressureManager::Stop()
+    {
+        if (_thread.joinable() == true) {
+            _stop = true;
+            uint64_t one = 1;
+            if (write(_wakeup, &one, sizeof(one)) < 0) {
+                LOGWARN("memory pressure wakeup failed: %s", strerror(errno));
+            }
+            _thread.join();
+        }
+    }
+
+    bool MemoryPressureManager::Read(Pressure& pressure) const
+    {
+        std::ifstream file(_source);
+        if (file.is_open() == false) {
+            return (false);
+        }
+        std::stringstream content;
+        content << file.rdbuf();
+        return (Parse(content.str(), pressure));
+    }
+
+    void MemoryPressureManager::Record(const Decision& decision)
+    {
+        _adminLock.lock();
+        _decisions.push_back(decision);
+        if (_decisions.size() > kMaxDecisions) {
+            _decisions.pop_front();
+        }
+        if ((decision.executed == true) && (decision.what == HIBERNATE)) {
+            _hibernated.insert(decision.callsign);
+        }
+        _adminLock.unlock();
+
+        _applications.Decided(decision);
+    }
+
+    void MemoryPressureManager::Run()
+    {
+        // A PSI trigger needs write access to the file, without it the interval alone drives the sampling.
+        int trigger = open(_source.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if ((trigger >= 0) && (write(trigger, kTrigger, sizeof(kTrigger)) < 0)) {
+            LOGWARN("no PSI trigger on %s: %s", _source.c_str(), strerror(errno));
+            close(trigger);
+            trigger = -1;
+        }
+
+        bool reported = false;
+
+        while (_stop == false) {
+            _adminLock.lock();
+            const int interval = static_cast<int>(_policy.interval);
+            _adminLock.unlock();
+
+            struct pollfd fds[2];
+            fds[0].fd = _wakeup;
+            fds[0].events = POLLIN;
+            fds[0].revents = 0;
+            fds[1].fd = trigger;
+            fds[1].events = POLLPRI;
+            fds[1].revents = 0;
+
+            if (poll(fds, (trigger >= 0 ? 2 : 1), interval) < 0) {
+                if (errno != EINTR) {
+                    LOGERR("memory pressure poll failed: %s", strerror(errno));
+                    break;
+                }
+                continue;
+            }
+            if ((fds[0].revents & POLLIN) != 0) {
+                uint64_t value;
+                if (read(_wakeup, &value, sizeof(value)) < 0) {
+                    LOGWARN("memory pressure wakeup read failed: %s", strerror(errno));
+                }
+            }
+            if (_stop == true) {
+                break;
+            }
+            if ((trigger >= 0) && ((fds[1].revents & POLLERR) != 0)) {
+                close(trigger);
+                trigger = -1;
+            }
+
+            Pressure pressure;
+            if (Read(pressure) == false) {
+                if (reported == false) {
+                    LOGERR("no memory pressure information in %s", _source.c_str());
+                    reported = true;
+                }
+                continue;
+            }
+
+            _adminLock.lock();
+            _current = pressure;
+            const bool dryRun = _policy.dryRun;
+            _adminLock.unlock();
+
+            std::vector<Application> applications;
+            _applications.Applications(applications);
+
+            Decision decision;
+            if (Evaluate(pressure, applications, now(), decision) == true) {
+                if (dryRun == false) {
+                    decision.executed = _applications.Apply(decision.callsign, decision.what);
+                }
+                LOGINFO("memory pressure some %.2f full %.2f: %s %s (%llu kB, idle %llu ms)%s", decision.someAvg10, decision.fullAvg10,
+                    ActionName(decision.what), decision.callsign.c_str(), static_cast<unsigned long long>(decision.residentKb),
+                    static_cast<unsigned long long>(decision.idleMs), (dryRun ? " [dry run]" : (decision.executed ? "" : " [failed]")));
+                Record(decision);
+            }
+        }
+
+        if (trigger >= 0) {
+            close(trigger);
+        }
+    }
+
+} // namespace Plugin
+} // namespace WPEFramework
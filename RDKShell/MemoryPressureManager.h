@@ -0,0 +1,141 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Frees memory before the kernel OOM killer has to. The memory pressure stall information of the
+    // kernel (PSI, /proc/pressure/memory) is sampled every interval, and sooner when a PSI trigger fires;
+    // while it is above a threshold one background application per cooldown is suspended, hibernated or
+    // killed, depending on how high the pressure is. Candidates are ranked by how long ago they were in
+    // the foreground times how much resident memory they hold, so the least recently used expensive
+    // application goes first. In dry run mode the decisions are only logged and reported.
+    class MemoryPressureManager {
+    public:
+        enum action {
+            NONE,
+            SUSPEND,
+            HIBERNATE,
+            KILL
+        };
+
+        struct Application {
+            string callsign;
+            bool foreground; // focused or visible
+            bool suspended;
+            uint64_t residentKb; // 0 when not known
+        };
+
+        struct Pressure {
+            bool valid;
+            double someAvg10; // % of time some tasks stalled on memory
+            double fullAvg10; // % of time all non idle tasks stalled on memory
+        };
+
+        struct Policy {
+            bool enabled;
+            bool dryRun;
+            bool hibernation; // hibernate is available, otherwise that level kills suspended applications
+            uint32_t interval; // ms
+            uint32_t cooldown; // ms after an action before the next one
+            double suspendThreshold; // some avg10
+            double hibernateThreshold; // some avg10
+            double killThreshold; // full avg10
+            std::set<string> protectedApps;
+        };
+
+        struct Decision {
+            uint64_t timestamp; // ms since the epoch
+            string callsign;
+            action what;
+            uint64_t residentKb;
+            uint64_t idleMs;
+            double someAvg10;
+            double fullAvg10;
+            bool executed;
+        };
+
+        struct IApplications {
+            virtual ~IApplications() = default;
+
+            // Cheap, called every interval: the applications with only callsign and foreground filled in.
+            virtual void Applications(std::vector<Application>& applications) = 0;
+            // Called for the candidates once the pressure asks for an action: fills suspended and residentKb.
+            virtual void Inspect(Application& application) = 0;
+            virtual bool Apply(const string& callsign, const action what) = 0;
+            virtual void Decided(const Decision& decision) = 0;
+        };
+
+        MemoryPressureManager(const MemoryPressureManager&) = delete;
+        MemoryPressureManager& operator=(const MemoryPressureManager&) = delete;
+
+        MemoryPressureManager(IApplications& applications, const string& source = _T("/proc/pressure/memory"));
+        ~MemoryPressureManager();
+
+        static Policy DefaultPolicy();
+
+        // Starts or stops the monitoring as the policy says.
+        void Configure(const Policy& policy);
+        Policy Configuration() const;
+        Pressure Current() const;
+        void Decisions(std::vector<Decision>& decisions) const;
+
+        static bool Parse(const string& text, Pressure& pressure);
+        static const char* ActionName(const action what);
+
+        // One evaluation at the time when (ms), true with the decision filled in when an application has to go.
+        bool Evaluate(const Pressure& pressure, std::vector<Application>& applications, const uint64_t when, Decision& decision);
+
+    private:
+        void Start();
+        void Stop();
+        void Run();
+        bool Read(Pressure& pressure) const;
+        void Record(const Decision& decision);
+
+    private:
+        IApplications& _applications;
+        const string _source;
+        std::mutex _controlLock;
+        mutable std::mutex _adminLock;
+        Policy _policy;
+        Pressure _current;
+        std::map<string, uint64_t> _lastForeground;
+        std::set<string> _hibernated;
+        uint64_t _lastAction;
+        std::deque<Decision> _decisions;
+        int _wakeup;
+        std::atomic<bool> _stop;
+        std::thread _thread;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
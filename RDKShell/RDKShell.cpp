@@ -21,6 +21,7 @@
 #include "RDKShell.h"
 #include <string>
 #include <memory>
+#include <algorithm>
 #include <iostream>
 #include <mutex>
 #include <thread>
@@ -53,7 +54,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 6
-#define API_VERSION_NUMBER_PATCH 3
+#define API_VERSION_NUMBER_PATCH 5
 
 const string WPEFramework::Plugin::RDKShell::SERVICE_NAME = "org.rdk.RDKShell";
 //methods
@@ -144,6 +145,8 @@ const string WPEFramework::Plugin::RDKShell::RDKSHELL_METHOD_KEY_REPEAT_CONFIG =
 const string WPEFramework::Plugin::RDKShell::RDKSHELL_METHOD_GET_GRAPHICS_FRAME_RATE = "getGraphicsFrameRate";
 const string WPEFramework::Plugin::RDKShell::RDKSHELL_METHOD_SET_GRAPHICS_FRAME_RATE = "setGraphicsFrameRate";
 const string WPEFramework::Plugin::RDKShell::RDKSHELL_METHOD_SET_KEY_INTERCEPTS = "setKeyIntercepts";
+const string WPEFramework::Plugin::RDKShell::RDKSHELL_METHOD_SET_MEMORY_PRESSURE_POLICY = "setMemoryPressurePolicy";
+const string WPEFramework::Plugin::RDKShell::RDKSHELL_METHOD_GET_MEMORY_PRESSURE_STATUS = "getMemoryPressureStatus";
 #ifdef HIBERNATE_SUPPORT_ENABLED
 const string WPEFramework::Plugin::RDKShell::RDKSHELL_METHOD_HIBERNATE = "hibernate";
 const string WPEFramework::Plugin::RDKShell::RDKSHELL_METHOD_RESTORE = "restore";
@@ -170,6 +173,7 @@ const string WPEFramework::Plugin::RDKShell::RDKSHELL_EVENT_DEVICE_CRITICALLY_LO
 const string WPEFramework::Plugin::RDKShell::RDKSHELL_EVENT_ON_EASTER_EGG = "onEasterEgg";
 const string WPEFramework::Plugin::RDKShell::RDKSHELL_EVENT_ON_WILL_DESTROY = "onWillDestroy";
 const string WPEFramework::Plugin::RDKShell::RDKSHELL_EVENT_ON_SCREENSHOT_COMPLETE = "onScreenshotComplete";
+const string WPEFramework::Plugin::RDKShell::RDKSHELL_EVENT_ON_MEMORY_PRESSURE_ACTION = "onMemoryPressureAction";
 #ifdef HIBERNATE_SUPPORT_ENABLED
 const string WPEFramework::Plugin::RDKShell::RDKSHELL_EVENT_ON_HIBERNATED = "onHibernated";
 const string WPEFramework::Plugin::RDKShell::RDKSHELL_EVENT_ON_RESTORED = "onRestored";
@@ -228,6 +232,8 @@ std::mutex gLaunchedToSuspendedMutex;
 #define THUNDER_ACCESS_DEFAULT_VALUE "127.0.0.1:9998"
 #define RDKSHELL_WILLDESTROY_EVENT_WAITTIME 1
 #define RDKSHELL_TRY_LOCK_WAIT_TIME_IN_MS 250
+#define RDKSHELL_WARM_POOL_FILL_DELAY_MS 10000
+#define RDKSHELL_WARM_POOL_REFILL_DELAY_MS 2000
 
 static std::string gThunderAccessValue = THUNDER_ACCESS_DEFAULT_VALUE;
 static uint32_t gWillDestroyEventWaitTime = RDKSHELL_WILLDESTROY_EVENT_WAITTIME;
@@ -739,6 +745,105 @@ namespace WPEFramework {
           }
         };
 
+        // Phases of the launches in progress in milliseconds, a phase that did not run stays negative.
+        // They go out with onLaunched, the time to the first frame with onApplicationFirstFrame (and with
+        // onLaunched as well when the frame came first); the entry is dropped once both were sent.
+        struct LaunchTimings
+        {
+            double mStart { 0 };
+            double mClone { -1 };
+            double mConfig { -1 };
+            double mActivate { -1 };
+            double mFirstFrame { -1 };
+            bool mPrewarmed { false };
+            bool mLaunched { false };
+        };
+
+        std::map<std::string, LaunchTimings> gLaunchTimings;
+        std::mutex gLaunchTimingsMutex;
+
+        static void startLaunchTimings(const std::string& client, bool prewarmed)
+        {
+            std::lock_guard<std::mutex> lock(gLaunchTimingsMutex);
+            LaunchTimings timings;
+            timings.mStart = RdkShell::milliseconds();
+            timings.mPrewarmed = prewarmed;
+            gLaunchTimings[client] = timings;
+        }
+
+        static void setLaunchTimings(const std::string& client, double clone, double config, double activate)
+        {
+            std::lock_guard<std::mutex> lock(gLaunchTimingsMutex);
+            auto timingsIt = gLaunchTimings.find(client);
+            if (timingsIt != gLaunchTimings.end())
+            {
+                timingsIt->second.mClone = clone;
+                timingsIt->second.mConfig = config;
+                timingsIt->second.mActivate = activate;
+            }
+        }
+
+        static void addLaunchTimings(const std::string& client, JsonObject& params)
+        {
+            std::lock_guard<std::mutex> lock(gLaunchTimingsMutex);
+            auto timingsIt = gLaunchTimings.find(client);
+            if (timingsIt == gLaunchTimings.end() || timingsIt->second.mLaunched)
+            {
+                return;
+            }
+            LaunchTimings& timings = timingsIt->second;
+            JsonObject phases;
+            if (timings.mClone >= 0)
+            {
+                phases["clone"] = static_cast<uint32_t>(timings.mClone);
+            }
+            if (timings.mConfig >= 0)
+            {
+                phases["config"] = static_cast<uint32_t>(timings.mConfig);
+            }
+            if (timings.mActivate >= 0)
+            {
+                phases["activate"] = static_cast<uint32_t>(timings.mActivate);
+            }
+            if (timings.mFirstFrame >= 0)
+            {
+                phases["firstFrame"] = static_cast<uint32_t>(timings.mFirstFrame);
+            }
+            phases["total"] = static_cast<uint32_t>(RdkShell::milliseconds() - timings.mStart);
+            params["timings"] = phases;
+            if (timings.mPrewarmed)
+            {
+                params["prewarmed"] = true;
+            }
+            timings.mLaunched = true;
+            if (timings.mFirstFrame >= 0)
+            {
+                gLaunchTimings.erase(timingsIt);
+            }
+        }
+
+        static void addFirstFrameTiming(const std::string& client, JsonObject& params)
+        {
+            std::lock_guard<std::mutex> lock(gLaunchTimingsMutex);
+            auto timingsIt = gLaunchTimings.find(client);
+            if (timingsIt == gLaunchTimings.end() || timingsIt->second.mFirstFrame >= 0)
+            {
+                return;
+            }
+            timingsIt->second.mFirstFrame = RdkShell::milliseconds() - timingsIt->second.mStart;
+            params["firstFrame"] = static_cast<uint32_t>(timingsIt->second.mFirstFrame);
+            if (timingsIt->second.mLaunched)
+            {
+                gLaunchTimings.erase(timingsIt);
+            }
+        }
+
+        static void removeLaunchTimings(const std::string& client)
+        {
+            std::lock_guard<std::mutex> lock(gLaunchTimingsMutex);
+            gLaunchTimings.erase(client);
+        }
+
         class StateControlNotification: public PluginHost::IStateControl::INotification
         {
           RDKShell& mRDKShell;
@@ -764,6 +869,7 @@ namespace WPEFramework {
                JsonObject params;
                params["client"] = mCallSign;
                params["launchType"] = (isSuspended)?"suspend":"resume";
+               addLaunchTimings(mCallSign, params);
                mRDKShell.notify(RDKShell::RDKSHELL_EVENT_ON_LAUNCHED, params);
                mLaunchEnabled = false;
             }
@@ -1255,6 +1361,7 @@ namespace WPEFramework {
                 }
                 
                 gPluginDataMutex.lock();
+                mShell.mWarmPool.Forget(service->Callsign());
                 std::map<std::string, PluginData>::iterator pluginToRemove = gActivePluginsData.find(service->Callsign());
                 if (pluginToRemove != gActivePluginsData.end())
                 {
@@ -1438,6 +1545,7 @@ namespace WPEFramework {
                     }
                     
                     gPluginDataMutex.lock();
+                    mShell.mWarmPool.Forget(service->Callsign());
                     std::map<std::string, PluginData>::iterator pluginToRemove = gActivePluginsData.find(service->Callsign());
                     if (pluginToRemove != gActivePluginsData.end())
                     {
@@ -1513,6 +1621,90 @@ namespace WPEFramework {
             }
         }
 
+        void RDKShell::MemoryPressureApplications::Applications(std::vector<MemoryPressureManager::Application>& applications)
+        {
+            string focused;
+            mShell.getFocused(focused);
+
+            std::vector<string> callsigns;
+            gPluginDataMutex.lock();
+            for (std::map<std::string, PluginData>::iterator pluginDataEntry = gActivePluginsData.begin(); pluginDataEntry != gActivePluginsData.end(); pluginDataEntry++)
+            {
+                callsigns.push_back(pluginDataEntry->first);
+            }
+            gPluginDataMutex.unlock();
+
+            for (const string& callsign : callsigns)
+            {
+                bool visible = false;
+                mShell.getVisibility(callsign, visible);
+                MemoryPressureManager::Application application;
+                application.callsign = callsign;
+                application.foreground = ((callsign == focused) || visible);
+                application.suspended = false;
+                application.residentKb = 0;
+                applications.push_back(application);
+            }
+        }
+
+        void RDKShell::MemoryPressureApplications::Inspect(MemoryPressureManager::Application& application)
+        {
+            PluginHost::IShell* service = mShell.mCurrentService;
+            if (nullptr == service)
+            {
+                return;
+            }
+            PluginHost::IStateControl* stateControl(service->QueryInterfaceByCallsign<PluginHost::IStateControl>(application.callsign));
+            if (nullptr != stateControl)
+            {
+                application.suspended = (stateControl->State() == PluginHost::IStateControl::SUSPENDED);
+                stateControl->Release();
+            }
+            Exchange::IMemory* memory(service->QueryInterfaceByCallsign<Exchange::IMemory>(application.callsign));
+            if (nullptr != memory)
+            {
+                application.residentKb = memory->Resident()/1024;
+                memory->Release();
+            }
+        }
+
+        bool RDKShell::MemoryPressureApplications::Apply(const string& callsign, const MemoryPressureManager::action what)
+        {
+            JsonObject parameters, response;
+            parameters["callsign"] = callsign;
+            uint32_t status = Core::ERROR_GENERAL;
+            switch (what)
+            {
+                case MemoryPressureManager::SUSPEND:
+                    status = mShell.suspendWrapper(parameters, response);
+                    break;
+                case MemoryPressureManager::HIBERNATE:
+#ifdef HIBERNATE_SUPPORT_ENABLED
+                    status = mShell.hibernateWrapper(parameters, response);
+#endif
+                    break;
+                case MemoryPressureManager::KILL:
+                    status = mShell.destroyWrapper(parameters, response);
+                    break;
+                default:
+                    break;
+            }
+            return (status == Core::ERROR_NONE);
+        }
+
+        void RDKShell::MemoryPressureApplications::Decided(const MemoryPressureManager::Decision& decision)
+        {
+            JsonObject params;
+            params["client"] = decision.callsign;
+            params["action"] = MemoryPressureManager::ActionName(decision.what);
+            params["ram"] = decision.residentKb;
+            params["idle"] = decision.idleMs;
+            params["some"] = std::to_string(decision.someAvg10);
+            params["full"] = std::to_string(decision.fullAvg10);
+            params["executed"] = decision.executed;
+            mShell.notify(RDKShell::RDKSHELL_EVENT_ON_MEMORY_PRESSURE_ACTION, params);
+        }
+
 #ifdef HIBERNATE_SUPPORT_ENABLED
         RDKShell::HibernateExecutor::HibernateExecutor(RDKShell& shell):
             mShell(shell),
@@ -1701,13 +1893,21 @@ namespace WPEFramework {
                 mLastWakeupKeyTimestamp(0),
                 mEnableEasterEggs(true),
                 mScreenCapture(this),
-                mErmEnabled(false)
+                mErmEnabled(false),
+                mMemoryPressureApplications(this),
+                mMemoryPressure(mMemoryPressureApplications)
 #ifdef HIBERNATE_SUPPORT_ENABLED
                 , mHibernateExecutor(*this)
 #endif
         {
             LOGINFO("ctor");
             RDKShell::_instance = this;
+            MemoryPressureManager::Policy memoryPressurePolicy = MemoryPressureManager::DefaultPolicy();
+#ifdef HIBERNATE_SUPPORT_ENABLED
+            memoryPressurePolicy.hibernation = true;
+#endif
+            memoryPressurePolicy.protectedApps.insert("ResidentApp");
+            mMemoryPressure.Configure(memoryPressurePolicy);
             mEventListener = std::make_shared<RdkShellListener>(this);
 
             mRemoteShell = false;
@@ -1798,11 +1998,15 @@ namespace WPEFramework {
             Register(RDKSHELL_METHOD_SET_AV_BLOCKED, &RDKShell::setAVBlockedWrapper, this);
             Register(RDKSHELL_METHOD_GET_AV_BLOCKED_APPS, &RDKShell::getBlockedAVApplicationsWrapper, this);
             Register(RDKSHELL_METHOD_SET_KEY_INTERCEPTS, &RDKShell::setKeyInterceptsWrapper, this);
+            Register(RDKSHELL_METHOD_SET_MEMORY_PRESSURE_POLICY, &RDKShell::setMemoryPressurePolicyWrapper, this);
+            Register(RDKSHELL_METHOD_GET_MEMORY_PRESSURE_STATUS, &RDKShell::getMemoryPressureStatusWrapper, this);
 #ifdef HIBERNATE_SUPPORT_ENABLED
             Register(RDKSHELL_METHOD_HIBERNATE, &RDKShell::hibernateWrapper, this);
             Register(RDKSHELL_METHOD_RESTORE, &RDKShell::restoreWrapper, this);
 #endif
       	    m_timer.connect(std::bind(&RDKShell::onTimer, this));
+            m_warmPoolTimer.setSingleShot(true);
+            m_warmPoolTimer.connect(std::bind(&RDKShell::onWarmPoolTimer, this));
         }
 
         RDKShell::~RDKShell()
@@ -2158,6 +2362,32 @@ namespace WPEFramework {
             {
                 gWillDestroyEventWaitTime = atoi(willDestroyWaitTimeValue); 
             }
+            char* warmPoolSizeValue = getenv("RDKSHELL_WARM_POOL_SIZE");
+            if (NULL != warmPoolSizeValue)
+            {
+                std::string warmPoolTypes("WebKitBrowser,LightningApp");
+                char* warmPoolTypesValue = getenv("RDKSHELL_WARM_POOL_TYPES");
+                if (NULL != warmPoolTypesValue)
+                {
+                    warmPoolTypes = warmPoolTypesValue;
+                }
+                std::stringstream typeStream(warmPoolTypes);
+                std::string type;
+                std::vector<std::string> types;
+                while (std::getline(typeStream, type, ','))
+                {
+                    if (!type.empty())
+                    {
+                        types.push_back(type);
+                    }
+                }
+                const int warmPoolSize = atoi(warmPoolSizeValue);
+                if (mWarmPool.Configure(types, warmPoolSize > 0 ? warmPoolSize : 0))
+                {
+                    std::cout << "keeping " << warmPoolSize << " prewarmed instances of " << warmPoolTypes << std::endl;
+                    m_warmPoolTimer.start(RDKSHELL_WARM_POOL_FILL_DELAY_MS);
+                }
+            }
 
             m_timer.setInterval(RECONNECTION_TIME_IN_MILLISECONDS);
             m_timer.start();
@@ -2317,6 +2547,24 @@ namespace WPEFramework {
         void RDKShell::Deinitialize(PluginHost::IShell* service)
         {
             LOGINFO("Deinitialize");
+            MemoryPressureManager::Policy memoryPressurePolicy = mMemoryPressure.Configuration();
+            memoryPressurePolicy.enabled = false;
+            mMemoryPressure.Configure(memoryPressurePolicy);
+            m_warmPoolTimer.stop();
+            mWarmPool.Stop();
+            // the instance being prewarmed may wait for its display, finish it while the shell thread runs
+            mWarmPoolThreadMutex.lock();
+            if (mWarmPoolThread.joinable())
+            {
+                mWarmPoolThread.join();
+            }
+            mWarmPoolThreadMutex.unlock();
+            // nobody adopted these, destroy them like destroy does; their displays go with the deactivation
+            for (const std::string& callsign : mWarmPool.Drain())
+            {
+                std::cout << "destroying prewarmed instance " << callsign << std::endl;
+                deactivate(mCurrentService, callsign);
+            }
             gRdkShellMutex.lock();
             RdkShell::deinitialize();
             sRunning = false;
@@ -2458,6 +2706,7 @@ namespace WPEFramework {
           std::cout << "RDKShell onApplicationFirstFrame event received ..." << client << std::endl;
           JsonObject params;
           params["client"] = client;
+          addFirstFrameTiming(client, params);
           mShell.notify(RDKSHELL_EVENT_ON_APP_FIRST_FRAME, params);
         }
 
@@ -4101,6 +4350,138 @@ namespace WPEFramework {
             returnResponse(result);
         }
 
+        static void setWpeRootMode(const string& type, JsonObject& configSet)
+        {
+#ifdef RFC_ENABLED
+            RFC_ParamData_t param;
+            if (Utils::getRFCConfig("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Dobby.WPE.Enable", param))
+            {
+                JsonObject root;
+                if (strncasecmp(param.value, "true", 4) == 0)
+                {
+                    std::cout << "dobby WPE rfc true - launching " << type << " in container mode " << std::endl;
+                    root = configSet["root"].Object();
+                    root["mode"] = JsonValue("Container");
+                }
+                else
+                {
+                    std::cout << "dobby WPE rfc false - launching " << type << " in out-of-process mode " << std::endl;
+                    root = configSet["root"].Object();
+                    root["outofprocess"] = JsonValue(true);
+                }
+                configSet["root"] = root;
+            }
+            else
+            {
+                std::cout << "reading dobby WPE rfc failed - launching " << type << " in default mode" << std::endl;
+            }
+#else
+            std::cout << "rfc is disabled and unable to check for " << type << " container mode " << std::endl;
+#endif
+        }
+
+        void RDKShell::onWarmPoolTimer()
+        {
+            std::lock_guard<std::mutex> lock(mWarmPoolThreadMutex);
+            // all clients share one display in surface mode, nothing to prepare ahead
+            if (gRdkShellSurfaceModeEnabled || !mWarmPool.BeginFill())
+            {
+                return;
+            }
+            if (mWarmPoolThread.joinable())
+            {
+                mWarmPoolThread.join();
+            }
+            mWarmPoolThread = std::thread(&RDKShell::fillWarmPool, this);
+        }
+
+        void RDKShell::fillWarmPool()
+        {
+            for (const std::string& type : mWarmPool.Types())
+            {
+                while (true)
+                {
+                    string callsign = mWarmPool.Next(type);
+                    if (callsign.empty())
+                    {
+                        break;
+                    }
+                    if (!prewarmInstance(type, callsign))
+                    {
+                        std::cout << "unable to prewarm " << type << ", trying again with the next refill" << std::endl;
+                        break;
+                    }
+                    mWarmPool.Add(type, callsign);
+                    std::cout << "prewarmed " << callsign << std::endl;
+                }
+            }
+            mWarmPool.EndFill();
+        }
+
+        // Takes an instance through clone, configuration and activation the way launch does and parks
+        // it suspended and hidden, so that a launch that adopts it only has to resume it.
+        bool RDKShell::prewarmInstance(const string& type, const string& callsign)
+        {
+            PluginHost::IShell::state state;
+            if (getServiceState(mCurrentService, type, state) != Core::ERROR_NONE)
+            {
+                return false;
+            }
+            if (cloneService(mCurrentService, type, callsign) != Core::ERROR_NONE)
+            {
+                return false;
+            }
+
+            string xdgDir;
+            Core::SystemInfo::GetEnvironment(_T("XDG_RUNTIME_DIR"), xdgDir);
+            Core::Directory((xdgDir + "/" + type).c_str()).CreatePath();
+            const string displayName = type + "/" + "wst-" + callsign;
+
+            std::shared_ptr<CreateDisplayRequest> request = std::make_shared<CreateDisplayRequest>(callsign, displayName);
+            lockRdkShellMutex();
+            gPluginDisplayNameMap[callsign] = displayName;
+            gCreateDisplayRequests.push_back(request);
+            gRdkShellMutex.unlock();
+
+            string configString;
+            uint32_t status = getConfig(mCurrentService, callsign, configString);
+            if (status == Core::ERROR_NONE)
+            {
+                JsonObject configSet;
+                configSet.FromString(configString);
+                configSet["clientidentifier"] = displayName;
+                if (type == "HtmlApp" || type == "LightningApp")
+                {
+                    setWpeRootMode(type, configSet);
+                }
+                string configSetAsString;
+                configSet.ToString(configSetAsString);
+                Core::JSON::String configSetAsJsonString;
+                configSetAsJsonString.FromString(configSetAsString);
+                status = setConfig(mCurrentService, callsign, configSetAsJsonString.Value());
+            }
+            sem_wait(&request->mSemaphore);
+
+            if (status == Core::ERROR_NONE)
+            {
+                status = activate(mCurrentService, callsign);
+            }
+            if (status == Core::ERROR_NONE)
+            {
+                WPEFramework::Core::JSON::String stateString;
+                stateString = "suspended";
+                status = JSONRPCDirectLink(mCurrentService, callsign).Set<WPEFramework::Core::JSON::String>(RDKSHELL_THUNDER_TIMEOUT, "state", stateString);
+                setVisibility(callsign, false);
+            }
+            if (status != Core::ERROR_NONE)
+            {
+                std::cout << "prewarming " << callsign << " failed with status " << status << std::endl;
+                deactivate(mCurrentService, callsign);
+                return false;
+            }
+            return true;
+        }
+
         uint32_t RDKShell::launchWrapper(const JsonObject& parameters, JsonObject& response)
         {
             LOGINFOMETHOD();
@@ -4116,6 +4497,7 @@ namespace WPEFramework {
             }
 
             string appCallsign("");
+            bool prewarmed = false;
             /*if (result)
             {
                 bool launchInProgress = false;
@@ -4143,6 +4525,24 @@ namespace WPEFramework {
             if (result)
             {
                 appCallsign = parameters["callsign"].String();
+                if (parameters.HasLabel("prewarmed") && parameters["prewarmed"].Boolean() && parameters.HasLabel("type")
+                    && !parameters.HasLabel("configuration") && !parameters.HasLabel("displayName"))
+                {
+                    // Adopting is only possible for a callsign that is not running already, and the app keeps the
+                    // callsign of the pool instance since Thunder cannot rename a plugin.
+                    PluginHost::IShell::state state;
+                    if (getServiceState(mCurrentService, appCallsign, state) != Core::ERROR_NONE)
+                    {
+                        string warmCallsign = mWarmPool.Take(parameters["type"].String());
+                        if (!warmCallsign.empty())
+                        {
+                            std::cout << "adopting prewarmed instance " << warmCallsign << " for " << appCallsign << std::endl;
+                            appCallsign = warmCallsign;
+                            prewarmed = true;
+                            m_warmPoolTimer.start(RDKSHELL_WARM_POOL_REFILL_DELAY_MS);
+                        }
+                    }
+                }
                 if (appCallsign.compare("SearchAndDiscovery") == 0)
                 {
                     LOG_MILESTONE("PLUI_LAUNCH_START");
@@ -4167,7 +4567,12 @@ namespace WPEFramework {
                     returnResponse(false);
                 }
                 RDKShellLaunchType launchType = RDKShellLaunchType::UNKNOWN;
-                const string callsign = parameters["callsign"].String();
+                const string callsign = appCallsign;
+                startLaunchTimings(callsign, prewarmed);
+                double cloneTime = -1;
+                double configTime = -1;
+                double activateTime = -1;
+                double phaseStartTime = 0;
                 const string callsignWithVersion = callsign + ".1";
                 string type;
                 if (parameters.HasLabel("type"))
@@ -4342,9 +4747,11 @@ namespace WPEFramework {
                         originalPluginFound = true;
                     }
                 }
+                std::shared_ptr<CreateDisplayRequest> displayRequest;
 		if (!newPluginFound && !originalPluginFound)
                 {
                     response["message"] = "failed to launch application.  type not found";
+                    removeLaunchTimings(callsign);
                     gLaunchMutex.lock();
                     gLaunchCount = 0;
                     gLaunchMutex.unlock();
@@ -4357,6 +4764,7 @@ namespace WPEFramework {
                 else if (!newPluginFound)
                 {
                     std::cout << "attempting to clone type: " << type << " into " << callsign << std::endl;
+                    phaseStartTime = RdkShell::milliseconds();
                     uint32_t status = cloneService(mCurrentService, type, callsign);
 
                     std::cout << "clone status: " << status << std::endl;
@@ -4366,6 +4774,7 @@ namespace WPEFramework {
                         status = cloneService(mCurrentService, type, callsign);
                         std::cout << "clone status: " << status << std::endl;
                     }
+                    cloneTime = RdkShell::milliseconds() - phaseStartTime;
 
                     launchType = RDKShellLaunchType::CREATE;
                     {
@@ -4395,13 +4804,15 @@ namespace WPEFramework {
                         std::cout << "Added displayname : "<<displayName<< std::endl;
                         gCreateDisplayRequests.push_back(request);
                         gRdkShellMutex.unlock();
-                        sem_wait(&request->mSemaphore);
+                        // the shell thread creates the display while the configuration is prepared below
+                        displayRequest = request;
                     }
                 }
 
                 string configString;
 
                 uint32_t status = 0;
+                phaseStartTime = RdkShell::milliseconds();
                 status = getConfig(mCurrentService, callsign, configString);
 
                 std::cout << "config status: " << status << std::endl;
@@ -4504,32 +4915,7 @@ namespace WPEFramework {
                 // One RFC controls all WPE-based apps
                 if (!type.empty() && (type == "HtmlApp" || type == "LightningApp"))
                 {
-#ifdef RFC_ENABLED
-                    RFC_ParamData_t param;
-                    if (Utils::getRFCConfig("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Dobby.WPE.Enable", param))
-                    {
-                        JsonObject root;
-                        if (strncasecmp(param.value, "true", 4) == 0)
-                        {
-                            std::cout << "dobby WPE rfc true - launching " << type << " in container mode " << std::endl;
-                            root = configSet["root"].Object();
-                            root["mode"] = JsonValue("Container");
-                        }
-                        else
-                        {
-                            std::cout << "dobby WPE rfc false - launching " << type << " in out-of-process mode " << std::endl;
-                            root = configSet["root"].Object();
-                            root["outofprocess"] = JsonValue(true);
-                        }
-                        configSet["root"] = root;
-                    }
-                    else
-                    {
-                        std::cout << "reading dobby WPE rfc failed - launching " << type << " in default mode" << std::endl;
-                    }
-#else
-                    std::cout << "rfc is disabled and unable to check for " << type << " container mode " << std::endl;
-#endif
+                    setWpeRootMode(type, configSet);
                 }
 
                 if (!type.empty() && type == "SearchAndDiscoveryApp" )
@@ -4605,7 +4991,15 @@ namespace WPEFramework {
                     status = setConfig(mCurrentService, callsign, configSetAsJsonString.Value());
                     std::cout << "set status: " << status << std::endl;
                 }
+                configTime = RdkShell::milliseconds() - phaseStartTime;
+
+                if (displayRequest)
+                {
+                    sem_wait(&displayRequest->mSemaphore);
+                    displayRequest = nullptr;
+                }
 
+                phaseStartTime = RdkShell::milliseconds();
                 if (launchType == RDKShellLaunchType::UNKNOWN)
                 {
                     status = 0;
@@ -4664,6 +5058,12 @@ namespace WPEFramework {
                     }
                 }
 
+                if (launchType != RDKShellLaunchType::UNKNOWN)
+                {
+                    activateTime = RdkShell::milliseconds() - phaseStartTime;
+                }
+                setLaunchTimings(callsign, cloneTime, configTime, activateTime);
+
                 bool deferLaunch = false;
                 if (status > 0)
                 {
@@ -4893,12 +5293,18 @@ namespace WPEFramework {
                         onLaunched(callsign, launchTypeString);
                     }
                     response["launchType"] = launchTypeString;
+                    if (prewarmed)
+                    {
+                        response["callsign"] = callsign;
+                        response["prewarmed"] = true;
+                    }
                 }
                 
             }
             if (!result) 
             {
                 response["message"] = "failed to launch application";
+                removeLaunchTimings(appCallsign);
             }
             gLaunchMutex.lock();
             gLaunchCount = 0;
@@ -5757,6 +6163,120 @@ namespace WPEFramework {
             returnResponse(result);
         }
 
+        uint32_t RDKShell::setMemoryPressurePolicyWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            bool result = true;
+            if (!parameters.HasLabel("enable"))
+            {
+                result = false;
+                response["message"] = "please specify enable parameter";
+            }
+            if (result)
+            {
+                MemoryPressureManager::Policy policy = mMemoryPressure.Configuration();
+                policy.enabled = parameters["enable"].Boolean();
+                if (parameters.HasLabel("dryRun"))
+                {
+                    policy.dryRun = parameters["dryRun"].Boolean();
+                }
+                if (parameters.HasLabel("interval"))
+                {
+                    policy.interval = parameters["interval"].Number();
+                }
+                if (parameters.HasLabel("cooldown"))
+                {
+                    policy.cooldown = parameters["cooldown"].Number();
+                }
+                try
+                {
+                    if (parameters.HasLabel("suspendThreshold"))
+                    {
+                        policy.suspendThreshold = std::stod(parameters["suspendThreshold"].String());
+                    }
+                    if (parameters.HasLabel("hibernateThreshold"))
+                    {
+                        policy.hibernateThreshold = std::stod(parameters["hibernateThreshold"].String());
+                    }
+                    if (parameters.HasLabel("killThreshold"))
+                    {
+                        policy.killThreshold = std::stod(parameters["killThreshold"].String());
+                    }
+                }
+                catch (...)
+                {
+                    result = false;
+                    response["message"] = "thresholds have to be numbers";
+                }
+                if (parameters.HasLabel("protected"))
+                {
+                    policy.protectedApps.clear();
+                    const JsonArray protectedApps = parameters["protected"].Array();
+                    for (int i = 0; i < protectedApps.Length(); i++)
+                    {
+                        policy.protectedApps.insert(protectedApps[i].String());
+                    }
+                }
+                if (result && (policy.interval == 0))
+                {
+                    result = false;
+                    response["message"] = "interval has to be greater than 0";
+                }
+                if (result)
+                {
+                    mMemoryPressure.Configure(policy);
+                }
+            }
+            returnResponse(result);
+        }
+
+        uint32_t RDKShell::getMemoryPressureStatusWrapper(const JsonObject& parameters, JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            const MemoryPressureManager::Policy policy = mMemoryPressure.Configuration();
+            JsonObject policyObject;
+            policyObject["enable"] = policy.enabled;
+            policyObject["dryRun"] = policy.dryRun;
+            policyObject["interval"] = policy.interval;
+            policyObject["cooldown"] = policy.cooldown;
+            policyObject["suspendThreshold"] = std::to_string(policy.suspendThreshold);
+            policyObject["hibernateThreshold"] = std::to_string(policy.hibernateThreshold);
+            policyObject["killThreshold"] = std::to_string(policy.killThreshold);
+            JsonArray protectedApps;
+            for (const string& callsign : policy.protectedApps)
+            {
+                protectedApps.Add(callsign);
+            }
+            policyObject["protected"] = protectedApps;
+            response["policy"] = policyObject;
+
+            const MemoryPressureManager::Pressure pressure = mMemoryPressure.Current();
+            JsonObject pressureObject;
+            pressureObject["available"] = pressure.valid;
+            pressureObject["some"] = std::to_string(pressure.someAvg10);
+            pressureObject["full"] = std::to_string(pressure.fullAvg10);
+            response["pressure"] = pressureObject;
+
+            std::vector<MemoryPressureManager::Decision> decisions;
+            mMemoryPressure.Decisions(decisions);
+            JsonArray decisionsArray;
+            for (const MemoryPressureManager::Decision& decision : decisions)
+            {
+                JsonObject decisionObject;
+                decisionObject["timestamp"] = decision.timestamp;
+                decisionObject["client"] = decision.callsign;
+                decisionObject["action"] = MemoryPressureManager::ActionName(decision.what);
+                decisionObject["ram"] = decision.residentKb;
+                decisionObject["idle"] = decision.idleMs;
+                decisionObject["some"] = std::to_string(decision.someAvg10);
+                decisionObject["full"] = std::to_string(decision.fullAvg10);
+                decisionObject["executed"] = decision.executed;
+                decisionsArray.Add(decisionObject);
+            }
+            response["decisions"] = decisionsArray;
+            returnResponse(true);
+        }
+
         uint32_t RDKShell::launchFactoryAppWrapper(const JsonObject& parameters, JsonObject& response)
         {
             LOGINFOMETHOD();
@@ -7967,6 +8487,7 @@ namespace WPEFramework {
             JsonObject params;
             params["client"] = client;
             params["launchType"] = launchType;
+            addLaunchTimings(client, params);
             notify(RDKSHELL_EVENT_ON_LAUNCHED, params);
         }
 
@@ -7982,6 +8503,7 @@ namespace WPEFramework {
         void RDKShell::onDestroyed(const std::string& client)
         {
             std::cout << "RDKShell onDestroyed event received for " << client << std::endl;
+            removeLaunchTimings(client);
             JsonObject params;
             params["client"] = client;
             notify(RDKSHELL_EVENT_ON_DESTROYED, params);
@@ -8106,6 +8628,7 @@ namespace WPEFramework {
                JsonObject launchParams;
                launchParams["client"] = mCallSign;
                launchParams["launchType"] = (isSuspended)?"suspend":"resume";
+               addLaunchTimings(mCallSign, launchParams);
                mRDKShell.notify(RDKShell::RDKSHELL_EVENT_ON_LAUNCHED, launchParams);
                mLaunchEnabled = false;
             }
@@ -28,6 +28,8 @@
 #include <rdkshell/linuxkeys.h>
 #include <interfaces/ICapture.h>
 #include "tptimer.h"
+#include "MemoryPressureManager.h"
+#include "WarmPool.h"
 #ifdef ENABLE_RIALTO_FEATURE
 #include "RialtoConnector.h"
 #define RIALTO_TIMEOUT_MILLIS 5000
@@ -149,6 +151,8 @@ namespace WPEFramework {
             static const string RDKSHELL_METHOD_GET_GRAPHICS_FRAME_RATE;
             static const string RDKSHELL_METHOD_SET_GRAPHICS_FRAME_RATE;
             static const string RDKSHELL_METHOD_SET_KEY_INTERCEPTS;
+            static const string RDKSHELL_METHOD_SET_MEMORY_PRESSURE_POLICY;
+            static const string RDKSHELL_METHOD_GET_MEMORY_PRESSURE_STATUS;
 #ifdef HIBERNATE_SUPPORT_ENABLED
             static const string RDKSHELL_METHOD_HIBERNATE;
             static const string RDKSHELL_METHOD_RESTORE;
@@ -176,6 +180,7 @@ namespace WPEFramework {
             static const string RDKSHELL_EVENT_ON_EASTER_EGG;
             static const string RDKSHELL_EVENT_ON_WILL_DESTROY;
             static const string RDKSHELL_EVENT_ON_SCREENSHOT_COMPLETE;
+            static const string RDKSHELL_EVENT_ON_MEMORY_PRESSURE_ACTION;
 #ifdef HIBERNATE_SUPPORT_ENABLED
             static const string RDKSHELL_EVENT_ON_HIBERNATED;
             static const string RDKSHELL_EVENT_ON_RESTORED;
@@ -276,6 +281,8 @@ namespace WPEFramework {
             uint32_t getGraphicsFrameRateWrapper(const JsonObject& parameters, JsonObject& response);
             uint32_t setGraphicsFrameRateWrapper(const JsonObject& parameters, JsonObject& response);
             uint32_t setKeyInterceptsWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t setMemoryPressurePolicyWrapper(const JsonObject& parameters, JsonObject& response);
+            uint32_t getMemoryPressureStatusWrapper(const JsonObject& parameters, JsonObject& response);
 #ifdef HIBERNATE_SUPPORT_ENABLED
             uint32_t hibernateWrapper(const JsonObject& parameters, JsonObject& response);
             uint32_t restoreWrapper(const JsonObject& parameters, JsonObject& response);
@@ -345,6 +352,9 @@ namespace WPEFramework {
             void invokeStartupThunderApis();
             int32_t subscribeForSystemEvent(std::string event);
             void onTimer();
+            void onWarmPoolTimer();
+            void fillWarmPool();
+            bool prewarmInstance(const string& type, const string& callsign);
 
             void addFactoryModeEasterEggs();
             void removeFactoryModeEasterEggs();
@@ -450,6 +460,19 @@ namespace WPEFramework {
                   RDKShell& mShell;
             };
 
+            class MemoryPressureApplications : public MemoryPressureManager::IApplications {
+                public:
+                MemoryPressureApplications(RDKShell *shell) : mShell(*shell) { }
+
+                void Applications(std::vector<MemoryPressureManager::Application>& applications) override;
+                void Inspect(MemoryPressureManager::Application& application) override;
+                bool Apply(const string& callsign, const MemoryPressureManager::action what) override;
+                void Decided(const MemoryPressureManager::Decision& decision) override;
+
+                private:
+                RDKShell& mShell;
+            };
+
             class ScreenCapture : public Exchange::ICapture {
                 public:
                 ScreenCapture(RDKShell *shell) : mShell(shell) { }
@@ -513,9 +536,15 @@ namespace WPEFramework {
             uint32_t mLastWakeupKeyModifiers;
             uint64_t mLastWakeupKeyTimestamp;
             TpTimer m_timer;
+            TpTimer m_warmPoolTimer;
+            WarmPool mWarmPool;
+            std::mutex mWarmPoolThreadMutex;
+            std::thread mWarmPoolThread;
             bool mEnableEasterEggs;
             ScreenCapture mScreenCapture;
             bool mErmEnabled;
+            MemoryPressureApplications mMemoryPressureApplications;
+            MemoryPressureManager mMemoryPressure;
 #ifdef ENABLE_RIALTO_FEATURE
         std::shared_ptr<RialtoConnector>  rialtoConnector;
 #endif //ENABLE_RIALTO_FEATURE
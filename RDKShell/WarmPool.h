@@ -0,0 +1,160 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "Module.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Book keeping of the prewarmed instances: per type the callsigns of suspended clones that a launch can
+    // adopt, oldest first. Instances are named "<type>-warm-<n>"; the shell creates and destroys them, this
+    // only tracks which are ready, whether a fill is running and whether the pool is shutting down.
+    class WarmPool {
+    public:
+        WarmPool(const WarmPool&) = delete;
+        WarmPool& operator=(const WarmPool&) = delete;
+
+        WarmPool()
+            : _lock()
+            , _pools()
+            , _types()
+            , _size(0)
+            , _sequence(0)
+            , _filling(false)
+            , _stopping(false)
+        {
+        }
+        ~WarmPool() = default;
+
+    public:
+        // Returns true when there is anything to keep warm.
+        bool Configure(const std::vector<string>& types, const uint32_t size)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _types = types;
+            _size = size;
+            _stopping = false;
+            return ((_size > 0) && (_types.empty() == false));
+        }
+
+        std::vector<string> Types() const
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            return (_types);
+        }
+
+        size_t Count(const string& type) const
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            auto pool = _pools.find(type);
+            return (pool != _pools.end() ? pool->second.size() : 0);
+        }
+
+        // Only one fill at a time and none once stopping.
+        bool BeginFill()
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            if ((_stopping == true) || (_filling == true)) {
+                return (false);
+            }
+            _filling = true;
+            return (true);
+        }
+
+        void EndFill()
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _filling = false;
+        }
+
+        // The callsign for the next instance of the type, empty when its pool is full or stopping.
+        string Next(const string& type)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            if ((_stopping == true) || (_pools[type].size() >= _size)) {
+                return (string());
+            }
+            return (type + "-warm-" + std::to_string(++_sequence));
+        }
+
+        void Add(const string& type, const string& callsign)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _pools[type].push_back(callsign);
+        }
+
+        // Hands the oldest instance of the type to a launch, empty when there is none.
+        string Take(const string& type)
+        {
+            string callsign;
+            std::lock_guard<std::mutex> lock(_lock);
+            auto pool = _pools.find(type);
+            if ((pool != _pools.end()) && (pool->second.empty() == false)) {
+                callsign = pool->second.front();
+                pool->second.erase(pool->second.begin());
+            }
+            return (callsign);
+        }
+
+        // An instance that went away while it was waiting in the pool.
+        void Forget(const string& callsign)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            for (auto& pool : _pools) {
+                pool.second.erase(std::remove(pool.second.begin(), pool.second.end(), callsign), pool.second.end());
+            }
+        }
+
+        void Stop()
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _stopping = true;
+        }
+
+        // Empties the pool, the returned instances are for the caller to destroy.
+        std::vector<string> Drain()
+        {
+            std::vector<string> callsigns;
+            std::lock_guard<std::mutex> lock(_lock);
+            for (auto& pool : _pools) {
+                callsigns.insert(callsigns.end(), pool.second.begin(), pool.second.end());
+            }
+            _pools.clear();
+            return (callsigns);
+        }
+
+    private:
+        mutable std::mutex _lock;
+        std::map<string, std::vector<string>> _pools;
+        std::vector<string> _types;
+        uint32_t _size;
+        uint32_t _sequence;
+        bool _filling;
+        bool _stopping;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -20,6 +20,7 @@
 #include "RamHelper.h"
 #include "UtilsLogging.h"
 #include "UtilsUnused.h"
+#include "UtilsIarm.h"
 
 // IR-RF Database RF descriptors, needed for all original configurable keys
 // Discrete Power ON/OFF use actual RF keycodes (0x6D, 0x6C), the rest are all XRC ghost codes
@@ -59,7 +60,7 @@ namespace WPEFramework {
 
             memset((void*)&status, 0, sizeof(status));
             status.api_revision = CTRLM_MAIN_IARM_BUS_API_REVISION;
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_STATUS_GET, (void*)&status, sizeof(status));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_STATUS_GET, (void*)&status, sizeof(status));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - STATUS_GET IARM_Bus_Call FAILED, res: %d", (int)res);
@@ -121,7 +122,7 @@ namespace WPEFramework {
             memset((void*)&netStatus, 0, sizeof(netStatus));
             netStatus.api_revision = CTRLM_MAIN_IARM_BUS_API_REVISION;
             netStatus.network_id = rf4ceId;
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_NETWORK_STATUS_GET, (void*)&netStatus, sizeof(netStatus));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_MAIN_IARM_CALL_NETWORK_STATUS_GET, (void*)&netStatus, sizeof(netStatus));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("ERROR - NETWORK_STATUS_GET IARM_Bus_Call FAILED, res: %d", (int)res);
@@ -154,7 +155,7 @@ namespace WPEFramework {
                 ctrlStatus.api_revision = CTRLM_RCU_IARM_BUS_API_REVISION;
                 ctrlStatus.network_id = rf4ceId;
                 ctrlStatus.controller_id = netStatus.status.rf4ce.controllers[i];
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_CONTROLLER_STATUS, (void*)&ctrlStatus, sizeof(ctrlStatus));
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_CONTROLLER_STATUS, (void*)&ctrlStatus, sizeof(ctrlStatus));
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CONTROLLER_STATUS IARM_Bus_Call FAILED, res: %d, controller_id: %d, index: %d",
@@ -287,7 +288,7 @@ namespace WPEFramework {
             ctrlStatus.api_revision = CTRLM_RCU_IARM_BUS_API_REVISION;
             ctrlStatus.network_id = rf4ceId;
             ctrlStatus.controller_id = deviceID;
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_CONTROLLER_STATUS, (void*)&ctrlStatus, sizeof(ctrlStatus));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_CONTROLLER_STATUS, (void*)&ctrlStatus, sizeof(ctrlStatus));
             if (res != IARM_RESULT_SUCCESS)
             {
                 LOGERR("CONTROLLER_STATUS IARM_Bus_Call FAILED, res: %d, controller_id: %d, network_id: %d.",
@@ -648,7 +649,7 @@ namespace WPEFramework {
                     (unsigned char)ribRequest.data[16], (unsigned char)ribRequest.data[17], (unsigned char)ribRequest.data[18], (unsigned char)ribRequest.data[19]);
 
             // Do the direct write to the IR-RF DB RIB entry.
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
             if (res == IARM_RESULT_SUCCESS)
             {
                 LOGWARN("Set RIB IR-RF DB Request: controller_id: %u, network_id: 0x%02X, "
@@ -719,7 +720,7 @@ namespace WPEFramework {
             ribRequest.length           = CTRLM_RCU_MAX_RIB_ATTRIBUTE_SIZE;
 
             // Read the RIB IRRFDB entry for the specified rfKey
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
             if (res == IARM_RESULT_SUCCESS)
             {
                 LOGWARN("Get RIB IR-RF DB Request: controller_id: %u, network_id: 0x%02X, "
@@ -862,7 +863,7 @@ namespace WPEFramework {
             ribRequest.data[0]          = flags;
 
             // Direct write to the RIB IRRFDB entry for this RF key.
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
             if (res == IARM_RESULT_SUCCESS)
             {
                 LOGWARN("Wrote RIB IR-RF Database: controller_id: %u, network_id: 0x%02X, "
@@ -1142,7 +1143,7 @@ namespace WPEFramework {
             memcpy(bytePtr, data, dataSize);
 
             // Do the direct write to the IR-RF DB RIB entry.
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
             if (res == IARM_RESULT_SUCCESS)
             {
                 LOGWARN("Set RIB IR-RF DB Request: controller_id: %u, network_id: 0x%02X, "
@@ -1211,7 +1212,7 @@ namespace WPEFramework {
             ribRequest.data[0]          = flags;
 
             // Direct write to the RIB IRRFDB entry for this RF key.
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
             if (res == IARM_RESULT_SUCCESS)
             {
                 LOGWARN("Wrote RIB IR-RF Database: controller_id: %u, network_id: 0x%02X, "
@@ -1271,7 +1272,7 @@ namespace WPEFramework {
             ribRequest.length           = 1;
 
             // Read the RIB IRRF Status to get the current Flags setting
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
             if (res == IARM_RESULT_SUCCESS)
             {
                 LOGWARN("Current RIB IR-RF Status: controller_id: %u, network_id: 0x%02X, "
@@ -1292,7 +1293,7 @@ namespace WPEFramework {
                             ribRequest.length = 1;
                         }
 
-                        res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
+                        res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
                         if (res == IARM_RESULT_SUCCESS)
                         {
                             if (ribRequest.result == CTRLM_IARM_CALL_RESULT_SUCCESS)
@@ -1370,7 +1371,7 @@ namespace WPEFramework {
             ribRequest.length           = CTRLM_RCU_RIB_ATTR_LEN_TARGET_IRDB_STATUS;
 
             // Read the entire RIB Target IRDB Status attribute, to get the current Flags and  TV and AVR strings.
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
             if (res == IARM_RESULT_SUCCESS)
             {
                 LOGWARN("Current RIB Target IRDB Status: controller_id: %u, network_id: 0x%02X, "
@@ -1421,7 +1422,7 @@ namespace WPEFramework {
                     ribRequest.data[0] = flags;
                     // Write the Target IRDB Status attribute back to the RIB.
                     ribRequest.length = CTRLM_RCU_RIB_ATTR_LEN_TARGET_IRDB_STATUS;
-                    res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
+                    res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
                     if (res == IARM_RESULT_SUCCESS)
                     {
                         if (ribRequest.result == CTRLM_IARM_CALL_RESULT_SUCCESS)
@@ -1508,7 +1509,7 @@ namespace WPEFramework {
             ribRequest.length           = 1;
 
             // Read the RIB IRRF Status to get the current Flags setting
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
             if (res == IARM_RESULT_SUCCESS)
             {
                 LOGWARN("Current RIB IR-RF Status: controller_id: %u, network_id: 0x%02X, "
@@ -1529,7 +1530,7 @@ namespace WPEFramework {
                             ribRequest.length = 1;
                         }
 
-                        res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
+                        res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_SET, (void *)&ribRequest, sizeof(ribRequest));
                         if (res == IARM_RESULT_SUCCESS)
                         {
                             if (ribRequest.result == CTRLM_IARM_CALL_RESULT_SUCCESS)
@@ -1599,7 +1600,7 @@ namespace WPEFramework {
             ribRequest.length           = CTRLM_RCU_RIB_ATTR_LEN_CONTROLLER_IRDB_STATUS;
 
             // Read the entire RIB Controller IRDB Status attribute, to get the current TV and AVR Load Status bytes.
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
             if (res == IARM_RESULT_SUCCESS)
             {
                 LOGWARN("Current RIB Controller IRDB Status: controller_id: %u, network_id: 0x%02X, "
@@ -1686,7 +1687,7 @@ namespace WPEFramework {
             ribRequest.length           = 1;
 
             // Read the RIB IRRF Status to get the current Flags setting
-            res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
+            res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_RCU_IARM_CALL_RIB_REQUEST_GET, (void *)&ribRequest, sizeof(ribRequest));
             if (res == IARM_RESULT_SUCCESS)
             {
                 LOGWARN("Current RIB IR-RF Status: controller_id: %u, network_id: 0x%02X, "
@@ -26,6 +26,9 @@ namespace WPEFramework {
 namespace Plugin {
 namespace Rust {
 
+// responses arrive from the stream thread one after the other, a few pooled messages avoid an allocation per response
+static Core::ProxyPoolType<Web::JSONBodyType<Core::JSONRPC::Message>> messageFactory(4);
+
 RemotePlugin::RemotePlugin(const RustAdapter::Config &conf)
   : m_remotePid(0)
   , m_config(conf)
@@ -87,9 +90,10 @@ RemotePlugin::Deinitialize(PluginHost::IShell *shell)
 }
 
 void
-RemotePlugin::SendTo(uint32_t channel_id, const char *json)
+RemotePlugin::SendTo(uint32_t channel_id, const string& json)
 {
-  auto res = Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>>::Create();
+  auto res = messageFactory.Element();
+  res->Clear();
   res->FromString(json);
   m_service->Submit(channel_id, Core::ProxyType<Core::JSON::IElement>(res));
 }
@@ -213,7 +217,7 @@ WPEFramework::Core::hresult RemotePlugin::Validate(const string& token, const st
 void RemotePlugin::onRead(const Response& rsp)
 {
     LOGDBG("RemotePlugin::onRead response: channel_id=%u, json=\"%s\"", rsp.channel_id, rsp.json.c_str());
-    SendTo(rsp.channel_id, rsp.json.c_str());
+    SendTo(rsp.channel_id, rsp.json);
 }
 
 int RemotePlugin::LaunchRemoteProcess(const string& rust_shared_lib, const string& host_ip, int port)
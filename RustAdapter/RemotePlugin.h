@@ -135,7 +135,7 @@ public:
 
 private:
   int LaunchRemoteProcess(const string& rust_shared_lib, const string& host_ip, int port);
-  void SendTo(uint32_t channel_id, const char *json);
+  void SendTo(uint32_t channel_id, const string& json);
 
   // we keep a pointer to this to allow rust code to callback into
   // the Adapter and send messages/events asynchronously
@@ -20,11 +20,16 @@
 #include "Logger.h"
 #include <sys/socket.h>
 #include <sys/time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
 #include <netinet/ip.h>
 #include <arpa/inet.h>
 #include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <algorithm>
 
 enum CommandID
 {
@@ -72,10 +77,39 @@ Response::Response(uint32_t channel, const string& json_str)
 
 #define CLIENT_DISCONNECT -2
 
+#define MAX_EVENTS 16
+#define RECEIVE_BUFFER_SIZE (64 * 1024)
+#define MAX_RECEIVE_BUFFER_SIZE (1024 * 1024)
+#define SEND_TIMEOUT_MS 5000
+
+static int SetFlags(int fd, int cmd_get, int cmd_set, int flags)
+{
+  int cur = fcntl(fd, cmd_get, 0);
+  if (cur < 0)
+    return -1;
+  return fcntl(fd, cmd_set, cur | flags);
+}
+
+SocketServer::Client::Client(int fd)
+: socket(fd)
+, buffer(RECEIVE_BUFFER_SIZE)
+, used(0)
+{
+}
+
+SocketServer::Client::~Client()
+{
+  close(socket);
+}
+
 SocketServer::SocketServer()
 : m_serverSocket(0)
-, m_clientSocket(0)
+, m_epoll(-1)
+, m_wakeup(-1)
+, m_nextClient(0)
 , m_running(false)
+, m_inRun(false)
+, m_threadStarted(false)
 , m_address()
 , m_port(0)
 {
@@ -110,46 +144,67 @@ int SocketServer::Open(const string& address, int port, const function<void (con
   if (rc == 0)
   {
     LOGERR("SocketServer::Open inet_pton %s invalid ip format", address.c_str());
+    close(sock);
     return -1;
   }
   else if (rc < 0)
   {
     LOGERR("SocketServer::Open inet_pton %s failed: %s", address.c_str(), strerror(errno));
+    close(sock);
     return -1;
   }
   
   LOGDBG("SocketServer::Open host_ip=%s sin_addr=%d (note that INADDR_ANY=%d)", address.c_str(), addr.sin_addr.s_addr, INADDR_ANY);
 
-  int sock_flags = fcntl (sock, F_GETFD, 0);
-  if (sock_flags < 0)
-  {
-    LOGERR("SocketServer::Open fcntl get failed: %s", strerror(errno));
-    return -1;
-  }
-
-  sock_flags |= FD_CLOEXEC;
-
-  if (fcntl(sock, F_SETFD, sock_flags) < 0)
+  if (SetFlags(sock, F_GETFD, F_SETFD, FD_CLOEXEC) < 0)
   {
     LOGERR("SocketServer::Open fcntl set failed: %s", strerror(errno));
+    close(sock);
     return -1;
   }
 
   if (bind(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0)
   {
     LOGERR("SocketServer::Open bind failed: %s", strerror(errno));
+    close(sock);
     return -1;
   }
 
-  if (listen(sock, 4) < 0)
+  if (listen(sock, 16) < 0)
   {
     LOGERR("SocketServer::Open listen failed: %s", strerror(errno));
+    close(sock);
+    return -1;
+  }
+
+  m_epoll = epoll_create1(EPOLL_CLOEXEC);
+  m_wakeup = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+  if (m_epoll < 0 || m_wakeup < 0)
+  {
+    LOGERR("SocketServer::Open epoll setup failed: %s", strerror(errno));
+    if (m_epoll >= 0)
+      close(m_epoll);
+    if (m_wakeup >= 0)
+      close(m_wakeup);
+    m_epoll = -1;
+    m_wakeup = -1;
+    close(sock);
     return -1;
   }
 
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.fd = sock;
+  epoll_ctl(m_epoll, EPOLL_CTL_ADD, sock, &ev);
+  ev.data.fd = m_wakeup;
+  epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &ev);
+
   m_reader = reader;
   m_serverSocket = sock;
   m_address = address;
+  m_running = true;
 
   if (port)
   {
@@ -180,6 +235,7 @@ int SocketServer::RunThread()
     LOGERR("SocketServer::Open failed to create thread: %s",strerror(errno));
     return -1;
   }
+  m_threadStarted = true;
   return 0;
 }
 
@@ -192,151 +248,330 @@ void* SocketServer::RunThreadFunc(void* arg)
 
 int SocketServer::Run()
 {
-  if (m_serverSocket <= 0 || m_running)
+  if (m_serverSocket <= 0 || m_inRun)
     return -1;
 
-  m_running = true;
+  m_inRun = true;
 
   while (m_running)
   {
-    fd_set m_readSet;
-    fd_set m_exceptSet;
-    struct timeval tv;
-    int res;
-
-    FD_ZERO(&m_readSet);
-    FD_ZERO(&m_exceptSet);
-    FD_SET(m_serverSocket, &m_readSet);
-    FD_SET(m_serverSocket, &m_exceptSet);    
-    if (m_clientSocket)
-    {
-      FD_SET(m_clientSocket, &m_readSet);
-      FD_SET(m_clientSocket, &m_exceptSet);    
-    }
+    struct epoll_event events[MAX_EVENTS];
 
-    tv.tv_sec = 10;
-    tv.tv_usec = 0;
-    res = select((m_clientSocket > m_serverSocket ? m_clientSocket : m_serverSocket) + 1, 
-                 &m_readSet, NULL, &m_exceptSet, &tv);
+    int res = epoll_wait(m_epoll, events, MAX_EVENTS, 10000);
 
     if (!m_running)
       break;
 
     if (res < 0)
     {
-      LOGERR("SocketServer::Open select failed: %s", strerror(errno));
+      if (errno == EINTR)
+        continue;
+      LOGERR("SocketServer::Run epoll_wait failed: %s", strerror(errno));
+      m_inRun = false;
       return -1;
     }
 
-    if (res == 0)
-      continue;
-
-    if (FD_ISSET(m_serverSocket, &m_readSet))
+    for (int i = 0; i < res; i++)
     {
-      int clsock;
-      struct sockaddr_in claddr;
-      socklen_t cllen;
-      
-      cllen = sizeof(claddr);
-      memset(&claddr, 0, cllen);
-      
-      clsock = accept(m_serverSocket, (struct sockaddr*)&claddr, &cllen);
-      if (clsock < 0)
+      int fd = events[i].data.fd;
+
+      if (fd == m_wakeup)
       {
-        LOGERR("SocketServer::Open accept failed: %s", strerror(errno));
+        uint64_t count;
+        if (read(m_wakeup, &count, sizeof(count)) < 0)
+          LOGDBG("SocketServer::Run wakeup already consumed");
+        continue;
       }
-      else
+
+      if (fd == m_serverSocket)
       {
-        LOGDBG("SocketServer::Open client connected");
-        m_clientSocket = clsock;
+        Accept();
+        continue;
       }
-    }
 
-    if (m_clientSocket)
-    {
-      if (FD_ISSET(m_clientSocket, &m_readSet))
+      ClientPtr client;
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto it = m_clients.find(fd);
+        if (it != m_clients.end())
+          client = it->second;
+      }
+
+      if (!client)
+        continue;
+
+      int rc = CLIENT_DISCONNECT;
+      if (events[i].events & EPOLLIN)
+        rc = Receive(*client);
+
+      if (rc < 0)
       {
-        Response rsp;
-        int rc = ReadResponse(rsp);
-        if (rc >= 0)
-        {
-          m_reader(rsp);
-        }
-        else if (rc == CLIENT_DISCONNECT)
-        {
-          LOGDBG("SocketServer::Open client disconnected");
-          close(m_clientSocket);
-          m_clientSocket = 0;
-        }
+        LOGDBG("SocketServer::Run client %d disconnected", fd);
+        Disconnect(fd);
       }
     }
   }
+
+  m_inRun = false;
   return 0;
 }
 
-string SocketServer::GetAddress() const
+void SocketServer::Accept()
 {
-  return m_address;
+  struct sockaddr_in claddr;
+  socklen_t cllen = sizeof(claddr);
+  memset(&claddr, 0, cllen);
+
+  int clsock = accept(m_serverSocket, (struct sockaddr*)&claddr, &cllen);
+  if (clsock < 0)
+  {
+    LOGERR("SocketServer::Accept accept failed: %s", strerror(errno));
+    return;
+  }
+
+  if (SetFlags(clsock, F_GETFD, F_SETFD, FD_CLOEXEC) < 0 || SetFlags(clsock, F_GETFL, F_SETFL, O_NONBLOCK) < 0)
+  {
+    LOGERR("SocketServer::Accept fcntl set failed: %s", strerror(errno));
+    close(clsock);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_lock);
+
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN | EPOLLRDHUP;
+  ev.data.fd = clsock;
+
+  if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, clsock, &ev) < 0)
+  {
+    LOGERR("SocketServer::Accept epoll_ctl failed: %s", strerror(errno));
+    close(clsock);
+    return;
+  }
+
+  m_clients[clsock] = std::make_shared<Client>(clsock);
+  LOGDBG("SocketServer::Accept client %d connected, %zu clients", clsock, m_clients.size());
 }
 
-int SocketServer::GetPort() const
+void SocketServer::Disconnect(int fd)
 {
-  return m_port; 
+  std::lock_guard<std::mutex> lock(m_lock);
+
+  auto it = m_clients.find(fd);
+  if (it == m_clients.end())
+    return;
+
+  for (auto channel = m_channels.begin(); channel != m_channels.end(); )
+  {
+    if (channel->second == it->second)
+      channel = m_channels.erase(channel);
+    else
+      ++channel;
+  }
+
+  epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+  // fails senders that still hold the client, the descriptor is closed with the last reference
+  shutdown(fd, SHUT_RDWR);
+  m_clients.erase(it);
 }
 
-void SocketServer::Close()
+int SocketServer::Receive(Client& client)
 {
-  if (m_serverSocket > 0)
+  if (client.used == client.buffer.size())
   {
-    if (m_running)
+    if (client.buffer.size() >= MAX_RECEIVE_BUFFER_SIZE)
     {
-      m_running = false;
+      LOGERR("SocketServer::Receive buffer full: used=%zu", client.used);
+      return -1;
+    }
+    client.buffer.resize(std::min(client.buffer.size() * 2, (size_t)MAX_RECEIVE_BUFFER_SIZE));
+  }
+
+  ssize_t num = read(client.socket, client.buffer.data() + client.used, client.buffer.size() - client.used);
+
+  if (num == 0)
+    return CLIENT_DISCONNECT;
+
+  if (num < 0)
+  {
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+      return 0;
+    LOGERR("SocketServer::Receive read failed: %s", strerror(errno));
+    return -1;
+  }
+
+  client.used += (size_t)num;
+
+  size_t offset = 0;
+
+  while (client.used - offset >= sizeof(ResponseHeader))
+  {
+    ResponseHeader header;
+    memcpy(&header, client.buffer.data() + offset, sizeof(header));
+
+    uint32_t json_len = ntohl(header.json_len);
+
+    size_t frame = sizeof(ResponseHeader) + (size_t)json_len;
+
+    if (frame > MAX_RECEIVE_BUFFER_SIZE)
+    {
+      LOGERR("SocketServer::Receive response too large: json_len=%u", json_len);
+      return -1;
+    }
+
+    if (client.used - offset < frame)
+    {
+      if (frame > client.buffer.size())
+        client.buffer.resize(frame);
+      break;
+    }
+
+    m_response.channel_id = ntohl(header.channel_id);
+    m_response.json.assign((const char*)client.buffer.data() + offset + sizeof(ResponseHeader), json_len);
+
+    m_reader(m_response);
+    offset += frame;
+  }
+
+  if (offset > 0)
+  {
+    memmove(client.buffer.data(), client.buffer.data() + offset, client.used - offset);
+    client.used -= offset;
+
+    // give back what a large response needed once it has been handled
+    if (client.buffer.size() > RECEIVE_BUFFER_SIZE && client.used <= RECEIVE_BUFFER_SIZE)
+    {
+      client.buffer.resize(RECEIVE_BUFFER_SIZE);
+      client.buffer.shrink_to_fit();
     }
-    close(m_clientSocket);
-    close(m_serverSocket);
-    m_serverSocket = 0;
   }
+
+  return 0;
 }
 
-int SocketServer::ReadExact(uint8_t* p, int len)
+void SocketServer::Wakeup()
 {
-  if (m_serverSocket <= 0 || m_clientSocket <= 0)
-    return -1;
+  uint64_t one = 1;
+  if (m_wakeup >= 0 && write(m_wakeup, &one, sizeof(one)) < 0)
+    LOGDBG("SocketServer::Wakeup already pending");
+}
+
+SocketServer::ClientPtr SocketServer::GetClient(uint32_t channel_id, bool bind)
+{
+  std::lock_guard<std::mutex> lock(m_lock);
 
-  int remaining = len;
+  auto channel = m_channels.find(channel_id);
+  if (channel != m_channels.end())
+    return channel->second;
+
+  if (!bind || m_clients.empty())
+    return nullptr;
+
+  // spread new channels over the connected processes
+  auto it = m_clients.begin();
+  std::advance(it, m_nextClient++ % m_clients.size());
+  m_channels[channel_id] = it->second;
+
+  return it->second;
+}
+
+int SocketServer::WriteFrame(Client& client, struct iovec* iov, int iovcnt)
+{
+  std::lock_guard<std::mutex> lock(client.send_lock);
 
-  while (remaining > 0)
+  while (iovcnt > 0)
   {
-    int num = (int)read(m_clientSocket, p, remaining);
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
 
-    if (num <= 0)
+    ssize_t num = sendmsg(client.socket, &msg, MSG_NOSIGNAL);
+
+    if (num < 0)
     {
-        LOGERR("SocketServer::ReadExact failed: num=%d", num);
+      if (errno == EINTR)
+        continue;
 
-        if (num == 0)
-          return CLIENT_DISCONNECT;
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+      {
+        struct pollfd pfd = { client.socket, POLLOUT, 0 };
+        if (poll(&pfd, 1, SEND_TIMEOUT_MS) > 0)
+          continue;
+      }
 
-        return -1;
+      LOGERR("SocketServer::WriteFrame failed: %s", strerror(errno));
+      return -1;
     }
-    else
+
+    // partial write, continue after the last byte that went out
+    while (iovcnt > 0 && (size_t)num >= iov->iov_len)
     {
-      p += num;
-      remaining -= num;
+      num -= iov->iov_len;
+      iov++;
+      iovcnt--;
+    }
+
+    if (iovcnt > 0)
+    {
+      iov->iov_base = (uint8_t*)iov->iov_base + num;
+      iov->iov_len -= num;
     }
   }
 
-  if (remaining != 0)
+  return 0;
+}
+
+string SocketServer::GetAddress() const
+{
+  return m_address;
+}
+
+int SocketServer::GetPort() const
+{
+  return m_port; 
+}
+
+size_t SocketServer::GetClientCount() const
+{
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_clients.size();
+}
+
+void SocketServer::Close()
+{
+  if (m_serverSocket > 0)
   {
-    LOGERR("SocketServer::ReadExact: failed: remaining=%d", remaining);
-    return -1;
-  }
+    m_running = false;
+    Wakeup();
+
+    if (m_threadStarted && !pthread_equal(m_thread, pthread_self()))
+    {
+      pthread_join(m_thread, nullptr);
+      m_threadStarted = false;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      m_channels.clear();
+      m_clients.clear();
+    }
 
-  return len;
+    close(m_serverSocket);
+    close(m_epoll);
+    close(m_wakeup);
+    m_serverSocket = 0;
+    m_epoll = -1;
+    m_wakeup = -1;
+  }
 }
 
 int SocketServer::SendInvoke(uint32_t channel_id, const string& token, const string& json)
 {
-  if (m_serverSocket <= 0 || m_clientSocket <= 0)
+  ClientPtr client = GetClient(channel_id, true);
+
+  if (!client)
     return -1;
   
   InvoketHeader header = {
@@ -346,38 +581,25 @@ int SocketServer::SendInvoke(uint32_t channel_id, const string& token, const str
     htonl((uint32_t)json.length())
   };
 
-  int num = send(m_clientSocket, &header, sizeof(header), MSG_NOSIGNAL);
-  if (num != sizeof(header))
-  {
-    LOGERR("SocketServer::SendInvoke failed to send header: num=%d", num);
-    return -1;
-  }
-
-  if (token.length() > 0)
-  {
-    num = send(m_clientSocket, token.c_str(), token.length(), MSG_NOSIGNAL);
-    if (num != (ssize_t)token.length())
-    {
-      LOGERR("SocketServer::SendInvoke failed to send token: num=%d", num);
-      return -1;
-    }
-  }
+  struct iovec iov[3] = {
+    { &header, sizeof(header) },
+    { (void*)token.c_str(), token.length() },
+    { (void*)json.c_str(), json.length() }
+  };
 
-  if (json.length() > 0)
+  if (WriteFrame(*client, iov, 3) < 0)
   {
-    num = send(m_clientSocket, json.c_str(), json.length(), MSG_NOSIGNAL);
-    if (num != (ssize_t)json.length())
-    {
-      LOGERR("SocketServer::SendInvoke failed to send json: num=%d", num);
-      return -1;
-    }
+    LOGERR("SocketServer::SendInvoke failed on channel %u", channel_id);
+    return -1;
   }
   return 0;
 }
 
 int SocketServer::SendAttach(uint32_t channel_id, bool attach)
 {
-  if (m_serverSocket <= 0 || m_clientSocket <= 0)
+  ClientPtr client = GetClient(channel_id, attach);
+
+  if (!client)
     return -1;
 
   AttachHeader header = {
@@ -386,67 +608,49 @@ int SocketServer::SendAttach(uint32_t channel_id, bool attach)
     attach ? (uint8_t)1 : (uint8_t)0
   };
 
-  int num = send(m_clientSocket, &header, sizeof(header), MSG_NOSIGNAL);
-  if (num != sizeof(header))
+  struct iovec iov = { &header, sizeof(header) };
+
+  int rc = WriteFrame(*client, &iov, 1);
+
+  if (!attach)
   {
-    LOGERR("SocketServer::SendAttach failed to send header: num=%d", num);
-    return -1;
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_channels.erase(channel_id);
   }
-  return 0;
-}
-
-int SocketServer::SendExit()
-{
-  if (m_serverSocket <= 0 || m_clientSocket <= 0)
-    return -1;
 
-  uint32_t command_id = htonl(ID_EXIT);
-  int num = send(m_clientSocket, &command_id, sizeof(command_id), MSG_NOSIGNAL);
-  if (num != sizeof(command_id))
+  if (rc < 0)
   {
-    LOGERR("SocketServer::SendExit failed: num=%d", num);
+    LOGERR("SocketServer::SendAttach failed on channel %u", channel_id);
     return -1;
   }
-
-  /*break out of reader thread*/
-  m_running = false;
-
   return 0;
 }
 
-int SocketServer::ReadResponse(Response& rsp)
+int SocketServer::SendExit()
 {
-  if (m_serverSocket <= 0 || m_clientSocket <= 0)
-    return -1;
-
-  ResponseHeader header;
-  int rc;
-
-  if ((rc = ReadExact((uint8_t*)&header, (int)sizeof(ResponseHeader))) <= 0)
+  std::vector<ClientPtr> clients;
   {
-    return rc;
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (auto& client : m_clients)
+      clients.push_back(client.second);
   }
 
-  rsp.channel_id = ntohl(header.channel_id);
-  header.json_len = ntohl(header.json_len);
-
-  LOGDBG("SocketServer::ReadResponse read header: channel_id=%u, json_len=%u", 
-    rsp.channel_id, header.json_len);
+  int rc = clients.empty() ? -1 : 0;
 
-  if (header.json_len > 0)
+  for (auto& client : clients)
   {
-    uint8_t* buffer;
-    buffer = (uint8_t*)malloc(header.json_len+1);
-
-    if ((rc = ReadExact(buffer, (int)header.json_len)) <= 0)
+    uint32_t command_id = htonl(ID_EXIT);
+    struct iovec iov = { &command_id, sizeof(command_id) };
+    if (WriteFrame(*client, &iov, 1) < 0)
     {
-      free(buffer);
-      return rc;
+      LOGERR("SocketServer::SendExit failed on client %d", client->socket);
+      rc = -1;
     }
-    
-    buffer[header.json_len] = 0;
-    rsp.json = (char*)buffer;
-    free(buffer);
   }
-  return 0;
+
+  /*break out of reader thread*/
+  m_running = false;
+  Wakeup();
+
+  return rc;
 }
@@ -20,6 +20,10 @@
 
 #include <string>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <pthread.h>
 
 using std::string;
@@ -34,6 +38,15 @@ struct Response
   Response(uint32_t channel, const string& json_str);
 };
 
+/**
+ * Listens for remote Rust plugin processes and exchanges framed messages with them.
+ * Any number of processes can be connected at once; a channel is bound to one of them
+ * when it is attached (or on its first invoke) and all of its traffic goes there.
+ * Invokes are written with a single writev() and do not wait for a response, so many
+ * can be outstanding per channel. Responses are read into a per connection buffer that
+ * is reused and capped at 1 MB, every complete frame in it is passed to the reader from
+ * the Run() thread.
+ */
 class SocketServer
 {
 public:
@@ -48,15 +61,41 @@ public:
   int SendInvoke(uint32_t channel_id, const string& token, const string& json);
   int SendAttach(uint32_t channel_id, bool attach);
   int SendExit();
-  int ReadResponse(Response& cmd);
+  size_t GetClientCount() const;
 private:
-  int ReadExact(uint8_t* p, int len);
+  struct Client
+  {
+    explicit Client(int fd);
+    ~Client();
+
+    int socket;
+    std::mutex send_lock;
+    std::vector<uint8_t> buffer;
+    size_t used;
+  };
+
+  typedef std::shared_ptr<Client> ClientPtr;
+
+  void Accept();
+  void Disconnect(int fd);
+  int Receive(Client& client);
+  void Wakeup();
+  ClientPtr GetClient(uint32_t channel_id, bool bind);
+  static int WriteFrame(Client& client, struct iovec* iov, int iovcnt);
   static void* RunThreadFunc(void* arg);
 
   int m_serverSocket;
-  int m_clientSocket;  
+  int m_epoll;
+  int m_wakeup;
+  mutable std::mutex m_lock;
+  std::map<int, ClientPtr> m_clients;
+  std::map<uint32_t, ClientPtr> m_channels;
+  size_t m_nextClient;
   function<void (const Response&)> m_reader;
-  bool m_running;
+  Response m_response;
+  volatile bool m_running;
+  bool m_inRun;
+  bool m_threadStarted;
   pthread_t m_thread;
   string m_address;
   int m_port;
@@ -21,7 +21,7 @@
 
 #include "Module.h"
 
-#include <regex>
+#include <unordered_map>
 
 // helper functions
 namespace {
@@ -46,26 +46,6 @@ namespace {
         return regex;
     }
     
-    string CreateUrlRegex(const string& input)
-    {
-        string regex = input;
-        
-        // order of replacing is important
-        ReplaceString(regex,"/","\\/");
-        ReplaceString(regex,"[","\\[");
-        ReplaceString(regex,"]","\\]");
-        ReplaceString(regex,":*",":[0-9]+");
-        ReplaceString(regex,"*:","[a-z]+:");
-        ReplaceString(regex,".","\\.");
-        ReplaceString(regex,"*","[a-zA-Z0-9\\.\\-]*");
-        regex.insert(regex.begin(),'(');
-        regex.insert(regex.end(),')');
-        regex.insert(regex.begin(),'^');
-        regex.insert(regex.end(),'$');
-        
-        return regex;
-    }
-
     string GetUrlOrigin(const string& input)
     {
         // see https://tools.ietf.org/html/rfc3986
@@ -103,6 +83,221 @@ namespace Plugin {
             BLOCKED,
             ALLOWED
         };
+
+        // ACL patterns only know literal characters and '*', so they are compiled once into a list of steps
+        // and matched by walking all candidate positions in parallel (a small NFA), no backtracking and no
+        // std::regex construction per check. The rules for '*' are the ones the regular expressions used
+        // before: in a callsign or method it is [a-zA-Z0-9.]*, in a URL it is [a-z]+ when followed by ':'
+        // (the scheme), [0-9]+ when preceded by ':' (the port) and [a-zA-Z0-9.-]* otherwise.
+        class Pattern {
+        private:
+            enum class charset : uint8_t {
+                NAME,
+                HOST,
+                SCHEME,
+                PORT
+            };
+
+            struct Step {
+                enum kind : uint8_t {
+                    LITERAL,
+                    ONE,
+                    ANY
+                };
+
+                kind Kind;
+                charset Set;
+                TCHAR Literal;
+            };
+
+        public:
+            Pattern& operator=(const Pattern&) = delete;
+            Pattern(const Pattern&) = default;
+
+            static Pattern Name(const string& input)
+            {
+                Pattern result;
+                for (const TCHAR character : input) {
+                    if (character == '*') {
+                        result.Add(Step::ANY, charset::NAME);
+                    } else {
+                        result.Add(character);
+                    }
+                }
+                return (result);
+            }
+            static Pattern Origin(const string& input)
+            {
+                Pattern result;
+                for (string::size_type index = 0; index < input.length(); index++) {
+                    const TCHAR character = input[index];
+                    const TCHAR next = (index + 1 < input.length() ? input[index + 1] : '\0');
+
+                    if ((character == ':') && (next == '*')) {
+                        result.Add(character);
+                        result.Add(Step::ONE, charset::PORT);
+                        result.Add(Step::ANY, charset::PORT);
+                        index++;
+                    } else if ((character == '*') && (next == ':')) {
+                        result.Add(Step::ONE, charset::SCHEME);
+                        result.Add(Step::ANY, charset::SCHEME);
+                    } else if (character == '*') {
+                        result.Add(Step::ANY, charset::HOST);
+                    } else {
+                        result.Add(character);
+                    }
+                }
+                return (result);
+            }
+
+        public:
+            bool Matches(const string& input) const
+            {
+                // active[i] means steps [0, i) can have consumed the input seen so far.
+                std::vector<bool> active(_steps.size() + 1, false);
+                std::vector<bool> next(_steps.size() + 1, false);
+
+                active[0] = true;
+                Close(active);
+
+                for (const TCHAR character : input) {
+                    bool alive = false;
+                    std::fill(next.begin(), next.end(), false);
+
+                    for (uint16_t index = 0; index < _steps.size(); index++) {
+                        if (active[index] == true) {
+                            const Step& step(_steps[index]);
+                            if (step.Kind == Step::LITERAL) {
+                                if (step.Literal == character) {
+                                    next[index + 1] = alive = true;
+                                }
+                            } else if (Contains(step.Set, character) == true) {
+                                next[step.Kind == Step::ANY ? index : index + 1] = alive = true;
+                            }
+                        }
+                    }
+
+                    if (alive == false) {
+                        return (false);
+                    }
+                    Close(next);
+                    active.swap(next);
+                }
+
+                return (active[_steps.size()]);
+            }
+
+        private:
+            Pattern()
+                : _steps()
+            {
+            }
+
+            void Add(const TCHAR literal)
+            {
+                _steps.push_back({ Step::LITERAL, charset::NAME, literal });
+            }
+            void Add(const Step::kind kind, const charset set)
+            {
+                _steps.push_back({ kind, set, '\0' });
+            }
+            void Close(std::vector<bool>& states) const
+            {
+                // An ANY step may match nothing, so reaching it also reaches the step after it.
+                for (uint16_t index = 0; index < _steps.size(); index++) {
+                    if ((states[index] == true) && (_steps[index].Kind == Step::ANY)) {
+                        states[index + 1] = true;
+                    }
+                }
+            }
+            static bool Contains(const charset set, const TCHAR character)
+            {
+                bool result = false;
+
+                switch (set) {
+                case charset::PORT:
+                    result = ((character >= '0') && (character <= '9'));
+                    break;
+                case charset::SCHEME:
+                    result = ((character >= 'a') && (character <= 'z'));
+                    break;
+                case charset::HOST:
+                    result = (character == '-');
+                    // Fall through
+                case charset::NAME:
+                    result = result || (character == '.') || ((character >= '0') && (character <= '9')) || ((character >= 'a') && (character <= 'z')) || ((character >= 'A') && (character <= 'Z'));
+                    break;
+                }
+                return (result);
+            }
+
+        private:
+            std::vector<Step> _steps;
+        };
+
+    private:
+        // Remembers the verdict per (origin, callsign, method), the same few combinations are checked over
+        // and over by a running application. Least recently used entries go first, the whole cache is
+        // dropped when the ACL changes.
+        class VerdictCache {
+        private:
+            using Entries = std::list<std::pair<string, bool>>;
+
+        public:
+            VerdictCache() = delete;
+            VerdictCache(const VerdictCache&) = delete;
+            VerdictCache& operator=(const VerdictCache&) = delete;
+
+            VerdictCache(const uint16_t capacity)
+                : _capacity(capacity)
+                , _entries()
+                , _index()
+            {
+            }
+            ~VerdictCache()
+            {
+            }
+
+        public:
+            static string Key(const string& origin, const string& callsign, const string& method)
+            {
+                string key;
+                key.reserve(origin.length() + callsign.length() + method.length() + 2);
+                key.append(origin).append(1, '\n').append(callsign).append(1, '\n').append(method);
+                return (key);
+            }
+            bool Lookup(const string& key, bool& verdict)
+            {
+                auto entry = _index.find(key);
+                if (entry != _index.end()) {
+                    _entries.splice(_entries.begin(), _entries, entry->second);
+                    verdict = entry->second->second;
+                }
+                return (entry != _index.end());
+            }
+            void Store(const string& key, const bool verdict)
+            {
+                if (_capacity != 0) {
+                    if (_entries.size() >= _capacity) {
+                        _index.erase(_entries.back().first);
+                        _entries.pop_back();
+                    }
+                    _entries.emplace_front(key, verdict);
+                    _index.emplace(key, _entries.begin());
+                }
+            }
+            void Clear()
+            {
+                _index.clear();
+                _entries.clear();
+            }
+
+        private:
+            const uint16_t _capacity;
+            Entries _entries;
+            std::unordered_map<string, Entries::iterator> _index;
+        };
+
     private:
         class EXTERNAL JSONACL : public Core::JSON::Container {
         public:
@@ -273,29 +468,31 @@ namespace Plugin {
                 Plugin(const Plugin&) = delete;
                 Plugin& operator= (const Plugin&) = delete;
 
-                Plugin (const JSONACL::Plugins::Rules& rules)
-                    : _defaultBlocked(rules.Default.Value() == mode::BLOCKED) 
+                Plugin (const string& callsign, const JSONACL::Plugins::Rules& rules)
+                    : _callsign(Pattern::Name(callsign))
+                    , _defaultBlocked(rules.Default.Value() == mode::BLOCKED) 
                     , _methods() {
                     Core::JSON::ArrayType<Core::JSON::String>::ConstIterator index(rules.Methods.Elements());
                     while (index.Next() == true) {
-                        string str = index.Current().Value();
-                        _methods.emplace_back(CreateRegex(str));
+                        _methods.emplace_back(Pattern::Name(index.Current().Value()));
                     }
                 }
                 ~Plugin() {
                 }
 
             public:
+                bool Matches(const string& callsign) const
+                {
+                    return (_callsign.Matches(callsign));
+                }
                 bool Allowed(const string& method) const
                 {
                     bool found = false;
 
-                    std::list<string>::const_iterator index(_methods.begin());
+                    std::list<Pattern>::const_iterator index(_methods.begin());
 
                     while ((index != _methods.end()) && (found == false)) { 
-                        std::regex expression(index->c_str());
-                        std::smatch matchList;
-                        found = std::regex_match(method, matchList, expression);
+                        found = index->Matches(method);
                         if (found == false) {
                             index++;
                         }
@@ -304,8 +501,9 @@ namespace Plugin {
                 }
 
             private:
+                Pattern _callsign;
                 bool _defaultBlocked;
-                std::list<string> _methods;
+                std::list<Pattern> _methods;
             };
 
         public:
@@ -319,10 +517,12 @@ namespace Plugin {
             {
                 JSONACL::Plugins::Iterator index(plugins.Elements());
           
+                // Keyed by the expression the pattern used to be, which keeps the order in which overlapping
+                // patterns are tried the same.
                 while (index.Next() == true) {
                     _plugins.emplace(std::piecewise_construct,
                             std::forward_as_tuple(CreateRegex(index.Key())),
-                            std::forward_as_tuple(index.Current()));
+                            std::forward_as_tuple(index.Key(), index.Current()));
                 }
             }
             ~Filter()
@@ -336,9 +536,7 @@ namespace Plugin {
 
                 std::map<string, Plugin>::const_iterator index(_plugins.begin());
                 while ((index != _plugins.end()) && (pluginFound == false)) {
-                    std::regex expression(index->first.c_str());
-                    std::smatch matchList;
-                    pluginFound = std::regex_match(callsign, matchList, expression);
+                    pluginFound = index->second.Matches(callsign);
                     if (pluginFound == false) {
                         index++;
                     }
@@ -353,17 +551,20 @@ namespace Plugin {
         };
 
         using URLList = std::list<std::pair<string, Filter&>>;
+        using OriginList = std::list<std::pair<Pattern, Filter&>>;
         using Iterator = Core::IteratorType<const std::list<string>, const string&, std::list<string>::const_iterator>;
 
     public:
         AccessControlList(const AccessControlList&) = delete;
         AccessControlList& operator=(const AccessControlList&) = delete;
 
-        AccessControlList()
+        AccessControlList(const uint16_t verdictCacheSize = 512)
             : _urlMap()
+            , _originMap()
             , _filterMap()
             , _unusedRoles()
             , _undefinedURLS()
+            , _verdicts(verdictCacheSize)
         {
         }
         ~AccessControlList()
@@ -383,6 +584,8 @@ namespace Plugin {
         {
             Core::SafeSyncType<Core::CriticalSection> lock(_adminLock);
 
+            _verdicts.Clear();
+            _originMap.clear();
             _urlMap.clear();
             _filterMap.clear();
             _unusedRoles.clear();
@@ -395,16 +598,10 @@ namespace Plugin {
             Core::SafeSyncType<Core::CriticalSection> lock(_adminLock);
 
             const Filter* result = nullptr;
-            std::smatch matchList;
-            URLList::const_iterator index = _urlMap.begin();
-
-            while ((index != _urlMap.end()) && (result == nullptr)) {
-                // regex_search() for searching the regex pattern
-                // 'r' in the string 's'. 'm' is flag for determining
-                // matching behavior.
-                std::regex expression(index->first.c_str());
+            OriginList::const_iterator index = _originMap.begin();
 
-                if (std::regex_search(origin, matchList, expression) == true) {
+            while ((index != _originMap.end()) && (result == nullptr)) {
+                if (index->first.Matches(origin) == true) {
                     result = &(index->second);
                 }
                 else {
@@ -416,11 +613,20 @@ namespace Plugin {
         }
         bool Allowed(const string& URL, const string& callsign, const string& method) const
         {
+            const string key(VerdictCache::Key(GetUrlOrigin(URL), callsign, method));
+            bool result = false;
+
             Core::SafeSyncType<Core::CriticalSection> lock(_adminLock);
 
-            const Filter* filter = FilterMapFromURL(URL);
+            if (_verdicts.Lookup(key, result) == false) {
+                const Filter* filter = FilterMapFromURL(URL);
+
+                result = ((filter != nullptr) && (filter->Allowed(callsign, method)));
 
-            return ((filter != nullptr) && (filter->Allowed(callsign, method)));
+                _verdicts.Store(key, result);
+            }
+
+            return (result);
         }
         uint32_t Load(Core::File& source)
         {
@@ -431,6 +637,7 @@ namespace Plugin {
                 SYSLOG(Logging::ParsingError, (_T("Parsing failed with %s"), ErrorDisplayMessage(error.Value()).c_str()));
             }
             Core::SafeSyncType<Core::CriticalSection> lock(_adminLock);
+            _verdicts.Clear();
             _unusedRoles.clear();
 
             JSONACL::Roles::Iterator rolesIndex = controlList.ACL.Elements();
@@ -463,18 +670,19 @@ namespace Plugin {
                 } else {
                     Filter& entry(selectedFilter->second);
                     
-                    // create regex for url
-                    string url_regex = CreateUrlRegex(index.Current().URL.Value());
+                    const string& url(index.Current().URL.Value());
 
                     if (std::find_if(
                             _urlMap.begin(), _urlMap.end(),
                             [&](const std::pair<string, Filter&>& x) {
                                 // check if already exists
-                                return ((x.first == url_regex) && (&x.second == &entry));
+                                return ((x.first == url) && (&x.second == &entry));
                             })
                         == _urlMap.end()) {
                         _urlMap.emplace_back(std::pair<string, Filter&>(
-                            url_regex, entry));
+                            url, entry));
+                        _originMap.emplace_back(std::pair<Pattern, Filter&>(
+                            Pattern::Origin(url), entry));
                     }
 
                     std::list<string>::iterator found = std::find(_unusedRoles.begin(), _unusedRoles.end(), role);
@@ -490,9 +698,12 @@ namespace Plugin {
     private:
 	//_urlMap contains list of entries of urls under "groups" to the allow/block filters set for that role under "thunder"
         URLList _urlMap; 
+        //_originMap holds the same entries with the url compiled for matching
+        OriginList _originMap;
         std::map<string, Filter> _filterMap;
         std::list<string> _unusedRoles;
         std::list<string> _undefinedURLS;
+        mutable VerdictCache _verdicts;
         mutable Core::CriticalSection _adminLock;
     };
 }
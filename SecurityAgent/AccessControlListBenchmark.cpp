@@ -0,0 +1,110 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Cost of AccessControlList::Allowed() for a mix of origins, callsigns and methods, with and without the
+// verdict cache.
+// Usage: AccessControlListBenchmark [acl file, default example_acl.json] [rounds, default 2000]
+
+#include "AccessControlList.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace WPEFramework;
+
+namespace {
+
+static const char* kOrigins[] = {
+    "http://localhost:9998/index.html",
+    "http://127.0.0.1",
+    "file:///usr/share/app/index.html",
+    "https://apps.comcast.com/guide?x=1",
+    "https://metrological.com/store",
+    "https://unknown.example.org/",
+};
+
+static const char* kCallsigns[] = { "DeviceInfo", "JSONRPCPlugin", "Compositor", "Controller", "org.rdk.System" };
+
+static const char* kMethods[] = { "register", "unregister", "systeminfo", "time", "status", "getDeviceInfo" };
+
+template <typename FUNCTION>
+static double measure(int rounds, FUNCTION&& function)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+        function();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / rounds;
+}
+
+static bool load(const string& path, Plugin::AccessControlList& acl)
+{
+    Core::File file(path);
+    return (file.Open(true) == true) && (acl.Load(file) != Core::ERROR_GENERAL);
+}
+
+static uint32_t checkAll(const Plugin::AccessControlList& acl)
+{
+    uint32_t allowed = 0;
+    for (const char* origin : kOrigins)
+        for (const char* callsign : kCallsigns)
+            for (const char* method : kMethods)
+                allowed += acl.Allowed(origin, callsign, method) ? 1 : 0;
+    return allowed;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const string path = (argc > 1) ? argv[1] : "example_acl.json";
+    const int rounds = (argc > 2) ? atoi(argv[2]) : 2000;
+    const size_t checks = (sizeof(kOrigins) / sizeof(kOrigins[0])) * (sizeof(kCallsigns) / sizeof(kCallsigns[0])) * (sizeof(kMethods) / sizeof(kMethods[0]));
+
+    Plugin::AccessControlList uncached(0);
+    Plugin::AccessControlList cached;
+
+    if ((load(path, uncached) == false) || (load(path, cached) == false)) {
+        fprintf(stderr, "Cannot load %s\n", path.c_str());
+        return 1;
+    }
+
+    const uint32_t expected = checkAll(uncached);
+    if (checkAll(cached) != expected) {
+        fprintf(stderr, "Verdicts differ between the cached and the uncached ACL\n");
+        return 1;
+    }
+
+    uint32_t sink = 0;
+    double compiled = measure(rounds, [&]() { sink += checkAll(uncached); });
+    double memoized = measure(rounds, [&]() { sink += checkAll(cached); });
+
+    double reload = measure(rounds / 10 + 1, [&]() {
+        load(path, cached);
+        sink += checkAll(cached);
+    });
+
+    printf("%zu checks per round, %u allowed\n", checks, expected);
+    printf("compiled ACL        %10.1f ns/check\n", compiled / checks);
+    printf("with verdict cache  %10.1f ns/check\n", memoized / checks);
+    printf("reload + cold cache %10.1f us/round\n", reload / 1000.0);
+
+    return (sink != 0) ? 0 : 2;
+}
@@ -23,7 +23,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 1
-#define API_VERSION_NUMBER_PATCH 3
+#define API_VERSION_NUMBER_PATCH 7
 
 namespace WPEFramework {
 
@@ -132,9 +132,11 @@ namespace Plugin {
             }
         }
 
+        _tokens.Configure(config.TokenCacheSize.Value(), config.TokenCacheLifetime.Value());
+
         _dacDir = config.DAC.Value();
         if (!_dacDir.empty()) {
-            _dacDirCallback = Core::ProxyType<DirectoryCallback>::Create(_dacDir, _dac);
+            _dacDirCallback = Core::ProxyType<DirectoryCallback>::Create(_dacDir, _dac, _tokens);
             _dacDirCallback->Updated();
 
             Core::Directory(_dacDir.c_str()).CreatePath();
@@ -193,6 +195,7 @@ namespace Plugin {
         _dispatcher.reset();
         _engine.Release();
 
+        _tokens.Clear();
         _acl.Clear();
 
         if (_dacDirCallback.IsValid()) {
@@ -220,30 +223,65 @@ namespace Plugin {
 
     /* virtual */ PluginHost::ISecurity* SecurityAgent::Officer(const string& token)
     {
-        PluginHost::ISecurity* result = nullptr;
+        // Tokens seen before come with a ready made context, others are validated and decoded.
+        PluginHost::ISecurity* result = _tokens.Lookup(token);
+
+        if (result == nullptr) {
+            auto webToken = JWTFactory::Instance().Element();
+            uint16_t load = webToken->PayloadLength(token);
+
+            // Validate the token
+            if (load != static_cast<uint16_t>(~0)) {
+                // It is potentially a valid token, extract the payload.
+                uint8_t* payload = reinterpret_cast<uint8_t*>(ALLOCA(load));
+
+                load = webToken->Decode(token, load, payload);
 
-        auto webToken = JWTFactory::Instance().Element();
-        uint16_t load = webToken->PayloadLength(token);
+                if (load != static_cast<uint16_t>(~0)) {
+                    // Seems like we extracted a valid payload, time to create an security context
+                    Payload payloadJson;
+                    payloadJson.FromString(string(reinterpret_cast<const TCHAR*>(payload), load));
 
-        // Validate the token
-        if (load != static_cast<uint16_t>(~0)) {
-            // It is potentially a valid token, extract the payload.
-            uint8_t* payload = reinterpret_cast<uint8_t*>(ALLOCA(load));
+                    if (payloadJson.Type.IsSet() && (payloadJson.Type == tokentype::DAC)) {
+                        result = Core::Service<SecurityContext>::Create<SecurityContext>(&_dac, load, payload, _servicePrefix);
+                    } else {
+                        result = Core::Service<SecurityContext>::Create<SecurityContext>(&_acl, load, payload, _servicePrefix);
+                    }
 
-            load = webToken->Decode(token, load, payload);
+                    _tokens.Store(token, result, (payloadJson.Expiry.IsSet() ? payloadJson.Expiry.Value() * Core::Time::MicroSecondsPerSecond : 0));
+                }
+            }
+        }
+        return (result);
+    }
 
+    bool SecurityAgent::Validate(const string& token, string& payload)
+    {
+        bool result = false;
+        PluginHost::ISecurity* context = _tokens.Lookup(token);
+
+        if (context != nullptr) {
+            payload = context->Token();
+            context->Release();
+            result = true;
+        } else {
+            auto webToken = JWTFactory::Instance().Element();
+            uint16_t load = webToken->PayloadLength(token);
+
+            // Validate the token
             if (load != static_cast<uint16_t>(~0)) {
-                // Seems like we extracted a valid payload, time to create an security context
-                Payload payloadJson;
-                payloadJson.FromString(string(reinterpret_cast<const TCHAR*>(payload), load));
-
-                if (payloadJson.Type.IsSet() && (payloadJson.Type == tokentype::DAC)) {
-                    result = Core::Service<SecurityContext>::Create<SecurityContext>(&_dac, load, payload, _servicePrefix);
-                } else {
-                    result = Core::Service<SecurityContext>::Create<SecurityContext>(&_acl, load, payload, _servicePrefix);
+                // It is potentially a valid token, extract the payload.
+                uint8_t* buffer = reinterpret_cast<uint8_t*>(ALLOCA(load));
+
+                load = webToken->Decode(token, load, buffer);
+
+                if (load != static_cast<uint16_t>(~0)) {
+                    payload = string(reinterpret_cast<const TCHAR*>(buffer), load);
+                    result = true;
                 }
             }
         }
+
         return (result);
     }
 
@@ -291,27 +329,16 @@ namespace Plugin {
                 result->Message = _T("Missing token");
 
                 if (request.WebToken.IsSet()) {
-                    auto webToken = JWTFactory::Instance().Element();
-                    const string& token = request.WebToken.Value().Token();
-                    uint16_t load = webToken->PayloadLength(token);
-
-                    // Validate the token
-                    if (load != static_cast<uint16_t>(~0)) {
-                        // It is potentially a valid token, extract the payload.
-                        uint8_t* payload = reinterpret_cast<uint8_t*>(ALLOCA(load));
-
-                        load = webToken->Decode(token, load, payload);
-
-                        if (load == static_cast<uint16_t>(~0)) {
-                            result->ErrorCode = Web::STATUS_FORBIDDEN;
-                            result->Message = _T("Invalid token");
-                        } else {
-                            result->ErrorCode = Web::STATUS_OK;
-                            result->Message = _T("Valid token");
-                            TRACE(Trace::Information, (_T("Token contents: %s"), reinterpret_cast<const TCHAR*>(payload)));
-                        }
+                    string payload;
+
+                    if (Validate(request.WebToken.Value().Token(), payload) == false) {
+                        result->ErrorCode = Web::STATUS_FORBIDDEN;
+                        result->Message = _T("Invalid token");
+                    } else {
+                        result->ErrorCode = Web::STATUS_OK;
+                        result->Message = _T("Valid token");
+                        TRACE(Trace::Information, (_T("Token contents: %s"), payload.c_str()));
                     }
-                
 				}
             }
         }
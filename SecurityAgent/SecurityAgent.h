@@ -21,6 +21,7 @@
 
 #include "Module.h"
 #include "AccessControlList.h"
+#include "TokenCache.h"
 
 #include <interfaces/json/JsonData_SecurityAgent.h>
 
@@ -101,10 +102,14 @@ namespace Plugin {
                 , ACL()
                 , Connector()
                 , DAC()
+                , TokenCacheSize(64)
+                , TokenCacheLifetime(3600)
             {
                 Add(_T("acl"), &ACL);
                 Add(_T("connector"), &Connector);
                 Add(_T("dac"), &DAC);
+                Add(_T("tokencachesize"), &TokenCacheSize);
+                Add(_T("tokencachelifetime"), &TokenCacheLifetime);
             }
             ~Config()
             {
@@ -114,6 +119,8 @@ namespace Plugin {
             Core::JSON::String ACL;
             Core::JSON::String Connector;
             Core::JSON::String DAC;
+            Core::JSON::DecUInt16 TokenCacheSize;
+            Core::JSON::DecUInt32 TokenCacheLifetime;
         };
 
     public:
@@ -131,20 +138,24 @@ namespace Plugin {
             Payload()
                 : Core::JSON::Container()
                 , Type()
+                , Expiry()
             {
                 Add(_T("type"), &Type);
+                Add(_T("exp"), &Expiry);
             }
             ~Payload() = default;
 
         public:
             Core::JSON::EnumType<tokentype> Type;
+            Core::JSON::DecUInt64 Expiry; // Seconds since the epoch, as in the JWT "exp" claim
         };
 
         class DirectoryCallback : public Core::FileSystemMonitor::ICallback {
         public:
-            DirectoryCallback(const string& dir, AccessControlList& acl)
+            DirectoryCallback(const string& dir, AccessControlList& acl, TokenCache& tokens)
                 : _dir(dir)
                 , _acl(acl)
+                , _tokens(tokens)
             {
             }
             void Updated() override
@@ -157,11 +168,14 @@ namespace Plugin {
                         _acl.Load(file);
                     }
                 }
+
+                _tokens.Clear();
             }
 
         private:
             string _dir;
             AccessControlList& _acl;
+            TokenCache& _tokens;
         };
 
     public:
@@ -216,6 +230,9 @@ namespace Plugin {
         uint32_t endpoint_createtoken(const JsonData::SecurityAgent::CreatetokenParamsData& params, JsonData::SecurityAgent::CreatetokenResultInfo& response);
         #endif // DEBUG
         uint32_t endpoint_validate(const JsonData::SecurityAgent::CreatetokenResultInfo& params, JsonData::SecurityAgent::ValidateResultData& response);
+        uint32_t endpoint_tokencache(const JsonObject& params, JsonObject& response);
+
+        bool Validate(const string& token, string& payload);
 
 
     private:
@@ -227,6 +244,7 @@ namespace Plugin {
         string _dacDir;
         AccessControlList _dac;
         Core::ProxyType<DirectoryCallback> _dacDirCallback;
+        TokenCache _tokens;
     };
 
 } // namespace Plugin
@@ -39,10 +39,12 @@ namespace Plugin {
         #endif  
 
         Register<CreatetokenResultInfo,ValidateResultData>(_T("validate"), &SecurityAgent::endpoint_validate, this);
+        Register<JsonObject,JsonObject>(_T("tokencache"), &SecurityAgent::endpoint_tokencache, this);
     }
 
     void SecurityAgent::UnregisterAll()
     {
+        Unregister(_T("tokencache"));
         Unregister(_T("validate"));
         #ifdef SECURITY_TESTING_MODE
         Unregister(_T("createtoken"));
@@ -80,25 +82,26 @@ namespace Plugin {
     uint32_t SecurityAgent::endpoint_validate(const CreatetokenResultInfo& params, ValidateResultData& response)
     {
         uint32_t result = Core::ERROR_NONE;
-        const string& token = params.Token.Value();
-        response.Valid = false;
+        string payload;
 
-        auto webToken = JWTFactory::Instance().Element();
-        uint16_t load = webToken->PayloadLength(token);
+        response.Valid = Validate(params.Token.Value(), payload);
 
-        // Validate the token
-        if (load != static_cast<uint16_t>(~0)) {
-            // It is potentially a valid token, extract the payload.
-            uint8_t* payload = reinterpret_cast<uint8_t*>(ALLOCA(load));
+        return result;
+    }
 
-            load = webToken->Decode(token, load, payload);
+    // Method: tokencache - Statistics of the validated token cache
+    // Return codes:
+    //  - ERROR_NONE: Success
+    uint32_t SecurityAgent::endpoint_tokencache(const JsonObject& params, JsonObject& response)
+    {
+        TokenCache::Statistics counters(_tokens.Counters());
 
-             if (load != static_cast<uint16_t>(~0)) {
-                response.Valid = true;
-            }
-        }
+        response["hits"] = counters.Hits;
+        response["misses"] = counters.Misses;
+        response["evictions"] = counters.Evictions;
+        response["entries"] = counters.Entries;
 
-        return result;
+        return Core::ERROR_NONE;
     }
 
 } // namespace Plugin
@@ -0,0 +1,191 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+#include <list>
+#include <unordered_map>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Security contexts of tokens that passed validation, keyed by the SHA256 of the token. Applications present
+    // the same token on every connection, a hit skips the signature check, the payload parsing and the creation
+    // of a new SecurityContext. An entry lives for the configured lifetime, or until the expiry of the token if
+    // that comes first. Least recently used entries are dropped when the cache is full and all of them when an
+    // ACL is reloaded.
+    class TokenCache {
+    private:
+        struct Entry {
+            string Digest;
+            PluginHost::ISecurity* Context;
+            uint64_t Expiry;
+        };
+
+        using Entries = std::list<Entry>;
+
+    public:
+        struct Statistics {
+            uint32_t Hits;
+            uint32_t Misses;
+            uint32_t Evictions;
+            uint32_t Entries;
+        };
+
+        TokenCache(const TokenCache&) = delete;
+        TokenCache& operator=(const TokenCache&) = delete;
+
+        TokenCache()
+            : _adminLock()
+            , _capacity(64)
+            , _lifetime(3600)
+            , _entries()
+            , _index()
+            , _hits(0)
+            , _misses(0)
+            , _evictions(0)
+        {
+        }
+        ~TokenCache()
+        {
+            Clear();
+        }
+
+    public:
+        // capacity 0 disables the cache, lifetime is in seconds.
+        void Configure(const uint16_t capacity, const uint32_t lifetime)
+        {
+            Clear();
+
+            _adminLock.Lock();
+            _capacity = capacity;
+            _lifetime = lifetime;
+            _adminLock.Unlock();
+        }
+
+        // Returns the cached context with a reference taken for the caller, or nullptr.
+        PluginHost::ISecurity* Lookup(const string& token)
+        {
+            PluginHost::ISecurity* result = nullptr;
+            const string digest(Digest(token));
+            const uint64_t now = Core::Time::Now().Ticks();
+
+            _adminLock.Lock();
+
+            auto index = _index.find(digest);
+            if (index != _index.end()) {
+                if (index->second->Expiry > now) {
+                    _entries.splice(_entries.begin(), _entries, index->second);
+                    result = index->second->Context;
+                    result->AddRef();
+                } else {
+                    index->second->Context->Release();
+                    _entries.erase(index->second);
+                    _index.erase(index);
+                    _evictions++;
+                }
+            }
+
+            if (result != nullptr) {
+                _hits++;
+            } else {
+                _misses++;
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+
+        // expiry is the absolute time (Core::Time ticks) the token stops being valid, 0 if it does not expire.
+        void Store(const string& token, PluginHost::ISecurity* context, const uint64_t expiry)
+        {
+            ASSERT(context != nullptr);
+
+            const string digest(Digest(token));
+            const uint64_t now = Core::Time::Now().Ticks();
+
+            _adminLock.Lock();
+
+            uint64_t until = now + (static_cast<uint64_t>(_lifetime) * Core::Time::MicroSecondsPerSecond);
+            if ((expiry != 0) && (expiry < until)) {
+                until = expiry;
+            }
+
+            if ((_capacity != 0) && (until > now) && (_index.find(digest) == _index.end())) {
+                if (_entries.size() >= _capacity) {
+                    _entries.back().Context->Release();
+                    _index.erase(_entries.back().Digest);
+                    _entries.pop_back();
+                    _evictions++;
+                }
+
+                context->AddRef();
+                _entries.push_front({ digest, context, until });
+                _index.emplace(digest, _entries.begin());
+            }
+
+            _adminLock.Unlock();
+        }
+
+        void Clear()
+        {
+            _adminLock.Lock();
+            for (Entry& entry : _entries) {
+                entry.Context->Release();
+            }
+            _evictions += static_cast<uint32_t>(_entries.size());
+            _entries.clear();
+            _index.clear();
+            _adminLock.Unlock();
+        }
+
+        Statistics Counters() const
+        {
+            _adminLock.Lock();
+            Statistics result = { _hits, _misses, _evictions, static_cast<uint32_t>(_entries.size()) };
+            _adminLock.Unlock();
+
+            return (result);
+        }
+
+    private:
+        static string Digest(const string& token)
+        {
+            Crypto::SHA256 hash;
+            hash.Input(reinterpret_cast<const uint8_t*>(token.c_str()), static_cast<uint16_t>(token.length()));
+
+            return (string(reinterpret_cast<const char*>(hash.Result()), Crypto::SHA256::Length));
+        }
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        uint16_t _capacity;
+        uint32_t _lifetime;
+        Entries _entries;
+        std::unordered_map<string, Entries::iterator> _index;
+        uint32_t _hits;
+        uint32_t _misses;
+        uint32_t _evictions;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -306,7 +306,7 @@ namespace WPEFramework {
 				checkForStandalone = false;
 			}
 			IARM_Bus_SYSMgr_GetSystemStates_Param_t param;
-			IARM_Bus_Call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_GetSystemStates, &param, sizeof(param));
+			Utils::IARM::call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_GetSystemStates, &param, sizeof(param));
 			JsonArray response_arr;
 			for( std::vector<string>::iterator it = pname.begin(); it!= pname.end(); ++it )
 			{
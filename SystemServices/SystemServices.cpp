@@ -66,8 +66,8 @@
 using namespace std;
 
 #define API_VERSION_NUMBER_MAJOR 3
-#define API_VERSION_NUMBER_MINOR 3
-#define API_VERSION_NUMBER_PATCH 2
+#define API_VERSION_NUMBER_MINOR 4
+#define API_VERSION_NUMBER_PATCH 0
 
 #define MAX_REBOOT_DELAY 86400 /* 24Hr = 86400 sec */
 #define TR181_FW_DELAY_REBOOT "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.AutoReboot.fwDelayReboot"
@@ -278,7 +278,7 @@ bool setPowerState(std::string powerState)
         return false;
     }
 
-    IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_SetPowerState,
+    IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_SetPowerState,
         (void*)&param, sizeof(param));
 
     if (res == IARM_RESULT_SUCCESS)
@@ -497,6 +497,7 @@ namespace WPEFramework {
 
             registerMethod("setPrivacyMode", &SystemServices::setPrivacyMode, this);
             registerMethod("getPrivacyMode", &SystemServices::getPrivacyMode, this);
+            registerMethod("getIARMCallStatistics", &SystemServices::getIARMCallStatistics, this);
 
         }
 
@@ -666,7 +667,7 @@ namespace WPEFramework {
             LOGINFO("requestSystemReboot: custom reason: %s, other reason: %s\n", rebootParam.reboot_reason_custom,
                 rebootParam.reboot_reason_other);
 
-            IARM_Result_t iarmcallstatus = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+            IARM_Result_t iarmcallstatus = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                     IARM_BUS_PWRMGR_API_Reboot, &rebootParam, sizeof(rebootParam));
             if(IARM_RESULT_SUCCESS != iarmcallstatus) {
                 LOGWARN("requestSystemReboot: IARM_BUS_PWRMGR_API_Reboot failed with code %d.\n", iarmcallstatus); 
@@ -995,7 +996,7 @@ namespace WPEFramework {
                 param.bufLen = 0;
                 param.type = mfrSERIALIZED_TYPE_MANUFACTURER;
 
-                IARM_Result_t result = IARM_Bus_Call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_GetSerializedData, &param, sizeof(param));
+                IARM_Result_t result = Utils::IARM::call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_GetSerializedData, &param, sizeof(param));
                 param.buffer[param.bufLen] = '\0';
 
                 LOGWARN("SystemService getDeviceInfo param type %d result %s", param.type, param.buffer);
@@ -1131,7 +1132,7 @@ namespace WPEFramework {
 		IARM_Bus_MFRLib_GetSerializedData_Param_t param;
 		param.bufLen = 0;
 		param.type = mfrSERIALIZED_TYPE_PROVISIONED_MODELNAME;
-		IARM_Result_t result = IARM_Bus_Call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_GetSerializedData, &param, sizeof(param));
+		IARM_Result_t result = Utils::IARM::call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_GetSerializedData, &param, sizeof(param));
 		param.buffer[param.bufLen] = '\0';
 		LOGWARN("SystemService getDeviceInfo param type %d result %s", param.type, param.buffer);
 		bool status = false;
@@ -1163,7 +1164,7 @@ namespace WPEFramework {
             IARM_Bus_MFRLib_GetSerializedData_Param_t param;
             param.bufLen = 0;
             param.type = mfrSERIALIZED_TYPE_MANUFACTURING_SERIALNUMBER;
-            IARM_Result_t result = IARM_Bus_Call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_GetSerializedData, &param, sizeof(param));
+            IARM_Result_t result = Utils::IARM::call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_GetSerializedData, &param, sizeof(param));
             param.buffer[param.bufLen] = '\0';
 
             bool status = false;
@@ -1207,7 +1208,7 @@ namespace WPEFramework {
             } else if (!parameter.compare(HARDWARE_ID)) {
                 param.type = mfrSERIALIZED_TYPE_HWID;
             }
-            IARM_Result_t result = IARM_Bus_Call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_GetSerializedData, &param, sizeof(param));
+            IARM_Result_t result = Utils::IARM::call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_GetSerializedData, &param, sizeof(param));
             param.buffer[param.bufLen] = '\0';
 
             LOGWARN("SystemService getDeviceInfo param type %d result %s", param.type, param.buffer);
@@ -1326,7 +1327,7 @@ namespace WPEFramework {
                 LOGWARN("setBootLoaderPattern :%d \n", mfrparam.pattern);
                 if(status == true)
                 {
-                   if (IARM_RESULT_SUCCESS != IARM_Bus_Call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_SetBootLoaderPattern, (void *)&mfrparam, sizeof(mfrparam))){
+                   if (IARM_RESULT_SUCCESS != Utils::IARM::call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_SetBootLoaderPattern, (void *)&mfrparam, sizeof(mfrparam))){
                         status = false;
                    }
                 }
@@ -1348,7 +1349,7 @@ namespace WPEFramework {
 		{
 			IARM_Bus_MFRLib_SetBLSplashScreen_Param_t mfrparam;
 			std::strcpy(mfrparam.path, strBLSplashScreenPath.c_str());
-			IARM_Result_t result = IARM_Bus_Call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_SetBlSplashScreen, (void *)&mfrparam, sizeof(mfrparam));
+			IARM_Result_t result = Utils::IARM::call(IARM_BUS_MFRLIB_NAME, IARM_BUS_MFRLIB_API_SetBlSplashScreen, (void *)&mfrparam, sizeof(mfrparam));
 			if (result != IARM_RESULT_SUCCESS){
 				LOGERR("Update failed. path: %s, fileExists %s, IARM result %d ",strBLSplashScreenPath.c_str(),fileExists ? "true" : "false",result);
 				JsonObject error;
@@ -1437,7 +1438,7 @@ namespace WPEFramework {
                         IARM_Bus_CommonAPI_SysModeChange_Param_t modeParam;
                         stringToIarmMode(oldMode, modeParam.oldMode);
                         stringToIarmMode(m_currentMode, modeParam.newMode);
-                        if (IARM_RESULT_SUCCESS == IARM_Bus_Call(IARM_BUS_DAEMON_NAME,
+                        if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_DAEMON_NAME,
                                     "DaemonSysModeChange", &modeParam, sizeof(modeParam))) {
                             LOGWARN("switched to mode '%s'\n", m_currentMode.c_str());
                             if (MODE_NORMAL != m_currentMode && duration < 0) {
@@ -1742,7 +1743,7 @@ namespace WPEFramework {
 		IARM_Bus_PWRMgr_SetDeepSleepTimeOut_Param_t param;
 		if (parameters.HasLabel("seconds")) {
 			param.timeout = static_cast<unsigned int>(parameters["seconds"].Number());
-			IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+			IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
 					IARM_BUS_PWRMGR_API_SetDeepSleepTimeOut, (void *)&param,
 					sizeof(param));
 
@@ -1774,7 +1775,7 @@ namespace WPEFramework {
                  param.bStandbyMode = parameters["nwStandby"].Boolean();
                  LOGWARN("setNetworkStandbyMode called, with NwStandbyMode : %s\n",
                           (param.bStandbyMode)?("Enabled"):("Disabled"));
-                 IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+                 IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                                         IARM_BUS_PWRMGR_API_SetNetworkStandbyMode, (void *)&param,
                                         sizeof(param));
 
@@ -1808,7 +1809,7 @@ namespace WPEFramework {
             }
             else {
                 IARM_Bus_PWRMgr_NetworkStandbyMode_Param_t param;
-                IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+                IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                                        IARM_BUS_PWRMGR_API_GetNetworkStandbyMode, (void *)&param,
                                        sizeof(param));
                 bool nwStandby = param.bStandbyMode;
@@ -1905,7 +1906,7 @@ namespace WPEFramework {
 	    DeepSleep_WakeupReason_t param;
 	    std::string wakeupReason = "WAKEUP_REASON_UNKNOWN";
 
-	    IARM_Result_t res = IARM_Bus_Call((m_isPwrMgr2RFCEnabled)? IARM_BUS_PWRMGR_NAME : IARM_BUS_DEEPSLEEPMGR_NAME,
+	    IARM_Result_t res = Utils::IARM::call((m_isPwrMgr2RFCEnabled)? IARM_BUS_PWRMGR_NAME : IARM_BUS_DEEPSLEEPMGR_NAME,
 			IARM_BUS_DEEPSLEEPMGR_API_GetLastWakeupReason, (void *)&param,
 			sizeof(param));
 
@@ -1971,7 +1972,7 @@ namespace WPEFramework {
               DeepSleepMgr_WakeupKeyCode_Param_t param;
               uint32_t wakeupKeyCode = 0;
 
-              IARM_Result_t res = IARM_Bus_Call((m_isPwrMgr2RFCEnabled)? IARM_BUS_PWRMGR_NAME : IARM_BUS_DEEPSLEEPMGR_NAME,
+              IARM_Result_t res = Utils::IARM::call((m_isPwrMgr2RFCEnabled)? IARM_BUS_PWRMGR_NAME : IARM_BUS_DEEPSLEEPMGR_NAME,
                          IARM_BUS_DEEPSLEEPMGR_API_GetLastWakeupKeyCode, (void *)&param,
                          sizeof(param));
               if (IARM_RESULT_SUCCESS == res)
@@ -3504,7 +3505,7 @@ namespace WPEFramework {
                 methodType = parameters["param"].String();
                 if (SYSTEM_CHANNEL_MAP == methodType) {
                     LOGERR("methodType : %s\n", methodType.c_str());
-                    IARM_Result_t res = IARM_Bus_Call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_GetSystemStates,
+                    IARM_Result_t res = Utils::IARM::call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_GetSystemStates,
                             &paramGetSysState, sizeof(paramGetSysState));
                     if (IARM_RESULT_SUCCESS != res)
                     {
@@ -3617,7 +3618,7 @@ namespace WPEFramework {
             {
                 std::string currentState = "UNKNOWN";
                 IARM_Bus_PWRMgr_GetPowerState_Param_t param;
-                IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState,
+                IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState,
                     (void*)&param, sizeof(param));
 
                 if (res == IARM_RESULT_SUCCESS) {
@@ -4015,7 +4016,7 @@ namespace WPEFramework {
                 LOGINFO("Got cached powerStateBeforeReboot: '%s'", m_powerStateBeforeReboot.c_str());
             } else {
                 IARM_Bus_PWRMgr_GetPowerStateBeforeReboot_Param_t param;
-                IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+                IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                                        IARM_BUS_PWRMGR_API_GetPowerStateBeforeReboot, (void *)&param,
                                        sizeof(param));
     
@@ -4092,7 +4093,7 @@ namespace WPEFramework {
                     param.pwrMode = powerState;
                     param.srcType = srcType;
                     param.config = config;
-                    IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+                    IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                                            IARM_BUS_PWRMGR_API_SetWakeupSrcConfig, (void *)&param,
                                            sizeof(param));
                     if (IARM_RESULT_SUCCESS == res) {
@@ -4118,7 +4119,7 @@ namespace WPEFramework {
             JsonArray wakeupSrc;
             IARM_Bus_PWRMgr_WakeupSrcConfig_Param_t param;
             bool status = false;
-            IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+            IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                                   IARM_BUS_PWRMGR_API_GetWakeupSrcConfig, (void *)&param,
                                   sizeof(param));
             if (IARM_RESULT_SUCCESS == res) {
@@ -4809,7 +4810,7 @@ namespace WPEFramework {
                 param = fsrFlag;
 
                 LOGINFO("Param %d \n", param);
-                IARM_Result_t res = IARM_Bus_Call(IARM_BUS_MFRLIB_NAME,
+                IARM_Result_t res = Utils::IARM::call(IARM_BUS_MFRLIB_NAME,
                                        IARM_BUS_MFRLIB_API_SetFsrFlag, (void *)&param,
                                        sizeof(param));
                 if (IARM_RESULT_SUCCESS == res) {
@@ -4836,7 +4837,7 @@ namespace WPEFramework {
             bool status = false;
             IARM_Bus_MFRLib_FsrFlag_Param_t param;
 
-            IARM_Result_t res = IARM_Bus_Call(IARM_BUS_MFRLIB_NAME,
+            IARM_Result_t res = Utils::IARM::call(IARM_BUS_MFRLIB_NAME,
                                   IARM_BUS_MFRLIB_API_GetFsrFlag, (void *)&param,
                                   sizeof(param));
             if (IARM_RESULT_SUCCESS == res) {
@@ -4849,6 +4850,46 @@ namespace WPEFramework {
             returnResponse(status);
         }
 
+        /***
+         * @brief : Latency of the IARM calls made by this plugin, per owner and method.
+         * @param1[in] : {"params":{"reset":<bool>}}
+         * @param2[out] : {"result":{"calls":[{"owner":<string>,"method":<string>,"calls":<number>,...}],"success":<bool>}}
+         * @return     : Core::<StatusCode>
+         */
+        uint32_t SystemServices::getIARMCallStatistics(const JsonObject& parameters,
+                JsonObject& response)
+        {
+            LOGINFOMETHOD();
+            Utils::IarmCallStatistics& statistics = Utils::IarmCallStatistics::instance();
+            const Utils::IarmCallStatistics::Entries entries = statistics.entries();
+            JsonArray calls;
+
+            for (const auto& it : entries) {
+                const Utils::IarmCallStatistics::Entry& entry = it.second;
+                JsonObject call;
+                call["owner"] = it.first.first;
+                call["method"] = it.first.second;
+                call["calls"] = static_cast<uint64_t>(entry.calls);
+                call["failures"] = static_cast<uint64_t>(entry.failures);
+                call["timeouts"] = static_cast<uint64_t>(entry.timeouts);
+                call["inFlight"] = entry.inFlight;
+                call["maxInFlight"] = entry.maxInFlight;
+                call["averageUs"] = static_cast<uint64_t>(entry.calls != 0 ? (entry.totalUs / entry.calls) : 0);
+                call["p50Us"] = static_cast<uint64_t>(entry.percentile(50));
+                call["p95Us"] = static_cast<uint64_t>(entry.percentile(95));
+                call["p99Us"] = static_cast<uint64_t>(entry.percentile(99));
+                call["maxUs"] = static_cast<uint64_t>(entry.maxUs);
+                calls.Add(call);
+            }
+            response["calls"] = calls;
+
+            if (parameters.HasLabel("reset") && parameters["reset"].Boolean()) {
+                statistics.reset();
+            }
+
+            returnResponse(true);
+        }
+
 
     } /* namespace Plugin */
 } /* namespace WPEFramework */
@@ -308,6 +308,7 @@ namespace WPEFramework {
                 uint32_t getPrivacyMode(const JsonObject& parameters, JsonObject& response);
                 uint32_t setFSRFlag(const JsonObject& parameters, JsonObject& response);
                 uint32_t getFSRFlag(const JsonObject& parameters, JsonObject& response);
+                uint32_t getIARMCallStatistics(const JsonObject& parameters, JsonObject& response);
         }; /* end of system service class */
     } /* end of plugin */
 } /* end of wpeframework */
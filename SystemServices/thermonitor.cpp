@@ -32,6 +32,7 @@
 
 #include "libIBus.h"
 #include "pwrMgr.h"
+#include "UtilsIarm.h"
 
 /**
 Requirement: a generic IARMBus thermal monitoring class
@@ -65,7 +66,7 @@ namespace WPEFramework {
             bool result = false;
             IARM_Bus_PWRMgr_GetThermalState_Param_t param;
 
-            IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+            IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                     IARM_BUS_PWRMGR_API_GetThermalState, (void *)&param, sizeof(param));
 
             if (res == IARM_RESULT_SUCCESS) {
@@ -84,7 +85,7 @@ namespace WPEFramework {
             bool result = false;
             IARM_Bus_PWRMgr_GetTempThresholds_Param_t param;
 
-            IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+            IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                     IARM_BUS_PWRMGR_API_GetTemperatureThresholds,
                     (void *)&param,
                     sizeof(param));
@@ -109,7 +110,7 @@ namespace WPEFramework {
             param.tempHigh = high;
             param.tempCritical = critical;
 
-            IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+            IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                     IARM_BUS_PWRMGR_API_SetTemperatureThresholds,
                     (void *)&param,
                     sizeof(param));
@@ -129,7 +130,7 @@ namespace WPEFramework {
             bool result = false;
             IARM_Bus_PWRMgr_GetOvertempGraceInterval_Param_t param;
 
-            IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+            IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                     IARM_BUS_PWRMGR_API_GetOvertempGraceInterval,
                     (void *)&param,
                     sizeof(param));
@@ -152,7 +153,7 @@ namespace WPEFramework {
             IARM_Bus_PWRMgr_SetOvertempGraceInterval_Param_t param;
             param.graceInterval = graceInterval;
 
-            IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME,
+            IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME,
                     IARM_BUS_PWRMGR_API_SetOvertempGraceInterval,
                     (void *)&param,
                     sizeof(param));
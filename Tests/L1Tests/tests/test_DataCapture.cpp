@@ -327,3 +327,73 @@ TEST_F(DataCaptureInitializedEnableAudioCaptureEventTest, DISABLED_ShouldUploadD
     serverThread.join();
     socketThread.join();
 }
+
+TEST(DataCaptureStreamTest, RingBufferPassesDataThroughSmallBuffer)
+{
+    Plugin::AudioRingBuffer ring(7);
+    std::vector<unsigned char> input(1000);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = static_cast<unsigned char>(i * 31);
+    }
+
+    std::thread writer([&]() {
+        for (size_t offset = 0; offset < input.size(); offset += 13) {
+            EXPECT_TRUE(ring.write(input.data() + offset, std::min<size_t>(13, input.size() - offset)));
+        }
+        ring.close();
+    });
+
+    std::vector<unsigned char> output;
+    unsigned char chunk[5];
+    size_t length;
+    while ((length = ring.read(chunk, sizeof(chunk))) > 0) {
+        output.insert(output.end(), chunk, chunk + length);
+    }
+    writer.join();
+
+    EXPECT_EQ(output, input);
+    EXPECT_LE(ring.highWatermark(), ring.capacity());
+    EXPECT_FALSE(ring.aborted());
+}
+
+TEST(DataCaptureStreamTest, RingBufferAbortUnblocksWriter)
+{
+    Plugin::AudioRingBuffer ring(4);
+    const unsigned char data[16] = {};
+
+    std::thread writer([&]() {
+        EXPECT_FALSE(ring.write(data, sizeof(data)));
+    });
+
+    ring.abort();
+    writer.join();
+
+    unsigned char chunk[4];
+    EXPECT_EQ(0u, ring.read(chunk, sizeof(chunk)));
+    EXPECT_TRUE(ring.aborted());
+}
+
+TEST(DataCaptureStreamTest, DownsamplerConvertsStereo48kToMono16k)
+{
+    Plugin::PcmDownsampler downsampler(2, 48000, 16000);
+
+    // 48 stereo frames: left = 300, right = 100 -> mono 200
+    std::vector<unsigned char> input;
+    for (int frame = 0; frame < 48; frame++) {
+        input.push_back(300 & 0xff);
+        input.push_back(300 >> 8);
+        input.push_back(100);
+        input.push_back(0);
+    }
+
+    // feed in odd sized pieces to split frames
+    std::vector<unsigned char> output;
+    for (size_t offset = 0; offset < input.size(); offset += 7) {
+        downsampler.process(input.data() + offset, std::min<size_t>(7, input.size() - offset), output);
+    }
+
+    ASSERT_EQ(16u * 2, output.size());
+    for (size_t i = 0; i < output.size(); i += 2) {
+        EXPECT_EQ(200, static_cast<int16_t>(output[i] | (output[i + 1] << 8)));
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "DeviceRegistry.h"
+
+using namespace WPEFramework;
+using Plugin::DeviceRegistry;
+
+namespace {
+// Same as the registry's own limit, one more tombstone moves the horizon.
+const uint64_t MaxTombstones = 64;
+
+DeviceRegistry::Devices Listed(uint64_t first, uint64_t last)
+{
+    DeviceRegistry::Devices devices;
+    for (uint64_t handle = first; handle <= last; handle++) {
+        DeviceRegistry::Device device;
+        device.name = "device-" + std::to_string(handle);
+        devices.emplace_back(handle, device);
+    }
+    return devices;
+}
+}
+
+TEST(DeviceRegistryTest, deltaSinceVersion)
+{
+    DeviceRegistry registry;
+
+    registry.Sync(DeviceRegistry::DISCOVERED, Listed(1, 3));
+    EXPECT_TRUE(registry.IsSynced(DeviceRegistry::DISCOVERED));
+    EXPECT_FALSE(registry.IsSynced(DeviceRegistry::PAIRED));
+
+    const uint64_t since = registry.Version();
+    EXPECT_EQ(3u, since);
+
+    EXPECT_TRUE(registry.Modify(2, [](DeviceRegistry::Device& device) { device.name = "renamed"; }));
+    EXPECT_FALSE(registry.Modify(3, [](DeviceRegistry::Device& device) { device.name = "device-3"; }));
+    registry.Sync(DeviceRegistry::DISCOVERED, Listed(2, 3));
+
+    DeviceRegistry::Devices present;
+    std::vector<uint64_t> removed;
+    uint64_t version = 0;
+    EXPECT_TRUE(registry.Changes(DeviceRegistry::DISCOVERED, since, present, removed, version));
+
+    // Device 2 was renamed back by the sync, device 3 never changed.
+    ASSERT_EQ(1u, present.size());
+    EXPECT_EQ(2u, present[0].first);
+    EXPECT_EQ("device-2", present[0].second.name);
+    EXPECT_EQ(std::vector<uint64_t>({ 1 }), removed);
+    EXPECT_EQ(registry.Version(), version);
+    EXPECT_EQ(since + 3, version);
+
+    present.clear();
+    removed.clear();
+    EXPECT_TRUE(registry.Changes(DeviceRegistry::DISCOVERED, version, present, removed, version));
+    EXPECT_TRUE(present.empty());
+    EXPECT_TRUE(removed.empty());
+}
+
+TEST(DeviceRegistryTest, tombstonesSurviveUntilPruneHorizon)
+{
+    DeviceRegistry registry;
+
+    registry.Sync(DeviceRegistry::DISCOVERED, Listed(1, MaxTombstones));
+    const uint64_t since = registry.Version();
+
+    // Every device leaves the list, exactly as many tombstones as the registry keeps.
+    registry.Sync(DeviceRegistry::DISCOVERED, DeviceRegistry::Devices());
+
+    DeviceRegistry::Devices present;
+    std::vector<uint64_t> removed;
+    uint64_t version = 0;
+    EXPECT_TRUE(registry.Changes(DeviceRegistry::DISCOVERED, since, present, removed, version));
+    EXPECT_TRUE(present.empty());
+    EXPECT_EQ(MaxTombstones, removed.size());
+    EXPECT_EQ(since + MaxTombstones, version);
+
+    // A device paired elsewhere keeps its entry alive.
+    EXPECT_TRUE(registry.Modify(1, [](DeviceRegistry::Device& device) { device.paired = true; }));
+
+    present.clear();
+    removed.clear();
+    EXPECT_TRUE(registry.Changes(DeviceRegistry::PAIRED, since, present, removed, version));
+    ASSERT_EQ(1u, present.size());
+    EXPECT_EQ(1u, present[0].first);
+    EXPECT_EQ(MaxTombstones - 1, removed.size());
+}
+
+TEST(DeviceRegistryTest, fullResyncOlderThanHorizon)
+{
+    DeviceRegistry registry;
+
+    registry.Sync(DeviceRegistry::DISCOVERED, Listed(1, MaxTombstones));
+    const uint64_t listed = registry.Version();
+    registry.Sync(DeviceRegistry::DISCOVERED, DeviceRegistry::Devices());
+    const uint64_t oldest = listed + 1;
+
+    // One more tombstone drops the oldest one, device 1 which left at version listed + 1.
+    registry.Sync(DeviceRegistry::DISCOVERED, Listed(100, 101));
+    registry.Sync(DeviceRegistry::DISCOVERED, Listed(101, 101));
+
+    DeviceRegistry::Devices present;
+    std::vector<uint64_t> removed;
+    uint64_t version = 0;
+    EXPECT_FALSE(registry.Changes(DeviceRegistry::DISCOVERED, listed, present, removed, version));
+    ASSERT_EQ(1u, present.size());
+    EXPECT_EQ(101u, present[0].first);
+    EXPECT_TRUE(removed.empty());
+    EXPECT_EQ(registry.Version(), version);
+
+    // From the horizon on deltas work again, without the pruned device.
+    present.clear();
+    removed.clear();
+    EXPECT_TRUE(registry.Changes(DeviceRegistry::DISCOVERED, oldest, present, removed, version));
+    EXPECT_EQ(1u, present.size());
+    EXPECT_EQ(MaxTombstones, removed.size());
+    EXPECT_EQ(removed.end(), std::find(removed.begin(), removed.end(), 1u));
+    EXPECT_NE(removed.end(), std::find(removed.begin(), removed.end(), 100u));
+
+    // A version the registry never handed out, e.g. from before a restart, gets the full list too.
+    present.clear();
+    removed.clear();
+    EXPECT_FALSE(registry.Changes(DeviceRegistry::DISCOVERED, version + 1, present, removed, version));
+    EXPECT_EQ(1u, present.size());
+    EXPECT_TRUE(removed.empty());
+}
@@ -139,6 +139,7 @@ TEST_F(FrameRateTest, RegisteredMethods)
     EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("getFrmMode")));
     EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("getDisplayFrameRate")));
     EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("setDisplayFrameRate")));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("updateFrameTimes")));
 }
 
 TEST_F(FrameRateTest, setCollectionFrequency_startFpsCollection_stopFpsCollection_updateFps)
@@ -267,3 +268,28 @@ TEST_F(FrameRateInitializedEventTest, onDisplayFrameRateChanged)
     FrameRatePostChange(IARM_BUS_DSMGR_NAME, IARM_BUS_DSMGR_EVENT_DISPLAY_FRAMRATE_POSTCHANGE, &eventData , sizeof(eventData));
     handler.Unsubscribe(0, _T("onDisplayFrameRateChanged"), _T("client.events.onDisplayFrameRateChanged"), message);
 }
+
+TEST_F(FrameRateInitializedEventTest, onFrameTimeEvent)
+{
+    EXPECT_CALL(service, Submit(::testing::_, ::testing::_))
+        .Times(1)
+        .WillOnce(::testing::Invoke(
+            [&](const uint32_t, const Core::ProxyType<Core::JSON::IElement>& json) {
+                string text;
+                EXPECT_TRUE(json->ToString(text));
+                EXPECT_EQ(text, string(_T("{"
+                                          "\"jsonrpc\":\"2.0\","
+                                          "\"method\":\"client.events.onFrameTimeEvent.onFrameTimeEvent\","
+                                          "\"params\":{\"callsign\":\"HtmlApp\",\"frames\":5,\"p50\":18431,\"p95\":50000,\"p99\":50000,"
+                                          "\"max\":50000,\"longFrames\":2,\"jankBursts\":1,\"vsync\":16667}"
+                                          "}")));
+                return Core::ERROR_NONE;
+            }));
+
+    handler.Subscribe(0, _T("onFrameTimeEvent"), _T("client.events.onFrameTimeEvent"), message);
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("startFpsCollection"), _T("{}"), response));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("updateFrameTimes"), _T("{\"frameTimes\":[16667,16667,16667,40000,50000],\"callsign\":\"HtmlApp\"}"), response));
+    EXPECT_EQ(response, string("{\"success\":true}"));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("stopFpsCollection"), _T("{}"), response));
+    handler.Unsubscribe(0, _T("onFrameTimeEvent"), _T("client.events.onFrameTimeEvent"), message);
+}
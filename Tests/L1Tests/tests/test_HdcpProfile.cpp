@@ -154,6 +154,8 @@ TEST_F(HDCPProfileTest, RegisteredMethods)
 {
     EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("getHDCPStatus")));
     EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("getSettopHDCPSupport")));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("getApiLockStatistics")));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("setApiLockStatistics")));
 }
 
 TEST_F(HDCPProfileDsTest, getHDCPStatus_isConnected_false)
@@ -279,6 +281,55 @@ TEST_F(HDCPProfileDsTest, getSettopHDCPSupport_Hdcp_v2x)
                                                      "\\}")));
 }
 
+TEST_F(HDCPProfileDsTest, apiLockStatistics)
+{
+    device::VideoOutputPort videoOutputPort;
+
+    ON_CALL(*p_hostImplMock, getDefaultVideoPortName())
+        .WillByDefault(::testing::Return(string(_T("HDMI0"))));
+    ON_CALL(*p_videoOutputPortConfigImplMock, getPort(::testing::_))
+        .WillByDefault(::testing::ReturnRef(videoOutputPort));
+    ON_CALL(*p_videoOutputPortMock, getHDCPProtocol())
+        .WillByDefault(::testing::Return(dsHDCP_VERSION_2X));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("setApiLockStatistics"), _T("{\"enabled\":true,\"logInterval\":0,\"reset\":true}"), response));
+    EXPECT_EQ(response, _T("{\"success\":true}"));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getSettopHDCPSupport"), _T(""), response));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getSettopHDCPSupport"), _T(""), response));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getApiLockStatistics"), _T(""), response));
+    EXPECT_THAT(response, ::testing::MatchesRegex(_T("\\{"
+                                                     "\"enabled\":true,"
+                                                     "\"logInterval\":0,"
+                                                     "\"methods\":"
+                                                     "\\[\\{"
+                                                     "\"method\":\"getSettopHDCPSupport\","
+                                                     "\"calls\":2,"
+                                                     "\"contended\":0,"
+                                                     "\"unlocks\":0,"
+                                                     "\"waitTotalUs\":[0-9]+,"
+                                                     "\"waitMaxUs\":[0-9]+,"
+                                                     "\"holdTotalUs\":[0-9]+,"
+                                                     "\"holdMaxUs\":[0-9]+"
+                                                     "\\}\\],"
+                                                     "\"success\":true"
+                                                     "\\}")));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("setApiLockStatistics"), _T("{\"enabled\":false,\"logInterval\":100,\"reset\":true}"), response));
+}
+
+TEST_F(HDCPProfileTest, setApiLockStatistics_negativeLogInterval)
+{
+    EXPECT_EQ(Core::ERROR_BAD_REQUEST, handler.Invoke(connection, _T("setApiLockStatistics"), _T("{\"enabled\":true,\"logInterval\":-1}"), response));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getApiLockStatistics"), _T(""), response));
+    EXPECT_THAT(response, ::testing::MatchesRegex(_T("\\{"
+                                                     "\"enabled\":false,"
+                                                     "\"logInterval\":100,"
+                                                     ".*")));
+}
+
 TEST_F(HDCPProfileEventIarmTest, onDisplayConnectionChanged)
 {
     ASSERT_TRUE(dsHdmiEventHandler != nullptr);
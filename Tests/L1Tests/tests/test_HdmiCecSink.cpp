@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "HdmiCecSink.h"
+#include "CecSimulatedBus.h"
 #include "FactoriesImplementation.h"
 #include "IarmBusMock.h"
 #include "ServiceMock.h"
@@ -395,3 +396,180 @@ TEST_F(HdmiCecSinkTest, DISABLED_getCecVersion)
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getCecVersion"), _T("{}"), response));
     EXPECT_EQ(response, string("{\"CECVersion\":\"1.4\",\"success\":true}"));
 }
+
+namespace {
+    /* Logs every frame in order. The first ping holds the line until released,
+     * so the test controls what is queued while a sweep is in progress. */
+    class GatedCecBus : public Plugin::CecTxBus {
+    public:
+        GatedCecBus()
+            : m_firstPing(false, true)
+            , m_release(false, true)
+            , m_held(false)
+        {
+        }
+
+        PingResult ping(int from, int to) override
+        {
+            bool hold = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_log.push_back("ping-" + std::to_string(to));
+                hold = !m_held;
+                m_held = true;
+            }
+            if (hold) {
+                m_firstPing.SetEvent();
+                m_release.Lock(5000);
+            }
+            return (to == 4) ? PING_ACK : PING_NACK;
+        }
+
+        void transmit(const std::string& tag)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_log.push_back(tag);
+        }
+
+        std::vector<std::string> log() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_log;
+        }
+
+        Core::Event m_firstPing;
+        Core::Event m_release;
+
+    private:
+        mutable std::mutex m_mutex;
+        std::vector<std::string> m_log;
+        bool m_held;
+    };
+}
+
+TEST(HdmiCecSinkTxSchedulerTest, coalescesPendingRequests)
+{
+    Plugin::CecSimulatedBus bus(std::chrono::milliseconds(0));
+    Plugin::CecTxScheduler scheduler(bus, 0, 4);
+    Core::Event held(false, true);
+    Core::Event done(false, true);
+    std::mutex gate;
+    std::mutex sentLock;
+    std::vector<int> sent;
+
+    scheduler.start();
+    gate.lock();
+    /* hold the worker so the following requests stay queued */
+    EXPECT_TRUE(scheduler.submit(Plugin::CecTxScheduler::PRIORITY_USER, "", [&]() {
+        held.SetEvent();
+        std::lock_guard<std::mutex> lock(gate);
+    }));
+    ASSERT_EQ(Core::ERROR_NONE, held.Lock(5000));
+
+    EXPECT_TRUE(scheduler.submit(Plugin::CecTxScheduler::PRIORITY_USER, "routing", [&]() { std::lock_guard<std::mutex> lock(sentLock); sent.push_back(1); }));
+    EXPECT_FALSE(scheduler.submit(Plugin::CecTxScheduler::PRIORITY_USER, "routing", [&]() { std::lock_guard<std::mutex> lock(sentLock); sent.push_back(2); }));
+    EXPECT_TRUE(scheduler.submit(Plugin::CecTxScheduler::PRIORITY_USER, "standby", [&]() {
+        {
+            std::lock_guard<std::mutex> lock(sentLock);
+            sent.push_back(3);
+        }
+        done.SetEvent();
+    }));
+    gate.unlock();
+    EXPECT_EQ(Core::ERROR_NONE, done.Lock(5000));
+    scheduler.stop();
+
+    std::lock_guard<std::mutex> lock(sentLock);
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(sent[0], 2);
+    EXPECT_EQ(sent[1], 3);
+    EXPECT_EQ(scheduler.stats().coalesced, 1u);
+}
+
+TEST(HdmiCecSinkTxSchedulerTest, transmitsInlineWhileStoppedAndCountsFailures)
+{
+    Plugin::CecSimulatedBus bus(std::chrono::milliseconds(0));
+    Plugin::CecTxScheduler scheduler(bus, 0, 4);
+    Core::Event done(false, true);
+    std::thread::id caller = std::this_thread::get_id();
+    std::thread::id sender;
+
+    /* stopped: sent on the calling thread, nothing left queued */
+    scheduler.transmit(Plugin::CecTxScheduler::PRIORITY_PROTOCOL, "", [&]() { sender = std::this_thread::get_id(); });
+    EXPECT_EQ(sender, caller);
+    scheduler.transmit(Plugin::CecTxScheduler::PRIORITY_PROTOCOL, "", []() { throw std::runtime_error("nack"); });
+    EXPECT_EQ(scheduler.stats().failed, 1u);
+
+    /* running: sent by the worker, a throwing action does not stop it */
+    scheduler.start();
+    scheduler.transmit(Plugin::CecTxScheduler::PRIORITY_PROTOCOL, "", []() { throw std::runtime_error("nack"); });
+    scheduler.transmit(Plugin::CecTxScheduler::PRIORITY_PROTOCOL, "", [&]() {
+        sender = std::this_thread::get_id();
+        done.SetEvent();
+    });
+    EXPECT_EQ(Core::ERROR_NONE, done.Lock(5000));
+    scheduler.stop();
+
+    EXPECT_NE(sender, caller);
+    EXPECT_EQ(scheduler.stats().failed, 2u);
+    EXPECT_EQ(scheduler.stats().executed[Plugin::CecTxScheduler::PRIORITY_PROTOCOL], 4u);
+}
+
+TEST(HdmiCecSinkTxSchedulerTest, userCommandOvertakesDiscovery)
+{
+    GatedCecBus bus;
+    Plugin::CecTxScheduler scheduler(bus, 0, 4);
+    std::vector<bool> present(15, false);
+    std::vector<int> connected, disconnected;
+
+    scheduler.start();
+
+    std::thread sweep([&]() { scheduler.discover(0, present, connected, disconnected); });
+    ASSERT_EQ(Core::ERROR_NONE, bus.m_firstPing.Lock(5000));
+
+    /* queued behind the poll on the wire, ahead of the rest of the sweep */
+    scheduler.submit(Plugin::CecTxScheduler::PRIORITY_USER, "standby", [&]() { bus.transmit("standby"); });
+    bus.m_release.SetEvent();
+    sweep.join();
+    scheduler.stop();
+
+    std::vector<std::string> log = bus.log();
+    ASSERT_EQ(log.size(), 15u);
+    EXPECT_EQ(log[0], "ping-1");
+    EXPECT_EQ(log[1], "standby");
+    EXPECT_EQ(log[2], "ping-2");
+    EXPECT_EQ(log[14], "ping-14");
+    ASSERT_EQ(connected.size(), 1u);
+    EXPECT_EQ(connected[0], 4);
+}
+
+TEST(HdmiCecSinkTxSchedulerTest, backsOffSilentAddresses)
+{
+    Plugin::CecSimulatedBus bus(std::chrono::milliseconds(0));
+    Plugin::CecTxScheduler scheduler(bus, 0, 4);
+    std::vector<bool> present(15, false);
+
+    bus.attach(4);
+    present[4] = true;
+    scheduler.start();
+    for (int sweep = 0; sweep < 8; sweep++) {
+        std::vector<int> connected, disconnected;
+        scheduler.discover(0, present, connected, disconnected);
+        EXPECT_TRUE(connected.empty());
+        EXPECT_TRUE(disconnected.empty());
+    }
+
+    /* present device is polled every sweep, silent ones after 1, 2, 4, 4, ... sweeps */
+    EXPECT_EQ(bus.pingCount(4), 8u);
+    EXPECT_EQ(bus.pingCount(3), 4u);
+    EXPECT_EQ(bus.pingCount(0), 0u);
+
+    scheduler.resetBackoff(3);
+    bus.attach(3);
+    std::vector<int> connected, disconnected;
+    scheduler.discover(0, present, connected, disconnected);
+    scheduler.stop();
+
+    ASSERT_EQ(connected.size(), 1u);
+    EXPECT_EQ(connected[0], 3);
+}
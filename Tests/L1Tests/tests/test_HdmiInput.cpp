@@ -239,6 +239,29 @@ TEST_F(HdmiInputDsTest, readEDID)
     EXPECT_EQ(response, string("{\"EDID\":\"dGVzdA==\",\"success\":true}"));
 }
 
+TEST_F(HdmiInputDsTest, readEDIDCached)
+{
+    EXPECT_CALL(*p_hdmiInputImplMock, getEDIDBytesInfo(0, ::testing::_))
+        .Times(2)
+        .WillOnce(::testing::Invoke(
+            [&](int iport, std::vector<uint8_t> &edidVec2) {
+                edidVec2 = std::vector<uint8_t>({ 't', 'e', 's', 't' });
+            }))
+        .WillOnce(::testing::Invoke(
+            [&](int iport, std::vector<uint8_t> &edidVec2) {
+                edidVec2 = std::vector<uint8_t>({ 'n', 'e', 'w' });
+            }));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("readEDID"), _T("{\"deviceId\": 0}"), response));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("readEDID"), _T("{\"deviceId\": 0}"), response));
+    EXPECT_EQ(response, string("{\"EDID\":\"dGVzdA==\",\"success\":true}"));
+
+    // A new EDID version is read back from the port.
+    EXPECT_EQ(Core::ERROR_NONE, handlerV2.Invoke(connection, _T("setEdidVersion"), _T("{\"portId\": \"0\", \"edidVersion\":\"HDMI2.0\"}"), response));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("readEDID"), _T("{\"deviceId\": 0}"), response));
+    EXPECT_EQ(response, string("{\"EDID\":\"bmV3\",\"success\":true}"));
+}
+
 TEST_F(HdmiInputDsTest, getRawHDMISPD)
 {
     ON_CALL(*p_hdmiInputImplMock, getHDMISPDInfo(::testing::_,::testing::_))
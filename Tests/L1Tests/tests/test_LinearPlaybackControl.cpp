@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include "LinearPlaybackControl.h"
+
+#include "FactoriesImplementation.h"
+#include "ServiceMock.h"
+
+#include <fstream>
+#include <unistd.h>
+
+using namespace WPEFramework;
+
+using ::testing::NiceMock;
+
+namespace {
+const string mountPoint = _T("/tmp/LinearPlaybackControl");
+const string fccPath = mountPoint + _T("/fcc/");
+
+// The FCC side of the streamfs nodes, on regular files: the plugin writes the nodes in place, and so does this.
+void writeNode(const string& node, const string& value)
+{
+    std::ofstream file(fccPath + node);
+    file << value << std::endl;
+}
+
+void removeNodes()
+{
+    for (const string node : { _T("chan_select0"), _T("seek0"), _T("trick_play0"), _T("stream_status") }) {
+        ::unlink((fccPath + node).c_str());
+    }
+    ::rmdir(fccPath.c_str());
+    ::rmdir(mountPoint.c_str());
+}
+
+string readNode(const string& node)
+{
+    string value;
+    std::ifstream file(fccPath + node);
+    std::getline(file, value);
+    return value;
+}
+}
+
+class LinearPlaybackControlTest : public ::testing::Test {
+protected:
+    Core::ProxyType<Plugin::LinearPlaybackControl> plugin;
+    Core::JSONRPC::Handler& handler;
+    Core::JSONRPC::Connection connection;
+    string response;
+
+    LinearPlaybackControlTest()
+        : plugin(Core::ProxyType<Plugin::LinearPlaybackControl>::Create())
+        , handler(*(plugin))
+        , connection(1, 0)
+    {
+    }
+    virtual ~LinearPlaybackControlTest() = default;
+};
+
+class LinearPlaybackControlInitializedTest : public LinearPlaybackControlTest {
+protected:
+    NiceMock<ServiceMock> service;
+    NiceMock<FactoriesImplementation> factoriesImplementation;
+    PluginHost::IDispatcher* dispatcher;
+    Core::JSONRPC::Message message;
+
+    LinearPlaybackControlInitializedTest()
+        : LinearPlaybackControlTest()
+    {
+        Core::Directory(fccPath.c_str()).CreatePath();
+        writeNode(_T("chan_select0"), _T(""));
+        writeNode(_T("seek0"), _T("0,0,0,0,0"));
+        writeNode(_T("trick_play0"), _T("1"));
+        writeNode(_T("stream_status"), _T("0,0"));
+
+        ON_CALL(service, ConfigLine())
+            .WillByDefault(::testing::Return("{\"mountpoint\":\"" + mountPoint + "\",\"streamfs_enabled\":true}"));
+
+        PluginHost::IFactories::Assign(&factoriesImplementation);
+
+        dispatcher = static_cast<PluginHost::IDispatcher*>(
+            plugin->QueryInterface(PluginHost::IDispatcher::ID));
+        dispatcher->Activate(&service);
+
+        EXPECT_EQ(string(""), plugin->Initialize(&service));
+    }
+
+    virtual ~LinearPlaybackControlInitializedTest() override
+    {
+        plugin->Deinitialize(&service);
+
+        dispatcher->Deactivate();
+        dispatcher->Release();
+
+        PluginHost::IFactories::Assign(nullptr);
+
+        removeNodes();
+    }
+};
+
+TEST_F(LinearPlaybackControlTest, RegisteredMethods)
+{
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("channel")));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("seek")));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("trickplay")));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("status")));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("tracing")));
+}
+
+TEST_F(LinearPlaybackControlInitializedTest, channel)
+{
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("channel"), _T("{\"channel\":\"239.1.1.1:8433\"}"), response));
+    EXPECT_EQ(string(_T("239.1.1.1:8433")), readNode(_T("chan_select0")));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("channel"), _T(""), response));
+    EXPECT_EQ(response, string(_T("{\"channel\":\"239.1.1.1:8433\"}")));
+
+    // A shorter value replaces the node content.
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("channel"), _T("{\"channel\":\"1.1.1.1\"}"), response));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("channel"), _T(""), response));
+    EXPECT_EQ(response, string(_T("{\"channel\":\"1.1.1.1\"}")));
+}
+
+TEST_F(LinearPlaybackControlInitializedTest, status)
+{
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("seek"), _T("{\"seekPosInSeconds\":30}"), response));
+    EXPECT_EQ(string(_T("30")), readNode(_T("seek0")));
+
+    writeNode(_T("seek0"), _T("30,120,1024,4096,8192"));
+    writeNode(_T("trick_play0"), _T("-4"));
+    writeNode(_T("stream_status"), _T("1,3"));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("seek"), _T(""), response));
+    EXPECT_EQ(response, string(_T("{\"seekPosInSeconds\":30}")));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("status"), _T(""), response));
+    EXPECT_EQ(response, string(_T("{"
+                                  "\"maxSizeInBytes\":8192,"
+                                  "\"currentSizeInBytes\":4096,"
+                                  "\"currentSizeInSeconds\":120,"
+                                  "\"seekPosInBytes\":1024,"
+                                  "\"seekPosInSeconds\":30,"
+                                  "\"trickPlaySpeed\":-4,"
+                                  "\"streamSourceLost\":true,"
+                                  "\"streamSourceLossCount\":3"
+                                  "}")));
+
+    writeNode(_T("seek0"), _T("30,120"));
+    EXPECT_EQ(Core::ERROR_READ_ERROR, handler.Invoke(connection, _T("seek"), _T(""), response));
+}
+
+TEST_F(LinearPlaybackControlInitializedTest, speedchanged)
+{
+    Core::Event speedchanged(false, true);
+
+    EXPECT_CALL(service, Submit(::testing::_, ::testing::_))
+        .Times(1)
+        .WillOnce(::testing::Invoke(
+            [&](const uint32_t, const Core::ProxyType<Core::JSON::IElement>& json) {
+                string text;
+                EXPECT_TRUE(json->ToString(text));
+                EXPECT_EQ(text, string(_T("{"
+                                          "\"jsonrpc\":\"2.0\","
+                                          "\"method\":\"client.events.speedchanged\","
+                                          "\"params\":{\"speed\":-4,\"muxId\":0}"
+                                          "}")));
+
+                speedchanged.SetEvent();
+
+                return Core::ERROR_NONE;
+            }));
+
+    handler.Subscribe(0, _T("speedchanged"), _T("client.events"), message);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("trickplay"), _T("{\"speed\":-4}"), response));
+
+    EXPECT_EQ(Core::ERROR_NONE, speedchanged.Lock(1000));
+
+    handler.Unsubscribe(0, _T("speedchanged"), _T("client.events"), message);
+}
+
+TEST_F(LinearPlaybackControlInitializedTest, channelchanged)
+{
+    Core::Event channelchanged(false, true);
+
+    EXPECT_CALL(service, Submit(::testing::_, ::testing::_))
+        .Times(1)
+        .WillOnce(::testing::Invoke(
+            [&](const uint32_t, const Core::ProxyType<Core::JSON::IElement>& json) {
+                string text;
+                EXPECT_TRUE(json->ToString(text));
+                EXPECT_EQ(text, string(_T("{"
+                                          "\"jsonrpc\":\"2.0\","
+                                          "\"method\":\"client.events.channelchanged\","
+                                          "\"params\":{\"channel\":\"239.1.1.1:8433\",\"muxId\":0}"
+                                          "}")));
+
+                channelchanged.SetEvent();
+
+                return Core::ERROR_NONE;
+            }));
+
+    handler.Subscribe(0, _T("channelchanged"), _T("client.events"), message);
+
+    writeNode(_T("chan_select0"), _T("239.1.1.1:8433"));
+
+    EXPECT_EQ(Core::ERROR_NONE, channelchanged.Lock(1000));
+
+    handler.Unsubscribe(0, _T("channelchanged"), _T("client.events"), message);
+}
+
+TEST_F(LinearPlaybackControlInitializedTest, streamstatuschanged)
+{
+    Core::Event streamstatuschanged(false, true);
+
+    EXPECT_CALL(service, Submit(::testing::_, ::testing::_))
+        .Times(2)
+        .WillOnce(::testing::Invoke(
+            [&](const uint32_t, const Core::ProxyType<Core::JSON::IElement>& json) {
+                string text;
+                EXPECT_TRUE(json->ToString(text));
+                EXPECT_EQ(text, string(_T("{"
+                                          "\"jsonrpc\":\"2.0\","
+                                          "\"method\":\"client.events.streamstatuschanged\","
+                                          "\"params\":{\"streamSourceLost\":true,\"streamSourceLossCount\":1,\"muxId\":0}"
+                                          "}")));
+
+                streamstatuschanged.SetEvent();
+
+                return Core::ERROR_NONE;
+            }))
+        .WillOnce(::testing::Invoke(
+            [&](const uint32_t, const Core::ProxyType<Core::JSON::IElement>& json) {
+                string text;
+                EXPECT_TRUE(json->ToString(text));
+                EXPECT_EQ(text, string(_T("{"
+                                          "\"jsonrpc\":\"2.0\","
+                                          "\"method\":\"client.events.streamstatuschanged\","
+                                          "\"params\":{\"streamSourceLost\":false,\"streamSourceLossCount\":1,\"muxId\":0}"
+                                          "}")));
+
+                streamstatuschanged.SetEvent();
+
+                return Core::ERROR_NONE;
+            }));
+
+    handler.Subscribe(0, _T("streamstatuschanged"), _T("client.events"), message);
+
+    writeNode(_T("stream_status"), _T("1,1"));
+    EXPECT_EQ(Core::ERROR_NONE, streamstatuschanged.Lock(1000));
+    streamstatuschanged.ResetEvent();
+
+    // The node going away and coming back is picked up without polling.
+    ::unlink((fccPath + _T("stream_status")).c_str());
+    writeNode(_T("stream_status"), _T("0,1"));
+    EXPECT_EQ(Core::ERROR_NONE, streamstatuschanged.Lock(1000));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("status"), _T(""), response));
+    EXPECT_THAT(response, ::testing::HasSubstr(_T("\"streamSourceLost\":false,\"streamSourceLossCount\":1")));
+
+    handler.Unsubscribe(0, _T("streamstatuschanged"), _T("client.events"), message);
+}
@@ -21,6 +21,7 @@
 #include "gtest/gtest.h"
 #include <fstream>
 #include <iostream>
+#include <sys/stat.h>
 #include "FactoriesImplementation.h"
 #include "MaintenanceManager.h"
 #include "RfcApiMock.h"
@@ -206,6 +207,11 @@ TEST_F(MaintenanceManagerTest, setMaintenanceMode)
 TEST_F(MaintenanceManagerTest, getMaintenanceActivityStatus)
 {
     EXPECT_EQ(Core::ERROR_NONE, handler_.Invoke(connection_, _T("getMaintenanceActivityStatus"), _T("{}"), response_)); 
+    EXPECT_THAT(response_, ::testing::HasSubstr(_T("\"tasks\":["
+                                                   "{\"task\":\"RFC\",\"status\":\"pending\",\"startTime\":0,\"duration\":0},"
+                                                   "{\"task\":\"SWUPDATE\",\"status\":\"pending\",\"startTime\":0,\"duration\":0},"
+                                                   "{\"task\":\"LOGUPLOAD\",\"status\":\"pending\",\"startTime\":0,\"duration\":0}"
+                                                   "]")));
 }
 #if 0
 TEST_F(MaintenanceManagerInitializedEventTest, startMaintenanceOnReboot)
@@ -395,3 +401,66 @@ TEST_F(MaintenanceManagerTest, getMaintenanceStartTime)
 
 }
 
+TEST_F(MaintenanceManagerTest, startScriptThrottlesWithTheToolsInPath)
+{
+    const string bin = "/tmp/maintenancemanager_bin";
+    const string script = "/tmp/maintenancemanager_task.sh";
+    const string path = getenv("PATH");
+    std::vector<string> commands;
+
+    ON_CALL(*p_wrapsImplMock, system(::testing::_))
+        .WillByDefault(::testing::Invoke(
+            [&](const char* command) {
+                commands.push_back(command);
+                return 0;
+            }));
+
+    mkdir(bin.c_str(), 0755);
+    std::ofstream(script) << "exit 0\n";
+    chmod(script.c_str(), 0755);
+
+    /* neither nice nor ionice available, the script runs as is */
+    setenv("PATH", bin.c_str(), 1);
+    EXPECT_TRUE(Plugin::MaintenanceManager::startScript(script + " >> /tmp/maintenancemanager_task.log", true));
+
+    std::ofstream(bin + "/nice").close();
+    chmod((bin + "/nice").c_str(), 0755);
+    EXPECT_TRUE(Plugin::MaintenanceManager::startScript(script, true));
+
+    std::ofstream(bin + "/ionice").close();
+    chmod((bin + "/ionice").c_str(), 0755);
+    EXPECT_TRUE(Plugin::MaintenanceManager::startScript(script, true));
+    EXPECT_TRUE(Plugin::MaintenanceManager::startScript(script, false));
+    setenv("PATH", path.c_str(), 1);
+
+    ASSERT_EQ(4u, commands.size());
+    EXPECT_EQ(script + " >> /tmp/maintenancemanager_task.log &", commands[0]);
+    EXPECT_EQ("nice -n 19 " + script + " &", commands[1]);
+    EXPECT_EQ("nice -n 19 ionice -c 3 " + script + " &", commands[2]);
+    EXPECT_EQ(script + " &", commands[3]);
+
+    remove((bin + "/nice").c_str());
+    remove((bin + "/ionice").c_str());
+    rmdir(bin.c_str());
+    remove(script.c_str());
+}
+
+TEST_F(MaintenanceManagerTest, startScriptFailsWhenTheScriptDoesNotStart)
+{
+    const string script = "/tmp/maintenancemanager_task.sh";
+
+    EXPECT_CALL(*p_wrapsImplMock, system(::testing::_))
+        .Times(1)
+        .WillOnce(::testing::Return(-1));
+
+    /* missing script, the shell is not even asked */
+    remove(script.c_str());
+    EXPECT_FALSE(Plugin::MaintenanceManager::startScript(script, false));
+
+    /* the shell could not be run */
+    std::ofstream(script) << "exit 0\n";
+    chmod(script.c_str(), 0755);
+    EXPECT_FALSE(Plugin::MaintenanceManager::startScript(script, false));
+
+    remove(script.c_str());
+}
@@ -118,3 +118,35 @@ TEST_F(PackagerInitializedTest, SynchronizeRepositoryTest)
 
 	EXPECT_EQ(Core::ERROR_NONE, PackagerImplementation->SynchronizeRepository());
 }
+
+TEST(PackageDownloaderTest, ResumesPartialDownload)
+{
+    const string source = _T("/tmp/packager_source.ipk");
+    const string location = _T("/tmp/packager_cache.ipk");
+    const string partial = Plugin::PackageDownloader::PartialLocation(location);
+    string content;
+    for (int i = 0; i < 100000; i++) {
+        content += static_cast<char>('a' + (i % 26));
+    }
+    std::ofstream(source, std::ios::binary) << content;
+    std::ofstream(partial, std::ios::binary) << content.substr(0, 40000);
+    Core::File(location).Destroy();
+
+    Plugin::PackageDownloader downloader;
+    uint64_t resumedAt = 0;
+    uint64_t received = 0;
+    EXPECT_EQ(Core::ERROR_NONE, downloader.Fetch(_T("file://") + source, location, resumedAt, received));
+    EXPECT_EQ(40000u, resumedAt);
+    EXPECT_EQ(60000u, received);
+    EXPECT_FALSE(Core::File(partial).Exists());
+
+    std::ifstream result(location, std::ios::binary);
+    EXPECT_EQ(content, string((std::istreambuf_iterator<char>(result)), std::istreambuf_iterator<char>()));
+
+    downloader.Abort();
+    Core::File(location).Destroy();
+    EXPECT_EQ(Core::ERROR_ABORTED, downloader.Fetch(_T("file://") + source, location, resumedAt, received));
+
+    Core::File(source).Destroy();
+    Core::File(partial).Destroy();
+}
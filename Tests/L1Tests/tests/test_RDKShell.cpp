@@ -142,6 +142,8 @@ TEST_F(RDKShellTest, RegisteredMethods){
     EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("launchFactoryApp")));
     EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("launchFactoryAppShortcut")));
     EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("enableInputEvents")));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("setMemoryPressurePolicy")));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("getMemoryPressureStatus")));
     }
 TEST_F(RDKShellTest, enableInputEvents)
 {
@@ -852,4 +854,266 @@ TEST_F(RDKShellTest, enableInactivityReporting)
   EXPECT_EQ(response, _T("{\"success\":true}"));
 }
 
+TEST_F(RDKShellTest, memoryPressurePolicy)
+{
+  EXPECT_EQ(Core::ERROR_GENERAL, handler.Invoke(connection, _T("setMemoryPressurePolicy"), _T("{\"dryRun\": true}"), response));
+
+  EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("setMemoryPressurePolicy"), _T("{\"enable\": false,"
+                                                                                            "\"dryRun\": true,"
+                                                                                            "\"interval\": 500,"
+                                                                                            "\"suspendThreshold\": \"5\","
+                                                                                            "\"protected\": [\"ResidentApp\", \"HtmlApp\"]}"), response));
+  EXPECT_EQ(response, _T("{\"success\":true}"));
+
+  EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getMemoryPressureStatus"), _T("{}"), response));
+  EXPECT_EQ(response, string("{"
+                              "\"policy\":{\"enable\":false,\"dryRun\":true,\"interval\":500,\"cooldown\":10000,"
+                              "\"suspendThreshold\":\"5.000000\",\"hibernateThreshold\":\"25.000000\",\"killThreshold\":\"10.000000\","
+                              "\"protected\":[\"HtmlApp\",\"ResidentApp\"]},"
+                              "\"pressure\":{\"available\":false,\"some\":\"0.000000\",\"full\":\"0.000000\"},"
+                              "\"decisions\":[],"
+                              "\"success\":true"
+                      "}"));
+}
+
+TEST(RDKShellWarmPoolTest, adoptionAndRefill)
+{
+  Plugin::WarmPool pool;
+
+  EXPECT_FALSE(pool.Configure({ "WebKitBrowser" }, 0));
+  EXPECT_TRUE(pool.Configure({ "WebKitBrowser", "LightningApp" }, 2));
+  EXPECT_EQ(std::vector<string>({ "WebKitBrowser", "LightningApp" }), pool.Types());
+
+  // One fill at a time, each type up to the pool size.
+  EXPECT_TRUE(pool.BeginFill());
+  EXPECT_FALSE(pool.BeginFill());
+  EXPECT_EQ(string("WebKitBrowser-warm-1"), pool.Next("WebKitBrowser"));
+  pool.Add("WebKitBrowser", "WebKitBrowser-warm-1");
+  EXPECT_EQ(string("WebKitBrowser-warm-2"), pool.Next("WebKitBrowser"));
+  pool.Add("WebKitBrowser", "WebKitBrowser-warm-2");
+  EXPECT_EQ(string(), pool.Next("WebKitBrowser"));
+  pool.EndFill();
+  EXPECT_EQ(2u, pool.Count("WebKitBrowser"));
+
+  // A launch adopts the oldest instance of its type.
+  EXPECT_EQ(string(), pool.Take("HtmlApp"));
+  EXPECT_EQ(string("WebKitBrowser-warm-1"), pool.Take("WebKitBrowser"));
+  EXPECT_EQ(1u, pool.Count("WebKitBrowser"));
+
+  // The refill only tops the pool up again.
+  EXPECT_TRUE(pool.BeginFill());
+  EXPECT_EQ(string("WebKitBrowser-warm-3"), pool.Next("WebKitBrowser"));
+  pool.Add("WebKitBrowser", "WebKitBrowser-warm-3");
+  EXPECT_EQ(string(), pool.Next("WebKitBrowser"));
+  pool.EndFill();
+
+  // An instance deactivated while pooled can not be adopted any more.
+  pool.Forget("WebKitBrowser-warm-2");
+  EXPECT_EQ(string("WebKitBrowser-warm-3"), pool.Take("WebKitBrowser"));
+  EXPECT_EQ(string(), pool.Take("WebKitBrowser"));
+}
+
+TEST(RDKShellWarmPoolTest, stopDrainsThePool)
+{
+  Plugin::WarmPool pool;
+
+  EXPECT_TRUE(pool.Configure({ "WebKitBrowser", "LightningApp" }, 1));
+  EXPECT_TRUE(pool.BeginFill());
+  pool.Add("WebKitBrowser", pool.Next("WebKitBrowser"));
+  const string pending = pool.Next("LightningApp");
+  EXPECT_EQ(string("LightningApp-warm-2"), pending);
+
+  // Stopping ends the fill, the instance it was still preparing is drained with the others.
+  pool.Stop();
+  EXPECT_EQ(string(), pool.Next("LightningApp"));
+  pool.Add("LightningApp", pending);
+  pool.EndFill();
+  EXPECT_FALSE(pool.BeginFill());
+
+  EXPECT_EQ(std::vector<string>({ "LightningApp-warm-2", "WebKitBrowser-warm-1" }), pool.Drain());
+  EXPECT_EQ(0u, pool.Count("WebKitBrowser"));
+  EXPECT_TRUE(pool.Drain().empty());
+}
 
+namespace {
+
+class MemoryPressureApplications : public Plugin::MemoryPressureManager::IApplications {
+public:
+    void Applications(std::vector<Plugin::MemoryPressureManager::Application>&) override
+    {
+    }
+    void Inspect(Plugin::MemoryPressureManager::Application& application) override
+    {
+        inspected.push_back(application.callsign);
+        application.suspended = (suspended.find(application.callsign) != suspended.end());
+        auto resident = residentKb.find(application.callsign);
+        application.residentKb = (resident != residentKb.end() ? resident->second : 0);
+    }
+    bool Apply(const string&, const Plugin::MemoryPressureManager::action) override
+    {
+        return true;
+    }
+    void Decided(const Plugin::MemoryPressureManager::Decision&) override
+    {
+    }
+
+    std::set<string> suspended;
+    std::map<string, uint64_t> residentKb;
+    std::vector<string> inspected;
+};
+
+Plugin::MemoryPressureManager::Application Background(const string& callsign)
+{
+    return { callsign, false, false, 0 };
+}
+
+Plugin::MemoryPressureManager::Application Foreground(const string& callsign)
+{
+    return { callsign, true, false, 0 };
+}
+
+}
+
+TEST(RDKShellMemoryPressureTest, parse)
+{
+    Plugin::MemoryPressureManager::Pressure pressure;
+
+    EXPECT_TRUE(Plugin::MemoryPressureManager::Parse("some avg10=12.50 avg60=3.00 avg300=0.50 total=123456\n"
+                                                     "full avg10=4.25 avg60=1.00 avg300=0.10 total=23456\n", pressure));
+    EXPECT_TRUE(pressure.valid);
+    EXPECT_DOUBLE_EQ(12.5, pressure.someAvg10);
+    EXPECT_DOUBLE_EQ(4.25, pressure.fullAvg10);
+
+    // Kernels before 5.13 have no full line.
+    EXPECT_TRUE(Plugin::MemoryPressureManager::Parse("some avg10=1.00 avg60=0.00 avg300=0.00 total=0\n", pressure));
+    EXPECT_DOUBLE_EQ(1.0, pressure.someAvg10);
+    EXPECT_DOUBLE_EQ(0.0, pressure.fullAvg10);
+
+    EXPECT_FALSE(Plugin::MemoryPressureManager::Parse("full avg10=4.25 avg60=1.00 avg300=0.10 total=23456\n", pressure));
+    EXPECT_FALSE(pressure.valid);
+    EXPECT_FALSE(Plugin::MemoryPressureManager::Parse("", pressure));
+}
+
+TEST(RDKShellMemoryPressureTest, ranksLeastRecentlyUsedTimesResidentMemory)
+{
+    MemoryPressureApplications applications;
+    Plugin::MemoryPressureManager manager(applications);
+    Plugin::MemoryPressureManager::Decision decision;
+    const Plugin::MemoryPressureManager::Pressure calm = { true, 0, 0 };
+    const Plugin::MemoryPressureManager::Pressure pressure = { true, 15, 0 };
+
+    std::vector<Plugin::MemoryPressureManager::Application> list = { Background("Netflix"), Background("YouTube"), Background("Amazon") };
+    EXPECT_FALSE(manager.Evaluate(calm, list, 1000, decision));
+    list = { Background("Netflix"), Foreground("YouTube"), Background("Amazon") };
+    EXPECT_FALSE(manager.Evaluate(calm, list, 31000, decision));
+
+    // Netflix and Amazon have been in the background the longest, Amazon holds more memory.
+    applications.residentKb = { { "Netflix", 100 * 1024 }, { "YouTube", 150 * 1024 }, { "Amazon", 200 * 1024 } };
+    list = { Background("Netflix"), Background("YouTube"), Background("Amazon") };
+    ASSERT_TRUE(manager.Evaluate(pressure, list, 61000, decision));
+    EXPECT_EQ(string("Amazon"), decision.callsign);
+    EXPECT_EQ(Plugin::MemoryPressureManager::SUSPEND, decision.what);
+    EXPECT_EQ(60000u, decision.idleMs);
+    EXPECT_EQ(200u * 1024, decision.residentKb);
+    EXPECT_DOUBLE_EQ(15.0, decision.someAvg10);
+    EXPECT_FALSE(decision.executed);
+
+    // A recently used application holding a lot outranks an idle small one.
+    applications.residentKb["YouTube"] = 4000 * 1024;
+    applications.suspended = { "Amazon" };
+    ASSERT_TRUE(manager.Evaluate(pressure, list, 71000, decision));
+    EXPECT_EQ(string("YouTube"), decision.callsign);
+    EXPECT_EQ(40000u, decision.idleMs);
+}
+
+TEST(RDKShellMemoryPressureTest, cooldown)
+{
+    MemoryPressureApplications applications;
+    Plugin::MemoryPressureManager manager(applications);
+    Plugin::MemoryPressureManager::Decision decision;
+    const Plugin::MemoryPressureManager::Pressure pressure = { true, 15, 0 };
+
+    Plugin::MemoryPressureManager::Policy policy = Plugin::MemoryPressureManager::DefaultPolicy();
+    policy.cooldown = 5000;
+    manager.Configure(policy);
+
+    std::vector<Plugin::MemoryPressureManager::Application> list = { Background("Netflix"), Background("YouTube") };
+    ASSERT_TRUE(manager.Evaluate(pressure, list, 1000, decision));
+    applications.suspended.insert(decision.callsign);
+
+    EXPECT_FALSE(manager.Evaluate(pressure, list, 5999, decision));
+    ASSERT_TRUE(manager.Evaluate(pressure, list, 6000, decision));
+    applications.suspended.insert(decision.callsign);
+
+    // Nothing left to suspend. An evaluation that found nothing does not hold back the next action.
+    EXPECT_FALSE(manager.Evaluate(pressure, list, 11000, decision));
+    list.push_back(Background("Amazon"));
+    ASSERT_TRUE(manager.Evaluate(pressure, list, 11001, decision));
+    EXPECT_EQ(string("Amazon"), decision.callsign);
+}
+
+TEST(RDKShellMemoryPressureTest, hibernateFallsBackToKill)
+{
+    MemoryPressureApplications applications;
+    Plugin::MemoryPressureManager manager(applications);
+    Plugin::MemoryPressureManager::Decision decision;
+    const Plugin::MemoryPressureManager::Pressure pressure = { true, 30, 0 };
+
+    Plugin::MemoryPressureManager::Policy policy = Plugin::MemoryPressureManager::DefaultPolicy();
+    policy.cooldown = 0;
+    manager.Configure(policy);
+
+    // Nothing suspended yet, suspending comes first.
+    std::vector<Plugin::MemoryPressureManager::Application> list = { Background("Netflix"), Background("YouTube") };
+    applications.residentKb = { { "Netflix", 100 * 1024 }, { "YouTube", 200 * 1024 } };
+    ASSERT_TRUE(manager.Evaluate(pressure, list, 1000, decision));
+    EXPECT_EQ(Plugin::MemoryPressureManager::SUSPEND, decision.what);
+    EXPECT_EQ(string("YouTube"), decision.callsign);
+
+    // Without hibernation only the suspended application is killed, not the bigger active one.
+    applications.suspended = { "Netflix" };
+    ASSERT_TRUE(manager.Evaluate(pressure, list, 2000, decision));
+    EXPECT_EQ(Plugin::MemoryPressureManager::KILL, decision.what);
+    EXPECT_EQ(string("Netflix"), decision.callsign);
+
+    policy.hibernation = true;
+    manager.Configure(policy);
+    ASSERT_TRUE(manager.Evaluate(pressure, list, 3000, decision));
+    EXPECT_EQ(Plugin::MemoryPressureManager::HIBERNATE, decision.what);
+    EXPECT_EQ(string("Netflix"), decision.callsign);
+
+    // Full stalls kill whatever ranks first.
+    const Plugin::MemoryPressureManager::Pressure stalled = { true, 30, 12 };
+    ASSERT_TRUE(manager.Evaluate(stalled, list, 4000, decision));
+    EXPECT_EQ(Plugin::MemoryPressureManager::KILL, decision.what);
+    EXPECT_EQ(string("YouTube"), decision.callsign);
+}
+
+TEST(RDKShellMemoryPressureTest, skipsForegroundAndProtectedApplications)
+{
+    MemoryPressureApplications applications;
+    Plugin::MemoryPressureManager manager(applications);
+    Plugin::MemoryPressureManager::Decision decision;
+    const Plugin::MemoryPressureManager::Pressure stalled = { true, 50, 50 };
+
+    Plugin::MemoryPressureManager::Policy policy = Plugin::MemoryPressureManager::DefaultPolicy();
+    policy.cooldown = 0;
+    policy.protectedApps = { "ResidentApp" };
+    manager.Configure(policy);
+
+    applications.residentKb = { { "ResidentApp", 500 * 1024 }, { "YouTube", 400 * 1024 }, { "Netflix", 100 * 1024 } };
+    std::vector<Plugin::MemoryPressureManager::Application> list = { Background("ResidentApp"), Foreground("YouTube") };
+    EXPECT_FALSE(manager.Evaluate(stalled, list, 1000, decision));
+    EXPECT_TRUE(applications.inspected.empty());
+
+    list.push_back(Background("Netflix"));
+    ASSERT_TRUE(manager.Evaluate(stalled, list, 2000, decision));
+    EXPECT_EQ(string("Netflix"), decision.callsign);
+    EXPECT_EQ(std::vector<string>({ "Netflix" }), applications.inspected);
+
+    // Below the thresholds, or without valid figures, nothing happens.
+    const Plugin::MemoryPressureManager::Pressure calm = { true, 5, 0 };
+    const Plugin::MemoryPressureManager::Pressure unknown = { false, 50, 50 };
+    EXPECT_FALSE(manager.Evaluate(calm, list, 3000, decision));
+    EXPECT_FALSE(manager.Evaluate(unknown, list, 4000, decision));
+}
@@ -106,6 +106,43 @@ TEST_F(SecurityAgentTest, validate)
     plugin->Deinitialize(&service);
 }
 
+TEST_F(SecurityAgentTest, tokencache)
+{
+    const string payload = _T("{\"url\":\"http://localhost\"}");
+    const string expired = _T("{\"url\":\"http://localhost\",\"exp\":1}");
+
+    string token;
+    string expiredToken;
+
+    EXPECT_EQ(string(""), plugin->Initialize(&service));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("tokencache")));
+    EXPECT_EQ(Core::ERROR_NONE, plugin->CreateToken(static_cast<uint16_t>(payload.length()), reinterpret_cast<const uint8_t*>(payload.c_str()), token));
+    EXPECT_EQ(Core::ERROR_NONE, plugin->CreateToken(static_cast<uint16_t>(expired.length()), reinterpret_cast<const uint8_t*>(expired.c_str()), expiredToken));
+
+    PluginHost::ISecurity* first = plugin->Officer(token);
+    ASSERT_TRUE(first != nullptr);
+    PluginHost::ISecurity* second = plugin->Officer(token);
+    EXPECT_EQ(first, second);
+    second->Release();
+    first->Release();
+
+    // Not cached, the token expired already
+    PluginHost::ISecurity* old = plugin->Officer(expiredToken);
+    ASSERT_TRUE(old != nullptr);
+    old->Release();
+
+    EXPECT_EQ(nullptr, plugin->Officer(token + _T("x")));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("validate"), "{\"token\":\"" + token + "\"}", response));
+    EXPECT_EQ(response, _T("{\"valid\":true}"));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("tokencache"), _T("{}"), response));
+    EXPECT_EQ(response, _T("{\"hits\":2,\"misses\":3,\"evictions\":0,\"entries\":1}"));
+
+    plugin->Deinitialize(&service);
+}
+
 TEST_F(SecurityAgentTest, rpcCom)
 {
     const string payload = _T("{\"url\":\"http://localhost\"}");
@@ -269,3 +306,46 @@ TEST_F(SecurityAgentTest, aclForDACApps)
 
     plugin->Deinitialize(&service);
 }
+
+TEST(SecurityAgentAclTest, compiledPatterns)
+{
+    std::ofstream file("/tmp/acl_patterns.json");
+    file
+        << "{\n"
+           "  \"assign\": [\n"
+           "    { \"url\": \"*://localhost:*\", \"role\": \"local\" },\n"
+           "    { \"url\": \"*://*.example.com\", \"role\": \"example\" }\n"
+           "  ],\n"
+           "  \"roles\": {\n"
+           "    \"local\": { \"default\": \"allowed\" },\n"
+           "    \"example\": {\n"
+           "      \"default\": \"blocked\",\n"
+           "      \"org.rdk.*\": {\n"
+           "        \"default\": \"blocked\",\n"
+           "        \"methods\": [ \"get*\" ]\n"
+           "      }\n"
+           "    }\n"
+           "  }\n"
+           "}";
+    file.close();
+
+    Plugin::AccessControlList acl;
+    Core::File source(_T("/tmp/acl_patterns.json"));
+    ASSERT_TRUE(source.Open(true));
+    EXPECT_EQ(Core::ERROR_NONE, acl.Load(source));
+
+    EXPECT_TRUE(acl.Allowed(_T("http://localhost:9998/index.html"), _T("Controller"), _T("activate")));
+    EXPECT_FALSE(acl.Allowed(_T("http://localhost/index.html"), _T("Controller"), _T("activate")));
+    EXPECT_FALSE(acl.Allowed(_T("http://localhost:port"), _T("Controller"), _T("activate")));
+
+    EXPECT_TRUE(acl.Allowed(_T("https://apps.example.com/guide?x=1"), _T("org.rdk.System"), _T("getDeviceInfo")));
+    EXPECT_TRUE(acl.Allowed(_T("https://apps.example.com/guide"), _T("org.rdk.System"), _T("getDeviceInfo")));
+    EXPECT_FALSE(acl.Allowed(_T("https://apps.example.com"), _T("org.rdk.System"), _T("setMode")));
+    EXPECT_FALSE(acl.Allowed(_T("https://apps.example.com"), _T("org.rdk_System"), _T("getDeviceInfo")));
+    EXPECT_FALSE(acl.Allowed(_T("https://example.com"), _T("org.rdk.System"), _T("getDeviceInfo")));
+    EXPECT_FALSE(acl.Allowed(_T("HTTPS://apps.example.com"), _T("org.rdk.System"), _T("getDeviceInfo")));
+
+    // Cached verdicts do not survive the ACL they came from
+    acl.Clear();
+    EXPECT_FALSE(acl.Allowed(_T("http://localhost:9998/index.html"), _T("Controller"), _T("activate")));
+}
@@ -253,6 +253,7 @@ TEST_F(SystemServicesTest, TestedAPIsShouldExist)
 	EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("abortLogUpload")));
     EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("setFSRFlag")));
     EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("getFSRFlag")));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("getIARMCallStatistics")));
 }
 
 TEST_F(SystemServicesTest, SystemUptime)
@@ -169,6 +169,86 @@ TEST_F(TimerTest, jsonRpc)
     EXPECT_EQ(Core::ERROR_GENERAL, handler.Invoke(connection, _T("cancel"), _T("{\"timerId\":10}"), response));
 }
 
+TEST(TpTimerTest, sharedTimerWheel)
+{
+    Core::Event fired(false, true);
+    std::atomic<int> singleShots(0);
+    std::atomic<int> stopped(0);
+
+    Plugin::TpTimer single;
+    single.setSingleShot(true);
+    single.connect([&]() { singleShots++; fired.SetEvent(); });
+
+    Plugin::TpTimer revoked;
+    revoked.connect([&]() { stopped++; });
+
+    revoked.start(20);
+    single.start(10);
+    revoked.stop();
+
+    EXPECT_EQ(Core::ERROR_NONE, fired.Lock(1000));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_EQ(1, singleShots);
+    EXPECT_EQ(0, stopped);
+    EXPECT_FALSE(single.isActive());
+    EXPECT_FALSE(revoked.isActive());
+    EXPECT_EQ(0u, Plugin::TimerWheel::Instance().Pending());
+}
+
+TEST(TpTimerTest, timerWheelLevels)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    Core::Event done(false, true);
+    const Clock::time_point start = Clock::now();
+    std::atomic<int64_t> shortFired(-1);
+    std::atomic<int64_t> longFired(-1);
+    std::atomic<int> repeats(0);
+    std::atomic<int> stopped(0);
+
+    auto elapsed = [&start]() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+    };
+
+    // 300 and 700 ms are beyond the 256 slots of the lowest level and reach it by cascading.
+    Plugin::TpTimer shortTimer;
+    shortTimer.setSingleShot(true);
+    shortTimer.connect([&]() { shortFired = elapsed(); });
+
+    Plugin::TpTimer longTimer;
+    longTimer.setSingleShot(true);
+    longTimer.connect([&]() { longFired = elapsed(); done.SetEvent(); });
+
+    Plugin::TpTimer repeating;
+    repeating.connect([&]() {
+        if (++repeats == 2) {
+            repeating.stop();
+        }
+    });
+
+    Plugin::TpTimer revoked;
+    revoked.connect([&]() { stopped++; });
+
+    shortTimer.start(300);
+    longTimer.start(700);
+    repeating.start(260);
+    revoked.start(400);
+    revoked.stop();
+
+    EXPECT_EQ(Core::ERROR_NONE, done.Lock(2000));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_GE(shortFired, 300);
+    EXPECT_LT(shortFired, 400);
+    EXPECT_GE(longFired, 700);
+    EXPECT_LT(longFired, 800);
+    EXPECT_EQ(2, repeats);
+    EXPECT_EQ(0, stopped);
+    EXPECT_FALSE(repeating.isActive());
+    EXPECT_EQ(0u, Plugin::TimerWheel::Instance().Pending());
+}
+
 /**
  * Segmentation fault without valgrind
  */
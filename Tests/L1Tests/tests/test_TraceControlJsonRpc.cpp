@@ -77,6 +77,39 @@ protected:
     }
 };
 
+class TraceControlJsonRpcQueueTest : public TraceControlJsonRpcTest {
+protected:
+    ServiceMock service;
+    COMLinkMock comLinkMock;
+
+    TraceControlJsonRpcQueueTest()
+        : TraceControlJsonRpcTest()
+    {
+        // One collector and the smallest queue there is (a single batch), so a stalled output fills it quickly.
+        ON_CALL(service, ConfigLine())
+            .WillByDefault(::testing::Return("{\n"
+                                             "\"console\":false,\n"
+                                             "\"syslog\":true,\n"
+                                             "\"abbreviated\":true,\n"
+                                             "\"collectors\":1,\n"
+                                             "\"queue\":64\n"
+                                             "}"));
+        ON_CALL(service, WebPrefix())
+            .WillByDefault(::testing::Return(webPrefix));
+        ON_CALL(service, VolatilePath())
+            .WillByDefault(::testing::Return(volatilePath));
+        ON_CALL(service, Callsign())
+            .WillByDefault(::testing::Return(callSign));
+        ON_CALL(service, COMLink())
+            .WillByDefault(::testing::Return(&comLinkMock));
+        EXPECT_EQ(string(""), plugin->Initialize(&service));
+    }
+    virtual ~TraceControlJsonRpcQueueTest() override
+    {
+        plugin->Deinitialize(&service);
+    }
+};
+
 TEST_F(TraceControlJsonRpcTest, registeredMethods)
 {
     EXPECT_EQ(Core::ERROR_NONE, handler.Exists(_T("set")));
@@ -101,6 +134,8 @@ TEST_F(TraceControlJsonRpcInitializedTest, DISABLED_jsonRpc)
                                                   "\"console\":false,"
                                                   "\"settings\":"
                                                   "\\[(\\{\"module\":\"[^\"]+\",\"category\":\"[^\"]+\",\"state\":\"(disabled|enabled|tristated)\"\\},{0,}){0,}\\]"
+                                                  ",\"sources\":"
+                                                  "\\[(\\{\"id\":[0-9]+,\"entries\":[0-9]+,\"dropped\":[0-9]+,\"overwritten\":[0-9]+\\},{0,}){1,}\\]"
                                                   "\\}"));
 
     //Set Plugin_TraceControl:Information:enabled
@@ -112,6 +147,8 @@ TEST_F(TraceControlJsonRpcInitializedTest, DISABLED_jsonRpc)
                                                   "\"console\":false,"
                                                   "\"settings\":"
                                                   "\\[\\{\"module\":\"Plugin_TraceControl\",\"category\":\"Information\",\"state\":\"enabled\"\\}\\]"
+                                                  ",\"sources\":"
+                                                  "\\[(\\{\"id\":[0-9]+,\"entries\":[0-9]+,\"dropped\":[0-9]+,\"overwritten\":[0-9]+\\},{0,}){1,}\\]"
                                                   "\\}"));
 
     //Set Plugin_TraceControl:All:disabled
@@ -123,6 +160,8 @@ TEST_F(TraceControlJsonRpcInitializedTest, DISABLED_jsonRpc)
                                                   "\"console\":false,"
                                                   "\"settings\":"
                                                   "\\[(\\{\"module\":\"Plugin_TraceControl\",\"category\":\"[^\"]+\",\"state\":\"disabled\"\\},{0,}){0,}\\]"
+                                                  ",\"sources\":"
+                                                  "\\[(\\{\"id\":[0-9]+,\"entries\":[0-9]+,\"dropped\":[0-9]+,\"overwritten\":[0-9]+\\},{0,}){1,}\\]"
                                                   "\\}"));
 
     //Set Plugin_TraceControl:All:enabled
@@ -156,3 +195,50 @@ TEST_F(TraceControlJsonRpcInitializedTest, DISABLED_syslogFormat)
     //Log some trace data and verify the output format
     TRACE(Trace::Information, (_T("Test2")));
 }
+
+TEST_F(TraceControlJsonRpcQueueTest, droppedWhenOutputStalls)
+{
+    Core::Event stalled(false, true);
+    Core::Event release(false, true);
+    std::atomic<bool> first(true);
+
+    // The first entry that reaches syslog holds up the dispatcher until the test lets go.
+    ON_CALL(*p_wrapsImplMock, syslog(::testing::_, ::testing::_, ::testing::_))
+        .WillByDefault(::testing::Invoke(
+            [&](int, const char*, va_list) {
+                if (first.exchange(false) == true) {
+                    stalled.SetEvent();
+                    release.Lock();
+                }
+            }));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("set"), _T("{\"module\":\"Plugin_TraceControl\",\"category\":\"Information\",\"state\":\"enabled\"}"), response));
+
+    TRACE(Trace::Information, (_T("Stall")));
+    EXPECT_EQ(Core::ERROR_NONE, stalled.Lock(2000));
+
+    // Paced, so the collector reads the entries before the trace buffer wraps: they should be dropped by the
+    // queue, not overwritten in the buffer.
+    for (uint8_t round = 0; round < 8; round++) {
+        for (uint8_t index = 0; index < 32; index++) {
+            TRACE(Trace::Information, (_T("Entry %d"), (round * 32) + index));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    bool dropped = false;
+
+    for (uint8_t retry = 0; (retry < 100) && (dropped == false); retry++) {
+        EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("status"), _T("{}"), response));
+        dropped = ::testing::Value(response, ::testing::ContainsRegex("\"dropped\":[1-9]"));
+        if (dropped == false) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+
+    // Never leave the dispatcher stuck, Deinitialize waits for it.
+    release.SetEvent();
+
+    EXPECT_TRUE(dropped) << response;
+    EXPECT_THAT(response, ::testing::MatchesRegex(".*\"sources\":\\[\\{\"id\":0,\"entries\":[1-9][0-9]*,\"dropped\":[1-9][0-9]*,\"overwritten\":[0-9]+\\}.*"));
+}
@@ -608,6 +608,57 @@ for (const auto& fileName1 :fileNames) {
 	std::remove(filePaths.c_str());
 	}
 }
+
+/**
+ * @brief : getFileList with offset and limit
+ *          Check if the listing is sorted by name and only the requested page is returned,
+ *          together with the total number of matching entries and, on request, their details.
+ *
+ * @param[in]   :  Valid parameters with the "path", "offset", "limit" and "details" labels
+ * @return      :  response object containing one entry, the total and success status as true
+ */
+TEST_F(UsbAccessTest, getFileListSuccess_paginated)
+{
+    EXPECT_CALL(*p_udevImplMock, udev_enumerate_get_list_entry(testing::_))
+        .WillOnce(testing::Return(reinterpret_cast<struct udev_list_entry*>(0x3)));
+    EXPECT_CALL(*p_udevImplMock, udev_list_entry_get_name(testing::_))
+         .WillRepeatedly(testing::Return("/dev/sda1"));
+
+    EXPECT_CALL(*p_udevImplMock, udev_device_get_parent_with_subsystem_devtype(testing::_, testing::_, testing::_))
+        .WillRepeatedly(testing::Return(reinterpret_cast<struct udev_device*>(0x5)));
+
+    EXPECT_CALL(*p_udevImplMock, udev_device_get_devtype(testing::_))
+        .WillRepeatedly(testing::Return("disk"));
+
+    EXPECT_CALL(*p_udevImplMock, udev_device_get_devnode(testing::_))
+        .WillRepeatedly(testing::Return("/dev/sda1"));
+
+    EXPECT_CALL(*p_wrapsImplMock, getmntent(testing::_))
+      .WillRepeatedly(::testing::Invoke(
+       [&](FILE*) -> struct mntent* {
+        static struct mntent entry1;
+
+        entry1.mnt_fsname = const_cast<char*>("/dev/sda1");
+        entry1.mnt_dir = const_cast<char*>("/run/media/sda1/logs/");
+
+        static int callCount = 0;
+        if (callCount == 0) {
+            callCount++;
+            return &entry1;
+        } else {
+            return static_cast<struct mntent*>(NULL);
+        }
+    }));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("getFileList"), _T("{\"path\":\"/run/media/sda1/logs/PreviousLogs\",\"offset\":2,\"limit\":1,\"details\":true}"), response));
+    EXPECT_THAT(response, ::testing::MatchesRegex("\\{"
+                                                "\"path\":\"\\\\/run\\\\/media\\\\/sda1\\\\/logs\\\\/PreviousLogs\","
+                                                "\"contents\":"
+                                                "\\[\\{\"name\":\"logFile.txt\",\"t\":\"f\",\"kind\":\"other\",\"size\":[0-9]+,\"mtime\":[0-9]+\\}\\],"
+                                                "\"total\":3,"
+                                                "\"success\":true"
+                                                "\\}"));
+}
  /*Test cases for getFileList ends here*/
 
 /*******************************************************************************************************************
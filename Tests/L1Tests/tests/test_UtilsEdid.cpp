@@ -0,0 +1,179 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "UtilsEdid.h"
+
+namespace {
+void Seal(std::vector<uint8_t>& edid, size_t block)
+{
+    uint8_t sum = 0;
+    for (size_t i = 0; i < 127; i++) {
+        sum += edid[(block * 128) + i];
+    }
+    edid[(block * 128) + 127] = static_cast<uint8_t>(0x100 - sum);
+}
+
+// A 1080p60 TV with two CTA-861 extensions, the second one with a bad checksum.
+std::vector<uint8_t> Edid()
+{
+    std::vector<uint8_t> edid(3 * 128, 0);
+    const uint8_t header[] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+    std::copy(header, header + sizeof(header), edid.begin());
+
+    const uint8_t base[] = {
+        0x4C, 0x2D, // "SAM"
+        0x12, 0x0F, // product code
+        0x04, 0x03, 0x02, 0x01, // serial number
+        0x00, 0x20, // week, year
+        0x01, 0x03, // EDID 1.3
+        0x80, 160, 90 // digital, 160 x 90 cm
+    };
+    std::copy(base, base + sizeof(base), edid.begin() + 8);
+
+    // 148.5 MHz, 1920 + 280 x 1080 + 45, progressive
+    const uint8_t timing[] = { 0x02, 0x3A, 0x80, 0x18, 0x71, 0x38, 0x2D, 0x40, 0x58, 0x2C, 0x45, 0x00, 0x40, 0x84, 0x63, 0x00, 0x00, 0x1E };
+    std::copy(timing, timing + sizeof(timing), edid.begin() + 54);
+    const uint8_t name[] = { 0x00, 0x00, 0x00, 0xFC, 0x00, 'L', 'i', 'v', 'i', 'n', 'g', ' ', 'T', 'V', 0x0A, ' ', ' ', ' ' };
+    std::copy(name, name + sizeof(name), edid.begin() + 72);
+    edid[126] = 2;
+    Seal(edid, 0);
+
+    const uint8_t cta[] = {
+        0x02, 0x03, 0x00, 0x70, // CTA-861 revision 3, basic audio, YCbCr 4:4:4 and 4:2:2
+        0x43, 0x90, 0x04, 0x5F, // video: VIC 16 (native), 4, 95
+        0x26, 0x09, 0x07, 0x07, 0x55, 0x06, 0x01, // audio: LPCM 2 ch, E-AC-3 6 ch
+        0x83, 0x4F, 0x00, 0x00, // speaker allocation
+        0x67, 0x03, 0x0C, 0x00, 0x10, 0x00, 0x00, 0x3C, // HDMI VSDB: 1.0.0.0, 300 MHz
+        0x6A, 0xD8, 0x5D, 0xC4, 0x01, 0x78, 0x00, 0x30, 0x42, 0x30, 0x78, // HF-VSDB: 600 MHz, FRL 3, ALLM, QMS, VRR 48-120
+        0xE3, 0x05, 0xC0, 0x80, // colorimetry: BT.2020 YCC and RGB, DCI-P3
+        0xE6, 0x06, 0x0D, 0x01, 0x60, 0x50, 0x10, // HDR static metadata: SDR, ST 2084, HLG
+        0xE4, 0x01, 0x46, 0xD0, 0x00, // Dolby Vision VSVDB
+        0xE5, 0x01, 0x8B, 0x84, 0x90, 0x01, // HDR10+ VSVDB
+        0x45, 0x01, 0x02 // video block running past the detailed timings, ignored
+    };
+    std::copy(cta, cta + sizeof(cta), edid.begin() + 128);
+    edid[128 + 2] = sizeof(cta);
+    Seal(edid, 1);
+
+    const uint8_t corrupt[] = {
+        0x02, 0x01, 0x07, 0x00,
+        0x42, 0x61, 0x62 // VICs 97 and 98
+    };
+    std::copy(corrupt, corrupt + sizeof(corrupt), edid.begin() + 256);
+    Seal(edid, 2);
+    edid[256 + 127] ^= 0xFF;
+
+    return edid;
+}
+}
+
+using namespace Utils::Edid;
+
+TEST(UtilsEdidTest, parsesBaseBlockAndCtaExtension)
+{
+    const std::vector<uint8_t> edid = Edid();
+    Capabilities caps;
+
+    ASSERT_TRUE(Parse(edid.data(), edid.size(), caps));
+    EXPECT_TRUE(caps.valid);
+
+    EXPECT_EQ("SAM", caps.manufacturer);
+    EXPECT_EQ(0x0F12, caps.productCode);
+    EXPECT_EQ(0x01020304u, caps.serialNumber);
+    EXPECT_EQ(1, caps.version);
+    EXPECT_EQ(3, caps.revision);
+    EXPECT_EQ(160, caps.widthCm);
+    EXPECT_EQ(90, caps.heightCm);
+    EXPECT_EQ(1920, caps.preferredWidth);
+    EXPECT_EQ(1080, caps.preferredHeight);
+    EXPECT_EQ(60u, caps.preferredRefresh);
+    EXPECT_FALSE(caps.preferredInterlaced);
+    EXPECT_EQ("Living TV", caps.monitorName);
+
+    EXPECT_EQ(3, caps.ctaRevision);
+    EXPECT_TRUE(caps.basicAudio);
+    EXPECT_TRUE(caps.ycbcr444);
+    EXPECT_TRUE(caps.ycbcr422);
+    EXPECT_EQ(std::vector<uint8_t>({ 16, 4, 95 }), caps.vics);
+
+    ASSERT_EQ(2u, caps.audioFormats.size());
+    EXPECT_EQ(1, caps.audioFormats[0].format);
+    EXPECT_EQ(2, caps.audioFormats[0].channels);
+    EXPECT_EQ(0x07, caps.audioFormats[0].sampleRates);
+    EXPECT_EQ(0x07, caps.audioFormats[0].extra);
+    EXPECT_EQ(10, caps.audioFormats[1].format);
+    EXPECT_EQ(6, caps.audioFormats[1].channels);
+    EXPECT_EQ(0x06, caps.audioFormats[1].sampleRates);
+    EXPECT_EQ(0x01, caps.audioFormats[1].extra);
+    EXPECT_EQ(0x4F, caps.speakerAllocation);
+
+    EXPECT_EQ(COLORIMETRY_BT2020YCC | COLORIMETRY_BT2020RGB | COLORIMETRY_DCI_P3, caps.colorimetry);
+    EXPECT_EQ(EOTF_SDR | EOTF_SMPTE_ST_2084 | EOTF_HLG, caps.eotfs);
+    EXPECT_EQ(0x01, caps.staticMetadataTypes);
+    EXPECT_EQ(0x60, caps.maxLuminance);
+    EXPECT_EQ(0x50, caps.maxFrameAverageLuminance);
+    EXPECT_EQ(0x10, caps.minLuminance);
+    EXPECT_TRUE(caps.dolbyVision);
+    EXPECT_TRUE(caps.hdr10Plus);
+
+    EXPECT_TRUE(caps.hdmi);
+    EXPECT_EQ(0x1000, caps.physicalAddress);
+    EXPECT_EQ(300, caps.maxTmdsClockMHz);
+
+    EXPECT_TRUE(caps.hdmiForum);
+    EXPECT_EQ(600, caps.maxTmdsCharacterRateMHz);
+    EXPECT_EQ(3, caps.maxFrlRate);
+    EXPECT_TRUE(caps.allm);
+    EXPECT_FALSE(caps.fva);
+    EXPECT_TRUE(caps.qms);
+    EXPECT_EQ(48, caps.vrrMin);
+    EXPECT_EQ(120, caps.vrrMax);
+}
+
+TEST(UtilsEdidTest, skipsBadExtensionsAndTruncatedDataBlocks)
+{
+    std::vector<uint8_t> edid = Edid();
+    Capabilities caps;
+
+    // Neither the VICs of the extension with the bad checksum nor those of the cut off block show up.
+    ASSERT_TRUE(Parse(edid.data(), edid.size(), caps));
+    EXPECT_EQ(3, caps.ctaRevision);
+    EXPECT_EQ(std::vector<uint8_t>({ 16, 4, 95 }), caps.vics);
+
+    // Extensions beyond the bytes given are not read.
+    ASSERT_TRUE(Parse(edid.data(), 128, caps));
+    EXPECT_EQ("SAM", caps.manufacturer);
+    EXPECT_EQ(0, caps.ctaRevision);
+    EXPECT_TRUE(caps.vics.empty());
+    EXPECT_FALSE(caps.hdmi);
+    EXPECT_EQ(0xFFFF, caps.physicalAddress);
+
+    // The base block has to be complete and intact.
+    EXPECT_FALSE(Parse(edid.data(), 127, caps));
+    EXPECT_FALSE(caps.valid);
+    EXPECT_FALSE(Parse(nullptr, edid.size(), caps));
+    edid[20] ^= 0x01;
+    EXPECT_FALSE(Parse(edid.data(), edid.size(), caps));
+    EXPECT_FALSE(caps.valid);
+    EXPECT_TRUE(caps.manufacturer.empty());
+}
@@ -0,0 +1,105 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Module.h"
+
+#include "IarmStandIn.h"
+#include "UtilsIarm.h"
+
+namespace {
+const char* const owner = "StandInOwner";
+
+IARM_Result_t doubleIt(void* arg)
+{
+    *static_cast<int*>(arg) *= 2;
+    return IARM_RESULT_SUCCESS;
+}
+}
+
+class UtilsIarmTest : public ::testing::Test {
+protected:
+    IarmStandIn bus;
+
+    UtilsIarmTest()
+    {
+        IarmBus::setImpl(&bus);
+        Utils::IarmCallStatistics::instance().reset();
+    }
+    virtual ~UtilsIarmTest() override
+    {
+        IarmBus::setImpl(nullptr);
+    }
+};
+
+TEST_F(UtilsIarmTest, bucketOf)
+{
+    EXPECT_EQ(0, Utils::IarmCallStatistics::bucketOf(0));
+    EXPECT_EQ(1, Utils::IarmCallStatistics::bucketOf(1));
+    EXPECT_EQ(11, Utils::IarmCallStatistics::bucketOf(1024));
+    EXPECT_EQ(11, Utils::IarmCallStatistics::bucketOf(2047));
+    EXPECT_EQ(Utils::IarmCallStatistics::BUCKETS - 1, Utils::IarmCallStatistics::bucketOf(~0ULL));
+}
+
+TEST_F(UtilsIarmTest, callIsServedAndCounted)
+{
+    ASSERT_TRUE(Utils::IARM::init());
+
+    bus.registerCall(owner, "double", doubleIt);
+    bus.setDelay(owner, "double", 2000);
+
+    int value = 21;
+    EXPECT_EQ(IARM_RESULT_SUCCESS, Utils::IARM::call(owner, "double", &value, sizeof(value)));
+    EXPECT_EQ(42, value);
+    EXPECT_EQ(1u, bus.calls(owner, "double"));
+
+    Utils::IarmCallStatistics::Entries entries = Utils::IarmCallStatistics::instance().entries();
+    ASSERT_EQ(1u, entries.count(std::make_pair(std::string(owner), std::string("double"))));
+
+    const Utils::IarmCallStatistics::Entry& entry = entries[std::make_pair(std::string(owner), std::string("double"))];
+    EXPECT_EQ(1u, entry.calls);
+    EXPECT_EQ(0u, entry.failures);
+    EXPECT_EQ(0u, entry.timeouts);
+    EXPECT_EQ(0u, entry.inFlight);
+    EXPECT_EQ(1u, entry.maxInFlight);
+    EXPECT_GE(entry.maxUs, 2000u);
+    EXPECT_EQ(entry.maxUs, entry.percentile(99));
+}
+
+TEST_F(UtilsIarmTest, slowCallTimesOut)
+{
+    ASSERT_TRUE(Utils::IARM::init());
+
+    bus.setDelay(owner, "slow", 50000);
+
+    int value = 0;
+    EXPECT_EQ(IARM_RESULT_IPCCORE_FAIL, Utils::IARM::callWithIPCTimeout(owner, "slow", &value, sizeof(value), 10));
+    EXPECT_EQ(IARM_RESULT_SUCCESS, Utils::IARM::callWithIPCTimeout(owner, "slow", &value, sizeof(value), 100));
+
+    Utils::IarmCallStatistics::Entries entries = Utils::IarmCallStatistics::instance().entries();
+    const Utils::IarmCallStatistics::Entry& entry = entries[std::make_pair(std::string(owner), std::string("slow"))];
+    EXPECT_EQ(2u, entry.calls);
+    EXPECT_EQ(1u, entry.failures);
+    EXPECT_EQ(1u, entry.timeouts);
+    EXPECT_GE(entry.maxUs, 50000u);
+
+    Utils::IarmCallStatistics::instance().reset();
+    EXPECT_TRUE(Utils::IarmCallStatistics::instance().entries().empty());
+}
@@ -1632,11 +1632,14 @@ TEST_F(UserSettingTest, NoDBFileInPersistentstoreErrorCase)
                 }
 
                 TEST_LOG("Setting and Getting AudioDescription Values after DB file deletion");
+                /* Writes are accepted into the local mirror and persisted asynchronously.
+                   The store rejects this one, so the mirror falls back to the persisted value. */
                 status = m_usersettingsplugin->SetAudioDescription(false);
-                EXPECT_EQ(status, Core::ERROR_GENERAL);
+                EXPECT_EQ(status, Core::ERROR_NONE);
 
                 signalled = notification.WaitForRequestStatus(JSON_TIMEOUT, UserSettings_onAudioDescriptionChanged);
                 EXPECT_TRUE(signalled & UserSettings_onAudioDescriptionChanged);
+                sleep(1);
 
                 status = m_usersettingsplugin->GetAudioDescription(getBoolValue);
                 EXPECT_EQ(getBoolValue, true);
@@ -1644,10 +1647,11 @@ TEST_F(UserSettingTest, NoDBFileInPersistentstoreErrorCase)
 
                 TEST_LOG("Setting and Getting setPinControl Values after DB file deletion");
                 status = m_usersettingsplugin->SetPinControl(false);
-                EXPECT_EQ(status, Core::ERROR_GENERAL);
+                EXPECT_EQ(status, Core::ERROR_NONE);
 
                 signalled = notification.WaitForRequestStatus(JSON_TIMEOUT, UserSettings_onPinControlChanged);
                 EXPECT_TRUE(signalled & UserSettings_onPinControlChanged);
+                sleep(1);
 
                 status = m_usersettingsplugin->GetPinControl(getBoolValue);
                 EXPECT_EQ(getBoolValue, true);
@@ -1668,6 +1672,61 @@ TEST_F(UserSettingTest, NoDBFileInPersistentstoreErrorCase)
         }
     }
 }
+TEST_F(UserSettingTest, GetReturnsLocalWriteBeforeStoreNotification)
+{
+    uint32_t status = Core::ERROR_GENERAL;
+    string getStringValue = "";
+    Core::Sink<NotificationHandler> notification;
+    uint32_t signalled = UserSettings_StateInvalid;
+
+    if (CreateUserSettingInterfaceObjectUsingComRPCConnection() != Core::ERROR_NONE)
+    {
+        TEST_LOG("Invalid Client_UserSettings");
+    }
+    else
+    {
+        ASSERT_TRUE(m_controller_usersettings!= nullptr);
+        if (m_controller_usersettings)
+        {
+            ASSERT_TRUE(m_usersettingsplugin!= nullptr);
+            if (m_usersettingsplugin)
+            {
+                m_usersettingsplugin->AddRef();
+                m_usersettingsplugin->Register(&notification);
+
+                /* read-your-writes: no need to wait for the store round trip */
+                status = m_usersettingsplugin->SetPreferredAudioLanguages("eng");
+                EXPECT_EQ(status, Core::ERROR_NONE);
+                status = m_usersettingsplugin->SetPreferredAudioLanguages("fra");
+                EXPECT_EQ(status, Core::ERROR_NONE);
+
+                status = m_usersettingsplugin->GetPreferredAudioLanguages(getStringValue);
+                EXPECT_EQ(getStringValue, "fra");
+                EXPECT_EQ(status, Core::ERROR_NONE);
+
+                signalled = notification.WaitForRequestStatus(JSON_TIMEOUT, UserSettings_onPreferredAudioLanguagesChanged);
+                EXPECT_TRUE(signalled & UserSettings_onPreferredAudioLanguagesChanged);
+
+                status = m_usersettingsplugin->GetPreferredAudioLanguages(getStringValue);
+                EXPECT_EQ(getStringValue, "fra");
+                EXPECT_EQ(status, Core::ERROR_NONE);
+
+                m_usersettingsplugin->Unregister(&notification);
+                m_usersettingsplugin->Release();
+            }
+            else
+            {
+                TEST_LOG("m_usersettingsplugin is NULL");
+            }
+            m_controller_usersettings->Release();
+        }
+        else
+        {
+            TEST_LOG("m_controller_usersettings is NULL");
+        }
+    }
+}
+
 #if 0
 TEST_F(UserSettingTest, PersistentstoreIsDeactivatedErrorCase)
 {
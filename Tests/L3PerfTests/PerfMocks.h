@@ -0,0 +1,35 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include "IarmBusMock.h"
+#include "RfcApiMock.h"
+#include "UdevMock.h"
+#include "WrapsMock.h"
+
+// The platform libraries are the same mocks the L1 tests use, with their defaults, so the
+// benchmarks measure the plugin code and not IARM, RFC, udev or the wrapped libc calls.
+// A benchmark that needs a particular answer sets it with ON_CALL; main() installs them.
+namespace PerfMocks {
+extern ::testing::NiceMock<IarmBusImplMock>* iarmBus;
+extern ::testing::NiceMock<RfcApiImplMock>* rfcApi;
+extern ::testing::NiceMock<UdevImplMock>* udev;
+extern ::testing::NiceMock<WrapsImplMock>* wraps;
+}
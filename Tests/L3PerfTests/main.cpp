@@ -0,0 +1,63 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <benchmark/benchmark.h>
+
+#include "PerfMocks.h"
+
+using ::testing::NiceMock;
+
+namespace PerfMocks {
+NiceMock<IarmBusImplMock>* iarmBus = nullptr;
+NiceMock<RfcApiImplMock>* rfcApi = nullptr;
+NiceMock<UdevImplMock>* udev = nullptr;
+NiceMock<WrapsImplMock>* wraps = nullptr;
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    PerfMocks::iarmBus = new NiceMock<IarmBusImplMock>;
+    PerfMocks::rfcApi = new NiceMock<RfcApiImplMock>;
+    PerfMocks::udev = new NiceMock<UdevImplMock>;
+    PerfMocks::wraps = new NiceMock<WrapsImplMock>;
+    IarmBus::setImpl(PerfMocks::iarmBus);
+    RfcApi::setImpl(PerfMocks::rfcApi);
+    Udev::setImpl(PerfMocks::udev);
+    Wraps::setImpl(PerfMocks::wraps);
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+
+    IarmBus::setImpl(nullptr);
+    RfcApi::setImpl(nullptr);
+    Udev::setImpl(nullptr);
+    Wraps::setImpl(nullptr);
+    delete PerfMocks::wraps;
+    delete PerfMocks::udev;
+    delete PerfMocks::rfcApi;
+    delete PerfMocks::iarmBus;
+
+    return 0;
+}
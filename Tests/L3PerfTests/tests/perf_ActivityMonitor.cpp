@@ -0,0 +1,48 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <benchmark/benchmark.h>
+
+#include "ActivityMonitor.h"
+
+using namespace WPEFramework;
+
+// One memory sample of the applications, as getAllMemoryUsage takes it: the free memory,
+// then stat and smaps of every process under /proc.
+static void ActivityMonitor_GetAllMemoryUsage(benchmark::State& state)
+{
+    Core::ProxyType<Plugin::ActivityMonitor> plugin(Core::ProxyType<Plugin::ActivityMonitor>::Create());
+    Core::JSONRPC::Handler& handler(*plugin);
+    Core::JSONRPC::Connection connection(1, 0);
+    string response;
+
+    plugin->Initialize(nullptr);
+
+    for (auto _ : state) {
+        if (handler.Invoke(connection, _T("getAllMemoryUsage"), _T(""), response) != Core::ERROR_NONE) {
+            state.SkipWithError("getAllMemoryUsage failed");
+            break;
+        }
+    }
+
+    plugin->Deinitialize(nullptr);
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(ActivityMonitor_GetAllMemoryUsage)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,122 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <benchmark/benchmark.h>
+
+#include "CookieJar.h"
+
+#include <limits>
+
+using namespace WPEFramework;
+
+namespace {
+// Generation 'generation' of a jar of 'size' cookies, the first 'changed' differ between generations.
+std::vector<std::string> MakeJar(size_t size, uint32_t generation, size_t changed)
+{
+    std::vector<std::string> cookies;
+    cookies.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        char cookie[256];
+        snprintf(cookie, sizeof(cookie),
+            "session_%zu=%08x%08zx; Path=/; Domain=.service%zu.example.com; Expires=Thu, 01 Jan 2032 00:00:00 GMT; Secure; HttpOnly",
+            i, (i < changed) ? generation : 0u, i * 2654435761u, i % 97);
+        cookies.push_back(cookie);
+    }
+    return cookies;
+}
+}
+
+// A full snapshot on every sync: set the jar, pack it and unpack it in a new jar, the argument
+// is the number of cookies. Two generations alternate so no Pack() is served from its cache.
+static void CookieJar_PackUnpack(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    const std::vector<std::string> generations[] = { MakeJar(size, 1, size), MakeJar(size, 2, size) };
+    Plugin::CookieJar jar;
+    uint32_t version, checksum;
+    string payload;
+    uint32_t i = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<std::string> cookies(generations[i++ % 2]);
+        state.ResumeTiming();
+
+        jar.SetCookies(std::move(cookies));
+        jar.Pack(version, checksum, payload);
+
+        Plugin::CookieJar restored;
+        if (restored.Unpack(version, checksum, payload) != Core::ERROR_NONE) {
+            state.SkipWithError("Unpack failed");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.counters["payload"] = payload.size();
+}
+BENCHMARK(CookieJar_PackUnpack)
+    ->ArgNames({ "cookies" })
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->Unit(benchmark::kMillisecond);
+
+// Delta sync of the second argument changed cookies per sync into a peer holding the jar.
+static void CookieJar_DeltaPackUnpack(benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    const size_t changed = state.range(1);
+    const std::vector<std::string> generations[] = { MakeJar(size, 1, changed), MakeJar(size, 2, changed) };
+    Plugin::CookieJar jar;
+    Plugin::CookieJar peer;
+    uint32_t version, checksum;
+    string payload;
+    uint32_t i = 0;
+
+    // No compaction in the measured window, every payload is a delta
+    jar.Configure(true, std::numeric_limits<uint16_t>::max());
+    peer.Configure(true, std::numeric_limits<uint16_t>::max());
+    jar.SetCookies(MakeJar(size, 0, 0));
+    jar.Pack(version, checksum, payload);
+    peer.Unpack(version, checksum, payload);
+    jar.Acknowledge(peer.Sequence());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<std::string> cookies(generations[i++ % 2]);
+        state.ResumeTiming();
+
+        jar.SetCookies(std::move(cookies));
+        jar.Pack(version, checksum, payload);
+        if (peer.Unpack(version, checksum, payload) != Core::ERROR_NONE) {
+            state.SkipWithError("Unpack failed");
+            break;
+        }
+        jar.Acknowledge(peer.Sequence());
+    }
+
+    state.SetItemsProcessed(state.iterations() * changed);
+    state.counters["payload"] = payload.size();
+}
+BENCHMARK(CookieJar_DeltaPackUnpack)
+    ->ArgNames({ "cookies", "changed" })
+    ->Args({ 1000, 10 })
+    ->Args({ 5000, 10 })
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,147 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <benchmark/benchmark.h>
+
+#include "Store2.h"
+
+#include "PerfMocks.h"
+#include "WorkerPoolImplementation.h"
+
+using namespace WPEFramework;
+
+using ::WPEFramework::Exchange::IStore2;
+using ::WPEFramework::Plugin::Sqlite::Store2;
+
+namespace {
+const auto kPath = "/tmp/rdkservicesl3perf/persistentstore/store2";
+const auto kMaxSize = 10000000;
+const auto kMaxValue = 4096;
+const auto kLimit = 1000000;
+const auto kNamespace = "perf";
+const auto kKeys = 1000;
+}
+
+// Store2 on a fresh database, with the system time reported as synced by the IARM mock,
+// so values with a ttl are stored instead of failing with ERROR_PENDING_CONDITIONS.
+class PersistentStore : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State&) override
+    {
+        ON_CALL(*PerfMocks::iarmBus, IARM_Bus_Call_with_IPCTimeout(::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_))
+            .WillByDefault(::testing::Invoke(
+                [](const char*, const char* methodName, void* arg, size_t, int) {
+                    if (strcmp(methodName, IARM_BUS_SYSMGR_API_GetSystemStates) == 0) {
+                        auto param = static_cast<IARM_Bus_SYSMgr_GetSystemStates_Param_t*>(arg);
+                        param->time_source.state = 1;
+                    }
+                    return IARM_RESULT_SUCCESS;
+                }));
+
+        Core::File(string(kPath)).Destroy();
+
+        workerPool = Core::ProxyType<WorkerPoolImplementation>::Create(
+            2, Core::Thread::DefaultStackSize(), 1024);
+        Core::IWorkerPool::Assign(&(*workerPool));
+        workerPool->Run();
+
+        store = Core::ProxyType<Store2>::Create(kPath, kMaxSize, kMaxValue, kLimit);
+    }
+
+    void TearDown(const benchmark::State&) override
+    {
+        store.Release();
+
+        Core::IWorkerPool::Assign(nullptr);
+        workerPool.Release();
+
+        Core::File(string(kPath)).Destroy();
+    }
+
+    void Populate(const string& value)
+    {
+        for (int i = 0; i < kKeys; i++) {
+            store->SetValue(IStore2::ScopeType::DEVICE, kNamespace, "key" + std::to_string(i), value, 0);
+        }
+    }
+
+protected:
+    Core::ProxyType<WorkerPoolImplementation> workerPool;
+    Core::ProxyType<Store2> store;
+};
+
+BENCHMARK_DEFINE_F(PersistentStore, SetValue)(benchmark::State& state)
+{
+    const string value(state.range(0), 'v');
+    const uint32_t ttl = state.range(1);
+    int i = 0;
+
+    for (auto _ : state) {
+        if (store->SetValue(IStore2::ScopeType::DEVICE, kNamespace, "key" + std::to_string(i++ % kKeys), value, ttl) != Core::ERROR_NONE) {
+            state.SkipWithError("SetValue failed");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * value.size());
+}
+BENCHMARK_REGISTER_F(PersistentStore, SetValue)
+    ->ArgNames({ "value", "ttl" })
+    ->Args({ 16, 0 })
+    ->Args({ 1024, 0 })
+    ->Args({ 16, 60 });
+
+BENCHMARK_DEFINE_F(PersistentStore, GetValue)(benchmark::State& state)
+{
+    Populate(string(state.range(0), 'v'));
+
+    string value;
+    uint32_t ttl;
+    int i = 0;
+
+    for (auto _ : state) {
+        if (store->GetValue(IStore2::ScopeType::DEVICE, kNamespace, "key" + std::to_string(i++ % kKeys), value, ttl) != Core::ERROR_NONE) {
+            state.SkipWithError("GetValue failed");
+            break;
+        }
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(PersistentStore, GetValue)
+    ->ArgNames({ "value" })
+    ->Arg(16)
+    ->Arg(1024);
+
+BENCHMARK_DEFINE_F(PersistentStore, GetValueUnknownKey)(benchmark::State& state)
+{
+    Populate(string(16, 'v'));
+
+    string value;
+    uint32_t ttl;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(store->GetValue(IStore2::ScopeType::DEVICE, kNamespace, "unknown", value, ttl));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(PersistentStore, GetValueUnknownKey);
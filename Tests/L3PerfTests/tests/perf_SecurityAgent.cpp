@@ -0,0 +1,92 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <benchmark/benchmark.h>
+
+#include "AccessControlList.h"
+
+using namespace WPEFramework;
+
+namespace {
+const char* kOrigins[] = {
+    "http://localhost:9998/index.html",
+    "http://127.0.0.1",
+    "file:///usr/share/app/index.html",
+    "https://apps.comcast.com/guide?x=1",
+    "https://metrological.com/store",
+    "https://unknown.example.org/",
+};
+const char* kCallsigns[] = { "DeviceInfo", "JSONRPCPlugin", "Compositor", "Controller", "org.rdk.System" };
+const char* kMethods[] = { "register", "unregister", "systeminfo", "time", "status", "getDeviceInfo" };
+
+const size_t kChecks = (sizeof(kOrigins) / sizeof(kOrigins[0])) * (sizeof(kCallsigns) / sizeof(kCallsigns[0])) * (sizeof(kMethods) / sizeof(kMethods[0]));
+
+bool Load(Plugin::AccessControlList& acl)
+{
+    Core::File file(string(SECURITYAGENT_EXAMPLE_ACL));
+    return (file.Open(true) == true) && (acl.Load(file) != Core::ERROR_GENERAL);
+}
+
+uint32_t CheckAll(const Plugin::AccessControlList& acl)
+{
+    uint32_t allowed = 0;
+    for (const char* origin : kOrigins)
+        for (const char* callsign : kCallsigns)
+            for (const char* method : kMethods)
+                allowed += acl.Allowed(origin, callsign, method) ? 1 : 0;
+    return allowed;
+}
+}
+
+// One iteration checks every origin, callsign and method combination, the argument is the
+// size of the verdict cache (0 evaluates the compiled ACL every time).
+static void SecurityAgent_Allowed(benchmark::State& state)
+{
+    Plugin::AccessControlList acl(state.range(0));
+    if (Load(acl) == false) {
+        state.SkipWithError("Cannot load " SECURITYAGENT_EXAMPLE_ACL);
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CheckAll(acl));
+    }
+
+    state.SetItemsProcessed(state.iterations() * kChecks);
+}
+BENCHMARK(SecurityAgent_Allowed)
+    ->ArgNames({ "cache" })
+    ->Arg(0)
+    ->Arg(512);
+
+static void SecurityAgent_LoadAndCheck(benchmark::State& state)
+{
+    Plugin::AccessControlList acl;
+
+    for (auto _ : state) {
+        if (Load(acl) == false) {
+            state.SkipWithError("Cannot load " SECURITYAGENT_EXAMPLE_ACL);
+            break;
+        }
+        benchmark::DoNotOptimize(CheckAll(acl));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(SecurityAgent_LoadAndCheck);
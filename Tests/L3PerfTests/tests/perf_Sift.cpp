@@ -0,0 +1,98 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <benchmark/benchmark.h>
+
+#include "SiftBackend.h"
+
+using namespace WPEFramework;
+
+namespace {
+Plugin::SiftConfig::Attributes MakeAttributes(bool schema2)
+{
+    Plugin::SiftConfig::Attributes attributes;
+    attributes.schema2Enabled = schema2;
+    attributes.commonSchema = "entos/common/v1";
+    attributes.env = "prod";
+    attributes.productName = "entos";
+    attributes.productVersion = "1.0.0";
+    attributes.loggerName = "Analytics";
+    attributes.loggerVersion = "1.0.0";
+    attributes.partnerId = "partner";
+    attributes.xboAccountId = "1234567890";
+    attributes.xboDeviceId = "0987654321";
+    attributes.activated = true;
+    attributes.deviceModel = "model";
+    attributes.deviceType = "IPSTB";
+    attributes.deviceTimeZone = "3600";
+    attributes.deviceOsName = "rdk";
+    attributes.deviceOsVersion = "1.0.0";
+    attributes.platform = "platform";
+    attributes.deviceManufacturer = "manufacturer";
+    attributes.authenticated = true;
+    attributes.sessionId = "4b8e1a9d-4c4a-4f6e-9bd5-0c1a5a7b3e21";
+    attributes.proposition = "proposition";
+    attributes.deviceSerialNumber = "SERIAL0123456789";
+    attributes.deviceFriendlyName = "Living Room";
+    attributes.deviceMacAddress = "00:11:22:33:44:55";
+    attributes.country = "US";
+    attributes.region = "CO";
+    attributes.accountType = "residential";
+    attributes.deviceSoftwareVersion = "1.0.0";
+    attributes.deviceAppName = "app";
+    attributes.deviceAppVersion = "1.0.0";
+    attributes.accountId = "1234567890";
+    attributes.deviceId = "0987654321";
+    return attributes;
+}
+
+Plugin::IAnalyticsBackend::Event MakeEvent()
+{
+    Plugin::IAnalyticsBackend::Event event;
+    event.eventName = "app_launch";
+    event.eventVersion = "1";
+    event.eventSource = "ResidentApp";
+    event.eventSourceVersion = "1.0.0";
+    event.cetList = { "cet1", "cet2" };
+    event.epochTimestamp = 1727800000000;
+    event.eventPayload = "{\"appId\":\"com.example.app\",\"launchType\":\"cold\",\"durationMs\":1234,\"visible\":true}";
+    return event;
+}
+}
+
+// The JSON a Sift event is posted to the store as, for the 1.0 (argument 0) and 2.0 schema.
+static void Sift_ComposeEvent(benchmark::State& state)
+{
+    const Plugin::SiftConfig::Attributes attributes(MakeAttributes(state.range(0) != 0));
+    const Plugin::IAnalyticsBackend::Event event(MakeEvent());
+    std::string json;
+
+    for (auto _ : state) {
+        json.clear();
+        Plugin::SiftBackend::ComposeEvent(event, attributes, json);
+        benchmark::DoNotOptimize(json);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(Sift_ComposeEvent)
+    ->ArgNames({ "schema2" })
+    ->Arg(0)
+    ->Arg(1);
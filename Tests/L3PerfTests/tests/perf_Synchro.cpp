@@ -0,0 +1,104 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <benchmark/benchmark.h>
+
+#include <plugins/plugins.h>
+
+#include "UtilsJsonRpc.h"
+#include "UtilsSynchro.hpp"
+
+using namespace WPEFramework;
+
+namespace {
+
+// The same handler registered twice: once as a plain JSON-RPC method, once as a locked API
+// the way the plugins using Utils::Synchro register theirs.
+class LockedApi : public PluginHost::JSONRPC {
+public:
+    LockedApi(const LockedApi&) = delete;
+    LockedApi& operator=(const LockedApi&) = delete;
+
+    LockedApi()
+        : PluginHost::JSONRPC()
+    {
+        Register(_T("echo"), &LockedApi::echo, this);
+        Utils::Synchro::RegisterLockedApi(_T("lockedEcho"), &LockedApi::echo, this);
+    }
+    ~LockedApi() override
+    {
+        Unregister(_T("echo"));
+        Unregister(_T("lockedEcho"));
+    }
+
+    BEGIN_INTERFACE_MAP(LockedApi)
+    INTERFACE_ENTRY(PluginHost::IDispatcher)
+    END_INTERFACE_MAP
+
+private:
+    uint32_t echo(const JsonObject& parameters, JsonObject& response)
+    {
+        response["value"] = parameters["value"];
+        returnResponse(true);
+    }
+};
+
+Core::ProxyType<LockedApi> plugin;
+
+void SetUp(const benchmark::State&)
+{
+    plugin = Core::ProxyType<LockedApi>::Create();
+}
+
+void TearDown(const benchmark::State&)
+{
+    plugin.Release();
+}
+
+void Dispatch(benchmark::State& state, const string& method)
+{
+    Core::JSONRPC::Handler& handler(*plugin);
+    Core::JSONRPC::Connection connection(1, 0);
+    const string parameters(_T("{\"value\":\"0123456789abcdef\"}"));
+    string response;
+
+    for (auto _ : state) {
+        if (handler.Invoke(connection, method, parameters, response) != Core::ERROR_NONE) {
+            state.SkipWithError("Invoke failed");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+}
+
+// Invoke() through the JSON-RPC handler, parameters and response as text, without and with
+// the per plugin API lock; with more threads the locked variant shows the lock contention.
+static void Synchro_Dispatch(benchmark::State& state)
+{
+    Dispatch(state, _T("echo"));
+}
+BENCHMARK(Synchro_Dispatch)->Setup(SetUp)->Teardown(TearDown)->ThreadRange(1, 4)->UseRealTime();
+
+static void Synchro_DispatchLocked(benchmark::State& state)
+{
+    Dispatch(state, _T("lockedEcho"));
+}
+BENCHMARK(Synchro_DispatchLocked)->Setup(SetUp)->Teardown(TearDown)->ThreadRange(1, 4)->UseRealTime();
@@ -0,0 +1,197 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "IarmStandIn.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+IarmStandIn::IarmStandIn()
+    : m_name()
+    , m_connected(false)
+    , m_defaultDelayUs(0)
+{
+}
+
+void IarmStandIn::setDefaultDelay(uint32_t delayUs)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_defaultDelayUs = delayUs;
+}
+
+void IarmStandIn::setDelay(const std::string& owner, const std::string& method, uint32_t delayUs)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_delays[Key(owner, method)] = delayUs;
+}
+
+void IarmStandIn::registerCall(const std::string& owner, const std::string& method, IARM_BusCall_t handler)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_calls[Key(owner, method)] = handler;
+}
+
+uint32_t IarmStandIn::calls(const std::string& owner, const std::string& method) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_counts.find(Key(owner, method));
+    return (it != m_counts.end() ? it->second : 0);
+}
+
+IARM_Result_t IarmStandIn::IARM_Bus_Init(const char* name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_name.empty()) {
+        return IARM_RESULT_INVALID_STATE;
+    }
+    m_name = (name != nullptr ? name : "");
+    return IARM_RESULT_SUCCESS;
+}
+
+IARM_Result_t IarmStandIn::IARM_Bus_Connect()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_name.empty()) {
+        return IARM_RESULT_INVALID_STATE;
+    }
+    m_connected = true;
+    return IARM_RESULT_SUCCESS;
+}
+
+IARM_Result_t IarmStandIn::IARM_Bus_IsConnected(const char* memberName, int* isRegistered)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (isRegistered == nullptr) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    *isRegistered = ((m_connected && (memberName != nullptr) && (m_name == memberName)) ? 1 : 0);
+    return IARM_RESULT_SUCCESS;
+}
+
+IARM_Result_t IarmStandIn::IARM_Bus_RegisterEventHandler(const char* ownerName, IARM_EventId_t eventId, IARM_EventHandler_t handler)
+{
+    if ((ownerName == nullptr) || (handler == nullptr)) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_handlers[Event(ownerName, eventId)].push_back(handler);
+    return IARM_RESULT_SUCCESS;
+}
+
+IARM_Result_t IarmStandIn::IARM_Bus_UnRegisterEventHandler(const char* ownerName, IARM_EventId_t eventId)
+{
+    if (ownerName == nullptr) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_handlers.erase(Event(ownerName, eventId));
+    return IARM_RESULT_SUCCESS;
+}
+
+IARM_Result_t IarmStandIn::IARM_Bus_RemoveEventHandler(const char* ownerName, IARM_EventId_t eventId, IARM_EventHandler_t handler)
+{
+    if (ownerName == nullptr) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_handlers.find(Event(ownerName, eventId));
+    if (it != m_handlers.end()) {
+        it->second.erase(std::remove(it->second.begin(), it->second.end(), handler), it->second.end());
+    }
+    return IARM_RESULT_SUCCESS;
+}
+
+IARM_Result_t IarmStandIn::IARM_Bus_Call(const char* ownerName, const char* methodName, void* arg, size_t)
+{
+    return serve(ownerName, methodName, arg, 0);
+}
+
+IARM_Result_t IarmStandIn::IARM_Bus_BroadcastEvent(const char* ownerName, IARM_EventId_t eventId, void* arg, size_t argLen)
+{
+    if (ownerName == nullptr) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    std::vector<IARM_EventHandler_t> handlers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_handlers.find(Event(ownerName, eventId));
+        if (it != m_handlers.end()) {
+            handlers = it->second;
+        }
+    }
+    // Like the bus, handlers run without any lock of the sender held.
+    for (IARM_EventHandler_t handler : handlers) {
+        handler(ownerName, eventId, arg, argLen);
+    }
+    return IARM_RESULT_SUCCESS;
+}
+
+IARM_Result_t IarmStandIn::IARM_Bus_RegisterCall(const char* methodName, IARM_BusCall_t handler)
+{
+    if ((methodName == nullptr) || (handler == nullptr)) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_name.empty()) {
+        return IARM_RESULT_INVALID_STATE;
+    }
+    m_calls[Key(m_name, methodName)] = handler;
+    return IARM_RESULT_SUCCESS;
+}
+
+IARM_Result_t IarmStandIn::IARM_Bus_Call_with_IPCTimeout(const char* ownerName, const char* methodName, void* arg, size_t, int timeout)
+{
+    return serve(ownerName, methodName, arg, timeout);
+}
+
+IARM_Result_t IarmStandIn::serve(const char* ownerName, const char* methodName, void* arg, int timeoutMs)
+{
+    if ((ownerName == nullptr) || (methodName == nullptr)) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+
+    const Key key(ownerName, methodName);
+    uint32_t delayUs;
+    IARM_BusCall_t handler = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_connected) {
+            return IARM_RESULT_INVALID_STATE;
+        }
+        m_counts[key]++;
+        auto delay = m_delays.find(key);
+        delayUs = (delay != m_delays.end() ? delay->second : m_defaultDelayUs);
+        auto call = m_calls.find(key);
+        if (call != m_calls.end()) {
+            handler = call->second;
+        }
+    }
+
+    if ((timeoutMs > 0) && (delayUs > (static_cast<uint32_t>(timeoutMs) * 1000))) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+        return IARM_RESULT_IPCCORE_FAIL;
+    }
+
+    if (delayUs > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(delayUs));
+    }
+
+    return (handler != nullptr ? handler(arg) : IARM_RESULT_SUCCESS);
+}
@@ -0,0 +1,75 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "libIBus.h"
+
+// An in-process IARM bus to install with IarmBus::setImpl(), for running plugins against
+// IARM calls that take a realistic time. Calls are served by the handlers registered for
+// their owner and method, after the configured delay; calls without a handler succeed and
+// leave their argument untouched. A call with an IPC timeout shorter than its delay fails
+// with IARM_RESULT_IPCCORE_FAIL once the timeout has passed.
+class IarmStandIn : public IarmBusImpl {
+public:
+    IarmStandIn();
+    ~IarmStandIn() override = default;
+
+    IarmStandIn(const IarmStandIn&) = delete;
+    IarmStandIn& operator=(const IarmStandIn&) = delete;
+
+    void setDefaultDelay(uint32_t delayUs);
+    void setDelay(const std::string& owner, const std::string& method, uint32_t delayUs);
+    // A call served by another process, e.g. a daemon, the plugins only see it as an owner.
+    void registerCall(const std::string& owner, const std::string& method, IARM_BusCall_t handler);
+
+    uint32_t calls(const std::string& owner, const std::string& method) const;
+
+    IARM_Result_t IARM_Bus_Init(const char* name) override;
+    IARM_Result_t IARM_Bus_Connect() override;
+    IARM_Result_t IARM_Bus_IsConnected(const char* memberName, int* isRegistered) override;
+    IARM_Result_t IARM_Bus_RegisterEventHandler(const char* ownerName, IARM_EventId_t eventId, IARM_EventHandler_t handler) override;
+    IARM_Result_t IARM_Bus_UnRegisterEventHandler(const char* ownerName, IARM_EventId_t eventId) override;
+    IARM_Result_t IARM_Bus_RemoveEventHandler(const char* ownerName, IARM_EventId_t eventId, IARM_EventHandler_t handler) override;
+    IARM_Result_t IARM_Bus_Call(const char* ownerName, const char* methodName, void* arg, size_t argLen) override;
+    IARM_Result_t IARM_Bus_BroadcastEvent(const char* ownerName, IARM_EventId_t eventId, void* arg, size_t argLen) override;
+    IARM_Result_t IARM_Bus_RegisterCall(const char* methodName, IARM_BusCall_t handler) override;
+    IARM_Result_t IARM_Bus_Call_with_IPCTimeout(const char* ownerName, const char* methodName, void* arg, size_t argLen, int timeout) override;
+
+private:
+    typedef std::pair<std::string, std::string> Key;
+    typedef std::pair<std::string, IARM_EventId_t> Event;
+
+    IARM_Result_t serve(const char* ownerName, const char* methodName, void* arg, int timeoutMs);
+
+    mutable std::mutex m_mutex;
+    std::string m_name;
+    bool m_connected;
+    uint32_t m_defaultDelayUs;
+    std::map<Key, uint32_t> m_delays;
+    std::map<Key, IARM_BusCall_t> m_calls;
+    std::map<Key, uint32_t> m_counts;
+    std::map<Event, std::vector<IARM_EventHandler_t>> m_handlers;
+};
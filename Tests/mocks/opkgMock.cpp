@@ -41,4 +41,9 @@ void opkg_download_cleanup(void)
 int opkg_list_upgradable_packages(opkg_package_callback_t callback, void *user_data)
 {
         return 0;
-}
\ No newline at end of file
+}
+
+pkg_t *opkg_find_package(const char *name, const char *version, const char *architecture, const char *repository)
+{
+        return NULL;
+}
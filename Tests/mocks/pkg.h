@@ -22,11 +22,17 @@ typedef struct opkg_conf {
 
 } opkg_conf_t;
 
+typedef struct pkg_src {
+    char *name;
+    char *value;
+} pkg_src_t;
+
 struct pkg {
     char *name;
 	char *local_filename;
 	char *version;
-	
+	char *filename;
+	pkg_src_t *src;
 };
 typedef struct pkg pkg_t;
 
@@ -61,6 +67,7 @@ int opkg_upgrade_package(const char *package_name, opkg_progress_callback_t call
 int opkg_new(void);
 void opkg_download_cleanup(void);
 int opkg_list_upgradable_packages(opkg_package_callback_t callback, void *user_data);
+pkg_t *opkg_find_package(const char *name, const char *version, const char *architecture, const char *repository);
 
 #ifdef __cplusplus
 }
@@ -41,6 +41,7 @@
 #define TIMER_EVT_TIMER_EXPIRY_REMINDER   "timerExpiryReminder"
 
 #define TIMER_ACCURACY 0.001 // 10 milliseconds
+#define TIMER_MAX_TIMEOUT 100000.0 // seconds
 
 static const char* stateStrings[] = {
     "",
@@ -58,7 +59,7 @@ static const char* modeStrings[] = {
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 4
+#define API_VERSION_NUMBER_PATCH 5
 
 namespace WPEFramework
 {
@@ -94,12 +95,28 @@ namespace WPEFramework
             Register(TIMER_METHOD_RESUME, &Timer::resumeWrapper, this);
             Register(TIMER_METHOD_GET_TIMER_STATUS, &Timer::getTimerStatusWrapper, this);
             Register(TIMER_METHOD_GET_TIMERS, &Timer::getTimersWrapper, this);
-
-            m_timer.connect(std::bind(&Timer::onTimerCallback, this));
         }
 
         Timer::~Timer()
         {
+            std::vector<std::unique_ptr<TpTimer>> timers;
+
+            {
+                std::lock_guard<std::mutex> guard(m_callMutex);
+
+                for (auto& item : m_timerItems)
+                {
+                    if (item.timer)
+                    {
+                        item.timer->stop();
+                        timers.push_back(std::move(item.timer));
+                    }
+                }
+            }
+
+            // ~TpTimer waits for a callback still running, which needs m_callMutex, so the timers go
+            // here, without the lock, and before the members they use are destroyed.
+            timers.clear();
         }
         
         void Timer::InitializeIARM()
@@ -124,74 +141,60 @@ namespace WPEFramework
             Timer::_instance = nullptr;
         }
 
-        void Timer::checkTimers()
+        void Timer::scheduleTimer(int timerId)
         {
-            double minTimeout = 100000;
-            for (auto it = m_runningItems.cbegin(); it != m_runningItems.cend(); ++it)
+            std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - m_timerItems[timerId].lastExpired;
+            double timeout =  m_timerItems[timerId].interval - elapsed.count();
+
+            if (!m_timerItems[timerId].reminderSent && m_timerItems[timerId].remindBefore > TIMER_ACCURACY)
             {
-                unsigned int timerId = *it;
-                if (timerId >= m_timerItems.size())
-                {
-                    LOGERR("Internal error: wrong timerId");
-                    continue;
-                }
-                if (m_timerItems[timerId].state != RUNNING)
+                if (timeout > m_timerItems[timerId].remindBefore)
                 {
-                    LOGERR("Internal error: timer %d has wrong state", timerId);
-                    continue;
+                    timeout -= m_timerItems[timerId].remindBefore;
                 }
-
-                std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - m_timerItems[timerId].lastExpired;
-                double timeout =  m_timerItems[timerId].interval - elapsed.count();
-
-                if (!m_timerItems[timerId].reminderSent && m_timerItems[timerId].remindBefore > TIMER_ACCURACY)
+                else
                 {
-                    if (timeout > m_timerItems[timerId].remindBefore)
-                    {
-                        timeout -= m_timerItems[timerId].remindBefore;
-                    }
-                    else
-                    {
-                        sendTimerExpiryReminder(timerId);
-                        m_timerItems[timerId].reminderSent = true;
-                    }
+                    sendTimerExpiryReminder(timerId);
+                    m_timerItems[timerId].reminderSent = true;
                 }
-
-                if (timeout < minTimeout)
-                    minTimeout = timeout;
             }
 
-            if (minTimeout < TIMER_ACCURACY)
-                minTimeout = TIMER_ACCURACY;
+            if (timeout < TIMER_ACCURACY)
+                timeout = TIMER_ACCURACY;
 
-            if (minTimeout < 100000)
-                m_timer.start(int(minTimeout * 1000));
-            else
-                m_timer.stop();
+            // Longer timeouts are split up, the callback finds the timer not due yet and schedules the rest.
+            if (timeout > TIMER_MAX_TIMEOUT)
+                timeout = TIMER_MAX_TIMEOUT;
+
+            m_timerItems[timerId].timer->start(int(timeout * 1000));
         }
 
         void Timer::startTimer(int timerId)
         {
-            m_runningItems.push_back(timerId);
             m_timerItems[timerId].state = RUNNING;
 
             m_timerItems[timerId].lastExpired = std::chrono::system_clock::now();
             m_timerItems[timerId].lastExpiryReminder = std::chrono::system_clock::now();
             m_timerItems[timerId].reminderSent = false;
 
-            checkTimers();
+            if (!m_timerItems[timerId].timer)
+            {
+                m_timerItems[timerId].timer.reset(new TpTimer());
+                m_timerItems[timerId].timer->connect(std::bind(&Timer::onTimerCallback, this, timerId));
+            }
+
+            scheduleTimer(timerId);
         }
 
         bool Timer::cancelTimer(int timerId)
         {
+            bool wasRunning = (RUNNING == m_timerItems[timerId].state);
+
             m_timerItems[timerId].state = CANCELED;
 
-            auto it = std::find(m_runningItems.begin(), m_runningItems.end(), timerId);
-            if (m_runningItems.end() != it)
+            if (wasRunning)
             {
-                m_runningItems.erase(it);
-                m_timer.stop();
-                checkTimers();
+                m_timerItems[timerId].timer->stop();
                 return true;
             }
 
@@ -200,81 +203,64 @@ namespace WPEFramework
 
         bool Timer::suspendTimer(int timerId)
         {
+            bool wasRunning = (RUNNING == m_timerItems[timerId].state);
+
             m_timerItems[timerId].state = SUSPENDED;
 
-            auto it = std::find(m_runningItems.begin(), m_runningItems.end(), timerId);
-            if (m_runningItems.end() != it)
+            if (wasRunning)
             {
-                m_runningItems.erase(it);
-                m_timer.stop();
-                checkTimers();
+                m_timerItems[timerId].timer->stop();
                 return true;
             }
 
             return false;
         }
 
-        void Timer::onTimerCallback()
+        void Timer::onTimerCallback(int timerId)
         {
             std::lock_guard<std::mutex> guard(m_callMutex);
 
-            std::list <int> itemsToDelete;
+            if (!m_timerItems[timerId].timer)
+                return; // Being destroyed
 
-            for (auto it = m_runningItems.cbegin(); it != m_runningItems.cend(); ++it)
+            if (m_timerItems[timerId].state != RUNNING)
             {
-                unsigned int timerId = *it;
-                if (timerId >= m_timerItems.size())
-                {
-                    LOGERR("Internal error: wrong timerId");
-                    continue;
-                }
-                if (m_timerItems[timerId].state != RUNNING)
-                {
-                    LOGERR("Internal error: timer %d has wrong state", timerId);
-                    continue;
-                }
-
-                std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - m_timerItems[timerId].lastExpired;
-                double timeout =  m_timerItems[timerId].interval - elapsed.count();
+                m_timerItems[timerId].timer->stop();
+                return;
+            }
 
-                if (!m_timerItems[timerId].reminderSent && m_timerItems[timerId].remindBefore > TIMER_ACCURACY)
-                {
-                    if (timeout < m_timerItems[timerId].remindBefore + TIMER_ACCURACY)
-                    {
-                        sendTimerExpiryReminder(timerId);
-                        m_timerItems[timerId].reminderSent = true;
-                    }
-                }
+            std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - m_timerItems[timerId].lastExpired;
+            double timeout =  m_timerItems[timerId].interval - elapsed.count();
 
-                if (timeout <= TIMER_ACCURACY)
+            if (!m_timerItems[timerId].reminderSent && m_timerItems[timerId].remindBefore > TIMER_ACCURACY)
+            {
+                if (timeout < m_timerItems[timerId].remindBefore + TIMER_ACCURACY)
                 {
-                    sendTimerExpired(timerId);
-
-                    m_timerItems[timerId].lastExpired = std::chrono::system_clock::now();
-
-                    if (m_timerItems[timerId].repeatInterval > 0)
-                    {
-                        m_timerItems[timerId].interval = m_timerItems[timerId].repeatInterval;
-                    }
-                    else
-                    {
-                        m_timerItems[timerId].state = EXPIRED;
-                        itemsToDelete.push_back(timerId);
-                    }
-
-                    m_timerItems[timerId].reminderSent = false;
+                    sendTimerExpiryReminder(timerId);
+                    m_timerItems[timerId].reminderSent = true;
                 }
             }
 
-            for (auto delIt = itemsToDelete.cbegin(); delIt != itemsToDelete.cend(); ++delIt)
+            if (timeout <= TIMER_ACCURACY)
             {
-                auto it = std::find(m_runningItems.begin(), m_runningItems.end(), *delIt);
-                if (m_runningItems.end() != it)
-                    m_runningItems.erase(it);
+                sendTimerExpired(timerId);
+
+                m_timerItems[timerId].lastExpired = std::chrono::system_clock::now();
+                m_timerItems[timerId].reminderSent = false;
 
+                if (m_timerItems[timerId].repeatInterval > 0)
+                {
+                    m_timerItems[timerId].interval = m_timerItems[timerId].repeatInterval;
+                }
+                else
+                {
+                    m_timerItems[timerId].state = EXPIRED;
+                    m_timerItems[timerId].timer->stop();
+                    return;
+                }
             }
 
-            checkTimers();
+            scheduleTimer(timerId);
         }
 
         void Timer::getTimerStatus(int timerId, JsonObject& output, bool writeTimerId)
@@ -332,7 +318,7 @@ namespace WPEFramework
             item.repeatInterval = parameters.HasLabel("repeatInterval") ? std::stod(parameters["repeatInterval"].String()) : 0.0;
             item.remindBefore = parameters.HasLabel("remindBefore") ? std::stod(parameters["remindBefore"].String()) : 0.0;
 
-            m_timerItems.push_back(item);
+            m_timerItems.push_back(std::move(item));
 
             startTimer(m_timerItems.size() - 1);
             response["timerId"] = m_timerItems.size() - 1;
@@ -494,7 +480,7 @@ namespace WPEFramework
                 dataToSend.length = sizeof(buf);
                 memcpy(dataToSend.data, buf, dataToSend.length);
                 LOGINFO("Timer send CEC %s", SLEEP == m_timerItems[timerId].mode ? "Standby" : "Wake");
-                IARM_Result_t res = IARM_Bus_Call(IARM_BUS_CECMGR_NAME,IARM_BUS_CECMGR_API_Send,(void *)&dataToSend, sizeof(dataToSend));
+                IARM_Result_t res = Utils::IARM::call(IARM_BUS_CECMGR_NAME,IARM_BUS_CECMGR_API_Send,(void *)&dataToSend, sizeof(dataToSend));
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - API_Send IARM_BUS_CECMGR FAILED, res: %d", (int)res);
@@ -53,6 +53,7 @@ namespace WPEFramework {
             std::chrono::system_clock::time_point lastExpired;
             std::chrono::system_clock::time_point lastExpiryReminder;
             bool reminderSent;
+            std::unique_ptr<TpTimer> timer;
         };
 
 		// This is a server for a JSONRPC communication channel.
@@ -88,13 +89,13 @@ namespace WPEFramework {
             void sendTimerExpiryReminder(int timerId);
             //End events
 
-            void checkTimers();
+            void scheduleTimer(int timerId);
 
             void startTimer(int timerId);
             bool cancelTimer(int timerId);
             bool suspendTimer(int timerId);
 
-            void onTimerCallback();
+            void onTimerCallback(int timerId);
             void getTimerStatus(int timerId, JsonObject& output, bool writeTimerId = false);
 
         protected:
@@ -116,9 +117,7 @@ namespace WPEFramework {
         public:
             static Timer* _instance;
         private:
-            TpTimer m_timer;
             std::vector <TimerItem> m_timerItems;
-            std::list <int> m_runningItems;
             std::mutex m_callMutex;
         };
 	} // namespace Plugin
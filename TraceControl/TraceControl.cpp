@@ -22,7 +22,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 2
+#define API_VERSION_NUMBER_PATCH 3
 
 namespace WPEFramework {
 
@@ -100,7 +100,7 @@ namespace Plugin {
         _service->Register(&_observer);
 
         // Start observing..
-        _observer.Start();
+        _observer.Start(_config.Collectors.Value(), _config.Queue.Value());
 
         // On succes return a name as a Callsign to be used in the URL, after the "service"prefix
         return (_T(""));
@@ -227,13 +227,13 @@ namespace Plugin {
         return (result);
     }
 
-    void TraceControl::Dispatch(Observer::Source& information)
+    void TraceControl::Dispatch(const Observer::Entry& information)
     {
         std::list<Trace::ITraceMedia*>::iterator index(_outputs.begin());
         InformationWrapper wrapper(information);
 
         while (index != _outputs.end()) {
-            (*index)->Output(information.FileName(), information.LineNumber(), information.ClassName(), &wrapper);
+            (*index)->Output(information.FileName.c_str(), information.LineNumber, information.ClassName.c_str(), &wrapper);
             index++;
         }
     }
@@ -46,6 +46,19 @@ namespace Plugin {
             Observer& operator=(const Observer&) = delete;
 
         public:
+            // A decoded trace entry, owned by the batch it travels in, so the source can be read on while the
+            // outputs are busy with it.
+            struct Entry {
+                uint64_t Timestamp;
+                uint32_t LineNumber;
+                string FileName;
+                string Module;
+                string Category;
+                string ClassName;
+                string Information;
+            };
+            typedef std::vector<Entry> Batch;
+
             class Source : public Core::CyclicBuffer {
             private:
                 Source() = delete;
@@ -128,6 +141,9 @@ namespace Plugin {
                     , _classname(0)
                     , _information()
                     , _state(EMPTY)
+                    , _entries(0)
+                    , _dropped(0)
+                    , _overwritten(0)
                 {
                     if (_connection != nullptr) {
                         TRACE(Trace::Information, (_T("Constructing TraceControl::Source (%d)"), connection->Id()));
@@ -308,6 +324,47 @@ namespace Plugin {
                 {
                     _state = EMPTY;
                 }
+                void Copy(Entry& entry) const
+                {
+                    ASSERT(_state == LOADED);
+
+                    entry.Timestamp = Timestamp();
+                    entry.LineNumber = LineNumber();
+                    entry.FileName = FileName();
+                    entry.Module = Module();
+                    entry.Category = Category();
+                    entry.ClassName = ClassName();
+                    entry.Information.assign(Information(), Length());
+                }
+
+                // Counters, only updated by the collector owning this source.
+                inline uint32_t Entries() const
+                {
+                    return (_entries);
+                }
+                inline uint32_t Dropped() const
+                {
+                    return (_dropped);
+                }
+                inline uint32_t Overwritten() const
+                {
+                    return (_overwritten);
+                }
+                inline void Collected()
+                {
+                    _entries++;
+                }
+                inline void Dropped(const uint32_t count)
+                {
+                    _dropped += count;
+                }
+                inline void CheckOverwritten()
+                {
+                    // The producer sets the flag whenever it had to make room by discarding entries we did not read yet.
+                    if (Core::CyclicBuffer::Overwritten() == true) {
+                        _overwritten++;
+                    }
+                }
 
             private:
                 virtual uint32_t GetReadSize(Core::CyclicBuffer::Cursor& cursor) override
@@ -327,6 +384,9 @@ namespace Plugin {
                 uint16_t _information;
                 uint16_t _length = 0;
                 state _state;
+                std::atomic<uint32_t> _entries;
+                std::atomic<uint32_t> _dropped;
+                std::atomic<uint32_t> _overwritten;
                 uint8_t _traceBuffer[Trace::CyclicBufferSize];
                 static LocalIterator _localIterator;
             };
@@ -549,10 +609,255 @@ namespace Plugin {
                 ModuleMapIterator _iterator;
             };
 
+            // Drains the sources assigned to it, a bounded batch per source per pass, so one busy process can
+            // not starve the others. A source is only ever read by one collector, the lock is only contended
+            // when sources come and go.
+            class Collector : public Core::Thread {
+            private:
+                Collector() = delete;
+                Collector(const Collector&) = delete;
+                Collector& operator=(const Collector&) = delete;
+
+            public:
+                static constexpr uint16_t BatchSize = 64;
+
+                Collector(Observer& parent, const uint8_t index)
+                    : Thread(Core::Thread::DefaultStackSize(), _T("TraceCollector") + Core::NumberType<uint8_t>(index).Text())
+                    , _adminLock()
+                    , _signal(false, true)
+                    , _sources()
+                    , _parent(parent)
+                {
+                }
+                ~Collector()
+                {
+                    ASSERT(_sources.size() == 0);
+                }
+
+            public:
+                void Add(Source* source)
+                {
+                    _adminLock.Lock();
+                    _sources.push_back(source);
+                    _adminLock.Unlock();
+
+                    Trigger();
+                }
+                void Remove(Source* source)
+                {
+                    // Once this returns, we are not reading from the source anymore.
+                    _adminLock.Lock();
+                    _sources.remove(source);
+                    _adminLock.Unlock();
+                }
+                void Clear()
+                {
+                    _adminLock.Lock();
+                    _sources.clear();
+                    _adminLock.Unlock();
+                }
+                void Trigger()
+                {
+                    _signal.SetEvent();
+                }
+                void Start()
+                {
+                    Thread::Run();
+                }
+                void Stop()
+                {
+                    Block();
+                    Trigger();
+                    Wait(Thread::BLOCKED | Thread::STOPPED | Thread::STOPPING, Core::infinite);
+                }
+
+            private:
+                virtual uint32_t Worker()
+                {
+                    Batch batch;
+                    batch.reserve(BatchSize);
+
+                    while ((IsRunning() == true) && (_signal.Lock(Core::infinite) == Core::ERROR_NONE)) {
+                        // Before we start we reset the flag, if new info is coming in, we will get a retrigger.
+                        _signal.ResetEvent();
+
+                        bool pending;
+
+                        do {
+                            pending = false;
+
+                            _adminLock.Lock();
+
+                            std::list<Source*>::iterator index(_sources.begin());
+
+                            while ((IsRunning() == true) && (index != _sources.end())) {
+                                Source& source(**index);
+                                Source::state state(Source::EMPTY);
+
+                                source.CheckOverwritten();
+
+                                while ((batch.size() < BatchSize) && ((state = source.Load()) == Source::LOADED)) {
+                                    batch.emplace_back();
+                                    source.Copy(batch.back());
+                                    source.Clear();
+                                }
+
+                                if (state == Source::FAILURE) {
+                                    // Oops this requires recovery, so let's flush, whatever was in there is lost.
+                                    source.Dropped(1);
+                                    source.Flush();
+                                } else if (batch.size() == BatchSize) {
+                                    // There might be more, first give the other sources their turn.
+                                    pending = true;
+                                }
+
+                                if (batch.empty() == false) {
+                                    const uint32_t count = static_cast<uint32_t>(batch.size());
+
+                                    if (_parent.Submit(batch) == true) {
+                                        for (uint32_t i = 0; i < count; i++) {
+                                            source.Collected();
+                                        }
+                                    } else {
+                                        source.Dropped(count);
+                                    }
+                                    batch.clear();
+                                }
+
+                                index++;
+                            }
+
+                            _adminLock.Unlock();
+
+                        } while ((IsRunning() == true) && (pending == true));
+                    }
+
+                    return (Core::infinite);
+                }
+
+            private:
+                Core::CriticalSection _adminLock;
+                Core::Event _signal;
+                std::list<Source*> _sources;
+                Observer& _parent;
+            };
+
+            // Hands the collected batches to the outputs, so a slow output (syslog, remote) holds up this
+            // thread only, not the reading of the trace buffers. The queue is bounded, batches that do not
+            // fit anymore are dropped and accounted to their source.
+            class Dispatcher : public Core::Thread {
+            private:
+                Dispatcher() = delete;
+                Dispatcher(const Dispatcher&) = delete;
+                Dispatcher& operator=(const Dispatcher&) = delete;
+
+            public:
+                Dispatcher(TraceControl& parent)
+                    : Thread(Core::Thread::DefaultStackSize(), _T("TraceDispatcher"))
+                    , _adminLock()
+                    , _signal(false, true)
+                    , _queue()
+                    , _queued(0)
+                    , _limit(0)
+                    , _parent(parent)
+                {
+                }
+                ~Dispatcher()
+                {
+                    ASSERT(_queue.size() == 0);
+                }
+
+            public:
+                void Start(const uint32_t limit)
+                {
+                    _limit = limit;
+                    Thread::Run();
+                }
+                void Stop()
+                {
+                    Block();
+                    _signal.SetEvent();
+                    Wait(Thread::BLOCKED | Thread::STOPPED | Thread::STOPPING, Core::infinite);
+
+                    // Whatever made it into the queue is still delivered.
+                    Flush();
+                }
+                bool Submit(Batch& batch)
+                {
+                    bool result = false;
+
+                    _adminLock.Lock();
+
+                    if ((_queued + batch.size()) <= _limit) {
+                        _queued += static_cast<uint32_t>(batch.size());
+                        _queue.emplace_back();
+                        _queue.back().swap(batch);
+                        result = true;
+                    }
+
+                    _adminLock.Unlock();
+
+                    if (result == true) {
+                        _signal.SetEvent();
+                    }
+
+                    return (result);
+                }
+
+            private:
+                void Flush()
+                {
+                    std::list<Batch> queue;
+
+                    _adminLock.Lock();
+                    queue.swap(_queue);
+                    _queued = 0;
+                    _adminLock.Unlock();
+
+                    if (queue.empty() == false) {
+                        // Every batch is in order, the sources are collected in parallel though, so merge them
+                        // on time before they go out.
+                        Batch entries(std::move(queue.front()));
+                        queue.pop_front();
+
+                        while (queue.empty() == false) {
+                            entries.insert(entries.end(), std::make_move_iterator(queue.front().begin()), std::make_move_iterator(queue.front().end()));
+                            queue.pop_front();
+                        }
+
+                        std::stable_sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) { return (lhs.Timestamp < rhs.Timestamp); });
+
+                        for (const Entry& entry : entries) {
+                            _parent.Dispatch(entry);
+                        }
+                    }
+                }
+                virtual uint32_t Worker()
+                {
+                    while ((IsRunning() == true) && (_signal.Lock(Core::infinite) == Core::ERROR_NONE)) {
+                        _signal.ResetEvent();
+
+                        Flush();
+                    }
+
+                    return (Core::infinite);
+                }
+
+            private:
+                Core::CriticalSection _adminLock;
+                Core::Event _signal;
+                std::list<Batch> _queue;
+                uint32_t _queued;
+                uint32_t _limit;
+                TraceControl& _parent;
+            };
+
         public:
             Observer(TraceControl& parent)
                 : Thread(Core::Thread::DefaultStackSize(), _T("TraceWorker"))
                 , _buffers()
+                , _collectors()
+                , _dispatcher(parent)
                 , _traceControl(Trace::TraceUnit::Instance())
                 , _parent(parent)
                 , _refcount(0)
@@ -562,6 +867,7 @@ namespace Plugin {
             {
                 ASSERT(_refcount == 0);
                 ASSERT(_buffers.size() == 0);
+                ASSERT(_collectors.size() == 0);
                 _traceControl.Relinquish();
                 Wait(Thread::BLOCKED | Thread::STOPPED | Thread::STOPPING, Core::infinite);
             }
@@ -571,9 +877,30 @@ namespace Plugin {
             {
                 _traceControl.Announce();
             }
-            void Start() 
+            void Start(const uint8_t collectors, const uint32_t queue)
             {
+                // A batch that can never fit the queue would always be dropped.
+                _dispatcher.Start(std::max(queue, static_cast<uint32_t>(Collector::BatchSize)));
+
+                _adminLock.Lock();
+
+                for (uint8_t index = 0; index < std::max(collectors, static_cast<uint8_t>(1)); index++) {
+                    _collectors.push_back(new Collector(*this, index));
+                    _collectors.back()->Start();
+                }
+
                 _buffers.insert(std::pair<const uint32_t, Source*>(0, new Source(_parent.TracePath(), nullptr)));
+
+                // Connections might have been activated before we got started.
+                std::map<const uint32_t, Source*>::iterator index(_buffers.begin());
+
+                while (index != _buffers.end()) {
+                    Assign(*(index->second));
+                    index++;
+                }
+
+                _adminLock.Unlock();
+
                 _traceControl.Announce();
                 Thread::Run();
             }
@@ -587,6 +914,19 @@ namespace Plugin {
 
                 _adminLock.Lock();
 
+                while (_collectors.size() != 0) {
+                    _collectors.back()->Stop();
+                    _collectors.back()->Clear();
+                    delete _collectors.back();
+                    _collectors.pop_back();
+                }
+
+                _adminLock.Unlock();
+
+                _dispatcher.Stop();
+
+                _adminLock.Lock();
+
                 while (_buffers.size() != 0) {
                     delete _buffers.begin()->second;
 
@@ -602,7 +942,13 @@ namespace Plugin {
                 ASSERT(_buffers.find(connection->Id()) == _buffers.end());
 
                 // By definition, get the buffer file from WPEFramework (local source)
-                _buffers.insert(std::pair<const uint32_t, Source*>(connection->Id(), new Source(_parent.TracePath(), connection)));
+                Source* source = new Source(_parent.TracePath(), connection);
+                _buffers.insert(std::pair<const uint32_t, Source*>(connection->Id(), source));
+
+                if (_collectors.empty() == false) {
+                    Assign(*source);
+                }
+
                 _traceControl.Announce();
 
                 _adminLock.Unlock();
@@ -614,6 +960,9 @@ namespace Plugin {
                 std::map<const uint32_t, Source*>::iterator index(_buffers.find(connection->Id()));
 
                 if (index != _buffers.end()) {
+                    if (_collectors.empty() == false) {
+                        _collectors[index->first % _collectors.size()]->Remove(index->second);
+                    }
                     delete (index->second);
                     _buffers.erase(index);
                 }
@@ -649,6 +998,21 @@ namespace Plugin {
                 _adminLock.Unlock();
             }
 
+            template <typename ACTION>
+            void Sources(ACTION&& action)
+            {
+                _adminLock.Lock();
+
+                std::map<const uint32_t, Source*>::const_iterator index(_buffers.begin());
+
+                while (index != _buffers.end()) {
+                    action(static_cast<const Source&>(*(index->second)));
+                    index++;
+                }
+
+                _adminLock.Unlock();
+            }
+
             inline ModuleIterator Modules() const
             {
                 return (ModuleIterator(_buffers));
@@ -669,62 +1033,29 @@ namespace Plugin {
 
                 return (Core::ERROR_NONE);
             }
+            bool Submit(Batch& batch)
+            {
+                return (_dispatcher.Submit(batch));
+            }
+            void Assign(Source& source)
+            {
+                // A connection sticks to its collector for its lifetime.
+                _collectors[source.Id() % _collectors.size()]->Add(&source);
+            }
             virtual uint32_t Worker()
             {
-                
+                // All processes ring the same doorbell, wake up the collectors, they know who has something.
                 while ((IsRunning() == true) && (_traceControl.Wait(Core::infinite) == Core::ERROR_NONE)) {
                     // Before we start we reset the flag, if new info is coming in, we will get a retrigger flag.
                     _traceControl.Acknowledge();
 
-                    Source* selected;
-
-                    uint64_t timeStamp;
-
-                    do {
-                        selected = nullptr;
-
-                        _adminLock.Lock();
-
-                        timeStamp = static_cast<uint64_t>(~0);
-
-                        std::map<const uint32_t, Source*>::iterator index(_buffers.begin());
-
-                        while (index != _buffers.end()) {
-
-                            Source::state state(index->second->Load());
-
-                            if (state == Source::LOADED) {
-                                if (index->second->Timestamp() < timeStamp) {
-                                    timeStamp = index->second->Timestamp();
-
-                                    if (state == Source::LOADED) {
-                                        selected = index->second;
-                                    }
-                                }
-                            } else if (state == Source::FAILURE) {
-                                // Oops this requires recovery, so let's flush
-                                index->second->Flush();
-                            }
-
-                            index++;
-                        }
+                    _adminLock.Lock();
 
-                        if (selected != nullptr) {
-
-                            // Oke, output this entry
-                            _parent.Dispatch(*selected);
-
-                            // Ready to load a new one..
-                            selected->Clear();
-                        } else if (timeStamp != static_cast<uint64_t>(~0)) {
-                            // Looks like we are waiting for a message to be completed.
-                            // Give up our slice, so the producer, can produce.
-                            ::SleepMs(0);
-                        }
-
-                        _adminLock.Unlock();
+                    for (Collector* collector : _collectors) {
+                        collector->Trigger();
+                    }
 
-                    } while ((IsRunning() == true) && (timeStamp != static_cast<uint64_t>(~0)));
+                    _adminLock.Unlock();
                 }
 
                 return (Core::infinite);
@@ -733,6 +1064,8 @@ namespace Plugin {
         private:
             Core::CriticalSection _adminLock;
             std::map<const uint32_t, Source*> _buffers;
+            std::vector<Collector*> _collectors;
+            Dispatcher _dispatcher;
             Trace::TraceUnit& _traceControl;
             TraceControl& _parent;
             mutable uint32_t _refcount;
@@ -745,7 +1078,7 @@ namespace Plugin {
             InformationWrapper& operator=(const InformationWrapper&) = delete;
 
         public:
-            InformationWrapper(const TraceControl::Observer::Source& information)
+            InformationWrapper(const TraceControl::Observer::Entry& information)
                 : _info(information)
             {
             }
@@ -756,23 +1089,23 @@ namespace Plugin {
         public:
             virtual const char* Category() const
             {
-                return (_info.Category());
+                return (_info.Category.c_str());
             }
             virtual const char* Module() const
             {
-                return (_info.Module());
+                return (_info.Module.c_str());
             }
             virtual const char* Data() const
             {
-                return (_info.Information());
+                return (_info.Information.c_str());
             }
             virtual uint16_t Length() const
             {
-                return (_info.Length());
+                return (static_cast<uint16_t>(_info.Information.length()));
             }
 
         private:
-            const TraceControl::Observer::Source& _info;
+            const TraceControl::Observer::Entry& _info;
         };
 
     public:
@@ -822,11 +1155,15 @@ namespace Plugin {
                 , SysLog(true)
                 , Abbreviated(true)
                 , Remote()
+                , Collectors(2)
+                , Queue(4096)
             {
                 Add(_T("console"), &Console);
                 Add(_T("syslog"), &SysLog);
                 Add(_T("abbreviated"), &Abbreviated);
                 Add(_T("remote"), &Remote);
+                Add(_T("collectors"), &Collectors);
+                Add(_T("queue"), &Queue);
             }
             ~Config()
             {
@@ -837,6 +1174,8 @@ namespace Plugin {
             Core::JSON::Boolean SysLog;
             Core::JSON::Boolean Abbreviated;
             NetworkNode Remote;
+            Core::JSON::DecUInt8 Collectors; // Number of threads reading the trace buffers
+            Core::JSON::DecUInt32 Queue; // Maximum number of entries waiting for the outputs
         };
         class Data : public Core::JSON::Container {
         public:
@@ -859,6 +1198,54 @@ namespace Plugin {
                 Core::JSON::String Category; // Category name
             }; // class StatusDataParam
 
+            class Source final : public Core::JSON::Container {
+            public:
+                Source()
+                    : Core::JSON::Container()
+                {
+                    Add(_T("id"), &Id);
+                    Add(_T("entries"), &Entries);
+                    Add(_T("dropped"), &Dropped);
+                    Add(_T("overwritten"), &Overwritten);
+                }
+                Source(const Source& copy)
+                    : Core::JSON::Container()
+                    , Id(copy.Id)
+                    , Entries(copy.Entries)
+                    , Dropped(copy.Dropped)
+                    , Overwritten(copy.Overwritten)
+                {
+                    Add(_T("id"), &Id);
+                    Add(_T("entries"), &Entries);
+                    Add(_T("dropped"), &Dropped);
+                    Add(_T("overwritten"), &Overwritten);
+                }
+
+                Source& operator=(const Source&) = delete;
+
+            public:
+                Core::JSON::DecUInt32 Id; // Connection id, 0 for the framework itself
+                Core::JSON::DecUInt32 Entries; // Entries handed to the outputs
+                Core::JSON::DecUInt32 Dropped; // Entries lost in here, corrupt or not fitting the queue
+                Core::JSON::DecUInt32 Overwritten; // Times the process overwrote entries not read yet
+            }; // class Source
+
+            // The status result of the interface, extended with the collection counters per source.
+            class StatusResult final : public JsonData::TraceControl::StatusResultData {
+            public:
+                StatusResult()
+                    : JsonData::TraceControl::StatusResultData()
+                {
+                    Add(_T("sources"), &Sources);
+                }
+
+                StatusResult(const StatusResult&) = delete;
+                StatusResult& operator=(const StatusResult&) = delete;
+
+            public:
+                Core::JSON::ArrayType<Source> Sources;
+            }; // class StatusResult
+
             class Trace : public Core::JSON::Container {
             private:
                 Trace& operator=(const Trace&);
@@ -986,12 +1373,12 @@ namespace Plugin {
         virtual Core::ProxyType<Web::Response> Process(const Web::Request& request);
 
     private:
-        void Dispatch(Observer::Source& information);
+        void Dispatch(const Observer::Entry& information);
 
         void RegisterAll();
         void UnregisterAll();
         JsonData::TraceControl::StateType TranslateState(TraceControl::state state);
-        uint32_t endpoint_status(const JsonData::TraceControl::StatusParamsData& params, JsonData::TraceControl::StatusResultData& response);
+        uint32_t endpoint_status(const JsonData::TraceControl::StatusParamsData& params, Data::StatusResult& response);
         uint32_t endpoint_set(const JsonData::TraceControl::TraceInfo& params);
         inline const string& TracePath() const 
         {
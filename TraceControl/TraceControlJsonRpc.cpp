@@ -32,7 +32,7 @@ namespace Plugin {
 
     void TraceControl::RegisterAll()
     {
-        Register<StatusParamsData,StatusResultData>(_T("status"), &TraceControl::endpoint_status, this);
+        Register<StatusParamsData,Data::StatusResult>(_T("status"), &TraceControl::endpoint_status, this);
         Register<TraceInfo,void>(_T("set"), &TraceControl::endpoint_set, this);
     }
 
@@ -68,7 +68,7 @@ namespace Plugin {
     // Method: status - Retrieves general information
     // Return codes:
     //  - ERROR_NONE: Success
-    uint32_t TraceControl::endpoint_status(const StatusParamsData& params, StatusResultData& response)
+    uint32_t TraceControl::endpoint_status(const StatusParamsData& params, Data::StatusResult& response)
     {
         uint32_t result = Core::ERROR_NONE;
 
@@ -99,6 +99,15 @@ namespace Plugin {
         }
         _observer.Relinquish();
 
+        _observer.Sources([&response](const Observer::Source& source) {
+            Data::Source info;
+            info.Id = source.Id();
+            info.Entries = source.Entries();
+            info.Dropped = source.Dropped();
+            info.Overwritten = source.Overwritten();
+            response.Sources.Add(info);
+        });
+
         return result;
     }
 
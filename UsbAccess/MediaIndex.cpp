@@ -0,0 +1,404 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MediaIndex.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "UtilsLogging.h"
+
+namespace WPEFramework {
+namespace Plugin {
+
+namespace {
+
+    // Bounds for what one device may cost: directories deeper than this are read on request only, and
+    // past the watch budget new directories are not indexed (inotify watches are a system wide resource).
+    constexpr uint32_t kMaxDepth = 16;
+    constexpr size_t kMaxDirectories = 4096;
+
+    constexpr uint32_t kWatchMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_ONLYDIR;
+
+    const struct {
+        const char* extension;
+        MediaIndex::kind media;
+    } kExtensions[] = {
+        { "png", MediaIndex::IMAGE }, { "jpg", MediaIndex::IMAGE }, { "jpeg", MediaIndex::IMAGE },
+        { "tiff", MediaIndex::IMAGE }, { "tif", MediaIndex::IMAGE }, { "bmp", MediaIndex::IMAGE },
+        { "mp4", MediaIndex::VIDEO }, { "mov", MediaIndex::VIDEO }, { "avi", MediaIndex::VIDEO },
+        { "ts", MediaIndex::VIDEO },
+        { "mp3", MediaIndex::AUDIO }, { "wav", MediaIndex::AUDIO }, { "m4a", MediaIndex::AUDIO },
+        { "flac", MediaIndex::AUDIO }, { "aac", MediaIndex::AUDIO }, { "wma", MediaIndex::AUDIO }
+    };
+
+    const char* kKindNames[] = { "other", "folder", "image", "video", "audio", "any" };
+
+    string joinPath(const string& directory, const string& name)
+    {
+        return ((directory.empty() == false) && (*directory.rbegin() == '/') ? directory + name : directory + '/' + name);
+    }
+
+    bool isDots(const string& name)
+    {
+        return ((name == ".") || (name == ".."));
+    }
+
+    void describe(const string& name, const bool folder, const struct stat* info, const std::regex& listed, MediaIndex::Entry& entry)
+    {
+        entry.name = name;
+        entry.type = (folder ? 'd' : 'f');
+        entry.media = (folder ? MediaIndex::FOLDER : MediaIndex::Classify(name));
+        entry.listed = (folder || std::regex_match(name, listed));
+        entry.size = ((info != nullptr) && (folder == false) ? static_cast<uint64_t>(info->st_size) : 0);
+        entry.mtime = (info != nullptr ? info->st_mtime : 0);
+    }
+
+}
+
+    MediaIndex::MediaIndex(const string& root, const std::regex& listed)
+        : _root(root)
+        , _listed(listed)
+        , _adminLock()
+        , _directories()
+        , _watches()
+        , _inotify(-1)
+        , _wakeup(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        , _stop(false)
+        , _thread()
+    {
+        _thread = std::thread(&MediaIndex::Run, this);
+    }
+
+    MediaIndex::~MediaIndex()
+    {
+        _stop = true;
+
+        if (_wakeup != -1) {
+            uint64_t one = 1;
+            if (write(_wakeup, &one, sizeof(one)) != sizeof(one)) {
+                LOGWARN("cannot wake up the indexer of %s", _root.c_str());
+            }
+        }
+
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+
+        if (_inotify != -1) {
+            close(_inotify);
+        }
+        if (_wakeup != -1) {
+            close(_wakeup);
+        }
+    }
+
+    bool MediaIndex::List(const string& directory, const Query& query, Entries& page, uint32_t& total) const
+    {
+        std::lock_guard<std::mutex> lock(_adminLock);
+
+        auto index = _directories.find(Normalize(directory));
+        if (index == _directories.end()) {
+            return false;
+        }
+
+        total = Select(index->second, query, page);
+        return true;
+    }
+
+    /* static */ bool MediaIndex::Read(const string& directory, const std::regex& listed, Entries& entries)
+    {
+        DIR* dirp = opendir(directory.c_str());
+        if (dirp == nullptr) {
+            return false;
+        }
+
+        entries.clear();
+
+        struct dirent* dp;
+        while ((dp = readdir(dirp)) != nullptr) {
+            struct stat info;
+            const bool known = (fstatat(dirfd(dirp), dp->d_name, &info, AT_SYMLINK_NOFOLLOW) == 0);
+            const bool folder = ((dp->d_type == DT_DIR) || ((dp->d_type == DT_UNKNOWN) && known && S_ISDIR(info.st_mode)));
+
+            entries.emplace_back();
+            describe(dp->d_name, folder, (known ? &info : nullptr), listed, entries.back());
+        }
+        closedir(dirp);
+
+        std::sort(entries.begin(), entries.end());
+
+        return true;
+    }
+
+    /* static */ uint32_t MediaIndex::Select(const Entries& entries, const Query& query, Entries& page)
+    {
+        uint32_t total = 0;
+
+        page.clear();
+
+        for (const Entry& entry : entries) {
+            const bool match = (entry.type == 'd')
+                ? query.includeFolders
+                : (((query.listedOnly == false) || (entry.listed == true)) && ((query.media == ANY) || (entry.media == query.media)));
+
+            if (match == true) {
+                if ((total >= query.offset) && ((query.limit == 0) || (page.size() < query.limit))) {
+                    page.push_back(entry);
+                }
+                total++;
+            }
+        }
+
+        return total;
+    }
+
+    /* static */ MediaIndex::kind MediaIndex::Classify(const string& name)
+    {
+        kind result = OTHER;
+
+        size_t dot = name.find_last_of('.');
+        if (dot != string::npos) {
+            string extension(name.substr(dot + 1));
+            std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+            for (const auto& known : kExtensions) {
+                if (extension == known.extension) {
+                    result = known.media;
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    /* static */ const char* MediaIndex::KindName(const kind media)
+    {
+        return kKindNames[(media <= ANY) ? media : OTHER];
+    }
+
+    /* static */ MediaIndex::kind MediaIndex::KindFromName(const string& name)
+    {
+        for (uint8_t media = OTHER; media <= ANY; media++) {
+            if (name == kKindNames[media]) {
+                return static_cast<kind>(media);
+            }
+        }
+        return ANY;
+    }
+
+    string MediaIndex::Normalize(const string& directory) const
+    {
+        string result(directory);
+        while ((result.size() > 1) && (*result.rbegin() == '/')) {
+            result.erase(result.size() - 1);
+        }
+        return result;
+    }
+
+    void MediaIndex::Run()
+    {
+        _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (_inotify == -1) {
+            LOGWARN("inotify unavailable, %s is indexed once and not refreshed", _root.c_str());
+        }
+
+        Scan(Normalize(_root), 0);
+
+        if (_stop == false) {
+            std::lock_guard<std::mutex> lock(_adminLock);
+            LOGINFO("indexed %zu directories of %s", _directories.size(), _root.c_str());
+        }
+
+        while ((_stop == false) && (_inotify != -1)) {
+            struct pollfd fds[2] = { { _inotify, POLLIN, 0 }, { _wakeup, POLLIN, 0 } };
+
+            if (poll(fds, (_wakeup != -1 ? 2 : 1), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                LOGERR("poll failed on the index of %s: %d", _root.c_str(), errno);
+                break;
+            }
+
+            if ((fds[0].revents & POLLIN) != 0) {
+                Drain();
+            }
+        }
+    }
+
+    void MediaIndex::Scan(const string& directory, const uint32_t depth)
+    {
+        Entries entries;
+
+        if (_stop == true) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_adminLock);
+            if (_directories.size() >= kMaxDirectories) {
+                return;
+            }
+        }
+
+        // Watch before reading, a change in between then shows up as an event rather than getting lost.
+        if (_inotify != -1) {
+            int watch = inotify_add_watch(_inotify, directory.c_str(), kWatchMask);
+            if (watch != -1) {
+                _watches[watch] = directory;
+            }
+        }
+
+        if (Read(directory, _listed, entries) == false) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_adminLock);
+            _directories[directory] = entries;
+        }
+
+        if (depth < kMaxDepth) {
+            for (const Entry& entry : entries) {
+                if ((entry.type == 'd') && (isDots(entry.name) == false)) {
+                    Scan(joinPath(directory, entry.name), depth + 1);
+                }
+            }
+        }
+    }
+
+    void MediaIndex::Refresh(const string& directory, const string& name)
+    {
+        const string path(joinPath(directory, name));
+        struct stat info;
+        const bool exists = (lstat(path.c_str(), &info) == 0);
+        bool scan = false;
+        bool forget = false;
+
+        {
+            std::lock_guard<std::mutex> lock(_adminLock);
+
+            auto index = _directories.find(directory);
+            if (index == _directories.end()) {
+                return;
+            }
+
+            Entries& entries = index->second;
+            Entry entry;
+            describe(name, (exists && S_ISDIR(info.st_mode)), (exists ? &info : nullptr), _listed, entry);
+
+            auto position = std::lower_bound(entries.begin(), entries.end(), entry);
+            const bool present = ((position != entries.end()) && (position->name == name));
+
+            if (exists == true) {
+                if (present == true) {
+                    forget = ((position->type == 'd') && (entry.type != 'd'));
+                    *position = entry;
+                } else {
+                    entries.insert(position, entry);
+                    scan = (entry.type == 'd');
+                }
+            } else if (present == true) {
+                forget = (position->type == 'd');
+                entries.erase(position);
+            }
+
+            scan = scan && (_directories.find(path) == _directories.end());
+        }
+
+        if (forget == true) {
+            Forget(path);
+        }
+        if (scan == true) {
+            Scan(path, static_cast<uint32_t>(std::count(path.begin() + Normalize(_root).size(), path.end(), '/')));
+        }
+    }
+
+    void MediaIndex::Forget(const string& directory)
+    {
+        const string prefix(joinPath(directory, ""));
+
+        {
+            std::lock_guard<std::mutex> lock(_adminLock);
+            for (auto index = _directories.begin(); index != _directories.end();) {
+                if ((index->first == directory) || (index->first.compare(0, prefix.size(), prefix) == 0)) {
+                    index = _directories.erase(index);
+                } else {
+                    ++index;
+                }
+            }
+        }
+
+        for (auto watch = _watches.begin(); watch != _watches.end();) {
+            if ((watch->second == directory) || (watch->second.compare(0, prefix.size(), prefix) == 0)) {
+                inotify_rm_watch(_inotify, watch->first);
+                watch = _watches.erase(watch);
+            } else {
+                ++watch;
+            }
+        }
+    }
+
+    void MediaIndex::Drain()
+    {
+        alignas(struct inotify_event) char buffer[16 * 1024];
+        ssize_t length;
+
+        while ((_stop == false) && ((length = read(_inotify, buffer, sizeof(buffer))) > 0)) {
+            for (char* cursor = buffer; cursor < buffer + length;) {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(cursor);
+                cursor += sizeof(struct inotify_event) + event->len;
+
+                if ((event->mask & IN_Q_OVERFLOW) != 0) {
+                    // Events were lost, nothing short of reading everything again is reliable.
+                    LOGWARN("inotify queue overflow, indexing %s again", _root.c_str());
+                    Forget(Normalize(_root));
+                    Scan(Normalize(_root), 0);
+                    continue;
+                }
+
+                auto watch = _watches.find(event->wd);
+                if (watch == _watches.end()) {
+                    continue;
+                }
+
+                const string directory(watch->second);
+
+                if ((event->mask & IN_IGNORED) != 0) {
+                    _watches.erase(watch);
+                } else if ((event->mask & IN_DELETE_SELF) != 0) {
+                    Forget(directory);
+                } else if (event->len > 0) {
+                    Refresh(directory, event->name);
+                }
+            }
+        }
+    }
+
+} // namespace Plugin
+} // namespace WPEFramework
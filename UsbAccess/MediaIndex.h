@@ -0,0 +1,116 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <regex>
+#include <thread>
+#include <vector>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Listing of every directory of one mounted USB device, built by a background thread when the device
+    // shows up and kept current with inotify afterwards. Each directory is a vector sorted by name that
+    // carries the type, size and modification time of its entries, so a page of a large photo or video
+    // folder is served without reading the directory or matching file names again.
+    class MediaIndex {
+    public:
+        enum kind : uint8_t {
+            OTHER,
+            FOLDER,
+            IMAGE,
+            VIDEO,
+            AUDIO,
+            ANY
+        };
+
+        struct Entry {
+            string name;
+            char type; // 'f' or 'd'
+            kind media;
+            bool listed; // a folder, or a file name matching the listing pattern
+            uint64_t size;
+            time_t mtime;
+
+            bool operator<(const Entry& other) const
+            {
+                return (name < other.name);
+            }
+        };
+        typedef std::vector<Entry> Entries;
+
+        struct Query {
+            bool includeFolders;
+            bool listedOnly;
+            kind media; // ANY, or the only kind of files to return
+            uint32_t offset;
+            uint32_t limit; // 0 for all
+        };
+
+        MediaIndex(const MediaIndex&) = delete;
+        MediaIndex& operator=(const MediaIndex&) = delete;
+
+        // listed is kept by reference and has to outlive the index.
+        MediaIndex(const string& root, const std::regex& listed);
+        ~MediaIndex();
+
+        const string& Root() const
+        {
+            return (_root);
+        }
+
+        // False when the directory is not (yet) in the index; the caller reads it itself then.
+        bool List(const string& directory, const Query& query, Entries& page, uint32_t& total) const;
+
+        // Reads one directory the way the indexer does, sorted by name.
+        static bool Read(const string& directory, const std::regex& listed, Entries& entries);
+        // Copies the requested page of the entries matching the query, returns how many match in total.
+        static uint32_t Select(const Entries& entries, const Query& query, Entries& page);
+        static kind Classify(const string& name);
+        static const char* KindName(const kind media);
+        static kind KindFromName(const string& name);
+
+    private:
+        void Run();
+        void Scan(const string& directory, const uint32_t depth);
+        void Refresh(const string& directory, const string& name);
+        void Forget(const string& directory);
+        void Drain();
+        string Normalize(const string& directory) const;
+
+    private:
+        const string _root;
+        const std::regex& _listed;
+        mutable std::mutex _adminLock;
+        std::map<string, Entries> _directories;
+        std::map<int, string> _watches;
+        int _inotify;
+        int _wakeup;
+        std::atomic<bool> _stop;
+        std::thread _thread;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -16,7 +16,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 2
-#define API_VERSION_NUMBER_PATCH 5
+#define API_VERSION_NUMBER_PATCH 7
 const string WPEFramework::Plugin::UsbAccess::SERVICE_NAME = "org.rdk.UsbAccess";
 const string WPEFramework::Plugin::UsbAccess::METHOD_GET_FILE_LIST = "getFileList";
 const string WPEFramework::Plugin::UsbAccess::METHOD_CREATE_LINK = "createLink";
@@ -192,6 +192,12 @@ namespace Plugin {
             return bLinkExists;
         }
 
+        // REGEX_FILE compiled once for the listings instead of once per directory entry.
+        const std::regex& fileRegex() {
+            static const std::regex result(UsbAccess::REGEX_FILE, std::regex_constants::icase);
+            return result;
+        }
+
         bool isParamsEmpty(const JsonObject &parameters)
         {
             std::string strJson; 
@@ -232,12 +238,16 @@ namespace Plugin {
     const string UsbAccess::Initialize(PluginHost::IShell * /* service */)
     {
         InitializeIARM();
+        updateIndexes();
         return "";
     }
 
     void UsbAccess::Deinitialize(PluginHost::IShell * /* service */)
     {
         DeinitializeIARM();
+
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        m_indexes.clear();
     }
 
     string UsbAccess::Information() const
@@ -261,7 +271,23 @@ namespace Plugin {
             return Core::ERROR_BAD_REQUEST;
         }
 
-        FileList files;
+        MediaIndex::Query query;
+        query.includeFolders = true;
+        query.listedOnly = true;
+        query.media = MediaIndex::ANY;
+        query.offset = (parameters.HasLabel("offset") ? static_cast<uint32_t>(parameters["offset"].Number()) : 0);
+        query.limit = (parameters.HasLabel("limit") ? static_cast<uint32_t>(parameters["limit"].Number()) : 0);
+        if (parameters.HasLabel("type"))
+        {
+            query.media = MediaIndex::KindFromName(parameters["type"].String());
+            // A type filter selects files; folders only when that is the type asked for.
+            query.includeFolders = (query.media == MediaIndex::ANY || query.media == MediaIndex::FOLDER);
+        }
+        const bool paged = (parameters.HasLabel("offset") || parameters.HasLabel("limit"));
+        const bool details = (parameters.HasLabel("details") && parameters["details"].Boolean());
+
+        MediaIndex::Entries page;
+        uint32_t total = 0;
         string absPath;
         std::list<string> paths;
         getMounted(paths);
@@ -281,7 +307,7 @@ namespace Plugin {
             {
                 absPath = joinPaths(*paths.begin(), pathParam);
             }
-            result = getFileList(absPath, files, REGEX_FILE, true);
+            result = listDirectory(absPath, query, page, total);
         }
 
         if (!result)
@@ -290,14 +316,22 @@ namespace Plugin {
         {
             response["path"] = absPath;
             JsonArray arr;
-            for_each(files.begin(), files.end(), [&arr](const FileEnt& it)
+            for_each(page.begin(), page.end(), [&arr, details](const MediaIndex::Entry& it)
             {
                 JsonObject ent;
-                ent["name"] = it.filename;
-                ent["t"] = string(1, it.fileType);
+                ent["name"] = it.name;
+                ent["t"] = string(1, it.type);
+                if (details)
+                {
+                    ent["kind"] = MediaIndex::KindName(it.media);
+                    ent["size"] = it.size;
+                    ent["mtime"] = static_cast<uint64_t>(it.mtime);
+                }
                 arr.Add(ent);
             });
             response["contents"] = arr;
+            if (paged)
+                response["total"] = total;
         }
 
         returnResponse(result);
@@ -677,6 +711,8 @@ namespace Plugin {
 
     void UsbAccess::onUSBMountChanged(bool mounted, const string& device)
     {
+        updateIndexes();
+
         JsonObject params;
         params["mounted"] = mounted;
         params["device"] = device;
@@ -684,6 +720,59 @@ namespace Plugin {
     }
 
     // internal methods
+    bool UsbAccess::listDirectory(const string& path, const MediaIndex::Query& query, MediaIndex::Entries& page, uint32_t& total)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            for (auto const& it : m_indexes)
+            {
+                if (isAbsPath(it.first, path) && it.second->List(path, query, page, total))
+                    return true;
+            }
+        }
+
+        // Not indexed (yet), read the directory itself.
+        MediaIndex::Entries entries;
+        if (path.empty() || !MediaIndex::Read(path, fileRegex(), entries))
+            return false;
+
+        total = MediaIndex::Select(entries, query, page);
+        return true;
+    }
+
+    // Starts indexing newly mounted devices and drops the index of devices that are gone.
+    void UsbAccess::updateIndexes()
+    {
+        std::list<string> paths;
+        getMounted(paths);
+
+        std::list<std::unique_ptr<MediaIndex>> removed;
+        {
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            for (auto it = m_indexes.begin(); it != m_indexes.end();)
+            {
+                if (std::find(paths.begin(), paths.end(), it->first) == paths.end())
+                {
+                    LOGINFO("%s unmounted, dropping its index", it->first.c_str());
+                    removed.emplace_back(std::move(it->second));
+                    it = m_indexes.erase(it);
+                }
+                else
+                    ++it;
+            }
+            for (auto const& it : paths)
+            {
+                if (m_indexes.find(it) == m_indexes.end())
+                {
+                    LOGINFO("indexing %s", it.c_str());
+                    m_indexes.emplace(it, std::unique_ptr<MediaIndex>(new MediaIndex(it, fileRegex())));
+                }
+            }
+        }
+        // Joining the indexer threads outside of the lock keeps getFileList responsive.
+        removed.clear();
+    }
+
     bool UsbAccess::getFileList(const string& path, FileList& files, const string& fileRegex, bool includeFolders)
     {
         bool result = false;
@@ -695,12 +784,13 @@ namespace Plugin {
             {
                 files.clear();
 
+                const std::regex pattern(fileRegex, std::regex_constants::icase);
                 struct dirent *dp;
                 while ((dp = readdir(dirp)) != nullptr)
                 {
                     if (((dp->d_type == DT_DIR) && includeFolders) ||
                         ((dp->d_type != DT_DIR) && (fileRegex.empty() ||
-                            std::regex_match(dp->d_name, std::regex(fileRegex, std::regex_constants::icase)) == true)))
+                            std::regex_match(dp->d_name, pattern) == true)))
                         files.push_back(
                                 {
                                     dp->d_type == DT_DIR ? 'd' : 'f',
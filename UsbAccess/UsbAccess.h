@@ -2,9 +2,12 @@
 
 #include <set>
 #include "Module.h"
+#include "MediaIndex.h"
 
 #include "libIARM.h"
 
+#include <memory>
+#include <mutex>
 #include <thread>
 
 namespace WPEFramework {
@@ -92,11 +95,16 @@ namespace Plugin {
         static bool getFileList(const string& path, FileList& files, const string& fileRegex, bool includeFolders);
         static bool getMounted(std::list<string>& paths);
 
+        bool listDirectory(const string& path, const MediaIndex::Query& query, MediaIndex::Entries& page, uint32_t& total);
+        void updateIndexes();
+
         void archiveLogsInternal();
         void onArchiveLogs(ArchiveLogsError error, const string& filePath);
         std::thread archiveLogsThread;
         std::map<int, std::string> m_CreatedLinkIds;
         JsonObject m_oArchiveParams;
+        std::mutex m_indexMutex;
+        std::map<string, std::unique_ptr<MediaIndex>> m_indexes;
     };
 
 } // namespace Plugin
@@ -28,6 +28,9 @@
 #define RBUS_PRIVACY_MODE_EVENT_NAME "Device.X_RDKCENTRAL-COM_UserSettings.PrivacyModeChanged"
 #endif
 
+/* writes the store accepted whose ValueChanged has not arrived yet */
+#define MAX_UNCONFIRMED_WRITES 32
+
 namespace WPEFramework {
 namespace Plugin {
 
@@ -55,6 +58,12 @@ UserSettingsImplementation::UserSettingsImplementation()
 , _remotStoreObject(nullptr)
 , _storeNotification(*this)
 , _registeredEventHandlers(false)
+, _mirrorLock()
+, _settings(std::make_shared<const SettingsMap>())
+, _sequence(0)
+, _pendingWrites()
+, _unconfirmedWrites()
+, _flushScheduled(false)
 #ifdef HAS_RBUS
 , _rbusHandleStatus(RBUS_ERROR_NOT_INITIALIZED)
 #endif
@@ -92,6 +101,7 @@ UserSettingsImplementation::UserSettingsImplementation()
         }
 
         registerEventHandlers();
+        LoadSettings();
     }
 }
 
@@ -343,6 +353,11 @@ void UserSettingsImplementation::ValueChanged(const Exchange::IStore2::ScopeType
 {
     LOGINFO("ns:%s key:%s value:%s", ns.c_str(), key.c_str(), value.c_str());
 
+    if ((Exchange::IStore2::ScopeType::DEVICE == scope) && (ns.compare(USERSETTINGS_NAMESPACE) == 0))
+    {
+        StoreChanged(key, value);
+    }
+
     if((ns.compare(USERSETTINGS_NAMESPACE) == 0) && (key.compare(USERSETTINGS_AUDIO_DESCRIPTION_KEY) == 0))
     {
         dispatchEvent(AUDIO_DESCRIPTION_CHANGED, JsonValue((bool)(value.compare("true")==0)?true:false));
@@ -405,18 +420,254 @@ void UserSettingsImplementation::ValueChanged(const Exchange::IStore2::ScopeType
     }
 }
 
+void UserSettingsImplementation::LoadSettings()
+{
+    SettingsMap loaded;
+    std::map<string, string> keys(usersettingsDefaultMap);
+    keys.insert(std::make_pair(string(USERSETTINGS_PRIVACY_MODE_KEY), string("")));
+
+    ASSERT (nullptr != _remotStoreObject);
+    if (nullptr == _remotStoreObject)
+    {
+        return;
+    }
+
+    for (auto it = keys.begin(); it != keys.end(); ++it)
+    {
+        string value;
+        uint32_t ttl = 0;
+        uint32_t status = _remotStoreObject->GetValue(Exchange::IStore2::ScopeType::DEVICE, USERSETTINGS_NAMESPACE, it->first, value, ttl);
+
+        if (Core::ERROR_NONE == status)
+        {
+            loaded[it->first] = { value, 0 };
+        }
+        else if (Core::ERROR_UNKNOWN_KEY == status || Core::ERROR_NOT_EXIST == status)
+        {
+            loaded[it->first] = { it->second, 0 };
+        }
+        else
+        {
+            /* left out of the mirror, GetUserSettingsValue() falls back to the store */
+            LOGWARN("Key[%s] not loaded status[%d]", it->first.c_str(), status);
+        }
+    }
+
+    _mirrorLock.Lock();
+    /* values delivered through ValueChanged while loading are newer, keep them */
+    SettingsMap* settings = new SettingsMap(loaded);
+    for (auto it = _settings->begin(); it != _settings->end(); ++it)
+    {
+        (*settings)[it->first] = it->second;
+    }
+    std::atomic_store(&_settings, std::shared_ptr<const SettingsMap>(settings));
+    _mirrorLock.Unlock();
+
+    LOGINFO("Loaded %zu of %zu settings", loaded.size(), keys.size());
+}
+
+std::shared_ptr<const UserSettingsImplementation::SettingsMap> UserSettingsImplementation::Snapshot() const
+{
+    return std::atomic_load(&_settings);
+}
+
+uint32_t UserSettingsImplementation::Sequence() const
+{
+    _mirrorLock.Lock();
+    uint32_t sequence = _sequence;
+    _mirrorLock.Unlock();
+
+    return sequence;
+}
+
+void UserSettingsImplementation::UpdateMirror(const string& key, const string& value, const uint32_t since) const
+{
+    _mirrorLock.Lock();
+    /* a value read from the store before a later write or notification is stale */
+    auto current = _settings->find(key);
+    if (!IsWritePendingNoLock(key) && ((current == _settings->end()) || (current->second.sequence <= since)))
+    {
+        SettingsMap* settings = new SettingsMap(*_settings);
+        (*settings)[key] = { value, ++_sequence };
+        std::atomic_store(&_settings, std::shared_ptr<const SettingsMap>(settings));
+    }
+    _mirrorLock.Unlock();
+}
+
+void UserSettingsImplementation::StoreChanged(const string& key, const string& value)
+{
+    _mirrorLock.Lock();
+
+    /* A local write that is not yet in the store is newer than what the store reports */
+    if (!IsWritePendingNoLock(key))
+    {
+        /* the notification for one of our own writes, or a change made by another client */
+        uint32_t sequence = 0;
+        for (auto it = _unconfirmedWrites.begin(); it != _unconfirmedWrites.end(); ++it)
+        {
+            if ((it->key == key) && (it->value == value))
+            {
+                sequence = it->sequence;
+                _unconfirmedWrites.erase(it);
+                break;
+            }
+        }
+
+        auto current = _settings->find(key);
+        if (sequence == 0)
+        {
+            SettingsMap* settings = new SettingsMap(*_settings);
+            (*settings)[key] = { value, ++_sequence };
+            std::atomic_store(&_settings, std::shared_ptr<const SettingsMap>(settings));
+        }
+        else if ((current != _settings->end()) && (current->second.sequence > sequence))
+        {
+            LOGINFO("Key[%s] value[%s] is older than the local mirror, ignored", key.c_str(), value.c_str());
+        }
+    }
+
+    _mirrorLock.Unlock();
+}
+
+bool UserSettingsImplementation::IsWritePendingNoLock(const string& key) const
+{
+    bool pending = false;
+
+    for (auto it = _pendingWrites.begin(); it != _pendingWrites.end(); ++it)
+    {
+        if (it->key == key)
+        {
+            pending = true;
+            break;
+        }
+    }
+
+    return pending;
+}
+
+void UserSettingsImplementation::QueueWrite(const string& key, const string& value)
+{
+    bool schedule = false;
+
+    _mirrorLock.Lock();
+
+    std::shared_ptr<const SettingsMap> current = std::atomic_load(&_settings);
+    uint32_t sequence = ++_sequence;
+    auto it = _pendingWrites.begin();
+    for (; it != _pendingWrites.end(); ++it)
+    {
+        if (it->key == key)
+        {
+            /* coalesce with the queued write, keep its rollback value */
+            it->value = value;
+            it->sequence = sequence;
+            break;
+        }
+    }
+    if (it == _pendingWrites.end())
+    {
+        PendingWrite write;
+        auto previous = current->find(key);
+        write.key = key;
+        write.value = value;
+        write.sequence = sequence;
+        write.hadPrevious = (previous != current->end());
+        write.previous = write.hadPrevious ? previous->second : Setting { "", 0 };
+        _pendingWrites.push_back(write);
+    }
+
+    SettingsMap* settings = new SettingsMap(*current);
+    (*settings)[key] = { value, sequence };
+    std::atomic_store(&_settings, std::shared_ptr<const SettingsMap>(settings));
+
+    if (!_flushScheduled)
+    {
+        _flushScheduled = true;
+        schedule = true;
+    }
+
+    _mirrorLock.Unlock();
+
+    if (schedule)
+    {
+        Core::IWorkerPool::Instance().Submit(WriteJob::Create(this));
+    }
+}
+
+void UserSettingsImplementation::FlushPendingWrites()
+{
+    while (true)
+    {
+        _mirrorLock.Lock();
+        if (_pendingWrites.empty())
+        {
+            _flushScheduled = false;
+            _mirrorLock.Unlock();
+            break;
+        }
+        PendingWrite write = _pendingWrites.front();
+        _mirrorLock.Unlock();
+
+        uint32_t status = Core::ERROR_GENERAL;
+        if (nullptr != _remotStoreObject)
+        {
+            status = _remotStoreObject->SetValue(Exchange::IStore2::ScopeType::DEVICE, USERSETTINGS_NAMESPACE, write.key, write.value, 0);
+        }
+
+        _mirrorLock.Lock();
+        if (Core::ERROR_NONE == status)
+        {
+            /* its ValueChanged may still arrive after a newer write, see StoreChanged() */
+            _unconfirmedWrites.push_back(write);
+            if (_unconfirmedWrites.size() > MAX_UNCONFIRMED_WRITES)
+            {
+                _unconfirmedWrites.pop_front();
+            }
+        }
+        PendingWrite& front = _pendingWrites.front();
+        if (front.sequence != write.sequence)
+        {
+            /* overwritten while in flight, write the newer value on the next pass */
+            if (Core::ERROR_NONE == status)
+            {
+                front.previous = { write.value, write.sequence };
+                front.hadPrevious = true;
+            }
+        }
+        else
+        {
+            if (Core::ERROR_NONE != status)
+            {
+                LOGERR("Key[%s] value[%s] not persisted status[%d], reverting", write.key.c_str(), write.value.c_str(), status);
+                SettingsMap* settings = new SettingsMap(*_settings);
+                if (front.hadPrevious)
+                {
+                    (*settings)[write.key] = { front.previous.value, ++_sequence };
+                }
+                else
+                {
+                    settings->erase(write.key);
+                }
+                std::atomic_store(&_settings, std::shared_ptr<const SettingsMap>(settings));
+            }
+            _pendingWrites.pop_front();
+        }
+        _mirrorLock.Unlock();
+    }
+}
+
 uint32_t UserSettingsImplementation::SetUserSettingsValue(const string& key, const string& value)
 {
     uint32_t status = Core::ERROR_GENERAL;
-    _adminLock.Lock();
 
     ASSERT (nullptr != _remotStoreObject);
     if (nullptr != _remotStoreObject)
     {
-        status = _remotStoreObject->SetValue(Exchange::IStore2::ScopeType::DEVICE, USERSETTINGS_NAMESPACE, key, value, 0);
+        /* visible to readers right away, persisted from the worker pool */
+        QueueWrite(key, value);
+        status = Core::ERROR_NONE;
     }
 
-    _adminLock.Unlock();
     return status;
 }
 
@@ -424,6 +675,17 @@ uint32_t UserSettingsImplementation::GetUserSettingsValue(const string& key, str
 {
     uint32_t status = Core::ERROR_GENERAL;
     uint32_t ttl = 0;
+
+    std::shared_ptr<const SettingsMap> settings = Snapshot();
+    auto cached = settings->find(key);
+    if (cached != settings->end())
+    {
+        value = cached->second.value;
+        return Core::ERROR_NONE;
+    }
+
+    const uint32_t since = Sequence();
+
     _adminLock.Lock();
 
     ASSERT (nullptr != _remotStoreObject);
@@ -447,6 +709,11 @@ uint32_t UserSettingsImplementation::GetUserSettingsValue(const string& key, str
     }
     _adminLock.Unlock();
 
+    if (Core::ERROR_NONE == status)
+    {
+        UpdateMirror(key, value, since);
+    }
+
     return status;
 }
 
@@ -594,15 +861,12 @@ uint32_t UserSettingsImplementation::SetPrivacyMode(const string& privacyMode)
         return status;
     }
 
-    _adminLock.Lock();
-
     ASSERT (nullptr != _remotStoreObject);
 
     if (nullptr != _remotStoreObject)
     {
-        uint32_t ttl = 0;
         string oldPrivacyMode;
-        status = _remotStoreObject->GetValue(Exchange::IStore2::ScopeType::DEVICE, USERSETTINGS_NAMESPACE, USERSETTINGS_PRIVACY_MODE_KEY, oldPrivacyMode, ttl);
+        status = GetUserSettingsValue(USERSETTINGS_PRIVACY_MODE_KEY, oldPrivacyMode);
         LOGINFO("oldPrivacyMode: %s", oldPrivacyMode.c_str());
 
         if (privacyMode != oldPrivacyMode)
@@ -610,6 +874,8 @@ uint32_t UserSettingsImplementation::SetPrivacyMode(const string& privacyMode)
 #ifdef HAS_RBUS
             if (Core::ERROR_NONE == status)
             {
+                _adminLock.Lock();
+
                 if (RBUS_ERROR_SUCCESS != _rbusHandleStatus)
                 {
                     _rbusHandleStatus = rbus_open(&_rbusHandle, RBUS_COMPONENT_NAME);
@@ -637,35 +903,25 @@ uint32_t UserSettingsImplementation::SetPrivacyMode(const string& privacyMode)
                     str << "rbus_open failed with error code " << _rbusHandleStatus;
                     LOGERR("%s", str.str().c_str());
                 }
+
+                _adminLock.Unlock();
             }
 #endif
-            status = _remotStoreObject->SetValue(Exchange::IStore2::ScopeType::DEVICE, USERSETTINGS_NAMESPACE, USERSETTINGS_PRIVACY_MODE_KEY, privacyMode, 0);
+            status = SetUserSettingsValue(USERSETTINGS_PRIVACY_MODE_KEY, privacyMode);
         }
     }
 
-    _adminLock.Unlock();
-
     return status;
 }
 
 uint32_t UserSettingsImplementation::GetPrivacyMode(string &privacyMode) const
 {
     uint32_t status = Core::ERROR_NONE;
-    std::string value = "";
-    uint32_t ttl = 0;
     privacyMode = "";
 
-    _adminLock.Lock();
+    /* an unset or unreadable value is reported as the default below */
+    GetUserSettingsValue(USERSETTINGS_PRIVACY_MODE_KEY, privacyMode);
 
-    ASSERT (nullptr != _remotStoreObject);
-
-    if (nullptr != _remotStoreObject)
-    {
-        _remotStoreObject->GetValue(Exchange::IStore2::ScopeType::DEVICE, USERSETTINGS_NAMESPACE, USERSETTINGS_PRIVACY_MODE_KEY, privacyMode, ttl);
-    }
-
-    _adminLock.Unlock();
-    
     if (privacyMode != "SHARE" && privacyMode != "DO_NOT_SHARE") 
     {
         LOGWARN("Wrong privacyMode value: '%s', returning default", privacyMode.c_str());
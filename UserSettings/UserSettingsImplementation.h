@@ -25,6 +25,9 @@
 #include <interfaces/IStore2.h>
 #include "tracing/Logging.h"
 #include <vector>
+#include <list>
+#include <map>
+#include <memory>
 
 #include <com/com.h>
 #include <core/core.h>
@@ -193,9 +196,72 @@ namespace Plugin {
         void ValueChanged(const Exchange::IStore2::ScopeType scope, const string& ns, const string& key, const string& value);
 
     private:
-        uint32_t SetUserSettingsValue(const string& key, const string& value);
+        // Every local write and every value taken from the store gets the next
+        // sequence number, so an update older than the mirror entry is ignored.
+        struct Setting {
+            string value;
+            uint32_t sequence;
+        };
+        typedef std::map<string, Setting> SettingsMap;
+
+        struct PendingWrite {
+            string key;
+            string value;
+            uint32_t sequence;
+            Setting previous;
+            bool hadPrevious;
+        };
+
+        class EXTERNAL WriteJob : public Core::IDispatch {
+        protected:
+            WriteJob(UserSettingsImplementation *usersettingImplementation)
+                : _userSettingImplementation(usersettingImplementation) {
+                if (_userSettingImplementation != nullptr) {
+                    _userSettingImplementation->AddRef();
+                }
+            }
+
+        public:
+            WriteJob() = delete;
+            WriteJob(const WriteJob&) = delete;
+            WriteJob& operator=(const WriteJob&) = delete;
+            ~WriteJob() {
+                if (_userSettingImplementation != nullptr) {
+                    _userSettingImplementation->Release();
+                }
+            }
+
+        public:
+            static Core::ProxyType<Core::IDispatch> Create(UserSettingsImplementation *usersettingImplementation) {
+#ifndef USE_THUNDER_R4
+                return (Core::proxy_cast<Core::IDispatch>(Core::ProxyType<WriteJob>::Create(usersettingImplementation)));
+#else
+                return (Core::ProxyType<Core::IDispatch>(Core::ProxyType<WriteJob>::Create(usersettingImplementation)));
+#endif
+            }
+
+            virtual void Dispatch() {
+                _userSettingImplementation->FlushPendingWrites();
+            }
+        private:
+            UserSettingsImplementation *_userSettingImplementation;
+        };
+
+    private:
+        uint32_t SetUserSettingsValue(const string& key, const string& value);
         uint32_t GetUserSettingsValue(const string& key, string &value) const;
 
+        // Local mirror of USERSETTINGS_NAMESPACE. Readers take a snapshot without
+        // locking; writers replace the whole map under _mirrorLock.
+        void LoadSettings();
+        std::shared_ptr<const SettingsMap> Snapshot() const;
+        uint32_t Sequence() const;
+        void UpdateMirror(const string& key, const string& value, const uint32_t since) const;
+        void StoreChanged(const string& key, const string& value);
+        void QueueWrite(const string& key, const string& value);
+        void FlushPendingWrites();
+        bool IsWritePendingNoLock(const string& key) const;
+
     private:
         mutable Core::CriticalSection _adminLock;
         Core::ProxyType<RPC::InvokeServerType<1, 0, 4>> _engine;
@@ -205,6 +271,12 @@ namespace Plugin {
         std::list<Exchange::IUserSettings::INotification*> _userSettingNotification;
         Core::Sink<Store2Notification> _storeNotification;
         bool _registeredEventHandlers;
+        mutable Core::CriticalSection _mirrorLock;
+        mutable std::shared_ptr<const SettingsMap> _settings;
+        mutable uint32_t _sequence;
+        std::list<PendingWrite> _pendingWrites;
+        std::list<PendingWrite> _unconfirmedWrites;
+        bool _flushScheduled;
 
 #ifdef HAS_RBUS
         rbusError_t _rbusHandleStatus;
@@ -214,6 +286,7 @@ namespace Plugin {
         void Dispatch(Event event, const JsonValue params);
 
         friend class Job;
+        friend class WriteJob;
     };
 } // namespace Plugin
 } // namespace WPEFramework
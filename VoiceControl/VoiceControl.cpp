@@ -244,7 +244,7 @@ namespace WPEFramework {
             if (bSuccess)
             {
                 // Make the IARM call to controlMgr to configure the voice settings
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_STATUS, (void *)call, totalsize);
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_STATUS, (void *)call, totalsize);
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CTRLM_VOICE_IARM_CALL_STATUS Bus Call FAILED, res: %d.", (int)res);
@@ -305,7 +305,7 @@ namespace WPEFramework {
             if (bSuccess)
             {
                 // Make the IARM call to controlMgr to configure the voice settings
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_CONFIGURE_VOICE, (void *)call, totalsize);
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_CONFIGURE_VOICE, (void *)call, totalsize);
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CTRLM_VOICE_IARM_CALL_CONFIGURE_VOICE Bus Call FAILED, res: %d.", (int)res);
@@ -366,7 +366,7 @@ namespace WPEFramework {
             if (bSuccess)
             {
                 // Make the IARM call to controlMgr to configure the voice settings
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SET_VOICE_INIT, (void *)call, totalsize);
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SET_VOICE_INIT, (void *)call, totalsize);
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CTRLM_VOICE_IARM_CALL_SET_VOICE_INIT Bus Call FAILED, res: %d.", (int)res);
@@ -428,7 +428,7 @@ namespace WPEFramework {
             if (bSuccess)
             {
                 // Make the IARM call to controlMgr to configure the voice settings
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SEND_VOICE_MESSAGE, (void *)call, totalsize);
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SEND_VOICE_MESSAGE, (void *)call, totalsize);
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CTRLM_VOICE_IARM_CALL_SEND_VOICE_MESSAGE Bus Call FAILED, res: %d.", (int)res);
@@ -516,7 +516,7 @@ namespace WPEFramework {
             if (bSuccess)
             {
                 // Make the IARM call to controlMgr to configure the voice settings
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SESSION_TYPES, (void *)call, totalsize);
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SESSION_TYPES, (void *)call, totalsize);
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CTRLM_VOICE_IARM_CALL_SESSION_TYPES Bus Call FAILED, res: %d.", (int)res);
@@ -577,7 +577,7 @@ namespace WPEFramework {
             if (bSuccess)
             {
                 // Make the IARM call to controlMgr to configure the voice settings
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SESSION_REQUEST, (void *)call, totalsize);
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SESSION_REQUEST, (void *)call, totalsize);
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CTRLM_VOICE_IARM_CALL_SESSION_REQUEST Bus Call FAILED, res: %d.", (int)res);
@@ -638,7 +638,7 @@ namespace WPEFramework {
             if (bSuccess)
             {
                 // Make the IARM call to controlMgr to configure the voice settings
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SESSION_TERMINATE, (void *)call, totalsize);
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SESSION_TERMINATE, (void *)call, totalsize);
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CTRLM_VOICE_IARM_CALL_SESSION_TERMINATE Bus Call FAILED, res: %d.", (int)res);
@@ -699,7 +699,7 @@ namespace WPEFramework {
             if (bSuccess)
             {
                 // Make the IARM call to controlMgr to start the audio stream
-                res = IARM_Bus_Call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SESSION_AUDIO_STREAM_START, (void *)call, totalsize);
+                res = Utils::IARM::call(CTRLM_MAIN_IARM_BUS_NAME, CTRLM_VOICE_IARM_CALL_SESSION_AUDIO_STREAM_START, (void *)call, totalsize);
                 if (res != IARM_RESULT_SUCCESS)
                 {
                     LOGERR("ERROR - CTRLM_VOICE_IARM_CALL_SESSION_AUDIO_STREAM_START Bus Call FAILED, res: %d.", (int)res);
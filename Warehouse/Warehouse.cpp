@@ -226,7 +226,7 @@ namespace WPEFramework
                     ret = Warehouse::_instance->processColdFactoryReset();
                 }
                 else {
-                    err = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_ColdFactoryReset, nullptr, 0);
+                    err = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_ColdFactoryReset, nullptr, 0);
                 }
             }
             else if (resetType.compare("FACTORY") == 0)
@@ -237,7 +237,7 @@ namespace WPEFramework
                     ret = Warehouse::_instance->processFactoryReset();
                 }
                 else {
-                    err = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_FactoryReset, nullptr, 0);
+                    err = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_FactoryReset, nullptr, 0);
                 }
             }
             else if (resetType.compare("USERFACTORY") == 0)
@@ -248,7 +248,7 @@ namespace WPEFramework
                     ret = Warehouse::_instance->processUserFactoryReset();
                 }
                 else {
-                    err = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_UserFactoryReset, nullptr, 0);
+                    err = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_UserFactoryReset, nullptr, 0);
                 }
             }
             else if (resetType.compare("WAREHOUSE_CLEAR") == 0)
@@ -266,7 +266,7 @@ namespace WPEFramework
                 else {
                     IARM_Bus_PWRMgr_WareHouseReset_Param_t whParam;
                     whParam.suppressReboot = suppressReboot;
-                    err = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_WareHouseClear, &whParam, sizeof(whParam));
+                    err = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_WareHouseClear, &whParam, sizeof(whParam));
                     isWareHouse = true;
                 }
             }
@@ -285,7 +285,7 @@ namespace WPEFramework
                 else {
                     IARM_Bus_PWRMgr_WareHouseReset_Param_t whParam;
                     whParam.suppressReboot = suppressReboot;
-                    err = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_WareHouseReset, &whParam, sizeof(whParam));
+                    err = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_WareHouseReset, &whParam, sizeof(whParam));
                     isWareHouse = true;
                 }
             }
@@ -332,7 +332,7 @@ namespace WPEFramework
             }
 
             strcpy(runScriptParam.script_path, script.c_str());
-            IARM_Bus_Call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_RunScript, &runScriptParam, sizeof(runScriptParam));
+            Utils::IARM::call(IARM_BUS_SYSMGR_NAME, IARM_BUS_SYSMGR_API_RunScript, &runScriptParam, sizeof(runScriptParam));
             bool ok = runScriptParam.return_value == 0;
 
             std::stringstream message;
@@ -20,8 +20,11 @@
 #include "CookieJar.h"
 
 #include <sstream>
-#include <iterator>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include <strings.h>
 
 #include <glib.h>
 #include <zlib.h>
@@ -37,11 +40,14 @@ namespace Plugin {
 
 namespace {
 
-static std::string serialize(const std::vector<std::string>& cookies)
+// Header lines only present when delta sync is enabled. Payloads without a
+// header are plain snapshots, as produced by older versions.
+static const char kSnapshotHeader[] = "#!cookiejar-snapshot ";
+static const char kDeltaHeader[] = "#!cookiejar-delta ";
+
+static bool startsWith(const std::string& str, const char* prefix)
 {
-    std::ostringstream os;
-    std::copy(cookies.begin(), cookies.end(), std::ostream_iterator<std::string>(os, "\n"));
-    return os.str();
+    return str.compare(0, strlen(prefix), prefix) == 0;
 }
 
 static void deserialize(const std::string& cookies, std::vector<std::string>& result)
@@ -56,6 +62,36 @@ static void deserialize(const std::string& cookies, std::vector<std::string>& re
     }
 }
 
+// "name=value; Path=/; Domain=.example.com; ..." -> "name;.example.com;/"
+static std::string cookieKey(const std::string& cookie)
+{
+    std::string name, domain, path;
+    bool first = true;
+    size_t pos = 0;
+    while (pos < cookie.size())
+    {
+        size_t end = cookie.find(';', pos);
+        if (end == std::string::npos)
+            end = cookie.size();
+        size_t begin = cookie.find_first_not_of(' ', pos);
+        if (begin < end)
+        {
+            size_t eq = cookie.find('=', begin);
+            if (eq > end)
+                eq = end;
+            if (first)
+                name = cookie.substr(begin, eq - begin);
+            else if (eq < end && (eq - begin) == 6 && strncasecmp(cookie.c_str() + begin, "domain", 6) == 0)
+                domain = cookie.substr(eq + 1, end - eq - 1);
+            else if (eq < end && (eq - begin) == 4 && strncasecmp(cookie.c_str() + begin, "path", 4) == 0)
+                path = cookie.substr(eq + 1, end - eq - 1);
+        }
+        first = false;
+        pos = end + 1;
+    }
+    return name + ';' + domain + ';' + path;
+}
+
 static std::string toBase64(const std::vector<uint8_t>& in)
 {
     gchar* encoded = g_base64_encode(in.data(), in.size());
@@ -188,13 +224,11 @@ struct CookieJar::CookieJarPrivate
 {
     CookieJarCrypto _cookieJarCrypto;
 
-    uint32_t Pack(const std::vector<std::string> &cookies, uint32_t& version, uint32_t& checksum, string& payload)
+    uint32_t Pack(const std::string& serialized, uint32_t& version, uint32_t& checksum, string& payload)
     {
         uint32_t rc;
-        std::string serialized;
         std::vector<uint8_t> encrypted;
 
-        serialized = serialize(cookies);
         checksum = crc_checksum(serialized);
 
         rc = _cookieJarCrypto.Encrypt(compress(serialized), version, encrypted);
@@ -211,7 +245,7 @@ struct CookieJar::CookieJarPrivate
         return rc;
     }
 
-    uint32_t Unpack(const uint32_t version, const uint32_t checksum, const string& payload, std::vector<std::string>& cookies)
+    uint32_t Unpack(const uint32_t version, const uint32_t checksum, const string& payload, std::string& serialized)
     {
         uint32_t rc = Core::ERROR_GENERAL;
         std::vector<uint8_t> decrypted;
@@ -224,8 +258,7 @@ struct CookieJar::CookieJarPrivate
         }
         else
         {
-            std::string serialized;
-            int actualChecksum;
+            uint32_t actualChecksum;
 
             serialized = uncompress(decrypted);
             actualChecksum = crc_checksum(serialized);
@@ -234,10 +267,6 @@ struct CookieJar::CookieJarPrivate
                 rc = Core::ERROR_GENERAL;
                 SYSLOG(Logging::Error,(_T("Checksum does not match: actual=%d expected=%d"), actualChecksum, checksum));
             }
-            else
-            {
-                deserialize(serialized, cookies);
-            }
         }
 
         return rc;
@@ -251,35 +280,255 @@ CookieJar::CookieJar()
 
 CookieJar::~CookieJar() = default;
 
-uint32_t CookieJar::Pack(uint32_t& version, uint32_t& checksum, string& payload) const
+void CookieJar::Configure(bool delta, uint16_t compactionInterval)
 {
-    return _priv->Pack(_cookies, version, checksum, payload);
+    _delta = delta;
+    _compactionInterval = std::max<uint16_t>(compactionInterval, 1);
+    _packed = PackState();
+    _removed.clear();
+}
+
+std::string CookieJar::Serialize(bool& snapshot) const
+{
+    std::ostringstream os;
+
+    snapshot = true;
+    if (_delta && _packed.baseline && _packed.deltas < _compactionInterval)
+    {
+        const uint64_t base = _packed.base;
+        size_t changed = 0;
+        for (const auto& entry : _cookies)
+            changed += (entry.second.sequence > base);
+        for (const auto& removed : _removed)
+            changed += (removed.second > base);
+
+        // A delta touching most of the jar is not worth the extra step on restore
+        if ((changed * 2) <= _cookies.size())
+        {
+            snapshot = false;
+            os << kDeltaHeader << base << ' ' << _sequence << '\n';
+            for (const auto& entry : _cookies)
+            {
+                if (entry.second.sequence > base)
+                    os << '+' << entry.second.cookie << '\n';
+            }
+            for (const auto& removed : _removed)
+            {
+                if (removed.second > base)
+                    os << '-' << removed.first << '\n';
+            }
+        }
+    }
+
+    if (snapshot)
+    {
+        if (_delta)
+            os << kSnapshotHeader << _sequence << '\n';
+        for (const auto& entry : _cookies)
+            os << entry.second.cookie << '\n';
+    }
+
+    return os.str();
+}
+
+uint32_t CookieJar::Apply(const std::string& serialized)
+{
+    std::vector<std::string> lines;
+    deserialize(serialized, lines);
+
+    if (!lines.empty() && startsWith(lines.front(), kDeltaHeader))
+    {
+        char* end = nullptr;
+        const uint64_t base = strtoull(lines.front().c_str() + strlen(kDeltaHeader), &end, 10);
+        const uint64_t sequence = strtoull(end, nullptr, 10);
+
+        if (sequence == _sequence)
+            return Core::ERROR_NONE;
+
+        // Holds every change since 'base', so it applies on any state from there on
+        if (base > _sequence || sequence < _sequence)
+        {
+            SYSLOG(Logging::Error,(_T("Cookie jar delta %llu..%llu does not apply on %llu"),
+                static_cast<unsigned long long>(base), static_cast<unsigned long long>(sequence),
+                static_cast<unsigned long long>(_sequence)));
+            return Core::ERROR_ILLEGAL_STATE;
+        }
+
+        for (auto line = lines.begin() + 1; line != lines.end(); ++line)
+        {
+            if ((*line)[0] == '+')
+            {
+                std::string cookie = line->substr(1);
+                std::string key = cookieKey(cookie);
+                _removed.erase(key);
+                _cookies[key] = Entry { std::move(cookie), sequence };
+            }
+            else if ((*line)[0] == '-')
+            {
+                std::string key = line->substr(1);
+                _cookies.erase(key);
+                _removed[key] = sequence;
+            }
+        }
+        _sequence = sequence;
+        _packed.deltas++;
+    }
+    else
+    {
+        uint64_t sequence = _sequence + 1;
+        auto line = lines.begin();
+        if (line != lines.end() && startsWith(*line, kSnapshotHeader))
+        {
+            sequence = strtoull(line->c_str() + strlen(kSnapshotHeader), nullptr, 10);
+            ++line;
+        }
+
+        _cookies.clear();
+        for (; line != lines.end(); ++line)
+        {
+            std::string key = cookieKey(*line);
+            _cookies[key] = Entry { std::move(*line), sequence };
+        }
+        _removed.clear();
+        _sequence = sequence;
+        _packed.deltas = 0;
+    }
+
+    return Core::ERROR_NONE;
+}
+
+uint32_t CookieJar::Pack(uint32_t& version, uint32_t& checksum, string& payload)
+{
+    if (_packed.cached && _packed.sequence == _sequence)
+    {
+        version = _packed.version;
+        checksum = _packed.checksum;
+        payload = _packed.payload;
+        return Core::ERROR_NONE;
+    }
+
+    bool snapshot;
+    uint32_t rc = _priv->Pack(Serialize(snapshot), version, checksum, payload);
+
+    if (rc == Core::ERROR_NONE)
+    {
+        // The base only moves once the consumer acknowledged this payload
+        _packed.sequence = _sequence;
+        if (snapshot)
+        {
+            _packed.deltas = 0;
+        }
+        else
+        {
+            _packed.deltas++;
+        }
+        _packed.cached = true;
+        _packed.version = version;
+        _packed.checksum = checksum;
+        _packed.payload = payload;
+    }
+
+    return rc;
 }
 
 uint32_t CookieJar::Unpack(const uint32_t version, const uint32_t checksum, const string& payload)
 {
     uint32_t rc;
-    std::vector<std::string> cookies;
+    std::string serialized;
 
-    rc = _priv->Unpack(version, checksum, payload, cookies);
+    rc = _priv->Unpack(version, checksum, payload, serialized);
+
+    if (rc == WPEFramework::Core::ERROR_NONE)
+        rc = Apply(serialized);
 
     if (rc == WPEFramework::Core::ERROR_NONE) {
-        _cookies = std::move(cookies);
+        _packed.baseline = true;
+        _packed.base = _sequence;
+        _packed.sequence = _sequence;
+        _packed.cached = false;
         _refreshed.SetState( false );
     }
 
     return rc;
 }
 
+void CookieJar::Acknowledge(const uint64_t sequence)
+{
+    if (sequence != 0 && sequence == _packed.sequence)
+    {
+        if (!_packed.baseline || _packed.base != sequence)
+        {
+            _packed.baseline = true;
+            _packed.base = sequence;
+            _packed.cached = false;
+        }
+    }
+    else if (_packed.baseline && sequence != _packed.base)
+    {
+        SYSLOG(Logging::Notification,(_T("Cookie jar consumer holds %llu, sending a snapshot next"),
+            static_cast<unsigned long long>(sequence)));
+        _packed.baseline = false;
+        _packed.cached = false;
+    }
+}
+
 void CookieJar::SetCookies(std::vector<std::string> && cookies)
 {
-    _cookies = std::move(cookies);
+    const uint64_t sequence = _sequence + 1;
+    bool changed = false;
+
+    std::map<std::string, Entry> updated;
+    for (auto& cookie : cookies)
+    {
+        std::string key = cookieKey(cookie);
+        auto index = _cookies.find(key);
+        if (index != _cookies.end() && index->second.cookie == cookie)
+        {
+            updated.emplace(std::move(key), std::move(index->second));
+            _cookies.erase(index);
+        }
+        else
+        {
+            if (index != _cookies.end())
+                _cookies.erase(index);
+            _removed.erase(key);
+            updated.emplace(std::move(key), Entry { std::move(cookie), sequence });
+            changed = true;
+        }
+    }
+
+    // Whatever is left has expired or was deleted
+    for (auto& entry : _cookies)
+    {
+        if (_delta)
+            _removed[entry.first] = sequence;
+        changed = true;
+    }
+
+    _cookies = std::move(updated);
+    if (changed)
+        _sequence = sequence;
+
+    // Removals the consumer has, or gets with the payload it may still acknowledge, are not needed anymore
+    const uint64_t covered = _packed.baseline ? _packed.base : _packed.sequence;
+    for (auto index = _removed.begin(); index != _removed.end(); )
+    {
+        if (index->second <= covered)
+            index = _removed.erase(index);
+        else
+            ++index;
+    }
+
     _refreshed.SetState( true );
 }
 
 std::vector<std::string> CookieJar::GetCookies() const
 {
-    return _cookies;
+    std::vector<std::string> cookies;
+    cookies.reserve(_cookies.size());
+    for (const auto& entry : _cookies)
+        cookies.push_back(entry.second.cookie);
+    return cookies;
 }
 
 } // namespace Plugin
@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <map>
 
 namespace WPEFramework {
 namespace Plugin {
@@ -38,17 +39,59 @@ public:
     void MarkAsStale() { _refreshed.SetState( false ); }
     bool WaitForRefresh(int timeout_ms) const { return _refreshed.WaitState(true, timeout_ms); }
 
+    // When delta is enabled Pack() only emits the cookies added, changed or
+    // removed since the last state the consumer acknowledged, and falls back to
+    // a full snapshot every compactionInterval payloads (or when most of the jar
+    // changed). Deltas are cumulative, so the newest one applies on top of the
+    // acknowledged state or of any payload packed after it.
+    void Configure(bool delta, uint16_t compactionInterval);
+
     // Get/Set cookies
     void SetCookies(std::vector<std::string> &&);
     std::vector<std::string> GetCookies() const;
 
     // Pack/unack cookies for storing in the "cloud"
-    uint32_t Pack(uint32_t& version, uint32_t& checksum, string& payload) const;
+    uint32_t Pack(uint32_t& version, uint32_t& checksum, string& payload);
     uint32_t Unpack(const uint32_t version, const uint32_t checksum, const string& payload);
 
+    // Consumer reports the Sequence() it holds after Unpack(). Only the last
+    // packed sequence moves the delta base, anything else (0 for a consumer
+    // that has nothing or failed to apply) makes the next Pack() a snapshot.
+    void Acknowledge(const uint64_t sequence);
+
+    uint64_t Sequence() const { return _sequence; }
+
 private:
+    struct Entry
+    {
+        std::string cookie;
+        uint64_t sequence;
+    };
+
+    // State of what was handed out last, so unchanged jars are not packed again
+    struct PackState
+    {
+        bool baseline { false };      // consumer acknowledged the jar up to 'base'
+        uint64_t base { 0 };
+        uint64_t sequence { 0 };      // sequence of the last payload handed out
+        uint16_t deltas { 0 };        // deltas packed since the last snapshot
+        bool cached { false };
+        uint32_t version { 0 };
+        uint32_t checksum { 0 };
+        string payload;
+    };
+
+    std::string Serialize(bool& snapshot) const;
+    uint32_t Apply(const std::string& serialized);
+
     Core::StateTrigger<bool> _refreshed { false };
-    std::vector<std::string> _cookies;
+    std::map<std::string, Entry> _cookies;   // keyed by name, domain and path, ordered so output is stable
+    std::map<std::string, uint64_t> _removed; // removals not yet covered by a snapshot
+    uint64_t _sequence { 0 };
+
+    bool _delta { false };
+    uint16_t _compactionInterval { 16 };
+    PackState _packed;
 
     struct CookieJarPrivate;
     mutable std::unique_ptr<CookieJarPrivate> _priv;
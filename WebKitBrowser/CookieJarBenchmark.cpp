@@ -0,0 +1,113 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2024 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Pack/unpack timings for synthetic cookie jars, full snapshot vs. delta sync.
+// Usage: CookieJarBenchmark [changed cookies per sync, default 10]
+
+#include "CookieJar.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace WPEFramework;
+
+namespace {
+
+static const size_t kJarSizes[] = { 1000, 2500, 5000, 10000 };
+static const int kIterations = 20;
+
+static std::vector<std::string> syntheticJar(size_t size, uint32_t generation, size_t changed)
+{
+    std::vector<std::string> cookies;
+    cookies.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        char cookie[256];
+        snprintf(cookie, sizeof(cookie),
+            "session_%zu=%08x%08zx; Path=/; Domain=.service%zu.example.com; Expires=Thu, 01 Jan 2032 00:00:00 GMT; Secure; HttpOnly",
+            i, (i < changed) ? generation : 0u, i * 2654435761u, i % 97);
+        cookies.push_back(cookie);
+    }
+    return cookies;
+}
+
+template <typename FUNCTION>
+static double measure(FUNCTION&& function)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i)
+        function(i);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / kIterations;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t changed = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 10;
+
+    printf("%8s %14s %14s %14s %14s %12s %12s\n",
+        "cookies", "full pack ms", "full unpack ms", "delta pack ms", "delta unpack", "full bytes", "delta bytes");
+
+    for (size_t size : kJarSizes) {
+        uint32_t version, checksum;
+        string payload;
+        size_t fullBytes = 0, deltaBytes = 0;
+
+        // Full snapshot on every sync, the behaviour without delta support
+        Plugin::CookieJar full;
+        double fullPack = measure([&](int i) {
+            full.SetCookies(syntheticJar(size, i + 1, changed));
+            full.Pack(version, checksum, payload);
+            fullBytes = payload.size();
+        });
+        double fullUnpack = measure([&](int) {
+            Plugin::CookieJar restored;
+            restored.Unpack(version, checksum, payload);
+        });
+
+        // Delta sync with compaction disabled for the measured window
+        Plugin::CookieJar delta;
+        Plugin::CookieJar peer;
+        delta.Configure(true, kIterations + 1);
+        peer.Configure(true, kIterations + 1);
+        delta.SetCookies(syntheticJar(size, 0, 0));
+        delta.Pack(version, checksum, payload);
+        peer.Unpack(version, checksum, payload);
+        delta.Acknowledge(peer.Sequence());
+
+        std::vector<uint32_t> versions(kIterations), checksums(kIterations);
+        std::vector<string> payloads(kIterations);
+        double deltaPack = measure([&](int i) {
+            delta.SetCookies(syntheticJar(size, i + 1, changed));
+            delta.Pack(versions[i], checksums[i], payloads[i]);
+            deltaBytes = payloads[i].size();
+        });
+        double deltaUnpack = measure([&](int i) {
+            if (peer.Unpack(versions[i], checksums[i], payloads[i]) != Core::ERROR_NONE)
+                fprintf(stderr, "delta %d did not apply\n", i);
+        });
+
+        printf("%8zu %14.3f %14.3f %14.3f %14.3f %12zu %12zu\n",
+            size, fullPack, fullUnpack, deltaPack, deltaUnpack, fullBytes, deltaBytes);
+    }
+
+    return 0;
+}
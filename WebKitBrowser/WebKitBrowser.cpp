@@ -21,7 +21,7 @@
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 1
-#define API_VERSION_NUMBER_PATCH 26
+#define API_VERSION_NUMBER_PATCH 27
 
 namespace WPEFramework {
 
@@ -575,6 +575,8 @@ static GSourceFuncs _handlerIntervention =
                 , PageGroup(_T("WPEPageGroup"))
                 , CookieStorage()
                 , CloudCookieJarEnabled(false)
+                , CloudCookieJarDelta(false)
+                , CloudCookieJarCompaction(16)
                 , LocalStorage()
                 , LocalStorageEnabled(false)
                 , LocalStorageSize()
@@ -642,6 +644,8 @@ static GSourceFuncs _handlerIntervention =
                 Add(_T("pagegroup"), &PageGroup);
                 Add(_T("cookiestorage"), &CookieStorage);
                 Add(_T("cloudcookiejarenabled"), &CloudCookieJarEnabled);
+                Add(_T("cloudcookiejardelta"), &CloudCookieJarDelta);
+                Add(_T("cloudcookiejarcompaction"), &CloudCookieJarCompaction);
                 Add(_T("localstorage"), &LocalStorage);
                 Add(_T("localstorageenabled"), &LocalStorageEnabled);
                 Add(_T("localstoragesize"), &LocalStorageSize);
@@ -716,6 +720,8 @@ static GSourceFuncs _handlerIntervention =
             Core::JSON::String PageGroup;
             Core::JSON::String CookieStorage;
             Core::JSON::Boolean CloudCookieJarEnabled;
+            Core::JSON::Boolean CloudCookieJarDelta;
+            Core::JSON::DecUInt16 CloudCookieJarCompaction;
             Core::JSON::String LocalStorage;
             Core::JSON::Boolean LocalStorageEnabled;
             Core::JSON::DecUInt16 LocalStorageSize;
@@ -1399,7 +1405,7 @@ static GSourceFuncs _handlerIntervention =
 
                 _adminLock.Lock();
             }
-            result = _cookieJar.Pack(version, checksum, payload);
+            result = const_cast<WebKitImplementation*>(this)->_cookieJar.Pack(version, checksum, payload);
             _adminLock.Unlock();
 
             return result;
@@ -2241,6 +2247,10 @@ static GSourceFuncs _handlerIntervention =
                 return (Core::ERROR_INCOMPLETE_CONFIG);
             }
 
+            #if defined(ENABLE_CLOUD_COOKIE_JAR)
+            _cookieJar.Configure(_config.CloudCookieJarDelta.Value(), _config.CloudCookieJarCompaction.Value());
+            #endif
+
             #if defined(ENABLE_LOGGING_UTILS)
             if (!_config.LoggingTarget.Value().empty()) {
                 if (!RedirectAllLogsToService(_config.LoggingTarget.Value())) {
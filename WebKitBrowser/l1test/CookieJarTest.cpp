@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include "../CookieJar.h"
+
+using ::testing::Test;
+using ::WPEFramework::Plugin::CookieJar;
+
+namespace {
+
+std::vector<std::string> Jar(size_t size, uint32_t generation, size_t changed)
+{
+    std::vector<std::string> cookies;
+    for (size_t i = 0; i < size; ++i) {
+        cookies.push_back("session_" + std::to_string(i) + "=" + std::to_string((i < changed) ? generation : 0)
+            + "; Path=/; Domain=.service" + std::to_string(i) + ".example.com; Secure; HttpOnly");
+    }
+    return cookies;
+}
+
+struct Payload {
+    uint32_t version;
+    uint32_t checksum;
+    string payload;
+};
+
+} // namespace
+
+class ACookieJar : public Test {
+protected:
+    CookieJar jar;
+    CookieJar peer;
+
+    Payload Pack()
+    {
+        Payload result;
+        EXPECT_EQ(WPEFramework::Core::ERROR_NONE, jar.Pack(result.version, result.checksum, result.payload));
+        return result;
+    }
+    uint32_t Unpack(CookieJar& consumer, const Payload& payload)
+    {
+        return consumer.Unpack(payload.version, payload.checksum, payload.payload);
+    }
+    // One sync: pack, apply on the peer and report back what it holds
+    void Sync()
+    {
+        EXPECT_EQ(WPEFramework::Core::ERROR_NONE, Unpack(peer, Pack()));
+        jar.Acknowledge(peer.Sequence());
+    }
+};
+
+TEST_F(ACookieJar, RestoresASnapshotInAnEmptyJar)
+{
+    jar.SetCookies(Jar(10, 1, 10));
+    auto payload = Pack();
+
+    EXPECT_EQ(WPEFramework::Core::ERROR_NONE, Unpack(peer, payload));
+    EXPECT_EQ(jar.GetCookies(), peer.GetCookies());
+    EXPECT_EQ(10u, peer.GetCookies().size());
+
+    // Nothing changed, the same payload again
+    auto again = Pack();
+    EXPECT_EQ(payload.checksum, again.checksum);
+    EXPECT_EQ(payload.payload, again.payload);
+}
+
+TEST_F(ACookieJar, SendsOnlyTheChangesSinceTheAcknowledgedState)
+{
+    jar.Configure(true, 16);
+    peer.Configure(true, 16);
+    jar.SetCookies(Jar(100, 1, 0));
+    auto snapshot = Pack();
+    ASSERT_EQ(WPEFramework::Core::ERROR_NONE, Unpack(peer, snapshot));
+    jar.Acknowledge(peer.Sequence());
+
+    auto cookies = Jar(100, 2, 3);
+    cookies.pop_back();
+    jar.SetCookies(std::move(cookies));
+    auto delta = Pack();
+
+    EXPECT_LT(delta.payload.size(), snapshot.payload.size());
+    EXPECT_EQ(WPEFramework::Core::ERROR_NONE, Unpack(peer, delta));
+    EXPECT_EQ(jar.GetCookies(), peer.GetCookies());
+    EXPECT_EQ(99u, peer.GetCookies().size());
+    EXPECT_EQ(jar.Sequence(), peer.Sequence());
+
+    // Applying it twice changes nothing
+    EXPECT_EQ(WPEFramework::Core::ERROR_NONE, Unpack(peer, delta));
+    EXPECT_EQ(jar.GetCookies(), peer.GetCookies());
+}
+
+TEST_F(ACookieJar, KeepsTheBaseUntilADeltaIsAcknowledged)
+{
+    jar.Configure(true, 16);
+    peer.Configure(true, 16);
+    jar.SetCookies(Jar(100, 1, 0));
+    Sync();
+
+    jar.SetCookies(Jar(100, 2, 3));
+    auto lost = Pack();
+    auto cookies = Jar(100, 3, 3);
+    cookies.pop_back();
+    jar.SetCookies(std::move(cookies));
+    auto latest = Pack();
+
+    // The first delta never arrived, the second one still holds its changes
+    EXPECT_EQ(WPEFramework::Core::ERROR_NONE, Unpack(peer, latest));
+    EXPECT_EQ(jar.GetCookies(), peer.GetCookies());
+
+    // An older delta arriving late is rejected and leaves the jar alone
+    EXPECT_EQ(WPEFramework::Core::ERROR_ILLEGAL_STATE, Unpack(peer, lost));
+    EXPECT_EQ(jar.GetCookies(), peer.GetCookies());
+    EXPECT_EQ(jar.Sequence(), peer.Sequence());
+}
+
+TEST_F(ACookieJar, AppliesADeltaOnAnyStateSinceItsBase)
+{
+    jar.Configure(true, 16);
+    peer.Configure(true, 16);
+    jar.SetCookies(Jar(100, 1, 0));
+    Sync();
+
+    jar.SetCookies(Jar(100, 2, 3));
+    auto first = Pack();
+    jar.SetCookies(Jar(100, 3, 6));
+    auto second = Pack();
+
+    EXPECT_EQ(WPEFramework::Core::ERROR_NONE, Unpack(peer, first));
+    EXPECT_EQ(WPEFramework::Core::ERROR_NONE, Unpack(peer, second));
+    EXPECT_EQ(jar.GetCookies(), peer.GetCookies());
+}
+
+TEST_F(ACookieJar, SendsASnapshotToAConsumerThatCannotApplyTheDelta)
+{
+    jar.Configure(true, 16);
+    peer.Configure(true, 16);
+    jar.SetCookies(Jar(100, 1, 0));
+    Sync();
+    jar.SetCookies(Jar(100, 2, 3));
+    auto delta = Pack();
+
+    CookieJar fresh;
+    fresh.Configure(true, 16);
+    EXPECT_EQ(WPEFramework::Core::ERROR_ILLEGAL_STATE, Unpack(fresh, delta));
+    EXPECT_EQ(0u, fresh.Sequence());
+    EXPECT_TRUE(fresh.GetCookies().empty());
+
+    jar.Acknowledge(fresh.Sequence());
+    EXPECT_EQ(WPEFramework::Core::ERROR_NONE, Unpack(fresh, Pack()));
+    EXPECT_EQ(jar.GetCookies(), fresh.GetCookies());
+    jar.Acknowledge(fresh.Sequence());
+
+    jar.SetCookies(Jar(100, 3, 3));
+    EXPECT_EQ(WPEFramework::Core::ERROR_NONE, Unpack(fresh, Pack()));
+    EXPECT_EQ(jar.GetCookies(), fresh.GetCookies());
+}
+
+TEST_F(ACookieJar, CompactsIntoASnapshot)
+{
+    jar.Configure(true, 2);
+    peer.Configure(true, 2);
+    jar.SetCookies(Jar(100, 1, 0));
+    Sync();
+    jar.SetCookies(Jar(100, 2, 3));
+    Sync();
+    jar.SetCookies(Jar(100, 3, 3));
+    Sync();
+
+    // The third payload after the base is a snapshot again, a fresh jar takes it
+    jar.SetCookies(Jar(100, 4, 3));
+    CookieJar fresh;
+    fresh.Configure(true, 2);
+    EXPECT_EQ(WPEFramework::Core::ERROR_NONE, Unpack(fresh, Pack()));
+    EXPECT_EQ(jar.GetCookies(), fresh.GetCookies());
+}
@@ -171,7 +171,7 @@ uint32_t WifiManagerScan::getAvailableSSIDsAsync(const JsonObject& parameters, J
 
     // Issue the query via IARM bus, the response will be sent as an event
     IARM_Result_t res;
-    IARM_CHECK( IARM_Bus_Call(
+    IARM_CHECK( Utils::IARM::call(
                     IARM_BUS_NM_SRV_MGR_NAME,
                     IARM_BUS_WIFI_MGR_API_getAvailableSSIDsAsync,
                     reinterpret_cast<void *>(&param),
@@ -208,7 +208,7 @@ uint32_t WifiManagerScan::getAvailableSSIDsAsyncIncr(const JsonObject &parameter
 
     // Issue the query via IARM bus, the response will be sent as an event
     IARM_Result_t res;
-    IARM_CHECK( IARM_Bus_Call(
+    IARM_CHECK( Utils::IARM::call(
                     IARM_BUS_NM_SRV_MGR_NAME,
                     IARM_BUS_WIFI_MGR_API_getAvailableSSIDsAsyncIncr,
                     reinterpret_cast<void *>(&param),
@@ -241,7 +241,7 @@ uint32_t WifiManagerScan::stopScan(const JsonObject& parameters, JsonObject& res
     memset(&param, 0, sizeof(param));
 
     IARM_Result_t res;
-    IARM_CHECK( IARM_Bus_Call(
+    IARM_CHECK( Utils::IARM::call(
                     IARM_BUS_NM_SRV_MGR_NAME,
                     IARM_BUS_WIFI_MGR_API_stopProgressiveWifiScanning,
                     reinterpret_cast<void*>(&param),
@@ -23,6 +23,7 @@
 #include "netsrvmgrIarm.h"
 #include "libIBus.h"
 #include "UtilsJsonRpc.h"
+#include "UtilsIarm.h"
 
 using namespace WPEFramework::Plugin;
 using namespace std;
@@ -72,7 +73,7 @@ uint32_t WifiManagerState::getCurrentState(const JsonObject &parameters, JsonObj
 
     if (!m_useWifiStateCache)
     {
-        if(IARM_RESULT_SUCCESS == IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_getCurrentState, (void *)&param, sizeof(param)))
+        if(IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_getCurrentState, (void *)&param, sizeof(param)))
         {
             setWifiStateCache(true,(to_wifi_state(param.data.wifiStatus)));
         }
@@ -88,7 +89,7 @@ uint32_t WifiManagerState::getConnectedSSID(const JsonObject &parameters, JsonOb
 
     memset(&param, 0, sizeof(param));
 
-    retVal = IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_getConnectedSSID, (void *)&param, sizeof(param));
+    retVal = Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_getConnectedSSID, (void *)&param, sizeof(param));
 
     if(retVal == IARM_RESULT_SUCCESS)
     {
@@ -120,7 +121,7 @@ uint32_t WifiManagerState::setEnabled(const JsonObject &parameters, JsonObject &
     param.persist = persist_t;
 
     // disables wifi interface when ethernet interface is active
-    IARM_Result_t retVal = IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_setInterfaceEnabled, (void *)&param, sizeof(param));
+    IARM_Result_t retVal = Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_NETSRVMGR_API_setInterfaceEnabled, (void *)&param, sizeof(param));
 
     // Update wifi state cache if wifi interface was disabled
     if (retVal == IARM_RESULT_SUCCESS && !param.isInterfaceEnabled) {
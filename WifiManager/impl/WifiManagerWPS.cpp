@@ -21,6 +21,7 @@
 #include "UtilsJsonRpc.h"
 #include "libIBus.h"
 #include "wifiSrvMgrIarmIf.h"
+#include "UtilsIarm.h"
 
 namespace WPEFramework
 {
@@ -48,7 +49,7 @@ namespace WPEFramework
             IARM_Bus_WiFiSrvMgr_Param_t param;
             memset(&param, 0, sizeof(param));
 
-            IARM_Result_t retVal = IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_initiateWPSPairing, (void *)&param, sizeof(param));
+            IARM_Result_t retVal = Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_initiateWPSPairing, (void *)&param, sizeof(param));
             LOGINFO("[%s] : retVal:%d status:%d", IARM_BUS_WIFI_MGR_API_initiateWPSPairing, retVal, param.status);
 
             response["result"] = string();
@@ -101,7 +102,7 @@ namespace WPEFramework
                 returnResponse(false);
             }
 
-            IARM_Result_t retVal = IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME,
+            IARM_Result_t retVal = Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME,
                     IARM_BUS_WIFI_MGR_API_initiateWPSPairing2,
                     (void *)&wps_parameters, sizeof(wps_parameters));
             LOGINFO("[%s] : retVal:%d status:%d",
@@ -122,7 +123,7 @@ namespace WPEFramework
             IARM_Bus_WiFiSrvMgr_Param_t param;
             memset(&param, 0, sizeof(param));
 
-            IARM_Result_t retVal = IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_cancelWPSPairing, (void *)&param, sizeof(param));
+            IARM_Result_t retVal = Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_cancelWPSPairing, (void *)&param, sizeof(param));
             LOGINFO("[%s] : retVal:%d status:%d", IARM_BUS_WIFI_MGR_API_cancelWPSPairing, retVal, param.status);
 
             response["result"] = string();
@@ -145,7 +146,7 @@ namespace WPEFramework
             strncpy(param.data.connect.passphrase, parameters["passphrase"].String().c_str(), PASSPHRASE_BUFF - 1);
             param.data.connect.security_mode = static_cast<SsidSecurity>(parameters["securityMode"].Number());
 
-            IARM_Result_t retVal = IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_saveSSID, (void *)&param, sizeof(param));
+            IARM_Result_t retVal = Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_saveSSID, (void *)&param, sizeof(param));
             saved = (retVal == IARM_RESULT_SUCCESS) && param.status;
             LOGINFO("[%s] : retVal:%d status:%d", IARM_BUS_WIFI_MGR_API_saveSSID, retVal, param.status);
 
@@ -161,7 +162,7 @@ namespace WPEFramework
             IARM_Bus_WiFiSrvMgr_Param_t param;
             memset(&param, 0, sizeof(param));
 
-            IARM_Result_t retVal = IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_clearSSID, (void *)&param, sizeof(param));
+            IARM_Result_t retVal = Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_clearSSID, (void *)&param, sizeof(param));
             cleared = (retVal == IARM_RESULT_SUCCESS) && param.status;
             LOGINFO("[%s] : retVal:%d status:%d", IARM_BUS_WIFI_MGR_API_clearSSID, retVal, param.status);
 
@@ -181,7 +182,7 @@ namespace WPEFramework
                 response["ssid"] = m_cachePairedSSID;
                 result = true;
             }
-            else if (IARM_RESULT_SUCCESS == IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_getPairedSSIDInfo, (void *)&param, sizeof(param)))
+            else if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_getPairedSSIDInfo, (void *)&param, sizeof(param)))
             {
                 response["ssid"] = m_cachePairedSSID = string(param.data.getPairedSSIDInfo.ssid, SSID_SIZE);
                 m_cachePairedBSSID = string(param.data.getPairedSSIDInfo.bssid, BSSID_BUFF);
@@ -210,7 +211,7 @@ namespace WPEFramework
                 response["bssid"] = m_cachePairedBSSID;
                 result = true;
             }
-            else if (IARM_RESULT_SUCCESS == IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_getPairedSSIDInfo, (void *)&param, sizeof(param)))
+            else if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_getPairedSSIDInfo, (void *)&param, sizeof(param)))
             {
                 response["ssid"] = m_cachePairedSSID = string(param.data.getPairedSSIDInfo.ssid, SSID_SIZE);
                 response["bssid"] = m_cachePairedBSSID = string(param.data.getPairedSSIDInfo.bssid, BSSID_BUFF);
@@ -237,7 +238,7 @@ namespace WPEFramework
             {
                 ssid_len = strlen(m_cachePairedSSID.c_str());
             }
-            else if (IARM_RESULT_SUCCESS == IARM_Bus_Call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_getPairedSSIDInfo, (void *)&param, sizeof(param)))
+            else if (IARM_RESULT_SUCCESS == Utils::IARM::call(IARM_BUS_NM_SRV_MGR_NAME, IARM_BUS_WIFI_MGR_API_getPairedSSIDInfo, (void *)&param, sizeof(param)))
             {
                 m_cachePairedSSID = string(param.data.getPairedSSIDInfo.ssid, SSID_SIZE);
                 m_cachePairedBSSID = string(param.data.getPairedSSIDInfo.bssid, BSSID_BUFF);
@@ -70,7 +70,7 @@ using namespace std;
 
 #define API_VERSION_NUMBER_MAJOR 1
 #define API_VERSION_NUMBER_MINOR 0
-#define API_VERSION_NUMBER_PATCH 21
+#define API_VERSION_NUMBER_PATCH 22
 
 namespace WPEFramework {
 
@@ -129,6 +129,7 @@ XCast::XCast() : PluginHost::JSONRPC()
         Utils::Synchro::RegisterLockedApi(METHOD_REG_APPLICATIONS, &XCast::registerApplications, this);
         Utils::Synchro::RegisterLockedApi(METHOD_UNREG_APPLICATIONS, &XCast::unregisterApplications, this);
         Utils::Synchro::RegisterLockedApi(METHOD_GET_PROTOCOLVERSION, &XCast::getProtocolVersion, this);
+        Utils::Synchro::RegisterLockStatisticsApi(this);
         
         m_locateCastTimer.connect( bind( &XCast::onLocateCastTimer, this ));
     }
@@ -151,7 +152,7 @@ void XCast::InitializeIARM()
          IARM_Result_t res;
          IARM_CHECK( Utils::Synchro::RegisterLockedIarmEventHandler<XCast>(IARM_BUS_PWRMGR_NAME,IARM_BUS_PWRMGR_EVENT_MODECHANGED, powerModeChange) );
          IARM_Bus_PWRMgr_GetPowerState_Param_t param;
-         res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState,
+         res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState,
                 (void *)&param, sizeof(param));
          if (res == IARM_RESULT_SUCCESS)
          {
@@ -175,6 +176,7 @@ void XCast::DeinitializeIARM()
      Unregister(METHOD_SET_STANDBY_BEHAVIOR);
      Unregister(METHOD_GET_FRIENDLYNAME);
      Unregister(METHOD_SET_FRIENDLYNAME);
+     Utils::Synchro::UnregisterLockStatisticsApi(this);
 
 }
 void XCast::powerModeChange(const char *owner, IARM_EventId_t eventId, void *data, size_t len)
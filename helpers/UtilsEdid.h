@@ -0,0 +1,377 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Utils {
+namespace Edid {
+
+    // Colorimetry Data Block flags
+    enum Colorimetry : uint16_t {
+        COLORIMETRY_XVYCC601 = 1 << 0,
+        COLORIMETRY_XVYCC709 = 1 << 1,
+        COLORIMETRY_SYCC601 = 1 << 2,
+        COLORIMETRY_OPYCC601 = 1 << 3,
+        COLORIMETRY_OPRGB = 1 << 4,
+        COLORIMETRY_BT2020CYCC = 1 << 5,
+        COLORIMETRY_BT2020YCC = 1 << 6,
+        COLORIMETRY_BT2020RGB = 1 << 7,
+        COLORIMETRY_DCI_P3 = 1 << 8
+    };
+
+    // HDR Static Metadata Data Block EOTF flags
+    enum Eotf : uint8_t {
+        EOTF_SDR = 1 << 0,
+        EOTF_HDR = 1 << 1,
+        EOTF_SMPTE_ST_2084 = 1 << 2,
+        EOTF_HLG = 1 << 3
+    };
+
+    struct AudioFormat {
+        uint8_t format; // audio format code, 1 = LPCM, 2 = AC-3, 10 = E-AC-3, ...
+        uint8_t channels;
+        uint8_t sampleRates; // bit 0 = 32 kHz ... bit 6 = 192 kHz
+        uint8_t extra; // LPCM bit depths or the format specific byte
+    };
+
+    struct Capabilities {
+        bool valid = false;
+
+        // Base block
+        std::string manufacturer;
+        uint16_t productCode = 0;
+        uint32_t serialNumber = 0;
+        uint8_t version = 0;
+        uint8_t revision = 0;
+        uint8_t widthCm = 0;
+        uint8_t heightCm = 0;
+        uint16_t preferredWidth = 0;
+        uint16_t preferredHeight = 0;
+        uint32_t preferredRefresh = 0; // Hz, from the first detailed timing
+        bool preferredInterlaced = false;
+        std::string monitorName;
+
+        // CTA-861 extensions
+        uint8_t ctaRevision = 0;
+        bool basicAudio = false;
+        bool ycbcr444 = false;
+        bool ycbcr422 = false;
+        std::vector<uint8_t> vics;
+        std::vector<AudioFormat> audioFormats;
+        uint8_t speakerAllocation = 0;
+        uint16_t colorimetry = 0; // Colorimetry flags
+        uint8_t eotfs = 0; // Eotf flags
+        uint8_t staticMetadataTypes = 0;
+        uint8_t maxLuminance = 0; // code values as in the data block
+        uint8_t maxFrameAverageLuminance = 0;
+        uint8_t minLuminance = 0;
+        bool dolbyVision = false;
+        bool hdr10Plus = false;
+
+        // HDMI Vendor Specific Data Block
+        bool hdmi = false;
+        uint16_t physicalAddress = 0xFFFF;
+        uint16_t maxTmdsClockMHz = 0;
+
+        // HDMI Forum Vendor Specific Data Block / Sink Capability Data Structure
+        bool hdmiForum = false;
+        uint16_t maxTmdsCharacterRateMHz = 0;
+        uint8_t maxFrlRate = 0;
+        bool allm = false;
+        bool fva = false;
+        bool qms = false;
+        uint16_t vrrMin = 0;
+        uint16_t vrrMax = 0;
+    };
+
+    namespace Internal {
+        inline bool Checksum(const uint8_t* block)
+        {
+            uint8_t sum = 0;
+            for (int i = 0; i < 128; i++) {
+                sum += block[i];
+            }
+            return (sum == 0);
+        }
+
+        inline void DetailedTiming(const uint8_t* dtd, Capabilities& caps)
+        {
+            const uint32_t pixelClock = (dtd[0] | (dtd[1] << 8)) * 10000u;
+            const uint32_t hActive = dtd[2] | ((dtd[4] & 0xF0) << 4);
+            const uint32_t hBlank = dtd[3] | ((dtd[4] & 0x0F) << 8);
+            const uint32_t vActive = dtd[5] | ((dtd[7] & 0xF0) << 4);
+            const uint32_t vBlank = dtd[6] | ((dtd[7] & 0x0F) << 8);
+            const uint32_t total = (hActive + hBlank) * (vActive + vBlank);
+
+            caps.preferredWidth = hActive;
+            caps.preferredHeight = vActive;
+            caps.preferredInterlaced = ((dtd[17] & 0x80) != 0);
+            caps.preferredRefresh = (total != 0) ? ((pixelClock + total / 2) / total) : 0;
+        }
+
+        inline void Descriptor(const uint8_t* desc, Capabilities& caps)
+        {
+            if ((desc[0] | desc[1]) != 0) {
+                if (caps.preferredWidth == 0) {
+                    DetailedTiming(desc, caps);
+                }
+            } else if (desc[3] == 0xFC) {
+                std::string name;
+                for (int i = 5; i < 18 && desc[i] != 0x0A; i++) {
+                    name += static_cast<char>(desc[i]);
+                }
+                while (!name.empty() && name.back() == ' ') {
+                    name.pop_back();
+                }
+                caps.monitorName = name;
+            }
+        }
+
+        // Payload of the HF-VSDB after the OUI, or of the HF-SCDB after its two reserved bytes
+        inline void HdmiForum(const uint8_t* p, uint8_t length, Capabilities& caps)
+        {
+            caps.hdmiForum = true;
+            if (length > 1) {
+                caps.maxTmdsCharacterRateMHz = p[1] * 5;
+            }
+            if (length > 3) {
+                caps.maxFrlRate = p[3] >> 4;
+            }
+            if (length > 4) {
+                caps.allm = ((p[4] & 0x02) != 0);
+                caps.fva = ((p[4] & 0x04) != 0);
+                caps.qms = ((p[4] & 0x40) != 0);
+            }
+            if (length > 6) {
+                caps.vrrMin = p[5] & 0x3F;
+                caps.vrrMax = ((p[5] & 0xC0) << 2) | p[6];
+            }
+        }
+
+        inline uint32_t Oui(const uint8_t* p)
+        {
+            return p[0] | (p[1] << 8) | (p[2] << 16);
+        }
+
+        inline void DataBlock(uint8_t tag, const uint8_t* p, uint8_t length, Capabilities& caps)
+        {
+            switch (tag) {
+            case 1: // Audio
+                for (uint8_t i = 0; i + 2 < length; i += 3) {
+                    AudioFormat sad;
+                    sad.format = (p[i] >> 3) & 0x0F;
+                    sad.channels = (p[i] & 0x07) + 1;
+                    sad.sampleRates = p[i + 1] & 0x7F;
+                    sad.extra = p[i + 2];
+                    caps.audioFormats.push_back(sad);
+                }
+                break;
+            case 2: // Video
+                for (uint8_t i = 0; i < length; i++) {
+                    // VICs 1-64 carry the native flag in bit 7
+                    caps.vics.push_back(((p[i] >= 129) && (p[i] <= 192)) ? (p[i] & 0x7F) : p[i]);
+                }
+                break;
+            case 3: // Vendor specific
+                if (length >= 3) {
+                    const uint32_t oui = Oui(p);
+                    if (oui == 0x000C03) {
+                        caps.hdmi = true;
+                        if (length >= 5) {
+                            caps.physicalAddress = (p[3] << 8) | p[4];
+                        }
+                        if (length >= 7) {
+                            caps.maxTmdsClockMHz = p[6] * 5;
+                        }
+                    } else if (oui == 0xC45DD8) {
+                        HdmiForum(p + 3, length - 3, caps);
+                    }
+                }
+                break;
+            case 4: // Speaker allocation
+                if (length >= 1) {
+                    caps.speakerAllocation = p[0];
+                }
+                break;
+            case 7: // Extended tag
+                if (length >= 1) {
+                    switch (p[0]) {
+                    case 0x01: // Vendor specific video
+                        if (length >= 4) {
+                            const uint32_t oui = Oui(p + 1);
+                            caps.dolbyVision |= (oui == 0x00D046);
+                            caps.hdr10Plus |= (oui == 0x90848B);
+                        }
+                        break;
+                    case 0x05: // Colorimetry
+                        if (length >= 3) {
+                            caps.colorimetry = p[1] | ((p[2] & 0x80) << 1);
+                        }
+                        break;
+                    case 0x06: // HDR static metadata
+                        if (length >= 3) {
+                            caps.eotfs = p[1] & 0x3F;
+                            caps.staticMetadataTypes = p[2];
+                        }
+                        if (length >= 4) {
+                            caps.maxLuminance = p[3];
+                        }
+                        if (length >= 5) {
+                            caps.maxFrameAverageLuminance = p[4];
+                        }
+                        if (length >= 6) {
+                            caps.minLuminance = p[5];
+                        }
+                        break;
+                    case 0x79: // HDMI Forum sink capability
+                        if (length >= 3) {
+                            HdmiForum(p + 3, length - 3, caps);
+                        }
+                        break;
+                    default:
+                        break;
+                    }
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        inline void Cta(const uint8_t* block, Capabilities& caps)
+        {
+            const uint8_t dtdOffset = block[2];
+
+            caps.ctaRevision = block[1];
+            if (block[1] >= 2) {
+                caps.basicAudio = ((block[3] & 0x40) != 0);
+                caps.ycbcr444 = ((block[3] & 0x20) != 0);
+                caps.ycbcr422 = ((block[3] & 0x10) != 0);
+            }
+            if ((dtdOffset < 4) || (dtdOffset > 127)) {
+                return;
+            }
+            for (uint8_t i = 4; i < dtdOffset;) {
+                const uint8_t tag = block[i] >> 5;
+                const uint8_t length = block[i] & 0x1F;
+                if (i + 1 + length > dtdOffset) {
+                    break;
+                }
+                DataBlock(tag, block + i + 1, length, caps);
+                i += 1 + length;
+            }
+        }
+    }
+
+    // Parses the base block and the CTA-861 extension blocks. Extension blocks with a bad checksum are skipped.
+    inline bool Parse(const uint8_t* data, size_t length, Capabilities& caps)
+    {
+        static const uint8_t header[8] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+
+        caps = Capabilities();
+        if ((data == nullptr) || (length < 128) || (memcmp(data, header, sizeof(header)) != 0) || !Internal::Checksum(data)) {
+            return false;
+        }
+
+        const uint16_t id = (data[8] << 8) | data[9];
+        caps.manufacturer += static_cast<char>('A' - 1 + ((id >> 10) & 0x1F));
+        caps.manufacturer += static_cast<char>('A' - 1 + ((id >> 5) & 0x1F));
+        caps.manufacturer += static_cast<char>('A' - 1 + (id & 0x1F));
+        caps.productCode = data[10] | (data[11] << 8);
+        caps.serialNumber = data[12] | (data[13] << 8) | (data[14] << 16) | (static_cast<uint32_t>(data[15]) << 24);
+        caps.version = data[18];
+        caps.revision = data[19];
+        caps.widthCm = data[21];
+        caps.heightCm = data[22];
+        for (int i = 54; i < 126; i += 18) {
+            Internal::Descriptor(data + i, caps);
+        }
+
+        const size_t blocks = std::min(static_cast<size_t>(data[126]), (length / 128) - 1);
+        for (size_t i = 1; i <= blocks; i++) {
+            const uint8_t* block = data + (i * 128);
+            if ((block[0] == 0x02) && Internal::Checksum(block)) {
+                Internal::Cta(block, caps);
+            }
+        }
+
+        caps.valid = true;
+        return true;
+    }
+
+    // EDID bytes and parsed capabilities per port, fetched once and kept until the port is invalidated,
+    // typically on hotplug. Failed fetches are not kept.
+    class Cache {
+    public:
+        using Fetch = std::function<bool(std::vector<uint8_t>& bytes)>;
+
+        Cache() = default;
+        Cache(const Cache&) = delete;
+        Cache& operator=(const Cache&) = delete;
+
+        bool Bytes(int port, const Fetch& fetch, std::vector<uint8_t>& bytes)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            const Entry* entry = Load(port, fetch);
+            if (entry == nullptr) {
+                return false;
+            }
+            bytes = entry->bytes;
+            return true;
+        }
+
+        // False when the EDID could not be fetched or does not parse
+        bool Parsed(int port, const Fetch& fetch, Capabilities& caps)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            const Entry* entry = Load(port, fetch);
+            if ((entry == nullptr) || !entry->caps.valid) {
+                return false;
+            }
+            caps = entry->caps;
+            return true;
+        }
+
+        void Invalidate(int port)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _entries.erase(port);
+        }
+
+        void Invalidate()
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _entries.clear();
+        }
+
+    private:
+        struct Entry {
+            std::vector<uint8_t> bytes;
+            Capabilities caps;
+        };
+
+        const Entry* Load(int port, const Fetch& fetch)
+        {
+            auto it = _entries.find(port);
+            if (it == _entries.end()) {
+                Entry entry;
+                if (!fetch(entry.bytes)) {
+                    return nullptr;
+                }
+                Parse(entry.bytes.data(), entry.bytes.size(), entry.caps);
+                it = _entries.emplace(port, std::move(entry)).first;
+            }
+            return &it->second;
+        }
+
+        std::mutex _lock;
+        std::map<int, Entry> _entries;
+    };
+}
+}
@@ -4,6 +4,11 @@
 
 #include "libIBus.h"
 #include <unistd.h>
+#include <time.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #define IARM_CHECK(FUNC) { \
     if ((res = FUNC) != IARM_RESULT_SUCCESS) { \
@@ -20,7 +25,156 @@
 }
 
 namespace Utils {
+// Latency of the IARM calls of this library, per owner and method. Buckets are powers of two in
+// microseconds, a percentile is the upper bound of its bucket, so it is off by at most a factor 2.
+class IarmCallStatistics {
+public:
+    static constexpr int BUCKETS = 32;
+
+    struct Entry {
+        Entry()
+            : calls(0), failures(0), timeouts(0), inFlight(0), maxInFlight(0), totalUs(0), maxUs(0), histogram()
+        {
+        }
+
+        uint64_t percentile(uint32_t percent) const
+        {
+            uint64_t result = maxUs;
+            uint64_t rank = ((calls * percent) + 99) / 100;
+            uint64_t seen = 0;
+            for (int bucket = 0; bucket < BUCKETS; bucket++) {
+                seen += histogram[bucket];
+                if ((rank != 0) && (seen >= rank)) {
+                    uint64_t upper = (bucket == 0 ? 0 : ((1ULL << bucket) - 1));
+                    result = (upper < maxUs ? upper : maxUs);
+                    break;
+                }
+            }
+            return result;
+        }
+
+        uint64_t calls; // completed
+        uint64_t failures; // result other than IARM_RESULT_SUCCESS, timeouts included
+        uint64_t timeouts; // failed after at least the IPC timeout
+        uint32_t inFlight;
+        uint32_t maxInFlight;
+        uint64_t totalUs;
+        uint64_t maxUs;
+        uint64_t histogram[BUCKETS];
+    };
+
+    typedef std::map<std::pair<std::string, std::string>, Entry> Entries;
+
+    static IarmCallStatistics& instance()
+    {
+        static IarmCallStatistics statistics;
+        return statistics;
+    }
+
+    static uint64_t now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (static_cast<uint64_t>(ts.tv_sec) * 1000000ULL) + (ts.tv_nsec / 1000);
+    }
+
+    void begin(const char* owner, const char* method)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry& entry = m_entries[key(owner, method)];
+        if (++entry.inFlight > entry.maxInFlight) {
+            entry.maxInFlight = entry.inFlight;
+        }
+    }
+
+    // timeoutMs of 0 means the bus default, no timeouts are counted then.
+    void end(const char* owner, const char* method, uint64_t elapsedUs, IARM_Result_t result, int timeoutMs)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry& entry = m_entries[key(owner, method)];
+        if (entry.inFlight > 0) {
+            entry.inFlight--;
+        }
+        entry.calls++;
+        entry.totalUs += elapsedUs;
+        if (elapsedUs > entry.maxUs) {
+            entry.maxUs = elapsedUs;
+        }
+        entry.histogram[bucketOf(elapsedUs)]++;
+        if (result != IARM_RESULT_SUCCESS) {
+            entry.failures++;
+            if ((timeoutMs > 0) && (elapsedUs >= (static_cast<uint64_t>(timeoutMs) * 1000))) {
+                entry.timeouts++;
+            }
+        }
+    }
+
+    Entries entries() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries;
+    }
+
+    // Drops the completed calls, the calls still on their way keep being counted.
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Entries::iterator it = m_entries.begin(); it != m_entries.end();) {
+            if (it->second.inFlight == 0) {
+                it = m_entries.erase(it);
+            } else {
+                uint32_t inFlight = it->second.inFlight;
+                it->second = Entry();
+                it->second.inFlight = inFlight;
+                it->second.maxInFlight = inFlight;
+                ++it;
+            }
+        }
+    }
+
+    static int bucketOf(uint64_t us)
+    {
+        int bucket = (us == 0 ? 0 : (64 - __builtin_clzll(us)));
+        return (bucket < BUCKETS ? bucket : (BUCKETS - 1));
+    }
+
+private:
+    IarmCallStatistics() = default;
+    IarmCallStatistics(const IarmCallStatistics&) = delete;
+    IarmCallStatistics& operator=(const IarmCallStatistics&) = delete;
+
+    static std::pair<std::string, std::string> key(const char* owner, const char* method)
+    {
+        return std::make_pair(std::string(owner != nullptr ? owner : ""), std::string(method != nullptr ? method : ""));
+    }
+
+    mutable std::mutex m_mutex;
+    Entries m_entries;
+};
+
 struct IARM {
+    // Every IARM_Bus_Call of the plugins goes through here, so the time they block the calling
+    // thread shows up in IarmCallStatistics.
+    static IARM_Result_t call(const char* owner, const char* method, void* arg, size_t argLen)
+    {
+        IarmCallStatistics& statistics = IarmCallStatistics::instance();
+        statistics.begin(owner, method);
+        uint64_t start = IarmCallStatistics::now();
+        IARM_Result_t result = IARM_Bus_Call(owner, method, arg, argLen);
+        statistics.end(owner, method, IarmCallStatistics::now() - start, result, 0);
+        return result;
+    }
+
+    static IARM_Result_t callWithIPCTimeout(const char* owner, const char* method, void* arg, size_t argLen, int timeoutMs)
+    {
+        IarmCallStatistics& statistics = IarmCallStatistics::instance();
+        statistics.begin(owner, method);
+        uint64_t start = IarmCallStatistics::now();
+        IARM_Result_t result = IARM_Bus_Call_with_IPCTimeout(owner, method, arg, argLen, timeoutMs);
+        statistics.end(owner, method, IarmCallStatistics::now() - start, result, timeoutMs);
+        return result;
+    }
+
     static bool init()
     {
         IARM_Result_t res;
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <map>
 #include <mutex>
 #include <plugins/plugins.h>
 #include <memory>
+#include <time.h>
+#include <vector>
 #include "UtilsLogging.h"
 
 using namespace WPEFramework;
@@ -23,23 +28,198 @@ namespace Utils {
 
         template <class C> std::recursive_mutex ApiLocks<C>::mtx;
 
+        // Wait and hold times of an API lock per locked method (or IARM event), and the sampling of
+        // the call log. Recording is off by default, when on every locked call costs a try_lock and
+        // a few clock reads more. The hold time leaves out the time spent in UnlockApiGuard.
+        class LockStatistics {
+        public:
+            static constexpr uint32_t DEFAULT_LOG_INTERVAL = 100;
+
+            struct Entry {
+                Entry()
+                    : calls(0), contended(0), unlocks(0), totalWaitUs(0), maxWaitUs(0), totalHoldUs(0), maxHoldUs(0)
+                {
+                }
+
+                uint64_t calls;
+                uint64_t contended; // calls that found the lock taken by another thread
+                uint64_t unlocks; // outbound calls made with the lock released, see UnlockApiGuard
+                uint64_t totalWaitUs; // re-acquiring after an unlock included
+                uint64_t maxWaitUs;
+                uint64_t totalHoldUs;
+                uint64_t maxHoldUs;
+            };
+
+            typedef std::map<std::string, Entry> Entries;
+
+            LockStatistics()
+                : m_enabled(false), m_logInterval(DEFAULT_LOG_INTERVAL), m_logCounter(0)
+            {
+            }
+            LockStatistics(const LockStatistics&) = delete;
+            LockStatistics& operator=(const LockStatistics&) = delete;
+
+            static uint64_t now()
+            {
+                struct timespec ts;
+                clock_gettime(CLOCK_MONOTONIC, &ts);
+                return (static_cast<uint64_t>(ts.tv_sec) * 1000000ULL) + (ts.tv_nsec / 1000);
+            }
+
+            bool enabled() const
+            {
+                return m_enabled.load(std::memory_order_relaxed);
+            }
+            void enable(bool enabled)
+            {
+                m_enabled = enabled;
+            }
+
+            // One locked call in logInterval is logged, 1 logs all of them, 0 none.
+            uint32_t logInterval() const
+            {
+                return m_logInterval.load(std::memory_order_relaxed);
+            }
+            void setLogInterval(uint32_t interval)
+            {
+                m_logInterval = interval;
+            }
+            bool sample()
+            {
+                uint32_t interval = logInterval();
+                return (interval != 0) && ((m_logCounter.fetch_add(1, std::memory_order_relaxed) % interval) == 0);
+            }
+
+            void call(const std::string& method, bool contended, uint64_t waitUs, uint64_t holdUs)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                Entry& entry = m_entries[method];
+                entry.calls++;
+                if (contended) {
+                    entry.contended++;
+                }
+                entry.totalWaitUs += waitUs;
+                if (waitUs > entry.maxWaitUs) {
+                    entry.maxWaitUs = waitUs;
+                }
+                entry.totalHoldUs += holdUs;
+                if (holdUs > entry.maxHoldUs) {
+                    entry.maxHoldUs = holdUs;
+                }
+            }
+
+            void unlock(const std::string& method, uint64_t waitUs)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                Entry& entry = m_entries[method];
+                entry.unlocks++;
+                entry.totalWaitUs += waitUs;
+                if (waitUs > entry.maxWaitUs) {
+                    entry.maxWaitUs = waitUs;
+                }
+            }
+
+            Entries entries() const
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_entries;
+            }
+
+            void reset()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_entries.clear();
+            }
+
+        private:
+            std::atomic<bool> m_enabled;
+            std::atomic<uint32_t> m_logInterval;
+            std::atomic<uint32_t> m_logCounter;
+            mutable std::mutex m_mutex;
+            Entries m_entries;
+        };
+
+        // keeps API lock statistics, one per specific class, like the locks
+        template<class C>
+        struct ApiLockStatistics {
+            static LockStatistics statistics;
+        };
+
+        template <class C> LockStatistics ApiLockStatistics<C>::statistics;
+
+        namespace {
+            // the locked call of this thread, for UnlockApiGuard
+            thread_local const std::string* lockedApiMethod = nullptr;
+            // time this thread spent with the lock released by UnlockApiGuard during the locked call
+            thread_local uint64_t lockedApiUnlockedUs = 0;
+        }
+
+        // Holds the API lock of a class for one locked call and records it in the statistics.
+        template<class C>
+        class LockedCall {
+        public:
+            LockedCall(const LockedCall&) = delete;
+            LockedCall& operator=(const LockedCall&) = delete;
+
+            explicit LockedCall(const std::string& method)
+                : _method(method)
+                , _lock(ApiLocks<C>::mtx, std::defer_lock)
+                , _measure(ApiLockStatistics<C>::statistics.enabled())
+                , _contended(false)
+                , _waitUs(0)
+                , _acquired(0)
+                , _outerMethod(lockedApiMethod)
+                , _outerUnlockedUs(lockedApiUnlockedUs)
+            {
+                isThreadUsingLockedApi = true;
+                if (_measure) {
+                    if (_lock.try_lock() == false) {
+                        _contended = true;
+                        uint64_t start = LockStatistics::now();
+                        _lock.lock();
+                        _acquired = LockStatistics::now();
+                        _waitUs = _acquired - start;
+                    } else {
+                        _acquired = LockStatistics::now();
+                    }
+                } else {
+                    _lock.lock();
+                }
+                lockedApiMethod = &_method;
+                lockedApiUnlockedUs = 0;
+                if (ApiLockStatistics<C>::statistics.sample()) {
+                    LOGINFO("calling %s with lock: %p\n", _method.c_str(), &ApiLocks<C>::mtx);
+                }
+            }
+            ~LockedCall()
+            {
+                if (_measure) {
+                    uint64_t heldUs = LockStatistics::now() - _acquired;
+                    ApiLockStatistics<C>::statistics.call(_method, _contended, _waitUs, (heldUs > lockedApiUnlockedUs ? heldUs - lockedApiUnlockedUs : 0));
+                }
+                lockedApiMethod = _outerMethod;
+                lockedApiUnlockedUs = _outerUnlockedUs;
+                _lock.unlock();
+                isThreadUsingLockedApi = (_outerMethod != nullptr);
+            }
+
+        private:
+            const std::string& _method;
+            std::unique_lock<std::recursive_mutex> _lock;
+            const bool _measure;
+            bool _contended;
+            uint64_t _waitUs;
+            uint64_t _acquired;
+            const std::string* _outerMethod;
+            uint64_t _outerUnlockedUs;
+        };
+
         template <typename METHOD, typename REALOBJECT>
         std::function<uint32_t(REALOBJECT*, const WPEFramework::Core::JSON::VariantContainer&, WPEFramework::Core::JSON::VariantContainer&)>
         getFunctionToCall(const std::string& debugname, const METHOD& method, REALOBJECT* objectPtr) {
             return [debugname, method](REALOBJECT *obj, const WPEFramework::Core::JSON::VariantContainer& in, WPEFramework::Core::JSON::VariantContainer& out) -> uint32_t {
-                isThreadUsingLockedApi = true;
-                // printf("METHOD CALL, GETTING LOCK: REALOBJECT '%s', method: '%s' MUTEX:%p\n",typeid(REALOBJECT).name(), debugname.c_str(), &ApiLocks<REALOBJECT>::mtx); fflush(stdout);
-                std::lock_guard<std::recursive_mutex> lock(ApiLocks<REALOBJECT>::mtx);
-                LOGINFO("calling %s with lock: %p\n", debugname.c_str(), &ApiLocks<REALOBJECT>::mtx);
-                uint32_t ret;
-                try {
-                    ret = (obj->*method)(in, out);
-                } catch (...) {
-                    isThreadUsingLockedApi = false;
-                    throw;
-                }
-                isThreadUsingLockedApi = false;
-                return ret;
+                LockedCall<REALOBJECT> call(debugname);
+                return (obj->*method)(in, out);
             };
         }
 
@@ -56,6 +236,79 @@ namespace Utils {
             objectPtr->PluginHost::JSONRPC::Register<METHOD,REALOBJECT>(methodName, getFunctionToCall(methodName, method, objectPtr), objectPtr, versions);
         }
 
+        // getApiLockStatistics and setApiLockStatistics for the API lock of a class. They do not take the
+        // lock, so they answer while a locked call holds it.
+        template <typename REALOBJECT>
+        void RegisterLockStatisticsApi(REALOBJECT* objectPtr)
+        {
+            typedef std::function<uint32_t(REALOBJECT*, const JsonObject&, JsonObject&)> MethodType;
+
+            MethodType getStatistics = [](REALOBJECT*, const JsonObject& parameters, JsonObject& response) -> uint32_t {
+                LockStatistics& statistics = ApiLockStatistics<REALOBJECT>::statistics;
+                LockStatistics::Entries entries = statistics.entries();
+
+                // the methods serializing the most first
+                std::vector<LockStatistics::Entries::const_iterator> order;
+                for (LockStatistics::Entries::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+                    order.push_back(it);
+                }
+                std::stable_sort(order.begin(), order.end(), [](const LockStatistics::Entries::const_iterator& a, const LockStatistics::Entries::const_iterator& b) {
+                    return a->second.totalHoldUs > b->second.totalHoldUs;
+                });
+
+                JsonArray methods;
+                for (const LockStatistics::Entries::const_iterator& it : order) {
+                    JsonObject method;
+                    method["method"] = it->first;
+                    method["calls"] = it->second.calls;
+                    method["contended"] = it->second.contended;
+                    method["unlocks"] = it->second.unlocks;
+                    method["waitTotalUs"] = it->second.totalWaitUs;
+                    method["waitMaxUs"] = it->second.maxWaitUs;
+                    method["holdTotalUs"] = it->second.totalHoldUs;
+                    method["holdMaxUs"] = it->second.maxHoldUs;
+                    methods.Add(method);
+                }
+
+                response["enabled"] = statistics.enabled();
+                response["logInterval"] = statistics.logInterval();
+                response["methods"] = methods;
+                response["success"] = true;
+                return Core::ERROR_NONE;
+            };
+
+            MethodType setStatistics = [](REALOBJECT*, const JsonObject& parameters, JsonObject& response) -> uint32_t {
+                LockStatistics& statistics = ApiLockStatistics<REALOBJECT>::statistics;
+
+                if (parameters.HasLabel("logInterval") && (parameters["logInterval"].Number() < 0)) {
+                    return Core::ERROR_BAD_REQUEST;
+                }
+
+                if (parameters.HasLabel("enabled")) {
+                    statistics.enable(parameters["enabled"].Boolean());
+                }
+                if (parameters.HasLabel("logInterval")) {
+                    statistics.setLogInterval(static_cast<uint32_t>(parameters["logInterval"].Number()));
+                }
+                if (parameters.HasLabel("reset") && parameters["reset"].Boolean()) {
+                    statistics.reset();
+                }
+
+                response["success"] = true;
+                return Core::ERROR_NONE;
+            };
+
+            objectPtr->PluginHost::JSONRPC::Register<JsonObject, JsonObject, MethodType, REALOBJECT>(_T("getApiLockStatistics"), getStatistics, objectPtr);
+            objectPtr->PluginHost::JSONRPC::Register<JsonObject, JsonObject, MethodType, REALOBJECT>(_T("setApiLockStatistics"), setStatistics, objectPtr);
+        }
+
+        template <typename REALOBJECT>
+        void UnregisterLockStatisticsApi(REALOBJECT* objectPtr)
+        {
+            objectPtr->PluginHost::JSONRPC::Unregister(_T("getApiLockStatistics"));
+            objectPtr->PluginHost::JSONRPC::Unregister(_T("setApiLockStatistics"));
+        }
+
         template <typename METHOD, typename REALOBJECT>
         void RegisterLockedApiForHandler(Core::JSONRPC::Handler* handler, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
         {
@@ -69,16 +322,31 @@ namespace Utils {
         */
         template<class UsingClass>
         struct UnlockApiGuard {
-            UnlockApiGuard() {
+            UnlockApiGuard() : _unlocked(0) {
                 if (isThreadUsingLockedApi) {
                     ApiLocks<UsingClass>::mtx.unlock();
+                    if (ApiLockStatistics<UsingClass>::statistics.enabled()) {
+                        _unlocked = LockStatistics::now();
+                    }
                 }
             }
             ~UnlockApiGuard() {
                 if (isThreadUsingLockedApi) {
-                    ApiLocks<UsingClass>::mtx.lock();
+                    if (_unlocked != 0) {
+                        uint64_t start = LockStatistics::now();
+                        ApiLocks<UsingClass>::mtx.lock();
+                        uint64_t end = LockStatistics::now();
+                        lockedApiUnlockedUs += (end - _unlocked);
+                        if (lockedApiMethod != nullptr) {
+                            ApiLockStatistics<UsingClass>::statistics.unlock(*lockedApiMethod, end - start);
+                        }
+                    } else {
+                        ApiLocks<UsingClass>::mtx.lock();
+                    }
                 }
             }
+        private:
+            uint64_t _unlocked;
         };
 
         template<class UsingClass>
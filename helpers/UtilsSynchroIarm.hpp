@@ -30,16 +30,10 @@ namespace Utils {
         template<class UsingClass>
         static void _generic_iarm_handler(const char *owner, IARM_EventId_t eventId, void *data, size_t len) {
             auto& handlers_map = IarmHandlers<UsingClass>::_registered_iarm_handlers;
-            isThreadUsingLockedApi = true;
-            std::lock_guard<std::recursive_mutex> lock(ApiLocks<UsingClass>::mtx);
-            LOGINFO("calling handler %s/%d with lock: %p\n", owner, eventId, &ApiLocks<UsingClass>::mtx);
-            try {
-                handlers_map[owner][eventId](owner, eventId, data, len);
-            } catch (...) {
-                isThreadUsingLockedApi = false;
-                throw;
-            }
-            isThreadUsingLockedApi = false;
+            // recorded in the API lock statistics as "<owner>/<event id>"
+            const std::string name = std::string(owner) + "/" + std::to_string(eventId);
+            LockedCall<UsingClass> call(name);
+            handlers_map[owner][eventId](owner, eventId, data, len);
         }
 
         template<class UsingClass>
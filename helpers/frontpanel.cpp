@@ -47,6 +47,7 @@
 #include "UtilsJsonRpc.h"
 #include "UtilsLogging.h"
 #include "UtilssyncPersistFile.h"
+#include "UtilsIarm.h"
 
 #define FP_SETTINGS_FILE_JSON "/opt/fp_service_preferences.json"
 
@@ -150,7 +151,7 @@ namespace WPEFramework
 #if defined(HAS_API_POWERSTATE)
                     {
                         IARM_Bus_PWRMgr_GetPowerState_Param_t param;
-                        IARM_Result_t res = IARM_Bus_Call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState,
+                        IARM_Result_t res = Utils::IARM::call(IARM_BUS_PWRMGR_NAME, IARM_BUS_PWRMGR_API_GetPowerState,
                             (void*)&param, sizeof(param));
 
                         if (res == IARM_RESULT_SUCCESS) {
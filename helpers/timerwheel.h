@@ -0,0 +1,301 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <plugins/plugins.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace WPEFramework {
+
+namespace Plugin {
+    // Process wide hierarchical timing wheel. All timers of all plugins in the process share one thread
+    // that sleeps until the next slot holding a timer, instead of one timer thread per TpTimer.
+    // Level 0 has 256 slots of 1 ms, each of the 3 levels above 64 slots covering the whole range of
+    // the level below, which is about 18 hours in total; longer delays are parked in the last slot and
+    // placed again when they get there. Expired callbacks are handed to the worker pool when there is
+    // one, otherwise they run on the wheel thread and should return quickly.
+    class TimerWheel {
+    public:
+        typedef uint64_t Handle;
+
+    private:
+        static constexpr uint32_t Level0Bits = 8;
+        static constexpr uint32_t LevelBits = 6;
+        static constexpr uint32_t Levels = 4;
+        static constexpr uint64_t Range = (1ULL << (Level0Bits + (LevelBits * (Levels - 1))));
+
+        struct Entry {
+            uint64_t expiry;
+            std::function<void()> callback;
+        };
+
+        typedef std::list<Handle> Slot;
+
+#ifndef USE_THUNDER_R4
+        class Job : public Core::IDispatchType<void>
+#else
+        class Job : public Core::IDispatch
+#endif /* USE_THUNDER_R4 */
+        {
+        public:
+            Job(std::function<void()> work)
+                : _work(work)
+            {
+            }
+            void Dispatch() override
+            {
+                _work();
+            }
+
+        private:
+            std::function<void()> _work;
+        };
+
+        TimerWheel()
+            : m_epoch(std::chrono::steady_clock::now())
+            , m_current(0)
+            , m_nextHandle(1)
+            , m_exit(false)
+        {
+            for (uint32_t level = 0; level < Levels; level++) {
+                m_slots[level].resize(SlotCount(level));
+            }
+        }
+
+    public:
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        ~TimerWheel()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_exit = true;
+            }
+            m_wakeup.notify_one();
+
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+        }
+
+        static TimerWheel& Instance()
+        {
+            static TimerWheel instance;
+            return instance;
+        }
+
+        // Calls the callback once, delayMs from now. The handle stays valid until the callback is dispatched.
+        Handle Schedule(uint32_t delayMs, const std::function<void()>& callback)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_entries.empty() == true) {
+                // Nothing to walk through, catch up with the clock at once.
+                m_current = std::max(m_current, Now());
+            }
+
+            if (m_thread.joinable() == false) {
+                m_thread = std::thread(&TimerWheel::Run, this);
+            }
+
+            Handle handle = m_nextHandle++;
+            // Part of the current millisecond has passed already, one more keeps the callback from coming early.
+            uint64_t expiry = std::max(m_current, Now()) + delayMs + 1;
+
+            m_entries.emplace(handle, Entry { expiry, callback });
+            Place(handle, expiry);
+
+            m_wakeup.notify_one();
+
+            return handle;
+        }
+
+        // A revoked callback is not dispatched anymore; one that is already running is not waited for.
+        void Revoke(Handle handle)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // The handle left in its slot is skipped when the wheel gets there.
+            m_entries.erase(handle);
+        }
+
+        size_t Pending() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+    private:
+        static uint32_t SlotCount(uint32_t level)
+        {
+            return (level == 0 ? (1u << Level0Bits) : (1u << LevelBits));
+        }
+        static uint32_t Shift(uint32_t level)
+        {
+            return (level == 0 ? 0 : Level0Bits + (LevelBits * (level - 1)));
+        }
+
+        uint64_t Now() const
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_epoch).count();
+        }
+
+        void Place(Handle handle, uint64_t expiry)
+        {
+            uint64_t delta = (expiry > m_current ? expiry - m_current : 0);
+
+            if (delta < (1ULL << Level0Bits)) {
+                // Due at or before the current tick ends up in the current slot, which is handled right after a cascade.
+                uint64_t tick = std::max(expiry, m_current);
+                m_slots[0][tick & ((1u << Level0Bits) - 1)].push_back(handle);
+            } else {
+                if (delta >= Range) {
+                    expiry = m_current + Range - 1;
+                }
+
+                uint32_t level = 1;
+                while ((level < (Levels - 1)) && ((expiry - m_current) >= (1ULL << (Shift(level) + LevelBits)))) {
+                    level++;
+                }
+                m_slots[level][(expiry >> Shift(level)) & ((1u << LevelBits) - 1)].push_back(handle);
+            }
+        }
+
+        // First tick after the current one that needs work: a non empty level 0 slot or the next cascade.
+        uint64_t Next() const
+        {
+            const uint64_t boundary = (m_current | ((1u << Level0Bits) - 1)) + 1;
+            uint64_t tick = m_current + 1;
+
+            while ((tick < boundary) && (m_slots[0][tick & ((1u << Level0Bits) - 1)].empty() == true)) {
+                tick++;
+            }
+
+            return tick;
+        }
+
+        // Moves the slots that start at this tick down the hierarchy, highest level first.
+        void Cascade(uint64_t tick)
+        {
+            for (uint32_t level = Levels - 1; level > 0; level--) {
+                if ((tick & ((1ULL << Shift(level)) - 1)) == 0) {
+                    Slot moving;
+                    moving.swap(m_slots[level][(tick >> Shift(level)) & ((1u << LevelBits) - 1)]);
+
+                    for (Handle handle : moving) {
+                        auto entry = m_entries.find(handle);
+                        if (entry != m_entries.end()) {
+                            Place(handle, entry->second.expiry);
+                        }
+                    }
+                }
+            }
+        }
+
+        void Expire(uint64_t tick, std::vector<std::function<void()>>& expired)
+        {
+            Slot& slot = m_slots[0][tick & ((1u << Level0Bits) - 1)];
+
+            for (auto it = slot.begin(); it != slot.end();) {
+                auto entry = m_entries.find(*it);
+                if (entry == m_entries.end()) {
+                    it = slot.erase(it);
+                } else if (entry->second.expiry <= tick) {
+                    expired.push_back(std::move(entry->second.callback));
+                    m_entries.erase(entry);
+                    it = slot.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        void Dispatch(std::function<void()>& callback)
+        {
+            if (Core::IWorkerPool::IsAvailable() == true) {
+#ifndef USE_THUNDER_R4
+                Core::IWorkerPool::Instance().Submit(Core::ProxyType<Core::IDispatchType<void>>(Core::ProxyType<Job>::Create(callback)));
+#else
+                Core::IWorkerPool::Instance().Submit(Core::ProxyType<Core::IDispatch>(Core::ProxyType<Job>::Create(callback)));
+#endif /* USE_THUNDER_R4 */
+            } else {
+                callback();
+            }
+        }
+
+        void Run()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            std::vector<std::function<void()>> expired;
+
+            while (m_exit == false) {
+                if (m_entries.empty() == true) {
+                    m_wakeup.wait(lock);
+                    continue;
+                }
+
+                const uint64_t now = Now();
+                uint64_t next = Next();
+
+                if (next > now) {
+                    m_wakeup.wait_until(lock, m_epoch + std::chrono::milliseconds(next));
+                    continue;
+                }
+
+                // Ticks in between have nothing to do, skip them.
+                m_current = next;
+                Cascade(m_current);
+                Expire(m_current, expired);
+
+                if (expired.empty() == false) {
+                    lock.unlock();
+                    for (auto& callback : expired) {
+                        Dispatch(callback);
+                    }
+                    expired.clear();
+                    lock.lock();
+                }
+            }
+        }
+
+    private:
+        const std::chrono::steady_clock::time_point m_epoch;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wakeup;
+        std::thread m_thread;
+        std::vector<Slot> m_slots[Levels];
+        std::unordered_map<Handle, Entry> m_entries;
+        uint64_t m_current;
+        Handle m_nextHandle;
+        bool m_exit;
+    };
+}
+}
+
+#endif
@@ -20,52 +20,42 @@
 #ifndef TTIMER_H
 #define TTIMER_H
 
-//#include <core/Timer.h>
-#include <plugins/plugins.h>
+#include "timerwheel.h"
+
+#include <memory>
 
 namespace WPEFramework {
 
 namespace Plugin {
+    // Timer on the shared TimerWheel, so an instance costs a wheel entry while it runs instead of a thread.
+    // The callback runs on the worker pool (or the wheel thread if there is none), never concurrently with
+    // itself; the destructor waits for a callback that is still running on another thread.
     class TpTimer {
     private:
-        class TpTimerJob {
-        private:
-            TpTimerJob() = delete;
-            TpTimerJob& operator=(const TpTimerJob& RHS) = delete;
-
-        public:
-            TpTimerJob(TpTimer* tpt)
-                : m_tptimer(tpt)
-            {
-            }
-            TpTimerJob(const TpTimerJob& copy)
-                : m_tptimer(copy.m_tptimer)
-            {
-            }
-            ~TpTimerJob() {}
-
-            inline bool operator==(const TpTimerJob& RHS) const
-            {
-                return (m_tptimer == RHS.m_tptimer);
-            }
-
-        public:
-            uint64_t Timed(const uint64_t scheduledTime)
+        struct State {
+            State(TpTimer* owner)
+                : owner(owner)
+                , handle(0)
+                , generation(0)
+                , running(false)
             {
-                if (m_tptimer) {
-                    m_tptimer->Timed();
-                }
-                return 0;
             }
 
-        private:
-            TpTimer* m_tptimer;
+            std::mutex lock;
+            std::condition_variable idle;
+            TpTimer* owner;
+            TimerWheel::Handle handle;
+            uint64_t generation;
+            bool running;
+            std::thread::id runner;
         };
 
     public:
+        TpTimer(const TpTimer&) = delete;
+        TpTimer& operator=(const TpTimer&) = delete;
+
         TpTimer()
-            : baseTimer(64 * 1024, "ThunderPluginBaseTimer")
-            , m_timerJob(this)
+            : m_state(std::make_shared<State>(this))
             , m_isActive(false)
             , m_isSingleShot(false)
             , m_intervalInMs(-1)
@@ -74,6 +64,10 @@ namespace Plugin {
         ~TpTimer()
         {
             stop();
+
+            std::unique_lock<std::mutex> lock(m_state->lock);
+            m_state->idle.wait(lock, [this]() { return (m_state->running == false) || (m_state->runner == std::this_thread::get_id()); });
+            m_state->owner = nullptr;
         }
 
         bool isActive()
@@ -82,13 +76,18 @@ namespace Plugin {
         }
         void stop()
         {
-            baseTimer.Revoke(m_timerJob);
+            std::lock_guard<std::mutex> lock(m_state->lock);
+            revoke();
             m_isActive = false;
         }
         void start()
         {
-            baseTimer.Revoke(m_timerJob);
-            baseTimer.Schedule(Core::Time::Now().Add(m_intervalInMs), m_timerJob);
+            std::lock_guard<std::mutex> lock(m_state->lock);
+            revoke();
+
+            std::shared_ptr<State> state(m_state);
+            uint64_t generation = m_state->generation;
+            m_state->handle = TimerWheel::Instance().Schedule(std::max(m_intervalInMs, 0), [state, generation]() { Fire(state, generation); });
             m_isActive = true;
         }
         void start(int msec)
@@ -111,6 +110,44 @@ namespace Plugin {
         }
 
     private:
+        // Called with the state lock held. Bumping the generation also drops a callback the wheel already handed out.
+        void revoke()
+        {
+            if (m_state->handle != 0) {
+                TimerWheel::Instance().Revoke(m_state->handle);
+                m_state->handle = 0;
+            }
+            m_state->generation++;
+        }
+
+        static void Fire(const std::shared_ptr<State>& state, uint64_t generation)
+        {
+            TpTimer* owner = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock(state->lock);
+                // A restart from inside the callback, or from another thread, can fire again before the
+                // previous callback returned; on the worker pool that would run Timed() twice at once.
+                state->idle.wait(lock, [&state]() { return (state->running == false) || (state->runner == std::this_thread::get_id()); });
+                if ((state->generation == generation) && (state->owner != nullptr)) {
+                    state->handle = 0;
+                    state->running = true;
+                    state->runner = std::this_thread::get_id();
+                    owner = state->owner;
+                }
+            }
+
+            if (owner != nullptr) {
+                owner->Timed();
+
+                {
+                    std::lock_guard<std::mutex> lock(state->lock);
+                    state->running = false;
+                }
+                state->idle.notify_all();
+            }
+        }
+
         void Timed()
         {
             if (onTimeoutCallback != nullptr) {
@@ -126,8 +163,7 @@ namespace Plugin {
             }
         }
 
-        WPEFramework::Core::TimerType<TpTimerJob> baseTimer;
-        TpTimerJob m_timerJob;
+        std::shared_ptr<State> m_state;
         bool m_isActive;
         bool m_isSingleShot;
         int m_intervalInMs;